@@ -0,0 +1,69 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file boundary_conditions_apk.cpp
+//  \brief AthenaPK specific boundary conditions
+
+// C++ headers
+#include <array>
+#include <memory>
+#include <string>
+
+// Parthenon headers
+#include "bvals/boundary_conditions.hpp"
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "boundary_conditions_apk.hpp"
+
+namespace Hydro {
+namespace BoundaryFunction {
+
+namespace {
+// Packed boundary conditions of each face (if registered)
+std::array<PackedBValFunc, parthenon::BOUNDARY_NFACES> packed_bvals;
+// Whether the packed boundary conditions are applied by the current thread so that the
+// per block ones called by Parthenon are skipped
+thread_local bool applying_packed_bvals = false;
+
+const char *bc_names[] = {"ix1_bc", "ox1_bc", "ix2_bc", "ox2_bc", "ix3_bc", "ox3_bc"};
+} // namespace
+
+void RegisterBoundaryCondition(parthenon::ParameterInput *pin,
+                               parthenon::ApplicationInput *app_input,
+                               const parthenon::BoundaryFace face,
+                               const std::string &name, BValFunc per_block,
+                               PackedBValFunc packed) {
+  app_input->RegisterBoundaryCondition(
+      face, name, [per_block](std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse) {
+        if (!applying_packed_bvals) {
+          per_block(mbd, coarse);
+        }
+      });
+  const auto bc_name = bc_names[static_cast<int>(face)];
+  if (pin->DoesParameterExist("parthenon/mesh", bc_name) &&
+      pin->GetString("parthenon/mesh", bc_name) == name) {
+    packed_bvals[static_cast<int>(face)] = packed;
+  }
+}
+
+TaskStatus ApplyBoundaryConditionsOnCoarseOrFineMD(std::shared_ptr<MeshData<Real>> &md,
+                                                   bool coarse) {
+  // Parthenon's (and all per block) boundary conditions of faces without a packed
+  // boundary condition
+  applying_packed_bvals = true;
+  parthenon::ApplyBoundaryConditionsOnCoarseOrFineMD(md, coarse);
+  applying_packed_bvals = false;
+
+  for (const auto &packed : packed_bvals) {
+    if (packed != nullptr) {
+      packed(md.get(), coarse);
+    }
+  }
+  return TaskStatus::complete;
+}
+
+} // namespace BoundaryFunction
+} // namespace Hydro
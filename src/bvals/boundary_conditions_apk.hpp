@@ -3,13 +3,21 @@
 // Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
 // Licensed under the 3-clause BSD License, see LICENSE file for details
 //========================================================================================
-//! \file boundary_conditions_apk.chpp
+//! \file boundary_conditions_apk.hpp
 //  \brief AthenaPK specific boundary conditions
 //
+// Boundary conditions can be registered as a regular (per block) Parthenon boundary
+// condition together with a packed version that fills the ghost cells of all blocks of a
+// MeshData partition at a physical boundary face in a single kernel launch. The packed
+// versions are used in the boundary exchanges of the HydroDriver while the per block
+// versions are used otherwise (e.g., when initializing the mesh or after remeshing).
+//
 
 #ifndef BVALS_BOUNDARY_CONDITIONS_APK_HPP_
 #define BVALS_BOUNDARY_CONDITIONS_APK_HPP_
 
+#include <cmath>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -17,6 +25,7 @@
 // Parthenon headers
 #include <parthenon/package.hpp>
 
+#include "application_input.hpp"
 #include "basic_types.hpp"
 #include "bvals/boundary_conditions_generic.hpp"
 #include "mesh/domain.hpp"
@@ -35,6 +44,68 @@ using parthenon::CoordinateDirection;
 // using parthenon::Real;
 using parthenon::BoundaryFunction::BCSide;
 
+using BValFunc = std::function<void(std::shared_ptr<MeshBlockData<Real>> &, bool)>;
+using PackedBValFunc = std::function<void(MeshData<Real> *, bool)>;
+
+// Registers the per block boundary condition with Parthenon and the packed version for
+// all faces that use the boundary condition name in the input file.
+void RegisterBoundaryCondition(parthenon::ParameterInput *pin,
+                               parthenon::ApplicationInput *app_input,
+                               const parthenon::BoundaryFace face,
+                               const std::string &name, BValFunc per_block,
+                               PackedBValFunc packed);
+
+// Same as parthenon::ApplyBoundaryConditionsOnCoarseOrFineMD but using the packed
+// versions of the boundary conditions (if registered)
+TaskStatus ApplyBoundaryConditionsOnCoarseOrFineMD(std::shared_ptr<MeshData<Real>> &md,
+                                                   bool coarse);
+
+// Calls function(b, k, j, i) for all ghost cells of the SIDE of DIR of all blocks in md
+// located at the corresponding physical boundary of the mesh (in a single kernel).
+template <CoordinateDirection DIR, BCSide SIDE, typename Pack, typename Function>
+void ParForPackedBndry(const std::string &name, MeshData<Real> *md, const Pack &pack,
+                       const bool coarse, const Function &function) {
+  static_assert(DIR == X1DIR || DIR == X2DIR || DIR == X3DIR, "DIR must be X[123]DIR");
+  constexpr bool X1 = (DIR == X1DIR);
+  constexpr bool X2 = (DIR == X2DIR);
+  constexpr bool INNER = (SIDE == BCSide::Inner);
+
+  MeshBlock *pmb = md->GetBlockData(0)->GetBlockPointer();
+  const auto &bounds = coarse ? pmb->c_cellbounds : pmb->cellbounds;
+  auto ib = bounds.GetBoundsI(IndexDomain::entire);
+  auto jb = bounds.GetBoundsJ(IndexDomain::entire);
+  auto kb = bounds.GetBoundsK(IndexDomain::entire);
+  const auto &range = X1 ? bounds.GetBoundsI(IndexDomain::interior)
+                         : (X2 ? bounds.GetBoundsJ(IndexDomain::interior)
+                               : bounds.GetBoundsK(IndexDomain::interior));
+  auto &ghosts = X1 ? ib : (X2 ? jb : kb);
+  if (INNER) {
+    ghosts.e = range.s - 1;
+  } else {
+    ghosts.s = range.e + 1;
+  }
+
+  // Blocks at the physical boundary are identified by the position of the last (fine)
+  // interior face
+  const auto &fine_range = X1 ? pmb->cellbounds.GetBoundsI(IndexDomain::interior)
+                              : (X2 ? pmb->cellbounds.GetBoundsJ(IndexDomain::interior)
+                                    : pmb->cellbounds.GetBoundsK(IndexDomain::interior));
+  const int face = INNER ? fine_range.s : fine_range.e + 1;
+  const auto &mesh_size = pmb->pmy_mesh->mesh_size;
+  const Real x_bnd = INNER ? mesh_size.xmin(DIR) : mesh_size.xmax(DIR);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, name, parthenon::DevExecSpace(), 0, md->NumBlocks() - 1, kb.s,
+      kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &coords = pack.GetCoords(b);
+        const Real x_face = coords.template Xf<DIR>(face);
+        const Real dx = coords.template Xf<DIR>(face + 1) - x_face;
+        if (std::abs(x_face - x_bnd) > 0.5 * std::abs(dx)) return;
+        function(b, k, j, i);
+      });
+}
+
 template <CoordinateDirection DIR, BCSide SIDE>
 void ReflectBC(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse) {
   // make sure DIR is X[123]DIR so we don't have to check again
@@ -70,13 +141,18 @@ void ReflectBC(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse) {
   // used for reflections
   const int offset = (2 * ref) + (INNER ? -1 : 1);
 
-  auto cons = mbd->PackVariables(std::vector<std::string>{"cons"}, coarse);
+  // Includes the sparse scalars (if enabled), which are skipped if not allocated
+  auto cons = mbd->PackVariables(
+      hydro_pkg->Param<std::vector<std::string>>("cons_names"), coarse);
   const bool fine = false; // no usage of fine fields in AthenaPK for now
 
   const auto nv = IndexRange{0, cons.GetDim(4) - 1};
   pmb->par_for_bndry(
       "ReflectBC", nv, domain, parthenon::TopologicalElement::CC, coarse, fine,
       KOKKOS_LAMBDA(const int &v, const int &k, const int &j, const int &i) {
+        if (!cons.IsAllocated(v)) {
+          return;
+        }
         const bool reflect = v == DIR;
         cons(v, k, j, i) =
             (reflect ? -1.0 : 1.0) *
@@ -84,6 +160,44 @@ void ReflectBC(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse) {
       });
 }
 
+// Packed version of ReflectBC
+template <CoordinateDirection DIR, BCSide SIDE>
+void ReflectBCPacked(MeshData<Real> *md, bool coarse) {
+  MeshBlock *pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const auto fluid = hydro_pkg->Param<Fluid>("fluid");
+  PARTHENON_REQUIRE_THROWS(
+      fluid == Fluid::euler,
+      "Reflecting boundary conditions for MHD need special treatment.");
+
+  constexpr bool X1 = (DIR == X1DIR);
+  constexpr bool X2 = (DIR == X2DIR);
+  constexpr bool X3 = (DIR == X3DIR);
+  constexpr bool INNER = (SIDE == BCSide::Inner);
+
+  const auto &bounds = coarse ? pmb->c_cellbounds : pmb->cellbounds;
+  const auto &range = X1 ? bounds.GetBoundsI(IndexDomain::interior)
+                         : (X2 ? bounds.GetBoundsJ(IndexDomain::interior)
+                               : bounds.GetBoundsK(IndexDomain::interior));
+  const int ref = INNER ? range.s : range.e;
+  // used for reflections
+  const int offset = (2 * ref) + (INNER ? -1 : 1);
+
+  auto cons = md->PackVariables(
+      hydro_pkg->Param<std::vector<std::string>>("cons_names"), coarse);
+  ParForPackedBndry<DIR, SIDE>(
+      "ReflectBCPacked", md, cons, coarse,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        for (int v = 0; v < cons.GetDim(4); v++) {
+          if (!cons.IsAllocated(b, v)) continue;
+          const bool reflect = v == DIR;
+          cons(b, v, k, j, i) = (reflect ? -1.0 : 1.0) *
+                                cons(b, v, X3 ? offset - k : k, X2 ? offset - j : j,
+                                     X1 ? offset - i : i);
+        }
+      });
+}
+
 } // namespace BoundaryFunction
 } // namespace Hydro
 
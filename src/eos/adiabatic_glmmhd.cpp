@@ -12,9 +12,12 @@
 
 // C++ headers
 #include <cmath> // sqrt()
+#include <limits>
 
 // Parthenon headers
 #include "../eos/adiabatic_glmmhd.hpp"
+#include "../hydro/cell_crossing_time.hpp"
+#include "../hydro/pack_cache.hpp"
 #include "../main.hpp"
 #include "config.hpp"
 #include "interface/variable.hpp"
@@ -30,27 +33,99 @@ using parthenon::ParArray4D;
 //           Container<Real> &rc,
 //           int il, int iu, int jl, int ju, int kl, int ku)
 // \brief Converts conserved into primitive variables in adiabatic hydro.
-void AdiabaticGLMMHDEOS::ConservedToPrimitive(MeshData<Real> *md) const {
-  auto const cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-  auto prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+template <typename Clip>
+void AdiabaticGLMMHDEOS::ConservedToPrimitive(MeshData<Real> *md,
+                                              const Clip &clip) const {
   auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
   auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
   auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
 
-  auto pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-  const auto nhydro = pkg->Param<int>("nhydro");
-  const auto nscalars = pkg->Param<int>("nscalars");
+  const auto &params = Hydro::pack_cache::GetParams();
+  const auto nhydro = params.nhydro;
+  const auto nscalars = params.nscalars;
+  // Sparse scalars (if enabled) follow the hydro variables in the packs
+  auto const cons_pack = Hydro::pack_cache::Cons(md);
+  auto prim_pack = Hydro::pack_cache::Prim(md);
 
   auto this_on_device = (*this);
 
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "ConservedToPrimitive", parthenon::DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      DEFAULT_LOOP_PATTERN, "EOS::AdiabaticGLMMHD::ConservedToPrimitive",
+      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e,
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
         const auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         // auto &nu = entropy_pack(b);
 
-        return this_on_device.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+        this_on_device.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+        if (clip(cons, prim, cons_pack.GetCoords(b), k, j, i)) {
+          this_on_device.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+        }
       });
 }
+
+//----------------------------------------------------------------------------------------
+// \!fn Real EquationOfState::ConservedToPrimitiveAndTimestep(MeshData<Real> *md)
+// \brief Same as ConservedToPrimitive but additionally returns the minimum hyperbolic
+// timestep (without cfl factor) over all interior cells of all blocks in md.
+template <typename Clip>
+Real AdiabaticGLMMHDEOS::ConservedToPrimitiveAndTimestep(MeshData<Real> *md,
+                                                       const Clip &clip) const {
+  auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+  auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+  auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+  auto ib_int = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  auto jb_int = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  auto kb_int = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  const auto &params = Hydro::pack_cache::GetParams();
+  const auto nhydro = params.nhydro;
+  const auto nscalars = params.nscalars;
+  // Sparse scalars (if enabled) follow the hydro variables in the packs
+  auto const cons_pack = Hydro::pack_cache::Cons(md);
+  auto prim_pack = Hydro::pack_cache::Prim(md);
+  const auto ndim = prim_pack.GetNdim();
+
+  auto this_on_device = (*this);
+
+  Real min_dt_hyperbolic = std::numeric_limits<Real>::max();
+  Kokkos::parallel_reduce(
+      "EOS::AdiabaticGLMMHD::ConservedToPrimitiveAndTimestep",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          parthenon::DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &min_dt) {
+        const auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+
+        this_on_device.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+        if (clip(cons, prim, cons_pack.GetCoords(b), k, j, i)) {
+          this_on_device.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+        }
+
+        // Ghost cells are converted but don't contribute to the timestep.
+        if (k < kb_int.s || k > kb_int.e || j < jb_int.s || j > jb_int.e ||
+            i < ib_int.s || i > ib_int.e) {
+          return;
+        }
+        min_dt = fmin(min_dt, Hydro::CellCrossingTime<Fluid::glmmhd>(
+                                  this_on_device, prim, prim_pack.GetCoords(b), ndim,
+                                  k, j, i));
+      },
+      Kokkos::Min<Real>(min_dt_hyperbolic));
+  return min_dt_hyperbolic;
+}
+
+// Instantiate the template definitions for the available clip policies
+template void
+AdiabaticGLMMHDEOS::ConservedToPrimitive(MeshData<Real> *md, const NoClip &clip) const;
+template void AdiabaticGLMMHDEOS::ConservedToPrimitive(MeshData<Real> *md,
+                                                       const RadialClip &clip) const;
+template Real
+AdiabaticGLMMHDEOS::ConservedToPrimitiveAndTimestep(MeshData<Real> *md,
+                                                    const NoClip &clip) const;
+template Real
+AdiabaticGLMMHDEOS::ConservedToPrimitiveAndTimestep(MeshData<Real> *md,
+                                                    const RadialClip &clip) const;
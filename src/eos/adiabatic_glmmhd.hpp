@@ -14,6 +14,7 @@
 
 // Athena headers
 #include "../main.hpp"
+#include "clips.hpp"
 #include "eos.hpp"
 
 using parthenon::MeshBlock;
@@ -29,7 +30,17 @@ class AdiabaticGLMMHDEOS : public EquationOfState {
                         internal_e_ceiling),
         gamma_{gamma} {}
 
-  void ConservedToPrimitive(MeshData<Real> *md) const override;
+  void ConservedToPrimitive(MeshData<Real> *md) const override {
+    ConservedToPrimitive(md, NoClip());
+  }
+  Real ConservedToPrimitiveAndTimestep(MeshData<Real> *md) const override {
+    return ConservedToPrimitiveAndTimestep(md, NoClip());
+  }
+  // Same as above but additionally applying clip in every cell (see clips.hpp)
+  template <typename Clip>
+  void ConservedToPrimitive(MeshData<Real> *md, const Clip &clip) const;
+  template <typename Clip>
+  Real ConservedToPrimitiveAndTimestep(MeshData<Real> *md, const Clip &clip) const;
 
   KOKKOS_INLINE_FUNCTION
   Real GetGamma() const { return gamma_; }
@@ -93,6 +104,10 @@ class AdiabaticGLMMHDEOS : public EquationOfState {
 
     // Let's apply floors explicitly, i.e., by default floor will be disabled (<=0)
     // and the code will fail if a negative density is encountered.
+    if (!(u_d > 0.0 || density_floor_ > 0.0) && CountFailure()) {
+      // Keeping the primitive variables as the step is retried
+      return;
+    }
     PARTHENON_REQUIRE(u_d > 0.0 || density_floor_ > 0.0,
                       "Got negative density. Consider enabling first-order flux "
                       "correction or setting a reasonble density floor.");
@@ -133,6 +148,9 @@ class AdiabaticGLMMHDEOS : public EquationOfState {
 
     // Let's apply floors explicitly, i.e., by default floor will be disabled (<=0)
     // and the code will fail if a negative pressure is encountered.
+    if (!(w_p > 0.0 || pressure_floor_ > 0.0 || e_floor_ > 0.0) && CountFailure()) {
+      return;
+    }
     PARTHENON_REQUIRE(w_p > 0.0 || pressure_floor_ > 0.0 || e_floor_ > 0.0,
                       "Got negative pressure. Consider enabling first-order flux "
                       "correction or setting a reasonble pressure or temperature floor.");
@@ -160,9 +178,11 @@ class AdiabaticGLMMHDEOS : public EquationOfState {
       w_p = eff_pressure_ceiling;
     }
 
-    // Convert passive scalars
+    // Convert passive scalars (skipping sparse scalars not allocated on the block)
     for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-      prim(n, k, j, i) = cons(n, k, j, i) * di;
+      if (cons.IsAllocated(n)) {
+        prim(n, k, j, i) = cons(n, k, j, i) * di;
+      }
     }
   }
 
@@ -15,6 +15,7 @@
 
 // Athena headers
 #include "../main.hpp"
+#include "clips.hpp"
 #include "eos.hpp"
 
 using parthenon::MeshBlock;
@@ -28,9 +29,19 @@ class AdiabaticHydroEOS : public EquationOfState {
                     Real velocity_ceiling, Real internal_e_ceiling, Real gamma)
       : EquationOfState(pressure_floor, density_floor, internal_e_floor, velocity_ceiling,
                         internal_e_ceiling),
-        gamma_{gamma} {}
+        gamma_{gamma}, igm1_{1.0 / (gamma - 1.0)} {}
 
-  void ConservedToPrimitive(MeshData<Real> *md) const override;
+  void ConservedToPrimitive(MeshData<Real> *md) const override {
+    ConservedToPrimitive(md, NoClip());
+  }
+  Real ConservedToPrimitiveAndTimestep(MeshData<Real> *md) const override {
+    return ConservedToPrimitiveAndTimestep(md, NoClip());
+  }
+  // Same as above but additionally applying clip in every cell (see clips.hpp)
+  template <typename Clip>
+  void ConservedToPrimitive(MeshData<Real> *md, const Clip &clip) const;
+  template <typename Clip>
+  Real ConservedToPrimitiveAndTimestep(MeshData<Real> *md, const Clip &clip) const;
 
   KOKKOS_INLINE_FUNCTION
   Real GetGamma() const { return gamma_; }
@@ -44,6 +55,28 @@ class AdiabaticHydroEOS : public EquationOfState {
     return std::sqrt(gamma_ * prim[IPR] / prim[IDN]);
   }
 
+  // The following functions are the interface shared with general equations of state
+  // (see tabulated_hydro.hpp) used in the EOS templated Riemann solvers.
+  // Pressure given density and internal energy density
+  KOKKOS_INLINE_FUNCTION
+  Real PressureFromInternalEnergy(const Real /*rho*/, const Real eint) const {
+    return (gamma_ - 1.0) * eint;
+  }
+
+  // Internal energy density given density and pressure
+  KOKKOS_INLINE_FUNCTION
+  Real InternalEnergyFromPressure(const Real /*rho*/, const Real p) const {
+    return p * igm1_;
+  }
+
+  // Sound speed of the Roe averaged state from q = H - v^2 / 2 (given the left and right
+  // sound speeds and the weight fl of the left state for general equations of state)
+  KOKKOS_INLINE_FUNCTION
+  Real RoeSoundSpeed(const Real q, const Real /*cl*/, const Real /*cr*/,
+                     const Real /*fl*/) const {
+    return (q < 0.0) ? 0.0 : std::sqrt((gamma_ - 1.0) * q);
+  }
+
   //----------------------------------------------------------------------------------------
   // \!fn Real EquationOfState::ConsToPrim(View4D cons, View4D prim, const int& k, const
   // int& j, const int& i) \brief Fills an array of primitives given an array of
@@ -74,6 +107,10 @@ class AdiabaticHydroEOS : public EquationOfState {
 
     // Let's apply floors explicitly, i.e., by default floor will be disabled (<=0)
     // and the code will fail if a negative density is encountered.
+    if (!(u_d > 0.0 || density_floor_ > 0.0) && CountFailure()) {
+      // Keeping the primitive variables as the step is retried
+      return;
+    }
     PARTHENON_REQUIRE(u_d > 0.0 || density_floor_ > 0.0,
                       "Got negative density. Consider enabling first-order flux "
                       "correction or setting a reasonble density floor.");
@@ -108,6 +145,9 @@ class AdiabaticHydroEOS : public EquationOfState {
 
     // Let's apply floors explicitly, i.e., by default floor will be disabled (<=0)
     // and the code will fail if a negative pressure is encountered.
+    if (!(w_p > 0.0 || pressure_floor_ > 0.0 || e_floor_ > 0.0) && CountFailure()) {
+      return;
+    }
     PARTHENON_REQUIRE(w_p > 0.0 || pressure_floor_ > 0.0 || e_floor_ > 0.0,
                       "Got negative pressure. Consider enabling first-order flux "
                       "correction or setting a reasonble pressure or temperature floor.");
@@ -135,14 +175,17 @@ class AdiabaticHydroEOS : public EquationOfState {
       w_p = eff_pressure_ceiling;
     }
 
-    // Convert passive scalars
+    // Convert passive scalars (skipping sparse scalars not allocated on the block)
     for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-      prim(n, k, j, i) = cons(n, k, j, i) * di;
+      if (cons.IsAllocated(n)) {
+        prim(n, k, j, i) = cons(n, k, j, i) * di;
+      }
     }
   }
 
  private:
   Real gamma_; // ratio of specific heats
+  Real igm1_;  // 1 / (gamma - 1)
 };
 
 #endif // EOS_ADIABATIC_HYDRO_HPP_
@@ -0,0 +1,137 @@
+#ifndef EOS_CLIPS_HPP_
+#define EOS_CLIPS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file clips.hpp
+//  \brief Clip policies that can be fused into the conversion to primitive variables
+//
+// A clip policy is called for every cell right after the conversion to primitive
+// variables and returns whether it modified the conserved variables of the cell (so that
+// the conversion is repeated for that cell). As the policy is a template parameter of
+// the conversion kernels, NoClip results in the same code as without any clip.
+
+// C++ headers
+#include <limits>
+
+// Parthenon headers
+#include <basic_types.hpp>
+#include <kokkos_abstraction.hpp>
+
+// AthenaPK headers
+#include "../main.hpp"
+
+struct NoClip {
+  template <typename View4D, typename Coords>
+  KOKKOS_FORCEINLINE_FUNCTION bool operator()(View4D /*cons*/, View4D /*prim*/,
+                                              const Coords & /*coords*/, const int /*k*/,
+                                              const int /*j*/, const int /*i*/) const {
+    return false;
+  }
+};
+
+// Density floor and velocity, Alfven velocity, and internal energy ceilings within a
+// radius around the origin (see the cluster problem generator). The added mass and
+// removed energy in interior cells are accumulated in sums.
+struct RadialClip {
+  // squared clip radius
+  parthenon::Real clip_r2;
+  parthenon::Real dfloor, vceil, vAceil, eceil, gm1;
+  bool magnetic_fields;
+  // interior cells of the blocks
+  parthenon::IndexRange ib, jb, kb;
+  // added_dfloor_mass, removed_vceil_energy, added_vAceil_mass, removed_eceil_energy
+  parthenon::ParArray1D<parthenon::Real> sums;
+
+  template <typename Coords>
+  KOKKOS_INLINE_FUNCTION bool Contains(const Coords &coords, const int k, const int j,
+                                       const int i) const {
+    const parthenon::Real r2 = SQR(coords.template Xc<1>(i)) +
+                               SQR(coords.template Xc<2>(j)) +
+                               SQR(coords.template Xc<3>(k));
+    return r2 < clip_r2;
+  }
+
+  template <typename View4D, typename Coords>
+  KOKKOS_INLINE_FUNCTION bool operator()(View4D cons, View4D prim, const Coords &coords,
+                                         const int k, const int j, const int i) const {
+    using parthenon::Real;
+    constexpr Real inf = std::numeric_limits<Real>::infinity();
+    if (!Contains(coords, k, j, i)) {
+      return false;
+    }
+    const bool interior =
+        k >= kb.s && k <= kb.e && j >= jb.s && j <= jb.e && i >= ib.s && i <= ib.e;
+    const Real vol = interior ? coords.CellVolume(k, j, i) : 0.0;
+    const auto add = [&](const int n, const Real value) {
+      if (interior) {
+        Kokkos::atomic_add(&sums(n), value * vol);
+      }
+    };
+    bool clipped = false;
+
+    if (dfloor > 0) {
+      const Real rho = prim(IDN, k, j, i);
+      if (rho < dfloor) {
+        add(0, dfloor - rho);
+        cons(IDN, k, j, i) = dfloor;
+        prim(IDN, k, j, i) = dfloor;
+        clipped = true;
+      }
+    }
+
+    if (vceil < inf) {
+      // Apply velocity ceiling
+      const Real v2 =
+          SQR(prim(IV1, k, j, i)) + SQR(prim(IV2, k, j, i)) + SQR(prim(IV3, k, j, i));
+      if (v2 > SQR(vceil)) {
+        // Fix the velocity to the velocity ceiling
+        const Real v = sqrt(v2);
+        cons(IM1, k, j, i) *= vceil / v;
+        cons(IM2, k, j, i) *= vceil / v;
+        cons(IM3, k, j, i) *= vceil / v;
+        prim(IV1, k, j, i) *= vceil / v;
+        prim(IV2, k, j, i) *= vceil / v;
+        prim(IV3, k, j, i) *= vceil / v;
+
+        // Remove kinetic energy
+        const Real removed_energy = 0.5 * prim(IDN, k, j, i) * (v2 - SQR(vceil));
+        add(1, removed_energy);
+        cons(IEN, k, j, i) -= removed_energy;
+        clipped = true;
+      }
+    }
+
+    if (magnetic_fields && vAceil < inf) {
+      // Apply Alfven velocity ceiling by raising density
+      const Real rho = prim(IDN, k, j, i);
+      const Real B2 =
+          SQR(prim(IB1, k, j, i)) + SQR(prim(IB2, k, j, i)) + SQR(prim(IB3, k, j, i));
+      if (B2 / rho > SQR(vAceil)) {
+        // Increase the density to match the alfven velocity ceiling
+        const Real rho_new = sqrt(B2 / SQR(vAceil));
+        add(2, rho_new - rho);
+        cons(IDN, k, j, i) = rho_new;
+        prim(IDN, k, j, i) = rho_new;
+        clipped = true;
+      }
+    }
+
+    if (eceil < inf) {
+      // Apply internal energy ceiling as a pressure ceiling
+      const Real internal_e = prim(IPR, k, j, i) / (gm1 * prim(IDN, k, j, i));
+      if (internal_e > eceil) {
+        const Real removed_energy = prim(IDN, k, j, i) * (internal_e - eceil);
+        add(3, removed_energy);
+        cons(IEN, k, j, i) -= removed_energy;
+        prim(IPR, k, j, i) = gm1 * prim(IDN, k, j, i) * eceil;
+        clipped = true;
+      }
+    }
+    return clipped;
+  }
+};
+
+#endif // EOS_CLIPS_HPP_
@@ -17,6 +17,9 @@
 // Parthenon headers
 #include "mesh/mesh.hpp"
 
+// AthenaPK headers
+#include "../utils/failure_counter.hpp"
+
 using parthenon::MeshBlock;
 using parthenon::MeshBlockData;
 using parthenon::MeshBlockVarPack;
@@ -38,6 +41,8 @@ class EquationOfState {
         internal_e_floor_(internal_e_floor), velocity_ceiling_(velocity_ceiling),
         internal_e_ceiling_(internal_e_ceiling) {}
   virtual void ConservedToPrimitive(MeshData<Real> *md) const = 0;
+  // Also returns the minimum hyperbolic timestep (without cfl factor) of md
+  virtual Real ConservedToPrimitiveAndTimestep(MeshData<Real> *md) const = 0;
 
   KOKKOS_INLINE_FUNCTION
   Real GetPressureFloor() const { return pressure_floor_; }
@@ -55,9 +60,18 @@ class EquationOfState {
   KOKKOS_INLINE_FUNCTION
   Real GetInternalECeiling() const { return internal_e_ceiling_; }
 
+  // Negative densities or pressures (without floors) are counted by the counter (if
+  // enabled) instead of aborting so that the step can be retried (see hydro/step_retry)
+  void SetFailureCounter(const utils::FailureCounter &failures) { failures_ = failures; }
+
+  // Returns whether the failure was counted, in which case ConsToPrim returns early
+  KOKKOS_INLINE_FUNCTION
+  bool CountFailure() const { return failures_.Count(); }
+
  private:
   Real pressure_floor_, density_floor_, internal_e_floor_;
   Real velocity_ceiling_, internal_e_ceiling_;
+  utils::FailureCounter failures_;
 };
 
 #endif // EOS_EOS_HPP_
@@ -0,0 +1,250 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file tabulated_hydro.cpp
+//  \brief Reading of the table and conversion to primitive variables of the general
+//  (tabulated) equation of state for hydrodynamics
+
+// C++ headers
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <interface/variable.hpp>
+#include <kokkos_abstraction.hpp>
+#include <mesh/domain.hpp>
+#include <outputs/io_wrapper.hpp>
+#include <utils/error_checking.hpp>
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+// AthenaPK headers
+#include "../hydro/cell_crossing_time.hpp"
+#include "../hydro/pack_cache.hpp"
+#include "../main.hpp"
+#include "tabulated_hydro.hpp"
+
+using parthenon::IndexDomain;
+
+TabulatedHydroEOS::TabulatedHydroEOS(parthenon::ParameterInput *pin,
+                                     Real pressure_floor, Real density_floor,
+                                     Real internal_e_floor, Real velocity_ceiling,
+                                     Real internal_e_ceiling)
+    : EquationOfState(pressure_floor, density_floor, internal_e_floor, velocity_ceiling,
+                      internal_e_ceiling) {
+  ReadTable(pin);
+}
+
+// The table is a text file (lines starting with # are comments) with a first line
+//   n_rho n_e log10_rho_min log10_rho_max log10_e_min log10_e_max
+// followed by n_rho * n_e lines (e varying fastest) of
+//   pressure Gamma_1
+// in code units at the log-uniform grid points in density and specific internal energy.
+void TabulatedHydroEOS::ReadTable(parthenon::ParameterInput *pin) {
+  const std::string table_filename = pin->GetString("hydro", "eos_table_filename");
+
+  // Only the master process reads the table and then broadcasts it
+  parthenon::IOWrapper input;
+  input.Open(table_filename.c_str(), parthenon::IOWrapper::FileMode::read);
+  std::stringstream tab_ss;
+  const int bufsize = 4096;
+  std::vector<char> buf(bufsize);
+  std::ptrdiff_t ret;
+  do {
+    if (parthenon::Globals::my_rank == 0) {
+      ret = input.Read(buf.data(), sizeof(char), bufsize);
+    }
+#ifdef MPI_PARALLEL
+    MPI_Bcast(&ret, sizeof(std::ptrdiff_t), MPI_BYTE, 0, MPI_COMM_WORLD);
+    MPI_Bcast(buf.data(), ret, MPI_BYTE, 0, MPI_COMM_WORLD);
+#endif
+    tab_ss.write(buf.data(), ret);
+  } while (ret == bufsize);
+  input.Close();
+
+  std::vector<Real> values;
+  std::string line;
+  while (std::getline(tab_ss, line)) {
+    const auto first_char = line.find_first_not_of(" \t");
+    if (first_char == std::string::npos || line[first_char] == '#') continue;
+    std::istringstream iss(line);
+    values.insert(values.end(), std::istream_iterator<Real>{iss},
+                  std::istream_iterator<Real>{});
+    PARTHENON_REQUIRE_THROWS(iss.eof(), "Cannot parse line \"" + line +
+                                            "\" of EOS table " + table_filename);
+  }
+  PARTHENON_REQUIRE_THROWS(values.size() >= 6,
+                           "Missing header line of EOS table " + table_filename);
+  n_rho_ = static_cast<int>(values[0]);
+  n_e_ = static_cast<int>(values[1]);
+  n_theta_ = n_e_;
+  PARTHENON_REQUIRE_THROWS(n_rho_ >= 2 && n_e_ >= 2 &&
+                               values[3] > values[2] && values[5] > values[4],
+                           "EOS table requires at least two points in increasing "
+                           "density and internal energy.");
+  PARTHENON_REQUIRE_THROWS(values.size() == 6 + 2 * n_rho_ * n_e_,
+                           "Expected n_rho * n_e lines of pressure and Gamma_1 in EOS "
+                           "table " + table_filename);
+  log_rho_min_ = values[2];
+  const Real dlog_rho = (values[3] - values[2]) / (n_rho_ - 1);
+  inv_dlog_rho_ = 1.0 / dlog_rho;
+  log_e_min_ = values[4];
+  const Real dlog_e = (values[5] - values[4]) / (n_e_ - 1);
+  inv_dlog_e_ = 1.0 / dlog_e;
+
+  // Gamma_e - 1 and Gamma_1 on the (rho, e) grid
+  std::vector<Real> gm1_e(n_rho_ * n_e_), gamma_1(n_rho_ * n_e_);
+  Real log_theta_min = std::numeric_limits<Real>::max();
+  Real log_theta_max = std::numeric_limits<Real>::lowest();
+  for (int n = 0; n < n_rho_; n++) {
+    const Real rho = std::pow(10.0, log_rho_min_ + n * dlog_rho);
+    for (int m = 0; m < n_e_; m++) {
+      const Real e = std::pow(10.0, log_e_min_ + m * dlog_e);
+      const Real p = values[6 + 2 * (n * n_e_ + m)];
+      gamma_1[n * n_e_ + m] = values[7 + 2 * (n * n_e_ + m)];
+      gm1_e[n * n_e_ + m] = p / (rho * e);
+      PARTHENON_REQUIRE_THROWS(p > 0.0 && gamma_1[n * n_e_ + m] > 0.0,
+                               "EOS table requires positive pressure and Gamma_1.");
+      PARTHENON_REQUIRE_THROWS(m == 0 || p > values[6 + 2 * (n * n_e_ + m - 1)],
+                               "Pressure in EOS table must increase with internal "
+                               "energy (at fixed density).");
+      log_theta_min = std::min(log_theta_min, std::log10(p / rho));
+      log_theta_max = std::max(log_theta_max, std::log10(p / rho));
+    }
+  }
+  log_theta_min_ = log_theta_min;
+  const Real dlog_theta = (log_theta_max - log_theta_min) / (n_theta_ - 1);
+  inv_dlog_theta_ = 1.0 / dlog_theta;
+
+  // Linear interpolation in log e at fixed tabulated density n
+  const auto interp_e = [&](const std::vector<Real> &table, const int n,
+                            const Real log_e) {
+    int m;
+    Real fm;
+    Locate(log_e, log_e_min_, inv_dlog_e_, n_e_, m, fm);
+    return (1.0 - fm) * table[n * n_e_ + m] + fm * table[n * n_e_ + m + 1];
+  };
+
+  table_e_ = parthenon::ParArray2D<float>("TabulatedHydroEOS::table_e", n_rho_, n_e_);
+  table_p_ =
+      parthenon::ParArray3D<float>("TabulatedHydroEOS::table_p", n_rho_, n_theta_, 2);
+  auto table_e_h = Kokkos::create_mirror_view(table_e_);
+  auto table_p_h = Kokkos::create_mirror_view(table_p_);
+  for (int n = 0; n < n_rho_; n++) {
+    for (int m = 0; m < n_e_; m++) {
+      table_e_h(n, m) = static_cast<float>(gm1_e[n * n_e_ + m]);
+    }
+    // Invert p / rho = (Gamma_e - 1) e (monotonic in e) by bisection in log e (with the
+    // constant extrapolation outside of the table as in the lookup)
+    for (int m = 0; m < n_theta_; m++) {
+      const Real theta = std::pow(10.0, log_theta_min_ + m * dlog_theta);
+      Real log_e_lo = log_e_min_;
+      Real log_e_hi = log_e_min_ + (n_e_ - 1) * dlog_e;
+      Real log_e;
+      if (theta <= gm1_e[n * n_e_] * std::pow(10.0, log_e_lo)) {
+        log_e = std::log10(theta / gm1_e[n * n_e_]);
+      } else if (theta >= gm1_e[n * n_e_ + n_e_ - 1] * std::pow(10.0, log_e_hi)) {
+        log_e = std::log10(theta / gm1_e[n * n_e_ + n_e_ - 1]);
+      } else {
+        for (int it = 0; it < 64; it++) {
+          log_e = 0.5 * (log_e_lo + log_e_hi);
+          if (interp_e(gm1_e, n, log_e) * std::pow(10.0, log_e) < theta) {
+            log_e_lo = log_e;
+          } else {
+            log_e_hi = log_e;
+          }
+        }
+        log_e = 0.5 * (log_e_lo + log_e_hi);
+      }
+      table_p_h(n, m, 0) = static_cast<float>(theta / std::pow(10.0, log_e));
+      table_p_h(n, m, 1) = static_cast<float>(interp_e(gamma_1, n, log_e));
+    }
+  }
+  Kokkos::deep_copy(table_e_, table_e_h);
+  Kokkos::deep_copy(table_p_, table_p_h);
+}
+
+//----------------------------------------------------------------------------------------
+// \!fn void EquationOfState::ConservedToPrimitive(MeshData<Real> *md)
+// \brief Converts conserved into primitive variables with the tabulated EOS.
+void TabulatedHydroEOS::ConservedToPrimitive(MeshData<Real> *md) const {
+  auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+  auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+  auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+
+  const auto &params = Hydro::pack_cache::GetParams();
+  const auto nhydro = params.nhydro;
+  const auto nscalars = params.nscalars;
+  // Sparse scalars (if enabled) follow the hydro variables in the packs
+  auto const cons_pack = Hydro::pack_cache::Cons(md);
+  auto prim_pack = Hydro::pack_cache::Prim(md);
+
+  auto this_on_device = (*this);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "EOS::TabulatedHydro::ConservedToPrimitive",
+      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+
+        this_on_device.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+      });
+}
+
+//----------------------------------------------------------------------------------------
+// \!fn Real EquationOfState::ConservedToPrimitiveAndTimestep(MeshData<Real> *md)
+// \brief Same as ConservedToPrimitive but additionally returns the minimum hyperbolic
+// timestep (without cfl factor) over all interior cells of all blocks in md.
+Real TabulatedHydroEOS::ConservedToPrimitiveAndTimestep(MeshData<Real> *md) const {
+  auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+  auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+  auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+  auto ib_int = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  auto jb_int = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  auto kb_int = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  const auto &params = Hydro::pack_cache::GetParams();
+  const auto nhydro = params.nhydro;
+  const auto nscalars = params.nscalars;
+  // Sparse scalars (if enabled) follow the hydro variables in the packs
+  auto const cons_pack = Hydro::pack_cache::Cons(md);
+  auto prim_pack = Hydro::pack_cache::Prim(md);
+  const auto ndim = params.ndim;
+
+  auto this_on_device = (*this);
+
+  Real min_dt_hyperbolic = std::numeric_limits<Real>::max();
+  Kokkos::parallel_reduce(
+      "EOS::TabulatedHydro::ConservedToPrimitiveAndTimestep",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          parthenon::DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &min_dt) {
+        const auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+
+        this_on_device.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+
+        // Ghost cells are converted but don't contribute to the timestep.
+        if (k < kb_int.s || k > kb_int.e || j < jb_int.s || j > jb_int.e ||
+            i < ib_int.s || i > ib_int.e) {
+          return;
+        }
+        min_dt = fmin(min_dt, Hydro::CellCrossingTime<Fluid::euler>(
+                                  this_on_device, prim, prim_pack.GetCoords(b), ndim,
+                                  k, j, i));
+      },
+      Kokkos::Min<Real>(min_dt_hyperbolic));
+  return min_dt_hyperbolic;
+}
@@ -0,0 +1,233 @@
+#ifndef EOS_TABULATED_HYDRO_HPP_
+#define EOS_TABULATED_HYDRO_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file tabulated_hydro.hpp
+//  \brief General (tabulated) equation of state for hydrodynamics
+//
+// The table provides the pressure p and the adiabatic index Gamma_1 (for the sound
+// speed c_s^2 = Gamma_1 p / rho) on a log-uniform grid in density and specific internal
+// energy e. Internally, only the effective index Gamma_e - 1 = p / (rho e) is stored in
+// single precision so that a lookup is an O(1) index calculation followed by a bilinear
+// interpolation in log space of a few cache lines. A second table of Gamma_e - 1 and
+// Gamma_1 (interleaved) on a log-uniform grid in density and p / rho is derived when
+// reading the table so that the inverse (internal energy from pressure) and the sound
+// speed from primitive variables are O(1) lookups, too. The inverse is refined by a few
+// Newton iterations on the interpolated p(e) so that it is consistent with the forward
+// lookup. Outside of the tabulated range the values at the edge of the table are used.
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+
+// Parthenon headers
+#include <kokkos_abstraction.hpp>
+#include <parameter_input.hpp>
+
+// AthenaPK headers
+#include "../main.hpp"
+#include "eos.hpp"
+
+using parthenon::Real;
+
+class TabulatedHydroEOS : public EquationOfState {
+ public:
+  TabulatedHydroEOS(parthenon::ParameterInput *pin, Real pressure_floor,
+                    Real density_floor, Real internal_e_floor, Real velocity_ceiling,
+                    Real internal_e_ceiling);
+
+  void ConservedToPrimitive(MeshData<Real> *md) const override;
+  Real ConservedToPrimitiveAndTimestep(MeshData<Real> *md) const override;
+
+  // Pressure given density and internal energy density
+  KOKKOS_INLINE_FUNCTION
+  Real PressureFromInternalEnergy(const Real rho, const Real eint) const {
+    int n, m;
+    Real fn, fm;
+    Locate(std::log10(rho), log_rho_min_, inv_dlog_rho_, n_rho_, n, fn);
+    Locate(std::log10(eint / rho), log_e_min_, inv_dlog_e_, n_e_, m, fm);
+    return Interpolate(table_e_, n, fn, m, fm) * eint;
+  }
+
+  // Internal energy density given density and pressure, i.e., the inverse of
+  // PressureFromInternalEnergy. The lookup in the (rho, p / rho) table is only used as
+  // initial guess for Newton iterations on the interpolated p(e) so that both directions
+  // are consistent to roundoff (and not only to the accuracy of the two tables).
+  KOKKOS_INLINE_FUNCTION
+  Real InternalEnergyFromPressure(const Real rho, const Real p) const {
+    int n, m;
+    Real fn, fm;
+    Locate(std::log10(rho), log_rho_min_, inv_dlog_rho_, n_rho_, n, fn);
+    Locate(std::log10(p / rho), log_theta_min_, inv_dlog_theta_, n_theta_, m, fm);
+    Real eint = p / Interpolate(table_p_, n, fn, m, fm, 0);
+    for (int it = 0; it < num_inversion_iter_; it++) {
+      // p = (Gamma_e - 1)(log e) eint with Gamma_e - 1 linear in log e within a cell
+      // (and constant outside of the table)
+      const Real log_e = std::log10(eint / rho);
+      const Real s = (log_e - log_e_min_) * inv_dlog_e_;
+      Locate(log_e, log_e_min_, inv_dlog_e_, n_e_, m, fm);
+      const Real gm1_lo = (1.0 - fn) * table_e_(n, m) + fn * table_e_(n + 1, m);
+      const Real gm1_hi =
+          (1.0 - fn) * table_e_(n, m + 1) + fn * table_e_(n + 1, m + 1);
+      const Real gm1 = (1.0 - fm) * gm1_lo + fm * gm1_hi;
+      const Real dgm1_dloge =
+          (s > 0.0 && s < n_e_ - 1.0) ? (gm1_hi - gm1_lo) * inv_dlog_e_ : 0.0;
+      const Real dp_deint = gm1 + dgm1_dloge / std::log(10.0);
+      eint -= (gm1 * eint - p) / dp_deint;
+    }
+    return eint;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  Real SoundSpeed(const Real prim[NHYDRO]) const {
+    int n, m;
+    Real fn, fm;
+    Locate(std::log10(prim[IDN]), log_rho_min_, inv_dlog_rho_, n_rho_, n, fn);
+    Locate(std::log10(prim[IPR] / prim[IDN]), log_theta_min_, inv_dlog_theta_, n_theta_,
+           m, fm);
+    return std::sqrt(Interpolate(table_p_, n, fn, m, fm, 1) * prim[IPR] / prim[IDN]);
+  }
+
+  // Sound speed of the Roe averaged state (with weight fl of the left state), see
+  // AdiabaticHydroEOS. For a general EOS the squared sound speeds are averaged.
+  KOKKOS_INLINE_FUNCTION
+  Real RoeSoundSpeed(const Real /*q*/, const Real cl, const Real cr,
+                     const Real fl) const {
+    return std::sqrt(fl * SQR(cl) + (1.0 - fl) * SQR(cr));
+  }
+
+  //----------------------------------------------------------------------------------------
+  // \!fn Real EquationOfState::ConsToPrim(View4D cons, View4D prim, const int& k, const
+  // int& j, const int& i) \brief Fills an array of primitives given an array of
+  // conserveds, potentially updating the conserved with floors
+  template <typename View4D>
+  KOKKOS_INLINE_FUNCTION void ConsToPrim(View4D cons, View4D prim, const int &nhydro,
+                                         const int &nscalars, const int &k, const int &j,
+                                         const int &i) const {
+    auto density_floor_ = GetDensityFloor();
+    auto pressure_floor_ = GetPressureFloor();
+    auto e_floor_ = GetInternalEFloor();
+
+    auto velocity_ceiling_ = GetVelocityCeiling();
+    auto e_ceiling_ = GetInternalECeiling();
+
+    Real &u_d = cons(IDN, k, j, i);
+    Real &u_m1 = cons(IM1, k, j, i);
+    Real &u_m2 = cons(IM2, k, j, i);
+    Real &u_m3 = cons(IM3, k, j, i);
+    Real &u_e = cons(IEN, k, j, i);
+
+    Real &w_d = prim(IDN, k, j, i);
+    Real &w_vx = prim(IV1, k, j, i);
+    Real &w_vy = prim(IV2, k, j, i);
+    Real &w_vz = prim(IV3, k, j, i);
+    Real &w_p = prim(IPR, k, j, i);
+
+    if (!(u_d > 0.0 || density_floor_ > 0.0) && CountFailure()) {
+      // Keeping the primitive variables as the step is retried
+      return;
+    }
+    PARTHENON_REQUIRE(u_d > 0.0 || density_floor_ > 0.0,
+                      "Got negative density. Consider enabling first-order flux "
+                      "correction or setting a reasonble density floor.");
+    u_d = (u_d > density_floor_) ? u_d : density_floor_;
+    w_d = u_d;
+
+    Real di = 1.0 / u_d;
+    w_vx = u_m1 * di;
+    w_vy = u_m2 * di;
+    w_vz = u_m3 * di;
+
+    Real e_k = 0.5 * di * (SQR(u_m1) + SQR(u_m2) + SQR(u_m3));
+
+    const Real w_v2 = SQR(w_vx) + SQR(w_vy) + SQR(w_vz);
+    if (w_v2 > SQR(velocity_ceiling_)) {
+      const Real w_v = sqrt(w_v2);
+      w_vx *= velocity_ceiling_ / w_v;
+      w_vy *= velocity_ceiling_ / w_v;
+      w_vz *= velocity_ceiling_ / w_v;
+
+      u_m1 *= velocity_ceiling_ / w_v;
+      u_m2 *= velocity_ceiling_ / w_v;
+      u_m3 *= velocity_ceiling_ / w_v;
+
+      Real e_k_new = 0.5 * u_d * SQR(velocity_ceiling_);
+      u_e -= e_k - e_k_new;
+      e_k = e_k_new;
+    }
+
+    // In contrast to the ideal gas, the table cannot be evaluated for a negative internal
+    // energy, so floors are applied to the internal energy first.
+    Real eint = u_e - e_k;
+    if (!(eint > 0.0 || pressure_floor_ > 0.0 || e_floor_ > 0.0) && CountFailure()) {
+      return;
+    }
+    PARTHENON_REQUIRE(eint > 0.0 || pressure_floor_ > 0.0 || e_floor_ > 0.0,
+                      "Got negative pressure. Consider enabling first-order flux "
+                      "correction or setting a reasonble pressure or temperature floor.");
+
+    // temperature (internal energy) based floor and ceiling
+    if (eint < u_d * e_floor_) {
+      eint = u_d * e_floor_;
+      u_e = eint + e_k;
+    } else if (eint > u_d * e_ceiling_) {
+      eint = u_d * e_ceiling_;
+      u_e = eint + e_k;
+    }
+    w_p = eint > 0.0 ? PressureFromInternalEnergy(u_d, eint) : 0.0;
+
+    // Pressure floor (if present)
+    if ((pressure_floor_ > 0.0) && (w_p < pressure_floor_)) {
+      u_e = InternalEnergyFromPressure(u_d, pressure_floor_) + e_k;
+      w_p = pressure_floor_;
+    }
+
+    // Convert passive scalars (skipping sparse scalars not allocated on the block)
+    for (auto n = nhydro; n < nhydro + nscalars; ++n) {
+      if (cons.IsAllocated(n)) {
+        prim(n, k, j, i) = cons(n, k, j, i) * di;
+      }
+    }
+  }
+
+ private:
+  // Index n (with 0 <= n <= num - 2) and fraction f of log value x in the table
+  KOKKOS_INLINE_FUNCTION
+  static void Locate(const Real x, const Real x_min, const Real inv_dx, const int num,
+                     int &n, Real &f) {
+    const Real s = std::min(std::max((x - x_min) * inv_dx, 0.0), num - 1.0);
+    n = std::min(static_cast<int>(s), num - 2);
+    f = s - n;
+  }
+
+  // Bilinear interpolation in table (with the quantity index q of the p / rho table)
+  template <typename Table, typename... Q>
+  KOKKOS_INLINE_FUNCTION static Real Interpolate(const Table &table, const int n,
+                                                 const Real fn, const int m,
+                                                 const Real fm, const Q... q) {
+    return (1.0 - fn) * ((1.0 - fm) * table(n, m, q...) + fm * table(n, m + 1, q...)) +
+           fn * ((1.0 - fm) * table(n + 1, m, q...) + fm * table(n + 1, m + 1, q...));
+  }
+
+  void ReadTable(parthenon::ParameterInput *pin);
+
+  // The initial guess is accurate to the single precision of the tables so that two
+  // Newton iterations give double precision (a third one covers kinks at grid points).
+  static constexpr int num_inversion_iter_ = 3;
+
+  int n_rho_, n_e_, n_theta_;
+  // log10 of the lower end and inverse spacing of the density, specific internal
+  // energy, and p / rho grids
+  Real log_rho_min_, inv_dlog_rho_;
+  Real log_e_min_, inv_dlog_e_;
+  Real log_theta_min_, inv_dlog_theta_;
+  // Gamma_e - 1 on the (rho, e) grid and (Gamma_e - 1, Gamma_1) on the (rho, p / rho)
+  // grid
+  parthenon::ParArray2D<float> table_e_;
+  parthenon::ParArray3D<float> table_p_;
+};
+
+#endif // EOS_TABULATED_HYDRO_HPP_
@@ -0,0 +1,227 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file autotune.cpp
+//! \brief Startup tuning of the launch parameters of the hyperbolic flux kernels
+
+// C++ headers
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+#include "globals.hpp"
+
+// AthenaPK headers
+#include "../main.hpp"
+#include "autotune.hpp"
+#include "hydro.hpp"
+#include "pack_cache.hpp"
+
+using namespace parthenon::package::prelude;
+
+namespace Hydro {
+
+namespace {
+struct FluxLaunchConfig {
+  int scratch_level;
+  int tile_sweep;
+  int tile_transverse;
+};
+
+// Only depends on global quantities as rank 0 looks up the key for all ranks
+std::string GetAutotuneKey(Mesh *pmesh, MeshData<Real> *md) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  // The timed partition with the most blocks (i.e., the slowest) over all ranks
+  int max_pack_blocks = md->NumBlocks();
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &max_pack_blocks, 1, MPI_INT, MPI_MAX,
+                                    MPI_COMM_WORLD));
+#endif
+  std::stringstream key;
+  // Concurrency is used to (roughly) distinguish different devices/CPU partitions using
+  // the same execution space.
+  key << parthenon::DevExecSpace::name() << "-" << parthenon::DevExecSpace().concurrency()
+      << "_fluid" << static_cast<int>(hydro_pkg->Param<Fluid>("fluid")) << "_recon"
+      << static_cast<int>(hydro_pkg->Param<Reconstruction>("reconstruction"))
+      << "_"
+      << static_cast<int>(hydro_pkg->Param<Reconstruction>("reconstruction_scalars"))
+      << "_riemann" << static_cast<int>(hydro_pkg->Param<RiemannSolver>("riemann"))
+      << "_nvars" << hydro_pkg->Param<int>("nhydro") + hydro_pkg->Param<int>("nscalars")
+      << "_block" << pmb->block_size.nx(X1DIR) << "x" << pmb->block_size.nx(X2DIR) << "x"
+      << pmb->block_size.nx(X3DIR) << "_nblocks" << pmesh->nbtotal << "_pack"
+      << max_pack_blocks;
+  return key.str();
+}
+
+// Only rank 0 reads the file. Returns true if the key was found.
+bool ReadCachedConfig(const std::string &fname, const std::string &key,
+                      FluxLaunchConfig &cfg) {
+  int found = 0;
+  int values[3] = {0, 0, 1};
+  if (parthenon::Globals::my_rank == 0 && !fname.empty()) {
+    std::ifstream infile(fname);
+    std::string line;
+    while (std::getline(infile, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      std::istringstream iss(line);
+      std::string line_key;
+      int scratch_level, tile_sweep, tile_transverse;
+      if ((iss >> line_key >> scratch_level >> tile_sweep >> tile_transverse) &&
+          line_key == key) {
+        // Keep going so that the last entry for a key wins.
+        found = 1;
+        values[0] = scratch_level;
+        values[1] = tile_sweep;
+        values[2] = tile_transverse;
+      }
+    }
+  }
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Bcast(&found, 1, MPI_INT, 0, MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Bcast(values, 3, MPI_INT, 0, MPI_COMM_WORLD));
+#endif
+  cfg.scratch_level = values[0];
+  cfg.tile_sweep = values[1];
+  cfg.tile_transverse = values[2];
+  return found == 1;
+}
+
+void ApplyConfig(StateDescriptor *hydro_pkg, const FluxLaunchConfig &cfg) {
+  hydro_pkg->UpdateParam("scratch_level", cfg.scratch_level);
+  hydro_pkg->UpdateParam("flux_tile_sweep", cfg.tile_sweep);
+  hydro_pkg->UpdateParam("flux_tile_transverse", cfg.tile_transverse);
+  pack_cache::UpdateLaunchParams(hydro_pkg);
+}
+} // namespace
+
+void AutotuneFluxKernels(Mesh *pmesh) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  auto &md = pmesh->mesh_data.GetOrAdd("base", 0);
+  const auto key = GetAutotuneKey(pmesh, md.get());
+  const auto &cache_file = hydro_pkg->Param<std::string>("autotune_cache_file");
+
+  FluxLaunchConfig best_cfg;
+  if (ReadCachedConfig(cache_file, key, best_cfg)) {
+    ApplyConfig(hydro_pkg.get(), best_cfg);
+    if (parthenon::Globals::my_rank == 0) {
+      std::cout << "Autotune: using cached flux kernel config for " << key
+                << ": scratch_level=" << best_cfg.scratch_level
+                << " flux_tile_sweep=" << best_cfg.tile_sweep
+                << " flux_tile_transverse=" << best_cfg.tile_transverse << std::endl;
+    }
+    return;
+  }
+
+  // Assemble candidates
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  const int ndim = pmesh->ndim;
+  const int nx1 = pmb->cellbounds.ncellsi(IndexDomain::entire);
+  const int num_scratch_vars =
+      hydro_pkg->Param<int>("nhydro") + hydro_pkg->Param<int>("nscalars");
+  // per pencil of a tile of the x2 and x3 kernels
+  const size_t scratch_size_in_bytes =
+      parthenon::ScratchPad2D<ScratchReal>::shmem_size(num_scratch_vars, nx1) * 3;
+  const std::vector<int> scratch_levels = {0, 1};
+
+  std::vector<int> tiles_sweep = {-1};
+  if (ndim >= 2) {
+    // smallest extent of the sweep direction over the x2 and x3 kernels
+    int nx_sweep = pmb->block_size.nx(X2DIR);
+    if (ndim >= 3) {
+      nx_sweep = std::min(nx_sweep, pmb->block_size.nx(X3DIR));
+    }
+    // Splitting the sweep direction is not supported with the fused update.
+    if (!hydro_pkg->Param<bool>("fused_update")) {
+      for (const auto tile : {4, 8, 16}) {
+        if (tile < nx_sweep) {
+          tiles_sweep.push_back(tile);
+        }
+      }
+    }
+  }
+
+  // Tiles of several pencils in the transverse direction only exist in 3D (the
+  // transverse direction of the x2 sweep is x3).
+  std::vector<int> tiles_transverse = {1};
+  if (ndim >= 3) {
+    const int nx_transverse =
+        std::min(pmb->block_size.nx(X2DIR), pmb->block_size.nx(X3DIR));
+    for (int tile = 2; tile <= max_flux_tile_transverse; tile *= 2) {
+      if (tile <= nx_transverse) {
+        tiles_transverse.push_back(tile);
+      }
+    }
+  }
+
+  FluxFun_t *calc_flux_fun = hydro_pkg->Param<FluxFun_t *>("flux_other_stage");
+  const auto num_repeat = hydro_pkg->Param<int>("autotune_num_repeat");
+
+  // Flux kernels only write fluxes (which are recalculated in every stage), so they can
+  // be safely called on the actual data.
+  auto time_config = [&](const FluxLaunchConfig &cfg) {
+    ApplyConfig(hydro_pkg.get(), cfg);
+    // warm up
+    calc_flux_fun(md, nullptr, 0.0, 0.0, 0.0, BlockRegion::all);
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    for (int n = 0; n < num_repeat; n++) {
+      calc_flux_fun(md, nullptr, 0.0, 0.0, 0.0, BlockRegion::all);
+    }
+    Kokkos::fence();
+    Real elapsed = timer.seconds();
+#ifdef MPI_PARALLEL
+    // use slowest rank so that all ranks pick the same config
+    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_PARTHENON_REAL,
+                                      MPI_MAX, MPI_COMM_WORLD));
+#endif
+    return elapsed;
+  };
+
+  Real best_time = std::numeric_limits<Real>::max();
+  for (const auto scratch_level : scratch_levels) {
+    for (const auto tile_transverse : tiles_transverse) {
+      // Skip tiles that do not fit into the (small) level 0 scratch space
+      if (scratch_level == 0 &&
+          static_cast<int>(scratch_size_in_bytes * tile_transverse) >
+              Kokkos::TeamPolicy<parthenon::DevExecSpace>::scratch_size_max(0)) {
+        continue;
+      }
+      for (const auto tile_sweep : tiles_sweep) {
+        const FluxLaunchConfig cfg{scratch_level, tile_sweep, tile_transverse};
+        const auto elapsed = time_config(cfg);
+        if (elapsed < best_time) {
+          best_time = elapsed;
+          best_cfg = cfg;
+        }
+      }
+    }
+  }
+  ApplyConfig(hydro_pkg.get(), best_cfg);
+
+  if (parthenon::Globals::my_rank == 0) {
+    std::cout << "Autotune: selected flux kernel config for " << key
+              << ": scratch_level=" << best_cfg.scratch_level
+              << " flux_tile_sweep=" << best_cfg.tile_sweep
+              << " flux_tile_transverse=" << best_cfg.tile_transverse << " ("
+              << best_time / num_repeat << " s per call)" << std::endl;
+    if (!cache_file.empty()) {
+      std::ofstream outfile(cache_file, std::ios::app);
+      outfile << key << " " << best_cfg.scratch_level << " " << best_cfg.tile_sweep << " "
+              << best_cfg.tile_transverse << std::endl;
+    }
+  }
+}
+
+} // namespace Hydro
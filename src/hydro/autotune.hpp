@@ -0,0 +1,28 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file autotune.hpp
+//! \brief Startup tuning of the launch parameters of the hyperbolic flux kernels
+
+#ifndef HYDRO_AUTOTUNE_HPP_
+#define HYDRO_AUTOTUNE_HPP_
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+using namespace parthenon::package::prelude;
+
+namespace Hydro {
+
+// Selects the fastest combination of scratch_level, flux_tile_sweep, and
+// flux_tile_transverse for the flux function of the current setup by timing it on the
+// first MeshData partition and updates the Hydro params accordingly.
+// Results are read from/appended to the hydro/autotune_cache_file (if not empty) using a
+// key based on the execution space, the flux function, and the block (pack) size.
+void AutotuneFluxKernels(Mesh *pmesh);
+
+} // namespace Hydro
+
+#endif // HYDRO_AUTOTUNE_HPP_
@@ -0,0 +1,68 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file cell_crossing_time.hpp
+//! \brief Per cell hyperbolic crossing time shared by the timestep estimate and the
+//! fused conversion to primitive variables
+
+#ifndef HYDRO_CELL_CROSSING_TIME_HPP_
+#define HYDRO_CELL_CROSSING_TIME_HPP_
+
+// C++ headers
+#include <cmath>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../main.hpp"
+
+namespace Hydro {
+
+// Minimum time (without cfl) for the fastest hyperbolic signal to cross cell (k, j, i)
+template <Fluid fluid, typename EOS, typename T>
+KOKKOS_INLINE_FUNCTION Real CellCrossingTime(const EOS &eos, const T &prim,
+                                             const parthenon::Coordinates_t &coords,
+                                             const int ndim, const int k, const int j,
+                                             const int i) {
+  Real w[(NHYDRO)];
+  w[IDN] = prim(IDN, k, j, i);
+  w[IV1] = prim(IV1, k, j, i);
+  w[IV2] = prim(IV2, k, j, i);
+  w[IV3] = prim(IV3, k, j, i);
+  w[IPR] = prim(IPR, k, j, i);
+  Real lambda_max_x, lambda_max_y, lambda_max_z;
+  if constexpr (fluid == Fluid::euler) {
+    lambda_max_x = eos.SoundSpeed(w);
+    lambda_max_y = lambda_max_x;
+    lambda_max_z = lambda_max_x;
+
+  } else if constexpr (fluid == Fluid::glmmhd) {
+    lambda_max_x = eos.FastMagnetosonicSpeed(w[IDN], w[IPR], prim(IB1, k, j, i),
+                                             prim(IB2, k, j, i), prim(IB3, k, j, i));
+    if (ndim > 1) {
+      lambda_max_y = eos.FastMagnetosonicSpeed(w[IDN], w[IPR], prim(IB2, k, j, i),
+                                               prim(IB3, k, j, i), prim(IB1, k, j, i));
+    }
+    if (ndim > 2) {
+      lambda_max_z = eos.FastMagnetosonicSpeed(w[IDN], w[IPR], prim(IB3, k, j, i),
+                                               prim(IB1, k, j, i), prim(IB2, k, j, i));
+    }
+  } else {
+    PARTHENON_FAIL("Unknown fluid in EstimateTimestep");
+  }
+  Real min_dt = coords.Dxc<1>(k, j, i) / (fabs(w[IV1]) + lambda_max_x);
+  if (ndim > 1) {
+    min_dt = fmin(min_dt, coords.Dxc<2>(k, j, i) / (fabs(w[IV2]) + lambda_max_y));
+  }
+  if (ndim > 2) {
+    min_dt = fmin(min_dt, coords.Dxc<3>(k, j, i) / (fabs(w[IV3]) + lambda_max_z));
+  }
+  return min_dt;
+}
+
+} // namespace Hydro
+
+#endif // HYDRO_CELL_CROSSING_TIME_HPP_
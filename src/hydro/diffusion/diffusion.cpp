@@ -6,48 +6,289 @@
 //! \file diffusion.cpp
 //! \brief
 
+// C++ headers
+#include <string>
+#include <utility>
+#include <vector>
+
 // Parthenon headers
 #include <parthenon/package.hpp>
 
 // AthenaPK headers
 #include "../../main.hpp"
+#include "../../utils/profiling.hpp"
+#include "../hydro.hpp"
 #include "diffusion.hpp"
+#include "diffusion_fluxes.hpp"
 
 using namespace parthenon::package::prelude;
 
-TaskStatus CalcDiffFluxes(StateDescriptor *hydro_pkg, MeshData<Real> *md) {
+namespace {
+// Calculate the face-centered primitive variables of all faces in the region.
+DiffusionFaceCache FillFaceCache(StateDescriptor *hydro_pkg, MeshData<Real> *md,
+                                 const BlockRim &faces) {
+  DiffusionFaceCache face_cache;
+  face_cache.enabled = hydro_pkg->Param<bool>("diffusion_face_cache");
+  if (!face_cache.enabled) {
+    return face_cache;
+  }
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  const int ndim = pmb->pmy_mesh->ndim;
+
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  // Magnetic fields are only used by anisotropic conduction and resistivity (both MHD).
+  const int nvar = hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd ? IB3 + 1 : IPR + 1;
+
+  face_cache.data = parthenon::ParArray6D<Real>(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "diffusion face cache"), ndim, nvar,
+      prim_pack.GetDim(5), pmb->cellbounds.ncellsk(IndexDomain::entire),
+      pmb->cellbounds.ncellsj(IndexDomain::entire),
+      pmb->cellbounds.ncellsi(IndexDomain::entire));
+  auto data = face_cache.data;
+
+  // Single pass over the (upper bounds of the) faces of all directions so that each cell
+  // is only loaded once.
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Diffusion::FillFaceCache", DevExecSpace(), 0,
+      prim_pack.GetDim(5) - 1, kb.s, kb.e + (ndim > 2), jb.s, jb.e + (ndim > 1), ib.s,
+      ib.e + 1, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        if (!faces.ContainsBlock(b)) {
+          return;
+        }
+        const auto &prim = prim_pack(b);
+        const bool in_j = j <= jb.e;
+        const bool in_k = k <= kb.e;
+        if (in_j && in_k && faces.ContainsFace<X1DIR>(k, j, i)) {
+          for (int v = 0; v < nvar; v++) {
+            data(0, v, b, k, j, i) = 0.5 * (prim(v, k, j, i) + prim(v, k, j, i - 1));
+          }
+        }
+        if (ndim > 1 && i <= ib.e && in_k && faces.ContainsFace<X2DIR>(k, j, i)) {
+          for (int v = 0; v < nvar; v++) {
+            data(1, v, b, k, j, i) = 0.5 * (prim(v, k, j, i) + prim(v, k, j - 1, i));
+          }
+        }
+        if (ndim > 2 && i <= ib.e && in_j && faces.ContainsFace<X3DIR>(k, j, i)) {
+          for (int v = 0; v < nvar; v++) {
+            data(2, v, b, k, j, i) = 0.5 * (prim(v, k, j, i) + prim(v, k - 1, j, i));
+          }
+        }
+      });
+  return face_cache;
+}
+
+// Flux calculation of thermal conduction
+enum class ThermalFlux { none, iso_fixed, general };
+
+// Coefficients of the processes that are used in the flux kernels
+struct DiffusionCoeffs {
+  ThermalDiffusivity thermal_diff;
+  Real thermal_diff_coeff; // only for iso_fixed
+  Real flux_sat_prefac;
+  bool use_coeff_field;
+  Real nu;  // fixed kinematic viscosity
+  Real eta; // fixed Ohmic diffusivity
+};
+
+// Add the fluxes of the given (compile time) combination of processes to all XNDIR faces
+// in the region in a single kernel (specialized on the number of dimensions NDIM).
+template <int XNDIR, int NDIM, ThermalFlux COND, bool VISC, bool OHM>
+void AddDiffFluxes(MeshData<Real> *md, const bool overwrite, const BlockRim &faces,
+                   const DiffusionFaceCache &face_cache, const DiffusionCoeffs &coeffs,
+                   const std::string &label) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  constexpr int ndim = NDIM;
+
+  const auto &cons_names = pmb->packages.Get("Hydro")->Param<std::vector<std::string>>(
+      "cons_names");
+  auto cons_pack = md->PackVariablesAndFluxes(cons_names, cons_names);
+  // number of variables to reset in overwrite mode
+  const int nvar = cons_pack.GetDim(4);
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  // only packed and used if enabled
+  const auto &coeff_pack = md->PackVariables(std::vector<std::string>{"thermal_diff"});
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, label, DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s,
+      kb.e + (XNDIR == X3DIR), jb.s, jb.e + (XNDIR == X2DIR), ib.s,
+      ib.e + (XNDIR == X1DIR),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        if (!faces.ContainsBlock(b) || !faces.ContainsFace<XNDIR>(k, j, i)) {
+          return;
+        }
+        auto &cons = cons_pack(b);
+        DiffusiveFaceFlux flx;
+        if (overwrite) {
+          ResetFaceFluxes<XNDIR>(cons, nvar, k, j, i);
+        } else {
+          flx.Load<XNDIR, VISC, OHM>(cons, k, j, i);
+        }
+        const auto &coords = prim_pack.GetCoords(b);
+        const auto &prim = prim_pack(b);
+
+        // Same order as with separate kernels so that the results are identical.
+        if constexpr (COND == ThermalFlux::iso_fixed) {
+          AddThermalFluxIsoFixed<XNDIR>(flx, prim, coords, face_cache,
+                                        coeffs.thermal_diff_coeff, b, k, j, i);
+        } else if constexpr (COND == ThermalFlux::general) {
+          AddThermalFluxGeneral<XNDIR>(flx, prim, coeff_pack, coords, face_cache,
+                                       coeffs.thermal_diff, coeffs.flux_sat_prefac,
+                                       coeffs.use_coeff_field, ndim, b, k, j, i);
+        }
+        if constexpr (VISC) {
+          AddMomentumDiffFluxIsoFixed<XNDIR>(flx, prim, coords, face_cache, coeffs.nu,
+                                             ndim, b, k, j, i);
+        }
+        if constexpr (OHM) {
+          AddOhmicDiffFluxIsoFixed<XNDIR>(flx, prim, coords, face_cache, coeffs.eta, ndim,
+                                          b, k, j, i);
+        }
+        flx.Store<XNDIR, VISC, OHM>(cons, k, j, i);
+      });
+}
+
+template <int NDIM, ThermalFlux COND, bool VISC, bool OHM>
+void AddDiffFluxesNDim(MeshData<Real> *md, const bool overwrite, const BlockRim &faces,
+                       const DiffusionFaceCache &face_cache,
+                       const DiffusionCoeffs &coeffs, const std::string &label) {
+  AddDiffFluxes<X1DIR, NDIM, COND, VISC, OHM>(md, overwrite, faces, face_cache, coeffs,
+                                              label + "::X1Fluxes");
+  if constexpr (NDIM > 1) {
+    AddDiffFluxes<X2DIR, NDIM, COND, VISC, OHM>(md, overwrite, faces, face_cache, coeffs,
+                                                label + "::X2Fluxes");
+  }
+  if constexpr (NDIM > 2) {
+    AddDiffFluxes<X3DIR, NDIM, COND, VISC, OHM>(md, overwrite, faces, face_cache, coeffs,
+                                                label + "::X3Fluxes");
+  }
+}
+
+template <ThermalFlux COND, bool VISC, bool OHM>
+void AddDiffFluxes(MeshData<Real> *md, const bool overwrite, const BlockRim &faces,
+                   const DiffusionFaceCache &face_cache, const DiffusionCoeffs &coeffs,
+                   const std::string &label) {
+  Hydro::DispatchNDim(faces.ndim, [&](auto dim) {
+    AddDiffFluxesNDim<decltype(dim)::value, COND, VISC, OHM>(md, overwrite, faces,
+                                                             face_cache, coeffs, label);
+  });
+}
+
+// Translate the runtime combination of processes to the template parameters
+template <ThermalFlux COND, bool VISC, typename... Args>
+void DispatchOhm(const bool ohm, Args &&...args) {
+  if (ohm) {
+    AddDiffFluxes<COND, VISC, true>(std::forward<Args>(args)...);
+  } else {
+    AddDiffFluxes<COND, VISC, false>(std::forward<Args>(args)...);
+  }
+}
+
+template <ThermalFlux COND, typename... Args>
+void DispatchVisc(const bool visc, const bool ohm, Args &&...args) {
+  if (visc) {
+    DispatchOhm<COND, true>(ohm, std::forward<Args>(args)...);
+  } else {
+    DispatchOhm<COND, false>(ohm, std::forward<Args>(args)...);
+  }
+}
+
+template <typename... Args>
+void DispatchDiffFluxes(const ThermalFlux cond, const bool visc, const bool ohm,
+                        Args &&...args) {
+  if (cond == ThermalFlux::iso_fixed) {
+    DispatchVisc<ThermalFlux::iso_fixed>(visc, ohm, std::forward<Args>(args)...);
+  } else if (cond == ThermalFlux::general) {
+    DispatchVisc<ThermalFlux::general>(visc, ohm, std::forward<Args>(args)...);
+  } else {
+    DispatchVisc<ThermalFlux::none>(visc, ohm, std::forward<Args>(args)...);
+  }
+}
+} // namespace
+
+TaskStatus CalcDiffFluxes(StateDescriptor *hydro_pkg, MeshData<Real> *md,
+                          const bool overwrite, const BlockRegion region,
+                          const int sts_stage) {
+  utils::profiling::ScopedRegion profiling_region("Diffusion::CalcDiffFluxes");
+  const BlockRim faces(md, region, sts_stage);
+  // Shared by all processes. Calculated per call (and not per stage) as the rim cells are
+  // updated in between with sts_overlap_comm.
+  const auto face_cache = FillFaceCache(hydro_pkg, md, faces);
+
+  DiffusionCoeffs coeffs{ThermalDiffusivity(Conduction::none, ConductionCoeff::none, 0.0,
+                                            0.0, 0.0, 0.0),
+                         0.0,
+                         0.0,
+                         hydro_pkg->Param<bool>("diffusion_coeff_field"),
+                         0.0,
+                         0.0};
+  auto cond = ThermalFlux::none;
   const auto &conduction = hydro_pkg->Param<Conduction>("conduction");
   if (conduction != Conduction::none) {
-    const auto &thermal_diff = hydro_pkg->Param<ThermalDiffusivity>("thermal_diff");
+    coeffs.thermal_diff = hydro_pkg->Param<ThermalDiffusivity>("thermal_diff");
+    coeffs.flux_sat_prefac = hydro_pkg->Param<Real>("conduction_sat_prefac");
 
     if (conduction == Conduction::isotropic &&
-        thermal_diff.GetCoeffType() == ConductionCoeff::fixed) {
-      ThermalFluxIsoFixed(md);
+        coeffs.thermal_diff.GetCoeffType() == ConductionCoeff::fixed) {
+      cond = ThermalFlux::iso_fixed;
+      // Using fixed and uniform coefficient so it's safe to get it outside the kernel.
+      // Using 0.0 as parameters rho and p as they're not used anyway for a fixed coeff.
+      coeffs.thermal_diff_coeff = coeffs.thermal_diff.Get(0.0, 0.0);
     } else {
-      ThermalFluxGeneral(md);
+      cond = ThermalFlux::general;
     }
   }
   const auto &viscosity = hydro_pkg->Param<Viscosity>("viscosity");
-  if (viscosity != Viscosity::none) {
+  const bool visc = viscosity != Viscosity::none;
+  if (visc) {
     const auto &mom_diff = hydro_pkg->Param<MomentumDiffusivity>("mom_diff");
-
-    if (viscosity == Viscosity::isotropic &&
-        mom_diff.GetCoeffType() == ViscosityCoeff::fixed) {
-      MomentumDiffFluxIsoFixed(md);
-    } else {
-      MomentumDiffFluxGeneral(md);
-    }
+    // TODO(pgrete) Calculate momentum diffusion, general case, i.e., anisotropic and/or
+    // with varying coefficient
+    PARTHENON_REQUIRE_THROWS(viscosity == Viscosity::isotropic &&
+                                 mom_diff.GetCoeffType() == ViscosityCoeff::fixed,
+                             "Needs impl.");
+    coeffs.nu = mom_diff.Get(0.0, 0.0);
   }
   const auto &resistivity = hydro_pkg->Param<Resistivity>("resistivity");
-  if (resistivity != Resistivity::none) {
+  const bool ohm = resistivity != Resistivity::none;
+  if (ohm) {
     const auto &ohm_diff = hydro_pkg->Param<OhmicDiffusivity>("ohm_diff");
+    // TODO(pgrete) Calculate Ohmic diffusion, general case, e.g., with varying (Spitzer)
+    // coefficient
+    PARTHENON_REQUIRE_THROWS(resistivity == Resistivity::ohmic &&
+                                 ohm_diff.GetCoeffType() == ResistivityCoeff::fixed,
+                             "Needs impl.");
+    coeffs.eta = ohm_diff.Get(0.0, 0.0);
+  }
+  PARTHENON_REQUIRE(!overwrite || cond != ThermalFlux::none || visc || ohm,
+                    "Diffusive fluxes in overwrite mode require an active process.");
 
-    if (resistivity == Resistivity::ohmic &&
-        ohm_diff.GetCoeffType() == ResistivityCoeff::fixed) {
-      OhmicDiffFluxIsoFixed(md);
-    } else {
-      OhmicDiffFluxGeneral(md);
-    }
+  if (hydro_pkg->Param<bool>("diffusion_fused_fluxes")) {
+    DispatchDiffFluxes(cond, visc, ohm, md, overwrite, faces, face_cache, coeffs,
+                       "Diffusion::Fused");
+    return TaskStatus::complete;
+  }
+
+  // Only the first active process overwrites, all following ones add their fluxes.
+  bool overwrite_fluxes = overwrite;
+  if (cond != ThermalFlux::none) {
+    DispatchDiffFluxes(cond, false, false, md, overwrite_fluxes, faces, face_cache,
+                       coeffs, "Diffusion::Conduction");
+    overwrite_fluxes = false;
+  }
+  if (visc) {
+    DispatchDiffFluxes(ThermalFlux::none, true, false, md, overwrite_fluxes, faces,
+                       face_cache, coeffs, "Diffusion::Viscosity");
+    overwrite_fluxes = false;
+  }
+  if (ohm) {
+    DispatchDiffFluxes(ThermalFlux::none, false, true, md, overwrite_fluxes, faces,
+                       face_cache, coeffs, "Diffusion::Resistivity");
   }
   return TaskStatus::complete;
 }
@@ -9,6 +9,9 @@
 #ifndef HYDRO_DIFFUSION_DIFFUSION_HPP_
 #define HYDRO_DIFFUSION_DIFFUSION_HPP_
 
+// C++ headers
+#include <map>
+
 // Parthenon headers
 #include <parthenon/package.hpp>
 
@@ -67,6 +70,92 @@ KOKKOS_INLINE_FUNCTION Real lim4(const Real A, const Real B, const Real C, const
 }
 } // namespace limiters
 
+// The rim consists of all interior cells within `width` cells of a block face (in active
+// dimensions), i.e., all cells that are (potentially) sent to neighbors. Faces belong to
+// the rim if any of the two adjacent cells is a rim (or ghost) cell.
+// With <diffusion/sts_local_stages>, blocks whose own number of RKL stages (see
+// "sts_block_stages") is below the given stage (counting from 1) contain nothing.
+struct BlockRim {
+  BlockRegion region;
+  int ndim, width;
+  int is, ie, js, je, ks, ke;
+  int stage;
+  parthenon::ParArray1D<int> block_stages;
+
+  BlockRim(MeshData<Real> *md, const BlockRegion region_, const int stage_ = 0)
+      : region(region_), stage(stage_) {
+    auto pmb = md->GetBlockData(0)->GetBlockPointer();
+    if (stage > 0) {
+      block_stages = pmb->packages.Get("Hydro")
+                         ->Param<std::map<MeshData<Real> *, parthenon::ParArray1D<int>>>(
+                             "sts_block_stages")
+                         .at(md);
+    }
+    ndim = pmb->pmy_mesh->ndim;
+    // With mesh refinement, restriction (prolongation) covers twice the ghost zones.
+    width = (pmb->pmy_mesh->multilevel ? 2 : 1) * parthenon::Globals::nghost;
+    const auto ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+    const auto jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+    const auto kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+    is = ib.s;
+    ie = ib.e;
+    js = jb.s;
+    je = jb.e;
+    ks = kb.s;
+    ke = kb.e;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  bool ContainsBlock(const int b) const { return stage == 0 || stage <= block_stages(b); }
+
+  KOKKOS_INLINE_FUNCTION
+  bool IsRimCell(const int k, const int j, const int i) const {
+    return i < is + width || i > ie - width ||
+           (ndim > 1 && (j < js + width || j > je - width)) ||
+           (ndim > 2 && (k < ks + width || k > ke - width));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  bool ContainsCell(const int k, const int j, const int i) const {
+    return region == BlockRegion::all ||
+           (IsRimCell(k, j, i) == (region == BlockRegion::rim));
+  }
+
+  // Face (k, j, i) in direction XNDIR is located between cell (k, j, i) and the cell
+  // with an index reduced by one in direction XNDIR.
+  template <int XNDIR>
+  KOKKOS_INLINE_FUNCTION bool ContainsFace(const int k, const int j, const int i) const {
+    if (region == BlockRegion::all) {
+      return true;
+    }
+    const bool is_rim =
+        IsRimCell(k, j, i) || IsRimCell(k - (XNDIR == X3DIR), j - (XNDIR == X2DIR),
+                                        i - (XNDIR == X1DIR));
+    return is_rim == (region == BlockRegion::rim);
+  }
+};
+
+// Face-centered primitive variables, i.e., the arithmetic mean of the two cells adjacent
+// to a face, that are shared by the diffusive processes (see <diffusion/face_cache>).
+// If enabled, they are calculated once per CalcDiffFluxes call for the faces in the
+// region. Otherwise, they are calculated on the fly from the primitive variables.
+struct DiffusionFaceCache {
+  bool enabled = false;
+  // Indexed by (direction, primitive variable, block, k, j, i) with the face convention
+  // of BlockRim::ContainsFace.
+  parthenon::ParArray6D<Real> data;
+
+  template <int XNDIR, typename T>
+  KOKKOS_INLINE_FUNCTION Real Get(const int v, const T &prim, const int b, const int k,
+                                  const int j, const int i) const {
+    if (enabled) {
+      return data(XNDIR - X1DIR, v, b, k, j, i);
+    }
+    return 0.5 * (prim(v, k, j, i) + prim(v, k - (XNDIR == X3DIR), j - (XNDIR == X2DIR),
+                                          i - (XNDIR == X1DIR)));
+  }
+};
+
 struct ThermalDiffusivity {
  private:
   Real mbar_, me_, kb_;
@@ -92,12 +181,11 @@ struct ThermalDiffusivity {
   ConductionCoeff GetCoeffType() const { return conduction_coeff_type_; }
 };
 
-Real EstimateConductionTimestep(MeshData<Real> *md);
+// Minimum over all blocks of md or (if block >= 0) only over the given block of md
+Real EstimateConductionTimestep(MeshData<Real> *md, const int block = -1);
 
-//! Calculate isotropic thermal conduction with fixed coefficient
-void ThermalFluxIsoFixed(MeshData<Real> *md);
-//! Calculate thermal conduction (general case incl. anisotropic and saturated)
-void ThermalFluxGeneral(MeshData<Real> *md);
+//! Calculate the (varying) thermal diffusivity of all cells in the "thermal_diff" field
+void CalcThermalDiffusivityField(MeshData<Real> *md);
 
 struct MomentumDiffusivity {
  private:
@@ -124,12 +212,8 @@ struct MomentumDiffusivity {
   ViscosityCoeff GetCoeffType() const { return viscosity_coeff_type_; }
 };
 
-Real EstimateViscosityTimestep(MeshData<Real> *md);
-
-//! Calculate isotropic viscosity with fixed coefficient
-void MomentumDiffFluxIsoFixed(MeshData<Real> *md);
-//! Calculate viscosity (general case incl. anisotropic)
-void MomentumDiffFluxGeneral(MeshData<Real> *md);
+// See EstimateConductionTimestep for the meaning of block
+Real EstimateViscosityTimestep(MeshData<Real> *md, const int block = -1);
 
 struct OhmicDiffusivity {
  private:
@@ -156,15 +240,38 @@ struct OhmicDiffusivity {
   ResistivityCoeff GetCoeffType() const { return resistivity_coeff_type_; }
 };
 
-Real EstimateResistivityTimestep(MeshData<Real> *md);
-
-//! Calculate isotropic resistivity with fixed coefficient
-void OhmicDiffFluxIsoFixed(MeshData<Real> *md);
-
-//! Calculate resistivity (general case incl. Spitzer)
-void OhmicDiffFluxGeneral(MeshData<Real> *md);
+// See EstimateConductionTimestep for the meaning of block
+Real EstimateResistivityTimestep(MeshData<Real> *md, const int block = -1);
+
+// Zero all XNDIR fluxes of face (k, j, i).
+// Used by the diffusive flux kernels in overwrite mode, i.e., when the first active
+// process sets (instead of adds to) the fluxes so that no separate reset is required.
+template <int XNDIR, typename T>
+KOKKOS_INLINE_FUNCTION void ResetFaceFluxes(T &cons, const int nvar, const int k,
+                                            const int j, const int i) {
+  for (int v = 0; v < nvar; v++) {
+    if (cons.IsAllocated(v)) {
+      cons.flux(XNDIR, v, k, j, i) = 0.0;
+    }
+  }
+}
 
-// Calculate all diffusion fluxes, i.e., update the .flux views in md
-TaskStatus CalcDiffFluxes(StateDescriptor *hydro_pkg, MeshData<Real> *md);
+// Calculate all diffusion fluxes, i.e., update the .flux views in md.
+// By default the diffusive fluxes are added to the existing fluxes. With overwrite, all
+// fluxes (of all variables) on the interior faces are replaced by the diffusive ones.
+// Only the faces in the given region (see BlockRim) are updated.
+// The fluxes of all enabled processes are either calculated in a single kernel per
+// direction (with <diffusion/fused_fluxes>) or in separate kernels per process.
+// With a positive sts_stage (only with <diffusion/sts_local_stages>), blocks that already
+// completed their RKL stages are skipped.
+TaskStatus CalcDiffFluxes(StateDescriptor *hydro_pkg, MeshData<Real> *md,
+                          const bool overwrite, const BlockRegion region,
+                          const int sts_stage);
+
+// Backward Euler update of the total energy by isotropic thermal conduction over tau
+// (with <diffusion/integrator=implicit>). Operates on all blocks and exchanges the
+// ghost cells of the search direction internally, so it must be the only task of a
+// single task list region. Afterwards, prim and cons (incl. ghost cells) are in sync.
+TaskStatus ImplicitConductionStep(Mesh *pmesh, const Real tau);
 
 #endif //  HYDRO_DIFFUSION_DIFFUSION_HPP_
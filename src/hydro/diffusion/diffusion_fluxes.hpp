@@ -0,0 +1,405 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2021-2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+// Anisotropic conduction implemented by Philipp Grete adapted from Michael Jennings
+//========================================================================================
+//! \file diffusion_fluxes.hpp
+//! \brief Diffusive flux contributions of the individual processes to a single face
+//!
+//! All functions add the contribution of a process to the (local) fluxes of the face
+//! (k, j, i) in direction XNDIR, i.e., the face between cell (k, j, i) and the cell with
+//! an index reduced by one in direction XNDIR, so that the fluxes of all enabled
+//! processes can be calculated in a single kernel, see CalcDiffFluxes.
+
+#ifndef HYDRO_DIFFUSION_DIFFUSION_FLUXES_HPP_
+#define HYDRO_DIFFUSION_DIFFUSION_FLUXES_HPP_
+
+// C++ headers
+#include <cmath>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../../main.hpp"
+#include "diffusion.hpp"
+#include "utils/error_checking.hpp"
+
+// Calculate the thermal *diffusivity*, \chi, in code units as the energy flux itself
+// is calculated from -\chi \rho \nabla (p/\rho).
+KOKKOS_INLINE_FUNCTION
+Real ThermalDiffusivity::Get(const Real pres, const Real rho) const {
+  if (conduction_coeff_type_ == ConductionCoeff::fixed) {
+    return coeff_;
+  } else if (conduction_coeff_type_ == ConductionCoeff::spitzer) {
+    const Real T_cgs = mbar_ / kb_ * pres / rho;
+    const Real kappa_spitzer = coeff_ * std::pow(T_cgs, 5. / 2.); // Full spitzer
+
+    // Convert conductivity to diffusivity
+    return kappa_spitzer * mbar_ / kb_ / rho;
+
+  } else {
+    return 0.0;
+  }
+}
+
+KOKKOS_INLINE_FUNCTION
+Real MomentumDiffusivity::Get(const Real pres, const Real rho) const {
+  if (viscosity_coeff_type_ == ViscosityCoeff::fixed) {
+    return coeff_;
+  } else {
+    PARTHENON_FAIL("Unknown viscosity coeff");
+  }
+}
+
+KOKKOS_INLINE_FUNCTION
+Real OhmicDiffusivity::Get(const Real pres, const Real rho) const {
+  if (resistivity_coeff_type_ == ResistivityCoeff::fixed) {
+    return coeff_;
+  } else if (resistivity_coeff_type_ == ResistivityCoeff::spitzer) {
+    PARTHENON_FAIL("needs impl");
+  } else {
+    PARTHENON_FAIL("Unknown Resistivity coeff");
+  }
+}
+
+// Diffusive fluxes of a single face accumulated over all processes so that the fluxes
+// are only loaded and stored once per face.
+struct DiffusiveFaceFlux {
+  Real mom[3] = {0.0, 0.0, 0.0};
+  Real en = 0.0;
+  Real mag[3] = {0.0, 0.0, 0.0};
+
+  template <int XNDIR, bool MOM, bool MAG, typename T>
+  KOKKOS_INLINE_FUNCTION void Load(const T &cons, const int k, const int j, const int i) {
+    en = cons.flux(XNDIR, IEN, k, j, i);
+    for (int n = 0; n < 3; n++) {
+      if constexpr (MOM) {
+        mom[n] = cons.flux(XNDIR, IM1 + n, k, j, i);
+      }
+      if constexpr (MAG) {
+        mag[n] = cons.flux(XNDIR, IB1 + n, k, j, i);
+      }
+    }
+  }
+
+  template <int XNDIR, bool MOM, bool MAG, typename T>
+  KOKKOS_INLINE_FUNCTION void Store(T &cons, const int k, const int j, const int i) const {
+    cons.flux(XNDIR, IEN, k, j, i) = en;
+    for (int n = 0; n < 3; n++) {
+      if constexpr (MOM) {
+        cons.flux(XNDIR, IM1 + n, k, j, i) = mom[n];
+      }
+      if constexpr (MAG) {
+        cons.flux(XNDIR, IB1 + n, k, j, i) = mag[n];
+      }
+    }
+  }
+};
+
+template <typename T>
+KOKKOS_INLINE_FUNCTION Real CellTemp(const T &prim, const int k, const int j,
+                                     const int i) {
+  return prim(IPR, k, j, i) / prim(IDN, k, j, i);
+}
+
+// Monotonized temperature difference in the direction XTDIR transverse to the face
+template <int XNDIR, int XTDIR, typename T>
+KOKKOS_INLINE_FUNCTION Real MonotonizedGradT(const T &prim,
+                                             const parthenon::Coordinates_t &coords,
+                                             const int k, const int j, const int i) {
+  constexpr int nk = XNDIR == X3DIR, nj = XNDIR == X2DIR, ni = XNDIR == X1DIR;
+  constexpr int tk = XTDIR == X3DIR, tj = XTDIR == X2DIR, ti = XTDIR == X1DIR;
+  return limiters::lim4(
+             CellTemp(prim, k + tk, j + tj, i + ti) - CellTemp(prim, k, j, i),
+             CellTemp(prim, k, j, i) - CellTemp(prim, k - tk, j - tj, i - ti),
+             CellTemp(prim, k - nk + tk, j - nj + tj, i - ni + ti) -
+                 CellTemp(prim, k - nk, j - nj, i - ni),
+             CellTemp(prim, k - nk, j - nj, i - ni) -
+                 CellTemp(prim, k - nk - tk, j - nj - tj, i - ni - ti)) /
+         coords.Dxc<XTDIR>(k, j, i);
+}
+
+//! Isotropic thermal conduction with fixed coefficient
+template <int XNDIR, typename T>
+KOKKOS_INLINE_FUNCTION void
+AddThermalFluxIsoFixed(DiffusiveFaceFlux &flx, const T &prim,
+                       const parthenon::Coordinates_t &coords,
+                       const DiffusionFaceCache &face_cache, const Real thermal_diff_coeff,
+                       const int b, const int k, const int j, const int i) {
+  constexpr int nk = XNDIR == X3DIR, nj = XNDIR == X2DIR, ni = XNDIR == X1DIR;
+  const auto dTdn = (CellTemp(prim, k, j, i) - CellTemp(prim, k - nk, j - nj, i - ni)) /
+                    coords.Dxc<XNDIR>(k, j, i);
+  const auto denf = face_cache.Get<XNDIR>(IDN, prim, b, k, j, i);
+  flx.en -= thermal_diff_coeff * denf * dTdn;
+}
+
+//! Thermal conduction, general case, i.e., anisotropic and/or with varying (incl.
+//! saturated) coefficient.
+//! The diffusivity is either calculated from the primitive variables or taken from the
+//! "thermal_diff" field (coeff, indexed by block b) if use_coeff_field.
+template <int XNDIR, typename T, typename TCoeff>
+KOKKOS_INLINE_FUNCTION void
+AddThermalFluxGeneral(DiffusiveFaceFlux &flx, const T &prim, const TCoeff &coeff,
+                      const parthenon::Coordinates_t &coords,
+                      const DiffusionFaceCache &face_cache,
+                      const ThermalDiffusivity &thermal_diff, const Real flux_sat_prefac,
+                      const bool use_coeff_field, const int ndim, const int b,
+                      const int k, const int j, const int i) {
+  constexpr int nk = XNDIR == X3DIR, nj = XNDIR == X2DIR, ni = XNDIR == X1DIR;
+
+  // Temperature gradient with the normal component from the two adjacent cells and the
+  // (monotonized) transverse components only in active dimensions.
+  Real gradT[3] = {0.0, 0.0, 0.0};
+  gradT[XNDIR - X1DIR] =
+      (CellTemp(prim, k, j, i) - CellTemp(prim, k - nk, j - nj, i - ni)) /
+      coords.Dxc<XNDIR>(k, j, i);
+  if constexpr (XNDIR != X1DIR) {
+    gradT[0] = MonotonizedGradT<XNDIR, X1DIR>(prim, coords, k, j, i);
+  }
+  if constexpr (XNDIR != X2DIR) {
+    if (ndim >= 2) {
+      gradT[1] = MonotonizedGradT<XNDIR, X2DIR>(prim, coords, k, j, i);
+    }
+  }
+  if constexpr (XNDIR != X3DIR) {
+    if (ndim >= 3) {
+      gradT[2] = MonotonizedGradT<XNDIR, X3DIR>(prim, coords, k, j, i);
+    }
+  }
+
+  const auto denf = face_cache.Get<XNDIR>(IDN, prim, b, k, j, i);
+  const auto thermal_diff_f =
+      use_coeff_field
+          ? 0.5 * (coeff(b, 0, k, j, i) + coeff(b, 0, k - nk, j - nj, i - ni))
+          : 0.5 * (thermal_diff.Get(prim(IPR, k, j, i), prim(IDN, k, j, i)) +
+                   thermal_diff.Get(prim(IPR, k - nk, j - nj, i - ni),
+                                    prim(IDN, k - nk, j - nj, i - ni)));
+  const auto gradTmag = std::sqrt(SQR(gradT[0]) + SQR(gradT[1]) + SQR(gradT[2]));
+
+  // Calculate "classic" fluxes
+  Real flux_classic = 0.0;
+  Real flux_classic_mag = 0.0;
+  if (thermal_diff.GetType() == Conduction::anisotropic) {
+    const Real B[3] = {face_cache.Get<XNDIR>(IB1, prim, b, k, j, i),
+                       face_cache.Get<XNDIR>(IB2, prim, b, k, j, i),
+                       ndim >= 3 ? face_cache.Get<XNDIR>(IB3, prim, b, k, j, i) : 0.0};
+    auto Bmag = std::sqrt(SQR(B[0]) + SQR(B[1]) + SQR(B[2]));
+    Bmag = std::max(Bmag, TINY_NUMBER);      /* limit in case B=0 */
+    const auto bn = B[XNDIR - X1DIR] / Bmag; // unit vector component
+    const auto bDotGradT = (B[0] * gradT[0] + B[1] * gradT[1] + B[2] * gradT[2]) / Bmag;
+    flux_classic = -thermal_diff_f * denf * bDotGradT * bn;
+    flux_classic_mag = std::abs(thermal_diff_f * denf * bDotGradT);
+  } else if (thermal_diff.GetType() == Conduction::isotropic) {
+    flux_classic = -thermal_diff_f * denf * gradT[XNDIR - X1DIR];
+    flux_classic_mag = thermal_diff_f * denf * gradTmag;
+  } else {
+    PARTHENON_FAIL("Unknown thermal diffusion flux.");
+  }
+
+  // Calculate saturated fluxes using upwinding, see (A3) in Mignone+12.
+  // Note that we are not concerned about the sign of flux_sat here. The way it is
+  // calculated it's always positive because we use it in the harmonic mean with
+  // the flux_classic_mag below. The correct sign is eventually picked up again from
+  // flux_classic.
+  Real flux_sat;
+  // Use first order limiting for now.
+  if (flux_classic > 0.0) {
+    const auto pres_m = prim(IPR, k - nk, j - nj, i - ni);
+    flux_sat = flux_sat_prefac * std::sqrt(pres_m / denf) * pres_m;
+  } else if (flux_classic < 0.0) {
+    flux_sat =
+        flux_sat_prefac * std::sqrt(prim(IPR, k, j, i) / denf) * prim(IPR, k, j, i);
+  } else {
+    const auto presf = face_cache.Get<XNDIR>(IPR, prim, b, k, j, i);
+    flux_sat = flux_sat_prefac * std::sqrt(presf / denf) * presf;
+  }
+
+  flx.en += (flux_sat / (flux_sat + flux_classic_mag)) * flux_classic;
+}
+
+//! Isotropic viscosity with fixed coefficient
+template <int XNDIR, typename T>
+KOKKOS_INLINE_FUNCTION void
+AddMomentumDiffFluxIsoFixed(DiffusiveFaceFlux &flx, const T &prim,
+                            const parthenon::Coordinates_t &coords,
+                            const DiffusionFaceCache &face_cache, const Real nu,
+                            const int ndim, const int b, const int k, const int j,
+                            const int i) {
+  Real fvx, fvy, fvz;
+  if constexpr (XNDIR == X1DIR) {
+    // Add [2(dVx/dx)-(2/3)dVx/dx, dVy/dx, dVz/dx]
+    fvx = 4.0 * (prim(IV1, k, j, i) - prim(IV1, k, j, i - 1)) / (3.0 * coords.Dxc<1>(i));
+    fvy = (prim(IV2, k, j, i) - prim(IV2, k, j, i - 1)) / coords.Dxc<1>(i);
+    fvz = (prim(IV3, k, j, i) - prim(IV3, k, j, i - 1)) / coords.Dxc<1>(i);
+
+    // In 2D/3D Add [(-2/3)dVy/dy, dVx/dy, 0]
+    if (ndim > 1) {
+      fvx -= ((prim(IV2, k, j + 1, i) + prim(IV2, k, j + 1, i - 1)) -
+              (prim(IV2, k, j - 1, i) + prim(IV2, k, j - 1, i - 1))) /
+             (6.0 * coords.Dxc<2>(j));
+      fvy += ((prim(IV1, k, j + 1, i) + prim(IV1, k, j + 1, i - 1)) -
+              (prim(IV1, k, j - 1, i) + prim(IV1, k, j - 1, i - 1))) /
+             (4.0 * coords.Dxc<2>(j));
+    }
+
+    // In 3D Add [(-2/3)dVz/dz, 0,  dVx/dz]
+    if (ndim > 2) {
+      fvx -= ((prim(IV3, k + 1, j, i) + prim(IV3, k + 1, j, i - 1)) -
+              (prim(IV3, k - 1, j, i) + prim(IV3, k - 1, j, i - 1))) /
+             (6.0 * coords.Dxc<3>(k));
+      fvz += ((prim(IV1, k + 1, j, i) + prim(IV1, k + 1, j, i - 1)) -
+              (prim(IV1, k - 1, j, i) + prim(IV1, k - 1, j, i - 1))) /
+             (4.0 * coords.Dxc<3>(k));
+    }
+  } else if constexpr (XNDIR == X2DIR) {
+    // Add [(dVx/dy+dVy/dx), 2(dVy/dy)-(2/3)(dVx/dx+dVy/dy), dVz/dy]
+    fvx = (prim(IV1, k, j, i) - prim(IV1, k, j - 1, i)) / coords.Dxc<2>(j) +
+          ((prim(IV2, k, j, i + 1) + prim(IV2, k, j - 1, i + 1)) -
+           (prim(IV2, k, j, i - 1) + prim(IV2, k, j - 1, i - 1))) /
+              (4.0 * coords.Dxc<1>(i));
+    fvy = (prim(IV2, k, j, i) - prim(IV2, k, j - 1, i)) * 4.0 / (3.0 * coords.Dxc<2>(j)) -
+          ((prim(IV1, k, j, i + 1) + prim(IV1, k, j - 1, i + 1)) -
+           (prim(IV1, k, j, i - 1) + prim(IV1, k, j - 1, i - 1))) /
+              (6.0 * coords.Dxc<1>(i));
+    fvz = (prim(IV3, k, j, i) - prim(IV3, k, j - 1, i)) / coords.Dxc<2>(j);
+
+    // In 3D Add [0, (-2/3)dVz/dz, dVy/dz]
+    if (ndim > 2) {
+      fvy -= ((prim(IV3, k + 1, j, i) + prim(IV3, k + 1, j - 1, i)) -
+              (prim(IV3, k - 1, j, i) + prim(IV3, k - 1, j - 1, i))) /
+             (6.0 * coords.Dxc<3>(k));
+      fvz += ((prim(IV2, k + 1, j, i) + prim(IV2, k + 1, j - 1, i)) -
+              (prim(IV2, k - 1, j, i) + prim(IV2, k - 1, j - 1, i))) /
+             (4.0 * coords.Dxc<3>(k));
+    }
+  } else {
+    // Add [(dVx/dz+dVz/dx), (dVy/dz+dVz/dy), 2(dVz/dz)-(2/3)(dVx/dx+dVy/dy+dVz/dz)]
+    fvx = (prim(IV1, k, j, i) - prim(IV1, k - 1, j, i)) / coords.Dxc<3>(k) +
+          ((prim(IV3, k, j, i + 1) + prim(IV3, k - 1, j, i + 1)) -
+           (prim(IV3, k, j, i - 1) + prim(IV3, k - 1, j, i - 1))) /
+              (4.0 * coords.Dxc<1>(i));
+    fvy = (prim(IV2, k, j, i) - prim(IV2, k - 1, j, i)) / coords.Dxc<3>(k) +
+          ((prim(IV3, k, j + 1, i) + prim(IV3, k - 1, j + 1, i)) -
+           (prim(IV3, k, j - 1, i) + prim(IV3, k - 1, j - 1, i))) /
+              (4.0 * coords.Dxc<2>(j));
+    fvz = (prim(IV3, k, j, i) - prim(IV3, k - 1, j, i)) * 4.0 / (3.0 * coords.Dxc<3>(k)) -
+          ((prim(IV1, k, j, i + 1) + prim(IV1, k - 1, j, i + 1)) -
+           (prim(IV1, k, j, i - 1) + prim(IV1, k - 1, j, i - 1))) /
+              (6.0 * coords.Dxc<1>(i)) -
+          ((prim(IV2, k, j + 1, i) + prim(IV2, k - 1, j + 1, i)) -
+           (prim(IV2, k, j - 1, i) + prim(IV2, k - 1, j - 1, i))) /
+              (6.0 * coords.Dxc<2>(j));
+  }
+
+  // Sum viscous fluxes into fluxes of conserved variables; including energy fluxes
+  const Real nud = nu * face_cache.Get<XNDIR>(IDN, prim, b, k, j, i);
+  flx.mom[0] -= nud * fvx;
+  flx.mom[1] -= nud * fvy;
+  flx.mom[2] -= nud * fvz;
+  flx.en -= nud * (face_cache.Get<XNDIR>(IV1, prim, b, k, j, i) * fvx +
+                   face_cache.Get<XNDIR>(IV2, prim, b, k, j, i) * fvy +
+                   face_cache.Get<XNDIR>(IV3, prim, b, k, j, i) * fvz);
+}
+
+//! Isotropic resistivity with fixed coefficient
+template <int XNDIR, typename T>
+KOKKOS_INLINE_FUNCTION void
+AddOhmicDiffFluxIsoFixed(DiffusiveFaceFlux &flx, const T &prim,
+                         const parthenon::Coordinates_t &coords,
+                         const DiffusionFaceCache &face_cache, const Real eta,
+                         const int ndim, const int b, const int k, const int j,
+                         const int i) {
+  // Face centered current densities
+  if constexpr (XNDIR == X1DIR) {
+    // j2 = d3B1 - d1B3
+    const auto d3B1 =
+        ndim > 2 ? (0.5 * (prim(IB1, k + 1, j, i - 1) + prim(IB1, k + 1, j, i)) -
+                    0.5 * (prim(IB1, k - 1, j, i - 1) + prim(IB1, k - 1, j, i))) /
+                       (coords.Xf<3, 1>(k + 1, j, i) - coords.Xf<3, 1>(k - 1, j, i))
+                 : 0.0;
+
+    const auto d1B3 =
+        (prim(IB3, k, j, i) - prim(IB3, k, j, i - 1)) / coords.Dxc<1>(k, j, i);
+
+    const auto j2 = d3B1 - d1B3;
+
+    // j3 = d1B2 - d2B1
+    const auto d1B2 =
+        (prim(IB2, k, j, i) - prim(IB2, k, j, i - 1)) / coords.Dxc<1>(k, j, i);
+
+    const auto d2B1 =
+        ndim > 1 ? (0.5 * (prim(IB1, k, j + 1, i - 1) + prim(IB1, k, j + 1, i)) -
+                    0.5 * (prim(IB1, k, j - 1, i - 1) + prim(IB1, k, j - 1, i))) /
+                       (coords.Xf<2, 1>(k, j + 1, i) - coords.Xf<2, 1>(k, j - 1, i))
+                 : 0.0;
+
+    const auto j3 = d1B2 - d2B1;
+
+    flx.mag[1] += -eta * j3;
+    flx.mag[2] += eta * j2;
+    flx.en += eta * (face_cache.Get<X1DIR>(IB3, prim, b, k, j, i) * j2 -
+                     face_cache.Get<X1DIR>(IB2, prim, b, k, j, i) * j3);
+  } else if constexpr (XNDIR == X2DIR) {
+    // j3 = d1B2 - d2B1
+    const auto d1B2 = (0.5 * (prim(IB2, k, j - 1, i + 1) + prim(IB2, k, j, i + 1)) -
+                       0.5 * (prim(IB2, k, j - 1, i - 1) + prim(IB2, k, j, i - 1))) /
+                      (coords.Xf<1, 2>(k, j, i + 1) - coords.Xf<1, 2>(k, j, i - 1));
+
+    const auto d2B1 =
+        (prim(IB1, k, j, i) - prim(IB1, k, j - 1, i)) / coords.Dxc<2>(k, j, i);
+
+    const auto j3 = d1B2 - d2B1;
+
+    // j1 = d2B3 - d3B2
+    const auto d2B3 =
+        (prim(IB3, k, j, i) - prim(IB3, k, j - 1, i)) / coords.Dxc<2>(k, j, i);
+
+    const auto d3B2 =
+        ndim > 2 ? (0.5 * (prim(IB2, k + 1, j - 1, i) + prim(IB2, k + 1, j, i)) -
+                    0.5 * (prim(IB2, k - 1, j - 1, i) + prim(IB2, k - 1, j, i))) /
+                       (coords.Xf<3, 2>(k + 1, j, i) - coords.Xf<3, 2>(k - 1, j, i))
+                 : 0.0;
+
+    const auto j1 = d2B3 - d3B2;
+
+    flx.mag[0] += eta * j3;
+    flx.mag[2] += -eta * j1;
+    flx.en += eta * (face_cache.Get<X2DIR>(IB1, prim, b, k, j, i) * j3 -
+                     face_cache.Get<X2DIR>(IB3, prim, b, k, j, i) * j1);
+  } else {
+    // j1 = d2B3 - d3B2
+    const auto d2B3 = (0.5 * (prim(IB3, k - 1, j + 1, i) + prim(IB3, k, j + 1, i)) -
+                       0.5 * (prim(IB3, k - 1, j - 1, i) + prim(IB3, k, j - 1, i))) /
+                      (coords.Xf<2, 3>(k, j + 1, i) - coords.Xf<2, 3>(k, j - 1, i));
+
+    const auto d3B2 =
+        (prim(IB2, k, j, i) - prim(IB2, k - 1, j, i)) / coords.Dxc<3>(k, j, i);
+
+    const auto j1 = d2B3 - d3B2;
+
+    // j2 = d3B1 - d1B3
+    const auto d3B1 =
+        (prim(IB1, k, j, i) - prim(IB1, k - 1, j, i)) / coords.Dxc<3>(k, j, i);
+
+    const auto d1B3 = (0.5 * (prim(IB3, k - 1, j, i + 1) + prim(IB3, k, j, i + 1)) -
+                       0.5 * (prim(IB3, k - 1, j, i - 1) + prim(IB3, k, j, i - 1))) /
+                      (coords.Xf<1, 3>(k, j, i + 1) - coords.Xf<1, 3>(k, j, i - 1));
+
+    const auto j2 = d3B1 - d1B3;
+
+    flx.mag[0] += -eta * j2;
+    flx.mag[1] += eta * j1;
+    flx.en += eta * (face_cache.Get<X3DIR>(IB2, prim, b, k, j, i) * j1 -
+                     face_cache.Get<X3DIR>(IB1, prim, b, k, j, i) * j2);
+  }
+}
+
+#endif //  HYDRO_DIFFUSION_DIFFUSION_FLUXES_HPP_
@@ -0,0 +1,131 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2021-2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file diffusion_timestep.hpp
+//! \brief Diffusive timestep constraints of a single cell
+//!
+//! The values do not include the cfl and the dimensional prefactors (see, e.g.,
+//! EstimateConductionTimestep) so that the constraints of individual processes can also
+//! be reduced in a single kernel together with the hyperbolic one, see
+//! <hydro/fused_dt_estimate>.
+
+#ifndef HYDRO_DIFFUSION_DIFFUSION_TIMESTEP_HPP_
+#define HYDRO_DIFFUSION_DIFFUSION_TIMESTEP_HPP_
+
+// C++ headers
+#include <cmath>
+#include <limits>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../../main.hpp"
+#include "diffusion.hpp"
+#include "diffusion_fluxes.hpp"
+
+//! Isotropic diffusion with a fixed coefficient (thermal conduction, viscosity, and
+//! resistivity)
+KOKKOS_INLINE_FUNCTION Real CellDiffusionTimestepFixed(
+    const parthenon::Coordinates_t &coords, const Real diff_coeff, const int ndim,
+    const int k, const int j, const int i) {
+  Real min_dt = SQR(coords.Dxc<1>(k, j, i)) / (diff_coeff + TINY_NUMBER);
+  if (ndim >= 2) {
+    min_dt = fmin(min_dt, SQR(coords.Dxc<2>(k, j, i)) / (diff_coeff + TINY_NUMBER));
+  }
+  if (ndim >= 3) {
+    min_dt = fmin(min_dt, SQR(coords.Dxc<3>(k, j, i)) / (diff_coeff + TINY_NUMBER));
+  }
+  return min_dt;
+}
+
+//! Thermal conduction, general case, i.e., anisotropic and/or with varying (incl.
+//! saturated) coefficient.
+//! The diffusivity is either calculated from the primitive variables or taken from the
+//! "thermal_diff" field (coeff_pack) if use_coeff_field.
+template <typename T, typename TCoeff>
+KOKKOS_INLINE_FUNCTION Real CellConductionTimestepGeneral(
+    const T &prim, const TCoeff &coeff_pack, const ThermalDiffusivity &thermal_diff,
+    const Real flux_sat_prefac, const bool use_coeff_field,
+    const parthenon::Coordinates_t &coords, const int ndim, const int b, const int k,
+    const int j, const int i) {
+  constexpr auto no_constraint = std::numeric_limits<Real>::max();
+  const auto &rho = prim(IDN, k, j, i);
+  const auto &p = prim(IPR, k, j, i);
+
+  const auto dTdx = 0.5 *
+                    (prim(IPR, k, j, i + 1) / prim(IDN, k, j, i + 1) -
+                     prim(IPR, k, j, i - 1) / prim(IDN, k, j, i - 1)) /
+                    coords.Dxc<1>(i);
+
+  const auto dTdy = ndim >= 2 ? 0.5 *
+                                    (prim(IPR, k, j + 1, i) / prim(IDN, k, j + 1, i) -
+                                     prim(IPR, k, j - 1, i) / prim(IDN, k, j - 1, i)) /
+                                    coords.Dxc<2>(j)
+                              : 0.0;
+
+  const auto dTdz = ndim >= 3 ? 0.5 *
+                                    (prim(IPR, k + 1, j, i) / prim(IDN, k + 1, j, i) -
+                                     prim(IPR, k - 1, j, i) / prim(IDN, k - 1, j, i)) /
+                                    coords.Dxc<3>(k)
+                              : 0.0;
+  const auto gradTmag = sqrt(SQR(dTdx) + SQR(dTdy) + SQR(dTdz));
+
+  // No temperature gradient -> no thermal conduction-> no timestep restriction
+  if (gradTmag == 0.0) {
+    return no_constraint;
+  }
+  const auto thermal_diff_coeff =
+      use_coeff_field ? coeff_pack(b, 0, k, j, i) : thermal_diff.Get(p, rho);
+
+  if (thermal_diff.GetType() == Conduction::isotropic) {
+    Real min_dt = SQR(coords.Dxc<1>(k, j, i)) / thermal_diff_coeff;
+    if (ndim >= 2) {
+      min_dt = fmin(min_dt, SQR(coords.Dxc<2>(k, j, i)) / thermal_diff_coeff);
+    }
+    if (ndim >= 3) {
+      min_dt = fmin(min_dt, SQR(coords.Dxc<3>(k, j, i)) / thermal_diff_coeff);
+    }
+    return min_dt;
+  }
+  const auto &Bx = prim(IB1, k, j, i);
+  const auto &By = prim(IB2, k, j, i);
+  const auto &Bz = prim(IB3, k, j, i);
+  const auto Bmag = sqrt(SQR(Bx) + SQR(By) + SQR(Bz));
+  // Need to have some local field for anisotropic conduction
+  if (Bmag == 0.0) {
+    return no_constraint;
+  }
+
+  // In the saturated regime, i.e., when the ratio of classic to saturated fluxes
+  // is large, the equation becomes hyperbolic with the signal speed of the
+  // conduction front being comparable to the sound speed, see [Balsara, Tilley,
+  // and Howk MANRAS 2008]. Therefore, we don't need to contrain the "parabolic"
+  // timestep here (and the hyperbolic one is constrained automatically by the
+  // fluid EstimateTimestep call).
+  auto const flux_sat = flux_sat_prefac * std::sqrt(p / rho) * p;
+  auto const flux_classic = thermal_diff_coeff * rho * gradTmag;
+  if (flux_classic / flux_sat > 100.) {
+    return no_constraint;
+  }
+
+  const auto costheta = fabs(Bx * dTdx + By * dTdy + Bz * dTdz) / (Bmag * gradTmag);
+
+  Real min_dt = SQR(coords.Dxc<1>(k, j, i)) /
+                (thermal_diff_coeff * fabs(Bx) / Bmag * costheta + TINY_NUMBER);
+  if (ndim >= 2) {
+    min_dt = fmin(min_dt, SQR(coords.Dxc<2>(k, j, i)) /
+                              (thermal_diff_coeff * fabs(By) / Bmag * costheta +
+                               TINY_NUMBER));
+  }
+  if (ndim >= 3) {
+    min_dt = fmin(min_dt, SQR(coords.Dxc<3>(k, j, i)) /
+                              (thermal_diff_coeff * fabs(Bz) / Bmag * costheta +
+                               TINY_NUMBER));
+  }
+  return min_dt;
+}
+
+#endif // HYDRO_DIFFUSION_DIFFUSION_TIMESTEP_HPP_
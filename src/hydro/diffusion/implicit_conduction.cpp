@@ -0,0 +1,377 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file implicit_conduction.cpp
+//! \brief Implicit (backward Euler) integration of isotropic thermal conduction
+//!
+//! The linear system
+//!   rho / ((gamma - 1) tau) (u - u^n) = div(chi rho grad u)  with u = p / rho
+//! is solved with a Jacobi preconditioned conjugate gradient method. The diffusivity is
+//! evaluated at the beginning of the step (i.e., linearized for Spitzer conduction) and
+//! saturation is not taken into account. Eventually, the total energy is updated in flux
+//! form (so that it is conserved) from the converged solution.
+
+// C++ headers
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include "bvals/comms/bvals_in_one.hpp"
+#include <parthenon/package.hpp>
+
+#include "globals.hpp"
+
+// AthenaPK headers
+#include "../../main.hpp"
+#include "diffusion.hpp"
+#include "diffusion_fluxes.hpp"
+
+using namespace parthenon::package::prelude;
+
+namespace {
+// Components of the "implicit_cond" work field
+enum { IX = 0, IR = 1, IAP = 2, IDIAG = 3, ICHI = 4 };
+
+// Diffusion coefficient (chi rho) of the face between cells (k, j, i) and (k2, j2, i2)
+template <typename TW, typename TP>
+KOKKOS_INLINE_FUNCTION Real FaceKappa(const TW &work, const TP &prim, const int k,
+                                      const int j, const int i, const int k2,
+                                      const int j2, const int i2) {
+  return 0.5 * (work(ICHI, k, j, i) + work(ICHI, k2, j2, i2)) * 0.5 *
+         (prim(IDN, k, j, i) + prim(IDN, k2, j2, i2));
+}
+
+// Add the XNDIR contribution to div(chi rho grad x) of cell (k, j, i) and the
+// corresponding (positive) diagonal entry of the negative operator.
+template <int XNDIR, typename TW, typename TP, typename TX>
+KOKKOS_INLINE_FUNCTION void AddOperator(Real &div, Real &diag, const TW &work,
+                                        const TP &prim, const TX &x,
+                                        const parthenon::Coordinates_t &coords,
+                                        const int k, const int j, const int i) {
+  constexpr int dk = XNDIR == X3DIR, dj = XNDIR == X2DIR, di = XNDIR == X1DIR;
+  const Real dx2 = SQR(coords.Dxc<XNDIR>(k, j, i));
+  const auto kappa_m = FaceKappa(work, prim, k, j, i, k - dk, j - dj, i - di);
+  const auto kappa_p = FaceKappa(work, prim, k, j, i, k + dk, j + dj, i + di);
+  div += (kappa_p * (x(0, k + dk, j + dj, i + di) - x(0, k, j, i)) -
+          kappa_m * (x(0, k, j, i) - x(0, k - dk, j - dj, i - di))) /
+         dx2;
+  diag += (kappa_m + kappa_p) / dx2;
+}
+
+template <typename TW, typename TP, typename TX>
+KOKKOS_INLINE_FUNCTION Real DivKappaGrad(Real &diag, const TW &work, const TP &prim,
+                                         const TX &x,
+                                         const parthenon::Coordinates_t &coords,
+                                         const int ndim, const int k, const int j,
+                                         const int i) {
+  Real div = 0.0;
+  diag = 0.0;
+  AddOperator<X1DIR>(div, diag, work, prim, x, coords, k, j, i);
+  if (ndim > 1) {
+    AddOperator<X2DIR>(div, diag, work, prim, x, coords, k, j, i);
+  }
+  if (ndim > 2) {
+    AddOperator<X3DIR>(div, diag, work, prim, x, coords, k, j, i);
+  }
+  return div;
+}
+
+// Blocking exchange of the ghost cells of the container (outside of the task lists).
+void ExchangeGhosts(Mesh *pmesh, const std::string &container) {
+  TaskCollection tc;
+  TaskID none(0);
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  TaskRegion &region = tc.AddRegion(num_partitions);
+  for (int n = 0; n < num_partitions; n++) {
+    auto &tl = region[n];
+    auto &md = pmesh->mesh_data.GetOrAdd(container, n);
+    const auto any = parthenon::BoundaryType::any;
+    auto start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, md);
+    parthenon::AddBoundaryExchangeTasks(start_bnd, tl, md, pmesh->multilevel);
+  }
+  tc.Execute();
+}
+
+void GlobalSum(Real *vals, const int n) {
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(
+      MPI_Allreduce(MPI_IN_PLACE, vals, n, MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
+#endif
+}
+
+// Initialize x = u^n, r = b - A x = div(chi rho grad u^n), and p = z = r / diag.
+// Returns the local r.r and r.z.
+void InitSolver(MeshData<Real> *md, const Real tau, Real &rr, Real &rz) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const auto &work_pack = md->PackVariables(std::vector<std::string>{"implicit_cond"});
+  const auto &p_pack = md->PackVariables(std::vector<std::string>{"implicit_cond_p"});
+  const auto &thermal_diff = hydro_pkg->Param<ThermalDiffusivity>("thermal_diff");
+  const auto gm1 = hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0;
+  const int ndim = md->GetMeshPointer()->ndim;
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  IndexRange ibe = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+  IndexRange jbe = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+  IndexRange kbe = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+
+  // The primitive variables (incl. ghost cells) are valid at the beginning of the step
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Diffusion::Implicit::InitCoeffs", DevExecSpace(), 0,
+      prim_pack.GetDim(5) - 1, kbe.s, kbe.e, jbe.s, jbe.e, ibe.s, ibe.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &prim = prim_pack(b);
+        work_pack(b, ICHI, k, j, i) =
+            thermal_diff.Get(prim(IPR, k, j, i), prim(IDN, k, j, i));
+        p_pack(b, 0, k, j, i) = prim(IPR, k, j, i) / prim(IDN, k, j, i);
+      });
+
+  rr = 0.0;
+  Kokkos::parallel_reduce(
+      "Diffusion::Implicit::InitResidual",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
+        const auto &coords = prim_pack.GetCoords(b);
+        const auto &prim = prim_pack(b);
+        const auto &work = work_pack(b);
+        Real diag;
+        const auto r = DivKappaGrad(diag, work, prim, p_pack(b), coords, ndim, k, j, i);
+        work_pack(b, IX, k, j, i) = p_pack(b, 0, k, j, i);
+        work_pack(b, IR, k, j, i) = r;
+        work_pack(b, IDIAG, k, j, i) = prim(IDN, k, j, i) / (gm1 * tau) + diag;
+        lsum += r * r;
+      },
+      Kokkos::Sum<Real>(rr));
+
+  // Separate kernel as the neighboring values of p (i.e., u^n) are used above.
+  rz = 0.0;
+  Kokkos::parallel_reduce(
+      "Diffusion::Implicit::InitDirection",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
+        const auto r = work_pack(b, IR, k, j, i);
+        const auto z = r / work_pack(b, IDIAG, k, j, i);
+        p_pack(b, 0, k, j, i) = z;
+        lsum += r * z;
+      },
+      Kokkos::Sum<Real>(rz));
+}
+
+// Calculate Ap (requires valid ghost cells of p) and return the local p.Ap.
+Real ApplyOperator(MeshData<Real> *md, const Real tau) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const auto &work_pack = md->PackVariables(std::vector<std::string>{"implicit_cond"});
+  const auto &p_pack = md->PackVariables(std::vector<std::string>{"implicit_cond_p"});
+  const auto gm1 = hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0;
+  const int ndim = md->GetMeshPointer()->ndim;
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  Real pAp = 0.0;
+  Kokkos::parallel_reduce(
+      "Diffusion::Implicit::ApplyOperator",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
+        const auto &coords = prim_pack.GetCoords(b);
+        const auto &prim = prim_pack(b);
+        const auto &work = work_pack(b);
+        const auto &p = p_pack(b);
+        Real diag;
+        const auto div = DivKappaGrad(diag, work, prim, p, coords, ndim, k, j, i);
+        const auto Ap = prim(IDN, k, j, i) / (gm1 * tau) * p(0, k, j, i) - div;
+        work_pack(b, IAP, k, j, i) = Ap;
+        lsum += p(0, k, j, i) * Ap;
+      },
+      Kokkos::Sum<Real>(pAp));
+  return pAp;
+}
+
+// x += alpha p and r -= alpha Ap. Returns the local r.r and r.z (with z = r / diag).
+void UpdateSolution(MeshData<Real> *md, const Real alpha, Real &rr, Real &rz) {
+  const auto &work_pack = md->PackVariables(std::vector<std::string>{"implicit_cond"});
+  const auto &p_pack = md->PackVariables(std::vector<std::string>{"implicit_cond_p"});
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  const auto policy = Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+      DevExecSpace(), {0, kb.s, jb.s, ib.s},
+      {work_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1}, {1, 1, 1, ib.e + 1 - ib.s});
+  rr = 0.0;
+  Kokkos::parallel_reduce(
+      "Diffusion::Implicit::UpdateSolution", policy,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
+        work_pack(b, IX, k, j, i) += alpha * p_pack(b, 0, k, j, i);
+        const auto r = work_pack(b, IR, k, j, i) - alpha * work_pack(b, IAP, k, j, i);
+        work_pack(b, IR, k, j, i) = r;
+        lsum += r * r;
+      },
+      Kokkos::Sum<Real>(rr));
+  rz = 0.0;
+  Kokkos::parallel_reduce(
+      "Diffusion::Implicit::PreconditionedResidual", policy,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
+        const auto r = work_pack(b, IR, k, j, i);
+        lsum += r * r / work_pack(b, IDIAG, k, j, i);
+      },
+      Kokkos::Sum<Real>(rz));
+}
+
+// p = z + beta p (or p = x if x_to_p for the final flux calculation)
+void UpdateDirection(MeshData<Real> *md, const Real beta, const bool x_to_p) {
+  const auto &work_pack = md->PackVariables(std::vector<std::string>{"implicit_cond"});
+  const auto &p_pack = md->PackVariables(std::vector<std::string>{"implicit_cond_p"});
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Diffusion::Implicit::UpdateDirection", DevExecSpace(), 0,
+      work_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        if (x_to_p) {
+          p_pack(b, 0, k, j, i) = work_pack(b, IX, k, j, i);
+        } else {
+          p_pack(b, 0, k, j, i) =
+              work_pack(b, IR, k, j, i) / work_pack(b, IDIAG, k, j, i) +
+              beta * p_pack(b, 0, k, j, i);
+        }
+      });
+}
+
+// Add tau div(chi rho grad x) to the total energy (requires valid ghost cells of p = x).
+// As each face contribution is calculated identically from both sides, the update is
+// conservative.
+void UpdateEnergy(MeshData<Real> *md, const Real tau) {
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  const auto &work_pack = md->PackVariables(std::vector<std::string>{"implicit_cond"});
+  const auto &p_pack = md->PackVariables(std::vector<std::string>{"implicit_cond_p"});
+  const int ndim = md->GetMeshPointer()->ndim;
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Diffusion::Implicit::UpdateEnergy", DevExecSpace(), 0,
+      prim_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &coords = prim_pack.GetCoords(b);
+        Real diag;
+        const auto div = DivKappaGrad(diag, work_pack(b), prim_pack(b), p_pack(b),
+                                      coords, ndim, k, j, i);
+        cons_pack(b, IEN, k, j, i) += tau * div;
+      });
+}
+} // namespace
+
+TaskStatus ImplicitConductionStep(Mesh *pmesh, const Real tau) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  const auto tol = hydro_pkg->Param<Real>("implicit_tol");
+  const auto max_iter = hydro_pkg->Param<int>("implicit_max_iter");
+  const int num_partitions = pmesh->DefaultNumPartitions();
+
+  // Shallow container so that only the search direction is exchanged in each iteration.
+  // No-op for existing containers so it's safe to call every time.
+  for (auto &pmb : pmesh->block_list) {
+    auto &base = pmb->meshblock_data.Get();
+    pmb->meshblock_data.AddShallow("implicit_exchange", base,
+                                   std::vector<std::string>{"implicit_cond_p"});
+  }
+
+  Real sums[2] = {0.0, 0.0}; // r.r and r.z
+  for (int n = 0; n < num_partitions; n++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", n);
+    Real rr, rz;
+    InitSolver(md.get(), tau, rr, rz);
+    sums[0] += rr;
+    sums[1] += rz;
+  }
+  GlobalSum(sums, 2);
+  const Real rr0 = sums[0];
+  Real rr = sums[0];
+  Real rz = sums[1];
+
+  int iter = 0;
+  while (rr > SQR(tol) * rr0 && iter < max_iter) {
+    ExchangeGhosts(pmesh, "implicit_exchange");
+    Real pAp = 0.0;
+    for (int n = 0; n < num_partitions; n++) {
+      auto &md = pmesh->mesh_data.GetOrAdd("base", n);
+      pAp += ApplyOperator(md.get(), tau);
+    }
+    GlobalSum(&pAp, 1);
+    const Real alpha = rz / pAp;
+
+    sums[0] = 0.0;
+    sums[1] = 0.0;
+    for (int n = 0; n < num_partitions; n++) {
+      auto &md = pmesh->mesh_data.GetOrAdd("base", n);
+      Real rr_local, rz_local;
+      UpdateSolution(md.get(), alpha, rr_local, rz_local);
+      sums[0] += rr_local;
+      sums[1] += rz_local;
+    }
+    GlobalSum(sums, 2);
+    rr = sums[0];
+    const Real beta = sums[1] / rz;
+    rz = sums[1];
+    iter++;
+
+    if (rr > SQR(tol) * rr0) {
+      for (int n = 0; n < num_partitions; n++) {
+        auto &md = pmesh->mesh_data.GetOrAdd("base", n);
+        UpdateDirection(md.get(), beta, false);
+      }
+    }
+  }
+
+  if (hydro_pkg->Param<bool>("implicit_verbose") && parthenon::Globals::my_rank == 0) {
+    std::cout << "Implicit conduction: " << iter << " iterations, relative residual "
+              << (rr0 > 0.0 ? std::sqrt(rr / rr0) : 0.0) << std::endl;
+  }
+  if (rr > SQR(tol) * rr0) {
+    PARTHENON_WARN("Implicit conduction did not converge within "
+                   "diffusion/implicit_max_iter iterations.");
+  }
+
+  // Conservative update of the total energy using the solution
+  for (int n = 0; n < num_partitions; n++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", n);
+    UpdateDirection(md.get(), 0.0, true);
+  }
+  ExchangeGhosts(pmesh, "implicit_exchange");
+  for (int n = 0; n < num_partitions; n++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", n);
+    UpdateEnergy(md.get(), tau);
+  }
+
+  // Guarantee that prim and cons (incl. ghost cells) are in sync at the end (as the STS).
+  ExchangeGhosts(pmesh, "base");
+  for (int n = 0; n < num_partitions; n++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", n);
+    parthenon::Update::FillDerived(md.get());
+  }
+  return TaskStatus::complete;
+}
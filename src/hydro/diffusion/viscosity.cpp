@@ -18,21 +18,14 @@
 #include "../../main.hpp"
 #include "config.hpp"
 #include "diffusion.hpp"
+#include "diffusion_fluxes.hpp"
+#include "diffusion_timestep.hpp"
 #include "kokkos_abstraction.hpp"
 #include "utils/error_checking.hpp"
 
 using namespace parthenon::package::prelude;
 
-KOKKOS_INLINE_FUNCTION
-Real MomentumDiffusivity::Get(const Real pres, const Real rho) const {
-  if (viscosity_coeff_type_ == ViscosityCoeff::fixed) {
-    return coeff_;
-  } else {
-    PARTHENON_FAIL("Unknown viscosity coeff");
-  }
-}
-
-Real EstimateViscosityTimestep(MeshData<Real> *md) {
+Real EstimateViscosityTimestep(MeshData<Real> *md, const int block) {
   // get to package via first block in Meshdata (which exists by construction)
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
@@ -40,6 +33,9 @@ Real EstimateViscosityTimestep(MeshData<Real> *md) {
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  // Either all blocks of the pack or only the given one
+  const int bs = block < 0 ? 0 : block;
+  const int be = block < 0 ? prim_pack.GetDim(5) : block + 1;
 
   Real min_dt_visc = std::numeric_limits<Real>::max();
   const auto ndim = prim_pack.GetNdim();
@@ -61,23 +57,14 @@ Real EstimateViscosityTimestep(MeshData<Real> *md) {
     // Using 0.0 as parameters rho and p as they're not used anyway for a fixed coeff.
     const auto mom_diff_coeff = mom_diff.Get(0.0, 0.0);
     Kokkos::parallel_reduce(
-        "EstimateViscosityTimestep (iso fixed)",
+        "Diffusion::Viscosity::EstimateTimestep(iso fixed)",
         Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-            DevExecSpace(), {0, kb.s, jb.s, ib.s},
-            {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+            DevExecSpace(), {bs, kb.s, jb.s, ib.s}, {be, kb.e + 1, jb.e + 1, ib.e + 1},
             {1, 1, 1, ib.e + 1 - ib.s}),
         KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &min_dt) {
           const auto &coords = prim_pack.GetCoords(b);
-          min_dt =
-              fmin(min_dt, SQR(coords.Dxc<1>(k, j, i)) / (mom_diff_coeff + TINY_NUMBER));
-          if (ndim >= 2) {
-            min_dt = fmin(min_dt,
-                          SQR(coords.Dxc<2>(k, j, i)) / (mom_diff_coeff + TINY_NUMBER));
-          }
-          if (ndim >= 3) {
-            min_dt = fmin(min_dt,
-                          SQR(coords.Dxc<3>(k, j, i)) / (mom_diff_coeff + TINY_NUMBER));
-          }
+          min_dt = fmin(min_dt, CellDiffusionTimestepFixed(coords, mom_diff_coeff, ndim,
+                                                           k, j, i));
         },
         Kokkos::Min<Real>(min_dt_visc));
   } else {
@@ -87,209 +74,3 @@ Real EstimateViscosityTimestep(MeshData<Real> *md) {
   const auto &cfl_diff = hydro_pkg->Param<Real>("cfl_diff");
   return cfl_diff * fac * min_dt_visc;
 }
-
-//---------------------------------------------------------------------------------------
-//! Calculate isotropic viscosity with fixed coefficient
-
-void MomentumDiffFluxIsoFixed(MeshData<Real> *md) {
-  auto pmb = md->GetBlockData(0)->GetBlockPointer();
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-
-  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
-  auto cons_pack = md->PackVariablesAndFluxes(flags_ind);
-  auto hydro_pkg = pmb->packages.Get("Hydro");
-
-  auto const &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-
-  const int ndim = pmb->pmy_mesh->ndim;
-
-  const auto &mom_diff = hydro_pkg->Param<MomentumDiffusivity>("mom_diff");
-  // Using fixed and uniform coefficient so it's safe to get it outside the kernel.
-  // Using 0.0 as parameters rho and p as they're not used anyway for a fixed coeff.
-  const auto nu = mom_diff.Get(0.0, 0.0);
-
-  const int scratch_level =
-      hydro_pkg->Param<int>("scratch_level"); // 0 is actual scratch (tiny); 1 is HBM
-  const int nx1 = pmb->cellbounds.ncellsi(IndexDomain::entire);
-
-  size_t scratch_size_in_bytes = parthenon::ScratchPad1D<Real>::shmem_size(nx1) * 3;
-
-  parthenon::par_for_outer(
-      DEFAULT_OUTER_LOOP_PATTERN, "Visc. X1 fluxes (iso)", DevExecSpace(),
-      scratch_size_in_bytes, scratch_level, 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s,
-      jb.e,
-      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k, const int j) {
-        const auto &coords = prim_pack.GetCoords(b);
-        auto &cons = cons_pack(b);
-        const auto &prim = prim_pack(b);
-        parthenon::ScratchPad1D<Real> fvx(member.team_scratch(scratch_level), nx1);
-        parthenon::ScratchPad1D<Real> fvy(member.team_scratch(scratch_level), nx1);
-        parthenon::ScratchPad1D<Real> fvz(member.team_scratch(scratch_level), nx1);
-
-        // Add [2(dVx/dx)-(2/3)dVx/dx, dVy/dx, dVz/dx]
-        par_for_inner(member, ib.s, ib.e + 1, [&](const int i) {
-          fvx(i) = 4.0 * (prim(IV1, k, j, i) - prim(IV1, k, j, i - 1)) /
-                   (3.0 * coords.Dxc<1>(i));
-          fvy(i) = (prim(IV2, k, j, i) - prim(IV2, k, j, i - 1)) / coords.Dxc<1>(i);
-          fvz(i) = (prim(IV3, k, j, i) - prim(IV3, k, j, i - 1)) / coords.Dxc<1>(i);
-        });
-        member.team_barrier();
-
-        // In 2D/3D Add [(-2/3)dVy/dy, dVx/dy, 0]
-        if (ndim > 1) {
-          par_for_inner(member, ib.s, ib.e + 1, [&](const int i) {
-            fvx(i) -= ((prim(IV2, k, j + 1, i) + prim(IV2, k, j + 1, i - 1)) -
-                       (prim(IV2, k, j - 1, i) + prim(IV2, k, j - 1, i - 1))) /
-                      (6.0 * coords.Dxc<2>(j));
-            fvy(i) += ((prim(IV1, k, j + 1, i) + prim(IV1, k, j + 1, i - 1)) -
-                       (prim(IV1, k, j - 1, i) + prim(IV1, k, j - 1, i - 1))) /
-                      (4.0 * coords.Dxc<2>(j));
-          });
-          member.team_barrier();
-        }
-
-        // In 3D Add [(-2/3)dVz/dz, 0,  dVx/dz]
-        if (ndim > 2) {
-          par_for_inner(member, ib.s, ib.e + 1, [&](const int i) {
-            fvx(i) -= ((prim(IV3, k + 1, j, i) + prim(IV3, k + 1, j, i - 1)) -
-                       (prim(IV3, k - 1, j, i) + prim(IV3, k - 1, j, i - 1))) /
-                      (6.0 * coords.Dxc<3>(k));
-            fvz(i) += ((prim(IV1, k + 1, j, i) + prim(IV1, k + 1, j, i - 1)) -
-                       (prim(IV1, k - 1, j, i) + prim(IV1, k - 1, j, i - 1))) /
-                      (4.0 * coords.Dxc<3>(k));
-          });
-          member.team_barrier();
-        }
-
-        // Sum viscous fluxes into fluxes of conserved variables; including energy fluxes
-        par_for_inner(member, ib.s, ib.e + 1, [&](const int i) {
-          Real nud = 0.5 * nu * (prim(IDN, k, j, i) + prim(IDN, k, j, i - 1));
-          cons.flux(X1DIR, IV1, k, j, i) -= nud * fvx(i);
-          cons.flux(X1DIR, IV2, k, j, i) -= nud * fvy(i);
-          cons.flux(X1DIR, IV3, k, j, i) -= nud * fvz(i);
-          cons.flux(X1DIR, IEN, k, j, i) -=
-              0.5 * nud *
-              ((prim(IV1, k, j, i - 1) + prim(IV1, k, j, i)) * fvx(i) +
-               (prim(IV2, k, j, i - 1) + prim(IV2, k, j, i)) * fvy(i) +
-               (prim(IV3, k, j, i - 1) + prim(IV3, k, j, i)) * fvz(i));
-        });
-      });
-
-  if (ndim < 2) {
-    return;
-  }
-  /* Compute viscous fluxes in 2-direction  --------------------------------------*/
-  parthenon::par_for_outer(
-      DEFAULT_OUTER_LOOP_PATTERN, "Visc. X2 fluxes (iso)", parthenon::DevExecSpace(),
-      scratch_size_in_bytes, scratch_level, 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s,
-      jb.e + 1,
-      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k, const int j) {
-        const auto &coords = prim_pack.GetCoords(b);
-        auto &cons = cons_pack(b);
-        const auto &prim = prim_pack(b);
-        parthenon::ScratchPad1D<Real> fvx(member.team_scratch(scratch_level), nx1);
-        parthenon::ScratchPad1D<Real> fvy(member.team_scratch(scratch_level), nx1);
-        parthenon::ScratchPad1D<Real> fvz(member.team_scratch(scratch_level), nx1);
-
-        // Add [(dVx/dy+dVy/dx), 2(dVy/dy)-(2/3)(dVx/dx+dVy/dy), dVz/dy]
-        par_for_inner(member, ib.s, ib.e, [&](const int i) {
-          fvx(i) = (prim(IV1, k, j, i) - prim(IV1, k, j - 1, i)) / coords.Dxc<2>(j) +
-                   ((prim(IV2, k, j, i + 1) + prim(IV2, k, j - 1, i + 1)) -
-                    (prim(IV2, k, j, i - 1) + prim(IV2, k, j - 1, i - 1))) /
-                       (4.0 * coords.Dxc<1>(i));
-          fvy(i) = (prim(IV2, k, j, i) - prim(IV2, k, j - 1, i)) * 4.0 /
-                       (3.0 * coords.Dxc<2>(j)) -
-                   ((prim(IV1, k, j, i + 1) + prim(IV1, k, j - 1, i + 1)) -
-                    (prim(IV1, k, j, i - 1) + prim(IV1, k, j - 1, i - 1))) /
-                       (6.0 * coords.Dxc<1>(i));
-          fvz(i) = (prim(IV3, k, j, i) - prim(IV3, k, j - 1, i)) / coords.Dxc<2>(j);
-        });
-        member.team_barrier();
-
-        // In 3D Add [0, (-2/3)dVz/dz, dVy/dz]
-        if (ndim > 2) {
-          par_for_inner(member, ib.s, ib.e, [&](const int i) {
-            fvy(i) -= ((prim(IV3, k + 1, j, i) + prim(IV3, k + 1, j - 1, i)) -
-                       (prim(IV3, k - 1, j, i) + prim(IV3, k - 1, j - 1, i))) /
-                      (6.0 * coords.Dxc<3>(k));
-            fvz(i) += ((prim(IV2, k + 1, j, i) + prim(IV2, k + 1, j - 1, i)) -
-                       (prim(IV2, k - 1, j, i) + prim(IV2, k - 1, j - 1, i))) /
-                      (4.0 * coords.Dxc<3>(k));
-          });
-          member.team_barrier();
-        }
-
-        // Sum viscous fluxes into fluxes of conserved variables; including energy fluxes
-        par_for_inner(member, ib.s, ib.e, [&](const int i) {
-          Real nud = 0.5 * nu * (prim(IDN, k, j, i) + prim(IDN, k, j - 1, i));
-          cons.flux(X2DIR, IV1, k, j, i) -= nud * fvx(i);
-          cons.flux(X2DIR, IV2, k, j, i) -= nud * fvy(i);
-          cons.flux(X2DIR, IV3, k, j, i) -= nud * fvz(i);
-          cons.flux(X2DIR, IEN, k, j, i) -=
-              0.5 * nud *
-              ((prim(IV1, k, j - 1, i) + prim(IV1, k, j, i)) * fvx(i) +
-               (prim(IV2, k, j - 1, i) + prim(IV2, k, j, i)) * fvy(i) +
-               (prim(IV3, k, j - 1, i) + prim(IV3, k, j, i)) * fvz(i));
-        });
-      });
-  /* Compute heat fluxes in 3-direction, 3D problem ONLY  ---------------------*/
-  if (ndim < 3) {
-    return;
-  }
-
-  parthenon::par_for_outer(
-      DEFAULT_OUTER_LOOP_PATTERN, "Visc. X3 fluxes (iso)", parthenon::DevExecSpace(),
-      scratch_size_in_bytes, scratch_level, 0, cons_pack.GetDim(5) - 1, kb.s, kb.e + 1,
-      jb.s, jb.e,
-      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k, const int j) {
-        const auto &coords = prim_pack.GetCoords(b);
-        auto &cons = cons_pack(b);
-        const auto &prim = prim_pack(b);
-
-        parthenon::ScratchPad1D<Real> fvx(member.team_scratch(scratch_level), nx1);
-        parthenon::ScratchPad1D<Real> fvy(member.team_scratch(scratch_level), nx1);
-        parthenon::ScratchPad1D<Real> fvz(member.team_scratch(scratch_level), nx1);
-
-        // Add [(dVx/dz+dVz/dx), (dVy/dz+dVz/dy), 2(dVz/dz)-(2/3)(dVx/dx+dVy/dy+dVz/dz)]
-        par_for_inner(member, ib.s, ib.e, [&](const int i) {
-          fvx(i) = (prim(IV1, k, j, i) - prim(IV1, k - 1, j, i)) / coords.Dxc<3>(k) +
-                   ((prim(IV3, k, j, i + 1) + prim(IV3, k - 1, j, i + 1)) -
-                    (prim(IV3, k, j, i - 1) + prim(IV3, k - 1, j, i - 1))) /
-                       (4.0 * coords.Dxc<1>(i));
-          fvy(i) = (prim(IV2, k, j, i) - prim(IV2, k - 1, j, i)) / coords.Dxc<3>(k) +
-                   ((prim(IV3, k, j + 1, i) + prim(IV3, k - 1, j + 1, i)) -
-                    (prim(IV3, k, j - 1, i) + prim(IV3, k - 1, j - 1, i))) /
-                       (4.0 * coords.Dxc<2>(j));
-          fvz(i) = (prim(IV3, k, j, i) - prim(IV3, k - 1, j, i)) * 4.0 /
-                       (3.0 * coords.Dxc<3>(k)) -
-                   ((prim(IV1, k, j, i + 1) + prim(IV1, k - 1, j, i + 1)) -
-                    (prim(IV1, k, j, i - 1) + prim(IV1, k - 1, j, i - 1))) /
-                       (6.0 * coords.Dxc<1>(i)) -
-                   ((prim(IV2, k, j + 1, i) + prim(IV2, k - 1, j + 1, i)) -
-                    (prim(IV2, k, j - 1, i) + prim(IV2, k - 1, j - 1, i))) /
-                       (6.0 * coords.Dxc<2>(j));
-        });
-        member.team_barrier();
-
-        // Sum viscous fluxes into fluxes of conserved variables; including energy fluxes
-        par_for_inner(member, ib.s, ib.e, [&](const int i) {
-          Real nud = 0.5 * nu * (prim(IDN, k, j, i) + prim(IDN, k - 1, j, i));
-          cons.flux(X3DIR, IV1, k, j, i) -= nud * fvx(i);
-          cons.flux(X3DIR, IV2, k, j, i) -= nud * fvy(i);
-          cons.flux(X3DIR, IV3, k, j, i) -= nud * fvz(i);
-          cons.flux(X3DIR, IEN, k, j, i) -=
-              0.5 * nud *
-              ((prim(IV1, k - 1, j, i) + prim(IV1, k, j, i)) * fvx(i) +
-               (prim(IV2, k - 1, j, i) + prim(IV2, k, j, i)) * fvy(i) +
-               (prim(IV3, k - 1, j, i) + prim(IV3, k, j, i)) * fvz(i));
-        });
-      });
-}
-
-//---------------------------------------------------------------------------------------
-//! TODO(pgrete) Calculate momentum diffusion, general case, i.e., anisotropic and/or with
-//! varying coefficient
-
-void MomentumDiffFluxGeneral(MeshData<Real> *md) { PARTHENON_THROW("Needs impl."); }
@@ -5,17 +5,64 @@
 //========================================================================================
 
 // Parthenon headers
+#include "interface/update.hpp"
 #include <parthenon/package.hpp>
 
 // AthenaPK headers
 #include "../../main.hpp"
+#include "../hydro.hpp"
 
 using namespace parthenon::package::prelude;
 
 namespace Hydro::GLMMHD {
 
-template <bool extended>
-void DednerSource(MeshData<Real> *md, const Real beta_dt) {
+// Using an alpha based parameter here following Mignone & Tzeferacos 2010 (27)
+Real DampingCoeff(MeshData<Real> *md, const Real beta_dt) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto c_h = hydro_pkg->Param<Real>("c_h");
+  const auto mindx = hydro_pkg->Param<Real>("mindx");
+  const auto alpha = hydro_pkg->Param<Real>("glmmhd_alpha");
+  return std::exp(-alpha * c_h * beta_dt / mindx);
+}
+
+// Adds the source to the conserved variables of cell (k, j, i) based on the primitive
+// variables (at the beginning of the stage) and damps psi by coeff.
+// k_offset is 0 in 2D so that the second order x3-derivatives are zero.
+// Should (untested) not introduce a performance penalty, as vals at k,j,i are
+// in the cache line from x1 derivative.
+template <bool extended, typename TCons, typename TPrim>
+KOKKOS_INLINE_FUNCTION void
+DednerCellSource(TCons &cons, const TPrim &prim, const parthenon::Coordinates_t &coords,
+                 const int k_offset, const Real beta_dt, const Real coeff, const int k,
+                 const int j, const int i) {
+  // Use extended source terms that is non-conservative but has better
+  // stability properties as reported by Dedner+ and M&T
+  if (extended) {
+    const Real divB =
+        0.5 *
+        ((prim(IB1, k, j, i + 1) - prim(IB1, k, j, i - 1)) / coords.Dxc<1>(k, j, i) +
+         (prim(IB2, k, j + 1, i) - prim(IB2, k, j - 1, i)) / coords.Dxc<2>(k, j, i) +
+         (prim(IB3, k + k_offset, j, i) - prim(IB3, k - k_offset, j, i)) /
+             coords.Dxc<3>(k, j, i));
+    cons(IM1, k, j, i) -= beta_dt * divB * prim(IB1, k, j, i);
+    cons(IM2, k, j, i) -= beta_dt * divB * prim(IB2, k, j, i);
+    cons(IM3, k, j, i) -= beta_dt * divB * prim(IB3, k, j, i);
+    cons(IEN, k, j, i) -=
+        0.5 * beta_dt *
+        (prim(IB1, k, j, i) * (prim(IPS, k, j, i + 1) - prim(IPS, k, j, i - 1)) /
+             coords.Dxc<1>(k, j, i) +
+         prim(IB2, k, j, i) * (prim(IPS, k, j + 1, i) - prim(IPS, k, j - 1, i)) /
+             coords.Dxc<2>(k, j, i) +
+         prim(IB3, k, j, i) *
+             (prim(IPS, k + k_offset, j, i) - prim(IPS, k - k_offset, j, i)) /
+             coords.Dxc<3>(k, j, i));
+  }
+  cons(IPS, k, j, i) *= coeff;
+}
+
+// Specialized on the number of dimensions NDIM, see DispatchNDim
+template <bool extended, int NDIM>
+void DednerSourceNDim(MeshData<Real> *md, const Real beta_dt) {
   auto cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
   const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
 
@@ -23,57 +70,95 @@ void DednerSource(MeshData<Real> *md, const Real beta_dt) {
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-  const auto c_h = hydro_pkg->Param<Real>("c_h");
-  const auto mindx = hydro_pkg->Param<Real>("mindx");
-  const auto alpha = hydro_pkg->Param<Real>("glmmhd_alpha");
-
-  // Using an alpha based parameter here following Mignone & Tzeferacos 2010 (27)
-  const auto coeff = std::exp(-alpha * c_h * beta_dt / mindx);
-
-  int k_offset = 1;
-  // In 2D, offset is 0 so that the second order x3-derivatives are zero
-  // Should (untested) not introduce a performance penalty, as vals at k,j,i are
-  // in the cache line from x1 derivative.
-  if (cons_pack.GetNdim() < 3) {
-    k_offset = 0;
-  }
+  const auto coeff = DampingCoeff(md, beta_dt);
+  constexpr int k_offset = NDIM < 3 ? 0 : 1;
 
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "DednerSource", parthenon::DevExecSpace(), 0,
+      DEFAULT_LOOP_PATTERN, "SrcTerms::DednerSource", parthenon::DevExecSpace(), 0,
       cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
-        // Use extended source terms that is non-conservative but has better
-        // stability properties as reported by Dedner+ and M&T
-        // TODO(pgrete) Once nvcc is fixed this could be constexpr if again
-        if (extended) {
-          auto &cons = cons_pack(b);
-          const auto &prim = prim_pack(b);
-          const auto &coords = prim_pack.GetCoords(b);
-          const Real divB =
-              0.5 * ((prim(IB1, k, j, i + 1) - prim(IB1, k, j, i - 1)) /
-                         coords.Dxc<1>(k, j, i) +
-                     (prim(IB2, k, j + 1, i) - prim(IB2, k, j - 1, i)) /
-                         coords.Dxc<2>(k, j, i) +
-                     (prim(IB3, k + k_offset, j, i) - prim(IB3, k - k_offset, j, i)) /
-                         coords.Dxc<3>(k, j, i));
-          cons(IM1, k, j, i) -= beta_dt * divB * prim(IB1, k, j, i);
-          cons(IM2, k, j, i) -= beta_dt * divB * prim(IB2, k, j, i);
-          cons(IM3, k, j, i) -= beta_dt * divB * prim(IB3, k, j, i);
-          cons(IEN, k, j, i) -=
-              0.5 * beta_dt *
-              (prim(IB1, k, j, i) * (prim(IPS, k, j, i + 1) - prim(IPS, k, j, i - 1)) /
-                   coords.Dxc<1>(k, j, i) +
-               prim(IB2, k, j, i) * (prim(IPS, k, j + 1, i) - prim(IPS, k, j - 1, i)) /
-                   coords.Dxc<2>(k, j, i) +
-               prim(IB3, k, j, i) *
-                   (prim(IPS, k + k_offset, j, i) - prim(IPS, k - k_offset, j, i)) /
-                   coords.Dxc<3>(k, j, i));
-        }
-        cons_pack(b, IPS, k, j, i) *= coeff;
+        auto &cons = cons_pack(b);
+        DednerCellSource<extended>(cons, prim_pack(b), prim_pack.GetCoords(b), k_offset,
+                                   beta_dt, coeff, k, j, i);
       });
 }
+
+template <bool extended>
+void DednerSource(MeshData<Real> *md, const Real beta_dt) {
+  DispatchNDim(md->GetMeshPointer()->ndim, [&](auto dim) {
+    DednerSourceNDim<extended, decltype(dim)::value>(md, beta_dt);
+  });
+}
 template void DednerSource<true>(MeshData<Real> *md, const Real beta_dt);
 template void DednerSource<false>(MeshData<Real> *md, const Real beta_dt);
 
+// Specialized on the number of dimensions NDIM, see DispatchNDim
+template <bool extended, int NDIM>
+TaskStatus
+UpdateWithFluxDivergenceAndSourceNDim(MeshData<Real> *u0_data, MeshData<Real> *u1_data,
+                                      const Real gam0_, const Real gam1_,
+                                      const Real beta_dt_) {
+  // Work around for CUDA <=11.6
+  const Real gam0 = gam0_;
+  const Real gam1 = gam1_;
+  const Real beta_dt = beta_dt_;
+
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto u0_cons_pack = u0_data->PackVariablesAndFluxes(flags_ind);
+  auto u1_cons_pack = u1_data->PackVariables(flags_ind);
+  // "cons" is packed separately to use the same variable indices as DednerSource
+  auto cons_pack = u0_data->PackVariables(std::vector<std::string>{"cons"});
+  const auto &prim_pack = u0_data->PackVariables(std::vector<std::string>{"prim"});
+
+  IndexRange ib = u0_data->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = u0_data->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = u0_data->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  const auto coeff = DampingCoeff(u0_data, beta_dt);
+  constexpr int ndim = NDIM;
+  constexpr int k_offset = NDIM < 3 ? 0 : 1;
+  const auto nvars = u0_cons_pack.GetDim(4);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "SrcTerms::UpdateWithFluxDivergenceAndDednerSource",
+      parthenon::DevExecSpace(), 0, u0_cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e,
+      ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &coords = u0_cons_pack.GetCoords(b);
+        auto &u0_cons = u0_cons_pack(b);
+        // Same update as parthenon::Update::UpdateWithFluxDivergence
+        for (auto v = 0; v < nvars; v++) {
+          if (!u0_cons.IsAllocated(v)) continue;
+          u0_cons(v, k, j, i) =
+              gam0 * u0_cons(v, k, j, i) +
+              (gam1 != 0.0 ? gam1 * u1_cons_pack(b, v, k, j, i) : 0.0) +
+              beta_dt *
+                  parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, u0_cons);
+        }
+        auto &cons = cons_pack(b);
+        DednerCellSource<extended>(cons, prim_pack(b), coords, k_offset, beta_dt, coeff,
+                                   k, j, i);
+      });
+  return TaskStatus::complete;
+}
+
+template <bool extended>
+TaskStatus UpdateWithFluxDivergenceAndSource(MeshData<Real> *u0_data,
+                                             MeshData<Real> *u1_data, const Real gam0,
+                                             const Real gam1, const Real beta_dt) {
+  return DispatchNDim(u0_data->GetMeshPointer()->ndim, [&](auto dim) {
+    return UpdateWithFluxDivergenceAndSourceNDim<extended, decltype(dim)::value>(
+        u0_data, u1_data, gam0, gam1, beta_dt);
+  });
+}
+template TaskStatus UpdateWithFluxDivergenceAndSource<true>(MeshData<Real> *u0_data,
+                                                            MeshData<Real> *u1_data,
+                                                            const Real gam0,
+                                                            const Real gam1,
+                                                            const Real beta_dt);
+template TaskStatus UpdateWithFluxDivergenceAndSource<false>(MeshData<Real> *u0_data,
+                                                             MeshData<Real> *u1_data,
+                                                             const Real gam0,
+                                                             const Real gam1,
+                                                             const Real beta_dt);
+
 } // namespace Hydro::GLMMHD
\ No newline at end of file
@@ -21,6 +21,16 @@ void DednerSource(MeshData<Real> *md, const Real beta_dt);
 
 using SourceFun_t = std::function<void(MeshData<Real> *md, const Real beta_dt)>;
 
+// Flux divergence update u0 = gam0 * u0 + gam1 * u1 + beta_dt * div(F) (as
+// parthenon::Update::UpdateWithFluxDivergence) followed by the DednerSource<extended>
+// of the same cell in a single kernel (with <hydro/glmmhd_fused_source>).
+template <bool extended>
+TaskStatus UpdateWithFluxDivergenceAndSource(MeshData<Real> *u0_data,
+                                             MeshData<Real> *u1_data, const Real gam0,
+                                             const Real gam1, const Real beta_dt);
+
+using FusedUpdateFun_t = decltype(UpdateWithFluxDivergenceAndSource<false>);
+
 } // namespace Hydro::GLMMHD
 
 #endif // HYDRO_GLMMHD_GLMMHD_HPP_
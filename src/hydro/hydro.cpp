@@ -6,7 +6,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -16,6 +18,7 @@
 // AthenaPK headers
 #include "../eos/adiabatic_glmmhd.hpp"
 #include "../eos/adiabatic_hydro.hpp"
+#include "../eos/tabulated_hydro.hpp"
 #include "../main.hpp"
 #include "../pgen/pgen.hpp"
 #include "../recon/dc_simple.hpp"
@@ -27,12 +30,23 @@
 #include "../refinement/refinement.hpp"
 #include "../tracers/tracers.hpp"
 #include "../units.hpp"
+#include "../utils/ensemble.hpp"
+#include "../utils/failure_counter.hpp"
+#include "../utils/global_reductions.hpp"
+#include "../utils/history.hpp"
+#include "../utils/profiling.hpp"
+#include "../utils/rank_metrics.hpp"
+#include "../utils/shared_params.hpp"
+#include "../utils/snapshot.hpp"
+#include "cell_crossing_time.hpp"
 #include "defs.hpp"
 #include "diffusion/diffusion.hpp"
+#include "diffusion/diffusion_timestep.hpp"
 #include "glmmhd/glmmhd.hpp"
 #include "hydro.hpp"
 #include "interface/params.hpp"
 #include "outputs/outputs.hpp"
+#include "pack_cache.hpp"
 #include "prolongation/custom_ops.hpp"
 #include "rsolvers/rsolvers.hpp"
 #include "srcterms/tabular_cooling.hpp"
@@ -77,8 +91,8 @@ Real CalculateGlobalMinDx(MeshData<Real> *md) {
   bool nx2 = prim_pack.GetDim(2) > 1;
   bool nx3 = prim_pack.GetDim(3) > 1;
   pmb->par_reduce(
-      "CalculateGlobalMinDx", 0, prim_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e,
+      "Hydro::CalculateGlobalMinDx", 0, prim_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e,
+      ib.s, ib.e,
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lmindx) {
         const auto &coords = prim_pack.GetCoords(b);
         lmindx = fmin(lmindx, coords.Dxc<1>(k, j, i));
@@ -108,38 +122,147 @@ void PreStepMeshUserWorkInLoop(Mesh *pmesh, ParameterInput *pin, SimTime &tm) {
   if (hydro_pkg->Param<bool>("calc_c_h") ||
       hydro_pkg->Param<DiffInt>("diffint") != DiffInt::none) {
 
-    Real mindx = std::numeric_limits<Real>::max();
-    // Going over default partitions. Not using a (new) single partition containing
-    // all blocks here as this (default) split is also used main Step() function and
-    // thus does not create an overhead (such as creating a new MeshBlockPack that is just
-    // used here). All partitions are executed sequentially. Given that a par_reduce to a
-    // host var is blocking it's save to dirctly use the return value.
-    const int num_partitions = pmesh->DefaultNumPartitions();
-    for (int i = 0; i < num_partitions; i++) {
-      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      mindx = std::min(mindx, CalculateGlobalMinDx(mu0.get()));
-    }
+    auto *reductions =
+        hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+    if (hydro_pkg->Param<bool>("async_dt_reduction") &&
+        reductions->IsInFlight("timestep")) {
+      // Reduction of dt_hyp and dt_diff has been started at the end of the last cycle.
+      // mindx is constant without adaptive mesh refinement and kept from the first cycle.
+      reductions->WaitReduce("timestep");
+      hydro_pkg->UpdateParam("dt_hyp", reductions->Get("dt_hyp"));
+      hydro_pkg->UpdateParam("dt_diff", reductions->Get("dt_diff"));
+    } else {
+      Real mindx = std::numeric_limits<Real>::max();
+      // Going over default partitions. Not using a (new) single partition containing
+      // all blocks here as this (default) split is also used main Step() function and
+      // thus does not create an overhead (such as creating a new MeshBlockPack that is
+      // just used here). All partitions are executed sequentially. Given that a
+      // par_reduce to a host var is blocking it's save to dirctly use the return value.
+      const int num_partitions = pmesh->DefaultNumPartitions();
+      for (int i = 0; i < num_partitions; i++) {
+        auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+        mindx = std::min(mindx, CalculateGlobalMinDx(mu0.get()));
+      }
 #ifdef MPI_PARALLEL
-    Real mins[3];
-    mins[0] = mindx;
-    mins[1] = hydro_pkg->Param<Real>("dt_hyp");
-    mins[2] = hydro_pkg->Param<Real>("dt_diff");
-    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, mins, 3, MPI_PARTHENON_REAL, MPI_MIN,
-                                      MPI_COMM_WORLD));
-
-    hydro_pkg->UpdateParam("mindx", mins[0]);
-    hydro_pkg->UpdateParam("dt_hyp", mins[1]);
-    hydro_pkg->UpdateParam("dt_diff", mins[2]);
+      Real mins[3];
+      mins[0] = mindx;
+      mins[1] = hydro_pkg->Param<Real>("dt_hyp");
+      mins[2] = hydro_pkg->Param<Real>("dt_diff");
+      PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, mins, 3, MPI_PARTHENON_REAL,
+                                        MPI_MIN, MPI_COMM_WORLD));
+
+      hydro_pkg->UpdateParam("mindx", mins[0]);
+      hydro_pkg->UpdateParam("dt_hyp", mins[1]);
+      hydro_pkg->UpdateParam("dt_diff", mins[2]);
 #else
-    hydro_pkg->UpdateParam("mindx", mindx);
-    // dt_hyp and dt_diff are already set directly in Params when they're calculated
+      hydro_pkg->UpdateParam("mindx", mindx);
+      // dt_hyp and dt_diff are already set directly in Params when they're calculated
 #endif
+    }
     // Finally update c_h
     const auto &cfl_hyp = hydro_pkg->Param<Real>("cfl");
     const auto &dt_hyp = hydro_pkg->Param<Real>("dt_hyp");
     mindx = hydro_pkg->Param<Real>("mindx");
     hydro_pkg->UpdateParam("c_h", cfl_hyp * mindx / dt_hyp);
   }
+
+  // Snapshots are taken from the state at the beginning of a cycle
+  if (hydro_pkg->AllParams().hasKey("snapshot")) {
+    auto snapshot = hydro_pkg->Param<std::shared_ptr<utils::AsyncSnapshot>>("snapshot");
+    if (snapshot->IsDue(tm.time)) {
+      if (ProblemUserMeshWorkBeforeOutput != nullptr) {
+        ProblemUserMeshWorkBeforeOutput(pmesh, pin, tm);
+      }
+      snapshot->Write(pmesh, tm.ncycle, tm.time);
+    }
+  }
+
+  if (ProblemPreStepMeshUserWork != nullptr) {
+    ProblemPreStepMeshUserWork(pmesh, pin, tm);
+  }
+}
+
+void UserMeshWorkBeforeOutput(Mesh *pmesh, ParameterInput *pin, const SimTime &tm) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  // In particular, restart dumps are only written once all snapshots are complete
+  if (hydro_pkg->AllParams().hasKey("snapshot")) {
+    hydro_pkg->Param<std::shared_ptr<utils::AsyncSnapshot>>("snapshot")->WaitAll();
+  }
+  if (ProblemUserMeshWorkBeforeOutput != nullptr) {
+    ProblemUserMeshWorkBeforeOutput(pmesh, pin, tm);
+  }
+}
+
+TaskStatus SetLoadBalancingCosts(MeshData<Real> *md) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto cooling_weight = hydro_pkg->Param<Real>("lb_cooling_cost_weight");
+  auto tracers_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("tracers");
+  const auto tracer_weight = tracers_pkg->Param<bool>("enabled")
+                                 ? tracers_pkg->Param<Real>("lb_cost_weight")
+                                 : 0.0;
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+  const Real ncells = (ib.e - ib.s + 1) * (jb.e - jb.s + 1) * (kb.e - kb.s + 1);
+  utils::shared_params::WithMutableParam<std::map<int, Real>>(
+      hydro_pkg.get(), "lb_cooling_substeps", [&](auto *lb_cooling_substeps) {
+        for (int b = 0; b < md->NumBlocks(); b++) {
+          auto pmb = md->GetBlockData(b)->GetBlockPointer();
+          // Cost of the hydro update is 1 per block with additional costs in units of
+          // the cost of the hydro update of a cell.
+          Real cost = 1.0;
+          auto it = lb_cooling_substeps->find(pmb->gid);
+          if (it != lb_cooling_substeps->end()) {
+            cost += cooling_weight * it->second / ncells;
+            lb_cooling_substeps->erase(it);
+          }
+          if (tracer_weight > 0.0) {
+            const auto &swarm = md->GetBlockData(b)->GetSwarmData()->Get("tracers");
+            cost += tracer_weight * swarm->GetNumActive() / ncells;
+          }
+          pmb->SetCostForLoadBalancing(cost);
+        }
+      });
+  return TaskStatus::complete;
+}
+
+// Contribution of cell (k, j, i) to the history output quantity hst
+template <Hst hst, int idx, typename TCons>
+KOKKOS_INLINE_FUNCTION Real HydroHstCell(const TCons &cons,
+                                         const parthenon::Coordinates_t &coords,
+                                         const bool three_d, const int k, const int j,
+                                         const int i) {
+  if (hst == Hst::idx) {
+    return cons(idx, k, j, i) * coords.CellVolume(k, j, i);
+  } else if (hst == Hst::ekin) {
+    return 0.5 / cons(IDN, k, j, i) *
+           (SQR(cons(IM1, k, j, i)) + SQR(cons(IM2, k, j, i)) + SQR(cons(IM3, k, j, i))) *
+           coords.CellVolume(k, j, i);
+  } else if (hst == Hst::emag) {
+    return 0.5 *
+           (SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) + SQR(cons(IB3, k, j, i))) *
+           coords.CellVolume(k, j, i);
+    // relative divergence of B error, i.e., L * |div(B)| / |B|
+  } else if (hst == Hst::divb) {
+    Real divb =
+        (cons(IB1, k, j, i + 1) - cons(IB1, k, j, i - 1)) / coords.Dxc<1>(k, j, i) +
+        (cons(IB2, k, j + 1, i) - cons(IB2, k, j - 1, i)) / coords.Dxc<2>(k, j, i);
+    if (three_d) {
+      divb += (cons(IB3, k + 1, j, i) - cons(IB3, k - 1, j, i)) / coords.Dxc<3>(k, j, i);
+    }
+
+    Real abs_b = std::sqrt(SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) +
+                           SQR(cons(IB3, k, j, i)));
+
+    return (abs_b != 0) ? 0.5 *
+                              (std::sqrt(SQR(coords.Dxc<1>(k, j, i)) +
+                                         SQR(coords.Dxc<2>(k, j, i)) +
+                                         SQR(coords.Dxc<3>(k, j, i)))) *
+                              std::abs(divb) / abs_b * coords.CellVolume(k, j, i)
+                        : 0; // Add zero when abs_b ==0
+  }
+  return 0.0;
 }
 
 template <Hst hst, int idx = -1>
@@ -160,7 +283,7 @@ Real HydroHst(MeshData<Real> *md) {
     PARTHENON_FAIL("Idx based hst output needs index >= 0");
   }
   Kokkos::parallel_reduce(
-      "HydroHst",
+      "Hydro::HydroHst",
       Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
           DevExecSpace(), {0, kb.s, jb.s, ib.s},
           {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
@@ -168,43 +291,105 @@ Real HydroHst(MeshData<Real> *md) {
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
         const auto &cons = cons_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
+        lsum += HydroHstCell<hst, idx>(cons, coords, three_d, k, j, i);
+      },
+      sum);
 
-        if (hst == Hst::idx) {
-          lsum += cons(idx, k, j, i) * coords.CellVolume(k, j, i);
-        } else if (hst == Hst::ekin) {
-          lsum += 0.5 / cons(IDN, k, j, i) *
-                  (SQR(cons(IM1, k, j, i)) + SQR(cons(IM2, k, j, i)) +
-                   SQR(cons(IM3, k, j, i))) *
-                  coords.CellVolume(k, j, i);
-        } else if (hst == Hst::emag) {
-          lsum += 0.5 *
-                  (SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) +
-                   SQR(cons(IB3, k, j, i))) *
-                  coords.CellVolume(k, j, i);
-          // relative divergence of B error, i.e., L * |div(B)| / |B|
-        } else if (hst == Hst::divb) {
-          Real divb =
-              (cons(IB1, k, j, i + 1) - cons(IB1, k, j, i - 1)) / coords.Dxc<1>(k, j, i) +
-              (cons(IB2, k, j + 1, i) - cons(IB2, k, j - 1, i)) / coords.Dxc<2>(k, j, i);
-          if (three_d) {
-            divb += (cons(IB3, k + 1, j, i) - cons(IB3, k - 1, j, i)) /
-                    coords.Dxc<3>(k, j, i);
-          }
+  return sum;
+}
+
+// Same quantities (and order) as the individual HydroHst outputs registered below but
+// calculated in a single pass over the data, see utils/history.hpp.
+template <Fluid fluid>
+std::vector<Real> FusedHydroHst(MeshData<Real> *md) {
+  constexpr int nhst = fluid == Fluid::glmmhd ? 8 : 6;
+  using Sums_t = utils::history::Sums<nhst>;
 
-          Real abs_b = std::sqrt(SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) +
-                                 SQR(cons(IB3, k, j, i)));
+  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  const bool three_d = cons_pack.GetNdim() == 3;
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
-          lsum += (abs_b != 0) ? 0.5 *
-                                     (std::sqrt(SQR(coords.Dxc<1>(k, j, i)) +
-                                                SQR(coords.Dxc<2>(k, j, i)) +
-                                                SQR(coords.Dxc<3>(k, j, i)))) *
-                                     std::abs(divb) / abs_b * coords.CellVolume(k, j, i)
-                               : 0; // Add zero when abs_b ==0
+  Sums_t sums;
+  Kokkos::parallel_reduce(
+      "Hydro::FusedHydroHst",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Sums_t &lsums) {
+        const auto &cons = cons_pack(b);
+        const auto &coords = cons_pack.GetCoords(b);
+        lsums.v[0] += HydroHstCell<Hst::idx, IDN>(cons, coords, three_d, k, j, i);
+        lsums.v[1] += HydroHstCell<Hst::idx, IM1>(cons, coords, three_d, k, j, i);
+        lsums.v[2] += HydroHstCell<Hst::idx, IM2>(cons, coords, three_d, k, j, i);
+        lsums.v[3] += HydroHstCell<Hst::idx, IM3>(cons, coords, three_d, k, j, i);
+        lsums.v[4] += HydroHstCell<Hst::ekin, -1>(cons, coords, three_d, k, j, i);
+        lsums.v[5] += HydroHstCell<Hst::idx, IEN>(cons, coords, three_d, k, j, i);
+        if constexpr (fluid == Fluid::glmmhd) {
+          lsums.v[6] += HydroHstCell<Hst::emag, -1>(cons, coords, three_d, k, j, i);
+          lsums.v[7] += HydroHstCell<Hst::divb, -1>(cons, coords, three_d, k, j, i);
         }
       },
-      sum);
+      Kokkos::Sum<Sums_t>(sums));
 
-  return sum;
+  return sums.ToVector();
+}
+
+// Flags cells whose neighbors (in any direction) differ in density or (for compressive
+// flows) in pressure by more than the relative threshold. Pencils without troubled cells
+// are reconstructed with the unlimited stencils in the hybrid reconstruction.
+void CalcTroubledCells(MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const auto threshold = hydro_pkg->Param<Real>("hybrid_reconstruction_threshold");
+
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  auto troubled_pack = md->PackVariables(std::vector<std::string>{"troubled"});
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+  const int ndim = hydro_pkg->Param<int>("ndim");
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Hydro::CalcTroubledCells", DevExecSpace(), 0,
+      prim_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &prim = prim_pack(b);
+        const auto &coords = prim_pack.GetCoords(b);
+        Real max_jump_p = 0.0;
+        Real max_jump_rho = 0.0;
+        Real div_v = 0.0;
+        // neighbors in direction d (clamped to the entire domain)
+        const auto add_dir = [&](const int d, const int km, const int kp, const int jm,
+                                 const int jp, const int im, const int ip,
+                                 const Real dx) {
+          const Real p_m = prim(IPR, km, jm, im);
+          const Real p_p = prim(IPR, kp, jp, ip);
+          const Real rho_m = prim(IDN, km, jm, im);
+          const Real rho_p = prim(IDN, kp, jp, ip);
+          max_jump_p = std::max(max_jump_p, std::abs(p_p - p_m) / std::min(p_p, p_m));
+          max_jump_rho =
+              std::max(max_jump_rho, std::abs(rho_p - rho_m) / std::min(rho_p, rho_m));
+          div_v += (prim(IV1 + d, kp, jp, ip) - prim(IV1 + d, km, jm, im)) / dx;
+        };
+        add_dir(0, k, k, j, j, std::max(i - 1, ib.s), std::min(i + 1, ib.e),
+                coords.Dxc<1>(k, j, i));
+        if (ndim >= 2) {
+          add_dir(1, k, k, std::max(j - 1, jb.s), std::min(j + 1, jb.e), i, i,
+                  coords.Dxc<2>(k, j, i));
+        }
+        if (ndim >= 3) {
+          add_dir(2, std::max(k - 1, kb.s), std::min(k + 1, kb.e), j, j, i, i,
+                  coords.Dxc<3>(k, j, i));
+        }
+        const bool troubled =
+            max_jump_rho > threshold || (div_v < 0.0 && max_jump_p > threshold);
+        troubled_pack(b, 0, k, j, i) = troubled ? 1.0 : 0.0;
+      });
 }
 
 // TOOD(pgrete) check is we can enlist this with FillDerived directly
@@ -212,9 +397,30 @@ Real HydroHst(MeshData<Real> *md) {
 // conserved variables to primitives
 template <class T>
 void ConsToPrim(MeshData<Real> *md) {
-  const auto &eos =
-      md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro")->Param<T>("eos");
-  eos.ConservedToPrimitive(md);
+  utils::profiling::ScopedRegion region("EOS::ConservedToPrimitive");
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &eos = hydro_pkg->Param<T>("eos");
+  const bool with_dt_hyp = hydro_pkg->Param<bool>("fused_dt_hyp_active");
+  Real dt_hyp = std::numeric_limits<Real>::max();
+  // Unless converted by the problem generator
+  if (ProblemConsToPrim == nullptr || !ProblemConsToPrim(md, with_dt_hyp, dt_hyp)) {
+    if (with_dt_hyp) {
+      dt_hyp = eos.ConservedToPrimitiveAndTimestep(md);
+    } else {
+      eos.ConservedToPrimitive(md);
+    }
+  }
+  if (with_dt_hyp) {
+    utils::shared_params::WithMutableParam<std::map<MeshData<Real> *, Real>>(
+        hydro_pkg.get(), "fused_dt_hyp_cache",
+        [&](auto *dt_hyp_cache) { (*dt_hyp_cache)[md] = dt_hyp; });
+  }
+  if (hydro_pkg->Param<bool>("diffusion_coeff_field")) {
+    CalcThermalDiffusivityField(md);
+  }
+  if (hydro_pkg->Param<bool>("hybrid_reconstruction")) {
+    CalcTroubledCells(md);
+  }
 }
 
 // Add unsplit sources, i.e., source that are integrated in all stages of the
@@ -225,9 +431,12 @@ void ConsToPrim(MeshData<Real> *md) {
 // Note 2: Directly update the "cons" variables based on the "prim" variables
 // as the "cons" variables have already been updated when this function is called.
 TaskStatus AddUnsplitSources(MeshData<Real> *md, const SimTime &tm, const Real beta_dt) {
+  utils::profiling::ScopedRegion region("SrcTerms::AddUnsplitSources");
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
-  if (hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd) {
+  // With <hydro/glmmhd_fused_source> already applied as part of the update
+  if (hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd &&
+      !hydro_pkg->Param<bool>("glmmhd_fused_source")) {
     hydro_pkg->Param<GLMMHD::SourceFun_t>("glmmhd_source")(md, beta_dt);
   }
   const auto &enable_cooling = hydro_pkg->Param<Cooling>("enable_cooling");
@@ -246,6 +455,7 @@ TaskStatus AddUnsplitSources(MeshData<Real> *md, const SimTime &tm, const Real b
 }
 
 TaskStatus AddSplitSourcesFirstOrder(MeshData<Real> *md, const SimTime &tm) {
+  utils::profiling::ScopedRegion region("SrcTerms::AddSplitSourcesFirstOrder");
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
   if (ProblemSourceFirstOrder != nullptr) {
@@ -255,6 +465,7 @@ TaskStatus AddSplitSourcesFirstOrder(MeshData<Real> *md, const SimTime &tm) {
 }
 
 TaskStatus AddSplitSourcesStrang(MeshData<Real> *md, const SimTime &tm) {
+  utils::profiling::ScopedRegion region("SrcTerms::AddSplitSourcesStrang");
   if (ProblemSourceStrangSplit != nullptr) {
     ProblemSourceStrangSplit(md, tm, tm.dt);
   }
@@ -264,8 +475,8 @@ TaskStatus AddSplitSourcesStrang(MeshData<Real> *md, const SimTime &tm) {
 std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   auto pkg = std::make_shared<StateDescriptor>("Hydro");
 
+  // The "cfl" param (added with the integrator below) also includes the SSP coefficient
   Real cfl = pin->GetOrAddReal("parthenon/time", "cfl", 0.3);
-  pkg->AddParam<>("cfl", cfl);
 
   bool pack_in_one = pin->GetOrAddBoolean("parthenon/mesh", "pack_in_one", true);
   pkg->AddParam<>("pack_in_one", pack_in_one);
@@ -286,8 +497,12 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
         pin->GetOrAddString("hydro", "glmmhd_source", "dedner_plain");
     if (glmmhd_source_str == "dedner_plain") {
       pkg->AddParam<GLMMHD::SourceFun_t>("glmmhd_source", GLMMHD::DednerSource<false>);
+      pkg->AddParam<GLMMHD::FusedUpdateFun_t *>(
+          "glmmhd_fused_update", GLMMHD::UpdateWithFluxDivergenceAndSource<false>);
     } else if (glmmhd_source_str == "dedner_extended") {
       pkg->AddParam<GLMMHD::SourceFun_t>("glmmhd_source", GLMMHD::DednerSource<true>);
+      pkg->AddParam<GLMMHD::FusedUpdateFun_t *>(
+          "glmmhd_fused_update", GLMMHD::UpdateWithFluxDivergenceAndSource<true>);
     } else {
       PARTHENON_FAIL("AthenaPK hydro: Unknown glmmhd_source");
     }
@@ -300,6 +515,13 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   }
   pkg->AddParam<>("fluid", fluid);
   pkg->AddParam<>("nhydro", nhydro);
+  // Dimensionality of the fluxes and timestep, which excludes the direction of the
+  // members in ensemble mode (see utils/ensemble.hpp).
+  const int ndim = utils::ensemble::GetNumDims(pin);
+  pkg->AddParam<>("ndim", ndim);
+  const bool ensemble = utils::ensemble::GetDir(pin) > 0;
+  PARTHENON_REQUIRE_THROWS(!ensemble || fluid == Fluid::euler,
+                           "Ensemble mode currently only supports hydro/fluid=euler.");
   pkg->AddParam<>("calc_c_h", calc_c_h);
   // Following params should (currently) be present independent of solver because
   // they're all used in the main loop.
@@ -340,6 +562,32 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   // Adding recon independently of flux function pointer as it's used in 3D flux func.
   pkg->AddParam<>("reconstruction", recon);
 
+  // Passive scalars may use a cheaper reconstruction than the hydro variables
+  const auto recon_scalars_str =
+      pin->GetOrAddString("hydro", "reconstruction_scalars", recon_str);
+  auto recon_scalars = recon;
+  if (recon_scalars_str == "dc") {
+    recon_scalars = Reconstruction::dc;
+  } else if (recon_scalars_str == "plm" && recon != Reconstruction::dc) {
+    recon_scalars = Reconstruction::plm;
+  } else if (recon_scalars_str != recon_str) {
+    PARTHENON_FAIL("AthenaPK hydro: Passive scalar reconstruction needs to be dc, plm "
+                   "(with higher order hydro reconstruction), or the same as for hydro.");
+  }
+  pkg->AddParam<>("reconstruction_scalars", recon_scalars);
+
+  // Hybrid reconstruction: unlimited high order stencils in smooth pencils
+  const auto hybrid_recon = pin->GetOrAddBoolean("hydro", "hybrid_reconstruction", false);
+  PARTHENON_REQUIRE(!hybrid_recon || recon == Reconstruction::ppm ||
+                        recon == Reconstruction::wenoz,
+                    "Hybrid reconstruction requires ppm or wenoz reconstruction.");
+  pkg->AddParam<>("hybrid_reconstruction", hybrid_recon);
+  if (hybrid_recon) {
+    const auto thr = pin->GetOrAddReal("hydro", "hybrid_reconstruction_threshold", 0.1);
+    PARTHENON_REQUIRE(thr > 0.0, "hydro/hybrid_reconstruction_threshold must be > 0.");
+    pkg->AddParam<>("hybrid_reconstruction_threshold", thr);
+  }
+
   // Use hyperbolic timestep constraint by default
   bool calc_dt_hyp = true;
   const auto riemann_str = pin->GetString("hydro", "riemann");
@@ -367,22 +615,54 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   }
   pkg->AddParam<>("riemann", riemann);
 
+  // The general (tabulated) EOS is only available for the hyperbolic hydro paths with
+  // the Riemann solvers templated on the EOS.
+  const auto eos_str = pin->GetString("hydro", "eos");
+  auto eos_type = EosType::adiabatic;
+  if (eos_str == "tabulated") {
+    eos_type = EosType::tabulated;
+    PARTHENON_REQUIRE_THROWS(fluid == Fluid::euler,
+                             "hydro/eos=tabulated requires hydro/fluid=euler.");
+    PARTHENON_REQUIRE_THROWS(riemann == RiemannSolver::hlle ||
+                                 riemann == RiemannSolver::llf ||
+                                 riemann == RiemannSolver::none,
+                             "hydro/eos=tabulated requires the hlle, llf, or none "
+                             "Riemann solver.");
+  } else if (eos_str != "adiabatic") {
+    PARTHENON_FAIL("AthenaPK hydro: Unknown EOS");
+  }
+  pkg->AddParam<>("eos_type", eos_type);
+
   // Set calculation of hyperbolic timestep. Input file option takes precedence.
   if (pin->DoesParameterExist("hydro", "calc_dt_hyp")) {
     calc_dt_hyp = pin->GetBoolean("hydro", "calc_dt_hyp");
   }
   pkg->AddParam<>("calc_dt_hyp", calc_dt_hyp);
 
+  // Calculate the hyperbolic timestep as by-product of the conversion to primitive
+  // variables in the final stage (instead of a separate pass over the primitives)
+  const auto fused_dt_hyp = pin->GetOrAddBoolean("hydro", "fused_dt_hyp", false);
+  pkg->AddParam<>("fused_dt_hyp", fused_dt_hyp && calc_dt_hyp);
+  // Set by the driver to only do the additional reduction in the final stage
+  pkg->AddParam<bool>("fused_dt_hyp_active", false, Params::Mutability::Mutable);
+  // Minimum hyperbolic timestep (without cfl) for each MeshData from the last
+  // (fused) conversion to primitive variables of the current step (cleared by the
+  // driver at the first stage and after the step, i.e., before any remeshing)
+  pkg->AddParam<std::map<MeshData<Real> *, Real>>(
+      "fused_dt_hyp_cache", std::map<MeshData<Real> *, Real>(),
+      Params::Mutability::Mutable);
+  // Reduce the hyperbolic and all diffusive timestep constraints in a single kernel
+  const auto fused_dt_estimate =
+      pin->GetOrAddBoolean("hydro", "fused_dt_estimate", false);
+  pkg->AddParam<>("fused_dt_estimate", fused_dt_estimate);
+
   // Maximum dt. Useful for debugging.
   const auto max_dt = pin->GetOrAddReal("hydro", "max_dt", -1.0);
   pkg->AddParam<>("max_dt", max_dt);
 
-  // Map contaning all compiled in flux functions
-  std::map<std::tuple<Fluid, Reconstruction, RiemannSolver>, FluxFun_t *>
-      flux_functions{};
-  // TODO(?) The following line could potentially be set by configure-time options
-  // so that the resulting binary can only contain a subset of included flux functions
-  // to reduce size.
+  // Map contaning all compiled in flux functions. Production builds may only contain a
+  // subset of them (see the AthenaPK_FLUX_CONFIGS CMake option and add_flux_fun).
+  std::map<FluxFunKey_t, FluxFun_t *> flux_functions{};
   add_flux_fun<Fluid::euler, Reconstruction::dc, RiemannSolver::hlle>(flux_functions);
   add_flux_fun<Fluid::euler, Reconstruction::dc, RiemannSolver::none>(flux_functions);
   add_flux_fun<Fluid::euler, Reconstruction::plm, RiemannSolver::hlle>(flux_functions);
@@ -410,33 +690,187 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   add_flux_fun<Fluid::glmmhd, Reconstruction::limo3, RiemannSolver::hlld>(flux_functions);
   add_flux_fun<Fluid::glmmhd, Reconstruction::wenoz, RiemannSolver::hlld>(flux_functions);
   // Add first order recon with LLF fluxes (implemented for testing as tight loop)
-  flux_functions[std::make_tuple(Fluid::euler, Reconstruction::dc, RiemannSolver::llf)] =
-      Hydro::CalculateFluxesTight<Fluid::euler>;
-  flux_functions[std::make_tuple(Fluid::glmmhd, Reconstruction::dc, RiemannSolver::llf)] =
-      Hydro::CalculateFluxesTight<Fluid::glmmhd>;
+  add_tight_flux_fun<Fluid::euler>(flux_functions);
+  add_tight_flux_fun<Fluid::glmmhd>(flux_functions);
+  // With the general EOS, the hydro flux functions are replaced by the ones templated on
+  // the tabulated EOS (only for the Riemann solvers supporting it, see check above).
+  if (eos_type == EosType::tabulated) {
+    add_flux_fun<Fluid::euler, Reconstruction::dc, RiemannSolver::hlle,
+                 TabulatedHydroEOS>(flux_functions);
+    add_flux_fun<Fluid::euler, Reconstruction::dc, RiemannSolver::none,
+                 TabulatedHydroEOS>(flux_functions);
+    add_flux_fun<Fluid::euler, Reconstruction::plm, RiemannSolver::hlle,
+                 TabulatedHydroEOS>(flux_functions);
+    add_flux_fun<Fluid::euler, Reconstruction::ppm, RiemannSolver::hlle,
+                 TabulatedHydroEOS>(flux_functions);
+    add_flux_fun<Fluid::euler, Reconstruction::weno3, RiemannSolver::hlle,
+                 TabulatedHydroEOS>(flux_functions);
+    add_flux_fun<Fluid::euler, Reconstruction::limo3, RiemannSolver::hlle,
+                 TabulatedHydroEOS>(flux_functions);
+    add_flux_fun<Fluid::euler, Reconstruction::wenoz, RiemannSolver::hlle,
+                 TabulatedHydroEOS>(flux_functions);
+    add_tight_flux_fun<Fluid::euler, TabulatedHydroEOS>(flux_functions);
+  }
+  auto get_flux_fun = [&flux_functions, &eos_str](const FluxFunKey_t &key) {
+    PARTHENON_REQUIRE_THROWS(flux_functions.count(key) > 0,
+                             "AthenaPK hydro: The combination of hydro/fluid, "
+                             "hydro/reconstruction, hydro/riemann, and hydro/eos = " +
+                                 eos_str +
+                                 " is not compiled in. Reconfigure with the combination "
+                                 "in AthenaPK_FLUX_CONFIGS (or empty for all).");
+    return flux_functions.at(key);
+  };
+  PARTHENON_REQUIRE_THROWS(compiled_ndim == 0 || compiled_ndim == ndim,
+                           "AthenaPK hydro: Binary is specialized for " +
+                               std::to_string(compiled_ndim) +
+                               " dimensions, see the AthenaPK_NDIM CMake option.");
 
   // flux used in all stages expect the first. First stage is set below based on integr.
   FluxFun_t *flux_other_stage = nullptr;
-  flux_other_stage = flux_functions.at(std::make_tuple(fluid, recon, riemann));
+  flux_other_stage = get_flux_fun(std::make_tuple(fluid, recon, riemann, recon_scalars));
+
+  // Asynchronous snapshots of selected variables (independent of the Parthenon outputs)
+  const auto snapshot_dt = pin->GetOrAddReal("snapshot", "dt", -1.0);
+  if (snapshot_dt > 0.0) {
+    std::stringstream vars_ss(pin->GetString("snapshot", "variables"));
+    std::vector<std::string> snapshot_vars;
+    std::string var;
+    while (std::getline(vars_ss, var, ',')) {
+      var.erase(0, var.find_first_not_of(' '));
+      var.erase(var.find_last_not_of(' ') + 1);
+      snapshot_vars.push_back(var);
+    }
+    const auto basename = pin->GetOrAddString("snapshot", "basename", "snapshot");
+    const auto max_in_flight = pin->GetOrAddInteger("snapshot", "max_in_flight", 2);
+    pkg->AddParam<>("snapshot", std::make_shared<utils::AsyncSnapshot>(
+                                    basename, snapshot_dt, snapshot_vars, max_in_flight));
+  }
 
   parthenon::HstVar_list hst_vars = {};
-  hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                         HydroHst<Hst::idx, IDN>, "mass"));
-  hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                         HydroHst<Hst::idx, IM1>, "1-mom"));
-  hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                         HydroHst<Hst::idx, IM2>, "2-mom"));
-  hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                         HydroHst<Hst::idx, IM3>, "3-mom"));
-  hst_vars.emplace_back(
-      HistoryOutputVar(parthenon::UserHistoryOperation::sum, HydroHst<Hst::ekin>, "KE"));
-  hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                         HydroHst<Hst::idx, IEN>, "tot-E"));
-  if (fluid == Fluid::glmmhd) {
+  // Calculate all default history outputs in a single reduction per partition
+  const auto fused_hst = pin->GetOrAddBoolean("hydro", "fused_hst", false);
+  pkg->AddParam<>("fused_hst", fused_hst);
+  if (fused_hst) {
+    std::vector<std::string> names = {"mass", "1-mom", "2-mom", "3-mom", "KE", "tot-E"};
+    if (fluid == Fluid::glmmhd) {
+      names.emplace_back("ME");
+      names.emplace_back("relDivB");
+      utils::history::FusedSums::AddHistoryVars(hst_vars, names,
+                                                FusedHydroHst<Fluid::glmmhd>);
+    } else {
+      utils::history::FusedSums::AddHistoryVars(hst_vars, names,
+                                                FusedHydroHst<Fluid::euler>);
+    }
+  } else {
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           HydroHst<Hst::idx, IDN>, "mass"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           HydroHst<Hst::idx, IM1>, "1-mom"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           HydroHst<Hst::idx, IM2>, "2-mom"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           HydroHst<Hst::idx, IM3>, "3-mom"));
     hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                           HydroHst<Hst::emag>, "ME"));
+                                           HydroHst<Hst::ekin>, "KE"));
     hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                           HydroHst<Hst::divb>, "relDivB"));
+                                           HydroHst<Hst::idx, IEN>, "tot-E"));
+    if (fluid == Fluid::glmmhd) {
+      hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                             HydroHst<Hst::emag>, "ME"));
+      hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                             HydroHst<Hst::divb>, "relDivB"));
+    }
+  }
+  // Cumulative number of blocks created and destroyed by the mesh refinement (the same on
+  // all partitions and ranks) to monitor the remeshing activity
+  if (pin->GetOrAddBoolean("refinement", "hst_remesh_counts", false)) {
+    hst_vars.emplace_back(HistoryOutputVar(
+        parthenon::UserHistoryOperation::max,
+        [](MeshData<Real> *md) {
+          auto pmesh = md->GetBlockData(0)->GetBlockPointer()->pmy_mesh;
+          return static_cast<Real>(pmesh->nbnew);
+        },
+        "blocks_created"));
+    hst_vars.emplace_back(HistoryOutputVar(
+        parthenon::UserHistoryOperation::max,
+        [](MeshData<Real> *md) {
+          auto pmesh = md->GetBlockData(0)->GetBlockPointer()->pmy_mesh;
+          return static_cast<Real>(pmesh->nbdel);
+        },
+        "blocks_destroyed"));
+  }
+  // Minimum, maximum, and mean (across ranks) step time and throughput of the ranks
+  // since the previous history output and the slowest rank to monitor load imbalances
+  const auto hst_rank_metrics = pin->GetOrAddBoolean("hydro", "hst_rank_metrics", false);
+  pkg->AddParam<>("hst_rank_metrics", hst_rank_metrics);
+  if (hst_rank_metrics) {
+    pkg->AddParam<>("rank_metrics", utils::RankMetrics(), Params::Mutability::Mutable);
+    using parthenon::UserHistoryOperation;
+    using Interval = utils::RankMetrics::Interval;
+    // Columns with the minimum, maximum, and mean of the value of each rank
+    auto add_rank_metric = [&hst_vars](const std::string &name,
+                                       Real (*value)(const Interval &)) {
+      for (const auto op : {UserHistoryOperation::min, UserHistoryOperation::max,
+                            UserHistoryOperation::sum}) {
+        const bool mean = op == UserHistoryOperation::sum;
+        hst_vars.emplace_back(HistoryOutputVar(
+            op,
+            [value, mean](MeshData<Real> *md) {
+              auto pmesh = md->GetBlockData(0)->GetBlockPointer()->pmy_mesh;
+              auto hydro_pkg = pmesh->packages.Get("Hydro");
+              const auto &metrics =
+                  hydro_pkg->MutableParam<utils::RankMetrics>("rank_metrics")->Get();
+              // Called for each partition of each rank
+              return mean ? value(metrics) / (parthenon::Globals::nranks *
+                                              pmesh->DefaultNumPartitions())
+                          : value(metrics);
+            },
+            "rank_" + name +
+                (op == UserHistoryOperation::min   ? "_min"
+                 : op == UserHistoryOperation::max ? "_max"
+                                                   : "_mean")));
+      }
+    };
+    add_rank_metric("step_time", [](const Interval &m) { return m.step_time; });
+    add_rank_metric("zcs", [](const Interval &m) { return m.zcs; });
+    hst_vars.emplace_back(HistoryOutputVar(
+        parthenon::UserHistoryOperation::max,
+        [](MeshData<Real> *md) {
+          auto pmesh = md->GetBlockData(0)->GetBlockPointer()->pmy_mesh;
+          auto hydro_pkg = pmesh->packages.Get("Hydro");
+          return static_cast<Real>(
+              hydro_pkg->MutableParam<utils::RankMetrics>("rank_metrics")
+                  ->Get()
+                  .slowest_rank);
+        },
+        "rank_slowest"));
+  }
+
+  // Failed cells (negative densities or pressures without floors or cooling exceeding
+  // cooling/max_iter) are counted instead of aborting and the step is retried from the
+  // state at the beginning of the step with a reduced timestep, see HydroDriver::Step
+  const auto step_retry = pin->GetOrAddBoolean("hydro", "step_retry", false);
+  pkg->AddParam<>("step_retry", step_retry);
+  if (step_retry) {
+    const auto max_attempts = pin->GetOrAddInteger("hydro", "step_retry_max_attempts", 3);
+    PARTHENON_REQUIRE_THROWS(max_attempts > 0,
+                             "hydro/step_retry_max_attempts must be positive.");
+    pkg->AddParam<>("step_retry_max_attempts", max_attempts);
+    const auto dt_factor = pin->GetOrAddReal("hydro", "step_retry_dt_factor", 0.5);
+    PARTHENON_REQUIRE_THROWS(dt_factor > 0.0 && dt_factor < 1.0,
+                             "hydro/step_retry_dt_factor must be in (0, 1).");
+    pkg->AddParam<>("step_retry_dt_factor", dt_factor);
+    pkg->AddParam<>("step_retry_failures", utils::FailureCounter("step_retry_failures"));
+    // Total number of retried steps (identical on all ranks)
+    pkg->AddParam<>("step_retries", 0, Params::Mutability::Mutable);
+    hst_vars.emplace_back(HistoryOutputVar(
+        parthenon::UserHistoryOperation::max,
+        [](MeshData<Real> *md) {
+          auto pmesh = md->GetBlockData(0)->GetBlockPointer()->pmy_mesh;
+          auto hydro_pkg = pmesh->packages.Get("Hydro");
+          return static_cast<Real>(hydro_pkg->Param<int>("step_retries"));
+        },
+        "step_retries"));
   }
   pkg->AddParam<>(parthenon::hist_param_key, hst_vars, true);
 
@@ -459,10 +893,35 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   } else if (integrator_str == "vl2") {
     integrator = Integrator::vl2;
     // override first stage (predictor) to first order
-    flux_first_stage =
-        flux_functions.at(std::make_tuple(fluid, Reconstruction::dc, riemann));
+    flux_first_stage = get_flux_fun(
+        std::make_tuple(fluid, Reconstruction::dc, riemann, Reconstruction::dc));
+  }
+  // Many-stage SSP integrators share the registers and update form of rk3 (see
+  // HydroDriver::HydroDriver)
+  const auto ssp_integrator_str = pin->GetOrAddString("hydro", "ssp_integrator", "none");
+  if (ssp_integrator_str != "none") {
+    PARTHENON_REQUIRE_THROWS(
+        integrator == Integrator::rk3,
+        "hydro/ssp_integrator requires parthenon/time/integrator = rk3");
+    if (ssp_integrator_str == "ssprk43") {
+      integrator = Integrator::ssprk43;
+    } else if (ssp_integrator_str == "ssprk104") {
+      integrator = Integrator::ssprk104;
+    } else {
+      PARTHENON_FAIL("AthenaPK hydro: Unknown ssp_integrator. Options are: none, "
+                     "ssprk43, ssprk104");
+    }
   }
   pkg->AddParam<>("integrator", integrator);
+  // The cfl limits the (forward Euler) steps of all stages so that the hyperbolic
+  // timestep scales with the SSP coefficient of the integrator (1 for all others).
+  Real ssp_coeff = 1.0;
+  if (integrator == Integrator::ssprk43) {
+    ssp_coeff = 2.0;
+  } else if (integrator == Integrator::ssprk104) {
+    ssp_coeff = 6.0;
+  }
+  pkg->AddParam<>("cfl", ssp_coeff * cfl);
   pkg->AddParam<FluxFun_t *>("flux_first_stage", flux_first_stage);
   pkg->AddParam<FluxFun_t *>("flux_other_stage", flux_other_stage);
 
@@ -470,21 +929,72 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
       pin->GetOrAddBoolean("hydro", "first_order_flux_correct", false);
   pkg->AddParam<>("first_order_flux_correct", first_order_flux_correct);
   if (first_order_flux_correct) {
-    if (fluid == Fluid::euler) {
-      pkg->AddParam<FirstOrderFluxCorrectFun_t *>("first_order_flux_correct_fun",
-                                                  FirstOrderFluxCorrect<Fluid::euler>);
-    } else if (fluid == Fluid::glmmhd) {
-      pkg->AddParam<FirstOrderFluxCorrectFun_t *>("first_order_flux_correct_fun",
-                                                  FirstOrderFluxCorrect<Fluid::glmmhd>);
-    }
+    // specialized on the number of dimensions
+    auto first_order_flux_correct_fun =
+        DispatchNDim(ndim, [&](auto dim) -> FirstOrderFluxCorrectFun_t * {
+          constexpr int NDIM = decltype(dim)::value;
+          if (eos_type == EosType::tabulated) {
+            return FirstOrderFluxCorrect<Fluid::euler, TabulatedHydroEOS, NDIM>;
+          } else if (fluid == Fluid::euler) {
+            return FirstOrderFluxCorrect<Fluid::euler, FluidEOS<Fluid::euler>, NDIM>;
+          }
+          return FirstOrderFluxCorrect<Fluid::glmmhd, FluidEOS<Fluid::glmmhd>, NDIM>;
+        });
+    pkg->AddParam<FirstOrderFluxCorrectFun_t *>("first_order_flux_correct_fun",
+                                                first_order_flux_correct_fun);
+  }
+
+  // Fuse the flux divergence update into the flux kernels (saving one pass over fluxes
+  // and conserved variables). Only valid for meshes without coarse/fine flux
+  // correction (checked in the driver), which also applies to first order flux
+  // correction (that needs to correct fluxes before they're used in the update).
+  auto fused_update = pin->GetOrAddBoolean("hydro", "fused_update", false);
+  if (fused_update) {
+    PARTHENON_REQUIRE_THROWS(!first_order_flux_correct,
+                             "hydro/fused_update is incompatible with "
+                             "hydro/first_order_flux_correct.");
+    PARTHENON_REQUIRE_THROWS(riemann != RiemannSolver::llf,
+                             "hydro/fused_update is not supported for the LLF solver.");
   }
+  pkg->AddParam<>("fused_update", fused_update);
+
+  // Apply the Dedner source (and damping of psi) of GLM MHD directly in the flux
+  // divergence update kernel rather than in a separate pass in AddUnsplitSources.
+  const auto glmmhd_fused_source =
+      pin->GetOrAddBoolean("hydro", "glmmhd_fused_source", false);
+  if (glmmhd_fused_source) {
+    PARTHENON_REQUIRE_THROWS(fluid == Fluid::glmmhd,
+                             "hydro/glmmhd_fused_source requires hydro/fluid=glmmhd.");
+    PARTHENON_REQUIRE_THROWS(!fused_update, "hydro/glmmhd_fused_source is incompatible "
+                                            "with hydro/fused_update.");
+  }
+  pkg->AddParam<>("glmmhd_fused_source", glmmhd_fused_source);
+
+  // Exchange ghost cells of intermediate stages at the beginning of the following stage
+  // (rather than at the end of the stage) and calculate the fluxes that do not depend on
+  // ghost cells while the exchange is in flight.
+  auto overlap_ghost_exchange =
+      pin->GetOrAddBoolean("hydro", "overlap_ghost_exchange", false);
+  PARTHENON_REQUIRE_THROWS(!(fused_update && overlap_ghost_exchange),
+                           "hydro/fused_update is incompatible with "
+                           "hydro/overlap_ghost_exchange.");
+  pkg->AddParam<>("overlap_ghost_exchange", overlap_ghost_exchange);
+
+  // Complete the global reductions at the beginning of a cycle (e.g., of the AGN
+  // triggering) within the main task region so that they overlap with the flux
+  // calculation of the first stage.
+  auto overlap_global_reductions =
+      pin->GetOrAddBoolean("hydro", "overlap_global_reductions", false);
+  pkg->AddParam<>("overlap_global_reductions", overlap_global_reductions);
 
   if (pin->DoesBlockExist("units")) {
     Units units(pin, pkg);
   }
 
-  auto eos_str = pin->GetString("hydro", "eos");
-  if (eos_str == "adiabatic") {
+  // The adiabatic index is also required for the general EOS as reference value for
+  // modules assuming an ideal gas (e.g., floors based on temperature, cooling, or
+  // diffusion).
+  {
     Real gamma = pin->GetReal("hydro", "gamma");
     pkg->AddParam<>("AdiabaticIndex", gamma);
 
@@ -536,6 +1046,9 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
       eceil = Tceil / mbar_over_kb / (gamma - 1.0);
     }
 
+    // Precalculate varying diffusivities once per cell (in FillDerived) instead of
+    // evaluating them for each face and in the timestep estimate.
+    auto diffusion_coeff_field = false;
     auto conduction = Conduction::none;
     auto conduction_str = pin->GetOrAddString("diffusion", "conduction", "none");
     if (conduction_str == "isotropic") {
@@ -610,8 +1123,15 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
       PARTHENON_REQUIRE(conduction_sat_prefac != 0.0,
                         "Saturated thermal conduction prefactor uninitialized.");
       pkg->AddParam<>("conduction_sat_prefac", conduction_sat_prefac);
+
+      if (pin->GetOrAddBoolean("diffusion", "coeff_field", false) &&
+          conduction_coeff != ConductionCoeff::fixed) {
+        diffusion_coeff_field = true;
+        pkg->AddField("thermal_diff", Metadata({Metadata::Cell, Metadata::Derived}));
+      }
     }
     pkg->AddParam<>("conduction", conduction);
+    pkg->AddParam<>("diffusion_coeff_field", diffusion_coeff_field);
 
     auto viscosity = Viscosity::none;
     auto viscosity_str = pin->GetOrAddString("diffusion", "viscosity", "none");
@@ -683,37 +1203,129 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
     auto diffint = DiffInt::none;
     if (diffint_str == "unsplit") {
       diffint = DiffInt::unsplit;
-    } else if (diffint_str == "rkl2") {
-      diffint = DiffInt::rkl2;
-      auto rkl2_dt_ratio = pin->GetOrAddReal("diffusion", "rkl2_max_dt_ratio", -1.0);
-      pkg->AddParam<>("rkl2_max_dt_ratio", rkl2_dt_ratio);
+    } else if (diffint_str == "rkl2" || diffint_str == "rkl1") {
+      diffint = diffint_str == "rkl2" ? DiffInt::rkl2 : DiffInt::rkl1;
+      auto sts_dt_ratio =
+          pin->GetOrAddReal("diffusion", diffint_str + "_max_dt_ratio", -1.0);
+      pkg->AddParam<>("sts_max_dt_ratio", sts_dt_ratio);
+      const auto sts_overlap_comm =
+          pin->GetOrAddBoolean("diffusion", "sts_overlap_comm", false);
+      pkg->AddParam<>("sts_overlap_comm", sts_overlap_comm);
+      // Per block number of stages (instead of the global one) so that blocks with a
+      // large diffusive timestep are skipped in later stages.
+      const auto sts_local_stages =
+          pin->GetOrAddBoolean("diffusion", "sts_local_stages", false);
+      // Blocks that completed their stages don't update their (coarse-fine) fluxes.
+      PARTHENON_REQUIRE_THROWS(
+          !sts_local_stages ||
+              pin->GetOrAddString("parthenon/mesh", "refinement", "none") == "none",
+          "diffusion/sts_local_stages does not support mesh refinement yet.");
+      pkg->AddParam<>("sts_local_stages", sts_local_stages);
+      // Stages of each block for each MeshData (set at the beginning of each STS step)
+      pkg->AddParam<std::map<MeshData<Real> *, parthenon::ParArray1D<int>>>(
+          "sts_block_stages", std::map<MeshData<Real> *, parthenon::ParArray1D<int>>(),
+          Params::Mutability::Mutable);
+      if (sts_local_stages) {
+        // Stage weighted diffusive fluxes of the hydro variables through the faces of the
+        // block boundary (stored in the adjacent cells, i.e., blocks need at least two
+        // cells in each direction) so that the faces between blocks with different
+        // numbers of stages are corrected at the end of the super timestep. The
+        // accumulated fluxes of each direction (and the number of stages of the block as
+        // last component) are exchanged with the neighbors, the previous accumulated flux
+        // and the flux of the initial state (of each direction) are block local.
+        for (int d = 1; d <= ndim; d++) {
+          const auto nx = pin->GetInteger("parthenon/mesh", "nx" + std::to_string(d));
+          PARTHENON_REQUIRE_THROWS(
+              pin->GetOrAddInteger("parthenon/meshblock", "nx" + std::to_string(d), nx) >=
+                  2,
+              "diffusion/sts_local_stages requires at least two cells per block in each "
+              "direction.");
+        }
+        pkg->AddField("sts_face_flux",
+                      Metadata({Metadata::Cell, Metadata::OneCopy, Metadata::FillGhost},
+                               std::vector<int>({ndim * nhydro + 1})));
+        pkg->AddField("sts_face_flux_hist",
+                      Metadata({Metadata::Cell, Metadata::OneCopy},
+                               std::vector<int>({2 * ndim * nhydro})));
+      }
+    } else if (diffint_str == "implicit") {
+      diffint = DiffInt::implicit;
+      PARTHENON_REQUIRE_THROWS(
+          conduction == Conduction::isotropic && viscosity == Viscosity::none &&
+              resistivity == Resistivity::none,
+          "The implicit diffusion integrator only supports isotropic thermal "
+          "conduction (without viscosity and resistivity).");
+      PARTHENON_REQUIRE_THROWS(
+          pin->GetOrAddString("parthenon/mesh", "refinement", "none") == "none",
+          "The implicit diffusion integrator does not support mesh refinement yet.");
+      // Relative reduction of the residual norm and maximum number of CG iterations
+      const auto implicit_tol = pin->GetOrAddReal("diffusion", "implicit_tol", 1e-8);
+      const auto implicit_max_iter =
+          pin->GetOrAddInteger("diffusion", "implicit_max_iter", 1000);
+      PARTHENON_REQUIRE_THROWS(implicit_tol > 0.0 && implicit_max_iter > 0,
+                               "diffusion/implicit_tol and diffusion/implicit_max_iter "
+                               "must be positive.");
+      pkg->AddParam<>("implicit_tol", implicit_tol);
+      pkg->AddParam<>("implicit_max_iter", implicit_max_iter);
+      // Print the number of iterations and the final residual of every solve
+      pkg->AddParam<>("implicit_verbose",
+                      pin->GetOrAddBoolean("diffusion", "implicit_verbose", false));
+      // Search direction (requires ghost cells) and the remaining work arrays, i.e.,
+      // solution, residual, operator applied to the search direction, diagonal of the
+      // operator, and thermal diffusivity.
+      pkg->AddField("implicit_cond_p", Metadata({Metadata::Cell, Metadata::OneCopy,
+                                                 Metadata::FillGhost}));
+      pkg->AddField("implicit_cond",
+                    Metadata({Metadata::Cell, Metadata::OneCopy}, std::vector<int>({5})));
     } else if (diffint_str != "none") {
       PARTHENON_FAIL("AthenaPK unknown integration method for diffusion processes. "
-                     "Options are: none, unsplit, rkl2");
+                     "Options are: none, unsplit, rkl2, rkl1, implicit");
     }
     if (diffint != DiffInt::none) {
       // As in Athena++ a cfl safety factor is also applied to the theoretical limit.
-      // By default it is equal to the hyperbolic cfl.
-      auto cfl_diff = pin->GetOrAddReal("diffusion", "cfl", pkg->Param<Real>("cfl"));
+      // By default it is equal to the hyperbolic cfl (without SSP coefficient).
+      auto cfl_diff = pin->GetOrAddReal("diffusion", "cfl", cfl);
       pkg->AddParam<>("cfl_diff", cfl_diff);
     }
+    // Calculate the face-centered primitive variables once for all diffusive processes
+    const auto diffusion_face_cache =
+        pin->GetOrAddBoolean("diffusion", "face_cache", false);
+    pkg->AddParam<>("diffusion_face_cache", diffusion_face_cache);
+    // Calculate the fluxes of all diffusive processes in a single kernel per direction
+    const auto diffusion_fused_fluxes =
+        pin->GetOrAddBoolean("diffusion", "fused_fluxes", false);
+    pkg->AddParam<>("diffusion_fused_fluxes", diffusion_fused_fluxes);
     pkg->AddParam<Real>("dt_diff", std::numeric_limits<Real>::max(),
                         Params::Mutability::Mutable); // diffusive timestep constraint
     pkg->AddParam<>("diffint", diffint);
-
-    if (fluid == Fluid::euler) {
+    PARTHENON_REQUIRE_THROWS(!ensemble || diffint == DiffInt::none,
+                             "Ensemble mode does not support diffusion.");
+    PARTHENON_REQUIRE_THROWS(!(fused_update && diffint == DiffInt::unsplit),
+                             "hydro/fused_update is incompatible with unsplit diffusion "
+                             "as diffusive fluxes are added after the hyperbolic ones.");
+
+    const auto step_retry_failures =
+        step_retry ? pkg->Param<utils::FailureCounter>("step_retry_failures")
+                   : utils::FailureCounter();
+    if (eos_type == EosType::tabulated) {
+      TabulatedHydroEOS eos(pin, pfloor, dfloor, efloor, vceil, eceil);
+      eos.SetFailureCounter(step_retry_failures);
+      pkg->AddParam<>("eos", eos);
+      pkg->FillDerivedMesh = ConsToPrim<TabulatedHydroEOS>;
+      pkg->EstimateTimestepMesh = EstimateTimestep<Fluid::euler, TabulatedHydroEOS>;
+    } else if (fluid == Fluid::euler) {
       AdiabaticHydroEOS eos(pfloor, dfloor, efloor, vceil, eceil, gamma);
+      eos.SetFailureCounter(step_retry_failures);
       pkg->AddParam<>("eos", eos);
       pkg->FillDerivedMesh = ConsToPrim<AdiabaticHydroEOS>;
       pkg->EstimateTimestepMesh = EstimateTimestep<Fluid::euler>;
     } else if (fluid == Fluid::glmmhd) {
       AdiabaticGLMMHDEOS eos(pfloor, dfloor, efloor, vceil, eceil, gamma);
+      eos.SetFailureCounter(step_retry_failures);
       pkg->AddParam<>("eos", eos);
       pkg->FillDerivedMesh = ConsToPrim<AdiabaticGLMMHDEOS>;
       pkg->EstimateTimestepMesh = EstimateTimestep<Fluid::glmmhd>;
     }
-  } else {
-    PARTHENON_FAIL("AthenaPK hydro: Unknown EOS");
   }
 
   /************************************************************
@@ -735,10 +1347,119 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   if (cooling == Cooling::tabular) {
     TabularCooling tabular_cooling(pin, pkg);
     pkg->AddParam<>("tabular_cooling", tabular_cooling);
+    // Buffers of the work queue (see cooling/work_queue_subcycles) of each MeshData
+    pkg->AddParam<>("cooling_work_queues", cooling::CoolingWorkQueues(),
+                    Params::Mutability::Mutable);
   }
 
   auto scratch_level = pin->GetOrAddInteger("hydro", "scratch_level", 0);
-  pkg->AddParam("scratch_level", scratch_level);
+  pkg->AddParam("scratch_level", scratch_level, Params::Mutability::Mutable);
+
+  // Number of faces in the sweep direction handled by a single team in the x2 and x3
+  // flux kernels. The default (all faces) corresponds to one team per pencil plane.
+  auto flux_tile_sweep = pin->GetOrAddInteger("hydro", "flux_tile_sweep", -1);
+  PARTHENON_REQUIRE_THROWS(!(fused_update && flux_tile_sweep > 0),
+                           "hydro/fused_update requires the flux tiles to cover all "
+                           "faces in the sweep direction (hydro/flux_tile_sweep <= 0).");
+  // Launch parameters are mutable so that they can be changed by the autotuner.
+  pkg->AddParam("flux_tile_sweep", flux_tile_sweep, Params::Mutability::Mutable);
+  // Number of pencils in the transverse direction (k for x2 and j for x3) processed by a
+  // single team so that the reconstruction, Riemann solver, and barriers of a step in
+  // the sweep direction are shared by the pencils of the tile.
+  auto flux_tile_transverse = pin->GetOrAddInteger("hydro", "flux_tile_transverse", 1);
+  PARTHENON_REQUIRE_THROWS(flux_tile_transverse >= 1 &&
+                               flux_tile_transverse <= max_flux_tile_transverse,
+                           "hydro/flux_tile_transverse must be in [1, " +
+                               std::to_string(max_flux_tile_transverse) + "].");
+  pkg->AddParam("flux_tile_transverse", flux_tile_transverse,
+                Params::Mutability::Mutable);
+
+  // Time the reconstruction and Riemann solver kernels separately at startup
+  const auto kernel_benchmark = pin->GetOrAddBoolean("hydro", "kernel_benchmark", false);
+  pkg->AddParam("kernel_benchmark", kernel_benchmark);
+  const auto kernel_benchmark_num_repeat =
+      pin->GetOrAddInteger("hydro", "kernel_benchmark_num_repeat", 10);
+  PARTHENON_REQUIRE_THROWS(kernel_benchmark_num_repeat > 0,
+                           "hydro/kernel_benchmark_num_repeat must be positive.");
+  pkg->AddParam("kernel_benchmark_num_repeat", kernel_benchmark_num_repeat);
+
+  // Time flux kernels with different launch parameters at startup and pick the fastest
+  const auto autotune = pin->GetOrAddBoolean("hydro", "autotune", false);
+  pkg->AddParam("autotune", autotune);
+  const auto autotune_num_repeat =
+      pin->GetOrAddInteger("hydro", "autotune_num_repeat", 5);
+  PARTHENON_REQUIRE_THROWS(autotune_num_repeat > 0,
+                           "hydro/autotune_num_repeat must be positive.");
+  pkg->AddParam("autotune_num_repeat", autotune_num_repeat);
+  // Empty string disables reading/writing tuned parameters from/to a file.
+  const auto autotune_cache_file =
+      pin->GetOrAddString("hydro", "autotune_cache_file", "athenapk_autotune.txt");
+  pkg->AddParam("autotune_cache_file", autotune_cache_file);
+
+  // Batched global reductions of scalars from different modules (e.g., the problem
+  // generator), see utils/global_reductions.hpp
+  auto global_reductions = utils::GlobalReductions();
+
+  // Start the global reduction of dt_hyp and dt_diff (for c_h and STS) at the end of a
+  // cycle and only wait for its completion at the beginning of the next cycle (in
+  // PreStepMeshUserWorkInLoop) rather than doing a blocking reduction there.
+  const auto async_dt_reduction =
+      pin->GetOrAddBoolean("hydro", "async_dt_reduction", false);
+  PARTHENON_REQUIRE_THROWS(
+      !(async_dt_reduction &&
+        pin->GetOrAddString("parthenon/mesh", "refinement", "none") == "adaptive"),
+      "hydro/async_dt_reduction is not supported with adaptive mesh refinement.");
+  pkg->AddParam("async_dt_reduction", async_dt_reduction);
+  if (async_dt_reduction) {
+    global_reductions.Register("timestep", "dt_hyp", utils::ReductionOp::min);
+    global_reductions.Register("timestep", "dt_diff", utils::ReductionOp::min);
+  }
+  pkg->AddParam("global_reductions", global_reductions, Params::Mutability::Mutable);
+
+  // Load balancing based on the measured cost per block (rather than the number of
+  // blocks). Currently, the (tabular cooling) subcycles per cell are counted with
+  // the given weight relative to the cost of the hydro update of a cell.
+  const auto lb_cooling_cost_weight =
+      pin->GetOrAddReal("hydro", "lb_cooling_cost_weight", 0.0);
+  PARTHENON_REQUIRE_THROWS(lb_cooling_cost_weight >= 0.0,
+                           "hydro/lb_cooling_cost_weight must be non-negative.");
+  PARTHENON_REQUIRE_THROWS(
+      lb_cooling_cost_weight == 0.0 ||
+          pin->GetOrAddString("parthenon/loadbalancing", "balancer", "default") ==
+              "manual",
+      "hydro/lb_cooling_cost_weight requires parthenon/loadbalancing/balancer=manual.");
+  pkg->AddParam("lb_cooling_cost_weight", lb_cooling_cost_weight);
+  // Accumulated number of cooling subcycles per block (gid) since the last update of the
+  // load balancing costs
+  pkg->AddParam("lb_cooling_substeps", std::map<int, Real>(),
+                Params::Mutability::Mutable);
+  // Minimum cooling time per block (gid) recorded during the last cooling update, see
+  // cooling/dt_from_srcterm
+  pkg->AddParam("cooling_min_time", std::map<int, Real>(), Params::Mutability::Mutable);
+
+  // Timing of the driver tasks, see TaskTimers
+  const auto task_timers = pin->GetOrAddBoolean("hydro", "task_timers", false);
+  pkg->AddParam("task_timers", task_timers);
+  const auto task_timers_ncycles =
+      pin->GetOrAddInteger("hydro", "task_timers_ncycles", 10);
+  PARTHENON_REQUIRE_THROWS(task_timers_ncycles > 0,
+                           "hydro/task_timers_ncycles must be positive.");
+  pkg->AddParam("task_timers_ncycles", task_timers_ncycles);
+  const auto task_timers_file =
+      pin->GetOrAddString("hydro", "task_timers_file", "athenapk_task_timers.csv");
+  pkg->AddParam("task_timers_file", task_timers_file);
+  // Achieved bandwidth and FLOP rate of the tasks based on a static model of each task
+  const auto roofline = pin->GetOrAddBoolean("hydro", "roofline", false);
+  pkg->AddParam("roofline", roofline);
+  // Memory footprint per package and register at startup and after each remeshing
+  const auto memory_report = pin->GetOrAddBoolean("hydro", "memory_report", false);
+  pkg->AddParam("memory_report", memory_report);
+
+  // Kokkos Tools profiling regions, see utils/profiling.hpp
+  const auto profiling_regions =
+      pin->GetOrAddBoolean("hydro", "profiling_regions", false);
+  utils::profiling::RegionsEnabled() = profiling_regions;
+  pkg->AddParam("profiling_regions", profiling_regions);
 
   auto nscalars = pin->GetOrAddInteger("hydro", "nscalars", 0);
   pkg->AddParam("nscalars", nscalars);
@@ -769,179 +1490,525 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
     prim_labels[IB3] = "magnetic_field_3";
     prim_labels[IPS] = "magnetic_psi";
   }
-  for (auto i = 0; i < nscalars; i++) {
+
+  // With sparse scalars, each passive scalar is a separate sparse variable that is only
+  // allocated on blocks where it is (or was recently) above the threshold. The scalars
+  // then follow the hydro variables in packs of the "cons_names" ("prim_names")
+  // variables so that scalar n is still at index nhydro + n in the packs (but may be
+  // unallocated on some blocks, see VariablePack::IsAllocated).
+  const auto sparse_scalars = pin->GetOrAddBoolean("hydro", "sparse_scalars", false);
+  pkg->AddParam("sparse_scalars", sparse_scalars);
+  PARTHENON_REQUIRE_THROWS(!sparse_scalars || nscalars > 0,
+                           "hydro/sparse_scalars requires hydro/nscalars > 0");
+  PARTHENON_REQUIRE_THROWS(!sparse_scalars || !ensemble,
+                           "Sparse passive scalars are not supported in ensemble mode");
+  // The saved state of a step only covers the variables allocated at its beginning
+  PARTHENON_REQUIRE_THROWS(!sparse_scalars || !step_retry,
+                           "hydro/sparse_scalars is incompatible with hydro/step_retry");
+  const int ndense_scalars = sparse_scalars ? 0 : nscalars;
+  for (auto i = 0; i < ndense_scalars; i++) {
     cons_labels.emplace_back("scalar_density_" + std::to_string(i));
     prim_labels.emplace_back("scalar_" + std::to_string(i));
   }
+  std::vector<std::string> cons_names = {"cons"};
+  std::vector<std::string> prim_names = {"prim"};
 
   Metadata m(
       {Metadata::Cell, Metadata::Independent, Metadata::FillGhost, Metadata::WithFluxes},
-      std::vector<int>({nhydro + nscalars}), cons_labels);
+      std::vector<int>({nhydro + ndense_scalars}), cons_labels);
   m.RegisterRefinementOps<refinement_ops::ProlongateCellMinModMultiD,
                           parthenon::refinement_ops::RestrictAverage>();
   pkg->AddField("cons", m);
 
-  m = Metadata({Metadata::Cell, Metadata::Derived}, std::vector<int>({nhydro + nscalars}),
-               prim_labels);
+  m = Metadata({Metadata::Cell, Metadata::Derived},
+               std::vector<int>({nhydro + ndense_scalars}), prim_labels);
   pkg->AddField("prim", m);
 
+  if (sparse_scalars) {
+    // Thresholds apply to the (absolute) conserved scalar densities. The lower
+    // deallocation threshold avoids blocks at the edge of a region flipping back and
+    // forth (deallocation also requires parthenon/sparse/dealloc_count cycles below it).
+    const auto threshold =
+        pin->GetOrAddReal("hydro", "sparse_scalars_threshold", 1.0e-12);
+    PARTHENON_REQUIRE_THROWS(threshold > 0.0,
+                             "hydro/sparse_scalars_threshold must be positive");
+    std::vector<int> sparse_ids(nscalars);
+    for (auto i = 0; i < nscalars; i++) {
+      sparse_ids[i] = i;
+    }
+    m = Metadata({Metadata::Cell, Metadata::Independent, Metadata::FillGhost,
+                  Metadata::WithFluxes, Metadata::Sparse});
+    m.SetSparseThresholds(threshold, 1.0e-2 * threshold, 0.0);
+    m.RegisterRefinementOps<refinement_ops::ProlongateCellMinModMultiD,
+                            parthenon::refinement_ops::RestrictAverage>();
+    pkg->AddSparsePool("scalar_density", m, sparse_ids);
+    // The primitive scalars are allocated together with the conserved ones
+    m = Metadata({Metadata::Cell, Metadata::Derived, Metadata::Sparse});
+    pkg->AddSparsePool("scalar", m, "scalar_density", sparse_ids);
+    cons_names.emplace_back("scalar_density");
+    prim_names.emplace_back("scalar");
+  }
+  pkg->AddParam("cons_names", cons_names);
+  pkg->AddParam("prim_names", prim_names);
+
+  if (hybrid_recon) {
+    // Troubled cell indicator (1 or 0) calculated with the primitive variables
+    pkg->AddField("troubled", Metadata({Metadata::Cell, Metadata::Derived,
+                                        Metadata::OneCopy}));
+  }
+
+  // Reads the parameters of a built-in refinement criterion and returns its tagging
+  // function (or nullptr for unknown criteria)
+  auto add_refinement_criterion =
+      [&](const std::string &criterion) -> refinement::CheckRefinementMeshFun_t {
+    if (criterion == "pressure_gradient") {
+      const auto thr =
+          pin->GetOrAddReal("refinement", "threshold_pressure_gradient", 0.0);
+      PARTHENON_REQUIRE(thr > 0.,
+                        "Make sure to set refinement/threshold_pressure_gradient >0.");
+      const auto deref_thr = pin->GetOrAddReal(
+          "refinement", "derefine_threshold_pressure_gradient", 0.25 * thr);
+      PARTHENON_REQUIRE(deref_thr < thr,
+                        "Make sure to set "
+                        "refinement/derefine_threshold_pressure_gradient < "
+                        "refinement/threshold_pressure_gradient.");
+      pkg->AddParam<Real>("refinement/threshold_pressure_gradient", thr);
+      pkg->AddParam<Real>("refinement/derefine_threshold_pressure_gradient", deref_thr);
+      return refinement::gradient::PressureGradient;
+    } else if (criterion == "xyvelocity_gradient") {
+      const auto thr =
+          pin->GetOrAddReal("refinement", "threshold_xyvelocity_gradient", 0.0);
+      PARTHENON_REQUIRE(thr > 0.,
+                        "Make sure to set refinement/threshold_xyvelocity_gradient >0.");
+      const auto deref_thr = pin->GetOrAddReal(
+          "refinement", "derefine_threshold_xyvelocity_gradient", 0.5 * thr);
+      PARTHENON_REQUIRE(deref_thr < thr,
+                        "Make sure to set "
+                        "refinement/derefine_threshold_xyvelocity_gradient < "
+                        "refinement/threshold_xyvelocity_gradient.");
+      pkg->AddParam<Real>("refinement/threshold_xyvelocity_gradient", thr);
+      pkg->AddParam<Real>("refinement/derefine_threshold_xyvelocity_gradient", deref_thr);
+      return refinement::gradient::VelocityGradient;
+    } else if (criterion == "density_2nd_deriv_err_norm") {
+      const Real thr = pin->GetOrAddReal("refinement", "refine_threshold_2nd_deriv", 0.0);
+      PARTHENON_REQUIRE(thr > 0.,
+                        "Make sure to set refinement/threshold_pressure_gradient >0.");
+      Real deref_thr =
+          pin->GetOrAddReal("refinement", "derefine_threshold_2nd_deriv", -1);
+      if (deref_thr <= 0.0) {
+        deref_thr = 0.25 * thr;
+      }
+      PARTHENON_REQUIRE(deref_thr > 0.,
+                        "Make sure to set refinement/derefine_threshold_2nd_deriv >0.");
+      PARTHENON_REQUIRE(deref_thr < thr,
+                        "Make sure to set refinement/derefine_threshold_2nd_deriv < "
+                        "refinement/refine_threshold_2nd_deriv.");
+
+      const Real epsilon = pin->GetOrAddReal("refinement", "epsilon_2nd_deriv", 0.01);
+      PARTHENON_REQUIRE(epsilon > 0.,
+                        "Make sure to set refinement/epsilon_2nd_deriv >0.");
+
+      pkg->AddParam<Real>("refinement/threshold_density_2nd_deriv", thr);
+      pkg->AddParam<Real>("refinement/derefine_threshold_density_2nd_deriv", deref_thr);
+      pkg->AddParam<Real>("refinement/epsilon_density_2nd_deriv", epsilon);
+      return refinement::gradient::Density2ndDerivErrorNorm;
+    } else if (criterion == "maxdensity") {
+      const auto deref_below =
+          pin->GetOrAddReal("refinement", "maxdensity_deref_below", 0.0);
+      const auto refine_above =
+          pin->GetOrAddReal("refinement", "maxdensity_refine_above", 0.0);
+      PARTHENON_REQUIRE(deref_below > 0.,
+                        "Make sure to set refinement/maxdensity_deref_below > 0.");
+      PARTHENON_REQUIRE(refine_above > 0.,
+                        "Make sure to set refinement/maxdensity_refine_above > 0.");
+      PARTHENON_REQUIRE(deref_below < refine_above,
+                        "Make sure to set refinement/maxdensity_deref_below < "
+                        "refinement/maxdensity_refine_above");
+      pkg->AddParam<Real>("refinement/maxdensity_deref_below", deref_below);
+      pkg->AddParam<Real>("refinement/maxdensity_refine_above", refine_above);
+      return refinement::other::MaxDensity;
+    }
+    return nullptr;
+  };
+
   const auto refine_str = pin->GetOrAddString("refinement", "type", "unset");
-  if (refine_str == "pressure_gradient") {
-    pkg->CheckRefinementBlock = refinement::gradient::PressureGradient;
-    const auto thr = pin->GetOrAddReal("refinement", "threshold_pressure_gradient", 0.0);
-    PARTHENON_REQUIRE(thr > 0.,
-                      "Make sure to set refinement/threshold_pressure_gradient >0.");
-    pkg->AddParam<Real>("refinement/threshold_pressure_gradient", thr);
-
-  } else if (refine_str == "xyvelocity_gradient") {
-    pkg->CheckRefinementBlock = refinement::gradient::VelocityGradient;
-    const auto thr =
-        pin->GetOrAddReal("refinement", "threshold_xyvelocity_gradient", 0.0);
-    PARTHENON_REQUIRE(thr > 0.,
-                      "Make sure to set refinement/threshold_xyvelocity_gradient >0.");
-    pkg->AddParam<Real>("refinement/threshold_xyvelocity_gradient", thr);
-
-  } else if (refine_str == "density_2nd_deriv_err_norm") {
-    pkg->CheckRefinementBlock = refinement::gradient::Density2ndDerivErrorNorm;
-    const Real thr = pin->GetOrAddReal("refinement", "refine_threshold_2nd_deriv", 0.0);
-    PARTHENON_REQUIRE(thr > 0.,
-                      "Make sure to set refinement/threshold_pressure_gradient >0.");
-    Real deref_thr = pin->GetOrAddReal("refinement", "derefine_threshold_2nd_deriv", -1);
-    if (deref_thr <= 0.0) {
-      deref_thr = 0.25 * thr;
+  if (refine_str == "combined") {
+    // Comma separated list of built-in criteria evaluated in a single pass
+    refinement::CombinedCriteria combined;
+    std::stringstream criteria_ss(pin->GetString("refinement", "criteria"));
+    std::string criterion;
+    while (std::getline(criteria_ss, criterion, ',')) {
+      criterion.erase(0, criterion.find_first_not_of(' '));
+      criterion.erase(criterion.find_last_not_of(' ') + 1);
+      bool *enabled = nullptr;
+      if (criterion == "pressure_gradient") {
+        enabled = &combined.pressure_gradient;
+      } else if (criterion == "xyvelocity_gradient") {
+        enabled = &combined.xyvelocity_gradient;
+      } else if (criterion == "density_2nd_deriv_err_norm") {
+        enabled = &combined.density_2nd_deriv_err_norm;
+      } else if (criterion == "maxdensity") {
+        enabled = &combined.maxdensity;
+      }
+      PARTHENON_REQUIRE_THROWS(enabled != nullptr,
+                               "Unknown refinement criterion: " + criterion);
+      PARTHENON_REQUIRE_THROWS(!*enabled,
+                               "Refinement criterion listed twice: " + criterion);
+      *enabled = true;
+      add_refinement_criterion(criterion);
     }
-    PARTHENON_REQUIRE(deref_thr > 0.,
-                      "Make sure to set refinement/derefine_threshold_2nd_deriv >0.");
-
-    const Real epsilon = pin->GetOrAddReal("refinement", "epsilon_2nd_deriv", 0.01);
-    PARTHENON_REQUIRE(epsilon > 0., "Make sure to set refinement/epsilon_2nd_deriv >0.");
-
-    pkg->AddParam<Real>("refinement/threshold_density_2nd_deriv", thr);
-    pkg->AddParam<Real>("refinement/derefine_threshold_density_2nd_deriv", deref_thr);
-    pkg->AddParam<Real>("refinement/epsilon_density_2nd_deriv", epsilon);
-
-  } else if (refine_str == "maxdensity") {
-    pkg->CheckRefinementBlock = refinement::other::MaxDensity;
-    const auto deref_below =
-        pin->GetOrAddReal("refinement", "maxdensity_deref_below", 0.0);
-    const auto refine_above =
-        pin->GetOrAddReal("refinement", "maxdensity_refine_above", 0.0);
-    PARTHENON_REQUIRE(deref_below > 0.,
-                      "Make sure to set refinement/maxdensity_deref_below > 0.");
-    PARTHENON_REQUIRE(refine_above > 0.,
-                      "Make sure to set refinement/maxdensity_refine_above > 0.");
-    PARTHENON_REQUIRE(deref_below < refine_above,
-                      "Make sure to set refinement/maxdensity_deref_below < "
-                      "refinement/maxdensity_refine_above");
-    pkg->AddParam<Real>("refinement/maxdensity_deref_below", deref_below);
-    pkg->AddParam<Real>("refinement/maxdensity_refine_above", refine_above);
+    const auto combine_str = pin->GetOrAddString("refinement", "combine", "max");
+    PARTHENON_REQUIRE_THROWS(combine_str == "max" || combine_str == "min",
+                             "refinement/combine must be max or min.");
+    combined.combine_min = combine_str == "min";
+    pkg->AddParam<>("refinement/combined", combined);
+    pkg->CheckRefinementMesh = refinement::Combined;
   } else if (refine_str == "user") {
-    pkg->CheckRefinementBlock = Hydro::ProblemCheckRefinementBlock;
+    if (Hydro::ProblemCheckRefinementMesh != nullptr) {
+      pkg->CheckRefinementMesh = Hydro::ProblemCheckRefinementMesh;
+    } else {
+      pkg->CheckRefinementBlock = Hydro::ProblemCheckRefinementBlock;
+    }
+  } else {
+    auto check_refinement = add_refinement_criterion(refine_str);
+    if (check_refinement != nullptr) {
+      pkg->CheckRefinementMesh = check_refinement;
+    }
+  }
+
+  // Minimum number of cycles between the creation and the derefinement of a block to
+  // suppress blocks flipping between refinement and derefinement
+  const auto min_derefine_age = pin->GetOrAddInteger("refinement", "min_derefine_age", 0);
+  PARTHENON_REQUIRE_THROWS(min_derefine_age >= 0,
+                           "refinement/min_derefine_age must be >= 0.");
+  pkg->AddParam<>("refinement/min_derefine_age", min_derefine_age);
+  if (min_derefine_age > 0) {
+    PARTHENON_REQUIRE_THROWS(pkg->CheckRefinementMesh != nullptr,
+                             "refinement/min_derefine_age requires a built-in refinement "
+                             "criterion or a mesh-level user criterion.");
+    pkg->AddParam<>("refinement/block_ages", refinement::BlockAges(), true);
+    auto check_refinement = pkg->CheckRefinementMesh;
+    pkg->CheckRefinementMesh = [check_refinement](
+                                   MeshData<Real> *md,
+                                   parthenon::ParArray1D<parthenon::AmrTag> &amr_tags) {
+      check_refinement(md, amr_tags);
+      refinement::EnforceMinDerefineAge(md, amr_tags);
+    };
   }
 
   if (ProblemInitPackageData != nullptr) {
     ProblemInitPackageData(pin, pkg.get());
   }
 
+  // Reuse the packs of the hot tasks for each MeshData (see pack_cache.hpp)
+  const auto pack_cache = pin->GetOrAddBoolean("hydro", "pack_cache", false);
+  pkg->AddParam<>("pack_cache", pack_cache);
+  pack_cache::Initialize(pkg.get());
+
+  // Record the flux kernels as graphs and replay them (see stage_graphs.hpp). Only
+  // supported if the kernel arguments do not change between cycles, i.e., not for the
+  // divergence cleaning speed, the timestep of the fused update, or (allocation
+  // dependent) sparse packs, and without unsplit diffusion.
+  const auto graph_capture = pin->GetOrAddBoolean("hydro", "graph_capture", false);
+  if (graph_capture) {
+    PARTHENON_REQUIRE_THROWS(fluid == Fluid::euler,
+                             "hydro/graph_capture requires hydro/fluid=euler.");
+    PARTHENON_REQUIRE_THROWS(!fused_update, "hydro/graph_capture is incompatible with "
+                                            "hydro/fused_update.");
+    PARTHENON_REQUIRE_THROWS(!sparse_scalars, "hydro/graph_capture is incompatible with "
+                                              "hydro/sparse_scalars.");
+    PARTHENON_REQUIRE_THROWS(pkg->Param<DiffInt>("diffint") != DiffInt::unsplit,
+                             "hydro/graph_capture is incompatible with unsplit "
+                             "diffusion.");
+  }
+  pkg->AddParam<>("graph_capture", graph_capture);
+
   return pkg;
 }
 
-template <Fluid fluid>
-Real EstimateHyperbolicTimestep(MeshData<Real> *md) {
-  // get to package via first block in Meshdata (which exists by construction)
+// Specialized on the number of dimensions NDIM, see DispatchNDim
+template <Fluid fluid, typename EOS, int NDIM>
+Real MinCellCrossingTimeNDim(MeshData<Real> *md) {
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-  const auto &cfl_hyp = hydro_pkg->Param<Real>("cfl");
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &eos_ =
-      hydro_pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
-                                                 AdiabaticGLMMHDEOS>::type>("eos");
+  const auto prim_pack = pack_cache::Prim(md);
+  const auto &eos_ = hydro_pkg->Param<EOS>("eos");
 
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
   Real min_dt_hyperbolic = std::numeric_limits<Real>::max();
-
-  const auto ndim_ = prim_pack.GetNdim();
+  constexpr int ndim_ = NDIM;
   Kokkos::parallel_reduce(
-      "EstimateHyperbolicTimestep",
+      "Hydro::MinCellCrossingTime",
       Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
           DevExecSpace(), {0, kb.s, jb.s, ib.s},
           {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
           {1, 1, 1, ib.e + 1 - ib.s}),
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &min_dt) {
-        const auto &prim = prim_pack(b);
         const auto &coords = prim_pack.GetCoords(b);
-        // Need to reference variables here so that they are properly caught by
-        // nvcc, which cannot determine captured variables only used within constexpr if.
-        const auto &ndim = ndim_;
-        const auto &eos = eos_;
-
-        Real w[(NHYDRO)];
-        w[IDN] = prim(IDN, k, j, i);
-        w[IV1] = prim(IV1, k, j, i);
-        w[IV2] = prim(IV2, k, j, i);
-        w[IV3] = prim(IV3, k, j, i);
-        w[IPR] = prim(IPR, k, j, i);
-        Real lambda_max_x, lambda_max_y, lambda_max_z;
-        if constexpr (fluid == Fluid::euler) {
-          lambda_max_x = eos.SoundSpeed(w);
-          lambda_max_y = lambda_max_x;
-          lambda_max_z = lambda_max_x;
-
-        } else if constexpr (fluid == Fluid::glmmhd) {
-          lambda_max_x = eos.FastMagnetosonicSpeed(
-              w[IDN], w[IPR], prim(IB1, k, j, i), prim(IB2, k, j, i), prim(IB3, k, j, i));
-          if (ndim > 1) {
-            lambda_max_y =
-                eos.FastMagnetosonicSpeed(w[IDN], w[IPR], prim(IB2, k, j, i),
-                                          prim(IB3, k, j, i), prim(IB1, k, j, i));
-          }
-          if (ndim > 2) {
-            lambda_max_z =
-                eos.FastMagnetosonicSpeed(w[IDN], w[IPR], prim(IB3, k, j, i),
-                                          prim(IB1, k, j, i), prim(IB2, k, j, i));
-          }
-        } else {
-          PARTHENON_FAIL("Unknown fluid in EstimateTimestep");
-        }
-        min_dt = fmin(min_dt, coords.Dxc<1>(k, j, i) / (fabs(w[IV1]) + lambda_max_x));
-        if (ndim > 1) {
-          min_dt = fmin(min_dt, coords.Dxc<2>(k, j, i) / (fabs(w[IV2]) + lambda_max_y));
-        }
-        if (ndim > 2) {
-          min_dt = fmin(min_dt, coords.Dxc<3>(k, j, i) / (fabs(w[IV3]) + lambda_max_z));
-        }
+        min_dt = fmin(min_dt, CellCrossingTime<fluid>(eos_, prim_pack(b), coords, ndim_,
+                                                      k, j, i));
       },
       Kokkos::Min<Real>(min_dt_hyperbolic));
 
-  // TODO(pgrete) THIS WORKAROUND IS NOT THREAD SAFE (though this will only become
-  // relevant once parthenon uses host-multithreading in the driver).
+  return min_dt_hyperbolic;
+}
+
+template <Fluid fluid, typename EOS>
+Real MinCellCrossingTime(MeshData<Real> *md) {
+  return DispatchNDim(pack_cache::GetParams().ndim, [&](auto dim) {
+    return MinCellCrossingTimeNDim<fluid, EOS, decltype(dim)::value>(md);
+  });
+}
+
+// Reuse the timestep from the fused conversion to primitive variables if available
+bool PopCachedCellCrossingTime(StateDescriptor *hydro_pkg, MeshData<Real> *md,
+                               Real &min_dt_hyperbolic) {
+  return utils::shared_params::WithMutableParam<std::map<MeshData<Real> *, Real>>(
+      hydro_pkg, "fused_dt_hyp_cache", [&](auto *dt_hyp_cache) {
+        auto cached_dt_hyp = dt_hyp_cache->find(md);
+        if (cached_dt_hyp == dt_hyp_cache->end()) {
+          return false;
+        }
+        min_dt_hyperbolic = cached_dt_hyp->second;
+        dt_hyp_cache->erase(cached_dt_hyp);
+        return true;
+      });
+}
+
+// Hyperbolic timestep (incl. cfl) from the minimum cell crossing time
+template <Fluid fluid>
+Real HyperbolicTimestep(StateDescriptor *hydro_pkg, const Real min_dt_hyperbolic) {
+  const auto &cfl_hyp = hydro_pkg->Param<Real>("cfl");
+
   // We need to save the the hyperbolic part to recover it later as
   // the divergence cleaning speed is only limited in relation to the other
   // hyperbolic signal speeds and not by (potentially more restrictive) diffusive
   // processes.
+  // The minimum is accumulated over all partitions (safe with concurrent task lists).
   if constexpr (fluid == Fluid::glmmhd) {
-    auto dt_hyp_pkg = hydro_pkg->Param<Real>("dt_hyp");
-    if (cfl_hyp * min_dt_hyperbolic < dt_hyp_pkg) {
-      hydro_pkg->UpdateParam("dt_hyp", cfl_hyp * min_dt_hyperbolic);
-    }
+    utils::shared_params::UpdateMin(hydro_pkg, "dt_hyp", cfl_hyp * min_dt_hyperbolic);
   }
   return cfl_hyp * min_dt_hyperbolic;
 }
 
+template <Fluid fluid, typename EOS>
+Real EstimateHyperbolicTimestep(MeshData<Real> *md) {
+  // get to package via first block in Meshdata (which exists by construction)
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+
+  Real min_dt_hyperbolic;
+  if (!PopCachedCellCrossingTime(hydro_pkg.get(), md, min_dt_hyperbolic)) {
+    min_dt_hyperbolic = MinCellCrossingTime<fluid, EOS>(md);
+  }
+  return HyperbolicTimestep<fluid>(hydro_pkg.get(), min_dt_hyperbolic);
+}
+
+// Calculation of the thermal conduction timestep, see EstimateConductionTimestep
+enum class ConductionDt { none, iso_fixed, general };
+
+// Minimum cell crossing time and diffusive timesteps (all without cfl and, for the
+// latter, the dimensional prefactor) of the enabled processes.
+struct MinTimesteps {
+  Real hyp, cond, visc, ohm;
+};
+
+// Single pass over all interior cells of md reducing the constraints of the (compile
+// time) combination of processes (with <hydro/fused_dt_estimate>). Disabled constraints
+// are std::numeric_limits<Real>::max().
+template <Fluid fluid, typename EOS, bool HYP, ConductionDt COND, bool VISC, bool OHM>
+MinTimesteps FusedMinTimesteps(MeshData<Real> *md) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto prim_pack = pack_cache::Prim(md);
+  // only packed and used if enabled
+  const auto &coeff_pack = md->PackVariables(std::vector<std::string>{"thermal_diff"});
+  const auto &eos_ = hydro_pkg->Param<EOS>("eos");
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  const auto ndim_ = pack_cache::GetParams().ndim;
+
+  // Coefficients are only available (and used) for enabled processes
+  auto thermal_diff_ =
+      ThermalDiffusivity(Conduction::none, ConductionCoeff::none, 0.0, 0.0, 0.0, 0.0);
+  Real thermal_diff_coeff_ = 0.0, flux_sat_prefac_ = 0.0;
+  bool use_coeff_field_ = false;
+  if constexpr (COND != ConductionDt::none) {
+    thermal_diff_ = hydro_pkg->Param<ThermalDiffusivity>("thermal_diff");
+    // Using 0.0 as parameters rho and p as they're not used anyway for a fixed coeff.
+    thermal_diff_coeff_ = thermal_diff_.Get(0.0, 0.0);
+    flux_sat_prefac_ = hydro_pkg->Param<Real>("conduction_sat_prefac");
+    use_coeff_field_ = hydro_pkg->Param<bool>("diffusion_coeff_field");
+  }
+  Real mom_diff_coeff_ = 0.0;
+  if constexpr (VISC) {
+    mom_diff_coeff_ = hydro_pkg->Param<MomentumDiffusivity>("mom_diff").Get(0.0, 0.0);
+  }
+  Real ohm_diff_coeff_ = 0.0;
+  if constexpr (OHM) {
+    ohm_diff_coeff_ = hydro_pkg->Param<OhmicDiffusivity>("ohm_diff").Get(0.0, 0.0);
+  }
+
+  constexpr auto no_constraint = std::numeric_limits<Real>::max();
+  MinTimesteps min_dts{no_constraint, no_constraint, no_constraint, no_constraint};
+  Kokkos::parallel_reduce(
+      "Hydro::FusedEstimateTimestep",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &min_hyp,
+                    Real &min_cond, Real &min_visc, Real &min_ohm) {
+        const auto &prim = prim_pack(b);
+        const auto &coords = prim_pack.GetCoords(b);
+        // Need to reference variables here so that they are properly caught by nvcc,
+        // which cannot determine captured variables only used within constexpr if.
+        const auto &ndim = ndim_;
+        const auto &eos = eos_;
+        const auto &thermal_diff = thermal_diff_;
+        const auto &thermal_diff_coeff = thermal_diff_coeff_;
+        const auto &flux_sat_prefac = flux_sat_prefac_;
+        const auto &use_coeff_field = use_coeff_field_;
+        const auto &mom_diff_coeff = mom_diff_coeff_;
+        const auto &ohm_diff_coeff = ohm_diff_coeff_;
+
+        if constexpr (HYP) {
+          min_hyp =
+              fmin(min_hyp, CellCrossingTime<fluid>(eos, prim, coords, ndim, k, j, i));
+        }
+        if constexpr (COND == ConductionDt::iso_fixed) {
+          min_cond = fmin(min_cond, CellDiffusionTimestepFixed(coords, thermal_diff_coeff,
+                                                               ndim, k, j, i));
+        } else if constexpr (COND == ConductionDt::general) {
+          min_cond = fmin(min_cond, CellConductionTimestepGeneral(
+                                        prim, coeff_pack, thermal_diff, flux_sat_prefac,
+                                        use_coeff_field, coords, ndim, b, k, j, i));
+        }
+        if constexpr (VISC) {
+          min_visc = fmin(min_visc, CellDiffusionTimestepFixed(coords, mom_diff_coeff,
+                                                               ndim, k, j, i));
+        }
+        if constexpr (OHM) {
+          min_ohm = fmin(min_ohm, CellDiffusionTimestepFixed(coords, ohm_diff_coeff, ndim,
+                                                             k, j, i));
+        }
+      },
+      Kokkos::Min<Real>(min_dts.hyp), Kokkos::Min<Real>(min_dts.cond),
+      Kokkos::Min<Real>(min_dts.visc), Kokkos::Min<Real>(min_dts.ohm));
+  return min_dts;
+}
+
+// Translate the runtime combination of processes to the template parameters
+template <Fluid fluid, typename EOS, bool HYP, ConductionDt COND, bool VISC>
+MinTimesteps DispatchFusedOhm(MeshData<Real> *md, const bool ohm) {
+  return ohm ? FusedMinTimesteps<fluid, EOS, HYP, COND, VISC, true>(md)
+             : FusedMinTimesteps<fluid, EOS, HYP, COND, VISC, false>(md);
+}
+
+template <Fluid fluid, typename EOS, bool HYP, ConductionDt COND>
+MinTimesteps DispatchFusedVisc(MeshData<Real> *md, const bool visc, const bool ohm) {
+  return visc ? DispatchFusedOhm<fluid, EOS, HYP, COND, true>(md, ohm)
+              : DispatchFusedOhm<fluid, EOS, HYP, COND, false>(md, ohm);
+}
+
+template <Fluid fluid, typename EOS, bool HYP>
+MinTimesteps DispatchFusedCond(MeshData<Real> *md, const ConductionDt cond,
+                               const bool visc, const bool ohm) {
+  if (cond == ConductionDt::iso_fixed) {
+    return DispatchFusedVisc<fluid, EOS, HYP, ConductionDt::iso_fixed>(md, visc, ohm);
+  } else if (cond == ConductionDt::general) {
+    return DispatchFusedVisc<fluid, EOS, HYP, ConductionDt::general>(md, visc, ohm);
+  }
+  return DispatchFusedVisc<fluid, EOS, HYP, ConductionDt::none>(md, visc, ohm);
+}
+
+template <Fluid fluid, typename EOS>
+MinTimesteps DispatchFusedMinTimesteps(MeshData<Real> *md, const bool hyp,
+                                       const ConductionDt cond, const bool visc,
+                                       const bool ohm) {
+  return hyp ? DispatchFusedCond<fluid, EOS, true>(md, cond, visc, ohm)
+             : DispatchFusedCond<fluid, EOS, false>(md, cond, visc, ohm);
+}
+
 // provide the routine that estimates a stable timestep for this package
-template <Fluid fluid>
+template <Fluid fluid, typename EOS>
 Real EstimateTimestep(MeshData<Real> *md) {
+  utils::profiling::ScopedRegion region("Hydro::EstimateTimestep");
   // get to package via first block in Meshdata (which exists by construction)
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   auto min_dt = std::numeric_limits<Real>::max();
   auto dt_hyp = std::numeric_limits<Real>::max();
 
   const auto calc_dt_hyp = hydro_pkg->Param<bool>("calc_dt_hyp");
-  if (calc_dt_hyp) {
-    dt_hyp = EstimateHyperbolicTimestep<fluid>(md);
-    min_dt = std::min(min_dt, dt_hyp);
+  const auto &diffint = hydro_pkg->Param<DiffInt>("diffint");
+  const bool conduction = diffint != DiffInt::none &&
+                          hydro_pkg->Param<Conduction>("conduction") != Conduction::none;
+  const bool viscosity = diffint != DiffInt::none &&
+                         hydro_pkg->Param<Viscosity>("viscosity") != Viscosity::none;
+  const bool resistivity =
+      diffint != DiffInt::none &&
+      hydro_pkg->Param<Resistivity>("resistivity") != Resistivity::none;
+  // diffusive timestep constraints of the individual processes
+  auto dt_cond = std::numeric_limits<Real>::max();
+  auto dt_visc = std::numeric_limits<Real>::max();
+  auto dt_ohm = std::numeric_limits<Real>::max();
+
+  if (hydro_pkg->Param<bool>("fused_dt_estimate")) {
+    Real min_dt_hyperbolic;
+    const bool calc_min_dt_hyperbolic =
+        calc_dt_hyp &&
+        !PopCachedCellCrossingTime(hydro_pkg.get(), md, min_dt_hyperbolic);
+
+    auto cond = ConductionDt::none;
+    if (conduction) {
+      const auto &thermal_diff = hydro_pkg->Param<ThermalDiffusivity>("thermal_diff");
+      cond = thermal_diff.GetType() == Conduction::isotropic &&
+                     thermal_diff.GetCoeffType() == ConductionCoeff::fixed
+                 ? ConductionDt::iso_fixed
+                 : ConductionDt::general;
+    }
+    PARTHENON_REQUIRE_THROWS(
+        !viscosity ||
+            hydro_pkg->Param<MomentumDiffusivity>("mom_diff").GetCoeffType() ==
+                ViscosityCoeff::fixed,
+        "Needs impl.");
+    PARTHENON_REQUIRE_THROWS(
+        !resistivity || hydro_pkg->Param<OhmicDiffusivity>("ohm_diff").GetCoeffType() ==
+                            ResistivityCoeff::fixed,
+        "Needs impl.");
+    const auto min_dts = DispatchFusedMinTimesteps<fluid, EOS>(
+        md, calc_min_dt_hyperbolic, cond, viscosity, resistivity);
+
+    if (calc_dt_hyp) {
+      dt_hyp = HyperbolicTimestep<fluid>(
+          hydro_pkg.get(), calc_min_dt_hyperbolic ? min_dts.hyp : min_dt_hyperbolic);
+      min_dt = std::min(min_dt, dt_hyp);
+    }
+    if (diffint != DiffInt::none) {
+      // Same prefactors as in the separate Estimate*Timestep functions
+      const auto ndim = md->GetBlockData(0)->GetBlockPointer()->pmy_mesh->ndim;
+      const Real fac = ndim == 1 ? 0.5 : (ndim == 2 ? 0.25 : 1.0 / 6.0);
+      const auto &cfl_diff = hydro_pkg->Param<Real>("cfl_diff");
+      dt_cond = cfl_diff * fac * min_dts.cond;
+      dt_visc = cfl_diff * fac * min_dts.visc;
+      dt_ohm = cfl_diff * fac * min_dts.ohm;
+    }
+  } else {
+    if (calc_dt_hyp) {
+      dt_hyp = EstimateHyperbolicTimestep<fluid, EOS>(md);
+      min_dt = std::min(min_dt, dt_hyp);
+    }
+    if (conduction) {
+      dt_cond = EstimateConductionTimestep(md);
+    }
+    if (viscosity) {
+      dt_visc = EstimateViscosityTimestep(md);
+    }
+    if (resistivity) {
+      dt_ohm = EstimateResistivityTimestep(md);
+    }
   }
 
   const auto &enable_cooling = hydro_pkg->Param<Cooling>("enable_cooling");
@@ -954,33 +2021,34 @@ Real EstimateTimestep(MeshData<Real> *md) {
   }
 
   auto dt_diff = std::numeric_limits<Real>::max();
-  if (hydro_pkg->Param<DiffInt>("diffint") != DiffInt::none) {
-    if (hydro_pkg->Param<Conduction>("conduction") != Conduction::none) {
-      dt_diff = std::min(dt_diff, EstimateConductionTimestep(md));
+  if (diffint != DiffInt::none) {
+    if (conduction) {
+      dt_diff = std::min(dt_diff, dt_cond);
     }
-    if (hydro_pkg->Param<Viscosity>("viscosity") != Viscosity::none) {
-      dt_diff = std::min(dt_diff, EstimateViscosityTimestep(md));
+    if (viscosity) {
+      dt_diff = std::min(dt_diff, dt_visc);
     }
-    if (hydro_pkg->Param<Resistivity>("resistivity") != Resistivity::none) {
-      dt_diff = std::min(dt_diff, EstimateResistivityTimestep(md));
+    if (resistivity) {
+      dt_diff = std::min(dt_diff, dt_ohm);
     }
 
     // For unsplit ingegration use strict limit
     if (hydro_pkg->Param<DiffInt>("diffint") == DiffInt::unsplit) {
       min_dt = std::min(min_dt, dt_diff);
-      // and for RKL2 integration use limit taking into account the maxium ratio
+      // and for RKL2/RKL1 integration use limit taking into account the maxium ratio
       // or not constrain limit further (which is why RKL2 is there in first place)
-    } else if (hydro_pkg->Param<DiffInt>("diffint") == DiffInt::rkl2) {
-      const auto max_dt_ratio = hydro_pkg->Param<Real>("rkl2_max_dt_ratio");
+    } else if (hydro_pkg->Param<DiffInt>("diffint") == DiffInt::rkl2 ||
+               hydro_pkg->Param<DiffInt>("diffint") == DiffInt::rkl1) {
+      const auto max_dt_ratio = hydro_pkg->Param<Real>("sts_max_dt_ratio");
       if (max_dt_ratio > 0.0 && dt_hyp / dt_diff > max_dt_ratio) {
         min_dt = std::min(min_dt, max_dt_ratio * dt_diff);
       }
-    } else {
+      // The implicit integrator is unconditionally stable.
+    } else if (hydro_pkg->Param<DiffInt>("diffint") != DiffInt::implicit) {
       PARTHENON_THROW("Looks like a a new diffusion integrator was implemented without "
                       "taking into accout timestep contstraints yet.");
     }
-    auto dt_diff_param = hydro_pkg->Param<Real>("dt_diff");
-    hydro_pkg->UpdateParam("dt_diff", std::min(dt_diff, dt_diff_param));
+    utils::shared_params::UpdateMin(hydro_pkg.get(), "dt_diff", dt_diff);
   }
 
   if (ProblemEstimateTimestep != nullptr) {
@@ -996,22 +2064,175 @@ Real EstimateTimestep(MeshData<Real> *md) {
   return min_dt;
 }
 
+// Flux divergence contribution of the XNDIR fluxes to cell (k, j, i), i.e., the
+// XNDIR part of parthenon::Update::FluxDivHelper.
+template <int XNDIR>
+KOKKOS_INLINE_FUNCTION Real FluxDivDir(const int v, const int k, const int j, const int i,
+                                       const parthenon::Coordinates_t &coords,
+                                       const VariableFluxPack<Real> &cons) {
+  constexpr int ioff = XNDIR == X1DIR ? 1 : 0;
+  constexpr int joff = XNDIR == X2DIR ? 1 : 0;
+  constexpr int koff = XNDIR == X3DIR ? 1 : 0;
+  return (coords.FaceArea<XNDIR>(k, j, i) * cons.flux(XNDIR, v, k, j, i) -
+          coords.FaceArea<XNDIR>(k + koff, j + joff, i + ioff) *
+              cons.flux(XNDIR, v, k + koff, j + joff, i + ioff)) /
+         coords.CellVolume(k, j, i);
+}
+
+// Upwinded passive scalar fluxes on the XNDIR faces [il, iu] of the pencil (k, j).
+// All scalars of a face are processed by the same thread so that the mass flux (which
+// determines the upwind state) is only read once per face independent of the number of
+// scalars. Sparse scalars that are not allocated on the block are skipped.
+template <int XNDIR>
+KOKKOS_INLINE_FUNCTION void
+PassiveScalarFluxes(parthenon::team_mbr_t const &member, const int k, const int j,
+                    const int il, const int iu, const int nhydro, const int nscalars,
+                    const parthenon::ScratchPad2D<ScratchReal> &wl,
+                    const parthenon::ScratchPad2D<ScratchReal> &wr,
+                    VariableFluxPack<Real> &cons) {
+  if (nscalars == 0) {
+    return;
+  }
+  parthenon::par_for_inner(member, il, iu, [&](const int i) {
+    const Real mass_flux = cons.flux(XNDIR, IDN, k, j, i);
+    const auto &w = mass_flux >= 0.0 ? wl : wr;
+    for (auto n = nhydro; n < nhydro + nscalars; ++n) {
+      if (cons.IsAllocated(n)) {
+        cons.flux(XNDIR, n, k, j, i) = mass_flux * w(n, i);
+      }
+    }
+  });
+}
+
+// Reconstruction of the variables [nl, nu] that uses the unlimited stencils (only
+// available for PPM and WENOZ) in smooth pencils.
+template <Reconstruction recon, int XNDIR>
+KOKKOS_INLINE_FUNCTION void
+ReconstructHybrid(parthenon::team_mbr_t const &member, const int k, const int j,
+                  const int il, const int iu, const parthenon::VariablePack<Real> &q,
+                  ScratchPad2D<ScratchReal> &ql, ScratchPad2D<ScratchReal> &qr,
+                  const int nl, const int nu, const bool smooth) {
+  if constexpr (recon == Reconstruction::ppm || recon == Reconstruction::wenoz) {
+    if (smooth) {
+      ReconstructLinear<recon, XNDIR>(member, k, j, il, iu, q, ql, qr, nl, nu);
+      return;
+    }
+  }
+  Reconstruct<recon, XNDIR>(member, k, j, il, iu, q, ql, qr, nl, nu);
+}
+
+// Reconstructs the nhydro hydro variables with recon and the nscalars passive scalars
+// with (the typically cheaper) recon_scalars. Sparse scalars are reconstructed one by one
+// so that the ones not allocated on the block are skipped.
+template <Reconstruction recon, Reconstruction recon_scalars, int XNDIR>
+KOKKOS_INLINE_FUNCTION void
+ReconstructVars(parthenon::team_mbr_t const &member, const int k, const int j,
+                const int il, const int iu, const parthenon::VariablePack<Real> &q,
+                ScratchPad2D<ScratchReal> &ql, ScratchPad2D<ScratchReal> &qr,
+                const int nhydro, const int nscalars, const bool smooth,
+                const bool sparse) {
+  if (sparse) {
+    ReconstructHybrid<recon, XNDIR>(member, k, j, il, iu, q, ql, qr, 0, nhydro - 1,
+                                    smooth);
+    for (auto n = nhydro; n < nhydro + nscalars; ++n) {
+      if (q.IsAllocated(n)) {
+        ReconstructHybrid<recon_scalars, XNDIR>(member, k, j, il, iu, q, ql, qr, n, n,
+                                                smooth);
+      }
+    }
+  } else if constexpr (recon == recon_scalars) {
+    ReconstructHybrid<recon, XNDIR>(member, k, j, il, iu, q, ql, qr, 0,
+                                    nhydro + nscalars - 1, smooth);
+  } else {
+    ReconstructHybrid<recon, XNDIR>(member, k, j, il, iu, q, ql, qr, 0, nhydro - 1,
+                                    smooth);
+    ReconstructHybrid<recon_scalars, XNDIR>(member, k, j, il, iu, q, ql, qr, nhydro,
+                                            nhydro + nscalars - 1, smooth);
+  }
+}
+
+// True if no cell in the reconstruction stencils of the faces [il, iu] of pencil (k, j)
+// is troubled. Uniform across the team so that all threads use the same reconstruction.
+template <int XNDIR>
+KOKKOS_INLINE_FUNCTION bool SmoothPencil(parthenon::team_mbr_t const &member,
+                                         const int k, const int j, const int il,
+                                         const int iu,
+                                         const parthenon::VariablePack<Real> &troubled) {
+  const int dk = XNDIR == parthenon::X3DIR;
+  const int dj = XNDIR == parthenon::X2DIR;
+  const int di = XNDIR == parthenon::X1DIR;
+  Real num_troubled = 0.0;
+  // Troubled cells are flagged based on their direct neighbors so the stencils of the +-2
+  // cells are covered by the flags of the neighboring cells in the sweep direction.
+  Kokkos::parallel_reduce(
+      Kokkos::TeamThreadRange(member, il - di, iu + di + 1),
+      [&](const int i, Real &lnum) {
+        lnum += troubled(0, k, j, i);
+        if (!di) {
+          lnum += troubled(0, k - dk, j - dj, i) + troubled(0, k + dk, j + dj, i);
+        }
+      },
+      num_troubled);
+  return num_troubled == 0.0;
+}
+
+// Faces [fs, fe] in the sweep direction of a flux kernel split into (up to) two ranges
+// that are each processed in tiles of (at most) `tile` faces (all faces of a range for
+// non-positive values). For BlockRegion::interior, only the faces whose reconstruction
+// stencil covers no ghost cells are included and for BlockRegion::rim the remaining ones
+// (at both ends of the sweep).
+struct SweepFaces {
+  int s[2], e[2];
+  int tile[2], ntiles[2];
+
+  SweepFaces(const int fs, const int fe, const int nghost, const BlockRegion region,
+             const int tile_) {
+    if (region == BlockRegion::all) {
+      s[0] = fs, e[0] = fe, s[1] = 0, e[1] = -1;
+    } else if (region == BlockRegion::interior) {
+      s[0] = fs + nghost, e[0] = fe - nghost, s[1] = 0, e[1] = -1;
+    } else {
+      s[0] = fs, e[0] = std::min(fs + nghost - 1, fe);
+      s[1] = std::max(fe - nghost + 1, fs + nghost), e[1] = fe;
+    }
+    for (int r = 0; r < 2; r++) {
+      const int len = std::max(e[r] - s[r] + 1, 0);
+      tile[r] = tile_ > 0 ? tile_ : std::max(len, 1);
+      ntiles[r] = (len + tile[r] - 1) / tile[r];
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION int NumTiles() const { return ntiles[0] + ntiles[1]; }
+
+  // first (ts) and last (te) face of tile t
+  KOKKOS_INLINE_FUNCTION void GetTile(const int t, int &ts, int &te) const {
+    const int r = t < ntiles[0] ? 0 : 1;
+    ts = s[r] + (t - r * ntiles[0]) * tile[r];
+    te = std::min(ts + tile[r] - 1, e[r]);
+  }
+};
+
 // Calculate fluxes using a tightly nested 3D loop over the entire block.
 // Currently only used for testing the LLF Riemann solver used in first-order flux corr.
-template <Fluid fluid>
-TaskStatus CalculateFluxesTight(std::shared_ptr<MeshData<Real>> &md) {
+template <Fluid fluid, typename EOS>
+TaskStatus CalculateFluxesTight(std::shared_ptr<MeshData<Real>> &md,
+                                MeshData<Real> *u1_data, const Real gam0,
+                                const Real gam1, const Real beta_dt,
+                                const BlockRegion region) {
+  utils::profiling::ScopedRegion profiling_region("Hydro::CalculateFluxesTight");
+  PARTHENON_REQUIRE(u1_data == nullptr,
+                    "Fused update not supported in tightly nested flux calculation.");
+  PARTHENON_REQUIRE(region == BlockRegion::all,
+                    "Interior/rim split not supported in tightly nested flux calc.");
   auto pmb = md->GetBlockData(0)->GetBlockPointer();
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
 
-  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
-  auto cons_in = md->PackVariablesAndFluxes(flags_ind);
   auto pkg = pmb->packages.Get("Hydro");
+  auto cons_in = pack_cache::ConsAndFluxes(md.get());
 
-  const auto &eos =
-      pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
-                                           AdiabaticGLMMHDEOS>::type>("eos");
+  const auto &eos = pkg->Param<EOS>("eos");
 
   // Hyperbolic divergence cleaning speed for GLM MHD
   Real c_h = 0.0;
@@ -1019,22 +2240,22 @@ TaskStatus CalculateFluxesTight(std::shared_ptr<MeshData<Real>> &md) {
     c_h = pkg->Param<Real>("c_h");
   }
   // TODO(pgrete) fix scalar fluxes, too
-  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
+  auto const prim_in = pack_cache::Prim(md.get());
 
-  const int ndim = pmb->pmy_mesh->ndim;
+  const int ndim = pack_cache::GetParams().ndim;
   auto riemann = Riemann<fluid, RiemannSolver::llf>();
   // loop bounds are chosen so that all active fluxes are calculated
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "DC LLF fluxes", parthenon::DevExecSpace(), 0,
+      DEFAULT_LOOP_PATTERN, "Hydro::CalculateFluxesTight", parthenon::DevExecSpace(), 0,
       cons_in.GetDim(5) - 1, kb.s, kb.e + 1, jb.s, jb.e + 1, ib.s, ib.e + 1,
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
         auto &cons = cons_in(b);
         const auto &prim = prim_in(b);
         riemann.Solve(eos, k, j, i, IV1, prim, cons, c_h);
-        if (ndim >= 2) {
+        if (HasDim(ndim, 2)) {
           riemann.Solve(eos, k, j, i, IV2, prim, cons, c_h);
         }
-        if (ndim >= 3) {
+        if (HasDim(ndim, 3)) {
           riemann.Solve(eos, k, j, i, IV3, prim, cons, c_h);
         }
       });
@@ -1043,31 +2264,44 @@ TaskStatus CalculateFluxesTight(std::shared_ptr<MeshData<Real>> &md) {
 }
 
 // Calculate fluxes using scratch pad memory, i.e., over cached pencils in i-dir.
-template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
-TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
+// If u1_data is not a nullptr, the flux divergence update is directly applied to the
+// interior cells of "md" within the pencil kernels once both fluxes of a cell in the
+// respective direction are available (i.e., while they are still in cache).
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver,
+          Reconstruction recon_scalars, typename EOS>
+TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md, MeshData<Real> *u1_data,
+                           const Real gam0_, const Real gam1_, const Real beta_dt_,
+                           const BlockRegion region) {
+  utils::profiling::ScopedRegion profiling_region("Hydro::CalculateFluxes");
+  // Work around for CUDA <=11.6
+  const Real gam0 = gam0_;
+  const Real gam1 = gam1_;
+  const Real beta_dt = beta_dt_;
+
   auto pmb = md->GetBlockData(0)->GetBlockPointer();
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
   int il, iu, jl, ju, kl, ku;
   jl = jb.s, ju = jb.e, kl = kb.s, ku = kb.e;
+  // Only fluxes of interior pencils are required for the update of interior cells.
+  const bool split = region != BlockRegion::all;
   // TODO(pgrete): are these looop limits are likely too large for 2nd order
-  if (pmb->block_size.nx(X2DIR) > 1) {
+  if (!split && pmb->block_size.nx(X2DIR) > 1) {
     if (pmb->block_size.nx(X3DIR) == 1) // 2D
       jl = jb.s - 1, ju = jb.e + 1, kl = kb.s, ku = kb.e;
     else // 3D
       jl = jb.s - 1, ju = jb.e + 1, kl = kb.s - 1, ku = kb.e + 1;
   }
 
-  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
-  auto cons_in = md->PackVariablesAndFluxes(flags_ind);
   auto pkg = pmb->packages.Get("Hydro");
-  const auto nhydro = pkg->Param<int>("nhydro");
-  const auto nscalars = pkg->Param<int>("nscalars");
+  const auto &params = pack_cache::GetParams();
+  auto cons_in = pack_cache::ConsAndFluxes(md.get());
+  const auto nhydro = params.nhydro;
+  const auto nscalars = params.nscalars;
+  const auto sparse = params.sparse_scalars;
 
-  const auto &eos =
-      pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
-                                           AdiabaticGLMMHDEOS>::type>("eos");
+  const auto &eos = pkg->Param<EOS>("eos");
 
   auto num_scratch_vars = nhydro + nscalars;
 
@@ -1077,152 +2311,291 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
     c_h = pkg->Param<Real>("c_h");
   }
 
-  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
+  auto const prim_in = pack_cache::Prim(md.get());
+
+  // Only used in hybrid reconstruction. Otherwise just a (cheap) copy to capture.
+  const bool hybrid = params.hybrid_reconstruction;
+  const auto troubled_in =
+      hybrid ? md->PackVariables(std::vector<std::string>{"troubled"}) : prim_in;
+
+  const bool fused_update = u1_data != nullptr;
+  PARTHENON_REQUIRE(!(fused_update && split),
+                    "Fused update requires all fluxes to be calculated at once.");
+  // Only used in fused update. Otherwise just a (cheap) copy to capture in the kernels.
+  auto u1_cons_in = fused_update ? pack_cache::ConsAndFluxes(u1_data) : cons_in;
+  const auto nvars = cons_in.GetDim(4);
 
-  const int scratch_level =
-      pkg->Param<int>("scratch_level"); // 0 is actual scratch (tiny); 1 is HBM
+  const int scratch_level = params.scratch_level; // 0 is actual scratch (tiny); 1 is HBM
   const int nx1 = pmb->cellbounds.ncellsi(IndexDomain::entire);
+  // Number of faces processed by a single team in the x2 and x3 sweeps (with the
+  // non-positive default covering all faces of a pencil)
+  const auto tile_s = params.flux_tile_sweep;
+  // Number of pencils (in the transverse direction) processed together by a team in the
+  // x2 and x3 sweeps, i.e., the tile of a team spans tile_s x tile_t pencil faces.
+  const auto tile_t = params.flux_tile_transverse;
 
   size_t scratch_size_in_bytes =
-      parthenon::ScratchPad2D<Real>::shmem_size(num_scratch_vars, nx1) * 2;
+      parthenon::ScratchPad2D<ScratchReal>::shmem_size(num_scratch_vars, nx1) * 2;
 
   auto riemann = Riemann<fluid, rsolver>();
 
+  const int nghost = parthenon::Globals::nghost;
+  const SweepFaces faces_x1(ib.s, ib.e + 1, nghost, region, -1);
+
   parthenon::par_for_outer(
-      DEFAULT_OUTER_LOOP_PATTERN, "x1 flux", DevExecSpace(), scratch_size_in_bytes,
-      scratch_level, 0, cons_in.GetDim(5) - 1, kl, ku, jl, ju,
+      DEFAULT_OUTER_LOOP_PATTERN, "Hydro::CalculateFluxes::X1", DevExecSpace(),
+      scratch_size_in_bytes, scratch_level, 0, cons_in.GetDim(5) - 1, kl, ku, jl, ju,
       KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k, const int j) {
         const auto &prim = prim_in(b);
         auto &cons = cons_in(b);
-        parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
-                                         num_scratch_vars, nx1);
-        parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
-                                         num_scratch_vars, nx1);
-        // get reconstructed state on faces
-        Reconstruct<recon, X1DIR>(member, k, j, ib.s - 1, ib.e + 1, prim, wl, wr);
-        // Sync all threads in the team so that scratch memory is consistent
-        member.team_barrier();
-
-        riemann.Solve(member, k, j, ib.s, ib.e + 1, IV1, wl, wr, cons, eos, c_h);
-        member.team_barrier();
-
-        // Passive scalar fluxes
-        for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-          parthenon::par_for_inner(member, ib.s, ib.e + 1, [&](const int i) {
-            if (cons.flux(IV1, IDN, k, j, i) >= 0.0) {
-              cons.flux(IV1, n, k, j, i) = cons.flux(IV1, IDN, k, j, i) * wl(n, i);
-            } else {
-              cons.flux(IV1, n, k, j, i) = cons.flux(IV1, IDN, k, j, i) * wr(n, i);
-            }
-          });
+        parthenon::ScratchPad2D<ScratchReal> wl(member.team_scratch(scratch_level),
+                                                num_scratch_vars, nx1);
+        parthenon::ScratchPad2D<ScratchReal> wr(member.team_scratch(scratch_level),
+                                                num_scratch_vars, nx1);
+        for (int t = 0; t < faces_x1.NumTiles(); t++) {
+          int fs, fe;
+          faces_x1.GetTile(t, fs, fe);
+          // get reconstructed state on faces
+          const bool smooth =
+              hybrid && SmoothPencil<X1DIR>(member, k, j, fs - 1, fe, troubled_in(b));
+          ReconstructVars<recon, recon_scalars, X1DIR>(member, k, j, fs - 1, fe, prim, wl,
+                                                       wr, nhydro, nscalars, smooth,
+                                                       sparse);
+          // Sync all threads in the team so that scratch memory is consistent
+          member.team_barrier();
+
+          riemann.Solve(member, k, j, fs, fe, IV1, wl, wr, cons, eos, c_h);
+          member.team_barrier();
+
+          // Passive scalar fluxes
+          PassiveScalarFluxes<X1DIR>(member, k, j, fs, fe, nhydro, nscalars, wl, wr,
+                                     cons);
+          // scratch of adjacent tiles may overlap
+          if (t + 1 < faces_x1.NumTiles()) {
+            member.team_barrier();
+          }
+        }
+
+        // First part of the fused update (including the register weights).
+        // Condition is uniform across the team so the barrier is safe.
+        if (fused_update && k >= kb.s && k <= kb.e && j >= jb.s && j <= jb.e) {
+          member.team_barrier();
+          const auto &coords = cons_in.GetCoords(b);
+          for (auto v = 0; v < nvars; ++v) {
+            if (!cons.IsAllocated(v)) continue;
+            parthenon::par_for_inner(member, ib.s, ib.e, [&](const int i) {
+              cons(v, k, j, i) =
+                  gam0 * cons(v, k, j, i) +
+                  (gam1 != 0.0 ? gam1 * u1_cons_in(b, v, k, j, i) : 0.0) +
+                  beta_dt * FluxDivDir<X1DIR>(v, k, j, i, coords, cons);
+            });
+          }
         }
       });
 
   //--------------------------------------------------------------------------------------
   // j-direction
-  if (pmb->pmy_mesh->ndim >= 2) {
+#if ATHENAPK_NDIM != 1
+  if (params.ndim >= 2) {
     scratch_size_in_bytes =
-        parthenon::ScratchPad2D<Real>::shmem_size(num_scratch_vars, nx1) * 3;
+        parthenon::ScratchPad2D<ScratchReal>::shmem_size(num_scratch_vars, nx1) * 3;
     // set the loop limits
     il = ib.s - 1, iu = ib.e + 1, kl = kb.s, ku = kb.e;
-    if (pmb->block_size.nx(X3DIR) == 1) // 2D
+    if (split) // interior pencils only
+      il = ib.s, iu = ib.e;
+    else if (pmb->block_size.nx(X3DIR) == 1) // 2D
       kl = kb.s, ku = kb.e;
     else // 3D
       kl = kb.s - 1, ku = kb.e + 1;
 
+    // number of tiles in the sweep (j) direction and of tiles of (up to tile_x2) pencils
+    // in the transverse (k) direction
+    const SweepFaces faces_x2(jb.s, jb.e + 1, nghost, region, tile_s);
+    const int ntiles_s = faces_x2.NumTiles();
+    // (with a single pencil in the transverse direction in 2D)
+    const int tile_x2 = std::min(tile_t, ku - kl + 1);
+    const int ntiles_t = (ku - kl + tile_x2) / tile_x2;
+
     parthenon::par_for_outer(
-        DEFAULT_OUTER_LOOP_PATTERN, "x2 flux", DevExecSpace(), scratch_size_in_bytes,
-        scratch_level, 0, cons_in.GetDim(5) - 1, kl, ku,
-        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k) {
+        DEFAULT_OUTER_LOOP_PATTERN, "Hydro::CalculateFluxes::X2", DevExecSpace(),
+        scratch_size_in_bytes * tile_x2, scratch_level, 0, cons_in.GetDim(5) - 1, 0,
+        ntiles_t - 1, 0, ntiles_s - 1,
+        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int kt,
+                      const int jt) {
           const auto &prim = prim_in(b);
           auto &cons = cons_in(b);
-          parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wlb(member.team_scratch(scratch_level),
-                                            num_scratch_vars, nx1);
-          for (int j = jb.s - 1; j <= jb.e + 1; ++j) {
-            // reconstruct L/R states at j
-            Reconstruct<recon, X2DIR>(member, k, j, il, iu, prim, wlb, wr);
+          // pencils [k0, k0 + nk) of this tile
+          const int k0 = kl + kt * tile_x2;
+          const int nk = std::min(tile_x2, ku - k0 + 1);
+          parthenon::ScratchPad2D<ScratchReal> wl[max_flux_tile_transverse],
+              wr[max_flux_tile_transverse], wlb[max_flux_tile_transverse];
+          for (int n = 0; n < nk; n++) {
+            wl[n] = parthenon::ScratchPad2D<ScratchReal>(
+                member.team_scratch(scratch_level), num_scratch_vars, nx1);
+            wr[n] = parthenon::ScratchPad2D<ScratchReal>(
+                member.team_scratch(scratch_level), num_scratch_vars, nx1);
+            wlb[n] = parthenon::ScratchPad2D<ScratchReal>(
+                member.team_scratch(scratch_level), num_scratch_vars, nx1);
+          }
+          // faces [js, je] of the pencils in this tile
+          int js, je;
+          faces_x2.GetTile(jt, js, je);
+          for (int j = js - 1; j <= je; ++j) {
+            // reconstruct L/R states at j of all pencils of the tile so that a single
+            // barrier covers the tile
+            for (int n = 0; n < nk; n++) {
+              const int k = k0 + n;
+              const bool smooth =
+                  hybrid && SmoothPencil<X2DIR>(member, k, j, il, iu, troubled_in(b));
+              ReconstructVars<recon, recon_scalars, X2DIR>(member, k, j, il, iu, prim,
+                                                           wlb[n], wr[n], nhydro,
+                                                           nscalars, smooth, sparse);
+            }
             // Sync all threads in the team so that scratch memory is consistent
             member.team_barrier();
 
-            if (j > jb.s - 1) {
-              riemann.Solve(member, k, j, il, iu, IV2, wl, wr, cons, eos, c_h);
+            if (j > js - 1) {
+              for (int n = 0; n < nk; n++) {
+                riemann.Solve(member, k0 + n, j, il, iu, IV2, wl[n], wr[n], cons, eos,
+                              c_h);
+              }
               member.team_barrier();
 
               // Passive scalar fluxes
-              for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-                parthenon::par_for_inner(member, il, iu, [&](const int i) {
-                  if (cons.flux(IV2, IDN, k, j, i) >= 0.0) {
-                    cons.flux(IV2, n, k, j, i) = cons.flux(IV2, IDN, k, j, i) * wl(n, i);
-                  } else {
-                    cons.flux(IV2, n, k, j, i) = cons.flux(IV2, IDN, k, j, i) * wr(n, i);
-                  }
-                });
+              for (int n = 0; n < nk; n++) {
+                PassiveScalarFluxes<X2DIR>(member, k0 + n, j, il, iu, nhydro, nscalars,
+                                           wl[n], wr[n], cons);
               }
               member.team_barrier();
+
+              // The fluxes on both faces of cell j - 1 are now available.
+              if (fused_update && j - 1 >= jb.s) {
+                const auto &coords = cons_in.GetCoords(b);
+                for (int n = 0; n < nk; n++) {
+                  const int k = k0 + n;
+                  if (k < kb.s || k > kb.e) continue;
+                  for (auto v = 0; v < nvars; ++v) {
+                    if (!cons.IsAllocated(v)) continue;
+                    parthenon::par_for_inner(member, ib.s, ib.e, [&](const int i) {
+                      cons(v, k, j - 1, i) +=
+                          beta_dt * FluxDivDir<X2DIR>(v, k, j - 1, i, coords, cons);
+                    });
+                  }
+                }
+              }
             }
 
-            // swap the arrays for the next step
-            auto *tmp = wl.data();
-            wl.assign_data(wlb.data());
-            wlb.assign_data(tmp);
+            // swap the arrays for the next step, i.e., the states reconstructed at j
+            // are reused for the face j + 1
+            for (int n = 0; n < nk; n++) {
+              auto *tmp = wl[n].data();
+              wl[n].assign_data(wlb[n].data());
+              wlb[n].assign_data(tmp);
+            }
           }
         });
   }
+#endif // ATHENAPK_NDIM != 1
   //--------------------------------------------------------------------------------------
   // k-direction
-  if (pmb->pmy_mesh->ndim >= 3) {
+#if ATHENAPK_NDIM == 0 || ATHENAPK_NDIM == 3
+  if (params.ndim >= 3) {
     // set the loop limits
     il = ib.s - 1, iu = ib.e + 1, jl = jb.s - 1, ju = jb.e + 1;
+    if (split) // interior pencils only
+      il = ib.s, iu = ib.e, jl = jb.s, ju = jb.e;
+
+    // number of tiles in the sweep (k) direction and of tiles of (up to tile_x3) pencils
+    // in the transverse (j) direction
+    const SweepFaces faces_x3(kb.s, kb.e + 1, nghost, region, tile_s);
+    const int ntiles_s = faces_x3.NumTiles();
+    // (with a single pencil in the transverse direction in 2D)
+    const int tile_x3 = std::min(tile_t, ju - jl + 1);
+    const int ntiles_t = (ju - jl + tile_x3) / tile_x3;
 
     parthenon::par_for_outer(
-        DEFAULT_OUTER_LOOP_PATTERN, "x3 flux", DevExecSpace(), scratch_size_in_bytes,
-        scratch_level, 0, cons_in.GetDim(5) - 1, jl, ju,
-        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int j) {
+        DEFAULT_OUTER_LOOP_PATTERN, "Hydro::CalculateFluxes::X3", DevExecSpace(),
+        scratch_size_in_bytes * tile_x3, scratch_level, 0, cons_in.GetDim(5) - 1, 0,
+        ntiles_t - 1, 0, ntiles_s - 1,
+        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int jt,
+                      const int kt) {
           const auto &prim = prim_in(b);
           auto &cons = cons_in(b);
-          parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wlb(member.team_scratch(scratch_level),
-                                            num_scratch_vars, nx1);
-          for (int k = kb.s - 1; k <= kb.e + 1; ++k) {
-            // reconstruct L/R states at j
-            Reconstruct<recon, X3DIR>(member, k, j, il, iu, prim, wlb, wr);
+          // pencils [j0, j0 + nj) of this tile
+          const int j0 = jl + jt * tile_x3;
+          const int nj = std::min(tile_x3, ju - j0 + 1);
+          parthenon::ScratchPad2D<ScratchReal> wl[max_flux_tile_transverse],
+              wr[max_flux_tile_transverse], wlb[max_flux_tile_transverse];
+          for (int n = 0; n < nj; n++) {
+            wl[n] = parthenon::ScratchPad2D<ScratchReal>(
+                member.team_scratch(scratch_level), num_scratch_vars, nx1);
+            wr[n] = parthenon::ScratchPad2D<ScratchReal>(
+                member.team_scratch(scratch_level), num_scratch_vars, nx1);
+            wlb[n] = parthenon::ScratchPad2D<ScratchReal>(
+                member.team_scratch(scratch_level), num_scratch_vars, nx1);
+          }
+          // faces [ks, ke] of the pencils in this tile
+          int ks, ke;
+          faces_x3.GetTile(kt, ks, ke);
+          for (int k = ks - 1; k <= ke; ++k) {
+            // reconstruct L/R states at k of all pencils of the tile
+            for (int n = 0; n < nj; n++) {
+              const int j = j0 + n;
+              const bool smooth =
+                  hybrid && SmoothPencil<X3DIR>(member, k, j, il, iu, troubled_in(b));
+              ReconstructVars<recon, recon_scalars, X3DIR>(member, k, j, il, iu, prim,
+                                                           wlb[n], wr[n], nhydro,
+                                                           nscalars, smooth, sparse);
+            }
             // Sync all threads in the team so that scratch memory is consistent
             member.team_barrier();
 
-            if (k > kb.s - 1) {
-              riemann.Solve(member, k, j, il, iu, IV3, wl, wr, cons, eos, c_h);
+            if (k > ks - 1) {
+              for (int n = 0; n < nj; n++) {
+                riemann.Solve(member, k, j0 + n, il, iu, IV3, wl[n], wr[n], cons, eos,
+                              c_h);
+              }
               member.team_barrier();
 
               // Passive scalar fluxes
-              for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-                parthenon::par_for_inner(member, il, iu, [&](const int i) {
-                  if (cons.flux(IV3, IDN, k, j, i) >= 0.0) {
-                    cons.flux(IV3, n, k, j, i) = cons.flux(IV3, IDN, k, j, i) * wl(n, i);
-                  } else {
-                    cons.flux(IV3, n, k, j, i) = cons.flux(IV3, IDN, k, j, i) * wr(n, i);
-                  }
-                });
+              for (int n = 0; n < nj; n++) {
+                PassiveScalarFluxes<X3DIR>(member, k, j0 + n, il, iu, nhydro, nscalars,
+                                           wl[n], wr[n], cons);
               }
               member.team_barrier();
+
+              // The fluxes on both faces of cell k - 1 are now available.
+              if (fused_update && k - 1 >= kb.s) {
+                const auto &coords = cons_in.GetCoords(b);
+                for (int n = 0; n < nj; n++) {
+                  const int j = j0 + n;
+                  if (j < jb.s || j > jb.e) continue;
+                  for (auto v = 0; v < nvars; ++v) {
+                    if (!cons.IsAllocated(v)) continue;
+                    parthenon::par_for_inner(member, ib.s, ib.e, [&](const int i) {
+                      cons(v, k - 1, j, i) +=
+                          beta_dt * FluxDivDir<X3DIR>(v, k - 1, j, i, coords, cons);
+                    });
+                  }
+                }
+              }
             }
             // swap the arrays for the next step
-            auto *tmp = wl.data();
-            wl.assign_data(wlb.data());
-            wlb.assign_data(tmp);
+            for (int n = 0; n < nj; n++) {
+              auto *tmp = wl[n].data();
+              wl[n].assign_data(wlb[n].data());
+              wlb[n].assign_data(tmp);
+            }
           }
         });
   }
+#endif // ATHENAPK_NDIM == 0 || ATHENAPK_NDIM == 3
 
+  // Diffusive fluxes (depending on ghost cells) are added with the rim, i.e., after all
+  // hyperbolic fluxes are available.
   const auto &diffint = pkg->Param<DiffInt>("diffint");
-  if (diffint == DiffInt::unsplit) {
-    CalcDiffFluxes(pkg.get(), md.get());
+  if (diffint == DiffInt::unsplit && region != BlockRegion::interior) {
+    CalcDiffFluxes(pkg.get(), md.get(), false, BlockRegion::all, 0);
   }
 
   return TaskStatus::complete;
@@ -1241,10 +2614,14 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
 // However, this'd require an additional register to store the initial state and
 // we should first evaluate where the tradeoff between extra computational costs
 // (multiple calls) versus extra memory usage is.
-template <Fluid fluid>
+// Only the first check goes over the entire mesh. Cells requiring correction are
+// compacted into a work list and subsequent attempts only recheck the corrected cells
+// and their neighbors (as those share the corrected fluxes).
+template <Fluid fluid, typename EOS, int NDIM>
 TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_data,
                                  const Real gam0_, const Real gam1_,
                                  const Real beta_dt_) {
+  utils::profiling::ScopedRegion region("Hydro::FirstOrderFluxCorrect");
   // Work around for CUDA <=11.6
   const Real gam0 = gam0_;
   const Real gam1 = gam1_;
@@ -1255,15 +2632,12 @@ TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_dat
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
 
-  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
-  auto u0_cons_pack = u0_data->PackVariablesAndFluxes(flags_ind);
-  auto const &u0_prim_pack = u0_data->PackVariables(std::vector<std::string>{"prim"});
-  auto u1_cons_pack = u1_data->PackVariablesAndFluxes(flags_ind);
   auto pkg = pmb->packages.Get("Hydro");
+  auto u0_cons_pack = pack_cache::ConsAndFluxes(u0_data);
+  auto const u0_prim_pack = pack_cache::Prim(u0_data);
+  auto u1_cons_pack = pack_cache::ConsAndFluxes(u1_data);
 
-  const auto &eos =
-      pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
-                                           AdiabaticGLMMHDEOS>::type>("eos");
+  const auto &eos = pkg->Param<EOS>("eos");
 
   // Hyperbolic divergence cleaning speed for GLM MHD
   Real c_h = 0.0;
@@ -1271,82 +2645,153 @@ TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_dat
     c_h = pkg->Param<Real>("c_h");
   }
 
-  const int ndim = pmb->pmy_mesh->ndim;
+  constexpr int ndim = NDIM;
 
   constexpr auto NVAR = GetNVars<fluid>();
 
   auto riemann = Riemann<fluid, RiemannSolver::llf>();
 
+  // Returns true if the cell (k, j, i) of block b is expected to end up with a negative
+  // density or pressure given the current fluxes.
+  // In principle, the u_cons.fluxes could be updated in parallel by a
+  // different thread resulting in a race conditon here. However, if the
+  // fluxes of a cell have been updated (anywhere) then the cell will
+  // be checked again anyway, and, at that point the already fixed
+  // u0_cons.fluxes will automaticlly be used here.
+  auto needs_correction = KOKKOS_LAMBDA(const int b, const int k, const int j,
+                                        const int i, bool &only_pressure) {
+    const auto &coords = u0_cons_pack.GetCoords(b);
+    auto &u0_cons = u0_cons_pack(b);
+    Real new_cons[NVAR];
+    for (auto v = 0; v < NVAR; v++) {
+      new_cons[v] =
+          gam0 * u0_cons(v, k, j, i) +
+          (gam1 != 0.0 ? gam1 * u1_cons_pack(b, v, k, j, i) : 0.0) +
+          beta_dt * parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, u0_cons);
+    }
+
+    // no need to include gamma - 1 as we only care for negative values
+    auto new_p = new_cons[IEN] -
+                 0.5 * (SQR(new_cons[IM1]) + SQR(new_cons[IM2]) + SQR(new_cons[IM3])) /
+                     new_cons[IDN];
+    if constexpr (fluid == Fluid::glmmhd) {
+      new_p -= 0.5 * (SQR(new_cons[IB1]) + SQR(new_cons[IB2]) + SQR(new_cons[IB3]));
+    }
+    only_pressure = new_cons[IDN] > 0.0;
+    return !(new_cons[IDN] > 0.0 && new_p > 0.0);
+  };
+
+  // Replaces all fluxes of cell (k, j, i) of block b with first order LLF fluxes.
+  // In principle, there could be a racecondion as we're updating fluxes shared with
+  // neighboring cells here. However, the results are idential because u0_prim is
+  // never updated in this function so we don't worry about it.
+  // TODO(pgrete) as we need to keep the function signature idential for now
+  // (due to Cuda compiler bug) we could potentially template these function
+  // and get rid of the `if constexpr`
+  auto correct_fluxes = KOKKOS_LAMBDA(const int b, const int k, const int j,
+                                      const int i) {
+    const auto &u0_prim = u0_prim_pack(b);
+    auto &u0_cons = u0_cons_pack(b);
+    riemann.Solve(eos, k, j, i, IV1, u0_prim, u0_cons, c_h);
+    riemann.Solve(eos, k, j, i + 1, IV1, u0_prim, u0_cons, c_h);
+
+    if (HasDim(ndim, 2)) {
+      riemann.Solve(eos, k, j, i, IV2, u0_prim, u0_cons, c_h);
+      riemann.Solve(eos, k, j + 1, i, IV2, u0_prim, u0_cons, c_h);
+    }
+    if (HasDim(ndim, 3)) {
+      riemann.Solve(eos, k, j, i, IV3, u0_prim, u0_cons, c_h);
+      riemann.Solve(eos, k + 1, j, i, IV3, u0_prim, u0_cons, c_h);
+    }
+  };
+
+  // Full mesh check. This is the only kernel in the (typical) case that no
+  // correction is required.
+  std::int64_t num_bad = 0;
+  Kokkos::parallel_reduce(
+      "Hydro::FirstOrderFluxCorrect::Check",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {u0_cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                    std::int64_t &lnum_bad) {
+        bool only_pressure;
+        if (needs_correction(b, k, j, i, only_pressure)) {
+          lnum_bad += 1;
+        }
+      },
+      Kokkos::Sum<std::int64_t>(num_bad));
+
+  if (num_bad == 0) {
+    return TaskStatus::complete;
+  }
+
+  // Cells are stored by their flattened (b, k, j, i) index in the pack.
+  const std::int64_t nx1 = u0_cons_pack.GetDim(1);
+  const std::int64_t nx2 = u0_cons_pack.GetDim(2);
+  const std::int64_t nx3 = u0_cons_pack.GetDim(3);
+  auto flat_idx = KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+    return ((b * nx3 + k) * nx2 + j) * nx1 + i;
+  };
+
+  parthenon::ParArray1D<std::int64_t> work_list("FirstOrderFluxCorrect work list",
+                                                 num_bad);
+  Kokkos::View<std::int64_t, parthenon::DevMemSpace> num_entries(
+      "FirstOrderFluxCorrect num entries");
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Hydro::FirstOrderFluxCorrect::Compact", DevExecSpace(), 0,
+      u0_cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        bool only_pressure;
+        if (needs_correction(b, k, j, i, only_pressure)) {
+          const auto n = Kokkos::atomic_fetch_add(&num_entries(), 1);
+          // Guard is just for safety as the check is deterministic.
+          if (n < num_bad) {
+            work_list(n) = flat_idx(b, k, j, i);
+          }
+        }
+      });
+
   std::int64_t num_corrected, num_need_floor;
   // Potentially need multiple attempts as flux correction corrects 6 (in 3D) fluxes
   // of a single cell at the same time. So the neighboring cells need to be rechecked with
   // the corrected fluxes as the corrected fluxes in one cell may result in the need to
   // correct all the fluxes of an originally "good" neighboring cell.
   size_t num_attempts = 0;
+  std::int64_t num_work = num_bad;
   do {
     num_corrected = 0;
+    num_need_floor = 0;
+    parthenon::ParArray1D<bool> corrected("FirstOrderFluxCorrect corrected", num_work);
 
     Kokkos::parallel_reduce(
-        "FirstOrderFluxCorrect",
-        Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-            DevExecSpace(), {0, kb.s, jb.s, ib.s},
-            {u0_cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-            {1, 1, 1, ib.e + 1 - ib.s}),
-        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
-                      std::int64_t &lnum_corrected, std::int64_t &lnum_need_floor) {
-          const auto &coords = u0_cons_pack.GetCoords(b);
-          const auto &u0_prim = u0_prim_pack(b);
-          auto &u0_cons = u0_cons_pack(b);
-
-          // In principle, the u_cons.fluxes could be updated in parallel by a
-          // different thread resulting in a race conditon here. However, if the
-          // fluxes of a cell have been updated (anywhere) then the entire kernel will
-          // be called again anyway, and, at that point the already fixed
-          // u0_cons.fluxes will automaticlly be used here.
-          Real new_cons[NVAR];
-          for (auto v = 0; v < NVAR; v++) {
-            new_cons[v] =
-                gam0 * u0_cons(v, k, j, i) + gam1 * u1_cons_pack(b, v, k, j, i) +
-                beta_dt *
-                    parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, u0_cons);
-          }
-
-          // no need to include gamma - 1 as we only care for negative values
-          auto new_p =
-              new_cons[IEN] -
-              0.5 * (SQR(new_cons[IM1]) + SQR(new_cons[IM2]) + SQR(new_cons[IM3])) /
-                  new_cons[IDN];
-          if constexpr (fluid == Fluid::glmmhd) {
-            new_p -= 0.5 * (SQR(new_cons[IB1]) + SQR(new_cons[IB2]) + SQR(new_cons[IB3]));
-          }
+        "Hydro::FirstOrderFluxCorrect::Correct",
+        Kokkos::RangePolicy<>(DevExecSpace(), 0, num_work),
+        KOKKOS_LAMBDA(const std::int64_t n, std::int64_t &lnum_corrected,
+                      std::int64_t &lnum_need_floor) {
+          auto idx = work_list(n);
+          const int i = idx % nx1;
+          idx /= nx1;
+          const int j = idx % nx2;
+          idx /= nx2;
+          const int k = idx % nx3;
+          const int b = idx / nx3;
+          corrected(n) = false;
+
+          bool only_pressure;
           // no correction required
-          if (new_cons[IDN] > 0.0 && new_p > 0.0) {
+          if (!needs_correction(b, k, j, i, only_pressure)) {
             return;
           }
           // if already tried 3 times and only pressure is negative, then we'll rely
           // on the pressure floor during ConsToPrim conversion
-          if (num_attempts > 2 && new_cons[IDN] > 0.0 && new_p < 0.0) {
+          if (num_attempts > 2 && only_pressure) {
             lnum_need_floor += 1;
             return;
           }
-          // In principle, there could be a racecondion as this loop goes over all
-          // k,j,i and we updating the i+1 flux here. However, the results are
-          // idential because u0_prim is never updated in this kernel so we don't
-          // worry about it.
-          // TODO(pgrete) as we need to keep the function signature idential for now
-          // (due to Cuda compiler bug) we could potentially template these function
-          // and get rid of the `if constexpr`
-          riemann.Solve(eos, k, j, i, IV1, u0_prim, u0_cons, c_h);
-          riemann.Solve(eos, k, j, i + 1, IV1, u0_prim, u0_cons, c_h);
-
-          if (ndim >= 2) {
-            riemann.Solve(eos, k, j, i, IV2, u0_prim, u0_cons, c_h);
-            riemann.Solve(eos, k, j + 1, i, IV2, u0_prim, u0_cons, c_h);
-          }
-          if (ndim >= 3) {
-            riemann.Solve(eos, k, j, i, IV3, u0_prim, u0_cons, c_h);
-            riemann.Solve(eos, k + 1, j, i, IV3, u0_prim, u0_cons, c_h);
-          }
+          correct_fluxes(b, k, j, i);
+          corrected(n) = true;
           lnum_corrected += 1;
         },
         Kokkos::Sum<std::int64_t>(num_corrected),
@@ -1357,6 +2802,52 @@ TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_dat
     //           << " Corrected (center): " << num_corrected
     //           << " Failed (will rely on floor): " << num_need_floor << std::endl;
     num_attempts += 1;
+
+    if (num_corrected > 0 && num_attempts < 4) {
+      // Corrected cells and their (interior) face neighbors need to be rechecked.
+      // Duplicates are fine as rechecking (and correcting) a cell is idempotent.
+      parthenon::ParArray1D<std::int64_t> next_work_list(
+          "FirstOrderFluxCorrect work list", (2 * ndim + 1) * num_corrected);
+      Kokkos::deep_copy(num_entries, 0);
+      const auto prev_work_list = work_list;
+      Kokkos::parallel_for(
+          "Hydro::FirstOrderFluxCorrect::Neighbors",
+          Kokkos::RangePolicy<>(DevExecSpace(), 0, num_work),
+          KOKKOS_LAMBDA(const std::int64_t n) {
+            if (!corrected(n)) {
+              return;
+            }
+            auto idx = prev_work_list(n);
+            const int i = idx % nx1;
+            idx /= nx1;
+            const int j = idx % nx2;
+            idx /= nx2;
+            const int k = idx % nx3;
+            const int b = idx / nx3;
+            auto add = [&](const int kk, const int jj, const int ii) {
+              if (kk >= kb.s && kk <= kb.e && jj >= jb.s && jj <= jb.e && ii >= ib.s &&
+                  ii <= ib.e) {
+                next_work_list(Kokkos::atomic_fetch_add(&num_entries(), 1)) =
+                    flat_idx(b, kk, jj, ii);
+              }
+            };
+            add(k, j, i);
+            add(k, j, i - 1);
+            add(k, j, i + 1);
+            if (HasDim(ndim, 2)) {
+              add(k, j - 1, i);
+              add(k, j + 1, i);
+            }
+            if (HasDim(ndim, 3)) {
+              add(k - 1, j, i);
+              add(k + 1, j, i);
+            }
+          });
+      auto num_entries_h =
+          Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), num_entries);
+      num_work = num_entries_h();
+      work_list = next_work_list;
+    }
   } while (num_corrected > 0 && num_attempts < 4);
 
   return TaskStatus::complete;
@@ -6,10 +6,16 @@
 // Licensed under the BSD 3-Clause License (the "LICENSE").
 //========================================================================================
 
+// C++ headers
+#include <type_traits>
+
 // Parthenon headers
 #include <parthenon/package.hpp>
 
+#include "../eos/adiabatic_glmmhd.hpp"
 #include "../eos/adiabatic_hydro.hpp"
+// Generated in the build directory, see src/CMakeLists.txt
+#include "hydro/flux_configs.hpp"
 
 using namespace parthenon::package::prelude;
 
@@ -17,46 +23,166 @@ namespace Hydro {
 
 parthenon::Packages_t ProcessPackages(std::unique_ptr<ParameterInput> &pin);
 void PreStepMeshUserWorkInLoop(Mesh *pmesh, ParameterInput *pin, parthenon::SimTime &tm);
+// Completes the asynchronous snapshots (see utils/snapshot.hpp) before any output and
+// calls ProblemUserMeshWorkBeforeOutput
+void UserMeshWorkBeforeOutput(Mesh *pmesh, ParameterInput *pin,
+                              const parthenon::SimTime &tm);
 std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin);
 
+// EOS of the fluid by default. The hyperbolic paths of hydro (fluid=euler) are
+// additionally templated on the general EOS (see tabulated_hydro.hpp).
 template <Fluid fluid>
+using FluidEOS = typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
+                                           AdiabaticGLMMHDEOS>::type;
+
+template <Fluid fluid, typename EOS = FluidEOS<fluid>>
 Real EstimateTimestep(MeshData<Real> *md);
+// Minimum (over all cells) of the hyperbolic cell crossing time, i.e., the timestep
+// without cfl
+template <Fluid fluid, typename EOS = FluidEOS<fluid>>
+Real MinCellCrossingTime(MeshData<Real> *md);
 
 using parthenon::SimTime;
 TaskStatus AddUnsplitSources(MeshData<Real> *md, const SimTime &tm, const Real beta_dt);
 TaskStatus AddSplitSourcesFirstOrder(MeshData<Real> *md, const SimTime &tm);
 TaskStatus AddSplitSourcesStrang(MeshData<Real> *md, const SimTime &tm);
+// Sets the cost of the blocks for load balancing from the measured work of the cycle
+TaskStatus SetLoadBalancingCosts(MeshData<Real> *md);
 
 using SourceFun_t =
     std::function<void(MeshData<Real> *md, const SimTime &tm, const Real dt)>;
 using EstimateTimestepFun_t = std::function<Real(MeshData<Real> *md)>;
+// Optionally replaces the conversion to primitive variables of md (e.g., to fuse clips
+// into the conversion) and returns whether it did so. Only sets the minimum hyperbolic
+// timestep (see EquationOfState::ConservedToPrimitiveAndTimestep) if with_dt_hyp is true.
+using ConsToPrimFun_t =
+    std::function<bool(MeshData<Real> *md, const bool with_dt_hyp, Real &dt_hyp)>;
+using MeshUserWorkFun_t =
+    std::function<void(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)>;
 
 extern SourceFun_t ProblemSourceFirstOrder;
 extern SourceFun_t ProblemSourceUnsplit;
 extern SourceFun_t ProblemSourceStrangSplit;
 extern EstimateTimestepFun_t ProblemEstimateTimestep;
+extern ConsToPrimFun_t ProblemConsToPrim;
+// Fills derived output fields, called before Parthenon outputs and snapshots
+extern MeshUserWorkFun_t ProblemUserMeshWorkBeforeOutput;
+// Called at the beginning of every cycle (after the global reductions of the previous
+// cycle are completed), e.g., for in-situ analysis of the state at the cycle start
+extern MeshUserWorkFun_t ProblemPreStepMeshUserWork;
 extern InitPackageDataFun_t ProblemInitPackageData;
 extern std::function<AmrTag(MeshBlockData<Real> *mbd)> ProblemCheckRefinementBlock;
-
-template <Fluid fluid>
-TaskStatus CalculateFluxesTight(std::shared_ptr<MeshData<Real>> &md);
-template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
-TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md);
+// Preferred over the per block version as all blocks of a pack are processed at once
+extern std::function<void(MeshData<Real> *md, parthenon::ParArray1D<AmrTag> &amr_tags)>
+    ProblemCheckRefinementMesh;
+
+// Flux functions optionally fuse the flux divergence update
+// u0 = gam0 * u0 + gam1 * u1 + beta_dt * div(F)
+// into the flux kernels if u1_data is not a nullptr (only valid without coarse/fine flux
+// correction and without first order flux correction).
+// With a region other than BlockRegion::all, only the fluxes required for the update of
+// the interior cells are calculated, either the ones that do not depend on ghost cells
+// (interior) or the remaining ones within nghost faces of the block faces (rim).
+template <Fluid fluid, typename EOS = FluidEOS<fluid>>
+TaskStatus CalculateFluxesTight(std::shared_ptr<MeshData<Real>> &md,
+                                MeshData<Real> *u1_data, const Real gam0,
+                                const Real gam1, const Real beta_dt,
+                                const BlockRegion region);
+// The passive scalars are reconstructed with recon_scalars (default: same as hydro).
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver,
+          Reconstruction recon_scalars = recon, typename EOS = FluidEOS<fluid>>
+TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md, MeshData<Real> *u1_data,
+                           const Real gam0, const Real gam1, const Real beta_dt,
+                           const BlockRegion region);
 using FluxFun_t =
     decltype(CalculateFluxes<Fluid::euler, Reconstruction::dc, RiemannSolver::hlle>);
 
-template <Fluid fluid>
+// Specialized on the number of dimensions NDIM, see DispatchNDim
+template <Fluid fluid, typename EOS = FluidEOS<fluid>, int NDIM = 3>
 TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_data,
                                  const Real gam0, const Real gam1, const Real beta_dt);
 using FirstOrderFluxCorrectFun_t = decltype(FirstOrderFluxCorrect<Fluid::glmmhd>);
 
-using FluxFunKey_t = std::tuple<Fluid, Reconstruction, RiemannSolver>;
+// fluid, reconstruction (hydro variables), Riemann solver, and reconstruction (scalars)
+using FluxFunKey_t = std::tuple<Fluid, Reconstruction, RiemannSolver, Reconstruction>;
 
-// Add flux function pointer to map containing all compiled in flux functions
+// Whether the flux functions of the combination are compiled in, i.e., all supported
+// ones by default or only the ones listed in the AthenaPK_FLUX_CONFIGS CMake option
 template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+constexpr bool FluxConfigEnabled() {
+  if (!flux_configs_restricted) {
+    return true;
+  }
+  for (const auto &config : flux_configs) {
+    if (config.fluid == fluid && config.recon == recon && config.rsolver == rsolver) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Whether the X2DIR (d = 2) or X3DIR (d = 3) direction exists. A compile time constant in
+// builds specialized for a number of dimensions (see the AthenaPK_NDIM CMake option).
+KOKKOS_FORCEINLINE_FUNCTION
+constexpr bool HasDim(const int ndim, const int d) {
+  return (compiled_ndim > 0 ? compiled_ndim : ndim) >= d;
+}
+
+// Calls f(std::integral_constant<int, NDIM>()) with NDIM being ndim (or the compiled in
+// number of dimensions, see the AthenaPK_NDIM CMake option) so that the kernels launched
+// by f can be specialized on the number of dimensions. Kernels (device lambdas) must be
+// defined in a named function called by f rather than in f itself.
+template <typename F>
+auto DispatchNDim(const int ndim, const F &f) {
+  if constexpr (compiled_ndim > 0) {
+    return f(std::integral_constant<int, compiled_ndim>());
+  } else {
+    if (ndim == 1) {
+      return f(std::integral_constant<int, 1>());
+    } else if (ndim == 2) {
+      return f(std::integral_constant<int, 2>());
+    }
+    return f(std::integral_constant<int, 3>());
+  }
+}
+
+// Add flux function pointer to map containing all compiled in flux functions.
+// In addition to the same reconstruction for all variables, variants using the cheaper
+// DC and PLM reconstruction for the passive scalars are added.
+// Combinations that are not compiled in (see FluxConfigEnabled) are skipped.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver,
+          typename EOS = FluidEOS<fluid>>
 void add_flux_fun(std::map<FluxFunKey_t, FluxFun_t *> &flux_functions) {
-  flux_functions[std::make_tuple(fluid, recon, rsolver)] =
-      Hydro::CalculateFluxes<fluid, recon, rsolver>;
+  if constexpr (FluxConfigEnabled<fluid, recon, rsolver>()) {
+    flux_functions[std::make_tuple(fluid, recon, rsolver, recon)] =
+        Hydro::CalculateFluxes<fluid, recon, rsolver, recon, EOS>;
+    if constexpr (recon != Reconstruction::dc) {
+      flux_functions[std::make_tuple(fluid, recon, rsolver, Reconstruction::dc)] =
+          Hydro::CalculateFluxes<fluid, recon, rsolver, Reconstruction::dc, EOS>;
+    }
+    if constexpr (recon != Reconstruction::dc && recon != Reconstruction::plm) {
+      flux_functions[std::make_tuple(fluid, recon, rsolver, Reconstruction::plm)] =
+          Hydro::CalculateFluxes<fluid, recon, rsolver, Reconstruction::plm, EOS>;
+    }
+    // First order variant for the predictor stage of vl2 (if not listed itself)
+    if constexpr (flux_configs_restricted && recon != Reconstruction::dc) {
+      flux_functions[std::make_tuple(fluid, Reconstruction::dc, rsolver,
+                                     Reconstruction::dc)] =
+          Hydro::CalculateFluxes<fluid, Reconstruction::dc, rsolver, Reconstruction::dc,
+                                 EOS>;
+    }
+  }
+}
+
+// Add the first order LLF flux function (implemented as tight loop), which is compiled
+// in if the fluid:dc:llf combination is
+template <Fluid fluid, typename EOS = FluidEOS<fluid>>
+void add_tight_flux_fun(std::map<FluxFunKey_t, FluxFun_t *> &flux_functions) {
+  if constexpr (FluxConfigEnabled<fluid, Reconstruction::dc, RiemannSolver::llf>()) {
+    flux_functions[std::make_tuple(fluid, Reconstruction::dc, RiemannSolver::llf,
+                                   Reconstruction::dc)] =
+        Hydro::CalculateFluxesTight<fluid, EOS>;
+  }
 }
 
 // Get number of "fluid" variable used
@@ -4,7 +4,9 @@
 // Licensed under the BSD 3-Clause License (the "LICENSE").
 //========================================================================================
 
+#include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -22,77 +24,416 @@
 #include "../pgen/cluster/agn_triggering.hpp"
 #include "../pgen/cluster/magnetic_tower.hpp"
 #include "../tracers/tracers.hpp"
+#include "../utils/failure_counter.hpp"
+#include "../utils/global_reductions.hpp"
+#include "../utils/rank_metrics.hpp"
+#include "autotune.hpp"
 #include "diffusion/diffusion.hpp"
 #include "glmmhd/glmmhd.hpp"
 #include "hydro.hpp"
 #include "hydro_driver.hpp"
+#include "kernel_benchmark.hpp"
+#include "memory_report.hpp"
+#include "pack_cache.hpp"
+#include "srcterms/tabular_cooling.hpp"
 
 using namespace parthenon::driver::prelude;
 
 namespace Hydro {
 
 HydroDriver::HydroDriver(ParameterInput *pin, ApplicationInput *app_in, Mesh *pm)
-    : MultiStageDriver(pin, app_in, pm) {
+    : MultiStageDriver(pin, app_in, pm), timers_(pm->packages.Get("Hydro").get()),
+      stage_graphs_(pm->packages.Get("Hydro").get()) {
   // fail if these are not specified in the input file
   pin->CheckRequired("hydro", "eos");
 
   // warn if these fields aren't specified in the input file
   pin->CheckDesired("parthenon/time", "cfl");
+
+  auto hydro_pkg = pm->packages.Get("Hydro");
+  PARTHENON_REQUIRE_THROWS(!(hydro_pkg->Param<bool>("fused_update") && pm->multilevel),
+                           "hydro/fused_update requires a mesh without coarse/fine "
+                           "flux correction, i.e., no static or adaptive refinement.");
+  PARTHENON_REQUIRE_THROWS(!(hydro_pkg->Param<bool>("step_retry") &&
+                             pm->packages.Get("tracers")->Param<bool>("enabled")),
+                           "hydro/step_retry is incompatible with tracers as the tracer "
+                           "particles are not restored when retrying a step.");
+  PARTHENON_REQUIRE_THROWS(!(hydro_pkg->Param<bool>("step_retry") &&
+                             hydro_pkg->Param<bool>("async_dt_reduction")),
+                           "hydro/step_retry is incompatible with "
+                           "hydro/async_dt_reduction as the timestep reduction started "
+                           "in a failed step would still be in flight when retrying it.");
+
+  // Replace the coefficients of Parthenon's rk3, i.e., SSPRK(3,3), by many-stage SSP
+  // integrators in the same low-storage form
+  //   u0 = gam0 * u0 + gam1 * u1 + beta * dt * L(u0)
+  // with u1 holding the state at the beginning of the cycle (optionally updated to
+  // u1 = u1_gam0 * u0 + u1_gam1 * u1 at the end of a stage). Their larger SSP
+  // coefficients (the hyperbolic timestep is scaled accordingly, see Hydro::Initialize)
+  // result in fewer cycles, and thus fewer timestep reductions and ghost cell exchanges,
+  // per simulated time. Stages with gam1 = 0 do not access u1.
+  const auto hydro_integrator = hydro_pkg->Param<Integrator>("integrator");
+  if (hydro_integrator == Integrator::ssprk43) {
+    // SSPRK(4,3) of Spiteri & Ruuth 2002 with SSP coefficient 2
+    integrator->gam0 = {1.0, 1.0, 1.0 / 3.0, 1.0};
+    integrator->gam1 = {0.0, 0.0, 2.0 / 3.0, 0.0};
+    integrator->beta = {0.5, 0.5, 1.0 / 6.0, 0.5};
+  } else if (hydro_integrator == Integrator::ssprk104) {
+    // Low-storage SSPRK(10,4) of Ketcheson 2008 with SSP coefficient 6. Its
+    // intermediate register q2 = 1/25 u^n + 9/25 u^(5) (stored in u1 after the fifth
+    // stage) is expressed in terms of the result of the fifth stage in Shu-Osher form.
+    integrator->gam0 = {1.0, 1.0, 1.0, 1.0, 0.4, 1.0, 1.0, 1.0, 1.0, 0.6};
+    integrator->gam1 = {0.0, 0.0, 0.0, 0.0, 0.6, 0.0, 0.0, 0.0, 0.0, 1.0};
+    integrator->beta = {1.0 / 6.0, 1.0 / 6.0, 1.0 / 6.0,  1.0 / 6.0, 1.0 / 15.0,
+                        1.0 / 6.0, 1.0 / 6.0, 1.0 / 6.0,  1.0 / 6.0, 0.1};
+    u1_gam0_ = {0.0, 0.0, 0.0, 0.0, 0.9, 0.0, 0.0, 0.0, 0.0, 0.0};
+    u1_gam1_ = {1.0, 1.0, 1.0, 1.0, -0.5, 1.0, 1.0, 1.0, 1.0, 1.0};
+  }
+  if (hydro_integrator == Integrator::ssprk43 ||
+      hydro_integrator == Integrator::ssprk104) {
+    integrator->nstages = integrator->beta.size();
+    integrator->delta = std::vector<Real>(integrator->nstages, 0.0);
+    integrator->delta[0] = 1.0;
+    integrator->stage_name = {"base"};
+    for (int s = 1; s <= integrator->nstages; s++) {
+      integrator->stage_name.push_back(std::to_string(s));
+    }
+  }
+
+  if (hydro_pkg->Param<bool>("memory_report")) {
+    ReportMemoryFootprint(pm, "at startup");
+    memory_report_nbnew_ = pm->nbnew;
+    memory_report_nbdel_ = pm->nbdel;
+  }
+  if (hydro_pkg->Param<bool>("autotune")) {
+    AutotuneFluxKernels(pm);
+  }
+  if (hydro_pkg->Param<bool>("kernel_benchmark")) {
+    BenchmarkKernels(pm);
+  }
+  // Kokkos may reallocate the level 1 scratch space (that recorded kernels would still
+  // use) for kernels requesting more, so graphs are restricted to level 0 (incl. the
+  // level selected by the autotuning).
+  PARTHENON_REQUIRE_THROWS(!stage_graphs_.IsEnabled() ||
+                               hydro_pkg->Param<int>("scratch_level") == 0,
+                           "hydro/graph_capture requires hydro/scratch_level=0.");
 }
 
-// Sets all fluxes to 0
-TaskStatus ResetFluxes(MeshData<Real> *md) {
-  auto pmb = md->GetBlockData(0)->GetBlockPointer();
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+void HydroDriver::PostExecute(parthenon::DriverStatus status) {
+  MultiStageDriver::PostExecute(status);
+  timers_.ReportRoofline();
+}
 
-  // In principle, we'd only need to pack Metadata::WithFluxes here, but
-  // choosing to mirror other use in the code so that the packs are already cached.
-  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
-  auto cons_pack = md->PackVariablesAndFluxes(flags_ind);
+TaskListStatus HydroDriver::Step() {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  TaskListStatus status;
+  if (!hydro_pkg->Param<bool>("hst_rank_metrics")) {
+    status = StepWithRetries();
+  } else {
+    // Zones before the step as remeshing happens after the step
+    const auto zones = static_cast<Real>(pmesh->GetNumberOfMeshBlockCells()) *
+                       static_cast<Real>(pmesh->block_list.size());
+    Kokkos::Timer timer;
+    status = StepWithRetries();
+    // Attribute all kernels of the step to the step
+    Kokkos::fence();
+    hydro_pkg->MutableParam<utils::RankMetrics>("rank_metrics")
+        ->AddStep(timer.seconds(), zones);
+  }
+  // The cached crossing times belong to the MeshData of this step. Remeshing (after the
+  // step) may replace them, so the timestep estimates following it must not find any.
+  if (hydro_pkg->Param<bool>("fused_dt_hyp")) {
+    hydro_pkg->MutableParam<std::map<MeshData<Real> *, Real>>("fused_dt_hyp_cache")
+        ->clear();
+  }
+  return status;
+}
 
-  const int ndim = pmb->pmy_mesh->ndim;
-  // Using separate loops for each dim as the launch overhead should be hidden
-  // by enough work over the entire pack and it allows to not use any conditionals.
+TaskListStatus HydroDriver::StepWithRetries() {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  if (!hydro_pkg->Param<bool>("step_retry")) {
+    return MultiStageDriver::Step();
+  }
+  const auto &failures = hydro_pkg->Param<utils::FailureCounter>("step_retry_failures");
+  const auto max_attempts = hydro_pkg->Param<int>("step_retry_max_attempts");
+  const auto dt_factor = hydro_pkg->Param<Real>("step_retry_dt_factor");
+
+  // Variables of the base register (including the primitive variables) at the beginning
+  // of the step. OneCopy variables are shared between registers and are not restored,
+  // which requires that they are derived from the state (or static). The cooling
+  // subcycles accumulated for the load balancing are restored so that failed attempts are
+  // not counted. Problem generators with other OneCopy or Params state advanced in each
+  // step (turbulence driving and cluster) reject hydro/step_retry.
+  std::map<int, Real> lb_cooling_substeps;
+  auto copy_state = [this, &hydro_pkg, &lb_cooling_substeps](const bool save) {
+    for (auto &pmb : pmesh->block_list) {
+      auto &base = pmb->meshblock_data.Get();
+      // This is a noop if the register already exists (i.e., not a new block).
+      pmb->meshblock_data.Add("step_retry", base);
+      auto &saved = pmb->meshblock_data.Get("step_retry");
+      for (const auto &var : base->GetVariableVector()) {
+        if (var->IsSet(Metadata::OneCopy)) {
+          continue;
+        }
+        auto &saved_data = saved->Get(var->label()).data;
+        if (save) {
+          saved_data.DeepCopy(var->data);
+        } else {
+          var->data.DeepCopy(saved_data);
+        }
+      }
+    }
+    auto *substeps = hydro_pkg->MutableParam<std::map<int, Real>>("lb_cooling_substeps");
+    if (save) {
+      lb_cooling_substeps = *substeps;
+    } else {
+      *substeps = lb_cooling_substeps;
+    }
+  };
+  copy_state(true);
+
+  for (int attempt = 0;; attempt++) {
+    failures.Reset();
+    const auto status = MultiStageDriver::Step();
+    int num_failures = failures.Get();
+#ifdef MPI_PARALLEL
+    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &num_failures, 1, MPI_INT, MPI_SUM,
+                                      MPI_COMM_WORLD));
+#endif
+    if (status != TaskListStatus::complete || num_failures == 0) {
+      return status;
+    }
+    PARTHENON_REQUIRE_THROWS(attempt < max_attempts,
+                             "Step of cycle " + std::to_string(tm.ncycle) +
+                                 " failed in " + std::to_string(num_failures) +
+                                 " cells after " + std::to_string(max_attempts) +
+                                 " retries, see hydro/step_retry_max_attempts.");
+    copy_state(false);
+    if (parthenon::Globals::my_rank == 0) {
+      std::cout << "Retrying step of cycle " << tm.ncycle << " (" << num_failures
+                << " failed cells) with dt = " << tm.dt * dt_factor << " (previously "
+                << tm.dt << ")" << std::endl;
+    }
+    tm.dt *= dt_factor;
+    *hydro_pkg->MutableParam<int>("step_retries") += 1;
+  }
+}
+
+// Intermediate register update u1 = u1_gam0 * u0 + u1_gam1 * u1 (of the interior cells,
+// which are the only ones used in the stage updates) of low-storage integrators
+TaskStatus UpdateStageRegister(MeshData<Real> *u0_data, MeshData<Real> *u1_data,
+                               const Real u1_gam0_, const Real u1_gam1_) {
+  // Work around for CUDA <=11.6
+  const Real u1_gam0 = u1_gam0_;
+  const Real u1_gam1 = u1_gam1_;
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  const auto &u0_pack = u0_data->PackVariables(flags_ind);
+  auto u1_pack = u1_data->PackVariables(flags_ind);
+  IndexRange ib = u0_data->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = u0_data->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = u0_data->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "ResetFluxes X1", parthenon::DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, 0, cons_pack.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e + 1,
+      DEFAULT_LOOP_PATTERN, "UpdateStageRegister", parthenon::DevExecSpace(), 0,
+      u0_pack.GetDim(5) - 1, 0, u0_pack.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e,
       KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
-        auto &cons = cons_pack(b);
-        cons.flux(X1DIR, v, k, j, i) = 0.0;
+        if (!u0_pack.IsAllocated(b, v)) {
+          return;
+        }
+        u1_pack(b, v, k, j, i) =
+            u1_gam0 * u0_pack(b, v, k, j, i) + u1_gam1 * u1_pack(b, v, k, j, i);
       });
+  return TaskStatus::complete;
+}
+
+// Number of RKL stages for a stable integration over tau given the diffusive timestep
+int RKLStages(const Real tau, const Real dt_diff, const bool rkl1) {
+  if (rkl1) {
+    // from the RKL1 stability limit tau <= dt_diff * (s^2 + s) / 2
+    return static_cast<int>(0.5 * (std::sqrt(1.0 + 8.0 * tau / dt_diff) - 1.0)) + 1;
+  }
+  // eq (21)
+  int s_rkl = static_cast<int>(0.5 * (std::sqrt(9.0 + 16.0 * tau / dt_diff) - 1.0)) + 1;
+  // ensure odd number of stages
+  if (s_rkl % 2 == 0) s_rkl += 1;
+  return s_rkl;
+}
+
+// Meyer+2014 w1, which is the only coefficient of the recursion depending on s_rkl (as a
+// prefactor of all mu_tilde and gamma_tilde). Used to rescale the coefficients for blocks
+// with their own number of stages.
+KOKKOS_INLINE_FUNCTION Real RKLW1(const int s_rkl, const bool rkl1) {
+  const Real s = static_cast<Real>(s_rkl);
+  return rkl1 ? 2. / (s * s + s) : 4. / (s * s + s - 2.);
+}
 
-  if (ndim < 2) {
-    return TaskStatus::complete;
+// Number of stages of each block (with <diffusion/sts_local_stages>) from the diffusive
+// timestep of the block itself, which is limited to the global count s_rkl.
+TaskStatus SetBlockSTSStages(MeshData<Real> *md, const Real tau, const int s_rkl,
+                             const bool rkl1) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  // Entry has been created (serially) when the task list was constructed.
+  auto block_stages =
+      hydro_pkg->Param<std::map<MeshData<Real> *, parthenon::ParArray1D<int>>>(
+                   "sts_block_stages")
+          .at(md);
+  auto block_stages_h = Kokkos::create_mirror_view(block_stages);
+  for (int b = 0; b < md->NumBlocks(); b++) {
+    auto dt_diff = std::numeric_limits<Real>::max();
+    if (hydro_pkg->Param<Conduction>("conduction") != Conduction::none) {
+      dt_diff = std::min(dt_diff, EstimateConductionTimestep(md, b));
+    }
+    if (hydro_pkg->Param<Viscosity>("viscosity") != Viscosity::none) {
+      dt_diff = std::min(dt_diff, EstimateViscosityTimestep(md, b));
+    }
+    if (hydro_pkg->Param<Resistivity>("resistivity") != Resistivity::none) {
+      dt_diff = std::min(dt_diff, EstimateResistivityTimestep(md, b));
+    }
+    block_stages_h(b) = std::min(s_rkl, RKLStages(tau, dt_diff, rkl1));
   }
+  Kokkos::deep_copy(block_stages, block_stages_h);
+  return TaskStatus::complete;
+}
+
+// With <diffusion/sts_local_stages>, blocks with different numbers of stages integrate
+// different stability polynomials so that the diffusive fluxes through a face between
+// them differ. As each stage is a linear combination of previous stages (with weights
+// summing to one) and flux divergences, the state of a block after stage j is
+//   Y_j = Y_0 + tau * div(G_j), G_j = mu_j G_jm1 + nu_j G_jm2 + mu_tilde_j F_jm1 +
+//                                     gamma_tilde_j F_0 (G_0 = 0)
+// with the face fluxes F_jm1 of stage j. G_j is accumulated here for the faces of the
+// block boundary (stored in the adjacent cells of "sts_face_flux", with G_jm2 and F_0 in
+// "sts_face_flux_hist") so that the side with fewer stages can be corrected to the
+// accumulated flux of its neighbor at the end of the super timestep, see
+// CorrectSTSFaceFluxes. The first stage (j = 1, using mu_j = nu_j = gamma_tilde_j = 0)
+// also stores the number of stages of the block.
+TaskStatus AccumulateSTSFaceFluxes(MeshData<Real> *md, const int stage, const bool rkl1,
+                                   const int s_rkl, const Real mu_j, const Real nu_j,
+                                   const Real mu_tilde_j, const Real gamma_tilde_j) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  const int ndim = pmb->pmy_mesh->ndim;
+  const int nhydro = pmb->packages.Get("Hydro")->Param<int>("nhydro");
+
+  const auto cons = pack_cache::ConsAndFluxes(md);
+  auto face_flux = md->PackVariables(std::vector<std::string>{"sts_face_flux"});
+  auto hist = md->PackVariables(std::vector<std::string>{"sts_face_flux_hist"});
+  const BlockRim cells(md, BlockRegion::all, stage);
+  const Real w1 = RKLW1(s_rkl, rkl1);
+  const int nface = ndim * nhydro;
+
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "ResetFluxes X2", parthenon::DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, 0, cons_pack.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e + 1,
-      ib.s, ib.e,
+      DEFAULT_LOOP_PATTERN, "Diffusion::RKL::AccumulateFaceFluxes",
+      parthenon::DevExecSpace(), 0, cons.GetDim(5) - 1, 0, nhydro - 1, kb.s, kb.e, jb.s,
+      jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
-        auto &cons = cons_pack(b);
-        cons.flux(X2DIR, v, k, j, i) = 0.0;
+        if (!cells.ContainsBlock(b)) {
+          return;
+        }
+        const Real w1_scale = RKLW1(cells.block_stages(b), rkl1) / w1;
+        const int idx[3] = {i, j, k};
+        const int start[3] = {ib.s, jb.s, kb.s};
+        const int end[3] = {ib.e, jb.e, kb.e};
+        for (int d = 0; d < ndim; d++) {
+          if (idx[d] != start[d] && idx[d] != end[d]) {
+            continue;
+          }
+          // Index of the face on the block boundary (lower or upper face of the cell)
+          const int off = idx[d] == end[d] ? 1 : 0;
+          const Real F = cons(b).flux(X1DIR + d, v, k + (d == 2) * off,
+                                      j + (d == 1) * off, i + (d == 0) * off);
+          const int n = d * nhydro + v;
+          if (stage == 1) {
+            hist(b, n, k, j, i) = 0.0;
+            hist(b, nface + n, k, j, i) = F;
+            face_flux(b, n, k, j, i) = w1_scale * mu_tilde_j * F;
+            if (v == 0) {
+              face_flux(b, nface, k, j, i) = cells.block_stages(b);
+            }
+          } else {
+            const Real G = mu_j * face_flux(b, n, k, j, i) + nu_j * hist(b, n, k, j, i) +
+                           w1_scale * (mu_tilde_j * F +
+                                       gamma_tilde_j * hist(b, nface + n, k, j, i));
+            hist(b, n, k, j, i) = face_flux(b, n, k, j, i);
+            face_flux(b, n, k, j, i) = G;
+          }
+        }
       });
+  return TaskStatus::complete;
+}
 
-  if (ndim < 3) {
-    return TaskStatus::complete;
+// Replaces the accumulated flux G (see AccumulateSTSFaceFluxes) through each face between
+// two blocks by the one of the neighbor if the neighbor took more stages (as read from
+// the exchanged ghost cells of "sts_face_flux") so that the super timestep is
+// conservative. Faces on physical boundaries are not corrected.
+TaskStatus CorrectSTSFaceFluxes(MeshData<Real> *md, const Real tau) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  const int ndim = pmb->pmy_mesh->ndim;
+  const int nhydro = pmb->packages.Get("Hydro")->Param<int>("nhydro");
+
+  // Faces of each block that are shared with another block (incl. periodic boundaries)
+  parthenon::ParArray2D<bool> block_faces("sts_block_faces", md->NumBlocks(), 6);
+  auto block_faces_h = Kokkos::create_mirror_view(block_faces);
+  for (int b = 0; b < md->NumBlocks(); b++) {
+    const auto &flags = md->GetBlockData(b)->GetBlockPointer()->boundary_flag;
+    for (int f = 0; f < 6; f++) {
+      block_faces_h(b, f) = flags[f] == parthenon::BoundaryFlag::block ||
+                            flags[f] == parthenon::BoundaryFlag::periodic;
+    }
   }
+  Kokkos::deep_copy(block_faces, block_faces_h);
+
+  auto cons = pack_cache::Cons(md);
+  const auto face_flux = md->PackVariables(std::vector<std::string>{"sts_face_flux"});
+  const int nface = ndim * nhydro;
+
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "ResetFluxes X3", parthenon::DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, 0, cons_pack.GetDim(4) - 1, kb.s, kb.e + 1, jb.s, jb.e,
-      ib.s, ib.e,
+      DEFAULT_LOOP_PATTERN, "Diffusion::RKL::CorrectFaceFluxes",
+      parthenon::DevExecSpace(), 0, cons.GetDim(5) - 1, 0, nhydro - 1, kb.s, kb.e, jb.s,
+      jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
-        auto &cons = cons_pack(b);
-        cons.flux(X3DIR, v, k, j, i) = 0.0;
+        const auto &coords = cons.GetCoords(b);
+        const int idx[3] = {i, j, k};
+        const int start[3] = {ib.s, jb.s, kb.s};
+        const int end[3] = {ib.e, jb.e, kb.e};
+        const Real stages = face_flux(b, nface, k, j, i);
+        Real dcons = 0.0;
+        for (int d = 0; d < ndim; d++) {
+          for (int upper = 0; upper <= 1; upper++) {
+            if (idx[d] != (upper ? end[d] : start[d]) || !block_faces(b, 2 * d + upper)) {
+              continue;
+            }
+            // Neighboring (ghost) cell and the face shared with it
+            const int sgn = upper ? 1 : -1;
+            const int kn = k + (d == 2) * sgn, jn = j + (d == 1) * sgn,
+                      ni = i + (d == 0) * sgn;
+            if (face_flux(b, nface, kn, jn, ni) <= stages) {
+              continue;
+            }
+            const int kface = k + (d == 2) * upper, jface = j + (d == 1) * upper,
+                      iface = i + (d == 0) * upper;
+            const Real area = d == 0   ? coords.FaceArea<X1DIR>(kface, jface, iface)
+                              : d == 1 ? coords.FaceArea<X2DIR>(kface, jface, iface)
+                                       : coords.FaceArea<X3DIR>(kface, jface, iface);
+            const int n = d * nhydro + v;
+            dcons -= sgn * area *
+                     (face_flux(b, n, kn, jn, ni) - face_flux(b, n, k, j, i));
+          }
+        }
+        cons(b, v, k, j, i) += tau * dcons / coords.CellVolume(k, j, i);
       });
   return TaskStatus::complete;
 }
 
+template <int NDIM>
 TaskStatus RKL2StepFirst(MeshData<Real> *md_Y0, MeshData<Real> *md_Yjm1,
                          MeshData<Real> *md_Yjm2, MeshData<Real> *md_MY0, const int s_rkl,
-                         const Real tau) {
+                         const Real tau, const BlockRegion region, const int stage) {
   auto pmb = md_Y0->GetBlockData(0)->GetBlockPointer();
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
@@ -105,30 +446,49 @@ TaskStatus RKL2StepFirst(MeshData<Real> *md_Y0, MeshData<Real> *md_Yjm1,
 
   // In principle, we'd only need to pack Metadata::WithFluxes here, but
   // choosing to mirror other use in the code so that the packs are already cached.
-  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
-  auto Y0 = md_Y0->PackVariablesAndFluxes(flags_ind);
-  auto Yjm1 = md_Yjm1->PackVariablesAndFluxes(flags_ind);
-  auto Yjm2 = md_Yjm2->PackVariablesAndFluxes(flags_ind);
-  auto MY0 = md_MY0->PackVariablesAndFluxes(flags_ind);
+  auto Y0 = pack_cache::IndependentAndFluxes(md_Y0);
+  auto Yjm1 = pack_cache::IndependentAndFluxes(md_Yjm1);
+  auto Yjm2 = pack_cache::IndependentAndFluxes(md_Yjm2);
+  auto MY0 = pack_cache::IndependentAndFluxes(md_MY0);
 
-  // Using separate loops for each dim as the launch overhead should be hidden
-  // by enough work over the entire pack and it allows to not use any conditionals.
+  const Real w1 = RKLW1(s_rkl, false);
+
+  constexpr int ndim = NDIM;
+  const BlockRim cells(md_Yjm1, region, stage);
+  // The flux divergence of Y0 (whose fluxes are stored in Yjm1 as nothing has been
+  // updated yet) is directly calculated here rather than in a separate kernel.
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "RKL first step", parthenon::DevExecSpace(), 0,
+      DEFAULT_LOOP_PATTERN, "Diffusion::RKL2::FirstStep", parthenon::DevExecSpace(), 0,
       Y0.GetDim(5) - 1, 0, Y0.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
+        if (!cells.ContainsBlock(b) || !cells.ContainsCell(k, j, i) ||
+            !Y0.IsAllocated(b, v)) {
+          return;
+        }
+        const Real w1_scale = stage > 0 ? RKLW1(cells.block_stages(b), false) / w1 : 1.0;
+        const auto &coords = Yjm1.GetCoords(b);
+        const Real MY0_ =
+            parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, Yjm1(b));
+        MY0(b, v, k, j, i) = MY0_;
         Yjm1(b, v, k, j, i) =
-            Y0(b, v, k, j, i) + mu_tilde_1 * tau * MY0(b, v, k, j, i); // Y_1
-        Yjm2(b, v, k, j, i) = Y0(b, v, k, j, i);                       // Y_0
+            Y0(b, v, k, j, i) + w1_scale * mu_tilde_1 * tau * MY0_; // Y_1
+        Yjm2(b, v, k, j, i) = Y0(b, v, k, j, i);                          // Y_0
       });
 
+  // The block boundary is part of the rim (or of all cells)
+  if (stage > 0 && region != BlockRegion::interior) {
+    AccumulateSTSFaceFluxes(md_Yjm1, stage, false, s_rkl, 0.0, 0.0, mu_tilde_1, 0.0);
+  }
+
   return TaskStatus::complete;
 }
 
+template <int NDIM>
 TaskStatus RKL2StepOther(MeshData<Real> *md_Y0, MeshData<Real> *md_Yjm1,
                          MeshData<Real> *md_Yjm2, MeshData<Real> *md_MY0, const Real mu_j,
                          const Real nu_j, const Real mu_tilde_j, const Real gamma_tilde_j,
-                         const Real tau) {
+                         const Real tau, const BlockRegion region, const int stage,
+                         const int s_rkl) {
   auto pmb = md_Y0->GetBlockData(0)->GetBlockPointer();
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
@@ -136,49 +496,165 @@ TaskStatus RKL2StepOther(MeshData<Real> *md_Y0, MeshData<Real> *md_Yjm1,
 
   // In principle, we'd only need to pack Metadata::WithFluxes here, but
   // choosing to mirror other use in the code so that the packs are already cached.
-  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
-  auto Y0 = md_Y0->PackVariablesAndFluxes(flags_ind);
-  auto Yjm1 = md_Yjm1->PackVariablesAndFluxes(flags_ind);
-  auto Yjm2 = md_Yjm2->PackVariablesAndFluxes(flags_ind);
-  auto MY0 = md_MY0->PackVariablesAndFluxes(flags_ind);
+  auto Y0 = pack_cache::IndependentAndFluxes(md_Y0);
+  auto Yjm1 = pack_cache::IndependentAndFluxes(md_Yjm1);
+  auto Yjm2 = pack_cache::IndependentAndFluxes(md_Yjm2);
+  auto MY0 = pack_cache::IndependentAndFluxes(md_MY0);
 
-  const int ndim = pmb->pmy_mesh->ndim;
+  const Real w1 = RKLW1(s_rkl, false);
+
+  constexpr int ndim = NDIM;
+  const BlockRim cells(md_Yjm1, region, stage);
   // Using separate loops for each dim as the launch overhead should be hidden
   // by enough work over the entire pack and it allows to not use any conditionals.
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "RKL other step", parthenon::DevExecSpace(), 0,
+      DEFAULT_LOOP_PATTERN, "Diffusion::RKL2::OtherStep", parthenon::DevExecSpace(), 0,
       Y0.GetDim(5) - 1, 0, Y0.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
+        if (!cells.ContainsBlock(b) || !cells.ContainsCell(k, j, i) ||
+            !Y0.IsAllocated(b, v)) {
+          return;
+        }
+        const Real w1_scale = stage > 0 ? RKLW1(cells.block_stages(b), false) / w1 : 1.0;
         // First calc this step
         const auto &coords = Yjm1.GetCoords(b);
         const Real MYjm1 =
             parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, Yjm1(b));
         const Real Yj = mu_j * Yjm1(b, v, k, j, i) + nu_j * Yjm2(b, v, k, j, i) +
                         (1.0 - mu_j - nu_j) * Y0(b, v, k, j, i) +
-                        mu_tilde_j * tau * MYjm1 +
-                        gamma_tilde_j * tau * MY0(b, v, k, j, i);
+                        w1_scale * mu_tilde_j * tau * MYjm1 +
+                        w1_scale * gamma_tilde_j * tau * MY0(b, v, k, j, i);
         // Then shuffle vars for next step
         Yjm2(b, v, k, j, i) = Yjm1(b, v, k, j, i);
         Yjm1(b, v, k, j, i) = Yj;
       });
 
+  if (stage > 0 && region != BlockRegion::interior) {
+    AccumulateSTSFaceFluxes(md_Yjm1, stage, false, s_rkl, mu_j, nu_j, mu_tilde_j,
+                            gamma_tilde_j);
+  }
+
+  return TaskStatus::complete;
+}
+
+// Low storage RKL1 variant that only requires the Yjm1 (here "base") and Yjm2
+// registers, i.e., neither a copy of the initial state Y0 nor its flux divergence MY0.
+template <int NDIM>
+TaskStatus RKL1StepFirst(MeshData<Real> *md_Yjm1, MeshData<Real> *md_Yjm2,
+                         const int s_rkl, const Real tau, const BlockRegion region,
+                         const int stage) {
+  auto pmb = md_Yjm1->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+
+  // Compute coefficients. RKL1 scheme in Meyer+2014 Sec. 2
+  const Real mu_tilde_1 = 2. / (static_cast<Real>(s_rkl) * static_cast<Real>(s_rkl) +
+                                static_cast<Real>(s_rkl));
+
+  auto Yjm1 = pack_cache::IndependentAndFluxes(md_Yjm1);
+  auto Yjm2 = pack_cache::IndependentAndFluxes(md_Yjm2);
+
+  constexpr int ndim = NDIM;
+  const BlockRim cells(md_Yjm1, region, stage);
+  // Updating Yjm1 in place is safe as the flux divergence only depends on the fluxes.
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Diffusion::RKL1::FirstStep", parthenon::DevExecSpace(), 0,
+      Yjm1.GetDim(5) - 1, 0, Yjm1.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
+        if (!cells.ContainsBlock(b) || !cells.ContainsCell(k, j, i) ||
+            !Yjm1.IsAllocated(b, v)) {
+          return;
+        }
+        // mu_tilde_1 = w1
+        const Real mu_tilde_1_b =
+            stage > 0 ? RKLW1(cells.block_stages(b), true) : mu_tilde_1;
+        const auto &coords = Yjm1.GetCoords(b);
+        const Real MY0 =
+            parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, Yjm1(b));
+        Yjm2(b, v, k, j, i) = Yjm1(b, v, k, j, i);                            // Y_0
+        Yjm1(b, v, k, j, i) = Yjm1(b, v, k, j, i) + mu_tilde_1_b * tau * MY0; // Y_1
+      });
+
+  if (stage > 0 && region != BlockRegion::interior) {
+    AccumulateSTSFaceFluxes(md_Yjm1, stage, true, s_rkl, 0.0, 0.0, mu_tilde_1, 0.0);
+  }
+
+  return TaskStatus::complete;
+}
+
+template <int NDIM>
+TaskStatus RKL1StepOther(MeshData<Real> *md_Yjm1, MeshData<Real> *md_Yjm2,
+                         const Real mu_j, const Real nu_j, const Real mu_tilde_j,
+                         const Real tau, const BlockRegion region, const int stage,
+                         const int s_rkl) {
+  auto pmb = md_Yjm1->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+
+  auto Yjm1 = pack_cache::IndependentAndFluxes(md_Yjm1);
+  auto Yjm2 = pack_cache::IndependentAndFluxes(md_Yjm2);
+
+  const Real w1 = RKLW1(s_rkl, true);
+
+  constexpr int ndim = NDIM;
+  const BlockRim cells(md_Yjm1, region, stage);
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Diffusion::RKL1::OtherStep", parthenon::DevExecSpace(), 0,
+      Yjm1.GetDim(5) - 1, 0, Yjm1.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
+        if (!cells.ContainsBlock(b) || !cells.ContainsCell(k, j, i) ||
+            !Yjm1.IsAllocated(b, v)) {
+          return;
+        }
+        const Real w1_scale = stage > 0 ? RKLW1(cells.block_stages(b), true) / w1 : 1.0;
+        const auto &coords = Yjm1.GetCoords(b);
+        const Real MYjm1 =
+            parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, Yjm1(b));
+        const Real Yj = mu_j * Yjm1(b, v, k, j, i) + nu_j * Yjm2(b, v, k, j, i) +
+                        w1_scale * mu_tilde_j * tau * MYjm1;
+        Yjm2(b, v, k, j, i) = Yjm1(b, v, k, j, i);
+        Yjm1(b, v, k, j, i) = Yj;
+      });
+
+  if (stage > 0 && region != BlockRegion::interior) {
+    AccumulateSTSFaceFluxes(md_Yjm1, stage, true, s_rkl, mu_j, nu_j, mu_tilde_j, 0.0);
+  }
+
   return TaskStatus::complete;
 }
 
 // Assumes that prim and cons are in sync initially.
 // Guarantees that prim and cons are in sync at the end.
 void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
-                 const Real tau) {
+                 const Real tau, TaskTimers *timers) {
 
   auto hydro_pkg = blocks[0]->packages.Get("Hydro");
   auto mindt_diff = hydro_pkg->Param<Real>("dt_diff");
+  const bool rkl1 = hydro_pkg->Param<DiffInt>("diffint") == DiffInt::rkl1;
+  // With overlap, the rim of each block (see BlockRim) is updated and sent first and the
+  // remaining interior is updated while the ghost cell exchange is in flight.
+  const bool overlap = hydro_pkg->Param<bool>("sts_overlap_comm");
+  const auto first_region = overlap ? BlockRegion::rim : BlockRegion::all;
+  // With local stages, each block only takes the number of stages required by its own
+  // diffusive timestep and is skipped in later stages.
+  const bool local_stages = hydro_pkg->Param<bool>("sts_local_stages");
 
   // get number of RKL steps
-  // eq (21) using half hyperbolic timestep due to Strang split
-  int s_rkl =
-      static_cast<int>(0.5 * (std::sqrt(9.0 + 16.0 * tau / mindt_diff) - 1.0)) + 1;
-  // ensure odd number of stages
-  if (s_rkl % 2 == 0) s_rkl += 1;
+  // (already using half hyperbolic timestep due to Strang split)
+  const int s_rkl = RKLStages(tau, mindt_diff, rkl1);
+  // Stage passed to the tasks, i.e., 0 to update all blocks in all stages
+  const auto task_stage = [&](const int stage) { return local_stages ? stage : 0; };
+  // Steps specialized on the number of dimensions
+  const auto rkl1_step_first = DispatchNDim(
+      pmesh->ndim, [](auto dim) { return RKL1StepFirst<decltype(dim)::value>; });
+  const auto rkl1_step_other = DispatchNDim(
+      pmesh->ndim, [](auto dim) { return RKL1StepOther<decltype(dim)::value>; });
+  const auto rkl2_step_first = DispatchNDim(
+      pmesh->ndim, [](auto dim) { return RKL2StepFirst<decltype(dim)::value>; });
+  const auto rkl2_step_other = DispatchNDim(
+      pmesh->ndim, [](auto dim) { return RKL2StepOther<decltype(dim)::value>; });
 
   if (parthenon::Globals::my_rank == 0) {
     const auto ratio = 2.0 * tau / mindt_diff;
@@ -190,21 +666,27 @@ void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
 
   TaskID none(0);
 
+  // Variables modified by the RKL steps. Only those need to be exchanged between stages.
+  // Primitive variables are recovered via FillDerived on the full "base" container.
+  const std::vector<std::string> sts_exchange_vars = {"cons"};
+
   // Store initial u0 in u1 as "base" will continuously be updated but initial state Y0 is
-  // required for each stage.
-  TaskRegion &region_copy_out = ptask_coll->AddRegion(blocks.size());
-  for (int i = 0; i < blocks.size(); i++) {
-    auto &tl = region_copy_out[i];
-    auto &Y0 = blocks[i]->meshblock_data.Get("u1");
-    auto &base = blocks[i]->meshblock_data.Get();
-    tl.AddTask(
-        none,
-        [](MeshBlockData<Real> *dst, MeshBlockData<Real> *src) {
-          dst->Get("cons").data.DeepCopy(src->Get("cons").data);
-          dst->Get("prim").data.DeepCopy(src->Get("prim").data);
-          return TaskStatus::complete;
-        },
-        Y0.get(), base.get());
+  // required for each stage (only in RKL2).
+  if (!rkl1) {
+    TaskRegion &region_copy_out = ptask_coll->AddRegion(blocks.size());
+    for (int i = 0; i < blocks.size(); i++) {
+      auto &tl = region_copy_out[i];
+      auto &Y0 = blocks[i]->meshblock_data.Get("u1");
+      auto &base = blocks[i]->meshblock_data.Get();
+      tl.AddTask(
+          none,
+          [](MeshBlockData<Real> *dst, MeshBlockData<Real> *src) {
+            dst->Get("cons").data.DeepCopy(src->Get("cons").data);
+            dst->Get("prim").data.DeepCopy(src->Get("prim").data);
+            return TaskStatus::complete;
+          },
+          Y0.get(), base.get());
+    }
   }
 
   TaskRegion &region_init = ptask_coll->AddRegion(blocks.size());
@@ -217,28 +699,57 @@ void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
     // time.
     // TODO(pgrete) this allocates all Variables, i.e., prim and cons vector, but only a
     // subset is actually needed. Streamline to allocate only required vars.
-    pmb->meshblock_data.Add("MY0", base);
+    if (!rkl1) {
+      pmb->meshblock_data.Add("MY0", base);
+    }
     pmb->meshblock_data.Add("Yjm2", base);
+    // Shallow container (sharing data with "base") that only holds the variables updated
+    // by the RKL steps so that ghost cells of other (e.g., problem specific) variables
+    // are not exchanged in every stage.
+    pmb->meshblock_data.AddShallow("sts_exchange", base, sts_exchange_vars);
+    if (local_stages) {
+      // Accumulated fluxes through the block boundary exchanged at the end of the step
+      pmb->meshblock_data.AddShallow("sts_face_flux", base,
+                                     std::vector<std::string>{"sts_face_flux"});
+    }
   }
 
   const int num_partitions = pmesh->DefaultNumPartitions();
+  if (local_stages) {
+    // Create the entries here as the map should not be modified in (concurrent) tasks.
+    auto *block_stages =
+        hydro_pkg->MutableParam<std::map<MeshData<Real> *, parthenon::ParArray1D<int>>>(
+            "sts_block_stages");
+    TaskRegion &region_block_stages = ptask_coll->AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+      auto &base = pmesh->mesh_data.GetOrAdd("base", i);
+      auto &stages = (*block_stages)[base.get()];
+      if (stages.extent_int(0) != base->NumBlocks()) {
+        stages = parthenon::ParArray1D<int>("sts_block_stages", base->NumBlocks());
+      }
+      region_block_stages[i].AddTask(none, SetBlockSTSStages, base.get(), tau, s_rkl,
+                                     rkl1);
+    }
+  }
+
   TaskRegion &region_calc_fluxes_step_init = ptask_coll->AddRegion(num_partitions);
   for (int i = 0; i < num_partitions; i++) {
     auto &tl = region_calc_fluxes_step_init[i];
     auto &base = pmesh->mesh_data.GetOrAdd("base", i);
+    auto &exchange = pmesh->mesh_data.GetOrAdd("sts_exchange", i);
     const auto any = parthenon::BoundaryType::any;
-    auto start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, base);
+    auto start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, exchange);
     auto start_flxcor_recv =
         tl.AddTask(none, parthenon::StartReceiveFluxCorrections, base);
 
-    // Reset flux arrays (not guaranteed to be zero)
-    auto reset_fluxes = tl.AddTask(none, ResetFluxes, base.get());
-
     // Calculate the diffusive fluxes for Y0 (here still "base" as nothing has been
     // updated yet) so that we can store the result as MY0 and reuse later
-    // (in every subsetp).
+    // (in every subsetp, only in RKL2).
+    // Fluxes are overwritten (rather than added) as the flux arrays still contain the
+    // hyperbolic fluxes, so no separate reset is required.
     auto hydro_diff_fluxes =
-        tl.AddTask(reset_fluxes, CalcDiffFluxes, hydro_pkg.get(), base.get());
+        tl.AddTask(none, timers->Wrap(TimedTask::sts_diff_fluxes, CalcDiffFluxes),
+                   hydro_pkg.get(), base.get(), true, first_region, task_stage(1));
 
     auto send_flx =
         tl.AddTask(hydro_diff_fluxes, parthenon::LoadAndSendFluxCorrections, base);
@@ -247,29 +758,49 @@ void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
     auto set_flx =
         tl.AddTask(recv_flx | hydro_diff_fluxes, parthenon::SetFluxCorrections, base);
 
-    auto &Y0 = pmesh->mesh_data.GetOrAdd("u1", i);
-    auto &MY0 = pmesh->mesh_data.GetOrAdd("MY0", i);
     auto &Yjm2 = pmesh->mesh_data.GetOrAdd("Yjm2", i);
 
-    auto init_MY0 = tl.AddTask(set_flx, parthenon::Update::FluxDivergence<MeshData<Real>>,
-                               base.get(), MY0.get());
-
     // Initialize Y0 and Y1 and the recursion relation starting with j = 2 needs data from
     // the two preceeding stages.
-    auto rkl2_step_first = tl.AddTask(init_MY0, RKL2StepFirst, Y0.get(), base.get(),
-                                      Yjm2.get(), MY0.get(), s_rkl, tau);
+    auto add_step_first = [&](const TaskID &dep, const BlockRegion region) {
+      if (rkl1) {
+        return tl.AddTask(dep, timers->Wrap(TimedTask::sts_step, rkl1_step_first),
+                          base.get(), Yjm2.get(), s_rkl, tau, region, task_stage(1));
+      }
+      auto &Y0 = pmesh->mesh_data.GetOrAdd("u1", i);
+      auto &MY0 = pmesh->mesh_data.GetOrAdd("MY0", i);
+      // MY0 is calculated within the first step
+      return tl.AddTask(dep, timers->Wrap(TimedTask::sts_step, rkl2_step_first), Y0.get(),
+                        base.get(), Yjm2.get(), MY0.get(), s_rkl, tau, region,
+                        task_stage(1));
+    };
+    auto rkl_step_first = add_step_first(set_flx, first_region);
 
     // Update ghost cells of Y1 (as MY1 is calculated for each Y_j).
-    // Y1 stored in "base", see rkl2_step_first task.
+    // Y1 stored in "base", see rkl_step_first task.
     // Update ghost cells (local and non local), prolongate and apply bound cond.
     // TODO(someone) experiment with split (local/nonlocal) comms with respect to
     // performance for various tests (static, amr, block sizes) and then decide on the
     // best impl. Go with default call (split local/nonlocal) for now.
-    // TODO(pgrete) optimize (in parthenon) to only send subset of updated vars
-    auto bounds_exchange = parthenon::AddBoundaryExchangeTasks(
-        rkl2_step_first | start_bnd, tl, base, pmesh->multilevel);
+    auto bounds_exchange =
+        timers->AddBoundaryExchangeTasks(TimedTask::sts_boundary_exchange,
+                                         rkl_step_first | start_bnd, tl, exchange,
+                                         pmesh->multilevel);
+
+    if (overlap) {
+      // Added after the exchange tasks so that the rim is sent before the interior is
+      // processed (while the receiving is pending).
+      auto interior_diff_fluxes = tl.AddTask(
+          rkl_step_first, timers->Wrap(TimedTask::sts_diff_fluxes, CalcDiffFluxes),
+          hydro_pkg.get(), base.get(), true, BlockRegion::interior, task_stage(1));
+      auto interior_step_first =
+          add_step_first(interior_diff_fluxes, BlockRegion::interior);
+      bounds_exchange = bounds_exchange | interior_step_first;
+    }
 
-    tl.AddTask(bounds_exchange, parthenon::Update::FillDerived<MeshData<Real>>,
+    tl.AddTask(bounds_exchange,
+               timers->Wrap(TimedTask::fill_derived,
+                            parthenon::Update::FillDerived<MeshData<Real>>),
                base.get());
   }
 
@@ -277,38 +808,48 @@ void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
   Real b_j = 1. / 3.;
   Real b_jm1 = 1. / 3.;
   Real b_jm2 = 1. / 3.;
-  Real w1 = 4. / (static_cast<Real>(s_rkl) * static_cast<Real>(s_rkl) +
-                  static_cast<Real>(s_rkl) - 2.);
+  // and Meyer+2014 Sec. 2 for RKL1
+  Real w1 = rkl1 ? 2. / (static_cast<Real>(s_rkl) * static_cast<Real>(s_rkl) +
+                         static_cast<Real>(s_rkl))
+                 : 4. / (static_cast<Real>(s_rkl) * static_cast<Real>(s_rkl) +
+                         static_cast<Real>(s_rkl) - 2.);
   Real mu_j, nu_j, j, mu_tilde_j, gamma_tilde_j;
 
   // RKL loop
   for (int jj = 2; jj <= s_rkl; jj++) {
     j = static_cast<Real>(jj);
-    b_j = (j * j + j - 2.0) / (2 * j * (j + 1.0));
-    mu_j = (2.0 * j - 1.0) / j * b_j / b_jm1;
-    nu_j = -(j - 1.0) / j * b_j / b_jm2;
-    mu_tilde_j = mu_j * w1;
-    gamma_tilde_j = -(1.0 - b_jm1) * mu_tilde_j; // -a_jm1*mu_tilde_j
+    if (rkl1) {
+      mu_j = (2.0 * j - 1.0) / j;
+      nu_j = -(j - 1.0) / j;
+      mu_tilde_j = mu_j * w1;
+      gamma_tilde_j = 0.0; // unused
+    } else {
+      b_j = (j * j + j - 2.0) / (2 * j * (j + 1.0));
+      mu_j = (2.0 * j - 1.0) / j * b_j / b_jm1;
+      nu_j = -(j - 1.0) / j * b_j / b_jm2;
+      mu_tilde_j = mu_j * w1;
+      gamma_tilde_j = -(1.0 - b_jm1) * mu_tilde_j; // -a_jm1*mu_tilde_j
+    }
 
     TaskRegion &region_calc_fluxes_step_other = ptask_coll->AddRegion(num_partitions);
     for (int i = 0; i < num_partitions; i++) {
       auto &tl = region_calc_fluxes_step_other[i];
       auto &base = pmesh->mesh_data.GetOrAdd("base", i);
+      auto &exchange = pmesh->mesh_data.GetOrAdd("sts_exchange", i);
 
-      // Only need boundaries for base as it's the only "active" container exchanging
-      // data/fluxes with neighbors. All other containers are passive (i.e., data is only
-      // used but not exchanged).
+      // Only need boundaries for base (restricted to the updated variables in
+      // "sts_exchange") as it's the only "active" container exchanging data/fluxes with
+      // neighbors. All other containers are passive (i.e., data is only used but not
+      // exchanged).
       const auto any = parthenon::BoundaryType::any;
-      auto start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, base);
+      auto start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, exchange);
       auto start_flxcor_recv =
           tl.AddTask(none, parthenon::StartReceiveFluxCorrections, base);
 
-      // Reset flux arrays (not guaranteed to be zero)
-      auto reset_fluxes = tl.AddTask(none, ResetFluxes, base.get());
-
-      // Calculate the diffusive fluxes for Yjm1 (here u1)
+      // Calculate the diffusive fluxes for Yjm1 (here u1) overwriting existing fluxes
       auto hydro_diff_fluxes =
-          tl.AddTask(reset_fluxes, CalcDiffFluxes, hydro_pkg.get(), base.get());
+          tl.AddTask(none, timers->Wrap(TimedTask::sts_diff_fluxes, CalcDiffFluxes),
+                     hydro_pkg.get(), base.get(), true, first_region, task_stage(jj));
 
       auto send_flx =
           tl.AddTask(hydro_diff_fluxes, parthenon::LoadAndSendFluxCorrections, base);
@@ -317,36 +858,128 @@ void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
       auto set_flx =
           tl.AddTask(recv_flx | hydro_diff_fluxes, parthenon::SetFluxCorrections, base);
 
-      auto &Y0 = pmesh->mesh_data.GetOrAdd("u1", i);
-      auto &MY0 = pmesh->mesh_data.GetOrAdd("MY0", i);
       auto &Yjm2 = pmesh->mesh_data.GetOrAdd("Yjm2", i);
 
-      auto rkl2_step_other =
-          tl.AddTask(set_flx, RKL2StepOther, Y0.get(), base.get(), Yjm2.get(), MY0.get(),
-                     mu_j, nu_j, mu_tilde_j, gamma_tilde_j, tau);
+      auto add_step_other = [&](const TaskID &dep, const BlockRegion region) {
+        if (rkl1) {
+          return tl.AddTask(dep, timers->Wrap(TimedTask::sts_step, rkl1_step_other),
+                            base.get(), Yjm2.get(), mu_j, nu_j, mu_tilde_j, tau, region,
+                            task_stage(jj), s_rkl);
+        }
+        auto &Y0 = pmesh->mesh_data.GetOrAdd("u1", i);
+        auto &MY0 = pmesh->mesh_data.GetOrAdd("MY0", i);
+        return tl.AddTask(dep, timers->Wrap(TimedTask::sts_step, rkl2_step_other),
+                          Y0.get(), base.get(), Yjm2.get(), MY0.get(), mu_j, nu_j,
+                          mu_tilde_j, gamma_tilde_j, tau, region, task_stage(jj),
+                          s_rkl);
+      };
+      auto rkl_step_other = add_step_other(set_flx, first_region);
 
       // update ghost cells of base (currently storing Yj)
       // Update ghost cells (local and non local), prolongate and apply bound cond.
       // TODO(someone) experiment with split (local/nonlocal) comms with respect to
       // performance for various tests (static, amr, block sizes) and then decide on the
       // best impl. Go with default call (split local/nonlocal) for now.
-      // TODO(pgrete) optimize (in parthenon) to only send subset of updated vars
-      auto bounds_exchange = parthenon::AddBoundaryExchangeTasks(
-          rkl2_step_other | start_bnd, tl, base, pmesh->multilevel);
+      auto bounds_exchange =
+          timers->AddBoundaryExchangeTasks(TimedTask::sts_boundary_exchange,
+                                           rkl_step_other | start_bnd, tl, exchange,
+                                           pmesh->multilevel);
+
+      if (overlap) {
+        // see comment in region_calc_fluxes_step_init above
+        auto interior_diff_fluxes = tl.AddTask(
+            rkl_step_other, timers->Wrap(TimedTask::sts_diff_fluxes, CalcDiffFluxes),
+            hydro_pkg.get(), base.get(), true, BlockRegion::interior, task_stage(jj));
+        auto interior_step_other =
+            add_step_other(interior_diff_fluxes, BlockRegion::interior);
+        bounds_exchange = bounds_exchange | interior_step_other;
+      }
 
-      tl.AddTask(bounds_exchange, parthenon::Update::FillDerived<MeshData<Real>>,
+      tl.AddTask(bounds_exchange,
+                 timers->Wrap(TimedTask::fill_derived,
+                              parthenon::Update::FillDerived<MeshData<Real>>),
                  base.get());
     }
 
     b_jm2 = b_jm1;
     b_jm1 = b_j;
   }
+
+  if (local_stages) {
+    // Correct the faces between blocks with different numbers of stages (see
+    // AccumulateSTSFaceFluxes) once all blocks completed their stages
+    TaskRegion &region_face_fluxes = ptask_coll->AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+      auto &tl = region_face_fluxes[i];
+      auto &base = pmesh->mesh_data.GetOrAdd("base", i);
+      auto &exchange = pmesh->mesh_data.GetOrAdd("sts_exchange", i);
+      auto &face_flux = pmesh->mesh_data.GetOrAdd("sts_face_flux", i);
+      const auto any = parthenon::BoundaryType::any;
+      auto start_face_bnd =
+          tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, face_flux);
+      auto face_exchange = timers->AddBoundaryExchangeTasks(
+          TimedTask::sts_boundary_exchange, start_face_bnd, tl, face_flux,
+          pmesh->multilevel);
+      // Only a single exchange is in flight at a time
+      auto start_bnd =
+          tl.AddTask(face_exchange, parthenon::StartReceiveBoundBufs<any>, exchange);
+      auto correct = tl.AddTask(
+          face_exchange, timers->Wrap(TimedTask::sts_step, CorrectSTSFaceFluxes),
+          base.get(), tau);
+      auto bounds_exchange =
+          timers->AddBoundaryExchangeTasks(TimedTask::sts_boundary_exchange,
+                                           correct | start_bnd, tl, exchange,
+                                           pmesh->multilevel);
+      tl.AddTask(bounds_exchange,
+                 timers->Wrap(TimedTask::fill_derived,
+                              parthenon::Update::FillDerived<MeshData<Real>>),
+                 base.get());
+    }
+  }
 }
 
 // See the advection.hpp declaration for a description of how this function gets called.
 TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
   TaskCollection tc;
   auto hydro_pkg = blocks[0]->packages.Get("Hydro");
+  auto tracers_pkg = blocks[0]->packages.Get("tracers");
+
+  // Only the conversion to primitive variables in the final stage (and potentially
+  // following STS stages) provides the hyperbolic timestep used in EstimateTimestep.
+  // Set at task list creation as the task collection of a stage is executed right after.
+  if (hydro_pkg->Param<bool>("fused_dt_hyp")) {
+    hydro_pkg->UpdateParam("fused_dt_hyp_active", stage == integrator->nstages);
+    if (stage == 1) {
+      hydro_pkg->MutableParam<std::map<MeshData<Real> *, Real>>("fused_dt_hyp_cache")
+          ->clear();
+    }
+  }
+
+  if (stage == 1) {
+    timers_.NewCycle(tm.ncycle);
+  }
+
+  if (stage == 1 && hydro_pkg->Param<bool>("memory_report") &&
+      (pmesh->nbnew != memory_report_nbnew_ || pmesh->nbdel != memory_report_nbdel_)) {
+    ReportMemoryFootprint(pmesh, "after remeshing (cycle " + std::to_string(tm.ncycle) +
+                                     ")");
+    memory_report_nbnew_ = pmesh->nbnew;
+    memory_report_nbdel_ = pmesh->nbdel;
+  }
+
+  // Drop the cached packs, graphs, and cooling work queues of MeshData that may no longer
+  // exist after remeshing (the packs are built again at the end of this function and the
+  // others on first use)
+  if (stage == 1 &&
+      (pmesh->nbnew != pack_cache_nbnew_ || pmesh->nbdel != pack_cache_nbdel_)) {
+    pack_cache_.Clear();
+    stage_graphs_.Clear();
+    if (hydro_pkg->AllParams().hasKey("cooling_work_queues")) {
+      hydro_pkg->MutableParam<cooling::CoolingWorkQueues>("cooling_work_queues")->clear();
+    }
+    pack_cache_nbnew_ = pmesh->nbnew;
+    pack_cache_nbdel_ = pmesh->nbdel;
+  }
 
   TaskID none(0);
   // Number of task lists that can be executed indepenently and thus *may*
@@ -357,42 +990,6 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
 
   const int num_partitions = pmesh->DefaultNumPartitions();
 
-  // calculate agn triggering accretion rate
-  if ((stage == 1) &&
-      hydro_pkg->AllParams().hasKey("agn_triggering_reduce_accretion_rate") &&
-      hydro_pkg->Param<bool>("agn_triggering_reduce_accretion_rate")) {
-
-    // need to make sure that there's only one region in order to MPI_reduce to work
-    TaskRegion &single_task_region = tc.AddRegion(1);
-    auto &tl = single_task_region[0];
-    // First globally reset triggering quantities
-    auto prev_task =
-        tl.AddTask(none, cluster::AGNTriggeringResetTriggering, hydro_pkg.get());
-
-    // Adding one task for each partition. Given that they're all in one task list
-    // they'll be executed sequentially. Given that a par_reduce to a host var is
-    // blocking it's also save to store the variable in the Params for now.
-    for (int i = 0; i < num_partitions; i++) {
-      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_agn_triggering =
-          tl.AddTask(prev_task, cluster::AGNTriggeringReduceTriggering, mu0.get(), tm.dt);
-      prev_task = new_agn_triggering;
-    }
-#ifdef MPI_PARALLEL
-    auto reduce_agn_triggering =
-        tl.AddTask(prev_task, cluster::AGNTriggeringMPIReduceTriggering, hydro_pkg.get());
-    prev_task = reduce_agn_triggering;
-#endif
-
-    // Remove accreted gas
-    for (int i = 0; i < num_partitions; i++) {
-      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_remove_accreted_gas =
-          tl.AddTask(prev_task, cluster::AGNTriggeringFinalizeTriggering, mu0.get(), tm);
-      prev_task = new_remove_accreted_gas;
-    }
-  }
-
   for (int i = 0; i < blocks.size(); i++) {
     auto &pmb = blocks[i];
     // Using "base" as u0, which already exists (and returned by using plain Get())
@@ -406,46 +1003,122 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     }
   }
 
-  // calculate magnetic tower scaling
-  if ((stage == 1) && hydro_pkg->AllParams().hasKey("magnetic_tower_power_scaling") &&
-      hydro_pkg->Param<bool>("magnetic_tower_power_scaling")) {
-    const auto &magnetic_tower =
-        hydro_pkg->Param<cluster::MagneticTower>("magnetic_tower");
+  // calculate agn triggering accretion rate and magnetic tower scaling
+  const bool agn_triggering =
+      hydro_pkg->AllParams().hasKey("agn_triggering_reduce_accretion_rate") &&
+      hydro_pkg->Param<bool>("agn_triggering_reduce_accretion_rate");
+  const bool magnetic_tower_scaling =
+      hydro_pkg->AllParams().hasKey("magnetic_tower_power_scaling") &&
+      hydro_pkg->Param<bool>("magnetic_tower_power_scaling");
+  // With overlap_global_reductions, the global reductions are only started here and all
+  // tasks depending on them (i.e., finalizing the triggering) are part of the main
+  // region below so that the fluxes of the first stage can be calculated in the meantime.
+  const bool cluster_reductions =
+      (stage == 1) && (agn_triggering || magnetic_tower_scaling);
+  const bool overlap_cluster_reductions =
+      cluster_reductions && hydro_pkg->Param<bool>("overlap_global_reductions");
+  auto *reductions =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+  const std::string reductions_phase = "cluster";
+  // Tasks that use the global values (in the task list tl) for the partition mu0
+  // (and the respective stage start register mu1).
+  auto add_finalize_cluster_reductions = [&](TaskID prev_task, TaskList &tl,
+                                             std::shared_ptr<MeshData<Real>> &mu0,
+                                             std::shared_ptr<MeshData<Real>> &mu1) {
+    if (magnetic_tower_scaling) {
+      prev_task = tl.AddTask(prev_task,
+                             timers_.Wrap(TimedTask::magnetic_tower,
+                                          cluster::MagneticTowerGetGlobalReductions),
+                             hydro_pkg.get());
+    }
+    if (agn_triggering) {
+      prev_task = tl.AddTask(prev_task,
+                             timers_.Wrap(TimedTask::agn_triggering,
+                                          cluster::AGNTriggeringGetGlobalReductions),
+                             hydro_pkg.get());
+      // Remove accreted gas
+      prev_task = tl.AddTask(prev_task,
+                             timers_.Wrap(TimedTask::agn_triggering,
+                                          cluster::AGNTriggeringFinalizeTriggering),
+                             mu0.get(), tm);
+      if (mu1 != nullptr) {
+        // The stage start register has already been initialized so it's synced again.
+        prev_task = tl.AddTask(
+            prev_task,
+            [](MeshData<Real> *mu0, MeshData<Real> *mu1) {
+              for (int b = 0; b < mu0->NumBlocks(); b++) {
+                mu1->GetBlockData(b)->Get("cons").data.DeepCopy(
+                    mu0->GetBlockData(b)->Get("cons").data);
+              }
+              return TaskStatus::complete;
+            },
+            mu0.get(), mu1.get());
+      }
+    }
+    return prev_task;
+  };
 
-    // need to make sure that there's only one region in order to MPI_reduce to work
+  if (cluster_reductions) {
+    // Both local reductions are added to a single task list so that the global
+    // reductions of all quantities are batched (in the "cluster" phase of the
+    // GlobalReductions) and only require a single region.
     TaskRegion &single_task_region = tc.AddRegion(1);
     auto &tl = single_task_region[0];
-    // First globally reset magnetic_tower_linear_contrib and
-    // magnetic_tower_quadratic_contrib
-    auto prev_task =
-        tl.AddTask(none, cluster::MagneticTowerResetPowerContribs, hydro_pkg.get());
+    auto prev_task = none;
 
     // Adding one task for each partition. Given that they're all in one task list
     // they'll be executed sequentially. Given that a par_reduce to a host var is
-    // blocking it's also save to store the variable in the Params for now.
-    for (int i = 0; i < num_partitions; i++) {
-      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_magnetic_tower_power_contrib =
-          tl.AddTask(prev_task, cluster::MagneticTowerReducePowerContribs, mu0.get(), tm);
-      prev_task = new_magnetic_tower_power_contrib;
+    // blocking it's also save to store the variable in the Params (the contributions
+    // are accumulated through utils::shared_params so that this would also hold for
+    // concurrently executed task lists).
+    if (agn_triggering) {
+      // First reset triggering quantities
+      prev_task = tl.AddTask(
+          prev_task,
+          timers_.Wrap(TimedTask::agn_triggering, cluster::AGNTriggeringResetTriggering),
+          hydro_pkg.get());
+      for (int i = 0; i < num_partitions; i++) {
+        auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+        prev_task = tl.AddTask(prev_task,
+                               timers_.Wrap(TimedTask::agn_triggering,
+                                            cluster::AGNTriggeringReduceTriggering),
+                               mu0.get(), tm.dt);
+      }
+      prev_task = tl.AddTask(prev_task,
+                             timers_.Wrap(TimedTask::agn_triggering,
+                                          cluster::AGNTriggeringSetLocalReductions),
+                             hydro_pkg.get());
+    }
+    if (magnetic_tower_scaling) {
+      // First reset magnetic_tower_linear_contrib and magnetic_tower_quadratic_contrib
+      prev_task = tl.AddTask(prev_task,
+                             timers_.Wrap(TimedTask::magnetic_tower,
+                                          cluster::MagneticTowerResetPowerContribs),
+                             hydro_pkg.get());
+      for (int i = 0; i < num_partitions; i++) {
+        auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+        prev_task = tl.AddTask(prev_task,
+                               timers_.Wrap(TimedTask::magnetic_tower,
+                                            cluster::MagneticTowerReducePowerContribs),
+                               mu0.get(), tm);
+      }
+      prev_task = tl.AddTask(prev_task,
+                             timers_.Wrap(TimedTask::magnetic_tower,
+                                          cluster::MagneticTowerSetLocalReductions),
+                             hydro_pkg.get());
+    }
+
+    auto start_reduce = tl.AddTask(prev_task, &utils::GlobalReductions::StartReduce,
+                                   reductions, reductions_phase);
+    if (!overlap_cluster_reductions) {
+      prev_task = tl.AddTask(start_reduce, &utils::GlobalReductions::CheckReduce,
+                             reductions, reductions_phase);
+      for (int i = 0; i < num_partitions; i++) {
+        auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+        std::shared_ptr<MeshData<Real>> no_mu1;
+        prev_task = add_finalize_cluster_reductions(prev_task, tl, mu0, no_mu1);
+      }
     }
-#ifdef MPI_PARALLEL
-    auto reduce_magnetic_tower_power_contrib = tl.AddTask(
-        prev_task,
-        [](StateDescriptor *hydro_pkg) {
-          Real magnetic_tower_contribs[] = {
-              hydro_pkg->Param<Real>("magnetic_tower_linear_contrib"),
-              hydro_pkg->Param<Real>("magnetic_tower_quadratic_contrib")};
-          PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, magnetic_tower_contribs, 2,
-                                            MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
-          hydro_pkg->UpdateParam("magnetic_tower_linear_contrib",
-                                 magnetic_tower_contribs[0]);
-          hydro_pkg->UpdateParam("magnetic_tower_quadratic_contrib",
-                                 magnetic_tower_contribs[1]);
-          return TaskStatus::complete;
-        },
-        hydro_pkg.get());
-#endif
   }
 
   // First add split sources before the main time integration
@@ -453,8 +1126,13 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     // If any tasks modify the conserved variables before this place, then
     // the STS tasks should be updated to not assume prim and cons are in sync.
     const auto &diffint = hydro_pkg->Param<DiffInt>("diffint");
-    if (diffint == DiffInt::rkl2) {
-      AddSTSTasks(&tc, pmesh, blocks, 0.5 * tm.dt);
+    if (diffint == DiffInt::rkl2 || diffint == DiffInt::rkl1) {
+      AddSTSTasks(&tc, pmesh, blocks, 0.5 * tm.dt, &timers_);
+    } else if (diffint == DiffInt::implicit) {
+      TaskRegion &implicit_region = tc.AddRegion(1);
+      implicit_region[0].AddTask(
+          none, timers_.Wrap(TimedTask::implicit_conduction, ImplicitConductionStep),
+          pmesh, 0.5 * tm.dt);
     }
     TaskRegion &strang_init_region = tc.AddRegion(num_partitions);
     for (int i = 0; i < num_partitions; i++) {
@@ -466,7 +1144,9 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
       // the source term is applied to all active registers in the flux calculation.
       // IMPORTANT 2: The tasks should work using `cons` variables as input as in the
       // final step, `prim` are not updated yet from the flux calculation.
-      tl.AddTask(none, AddSplitSourcesStrang, mu0.get(), tm);
+      tl.AddTask(none,
+                 timers_.Wrap(TimedTask::split_sources_strang, AddSplitSourcesStrang),
+                 mu0.get(), tm);
     }
   }
 
@@ -494,6 +1174,17 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     }
   }
 
+  // With overlap_ghost_exchange, the ghost cells of intermediate stages are exchanged at
+  // the beginning of the following stage so that the fluxes of the interior (not
+  // depending on ghost cells) can be calculated while the exchange is in flight.
+  // The exchange of the final stage is never deferred as many tasks (STS, timestep,
+  // refinement, outputs, ...) rely on synced ghost cells after a cycle.
+  // Only a single exchange is in flight per task region so that communication buffers are
+  // not overwritten before they've been consumed by all neighbors.
+  const bool overlap_ghost_exchange = hydro_pkg->Param<bool>("overlap_ghost_exchange");
+  const bool exchange_at_start = overlap_ghost_exchange && stage > 1;
+  const bool exchange_at_end = !overlap_ghost_exchange || stage == integrator->nstages;
+
   // note that task within this region that contains one tasklist per pack
   // could still be executed in parallel
   TaskRegion &single_tasklist_per_pack_region = tc.AddRegion(num_partitions);
@@ -503,69 +1194,162 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     auto &mu1 = pmesh->mesh_data.GetOrAdd("u1", i);
 
     const auto any = parthenon::BoundaryType::any;
-    auto start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, mu0);
+    TaskID start_bnd = none;
+    if (exchange_at_start || exchange_at_end) {
+      start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, mu0);
+    }
     auto start_flxcor_recv =
         tl.AddTask(none, parthenon::StartReceiveFluxCorrections, mu0);
 
-    const auto flux_str = (stage == 1) ? "flux_first_stage" : "flux_other_stage";
-    FluxFun_t *calc_flux_fun = hydro_pkg->Param<FluxFun_t *>(flux_str);
-    auto calc_flux = tl.AddTask(none, calc_flux_fun, mu0);
-
-    // TODO(pgrete) figure out what to do about the sources from the first stage
-    // that are potentially disregarded when the (m)hd fluxes are corrected in the second
-    // stage.
-    TaskID first_order_flux_correct = calc_flux;
-    if (hydro_pkg->Param<bool>("first_order_flux_correct")) {
-      auto *first_order_flux_correct_fun =
-          hydro_pkg->Param<FirstOrderFluxCorrectFun_t *>("first_order_flux_correct_fun");
-      first_order_flux_correct =
-          tl.AddTask(calc_flux, first_order_flux_correct_fun, mu0.get(), mu1.get(),
-                     integrator->gam0[stage - 1], integrator->gam1[stage - 1],
-                     integrator->beta[stage - 1] * integrator->dt);
+    // Finalize the global reductions started at the beginning of the cycle.
+    // Only the tasks modifying the conserved variables depend on those.
+    TaskID check_reduce = none;
+    TaskID cluster_reductions_done = none;
+    if (overlap_cluster_reductions) {
+      check_reduce = tl.AddTask(none, &utils::GlobalReductions::CheckReduce, reductions,
+                                reductions_phase);
     }
 
-    auto send_flx =
-        tl.AddTask(first_order_flux_correct, parthenon::LoadAndSendFluxCorrections, mu0);
-    auto recv_flx = tl.AddTask(start_flxcor_recv, parthenon::ReceiveFluxCorrections, mu0);
-    auto set_flx = tl.AddTask(recv_flx | first_order_flux_correct,
-                              parthenon::SetFluxCorrections, mu0);
+    const auto flux_str = (stage == 1) ? "flux_first_stage" : "flux_other_stage";
+    auto calc_flux_fun =
+        timers_.Wrap(TimedTask::calc_fluxes,
+                     stage_graphs_.Wrap(hydro_pkg->Param<FluxFun_t *>(flux_str)));
+
+    TaskID update;
+    if (hydro_pkg->Param<bool>("fused_update")) {
+      // Fluxes and flux divergence update in one go (only without flux correction).
+      if (overlap_cluster_reductions) {
+        cluster_reductions_done =
+            add_finalize_cluster_reductions(check_reduce, tl, mu0, mu1);
+      }
+      update = tl.AddTask(cluster_reductions_done, calc_flux_fun, mu0, mu1.get(),
+                          integrator->gam0[stage - 1], integrator->gam1[stage - 1],
+                          integrator->beta[stage - 1] * integrator->dt, BlockRegion::all);
+    } else {
+      TaskID calc_flux;
+      if (exchange_at_start) {
+        auto bounds_exchange = timers_.AddBoundaryExchangeTasks(
+            TimedTask::boundary_exchange, start_bnd, tl, mu0, pmesh->multilevel);
+        // Added after the exchange tasks so that the sending happens first.
+        auto calc_flux_interior = tl.AddTask(none, calc_flux_fun, mu0, nullptr, 0.0, 0.0,
+                                             0.0, BlockRegion::interior);
+        auto fill_derived =
+            tl.AddTask(bounds_exchange,
+                       timers_.Wrap(TimedTask::fill_derived,
+                                    parthenon::Update::FillDerived<MeshData<Real>>),
+                       mu0.get());
+        calc_flux = tl.AddTask(fill_derived | calc_flux_interior, calc_flux_fun, mu0,
+                               nullptr, 0.0, 0.0, 0.0, BlockRegion::rim);
+      } else {
+        calc_flux = tl.AddTask(none, calc_flux_fun, mu0, nullptr, 0.0, 0.0, 0.0,
+                               BlockRegion::all);
+      }
+      // Removing the accreted gas modifies the primitive variables, too. Thus, it always
+      // happens after the fluxes are calculated (from the original state) so that the
+      // result doesn't depend on when the global reductions complete.
+      if (overlap_cluster_reductions) {
+        cluster_reductions_done =
+            add_finalize_cluster_reductions(check_reduce | calc_flux, tl, mu0, mu1);
+      }
 
-    // compute the divergence of fluxes of conserved variables
-    auto update = tl.AddTask(
-        set_flx, parthenon::Update::UpdateWithFluxDivergence<MeshData<Real>>, mu0.get(),
-        mu1.get(), integrator->gam0[stage - 1], integrator->gam1[stage - 1],
-        integrator->beta[stage - 1] * integrator->dt);
+      // TODO(pgrete) figure out what to do about the sources from the first stage
+      // that are potentially disregarded when the (m)hd fluxes are corrected in the
+      // second stage.
+      TaskID first_order_flux_correct = calc_flux;
+      if (hydro_pkg->Param<bool>("first_order_flux_correct")) {
+        auto first_order_flux_correct_fun =
+            timers_.Wrap(TimedTask::first_order_flux_correct,
+                         hydro_pkg->Param<FirstOrderFluxCorrectFun_t *>(
+                             "first_order_flux_correct_fun"));
+        first_order_flux_correct =
+            tl.AddTask(calc_flux | cluster_reductions_done, first_order_flux_correct_fun,
+                       mu0.get(), mu1.get(), integrator->gam0[stage - 1],
+                       integrator->gam1[stage - 1],
+                       integrator->beta[stage - 1] * integrator->dt);
+      }
+
+      const auto flxcor = TimedTask::flux_correction;
+      auto send_flx = tl.AddTask(
+          first_order_flux_correct,
+          timers_.Wrap(flxcor, parthenon::LoadAndSendFluxCorrections), mu0);
+      auto recv_flx =
+          tl.AddTask(start_flxcor_recv,
+                     timers_.Wrap(flxcor, parthenon::ReceiveFluxCorrections), mu0);
+      auto set_flx =
+          tl.AddTask(recv_flx | first_order_flux_correct,
+                     timers_.Wrap(flxcor, parthenon::SetFluxCorrections), mu0);
+
+      // compute the divergence of fluxes of conserved variables
+      auto update_fun = parthenon::Update::UpdateWithFluxDivergence<MeshData<Real>>;
+      if (hydro_pkg->Param<bool>("glmmhd_fused_source")) {
+        // incl. the Dedner source that is then skipped in AddUnsplitSources
+        update_fun = hydro_pkg->Param<GLMMHD::FusedUpdateFun_t *>("glmmhd_fused_update");
+      }
+      update = tl.AddTask(
+          set_flx | cluster_reductions_done, timers_.Wrap(TimedTask::update, update_fun),
+          mu0.get(), mu1.get(), integrator->gam0[stage - 1], integrator->gam1[stage - 1],
+          integrator->beta[stage - 1] * integrator->dt);
+    }
 
     // Add non-operator split source terms.
     // Note: Directly update the "cons" variables of mu0 based on the "prim" variables
     // of mu0 as the "cons" variables have already been updated in this stage from the
     // fluxes in the previous step.
-    auto source_unsplit = tl.AddTask(update, AddUnsplitSources, mu0.get(), tm,
-                                     integrator->beta[stage - 1] * integrator->dt);
+    auto source_unsplit =
+        tl.AddTask(update, timers_.Wrap(TimedTask::unsplit_sources, AddUnsplitSources),
+                   mu0.get(), tm, integrator->beta[stage - 1] * integrator->dt);
 
     auto source_split_first_order = source_unsplit;
 
+    if (!u1_gam0_.empty() && u1_gam0_[stage - 1] != 0.0) {
+      // after all updates of u0 in this stage
+      source_split_first_order =
+          tl.AddTask(source_unsplit, UpdateStageRegister, mu0.get(), mu1.get(),
+                     u1_gam0_[stage - 1], u1_gam1_[stage - 1]);
+    }
+
     if (stage == integrator->nstages) {
       // Add final Strang split source terms, i.e., a dt/2 update
       // IMPORTANT: The tasks should work using `cons` variables as input as in the
       // final step, `prim` are not updated yet from the flux calculation.
-      auto source_split_strang_final =
-          tl.AddTask(source_unsplit, AddSplitSourcesStrang, mu0.get(), tm);
+      auto source_split_strang_final = tl.AddTask(
+          source_unsplit,
+          timers_.Wrap(TimedTask::split_sources_strang, AddSplitSourcesStrang), mu0.get(),
+          tm);
 
       // Add operator split source terms at first order, i.e., full dt update
       // after all stages of the integration.
       // Not recommended for but allows easy "reset" of variable for some
       // problem types, see random blasts.
-      source_split_first_order =
-          tl.AddTask(source_split_strang_final, AddSplitSourcesFirstOrder, mu0.get(), tm);
+      source_split_first_order = tl.AddTask(
+          source_split_strang_final,
+          timers_.Wrap(TimedTask::split_sources_first_order, AddSplitSourcesFirstOrder),
+          mu0.get(), tm);
     }
 
     // Update ghost cells (local and non local), prolongate and apply bound cond.
     // TODO(someone) experiment with split (local/nonlocal) comms with respect to
     // performance for various tests (static, amr, block sizes) and then decide on the
     // best impl. Go with default call (split local/nonlocal) for now.
-    parthenon::AddBoundaryExchangeTasks(source_split_first_order | start_bnd, tl, mu0,
-                                        pmesh->multilevel);
+    if (exchange_at_end && !exchange_at_start) {
+      timers_.AddBoundaryExchangeTasks(TimedTask::boundary_exchange,
+                                       source_split_first_order | start_bnd, tl, mu0,
+                                       pmesh->multilevel);
+    }
+  }
+
+  // Final stage with overlap_ghost_exchange already exchanged ghost cells at the start
+  // of the stage and needs a separate region for the second exchange.
+  if (exchange_at_end && exchange_at_start) {
+    TaskRegion &exchange_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+      auto &tl = exchange_region[i];
+      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+      const auto any = parthenon::BoundaryType::any;
+      auto start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, mu0);
+      timers_.AddBoundaryExchangeTasks(TimedTask::boundary_exchange, start_bnd, tl, mu0,
+                                       pmesh->multilevel);
+    }
   }
 
   TaskRegion &single_tasklist_per_pack_region_3 = tc.AddRegion(num_partitions);
@@ -573,13 +1357,22 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     auto &tl = single_tasklist_per_pack_region_3[i];
     auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
     auto fill_derived =
-        tl.AddTask(none, parthenon::Update::FillDerived<MeshData<Real>>, mu0.get());
+        tl.AddTask(none,
+                   timers_.Wrap(TimedTask::fill_derived,
+                                parthenon::Update::FillDerived<MeshData<Real>>),
+                   mu0.get());
   }
   const auto &diffint = hydro_pkg->Param<DiffInt>("diffint");
   // If any tasks modify the conserved variables before this place and after FillDerived,
   // then the STS tasks should be updated to not assume prim and cons are in sync.
-  if (diffint == DiffInt::rkl2 && stage == integrator->nstages) {
-    AddSTSTasks(&tc, pmesh, blocks, 0.5 * tm.dt);
+  if ((diffint == DiffInt::rkl2 || diffint == DiffInt::rkl1) &&
+      stage == integrator->nstages) {
+    AddSTSTasks(&tc, pmesh, blocks, 0.5 * tm.dt, &timers_);
+  } else if (diffint == DiffInt::implicit && stage == integrator->nstages) {
+    TaskRegion &implicit_region = tc.AddRegion(1);
+    implicit_region[0].AddTask(
+        none, timers_.Wrap(TimedTask::implicit_conduction, ImplicitConductionStep),
+        pmesh, 0.5 * tm.dt);
   }
 
   // Single task in single (serial) region to reset global vars used in reductions in the
@@ -594,7 +1387,10 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     tl.AddTask(
         none,
         [](StateDescriptor *hydro_pkg) {
-          hydro_pkg->UpdateParam("mindx", std::numeric_limits<Real>::max());
+          // mindx is only recalculated if not reused, see PreStepMeshUserWorkInLoop
+          if (!hydro_pkg->Param<bool>("async_dt_reduction")) {
+            hydro_pkg->UpdateParam("mindx", std::numeric_limits<Real>::max());
+          }
           hydro_pkg->UpdateParam("dt_hyp", std::numeric_limits<Real>::max());
           hydro_pkg->UpdateParam("dt_diff", std::numeric_limits<Real>::max());
           return TaskStatus::complete;
@@ -607,22 +1403,70 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     for (int i = 0; i < num_partitions; i++) {
       auto &tl = tr[i];
       auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_dt = tl.AddTask(none, parthenon::Update::EstimateTimestep<MeshData<Real>>,
-                               mu0.get());
+      auto new_dt =
+          tl.AddTask(none,
+                     timers_.Wrap(TimedTask::estimate_timestep,
+                                  parthenon::Update::EstimateTimestep<MeshData<Real>>),
+                     mu0.get());
+      // Sparse scalars that stayed below the deallocation threshold for long enough
+      if (hydro_pkg->Param<bool>("sparse_scalars")) {
+        tl.AddTask(new_dt, parthenon::Update::SparseDealloc, mu0.get());
+      }
+      // All source terms of this cycle have been applied at this point.
+      if (hydro_pkg->Param<Real>("lb_cooling_cost_weight") > 0.0 ||
+          (tracers_pkg->Param<bool>("enabled") &&
+           tracers_pkg->Param<Real>("lb_cost_weight") > 0.0)) {
+        tl.AddTask(none, SetLoadBalancingCosts, mu0.get());
+      }
+    }
+
+    // Only start the global reduction of dt_hyp and dt_diff (used for c_h and STS in the
+    // next cycle) here. It's completed in PreStepMeshUserWorkInLoop.
+    // Not started in the last cycle so that no reduction is pending at the end.
+    const bool last_cycle =
+        tm.time + tm.dt >= tm.tlim || (tm.nlim >= 0 && tm.ncycle + 1 >= tm.nlim);
+    if (hydro_pkg->Param<bool>("async_dt_reduction") && !last_cycle &&
+        (hydro_pkg->Param<bool>("calc_c_h") ||
+         hydro_pkg->Param<DiffInt>("diffint") != DiffInt::none)) {
+      TaskRegion &start_dt_reduction_region = tc.AddRegion(1);
+      auto &tl = start_dt_reduction_region[0];
+      auto set_local = tl.AddTask(
+          none,
+          [](StateDescriptor *hydro_pkg) {
+            auto *reductions =
+                hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+            reductions->SetLocal("dt_hyp", hydro_pkg->Param<Real>("dt_hyp"));
+            reductions->SetLocal("dt_diff", hydro_pkg->Param<Real>("dt_diff"));
+            return TaskStatus::complete;
+          },
+          hydro_pkg.get());
+      tl.AddTask(set_local, &utils::GlobalReductions::StartReduce,
+                 hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions"),
+                 std::string("timestep"));
     }
   }
 
-  auto tracers_pkg = pmesh->packages.Get("tracers");
   // First order operator split tracer advection
   if (stage == integrator->nstages && tracers_pkg->Param<bool>("enabled")) {
     const std::string swarm_name = "tracers";
+    const bool swarm_packs = tracers_pkg->Param<bool>("swarm_packs");
     TaskRegion &sync_region_tr = tc.AddRegion(1);
     {
+      auto &tl = sync_region_tr[0];
+      TaskID reset_comms = none;
       for (auto &pmb : blocks) {
-        auto &tl = sync_region_tr[0];
         auto &sd = pmb->meshblock_data.Get()->GetSwarmData();
-        auto reset_comms =
-            tl.AddTask(none, &SwarmContainer::ResetCommunication, sd.get());
+        reset_comms =
+            reset_comms | tl.AddTask(none, &SwarmContainer::ResetCommunication, sd.get());
+      }
+      // Advect the tracers of all blocks at once (before the per block communication)
+      if (swarm_packs) {
+        PARTHENON_REQUIRE_THROWS(num_partitions == 1,
+                                 "Only pack_size=-1 currently supported for tracers.")
+        auto &mu0 = pmesh->mesh_data.GetOrAdd("base", 0);
+        tl.AddTask(reset_comms,
+                   timers_.Wrap(TimedTask::tracers, Tracers::AdvectTracersMD),
+                   mu0.get(), integrator->dt);
       }
     }
 
@@ -633,13 +1477,20 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
       auto &sd = pmb->meshblock_data.Get()->GetSwarmData();
       auto &mbd0 = pmb->meshblock_data.Get("base");
       auto tracer_advect =
-          tl.AddTask(none, Tracers::AdvectTracers, mbd0.get(), integrator->dt);
+          swarm_packs
+              ? none
+              : tl.AddTask(none, timers_.Wrap(TimedTask::tracers, Tracers::AdvectTracers),
+                           mbd0.get(), integrator->dt);
 
       auto send = tl.AddTask(tracer_advect, &SwarmContainer::Send, sd.get(),
                              BoundaryCommSubset::all);
 
       auto receive =
           tl.AddTask(send, &SwarmContainer::Receive, sd.get(), BoundaryCommSubset::all);
+      if (tracers_pkg->Param<int>("sort_interval") > 0) {
+        tl.AddTask(receive, timers_.Wrap(TimedTask::tracers, Tracers::SortTracers),
+                   pmb.get(), tm.ncycle);
+      }
     }
     // TODO(pgrete) Fix/cleanup once we got swarm packs.
     // We need just a single region with a single task in order to be able to use plain
@@ -651,10 +1502,19 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     for (int i = 0; i < num_partitions; i++) {
       auto &tl = single_tasklist_per_pack_region_4[i];
       auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto fill = tl.AddTask(none, Tracers::FillTracers, mu0.get(), tm);
+      auto fill = tl.AddTask(none,
+                             timers_.Wrap(TimedTask::tracers, swarm_packs
+                                                                  ? Tracers::FillTracersMD
+                                                                  : Tracers::FillTracers),
+                             mu0.get(), tm);
       if (Tracers::ProblemFillTracers != nullptr) {
-        fill =
-            tl.AddTask(fill, Tracers::ProblemFillTracers, mu0.get(), tm, integrator->dt);
+        fill = tl.AddTask(fill,
+                          timers_.Wrap(TimedTask::tracers, Tracers::ProblemFillTracers),
+                          mu0.get(), tm, integrator->dt);
+      }
+      if (tracers_pkg->Param<bool>("stream_enabled")) {
+        tl.AddTask(fill, timers_.Wrap(TimedTask::tracers, Tracers::StreamTracers),
+                   mu0.get(), tm);
       }
     }
   }
@@ -665,7 +1525,28 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
       auto &tl = async_region_4[i];
       auto &u0 = blocks[i]->meshblock_data.Get("base");
       auto tag_refine =
-          tl.AddTask(none, parthenon::Refinement::Tag<MeshBlockData<Real>>, u0.get());
+          tl.AddTask(none,
+                     timers_.Wrap(TimedTask::refinement_tag,
+                                  parthenon::Refinement::Tag<MeshBlockData<Real>>),
+                     u0.get());
+    }
+  }
+
+  // Build the packs of all registers used by the tasks added above (and in the following
+  // stages), i.e., before any of these are executed
+  if (stage == 1) {
+    std::vector<std::string> registers = {"base", "u1"};
+    const auto &diffint = hydro_pkg->Param<DiffInt>("diffint");
+    if (diffint == DiffInt::rkl2 || diffint == DiffInt::rkl1) {
+      registers.emplace_back("Yjm2");
+      if (diffint == DiffInt::rkl2) {
+        registers.emplace_back("MY0");
+      }
+    }
+    for (const auto &name : registers) {
+      for (int i = 0; i < num_partitions; i++) {
+        pack_cache_.Add(pmesh->mesh_data.GetOrAdd(name, i));
+      }
     }
   }
 
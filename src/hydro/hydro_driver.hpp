@@ -6,10 +6,18 @@
 // Licensed under the BSD 3-Clause License (the "LICENSE").
 //========================================================================================
 
+// C++ headers
+#include <vector>
+
 // Parthenon headers
 #include <parthenon/driver.hpp>
 #include <parthenon/package.hpp>
 
+// AthenaPK headers
+#include "pack_cache.hpp"
+#include "stage_graphs.hpp"
+#include "task_timers.hpp"
+
 using namespace parthenon::driver::prelude;
 
 namespace Hydro {
@@ -25,6 +33,28 @@ class HydroDriver : public MultiStageDriver {
   //       DriverUtils::ConstructAndExecuteBlockTasks (driver.hpp)
   //         AdvectionDriver::MakeTaskList (advection.cpp)
   auto MakeTaskCollection(BlockList_t &blocks, int stage) -> TaskCollection;
+  void PostExecute(parthenon::DriverStatus status) override;
+  // Times the steps if <hydro/hst_rank_metrics> is enabled
+  TaskListStatus Step() override;
+
+ private:
+  // Retries a step with failed cells from the state at its beginning with a reduced
+  // timestep if <hydro/step_retry> is enabled
+  TaskListStatus StepWithRetries();
+
+  TaskTimers timers_;
+  StageGraphs stage_graphs_;
+  // Packs of the registers used by the tasks (see hydro/pack_cache), released with the
+  // driver before Kokkos is finalized
+  pack_cache::PackCache pack_cache_;
+  // Cumulative number of blocks created and destroyed at the last memory report (to
+  // report again after remeshing, see hydro/memory_report)
+  int memory_report_nbnew_ = 0, memory_report_nbdel_ = 0;
+  // Same for the last clearing of the pack cache and the stage graphs
+  int pack_cache_nbnew_ = 0, pack_cache_nbdel_ = 0;
+  // Weights of the optional update u1 = u1_gam0 * u0 + u1_gam1 * u1 at the end of each
+  // stage (empty for integrators without such update), see HydroDriver::HydroDriver
+  std::vector<Real> u1_gam0_, u1_gam1_;
 };
 
 } // namespace Hydro
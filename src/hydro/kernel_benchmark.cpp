@@ -0,0 +1,254 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file kernel_benchmark.cpp
+//! \brief Startup benchmark of the reconstruction and Riemann solver kernels
+
+// C++ headers
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+#include "globals.hpp"
+
+// AthenaPK headers
+#include "../eos/adiabatic_glmmhd.hpp"
+#include "../eos/adiabatic_hydro.hpp"
+#include "../eos/tabulated_hydro.hpp"
+#include "../main.hpp"
+#include "../recon/dc_simple.hpp"
+#include "../recon/limo3_simple.hpp"
+#include "../recon/plm_simple.hpp"
+#include "../recon/ppm_simple.hpp"
+#include "../recon/weno3_simple.hpp"
+#include "../recon/wenoz_simple.hpp"
+#include "kernel_benchmark.hpp"
+#include "rsolvers/rsolvers.hpp"
+
+using namespace parthenon::package::prelude;
+
+namespace Hydro {
+
+namespace {
+// Seconds per call of kernel (after a warm up call)
+template <typename Kernel>
+Real TimeKernel(const Kernel &kernel, const int num_repeat) {
+  kernel();
+  Kokkos::fence();
+  Kokkos::Timer timer;
+  for (int n = 0; n < num_repeat; n++) {
+    kernel();
+  }
+  Kokkos::fence();
+  return timer.seconds() / num_repeat;
+}
+
+// Reconstruction of all variables of all pencils of md in direction XNDIR. The states
+// are stored in the fluxes so that the reconstruction cannot be optimized away.
+template <Reconstruction recon, int XNDIR>
+Real TimeReconstruction(MeshData<Real> *md, const int num_repeat) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const int nvars = hydro_pkg->Param<int>("nhydro") + hydro_pkg->Param<int>("nscalars");
+  const int scratch_level = hydro_pkg->Param<int>("scratch_level");
+
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  const int nx1 = pmb->cellbounds.ncellsi(IndexDomain::entire);
+  const size_t scratch_size_in_bytes =
+      parthenon::ScratchPad2D<ScratchReal>::shmem_size(nvars, nx1) * 2;
+
+  // Cells [il, iu] of the pencils (k, j) whose states are reconstructed so that both
+  // states are available on all interior faces
+  constexpr bool X1 = XNDIR == X1DIR;
+  constexpr bool X2 = XNDIR == X2DIR;
+  constexpr bool X3 = XNDIR == X3DIR;
+  const int il = X1 ? ib.s - 1 : ib.s;
+  const int jl = X2 ? jb.s - 1 : jb.s;
+  const int kl = X3 ? kb.s - 1 : kb.s;
+
+  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
+  auto cons_in = md->PackVariablesAndFluxes(std::vector<std::string>{"cons"},
+                                            std::vector<std::string>{"cons"});
+
+  return TimeKernel(
+      [&]() {
+        parthenon::par_for_outer(
+            DEFAULT_OUTER_LOOP_PATTERN, "Hydro::BenchmarkReconstruction", DevExecSpace(),
+            scratch_size_in_bytes, scratch_level, 0, cons_in.GetDim(5) - 1, kl, kb.e, jl,
+            jb.e,
+            KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k,
+                          const int j) {
+              const auto &prim = prim_in(b);
+              auto &cons = cons_in(b);
+              parthenon::ScratchPad2D<ScratchReal> ql(member.team_scratch(scratch_level),
+                                                      nvars, nx1);
+              parthenon::ScratchPad2D<ScratchReal> qr(member.team_scratch(scratch_level),
+                                                      nvars, nx1);
+              Reconstruct<recon, XNDIR>(member, k, j, il, ib.e, prim, ql, qr, 0,
+                                        nvars - 1);
+              member.team_barrier();
+              for (int v = 0; v < nvars; v++) {
+                parthenon::par_for_inner(member, ib.s, ib.e, [&](const int i) {
+                  cons.flux(XNDIR, v, k, j, i) = ql(v, i) + qr(v, i);
+                });
+              }
+            });
+      },
+      num_repeat);
+}
+
+// Riemann solver on all interior x1 faces of md (with donor cell states)
+template <Fluid fluid, RiemannSolver rsolver, typename EOS>
+Real TimeRiemannSolver(MeshData<Real> *md, const int num_repeat) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const int nhydro = hydro_pkg->Param<int>("nhydro");
+  const int scratch_level = hydro_pkg->Param<int>("scratch_level");
+  const auto &eos = hydro_pkg->Param<EOS>("eos");
+  const Real c_h = fluid == Fluid::glmmhd ? hydro_pkg->Param<Real>("c_h") : 0.0;
+
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  const int nx1 = pmb->cellbounds.ncellsi(IndexDomain::entire);
+  const size_t scratch_size_in_bytes =
+      parthenon::ScratchPad2D<ScratchReal>::shmem_size(nhydro, nx1) * 2;
+
+  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
+  auto cons_in = md->PackVariablesAndFluxes(std::vector<std::string>{"cons"},
+                                            std::vector<std::string>{"cons"});
+  auto riemann = Riemann<fluid, rsolver>();
+
+  return TimeKernel(
+      [&]() {
+        parthenon::par_for_outer(
+            DEFAULT_OUTER_LOOP_PATTERN, "Hydro::BenchmarkRiemannSolver", DevExecSpace(),
+            scratch_size_in_bytes, scratch_level, 0, cons_in.GetDim(5) - 1, kb.s, kb.e,
+            jb.s, jb.e,
+            KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k,
+                          const int j) {
+              const auto &prim = prim_in(b);
+              auto &cons = cons_in(b);
+              parthenon::ScratchPad2D<ScratchReal> wl(member.team_scratch(scratch_level),
+                                                      nhydro, nx1);
+              parthenon::ScratchPad2D<ScratchReal> wr(member.team_scratch(scratch_level),
+                                                      nhydro, nx1);
+              Reconstruct<Reconstruction::dc, X1DIR>(member, k, j, ib.s - 1, ib.e, prim,
+                                                     wl, wr, 0, nhydro - 1);
+              member.team_barrier();
+              riemann.Solve(member, k, j, ib.s, ib.e, IV1, wl, wr, cons, eos, c_h);
+            });
+      },
+      num_repeat);
+}
+
+// Names, seconds per call, and number of variables read and written per cell
+struct Results {
+  std::vector<std::string> names;
+  std::vector<Real> seconds;
+  std::vector<int> nvars;
+
+  void Add(const std::string &name, const Real sec, const int nv) {
+    names.push_back(name);
+    seconds.push_back(sec);
+    nvars.push_back(nv);
+  }
+};
+
+template <Reconstruction recon>
+void AddReconstruction(MeshData<Real> *md, const std::string &name, const int ndim,
+                       const int nvars, const int num_repeat, Results &results) {
+  results.Add(name + " x1", TimeReconstruction<recon, X1DIR>(md, num_repeat), nvars);
+  if (ndim >= 2) {
+    results.Add(name + " x2", TimeReconstruction<recon, X2DIR>(md, num_repeat), nvars);
+  }
+  if (ndim >= 3) {
+    results.Add(name + " x3", TimeReconstruction<recon, X3DIR>(md, num_repeat), nvars);
+  }
+}
+} // namespace
+
+void BenchmarkKernels(Mesh *pmesh) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  auto &md = pmesh->mesh_data.GetOrAdd("base", 0);
+  const auto num_repeat = hydro_pkg->Param<int>("kernel_benchmark_num_repeat");
+  const auto ndim = hydro_pkg->Param<int>("ndim");
+  const auto fluid = hydro_pkg->Param<Fluid>("fluid");
+  const int nhydro = hydro_pkg->Param<int>("nhydro");
+  const int nvars = nhydro + hydro_pkg->Param<int>("nscalars");
+
+  Results results;
+  AddReconstruction<Reconstruction::dc>(md.get(), "dc", ndim, nvars, num_repeat,
+                                        results);
+  AddReconstruction<Reconstruction::plm>(md.get(), "plm", ndim, nvars, num_repeat,
+                                         results);
+  AddReconstruction<Reconstruction::ppm>(md.get(), "ppm", ndim, nvars, num_repeat,
+                                         results);
+  AddReconstruction<Reconstruction::wenoz>(md.get(), "wenoz", ndim, nvars, num_repeat,
+                                           results);
+  AddReconstruction<Reconstruction::weno3>(md.get(), "weno3", ndim, nvars, num_repeat,
+                                           results);
+  AddReconstruction<Reconstruction::limo3>(md.get(), "limo3", ndim, nvars, num_repeat,
+                                           results);
+
+  if (fluid == Fluid::glmmhd) {
+    using EOS = AdiabaticGLMMHDEOS;
+    constexpr auto GLMMHD = Fluid::glmmhd;
+    results.Add("hlle",
+                TimeRiemannSolver<GLMMHD, RiemannSolver::hlle, EOS>(md.get(), num_repeat),
+                nhydro);
+    results.Add("hlld",
+                TimeRiemannSolver<GLMMHD, RiemannSolver::hlld, EOS>(md.get(), num_repeat),
+                nhydro);
+    results.Add("llf",
+                TimeRiemannSolver<GLMMHD, RiemannSolver::llf, EOS>(md.get(), num_repeat),
+                nhydro);
+  } else if (hydro_pkg->Param<EosType>("eos_type") == EosType::tabulated) {
+    using EOS = TabulatedHydroEOS;
+    constexpr auto EULER = Fluid::euler;
+    results.Add("hlle",
+                TimeRiemannSolver<EULER, RiemannSolver::hlle, EOS>(md.get(), num_repeat),
+                nhydro);
+    results.Add("llf",
+                TimeRiemannSolver<EULER, RiemannSolver::llf, EOS>(md.get(), num_repeat),
+                nhydro);
+  } else {
+    using EOS = AdiabaticHydroEOS;
+    constexpr auto EULER = Fluid::euler;
+    results.Add("hlle",
+                TimeRiemannSolver<EULER, RiemannSolver::hlle, EOS>(md.get(), num_repeat),
+                nhydro);
+    results.Add("hllc",
+                TimeRiemannSolver<EULER, RiemannSolver::hllc, EOS>(md.get(), num_repeat),
+                nhydro);
+    results.Add("llf",
+                TimeRiemannSolver<EULER, RiemannSolver::llf, EOS>(md.get(), num_repeat),
+                nhydro);
+  }
+
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  const Real ncells = static_cast<Real>(md->NumBlocks()) *
+                      pmb->cellbounds.GetTotal(IndexDomain::interior);
+  if (parthenon::Globals::my_rank == 0) {
+    std::cout << "Hydro kernel benchmark on " << DevExecSpace::name() << " ("
+              << md->NumBlocks() << " blocks of " << pmb->block_size.nx(X1DIR) << "x"
+              << pmb->block_size.nx(X2DIR) << "x" << pmb->block_size.nx(X3DIR)
+              << " cells, " << num_repeat << " repetitions):\n";
+    for (size_t n = 0; n < results.names.size(); n++) {
+      // Effective bandwidth assuming that each variable is read and written once per cell
+      const Real bytes = 2.0 * ncells * results.nvars[n] * sizeof(Real);
+      std::cout << "  " << results.names[n] << ": " << ncells / results.seconds[n]
+                << " cells/s, " << bytes / results.seconds[n] / 1e9 << " GB/s\n";
+    }
+    std::cout << std::flush;
+  }
+}
+
+} // namespace Hydro
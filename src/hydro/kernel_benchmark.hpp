@@ -0,0 +1,28 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file kernel_benchmark.hpp
+//! \brief Startup benchmark of the reconstruction and Riemann solver kernels
+
+#ifndef HYDRO_KERNEL_BENCHMARK_HPP_
+#define HYDRO_KERNEL_BENCHMARK_HPP_
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+using namespace parthenon::package::prelude;
+
+namespace Hydro {
+
+// Times all reconstruction methods (in all directions) and all Riemann solvers of the
+// current fluid (and equation of state) separately on the first MeshData partition and
+// prints their throughput (in cells/s) and effective bandwidth.
+// Only the fluxes are overwritten (which are recalculated in every stage) so that this
+// can be called on the actual data.
+void BenchmarkKernels(Mesh *pmesh);
+
+} // namespace Hydro
+
+#endif // HYDRO_KERNEL_BENCHMARK_HPP_
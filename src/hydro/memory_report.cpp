@@ -0,0 +1,237 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file memory_report.cpp
+//! \brief Report of the memory footprint per package and register
+
+// C++ headers
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+#include "globals.hpp"
+
+// AthenaPK headers
+#include "../main.hpp"
+#include "memory_report.hpp"
+#include "srcterms/tabular_cooling.hpp"
+
+namespace Hydro {
+
+namespace {
+// Bytes of data (or zero if the data has already been counted)
+template <typename T>
+Real DataBytes(const T &data, std::set<const void *> &seen) {
+  if (data.size() == 0 || !seen.insert(data.data()).second) {
+    return 0.0;
+  }
+  return static_cast<Real>(data.size() * sizeof(*data.data()));
+}
+
+// Bytes of a variable (and its fluxes) that have not been counted yet
+template <typename V>
+Real VariableBytes(const V &var, const bool fluxes, std::set<const void *> &seen) {
+  Real bytes = DataBytes(var->data, seen);
+  if (fluxes && var->IsSet(Metadata::WithFluxes)) {
+    for (int d = X1DIR; d <= X3DIR; d++) {
+      bytes += DataBytes(var->flux[d], seen);
+    }
+  }
+  return bytes;
+}
+
+// Named byte counts that are accumulated over blocks (in the same order on all blocks
+// and ranks) followed by the ones of the rank
+class Entries {
+ public:
+  // Adds bytes of the current block
+  void Add(const std::string &name, const Real bytes) {
+    if (first_block_) {
+      Append(name, bytes);
+    } else {
+      bytes_[n_++] += bytes;
+    }
+  }
+  void NextBlock() {
+    first_block_ = names_.empty();
+    n_ = 0;
+  }
+  void Append(const std::string &name, const Real bytes) {
+    names_.push_back(name);
+    bytes_.push_back(bytes);
+  }
+  Real Sum() const {
+    Real sum = 0.0;
+    for (const auto &bytes : bytes_) {
+      sum += bytes;
+    }
+    return sum;
+  }
+  std::vector<std::string> names_;
+  std::vector<Real> bytes_;
+
+ private:
+  bool first_block_ = true;
+  size_t n_ = 0;
+};
+} // namespace
+
+void ReportMemoryFootprint(Mesh *pmesh, const std::string &when) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  auto tracers_pkg = pmesh->packages.Get("tracers");
+  const auto diffint = hydro_pkg->Param<DiffInt>("diffint");
+
+  // Registers allocated by the integrators (see HydroDriver), which may not exist yet
+  std::vector<std::string> int_registers = {"u1"};
+  if (diffint == DiffInt::rkl1 || diffint == DiffInt::rkl2) {
+    int_registers.emplace_back("Yjm2");
+  }
+  if (diffint == DiffInt::rkl2) {
+    int_registers.emplace_back("MY0");
+  }
+
+  // Assumes that all ranks hold at least one block so that all ranks add the same entries
+  Entries entries;
+  const auto &blocks = pmesh->block_list;
+  for (const auto &pmb : blocks) {
+    entries.NextBlock();
+    // Data shared between registers (e.g., OneCopy variables) is counted once
+    std::set<const void *> seen;
+    auto &base = pmb->meshblock_data.Get();
+
+    // Variables of the base register by package
+    std::set<std::string> counted;
+    for (const auto &[pkg_name, pkg] : pmesh->packages.AllPackages()) {
+      Real bytes = 0.0;
+      for (const auto &var : base->GetVariableVector()) {
+        if (pkg->FieldPresent(var->label()) && counted.insert(var->label()).second) {
+          bytes += VariableBytes(var, false, seen);
+        }
+      }
+      entries.Add("package " + pkg_name, bytes);
+    }
+    Real other_bytes = 0.0;
+    Real flux_bytes = 0.0;
+    // Full copy of the base register (with fluxes) without the OneCopy variables
+    Real copy_bytes = 0.0;
+    for (const auto &var : base->GetVariableVector()) {
+      if (counted.count(var->label()) == 0) {
+        other_bytes += VariableBytes(var, false, seen);
+      }
+      std::set<const void *> unseen;
+      if (!var->IsSet(Metadata::OneCopy)) {
+        copy_bytes += VariableBytes(var, true, unseen);
+      }
+      if (var->IsSet(Metadata::WithFluxes)) {
+        for (int d = X1DIR; d <= X3DIR; d++) {
+          flux_bytes += DataBytes(var->flux[d], seen);
+        }
+      }
+    }
+    entries.Add("other variables", other_bytes);
+    entries.Add("fluxes", flux_bytes);
+
+    // Additional registers (only the data that is not shared with other registers) and
+    // predicted integrator registers that are not allocated yet
+    for (const auto &[name, mbd] : pmb->meshblock_data.Stages()) {
+      if (name == "base") {
+        continue;
+      }
+      Real bytes = 0.0;
+      for (const auto &var : mbd->GetVariableVector()) {
+        bytes += VariableBytes(var, true, seen);
+      }
+      entries.Add("register " + name, bytes);
+    }
+    for (const auto &name : int_registers) {
+      if (pmb->meshblock_data.Stages().count(name) == 0) {
+        entries.Add("register " + name + " (predicted)", copy_bytes);
+      }
+    }
+
+    if (tracers_pkg->Param<bool>("enabled")) {
+      const auto &swarm = base->GetSwarmData()->Get("tracers");
+      Real bytes = 0.0;
+      for (const auto &var : swarm->GetVariableVector<Real>()) {
+        bytes += DataBytes(var->data, seen);
+      }
+      for (const auto &var : swarm->GetVariableVector<int>()) {
+        bytes += DataBytes(var->data, seen);
+      }
+      entries.Add("tracers swarm", bytes);
+    }
+  }
+  const int nblocks = static_cast<int>(blocks.size());
+  const Real block_bytes = entries.Sum();
+
+  // Per rank allocations
+  if (hydro_pkg->Param<Cooling>("enable_cooling") == Cooling::tabular) {
+    const auto &tabular_cooling =
+        hydro_pkg->Param<cooling::TabularCooling>("tabular_cooling");
+    entries.Append("cooling tables", static_cast<Real>(tabular_cooling.TableBytes()));
+  }
+  // Scratch memory per team of the flux kernels (the x2 and x3 kernels use the most)
+  const auto &cb = blocks[0]->cellbounds;
+  const int nvars = hydro_pkg->Param<int>("nhydro") + hydro_pkg->Param<int>("nscalars");
+  const auto scratch_per_team = static_cast<Real>(
+      parthenon::ScratchPad2D<ScratchReal>::shmem_size(nvars,
+                                                       cb.ncellsi(IndexDomain::entire)) *
+      3);
+  const int scratch_level = hydro_pkg->Param<int>("scratch_level");
+  if (scratch_level == 1) {
+    // Upper bound assuming all teams of the largest partition being in flight
+    const int num_partitions = pmesh->DefaultNumPartitions();
+    const int blocks_per_partition = (nblocks + num_partitions - 1) / num_partitions;
+    entries.Append("flux kernel scratch (upper bound)",
+                   scratch_per_team * blocks_per_partition *
+                       cb.ncellsk(IndexDomain::entire) *
+                       cb.ncellsj(IndexDomain::entire));
+  }
+
+  // Predicted peak, bytes of all blocks, and number of blocks are reduced in addition
+  std::vector<Real> max_bytes = entries.bytes_;
+  max_bytes.push_back(entries.Sum());
+  max_bytes.push_back(block_bytes);
+  max_bytes.push_back(nblocks);
+  std::vector<Real> sum_bytes = max_bytes;
+#ifdef MPI_PARALLEL
+  const bool root = parthenon::Globals::my_rank == 0;
+  const int n = static_cast<int>(max_bytes.size());
+  PARTHENON_MPI_CHECK(MPI_Reduce(root ? MPI_IN_PLACE : max_bytes.data(),
+                                 max_bytes.data(), n, MPI_PARTHENON_REAL, MPI_MAX, 0,
+                                 MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Reduce(root ? MPI_IN_PLACE : sum_bytes.data(),
+                                 sum_bytes.data(), n, MPI_PARTHENON_REAL, MPI_SUM, 0,
+                                 MPI_COMM_WORLD));
+#endif
+
+  if (parthenon::Globals::my_rank == 0) {
+    constexpr Real MiB = 1024.0 * 1024.0;
+    const auto num = entries.names_.size();
+    std::cout << "Memory footprint " << when << " in MiB (max per rank, total):"
+              << std::endl
+              << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < num; i++) {
+      std::cout << "  " << entries.names_[i] << ": " << max_bytes[i] / MiB << ", "
+                << sum_bytes[i] / MiB << std::endl;
+    }
+    std::cout << "  predicted peak: " << max_bytes[num] / MiB << ", "
+              << sum_bytes[num] / MiB << std::endl;
+    std::cout << "  per block: " << sum_bytes[num + 1] / sum_bytes[num + 2] / MiB
+              << " (with up to " << static_cast<int>(max_bytes[num + 2])
+              << " blocks per rank)" << std::endl;
+    std::cout << "  flux kernel scratch per team: " << scratch_per_team / 1024.0
+              << " KiB (scratch level " << scratch_level << ")" << std::defaultfloat
+              << std::endl;
+  }
+}
+
+} // namespace Hydro
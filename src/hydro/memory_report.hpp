@@ -0,0 +1,33 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file memory_report.hpp
+//! \brief Report of the memory footprint per package and register
+
+#ifndef HYDRO_MEMORY_REPORT_HPP_
+#define HYDRO_MEMORY_REPORT_HPP_
+
+// C++ headers
+#include <string>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+using namespace parthenon::package::prelude;
+
+namespace Hydro {
+
+// Prints the memory (maximum per rank and total across ranks) allocated for the
+// variables of each package, the fluxes, the additional registers (including the
+// registers of the integrators that are only allocated later, e.g., of the RKL2
+// integrator), the tracer swarm, the cooling tables, and the scratch memory of the flux
+// kernels as well as the predicted peak (excluding transient allocations, e.g., during
+// remeshing). Data shared between registers is counted once.
+// To be called collectively after (re)meshing. when describes the occasion.
+void ReportMemoryFootprint(Mesh *pmesh, const std::string &when);
+
+} // namespace Hydro
+
+#endif // HYDRO_MEMORY_REPORT_HPP_
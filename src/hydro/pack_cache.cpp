@@ -0,0 +1,127 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file pack_cache.cpp
+//! \brief Cache of the variable packs and params used by the hot hydro tasks
+
+// C++ headers
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "pack_cache.hpp"
+
+namespace Hydro::pack_cache {
+
+struct PackCache::Entry {
+  std::shared_ptr<MeshData<Real>> md;
+  parthenon::MeshBlockVarPack<Real> cons, prim;
+  parthenon::MeshBlockVarFluxPack<Real> cons_flux, ind_flux;
+};
+
+namespace {
+HydroParams params;
+bool enabled = false;
+// Cache of the driver (if any), see PackCache
+const std::unordered_map<MeshData<Real> *, std::unique_ptr<PackCache::Entry>>
+    *active_entries = nullptr;
+
+// Returns pack of the cached entry of md or, if there is none, the result of build
+template <typename Pack, typename Build>
+Pack Get(MeshData<Real> *md, Pack PackCache::Entry::*pack, const Build &build) {
+  if (active_entries != nullptr) {
+    const auto it = active_entries->find(md);
+    if (it != active_entries->end()) {
+      return (*it->second).*pack;
+    }
+  }
+  return build();
+}
+
+parthenon::MeshBlockVarPack<Real> BuildCons(MeshData<Real> *md) {
+  return md->PackVariables(params.cons_names);
+}
+parthenon::MeshBlockVarFluxPack<Real> BuildConsAndFluxes(MeshData<Real> *md) {
+  return md->PackVariablesAndFluxes(params.cons_names, params.cons_names);
+}
+parthenon::MeshBlockVarPack<Real> BuildPrim(MeshData<Real> *md) {
+  return md->PackVariables(params.prim_names);
+}
+parthenon::MeshBlockVarFluxPack<Real> BuildIndependentAndFluxes(MeshData<Real> *md) {
+  return md->PackVariablesAndFluxes(
+      std::vector<parthenon::MetadataFlag>{Metadata::Independent});
+}
+} // namespace
+
+void Initialize(StateDescriptor *hydro_pkg) {
+  params.nhydro = hydro_pkg->Param<int>("nhydro");
+  params.nscalars = hydro_pkg->Param<int>("nscalars");
+  params.ndim = hydro_pkg->Param<int>("ndim");
+  UpdateLaunchParams(hydro_pkg);
+  params.sparse_scalars = hydro_pkg->Param<bool>("sparse_scalars");
+  params.hybrid_reconstruction = hydro_pkg->Param<bool>("hybrid_reconstruction");
+  params.cons_names = hydro_pkg->Param<std::vector<std::string>>("cons_names");
+  params.prim_names = hydro_pkg->Param<std::vector<std::string>>("prim_names");
+  enabled = hydro_pkg->Param<bool>("pack_cache") && !params.sparse_scalars;
+}
+
+const HydroParams &GetParams() { return params; }
+
+void UpdateLaunchParams(StateDescriptor *hydro_pkg) {
+  params.scratch_level = hydro_pkg->Param<int>("scratch_level");
+  params.flux_tile_sweep = hydro_pkg->Param<int>("flux_tile_sweep");
+  params.flux_tile_transverse = hydro_pkg->Param<int>("flux_tile_transverse");
+}
+
+parthenon::MeshBlockVarPack<Real> Cons(MeshData<Real> *md) {
+  return Get(md, &PackCache::Entry::cons, [md]() { return BuildCons(md); });
+}
+
+parthenon::MeshBlockVarFluxPack<Real> ConsAndFluxes(MeshData<Real> *md) {
+  return Get(md, &PackCache::Entry::cons_flux,
+             [md]() { return BuildConsAndFluxes(md); });
+}
+
+parthenon::MeshBlockVarPack<Real> Prim(MeshData<Real> *md) {
+  return Get(md, &PackCache::Entry::prim, [md]() { return BuildPrim(md); });
+}
+
+parthenon::MeshBlockVarFluxPack<Real> IndependentAndFluxes(MeshData<Real> *md) {
+  return Get(md, &PackCache::Entry::ind_flux,
+             [md]() { return BuildIndependentAndFluxes(md); });
+}
+
+PackCache::PackCache() {
+  PARTHENON_REQUIRE_THROWS(active_entries == nullptr,
+                           "Only a single PackCache may exist at a time.");
+  active_entries = &entries_;
+}
+
+PackCache::~PackCache() {
+  active_entries = nullptr;
+  Clear();
+}
+
+void PackCache::Add(const std::shared_ptr<MeshData<Real>> &md) {
+  if (!enabled || entries_.count(md.get()) > 0) {
+    return;
+  }
+  auto entry = std::make_unique<Entry>();
+  entry->md = md;
+  entry->cons = BuildCons(md.get());
+  entry->cons_flux = BuildConsAndFluxes(md.get());
+  entry->prim = BuildPrim(md.get());
+  entry->ind_flux = BuildIndependentAndFluxes(md.get());
+  entries_[md.get()] = std::move(entry);
+}
+
+void PackCache::Clear() { entries_.clear(); }
+
+} // namespace Hydro::pack_cache
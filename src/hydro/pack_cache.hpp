@@ -0,0 +1,81 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file pack_cache.hpp
+//! \brief Cache of the variable packs and params used by the hot hydro tasks
+
+#ifndef HYDRO_PACK_CACHE_HPP_
+#define HYDRO_PACK_CACHE_HPP_
+
+// C++ headers
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+using namespace parthenon::package::prelude;
+
+namespace Hydro::pack_cache {
+
+// Params of the Hydro package used by the hot tasks, resolved once at initialization so
+// that the tasks do not need string lookups
+struct HydroParams {
+  int nhydro, nscalars, ndim;
+  int scratch_level, flux_tile_sweep, flux_tile_transverse;
+  bool sparse_scalars, hybrid_reconstruction;
+  std::vector<std::string> cons_names, prim_names;
+};
+
+// Resolves the params and enables the pack cache (with <hydro/pack_cache>).
+// To be called at the end of Hydro::Initialize.
+void Initialize(StateDescriptor *hydro_pkg);
+const HydroParams &GetParams();
+// Resolves the launch params of the flux kernels again (after they have been changed,
+// e.g., by the autotuning)
+void UpdateLaunchParams(StateDescriptor *hydro_pkg);
+
+// Packs of md (of any register) of "cons_names" (with or without fluxes), "prim_names",
+// and all Independent variables with fluxes.
+// With the cache, the packs of the MeshData added to the PackCache of the driver are
+// built when the task lists are created and returned without any locking or comparison
+// of blocks. Packs of other MeshData (or all without the cache or with sparse scalars,
+// whose packs depend on their allocation) are built through Parthenon's pack cache on
+// every call.
+parthenon::MeshBlockVarPack<Real> Cons(MeshData<Real> *md);
+parthenon::MeshBlockVarFluxPack<Real> ConsAndFluxes(MeshData<Real> *md);
+parthenon::MeshBlockVarPack<Real> Prim(MeshData<Real> *md);
+parthenon::MeshBlockVarFluxPack<Real> IndependentAndFluxes(MeshData<Real> *md);
+
+// Packs of the MeshData used by the tasks of the driver owning the cache. Only a single
+// instance may exist at a time, which is used by the functions above during its lifetime
+// so that all packs are released with the driver, i.e., before Kokkos is finalized.
+class PackCache {
+ public:
+  PackCache();
+  ~PackCache();
+  PackCache(const PackCache &) = delete;
+  PackCache &operator=(const PackCache &) = delete;
+
+  // Builds the packs of md unless they already exist (no-op without the cache).
+  // Must not be called while tasks are executed as the packs are read without locking.
+  // The MeshData is kept alive with its packs so that its address cannot be reused by a
+  // different one.
+  void Add(const std::shared_ptr<MeshData<Real>> &md);
+  // Drops all packs (e.g., after remeshing as the blocks of the MeshData change)
+  void Clear();
+
+  // Packs of a MeshData
+  struct Entry;
+
+ private:
+  std::unordered_map<MeshData<Real> *, std::unique_ptr<Entry>> entries_;
+};
+
+} // namespace Hydro::pack_cache
+
+#endif // HYDRO_PACK_CACHE_HPP_
@@ -77,7 +77,25 @@ struct ProlongateCellMinModMultiD {
     constexpr bool INCLUDE_X3 =
         (DIM > 2) && (el == TE::CC || el == TE::F1 || el == TE::F2 || el == TE::E3);
 
-    const Real fc = coarse(element_idx, l, m, n, k, j, i);
+    constexpr int jlim = (DIM > 1) ? 1 : 0;
+    constexpr int klim = (DIM > 2) ? 1 : 0;
+    // Load the coarse stencil once. It is used for the slopes and the extrema and a
+    // single pass over it (instead of repeated reads through the (possibly aliasing)
+    // buffers) reduces the memory traffic of the prolongation kernels.
+    Real q[3][3][3];
+    Real qmin = coarse(element_idx, l, m, n, k, j, i);
+    Real qmax = qmin;
+    for (int koff = -klim; koff <= klim; koff++) {
+      for (int joff = -jlim; joff <= jlim; joff++) {
+        for (int ioff = -1; ioff <= 1; ioff++) {
+          const Real qc = coarse(element_idx, l, m, n, k + koff, j + joff, i + ioff);
+          q[koff + 1][joff + 1][ioff + 1] = qc;
+          qmin = std::min(qmin, qc);
+          qmax = std::max(qmax, qc);
+        }
+      }
+    }
+    const Real fc = q[1][1][1];
 
     Real dx1fm = 0;
     Real dx1fp = 0;
@@ -87,9 +105,7 @@ struct ProlongateCellMinModMultiD {
       Real dx1m, dx1p;
       GetGridSpacings<1, el>(coords, coarse_coords, cib, ib, i, fi, &dx1m, &dx1p, &dx1fm,
                              &dx1fp);
-      gx1c =
-          GradMinMod(fc, coarse(element_idx, l, m, n, k, j, i - 1),
-                     coarse(element_idx, l, m, n, k, j, i + 1), dx1m, dx1p, gx1m, gx1p);
+      gx1c = GradMinMod(fc, q[1][1][0], q[1][1][2], dx1m, dx1p, gx1m, gx1p);
     }
 
     Real dx2fm = 0;
@@ -100,9 +116,7 @@ struct ProlongateCellMinModMultiD {
       Real dx2m, dx2p;
       GetGridSpacings<2, el>(coords, coarse_coords, cjb, jb, j, fj, &dx2m, &dx2p, &dx2fm,
                              &dx2fp);
-      gx2c =
-          GradMinMod(fc, coarse(element_idx, l, m, n, k, j - 1, i),
-                     coarse(element_idx, l, m, n, k, j + 1, i), dx2m, dx2p, gx2m, gx2p);
+      gx2c = GradMinMod(fc, q[1][0][1], q[1][2][1], dx2m, dx2p, gx2m, gx2p);
     }
     Real dx3fm = 0;
     Real dx3fp = 0;
@@ -112,35 +126,16 @@ struct ProlongateCellMinModMultiD {
       Real dx3m, dx3p;
       GetGridSpacings<3, el>(coords, coarse_coords, ckb, kb, k, fk, &dx3m, &dx3p, &dx3fm,
                              &dx3fp);
-      gx3c =
-          GradMinMod(fc, coarse(element_idx, l, m, n, k - 1, j, i),
-                     coarse(element_idx, l, m, n, k + 1, j, i), dx3m, dx3p, gx3m, dx3p);
+      gx3c = GradMinMod(fc, q[0][1][1], q[2][1][1], dx3m, dx3p, gx3m, gx3p);
     }
 
     // Max. expected total difference. (dx#fm/p are positive by construction)
     Real dqmax = std::abs(gx1c) * std::max(dx1fm, dx1fp);
-    int jlim = 0;
-    int klim = 0;
     if constexpr (DIM > 1) {
       dqmax += std::abs(gx2c) * std::max(dx2fm, dx2fp);
-      jlim = 1;
     }
     if constexpr (DIM > 2) {
       dqmax += std::abs(gx3c) * std::max(dx3fm, dx3fp);
-      klim = 1;
-    }
-    // Min/max values of all coarse cells used here
-    Real qmin = fc;
-    Real qmax = fc;
-    for (int koff = -klim; koff <= klim; koff++) {
-      for (int joff = -jlim; joff <= jlim; joff++) {
-        for (int ioff = -1; ioff <= 1; ioff++) {
-          qmin =
-              std::min(qmin, coarse(element_idx, l, m, n, k + koff, j + joff, i + ioff));
-          qmax =
-              std::max(qmax, coarse(element_idx, l, m, n, k + koff, j + joff, i + ioff));
-        }
-      }
     }
 
     // Scaling factor to limit all slopes simultaneously
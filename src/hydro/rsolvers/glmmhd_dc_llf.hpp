@@ -158,8 +158,9 @@ struct Riemann<Fluid::glmmhd, RiemannSolver::llf> {
     cons.flux(ivx, iBz, k, j, i) = 0.5 * (fsum.bz - du.bz);
     cons.flux(ivx, IPS, k, j, i) = SQR(c_h) * bxi;
 
-    // Passive scalar fluxes
+    // Passive scalar fluxes (of the scalars allocated on the block)
     for (auto n = Hydro::GetNVars<Fluid::glmmhd>(); n < cons.GetDim(4); ++n) {
+      if (!cons.IsAllocated(n)) continue;
       if (cons.flux(ivx, IDN, k, j, i) >= 0.0) {
         if (ivx == 1) {
           cons.flux(ivx, n, k, j, i) =
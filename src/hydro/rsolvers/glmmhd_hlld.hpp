@@ -39,8 +39,8 @@ template <>
 struct Riemann<Fluid::glmmhd, RiemannSolver::hlld> {
   static KOKKOS_INLINE_FUNCTION void
   Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-        const int iu, const int ivx, const ScratchPad2D<Real> &wl,
-        const ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
+        const int iu, const int ivx, const ScratchPad2D<ScratchReal> &wl,
+        const ScratchPad2D<ScratchReal> &wr, VariableFluxPack<Real> &cons,
         const AdiabaticGLMMHDEOS &eos, const Real c_h) {
     const int ivy = IV1 + ((ivx - IV1) + 1) % 3;
     const int ivz = IV1 + ((ivx - IV1) + 2) % 3;
@@ -41,14 +41,14 @@ struct HydCons1D {
 
 template <>
 struct Riemann<Fluid::euler, RiemannSolver::llf> {
-  static KOKKOS_INLINE_FUNCTION void Solve(const AdiabaticHydroEOS &eos, const int k,
-                                           const int j, const int i, const int ivx,
+  template <typename EOS>
+  static KOKKOS_INLINE_FUNCTION void Solve(const EOS &eos, const int k, const int j,
+                                           const int i, const int ivx,
                                            const VariablePack<Real> &prim,
                                            VariableFluxPack<Real> &cons,
                                            const Real /* c_h */) {
     const int ivy = IV1 + ((ivx - IV1) + 1) % 3;
     const int ivz = IV1 + ((ivx - IV1) + 2) % 3;
-    const Real igm1 = 1.0 / (eos.GetGamma() - 1.0);
 
     //--- Step 1.  Use first order reconstruction
     Real wli[(NHYDRO)];
@@ -91,9 +91,9 @@ struct Riemann<Fluid::euler, RiemannSolver::llf> {
     fsum.mz = qa * wli[IV3] + qb * wri[IV3];
 
     Real el, er;
-    el = wli[IPR] * igm1 +
+    el = eos.InternalEnergyFromPressure(wli[IDN], wli[IPR]) +
          0.5 * wli[IDN] * (SQR(wli[IV1]) + SQR(wli[IV2]) + SQR(wli[IV3]));
-    er = wri[IPR] * igm1 +
+    er = eos.InternalEnergyFromPressure(wri[IDN], wri[IPR]) +
          0.5 * wri[IDN] * (SQR(wri[IV1]) + SQR(wri[IV2]) + SQR(wri[IV3]));
     fsum.mx += (wli[IPR] + wri[IPR]);
     fsum.e = (el + wli[IPR]) * wli[IV1] + (er + wri[IPR]) * wri[IV1];
@@ -121,8 +121,9 @@ struct Riemann<Fluid::euler, RiemannSolver::llf> {
     cons.flux(ivx, ivz, k, j, i) = 0.5 * (fsum.mz - du.mz);
     cons.flux(ivx, IEN, k, j, i) = 0.5 * (fsum.e - du.e);
 
-    // Passive scalar fluxes
+    // Passive scalar fluxes (of the scalars allocated on the block)
     for (auto n = Hydro::GetNVars<Fluid::euler>(); n < cons.GetDim(4); ++n) {
+      if (!cons.IsAllocated(n)) continue;
       if (cons.flux(ivx, IDN, k, j, i) >= 0.0) {
         if (ivx == 1) {
           cons.flux(ivx, n, k, j, i) =
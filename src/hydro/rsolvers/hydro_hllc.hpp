@@ -22,6 +22,7 @@
 
 // AthenaPK headers
 #include "../../main.hpp"
+#include "../../utils/simd.hpp"
 #include "rsolvers.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -32,8 +33,8 @@ template <>
 struct Riemann<Fluid::euler, RiemannSolver::hllc> {
   static KOKKOS_INLINE_FUNCTION void
   Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-        const int iu, const int ivx, const ScratchPad2D<Real> &wl,
-        const ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
+        const int iu, const int ivx, const ScratchPad2D<ScratchReal> &wl,
+        const ScratchPad2D<ScratchReal> &wr, VariableFluxPack<Real> &cons,
         const AdiabaticHydroEOS &eos, const Real c_h) {
     int ivy = IV1 + ((ivx - IV1) + 1) % 3;
     int ivz = IV1 + ((ivx - IV1) + 2) % 3;
@@ -41,7 +42,13 @@ struct Riemann<Fluid::euler, RiemannSolver::hllc> {
     Real gm1 = gamma - 1.0;
     Real igm1 = 1.0 / gm1;
 
-    parthenon::par_for_inner(member, il, iu, [&](const int i) {
+    int is = il;
+#ifdef ATHENAPK_HOST_SIMD
+    // Full SIMD-width chunks, the remainder is handled by the scalar loop below
+    is = SolveChunks(member, k, j, il, iu, ivx, wl, wr, cons, gamma);
+#endif
+
+    parthenon::par_for_inner(member, is, iu, [&](const int i) {
       Real wli[(NHYDRO)], wri[(NHYDRO)];
       Real fl[(NHYDRO)], fr[(NHYDRO)], flxi[(NHYDRO)];
       //--- Step 1.  Load L/R states into local variables
@@ -154,6 +161,96 @@ struct Riemann<Fluid::euler, RiemannSolver::hllc> {
       cons.flux(ivx, IEN, k, j, i) = flxi[IEN];
     });
   }
+
+#ifdef ATHENAPK_HOST_SIMD
+  // SIMD version of the solver above for all full chunks of [il, iu] (see
+  // utils/simd.hpp). Returns the first index that still needs to be solved.
+  static KOKKOS_INLINE_FUNCTION int
+  SolveChunks(parthenon::team_mbr_t const &member, const int k, const int j,
+              const int il, const int iu, const int ivx,
+              const ScratchPad2D<ScratchReal> &wl, const ScratchPad2D<ScratchReal> &wr,
+              VariableFluxPack<Real> &cons, const Real gamma) {
+    using utils::simd::Load, utils::simd::Select, utils::simd::Sqrt, utils::simd::Store,
+        utils::simd::Vec;
+    const int ivy = IV1 + ((ivx - IV1) + 1) % 3;
+    const int ivz = IV1 + ((ivx - IV1) + 2) % 3;
+    const Real gm1 = gamma - 1.0;
+    const Real igm1 = 1.0 / gm1;
+    const int nchunks = utils::simd::NumChunks(il, iu);
+
+    parthenon::par_for_inner(member, 0, nchunks - 1, [&](const int c) {
+      const int i = il + c * utils::simd::width;
+      //--- Step 1.  Load L/R states into local variables (u is the normal velocity)
+      const Vec dl = Load(&wl(IDN, i));
+      const Vec u_l = Load(&wl(ivx, i));
+      const Vec vyl = Load(&wl(ivy, i));
+      const Vec vzl = Load(&wl(ivz, i));
+      const Vec pl = Load(&wl(IPR, i));
+
+      const Vec dr = Load(&wr(IDN, i));
+      const Vec u_r = Load(&wr(ivx, i));
+      const Vec vyr = Load(&wr(ivy, i));
+      const Vec vzr = Load(&wr(ivz, i));
+      const Vec pr = Load(&wr(IPR, i));
+
+      //--- Step 2.  Compute middle state estimates with PVRS (Toro 10.5.2)
+      const Vec cl = Sqrt(gamma * pl / dl);
+      const Vec cr = Sqrt(gamma * pr / dr);
+      const Vec el = pl * igm1 + 0.5 * dl * (SQR(u_l) + SQR(vyl) + SQR(vzl));
+      const Vec er = pr * igm1 + 0.5 * dr * (SQR(u_r) + SQR(vyr) + SQR(vzr));
+      const Vec rhoa = .5 * (dl + dr);
+      const Vec ca = .5 * (cl + cr);
+      const Vec pmid = .5 * (pl + pr + (u_l - u_r) * rhoa * ca);
+
+      //--- Step 3.  Compute sound speed in L,R
+      const Vec ql = Select(pmid <= pl, Vec(1.0),
+                            Sqrt(1.0 + (gamma + 1) / (2 * gamma) * (pmid / pl - 1.0)));
+      const Vec qr = Select(pmid <= pr, Vec(1.0),
+                            Sqrt(1.0 + (gamma + 1) / (2 * gamma) * (pmid / pr - 1.0)));
+
+      //--- Step 4.  Compute the max/min wave speeds based on L/R
+      const Vec al = u_l - cl * ql;
+      const Vec ar = u_r + cr * qr;
+
+      const Vec bp = Select(ar > Vec(0.0), ar, Vec(TINY_NUMBER));
+      const Vec bm = Select(al < Vec(0.0), al, Vec(-(TINY_NUMBER)));
+
+      //--- Step 5. Compute the contact wave speed and pressure
+      Vec vxl = u_l - al;
+      Vec vxr = u_r - ar;
+
+      const Vec tl = pl + vxl * dl * u_l;
+      const Vec tr = pr + vxr * dr * u_r;
+
+      const Vec ml = dl * vxl;
+      const Vec mr = -(dr * vxr);
+
+      const Vec am = (tl - tr) / (ml + mr);
+      Vec cp = (ml * tr + mr * tl) / (ml + mr);
+      cp = Select(cp > Vec(0.0), cp, Vec(0.0));
+
+      //--- Step 6. Compute L/R fluxes along the line bm, bp
+      vxl = u_l - bm;
+      vxr = u_r - bp;
+
+      //--- Step 8. Compute flux weights or scales
+      const auto upwind_l = am >= Vec(0.0);
+      const Vec sl = Select(upwind_l, am / (am - bm), Vec(0.0));
+      const Vec sr = Select(upwind_l, Vec(0.0), -am / (bp - am));
+      const Vec sm = Select(upwind_l, -bm / (am - bm), bp / (bp - am));
+
+      //--- Step 9. Compute the HLLC flux at interface
+      Store(sl * (dl * vxl) + sr * (dr * vxr), &cons.flux(ivx, IDN, k, j, i));
+      Store(sl * (dl * u_l * vxl + pl) + sr * (dr * u_r * vxr + pr) + sm * cp,
+            &cons.flux(ivx, ivx, k, j, i));
+      Store(sl * (dl * vyl * vxl) + sr * (dr * vyr * vxr), &cons.flux(ivx, ivy, k, j, i));
+      Store(sl * (dl * vzl * vxl) + sr * (dr * vzr * vxr), &cons.flux(ivx, ivz, k, j, i));
+      Store(sl * (el * vxl + pl * u_l) + sr * (er * vxr + pr * u_r) + sm * cp * am,
+            &cons.flux(ivx, IEN, k, j, i));
+    });
+    return il + nchunks * utils::simd::width;
+  }
+#endif // ATHENAPK_HOST_SIMD
 };
 
 #endif // RSOLVERS_HYDRO_HLLC_HPP_
@@ -35,20 +35,18 @@ using parthenon::Real;
 
 //----------------------------------------------------------------------------------------
 //! \fn void Hydro::RiemannSolver
-//  \brief The HLLE Riemann solver for hydrodynamics (adiabatic)
+//  \brief The HLLE Riemann solver for hydrodynamics (adiabatic or general EOS, see
+//  tabulated_hydro.hpp)
 template <>
 struct Riemann<Fluid::euler, RiemannSolver::hlle> {
+  template <typename EOS>
   static KOKKOS_INLINE_FUNCTION void
   Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-        const int iu, const int ivx, const ScratchPad2D<Real> &wl,
-        const ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
-        const AdiabaticHydroEOS &eos, const Real c_h) {
+        const int iu, const int ivx, const ScratchPad2D<ScratchReal> &wl,
+        const ScratchPad2D<ScratchReal> &wr, VariableFluxPack<Real> &cons,
+        const EOS &eos, const Real c_h) {
     int ivy = IV1 + ((ivx - IV1) + 1) % 3;
     int ivz = IV1 + ((ivx - IV1) + 2) % 3;
-    Real gamma;
-    gamma = eos.GetGamma();
-    Real gm1 = gamma - 1.0;
-    Real igm1 = 1.0 / gm1;
     parthenon::par_for_inner(member, il, iu, [&](const int i) {
       Real wli[(NHYDRO)], wri[(NHYDRO)], wroe[(NHYDRO)];
       Real fl[(NHYDRO)], fr[(NHYDRO)], flxi[(NHYDRO)];
@@ -77,9 +75,9 @@ struct Riemann<Fluid::euler, RiemannSolver::hlle> {
 
       // Following Roe(1981), the enthalpy H=(E+P)/d is averaged for adiabatic flows,
       // rather than E or P directly.  sqrtdl*hl = sqrtdl*(el+pl)/dl = (el+pl)/sqrtdl
-      const Real el = wli[IPR] * igm1 +
+      const Real el = eos.InternalEnergyFromPressure(wli[IDN], wli[IPR]) +
                       0.5 * wli[IDN] * (SQR(wli[IV1]) + SQR(wli[IV2]) + SQR(wli[IV3]));
-      const Real er = wri[IPR] * igm1 +
+      const Real er = eos.InternalEnergyFromPressure(wri[IDN], wri[IPR]) +
                       0.5 * wri[IDN] * (SQR(wri[IV1]) + SQR(wri[IV2]) + SQR(wri[IV3]));
       const Real hroe = ((el + wli[IPR]) / sqrtdl + (er + wri[IPR]) / sqrtdr) * isdlpdr;
 
@@ -88,7 +86,7 @@ struct Riemann<Fluid::euler, RiemannSolver::hlle> {
       const Real cl = eos.SoundSpeed(wli);
       const Real cr = eos.SoundSpeed(wri);
       Real q = hroe - 0.5 * (SQR(wroe[IV1]) + SQR(wroe[IV2]) + SQR(wroe[IV3]));
-      const Real a = (q < 0.0) ? 0.0 : std::sqrt(gm1 * q);
+      const Real a = eos.RoeSoundSpeed(q, cl, cr, sqrtdl * isdlpdr);
 
       //--- Step 4. Compute the max/min wave speeds based on L/R and Roe-averaged values
       const Real al = std::min((wroe[IV1] - a), (wli[IV1] - cl));
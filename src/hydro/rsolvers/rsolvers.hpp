@@ -34,11 +34,12 @@ struct Riemann;
 // "none" solvers for runs/testing without fluid evolution, i.e., just reset fluxes
 template <>
 struct Riemann<Fluid::euler, RiemannSolver::none> {
+  template <typename EOS>
   static KOKKOS_INLINE_FUNCTION void
   Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-        const int iu, const int ivx, const parthenon::ScratchPad2D<Real> &wl,
-        const parthenon::ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
-        const AdiabaticHydroEOS &eos, const Real c_h) {
+        const int iu, const int ivx, const parthenon::ScratchPad2D<ScratchReal> &wl,
+        const parthenon::ScratchPad2D<ScratchReal> &wr, VariableFluxPack<Real> &cons,
+        const EOS &eos, const Real c_h) {
     parthenon::par_for_inner(member, il, iu, [&](const int i) {
       for (size_t v = 0; v < Hydro::GetNVars<Fluid::euler>(); v++) {
         cons.flux(ivx, v, k, j, i) = 0.0;
@@ -51,8 +52,8 @@ template <>
 struct Riemann<Fluid::glmmhd, RiemannSolver::none> {
   static KOKKOS_INLINE_FUNCTION void
   Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-        const int iu, const int ivx, const parthenon::ScratchPad2D<Real> &wl,
-        const parthenon::ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
+        const int iu, const int ivx, const parthenon::ScratchPad2D<ScratchReal> &wl,
+        const parthenon::ScratchPad2D<ScratchReal> &wr, VariableFluxPack<Real> &cons,
         const AdiabaticGLMMHDEOS &eos, const Real c_h) {
     parthenon::par_for_inner(member, il, iu, [&](const int i) {
       for (size_t v = 0; v < Hydro::GetNVars<Fluid::glmmhd>(); v++) {
@@ -38,7 +38,7 @@ void GravitationalFieldSrcTerm(parthenon::MeshData<parthenon::Real> *md,
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "GravitationalFieldSrcTerm", parthenon::DevExecSpace(), 0,
+      DEFAULT_LOOP_PATTERN, "SrcTerms::GravitationalField", parthenon::DevExecSpace(), 0,
       cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
         auto &cons = cons_pack(b);
@@ -10,8 +10,17 @@
 
 // C++ headers
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
 #include <limits>
+#include <map>
+#include <string>
+#include <vector>
 
 // Parthenon headers
 #include <coordinates/uniform_cartesian.hpp>
@@ -21,18 +30,26 @@
 
 // AthenaPK headers
 #include "../../units.hpp"
+#include "../../utils/profiling.hpp"
+#include "../../utils/shared_params.hpp"
 #include "tabular_cooling.hpp"
 #include "utils/error_checking.hpp"
 
 namespace cooling {
 using namespace parthenon;
 
+namespace {
+// Number of coefficients per bin of the Townsend piecewise power law fits, i.e.,
+// ln(T_k), Y_k, A_k, 1 / A_k, alpha_k - 1, 1 / (alpha_k - 1), and per density row, i.e.,
+// lambda_N / T_N, Y_0, and the lower end and the inverse spacing of the index map
+constexpr int townsend_stride = 6;
+constexpr int townsend_row_stride = 4;
+} // namespace
+
 TabularCooling::TabularCooling(ParameterInput *pin,
                                std::shared_ptr<parthenon::StateDescriptor> hydro_pkg) {
   auto units = hydro_pkg->Param<Units>("units");
 
-  const std::string table_filename = pin->GetString("cooling", "table_filename");
-
   // It should be fine to just issue a warning here.
   // If an original cooling table with two columns was used, the behavior is the same.
   // If not, then the test below on the number of columns in the file will fail.
@@ -45,11 +62,6 @@ TabularCooling::TabularCooling(ParameterInput *pin,
                    "supported.\n");
   }
 
-  const Real lambda_units_cgs = pin->GetReal("cooling", "lambda_units_cgs");
-  // Convert erg cm^3/s to code units
-  const Real lambda_units =
-      lambda_units_cgs / (units.erg() * pow(units.cm(), 3) / units.s());
-
   const auto integrator_str = pin->GetOrAddString("cooling", "integrator", "rk12");
   if (integrator_str == "rk12") {
     integrator_ = CoolIntegrator::rk12;
@@ -61,12 +73,63 @@ TabularCooling::TabularCooling(ParameterInput *pin,
     integrator_ = CoolIntegrator::undefined;
   }
   max_iter_ = pin->GetOrAddInteger("cooling", "max_iter", 100);
+  const auto work_queue_subcycles =
+      pin->GetOrAddInteger("cooling", "work_queue_subcycles", 0);
+  PARTHENON_REQUIRE_THROWS(work_queue_subcycles >= 0,
+                           "cooling/work_queue_subcycles must be non-negative.");
+  work_queue_subcycles_ = work_queue_subcycles;
   cooling_time_cfl_ = pin->GetOrAddReal("cooling", "cfl", 0.1);
   d_log_temp_tol_ = pin->GetOrAddReal("cooling", "d_log_temp_tol", 1e-8);
   d_e_tol_ = pin->GetOrAddReal("cooling", "d_e_tol", 1e-8);
+  dt_from_srcterm_ = pin->GetOrAddBoolean("cooling", "dt_from_srcterm", false);
+  if (hydro_pkg->AllParams().hasKey("step_retry_failures")) {
+    failures_ = hydro_pkg->Param<utils::FailureCounter>("step_retry_failures");
+  }
   // negative means disabled
   T_floor_ = pin->GetOrAddReal("hydro", "Tfloor", -1.0);
 
+  // The arrays derived from the cooling table are read from the binary cache (if enabled
+  // and valid) or computed from the cooling table (and then written to the cache)
+  const auto cache_filename = pin->GetOrAddString("cooling", "table_cache", "");
+  const auto cache_key = TableCacheKey(pin, units);
+  if (cache_filename.empty() || !ReadTableCache(cache_filename, cache_key)) {
+    ReadTable(pin, units);
+    if (!cache_filename.empty() && Globals::my_rank == 0) {
+      WriteTableCache(cache_filename, cache_key);
+    }
+  }
+
+  // Create a lightweight object for computing cooling rates within kernels
+  const auto mbar_over_kb = hydro_pkg->Param<Real>("mbar_over_kb");
+  const auto adiabatic_index = hydro_pkg->Param<Real>("AdiabaticIndex");
+  const auto He_mass_fraction = hydro_pkg->Param<Real>("He_mass_fraction");
+
+  const auto fast_table = pin->GetOrAddBoolean("cooling", "fast_table", false);
+
+  // Density coordinate of two-dimensional tables is the log hydrogen number density in
+  // cm^-3, i.e., log10(rho) + log_nH_over_rho
+  const Real log_nH_over_rho =
+      std::log10((1.0 - He_mass_fraction) / units.mh() * std::pow(units.cm(), 3));
+
+  cooling_table_obj_ = CoolingTableObj(
+      log_lambdas_, log_temp_start_, log_temp_final_, d_log_temp_, n_temp_, uniform_,
+      log_temps_, bin_map_, n_dens_, log_dens_start_, d_log_dens_, log_nH_over_rho,
+      mbar_over_kb, adiabatic_index, 1.0 - He_mass_fraction, units, fast_table,
+      power_law_coeffs_, lambda_final_);
+
+  if (pin->GetOrAddBoolean("cooling", "benchmark", false)) {
+    Benchmark(pin, hydro_pkg.get());
+  }
+}
+
+void TabularCooling::ReadTable(ParameterInput *pin, const Units &units) {
+  const std::string table_filename = pin->GetString("cooling", "table_filename");
+
+  const Real lambda_units_cgs = pin->GetReal("cooling", "lambda_units_cgs");
+  // Convert erg cm^3/s to code units
+  const Real lambda_units =
+      lambda_units_cgs / (units.erg() * pow(units.cm(), 3) / units.s());
+
   std::stringstream msg;
 
   /****************************************
@@ -102,8 +165,10 @@ TabularCooling::TabularCooling(ParameterInput *pin,
 
   /****************************************
    * Determine log_temps and and log_lambdas vectors
+   * (and the log_dens vector of two-dimensional tables)
    ****************************************/
-  std::vector<Real> log_temps, log_lambdas;
+  std::vector<Real> log_temps, log_lambdas, log_dens;
+  std::size_t n_cols = 0;
   std::string line;
   std::size_t first_char;
   while (tab_ss.good()) {
@@ -117,21 +182,28 @@ TabularCooling::TabularCooling(ParameterInput *pin,
     std::istringstream iss(line);
     std::vector<std::string> line_data{std::istream_iterator<std::string>{iss},
                                        std::istream_iterator<std::string>{}};
-    // Check size
-    if (line_data.empty() || line_data.size() != 2) {
+    // Check size, i.e., two columns (log_temp, log_lambda) for one-dimensional tables or
+    // three columns (log_dens, log_temp, log_lambda) for two-dimensional tables
+    if (n_cols == 0) {
+      n_cols = line_data.size();
+    }
+    if ((n_cols != 2 && n_cols != 3) || line_data.size() != n_cols) {
       msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
-          << "Expected exactly two columns per line but got: \"" << line << "\""
-          << std::endl;
+          << "Expected exactly two or three columns on all lines but got: \"" << line
+          << "\"" << std::endl;
       PARTHENON_FAIL(msg);
     }
 
     try {
-      const Real log_temp = std::stod(line_data[0]);
-      const Real log_lambda = std::stod(line_data[1]);
+      const Real log_temp = std::stod(line_data[n_cols - 2]);
+      const Real log_lambda = std::stod(line_data[n_cols - 1]);
 
       // Add to growing list
       log_temps.push_back(log_temp);
       log_lambdas.push_back(log_lambda - std::log10(lambda_units));
+      if (n_cols == 3) {
+        log_dens.push_back(std::stod(line_data[0]));
+      }
 
     } catch (const std::invalid_argument &ia) {
       msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
@@ -144,6 +216,46 @@ TabularCooling::TabularCooling(ParameterInput *pin,
    * Check some assumtions about the cooling table
    ****************************************/
 
+  // Two-dimensional tables consist of rows (with the same temperatures) of equally
+  // spaced (in log space) and increasing densities.
+  // The temperatures of the first row are used in the following.
+  unsigned int n_dens = 1;
+  Real log_dens_start = 0.0;
+  Real d_log_dens = 1.0;
+  if (n_cols == 3) {
+    unsigned int n_temp = 1;
+    while (n_temp < log_dens.size() && log_dens[n_temp] == log_dens[0]) {
+      n_temp++;
+    }
+    n_dens = log_dens.size() / n_temp;
+    log_dens_start = log_dens[0];
+    d_log_dens = n_dens > 1 ? log_dens[n_temp] - log_dens_start : 1.0;
+    if (n_dens < 2 || log_dens.size() != n_dens * n_temp || d_log_dens <= 0) {
+      msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
+          << "Two-dimensional cooling table needs at least two rows of increasing "
+             "densities with the same number of temperatures."
+          << std::endl;
+      PARTHENON_FAIL(msg);
+    }
+    for (unsigned int j = 0; j < n_dens; j++) {
+      for (unsigned int i = 0; i < n_temp; i++) {
+        const auto idx = j * n_temp + i;
+        if (log_dens[idx] != log_dens[j * n_temp] ||
+            fabs(log_temps[idx] - log_temps[i]) > d_log_temp_tol_ * fabs(log_temps[i]) ||
+            fabs(log_dens[idx] - log_dens_start - j * d_log_dens) / d_log_dens >
+                d_log_temp_tol_) {
+          msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]"
+              << std::endl
+              << "Two-dimensional cooling table is not a regular grid (with equally "
+                 "spaced log_dens) at log_dens= "
+              << log_dens[idx] << " log_temp= " << log_temps[idx] << std::endl;
+          PARTHENON_FAIL(msg);
+        }
+      }
+    }
+    log_temps.resize(n_temp);
+  }
+
   // Ensure at least two data points in the table to interpolate from
   if (log_temps.size() < 2 || log_lambdas.size() < 2) {
     msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
@@ -161,30 +273,24 @@ TabularCooling::TabularCooling(ParameterInput *pin,
     PARTHENON_FAIL(msg);
   }
 
-  // Ensure that log_temps is evenly spaced
+  // Check whether log_temps is evenly spaced (allowing for direct indexing) and determine
+  // the narrowest bin of non-uniform tables
+  bool uniform = true;
+  Real min_d_log_temp = d_log_temp;
   for (size_t i = 1; i < log_temps.size(); i++) {
     const Real d_log_temp_i = log_temps[i] - log_temps[i - 1];
 
-    if (d_log_temp_i < 0) {
+    if (d_log_temp_i <= 0) {
       msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
-          << "log_temp in table is descreasing at i= " << i
+          << "log_temp in table is not increasing at i= " << i
           << " log_temp= " << log_temps[i] << std::endl;
       PARTHENON_FAIL(msg);
     }
 
-    // The Dedt() function currently relies on an equally spaced cooling table for faster
-    // lookup (direct indexing). It is used in the subcycling method and in order to
-    // restrict `dt` by a cooling cfl.
-    if (((integrator_ != CoolIntegrator::townsend) || (cooling_time_cfl_ > 0.0)) &&
-        (fabs(d_log_temp_i - d_log_temp) / d_log_temp > d_log_temp_tol_)) {
-      msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
-          << "d_log_temp in table is uneven at i=" << i << " log_temp=" << log_temps[i]
-          << " d_log_temp= " << d_log_temp << " d_log_temp_i= " << d_log_temp_i
-          << " diff= " << d_log_temp_i - d_log_temp
-          << " rel_diff= " << fabs(d_log_temp_i - d_log_temp) / d_log_temp
-          << " tol= " << d_log_temp_tol_ << std::endl;
-      PARTHENON_FAIL(msg);
+    if (fabs(d_log_temp_i - d_log_temp) / d_log_temp > d_log_temp_tol_) {
+      uniform = false;
     }
+    min_d_log_temp = std::min(min_d_log_temp, d_log_temp_i);
   }
 
   /****************************************
@@ -196,86 +302,379 @@ TabularCooling::TabularCooling(ParameterInput *pin,
   log_temp_final_ = log_temps[n_temp_ - 1];
   d_log_temp_ = d_log_temp;
   lambda_final_ = std::pow(10.0, log_lambdas[n_temp_ - 1]);
+  uniform_ = uniform;
+
+  // Setup the index map for non-uniform tables used in Dedt(), i.e., the bin containing
+  // the lower edge of each cell of a uniform grid in log temperature. With cells not
+  // wider than the narrowest bin, the bin of any log temperature within a cell is either
+  // the mapped one or the next one resulting in an O(1) lookup.
+  log_temps_ = ParArray1D<Real>("log_temps_", n_temp_);
+  bin_map_ = ParArray1D<int>("bin_map_", 0);
+  {
+    auto host_log_temps = Kokkos::create_mirror_view(log_temps_);
+    for (unsigned int i = 0; i < n_temp_; i++) {
+      host_log_temps(i) = log_temps[i];
+    }
+    Kokkos::deep_copy(log_temps_, host_log_temps);
+  }
+  if (!uniform_) {
+    const auto max_map_size = pin->GetOrAddInteger("cooling", "max_index_map_size",
+                                                   static_cast<int>(64 * n_temp_));
+    PARTHENON_REQUIRE_THROWS(max_map_size > 0,
+                             "cooling/max_index_map_size must be positive.");
+    const Real range = log_temp_final_ - log_temp_start_;
+    const auto n_map = static_cast<unsigned int>(
+        std::min<Real>(std::ceil(range / min_d_log_temp), max_map_size));
+    // The uniform grid of the index map replaces the table spacing in the lookup
+    d_log_temp_ = range / n_map;
+
+    bin_map_ = ParArray1D<int>("bin_map_", n_map);
+    auto host_bin_map = Kokkos::create_mirror_view(bin_map_);
+    unsigned int k = 0;
+    for (unsigned int m = 0; m < n_map; m++) {
+      const Real log_temp_m = log_temp_start_ + d_log_temp_ * m;
+      while (k < n_temp_ - 2 && log_temps[k + 1] <= log_temp_m) {
+        k++;
+      }
+      host_bin_map(m) = k;
+    }
+    Kokkos::deep_copy(bin_map_, host_bin_map);
+  }
 
   // Setup log_lambdas_ used in Dedt()
+  // Two-dimensional tables are stored row by row, i.e., with the temperature as fastest
+  // index so that the bins of the neighboring density rows are close in memory
+  n_dens_ = n_dens;
+  log_dens_start_ = log_dens_start;
+  d_log_dens_ = d_log_dens;
   {
     // log_lambdas is used if the integrator isn't Townsend, if the cooling CFL
     // is set, or if cooling time is a extra derived field. Since we don't have
     // a good way to check the last condition we always initialize log_lambdas_
-    log_lambdas_ = ParArray1D<Real>("log_lambdas_", n_temp_);
+    log_lambdas_ = ParArray1D<Real>("log_lambdas_", n_dens_ * n_temp_);
 
     // Read log_lambdas in host_log_lambdas, changing to code units along the way
     auto host_log_lambdas = Kokkos::create_mirror_view(log_lambdas_);
-    for (unsigned int i = 0; i < n_temp_; i++) {
+    for (unsigned int i = 0; i < n_dens_ * n_temp_; i++) {
       host_log_lambdas(i) = log_lambdas[i];
     }
     // Copy host_log_lambdas into device memory
     Kokkos::deep_copy(log_lambdas_, host_log_lambdas);
   }
   // Setup Townsend cooling, i.e., precalulcate piecewise powerlaw approx.
+  // (separately for each density row of two-dimensional tables)
   if (integrator_ == CoolIntegrator::townsend) {
-    lambdas_ = ParArray1D<Real>("lambdas_", n_temp_);
-    temps_ = ParArray1D<Real>("temps_", n_temp_);
-
-    // Read log_lambdas in host_lambdas, changing to code units along the way
-    auto host_lambdas = Kokkos::create_mirror_view(lambdas_);
-    auto host_temps = Kokkos::create_mirror_view(temps_);
+    std::vector<Real> temps(n_temp_), lambdas(n_dens_ * n_temp_);
     for (unsigned int i = 0; i < n_temp_; i++) {
-      host_lambdas(i) = std::pow(10.0, log_lambdas[i]);
-      host_temps(i) = std::pow(10.0, log_temps[i]);
+      temps[i] = std::pow(10.0, log_temps[i]);
+    }
+    for (unsigned int i = 0; i < n_dens_ * n_temp_; i++) {
+      lambdas[i] = std::pow(10.0, log_lambdas[i]);
     }
-    // Copy host_lambdas into device memory
-    Kokkos::deep_copy(lambdas_, host_lambdas);
-    Kokkos::deep_copy(temps_, host_temps);
 
     // Coeffs are for intervals, i.e., only n_temp_ - 1 entries
     const auto n_bins = n_temp_ - 1;
-    townsend_Y_k_ = ParArray1D<Real>("townsend_Y_k_", n_bins);
-    townsend_alpha_k_ = ParArray1D<Real>("townsend_alpha_k_", n_bins);
-
-    // Initialize on host (make *this* recursion simpler)
-    auto host_townsend_Y_k = Kokkos::create_mirror_view(townsend_Y_k_);
-    auto host_townsend_alpha_k = Kokkos::create_mirror_view(townsend_alpha_k_);
+    const auto y_map_size = pin->GetOrAddInteger("cooling", "townsend_map_size",
+                                                 static_cast<int>(4 * n_temp_));
+    PARTHENON_REQUIRE_THROWS(y_map_size > 0,
+                             "cooling/townsend_map_size must be positive.");
+    townsend_coeffs_ =
+        ParArray1D<Real>("townsend_coeffs_", townsend_stride * n_dens_ * n_bins);
+    townsend_rows_ = ParArray1D<Real>("townsend_rows_", townsend_row_stride * n_dens_);
+    townsend_y_map_ = ParArray1D<int>("townsend_y_map_", n_dens_ * y_map_size);
+    auto host_coeffs = Kokkos::create_mirror_view(townsend_coeffs_);
+    auto host_rows = Kokkos::create_mirror_view(townsend_rows_);
+    auto host_y_map = Kokkos::create_mirror_view(townsend_y_map_);
+
+    std::vector<Real> alpha_k(n_bins), Y_k(n_bins);
+    for (unsigned int j = 0; j < n_dens_; j++) {
+      const auto row_lambdas = lambdas.data() + j * n_temp_;
+
+      // Initialize piecewise power law indices
+      for (unsigned int i = 0; i < n_bins; i++) {
+        alpha_k[i] = (std::log10(row_lambdas[i + 1]) - std::log10(row_lambdas[i])) /
+                     (log_temps[i + 1] - log_temps[i]);
+        PARTHENON_REQUIRE(alpha_k[i] != 1.0,
+                          "Need to implement special case for Townsend piecewise fits.");
+      }
+
+      // Calculate TEF (temporal evolution functions Y_k recursively), (Eq. A6)
+      Y_k[n_bins - 1] = 0.0; // Last Y_N = Y(T_ref) = 0
+
+      for (int i = n_bins - 2; i >= 0; i--) {
+        const auto alpha_k_m1 = alpha_k[i] - 1.0;
+        const auto step = (row_lambdas[n_bins] / row_lambdas[i]) *
+                          (temps[i] / temps[n_bins]) *
+                          (std::pow(temps[i] / temps[i + 1], alpha_k_m1) - 1.0) /
+                          alpha_k_m1;
+
+        Y_k[i] = Y_k[i + 1] - step;
+      }
+
+      // Per bin coefficients so that Y(T) (Eq. A5) and its inverse (Eq. A7) are
+      //   Y = Y_k + A_k * expm1((alpha_k - 1) * (ln(T_k) - ln(T)))
+      //   T = exp(ln(T_k) - log1p((Y - Y_k) / A_k) / (alpha_k - 1))
+      // with A_k = (lambda_N / lambda_k) * (T_k / T_N) / (alpha_k - 1)
+      for (unsigned int i = 0; i < n_bins; i++) {
+        const auto alpha_k_m1 = alpha_k[i] - 1.0;
+        const Real A_k = (row_lambdas[n_bins] / row_lambdas[i]) *
+                         (temps[i] / temps[n_bins]) / alpha_k_m1;
+        auto coeffs = &host_coeffs(townsend_stride * (j * n_bins + i));
+        coeffs[0] = std::log(temps[i]);
+        coeffs[1] = Y_k[i];
+        coeffs[2] = A_k;
+        coeffs[3] = 1.0 / A_k;
+        coeffs[4] = alpha_k_m1;
+        coeffs[5] = 1.0 / alpha_k_m1;
+      }
+
+      // Index map on a uniform grid in u(Y) = ln(Y / (Y_0 - Y)) between the smallest
+      // positive Y_k and Y_1, which resolves the bins close to Y_0 (low temperatures)
+      // as well as close to 0 (high temperatures), storing the last bin with Y_k >= Y
+      // at the upper edge of each cell. As Y_k is decreasing, the mapped bin is a lower
+      // bound for the bin of the inverse (i.e., the last bin with Y_k >= Y) of any Y
+      // within the cell, which is then found by walking up from the mapped bin.
+      const Real Y_0 = Y_k[0];
+      auto u = [&](const Real y) { return std::log(y) - std::log(Y_0 - y); };
+      unsigned int n_pos = 0;
+      while (n_pos < n_bins && Y_k[n_pos] > 0.0) {
+        n_pos++;
+      }
+      Real u_min = 0.0;
+      Real inv_d_u = 0.0;
+      for (int m = 0; m < y_map_size; m++) {
+        host_y_map(j * y_map_size + m) = 0;
+      }
+      if (n_pos >= 2 && Y_k[n_pos - 1] < Y_k[1] && Y_k[1] < Y_0) {
+        u_min = u(Y_k[n_pos - 1]);
+        const Real d_u = (u(Y_k[1]) - u_min) / y_map_size;
+        inv_d_u = 1.0 / d_u;
+        int k = n_pos - 1;
+        for (int m = 0; m < y_map_size; m++) {
+          const Real u_upper = u_min + d_u * (m + 1);
+          while (k > 0 && u(Y_k[k]) < u_upper) {
+            k--;
+          }
+          host_y_map(j * y_map_size + m) = k;
+        }
+      }
+      auto row = &host_rows(townsend_row_stride * j);
+      row[0] = row_lambdas[n_bins] / temps[n_bins];
+      row[1] = Y_0;
+      row[2] = u_min;
+      row[3] = inv_d_u;
+    }
+    Kokkos::deep_copy(townsend_coeffs_, host_coeffs);
+    Kokkos::deep_copy(townsend_rows_, host_rows);
+    Kokkos::deep_copy(townsend_y_map_, host_y_map);
+  }
 
-    // Initialize piecewise power law indices
-    for (unsigned int i = 0; i < n_bins; i++) {
-      // Could use log_lambdas_ here, but using lambdas_ instead as they've already been
-      // converted to code units.
-      host_townsend_alpha_k(i) =
-          (std::log10(host_lambdas(i + 1)) - std::log10(host_lambdas(i))) /
-          (log_temps[i + 1] - log_temps[i]);
-      PARTHENON_REQUIRE(host_townsend_alpha_k(i) != 1.0,
-                        "Need to implement special case for Townsend piecewise fits.");
+  // Per bin power law coefficients for the fast table lookup in DeDt, i.e.,
+  // lambda = exp(c_k + alpha_k * ln(T)) within bin k stored as (c_k, alpha_k)
+  // (row by row for two-dimensional tables)
+  const auto n_bins = n_temp_ - 1;
+  power_law_coeffs_ = ParArray1D<Real>("power_law_coeffs_", 2 * n_dens_ * n_bins);
+  {
+    auto host_power_law_coeffs = Kokkos::create_mirror_view(power_law_coeffs_);
+    for (unsigned int j = 0; j < n_dens_; j++) {
+      for (unsigned int k = 0; k < n_bins; k++) {
+        // log10(lambda) = log_lambdas[k] + alpha_k * (log10(T) - log_temps[k])
+        const auto idx = j * n_temp_ + k;
+        const Real alpha_k =
+            (log_lambdas[idx + 1] - log_lambdas[idx]) / (log_temps[k + 1] - log_temps[k]);
+        host_power_law_coeffs(2 * (j * n_bins + k)) =
+            std::log(10.0) * (log_lambdas[idx] - alpha_k * log_temps[k]);
+        host_power_law_coeffs(2 * (j * n_bins + k) + 1) = alpha_k;
+      }
     }
+    Kokkos::deep_copy(power_law_coeffs_, host_power_law_coeffs);
+  }
+}
 
-    // Calculate TEF (temporal evolution functions Y_k recursively), (Eq. A6)
-    host_townsend_Y_k(n_bins - 1) = 0.0; // Last Y_N = Y(T_ref) = 0
+namespace {
+// Versioned binary cache of the arrays derived from the cooling table
+constexpr char table_cache_magic[] = "AthenaPK cooling table cache";
+constexpr int table_cache_version = 2;
 
-    for (int i = n_bins - 2; i >= 0; i--) {
-      const auto alpha_k_m1 = host_townsend_alpha_k(i) - 1.0;
-      const auto step = (host_lambdas(n_bins) / host_lambdas(i)) *
-                        (host_temps(i) / host_temps(n_bins)) *
-                        (std::pow(host_temps(i) / host_temps(i + 1), alpha_k_m1) - 1.0) /
-                        alpha_k_m1;
+// Byte buffer to (de)serialize the cache
+class TableCacheBuffer {
+ public:
+  std::vector<char> data;
+
+  template <typename T>
+  void Put(const T &value) {
+    const auto *bytes = reinterpret_cast<const char *>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+  }
+  void Put(const std::string &str) {
+    Put(static_cast<std::uint64_t>(str.size()));
+    data.insert(data.end(), str.begin(), str.end());
+  }
+  template <typename T>
+  void Put(const ParArray1D<T> &view) {
+    auto host_view = Kokkos::create_mirror_view_and_copy(HostMemSpace(), view);
+    Put(static_cast<std::uint64_t>(host_view.extent(0)));
+    const auto *bytes = reinterpret_cast<const char *>(host_view.data());
+    data.insert(data.end(), bytes, bytes + sizeof(T) * host_view.extent(0));
+  }
 
-      host_townsend_Y_k(i) = host_townsend_Y_k(i + 1) - step;
+  // Getters return false if the buffer ends prematurely
+  template <typename T>
+  bool Get(T &value) {
+    if (pos_ + sizeof(T) > data.size()) {
+      return false;
     }
+    std::memcpy(&value, data.data() + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+  bool Get(std::string &str) {
+    std::uint64_t size;
+    if (!Get(size) || pos_ + size > data.size()) {
+      return false;
+    }
+    str.assign(data.data() + pos_, size);
+    pos_ += size;
+    return true;
+  }
+  template <typename T>
+  bool Get(ParArray1D<T> &view, const std::string &label) {
+    std::uint64_t size;
+    if (!Get(size) || pos_ + sizeof(T) * size > data.size()) {
+      return false;
+    }
+    view = ParArray1D<T>(label, size);
+    auto host_view = Kokkos::create_mirror_view(view);
+    std::memcpy(host_view.data(), data.data() + pos_, sizeof(T) * size);
+    Kokkos::deep_copy(view, host_view);
+    pos_ += sizeof(T) * size;
+    return true;
+  }
+  bool AtEnd() const { return pos_ == data.size(); }
+  void Rewind() { pos_ = 0; }
+
+ private:
+  std::size_t pos_ = 0;
+};
+} // namespace
+
+std::string TabularCooling::TableCacheKey(ParameterInput *pin, const Units &units) const {
+  // All inputs the derived arrays depend on (the table itself by its name and size)
+  std::stringstream key;
+  key << std::setprecision(17);
+  const auto table_filename = pin->GetString("cooling", "table_filename");
+  key << "table_filename=" << table_filename;
+  if (Globals::my_rank == 0) {
+    std::error_code ec;
+    const auto table_size = std::filesystem::file_size(table_filename, ec);
+    key << " table_size=" << (ec ? 0 : table_size);
+  }
+  key << " lambda_units_cgs=" << pin->GetReal("cooling", "lambda_units_cgs")
+      << " integrator=" << static_cast<int>(integrator_)
+      << " d_log_temp_tol=" << d_log_temp_tol_ << " max_index_map_size="
+      << (pin->DoesParameterExist("cooling", "max_index_map_size")
+              ? pin->GetInteger("cooling", "max_index_map_size")
+              : -1)
+      << " townsend_map_size="
+      << (pin->DoesParameterExist("cooling", "townsend_map_size")
+              ? pin->GetInteger("cooling", "townsend_map_size")
+              : -1)
+      << " code_length_cgs=" << units.code_length_cgs()
+      << " code_mass_cgs=" << units.code_mass_cgs()
+      << " code_time_cgs=" << units.code_time_cgs() << " sizeof(Real)=" << sizeof(Real);
+  return key.str();
+}
 
-    Kokkos::deep_copy(townsend_alpha_k_, host_townsend_alpha_k);
-    Kokkos::deep_copy(townsend_Y_k_, host_townsend_Y_k);
+void TabularCooling::WriteTableCache(const std::string &filename,
+                                     const std::string &key) const {
+  TableCacheBuffer buffer;
+  buffer.Put(std::string(table_cache_magic));
+  buffer.Put(table_cache_version);
+  buffer.Put(key);
+  buffer.Put(n_temp_);
+  buffer.Put(n_dens_);
+  buffer.Put(log_temp_start_);
+  buffer.Put(log_temp_final_);
+  buffer.Put(d_log_temp_);
+  buffer.Put(lambda_final_);
+  buffer.Put(uniform_);
+  buffer.Put(log_dens_start_);
+  buffer.Put(d_log_dens_);
+  buffer.Put(log_lambdas_);
+  buffer.Put(log_temps_);
+  buffer.Put(bin_map_);
+  buffer.Put(power_law_coeffs_);
+  buffer.Put(townsend_coeffs_);
+  buffer.Put(townsend_rows_);
+  buffer.Put(townsend_y_map_);
+
+  // Write to a temporary file first so that concurrent jobs never read a partial cache
+  const auto tmp_filename = filename + ".tmp";
+  {
+    std::ofstream file(tmp_filename, std::ios::binary | std::ios::trunc);
+    file.write(buffer.data.data(), buffer.data.size());
+    if (!file.good()) {
+      PARTHENON_WARN("Could not write cooling table cache " + filename);
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_filename, filename, ec);
+  if (ec) {
+    PARTHENON_WARN("Could not write cooling table cache " + filename);
   }
+}
 
-  // Create a lightweight object for computing cooling rates within kernels
-  const auto mbar_over_kb = hydro_pkg->Param<Real>("mbar_over_kb");
-  const auto adiabatic_index = hydro_pkg->Param<Real>("AdiabaticIndex");
-  const auto He_mass_fraction = hydro_pkg->Param<Real>("He_mass_fraction");
+bool TabularCooling::ReadTableCache(const std::string &filename, const std::string &key) {
+  // Only the master process reads (and checks) the cache and then broadcasts the content
+  TableCacheBuffer buffer;
+  if (Globals::my_rank == 0) {
+    std::ifstream file(filename, std::ios::binary);
+    if (file.good()) {
+      buffer.data.assign(std::istreambuf_iterator<char>(file),
+                         std::istreambuf_iterator<char>());
+    }
+    std::string magic, cache_key;
+    int version;
+    if (!buffer.Get(magic) || magic != table_cache_magic || !buffer.Get(version) ||
+        version != table_cache_version || !buffer.Get(cache_key) || cache_key != key) {
+      buffer.data.clear();
+    }
+  }
+#ifdef MPI_PARALLEL
+  std::uint64_t size = buffer.data.size();
+  PARTHENON_MPI_CHECK(MPI_Bcast(&size, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD));
+  buffer.data.resize(size);
+  PARTHENON_MPI_CHECK(MPI_Bcast(buffer.data.data(), size, MPI_BYTE, 0, MPI_COMM_WORLD));
+#endif
+  if (buffer.data.empty()) {
+    return false;
+  }
 
-  cooling_table_obj_ = CoolingTableObj(log_lambdas_, log_temp_start_, log_temp_final_,
-                                       d_log_temp_, n_temp_, mbar_over_kb,
-                                       adiabatic_index, 1.0 - He_mass_fraction, units);
+  std::string magic, cache_key;
+  int version;
+  buffer.Rewind();
+  const bool valid = buffer.Get(magic) && buffer.Get(version) && buffer.Get(cache_key) &&
+                     buffer.Get(n_temp_) && buffer.Get(n_dens_) &&
+                     buffer.Get(log_temp_start_) && buffer.Get(log_temp_final_) &&
+                     buffer.Get(d_log_temp_) && buffer.Get(lambda_final_) &&
+                     buffer.Get(uniform_) && buffer.Get(log_dens_start_) &&
+                     buffer.Get(d_log_dens_) &&
+                     buffer.Get(log_lambdas_, "log_lambdas_") &&
+                     buffer.Get(log_temps_, "log_temps_") &&
+                     buffer.Get(bin_map_, "bin_map_") &&
+                     buffer.Get(power_law_coeffs_, "power_law_coeffs_") &&
+                     buffer.Get(townsend_coeffs_, "townsend_coeffs_") &&
+                     buffer.Get(townsend_rows_, "townsend_rows_") &&
+                     buffer.Get(townsend_y_map_, "townsend_y_map_") &&
+                     buffer.AtEnd();
+  PARTHENON_REQUIRE_THROWS(valid, "Cooling table cache " + filename +
+                                      " is corrupted. Please remove it.");
+  return true;
 }
 
 void TabularCooling::SrcTerm(MeshData<Real> *md, const Real dt) const {
+  utils::profiling::ScopedRegion region("SrcTerms::TabularCooling::SrcTerm");
   if (integrator_ == CoolIntegrator::rk12) {
     SubcyclingFixedIntSrcTerm<RK12Stepper>(md, dt, RK12Stepper());
   } else if (integrator_ == CoolIntegrator::rk45) {
@@ -287,6 +686,338 @@ void TabularCooling::SrcTerm(MeshData<Real> *md, const Real dt) const {
   }
 }
 
+namespace {
+// Specific internal energy of a cell from the conserved variables
+template <typename View3D>
+KOKKOS_INLINE_FUNCTION Real SpecificInternalEnergy(const View3D &cons, const int k,
+                                                   const int j, const int i,
+                                                   const bool mhd_enabled) {
+  const Real rho = cons(IDN, k, j, i);
+  // TODO(pgrete) with potentially more EOS, a separate get_pressure (or similar)
+  // function could be useful.
+  Real internal_e = cons(IEN, k, j, i) - 0.5 *
+                                             (SQR(cons(IM1, k, j, i)) +
+                                              SQR(cons(IM2, k, j, i)) +
+                                              SQR(cons(IM3, k, j, i))) /
+                                             rho;
+  if (mhd_enabled) {
+    internal_e -= 0.5 * (SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) +
+                         SQR(cons(IB3, k, j, i)));
+  }
+  return internal_e / rho;
+}
+
+// Cooling time of a cell as used for the cooling timestep, i.e., infinite if not cooling
+// (below the cooling table) or below the floor.
+KOKKOS_INLINE_FUNCTION Real CoolingTime(const CoolingTableObj &cooling_table_obj,
+                                        const Real rho, const Real internal_e,
+                                        const Real internal_e_floor) {
+  const Real de_dt = cooling_table_obj.DeDt(internal_e, rho);
+  return ((de_dt == 0) || (internal_e < internal_e_floor))
+             ? std::numeric_limits<Real>::infinity()
+             : fabs(internal_e / de_dt);
+}
+
+// Adaptive subcycling of the cooling of a single cell continuing from the current
+// subcycle time sub_t, subcycle timestep sub_dt and specific internal energy
+// internal_e (all updated in place) for at most max_pass_iter subcycles.
+// Returns whether the end of the timestep dt has been reached (or the failure of the
+// cell has been counted by failures so that the step is retried).
+template <typename RKStepper>
+KOKKOS_INLINE_FUNCTION bool
+SubcycleCell(const CoolingTableObj &cooling_table_obj, const Real rho, const Real dt,
+             const Real min_sub_dt, const Real d_e_tol, const Real internal_e_floor,
+             const Real epsilon, const unsigned int max_iter,
+             const unsigned int max_pass_iter, const utils::FailureCounter &failures,
+             Real &sub_t, Real &sub_dt, Real &internal_e, unsigned int &sub_iter) {
+  bool dedt_valid = true;
+
+  // Wrap DeDt into a functor for the RKStepper
+  auto DeDt_wrapper = [&](const Real t, const Real e, bool &valid) {
+    return cooling_table_obj.DeDt(e, rho, valid);
+  };
+
+  unsigned int pass_iter = 0;
+  // check for dedt != 0.0 required in case cooling floor it hit during subcycling
+  while ((sub_t * (1 + epsilon) < dt) &&
+         (DeDt_wrapper(sub_t, internal_e, dedt_valid) != 0.0)) {
+    if (pass_iter >= max_pass_iter) {
+      return false;
+    }
+
+    if (sub_iter > max_iter && failures.Count()) {
+      return true;
+    }
+    if (sub_iter > max_iter) {
+      // Due to sub_dt >= min_dt, this error should never happen
+      PARTHENON_FAIL("FATAL ERROR in [TabularCooling::SubcyclingFixedIntSrcTerm]: Sub "
+                     "cycles exceed max_iter (This should be impossible)");
+    }
+
+    // Next higher order estimate
+    Real internal_e_next_h;
+    // Error in estimate of higher order
+    Real d_e_err;
+    // Number of attempts on this subcycle
+    unsigned int sub_attempt = 0;
+    // Whether to reattempt this subcycle
+    bool reattempt_sub = true;
+    do {
+      // Next lower order estimate
+      Real internal_e_next_l;
+      // Do one dual order RK step
+      dedt_valid = true;
+      RKStepper::Step(sub_t, sub_dt, internal_e, DeDt_wrapper, internal_e_next_h,
+                      internal_e_next_l, dedt_valid);
+
+      sub_attempt++;
+
+      if (!dedt_valid) {
+        if (sub_dt == min_sub_dt) {
+          // Cooling is so fast that even the minimum subcycle dt would lead to
+          // negative internal energy -- so just cool to the floor of the cooling
+          // table
+          sub_dt = (dt - sub_t);
+          internal_e_next_h = internal_e_floor;
+          reattempt_sub = false;
+        } else {
+          reattempt_sub = true;
+          sub_dt = min_sub_dt;
+        }
+      } else {
+
+        // Compute error
+        d_e_err = fabs((internal_e_next_h - internal_e_next_l) / internal_e_next_h);
+
+        reattempt_sub = false;
+        // Accepting or reattempting the subcycle:
+        //
+        // -If the error is small, accept the subcycle
+        //
+        // -If the error on the subcycle is too high, compute a new time
+        // step to reattempt the subcycle
+        //   -But if the new time step is smaller than the minimum subcycle
+        //   time step (total step duration/ max iterations), just use the
+        //   minimum subcycle time step instead
+
+        if (std::isnan(d_e_err)) {
+          reattempt_sub = true;
+          sub_dt = min_sub_dt;
+        } else if (d_e_err >= d_e_tol && sub_dt > min_sub_dt) {
+          // Reattempt this subcycle
+          reattempt_sub = true;
+          // Error was too high, shrink the timestep
+          if (d_e_tol == 0) {
+            sub_dt = min_sub_dt;
+          } else {
+            sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
+          }
+          // Don't drop timestep under maximum iteration count
+          if (sub_dt < min_sub_dt || sub_attempt >= max_iter) {
+            sub_dt = min_sub_dt;
+          }
+        }
+      }
+
+    } while (reattempt_sub);
+    // Accept this subcycle
+    sub_t += sub_dt;
+
+    internal_e = internal_e_next_h;
+
+    // skip to the end of subcycling if error is 0 (very unlikely)
+    if (d_e_err == 0) {
+      sub_dt = dt - sub_t;
+    } else {
+      // Grow the timestep
+      // (or shrink in case d_e_err >= d_e_tol and sub_dt is already at min_sub_dt)
+      sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
+    }
+
+    if (d_e_tol == 0) {
+      sub_dt = min_sub_dt;
+    }
+
+    // Don't drop timestep under the minimum step size
+    sub_dt = std::max(sub_dt, min_sub_dt);
+
+    // Limit by end time
+    sub_dt = std::min(sub_dt, dt - sub_t);
+
+    sub_iter++;
+    pass_iter++;
+  }
+  return true;
+}
+
+// Time of n_rep evaluations of cell_func(j, i) for all cells of an n_j x n_i grid.
+// The returned values are accumulated so that the evaluations are not optimized away.
+template <typename CellFunc>
+Real TimeCells(const int n_j, const int n_i, const int n_rep, const CellFunc &cell_func) {
+  Real sum;
+  Kokkos::fence();
+  Kokkos::Timer timer;
+  for (int rep = 0; rep < n_rep; rep++) {
+    Kokkos::parallel_reduce(
+        "SrcTerms::TabularCooling::Benchmark",
+        Kokkos::MDRangePolicy<Kokkos::Rank<2>>(DevExecSpace(), {0, 0}, {n_j, n_i}),
+        KOKKOS_LAMBDA(const int j, const int i, Real &lsum) { lsum += cell_func(j, i); },
+        sum);
+  }
+  Kokkos::fence();
+  return timer.seconds();
+}
+
+// Time of n_rep RKStepper steps of size h for all (rho, internal_e) pairs
+template <typename RKStepper>
+Real TimeRKSteps(const CoolingTableObj &cooling_table_obj, const ParArray2D<Real> &d_rho,
+                 const ParArray2D<Real> &d_internal_e, const Real h, const int n_rep) {
+  return TimeCells(
+      d_rho.extent_int(0), d_rho.extent_int(1), n_rep,
+      KOKKOS_LAMBDA(const int j, const int i) {
+        const Real rho = d_rho(j, i);
+        auto DeDt_wrapper = [&](const Real t, const Real e, bool &valid) {
+          return cooling_table_obj.DeDt(e, rho, valid);
+        };
+        Real internal_e_next_h, internal_e_next_l;
+        bool dedt_valid = true;
+        RKStepper::Step(0.0, h, d_internal_e(j, i), DeDt_wrapper, internal_e_next_h,
+                        internal_e_next_l, dedt_valid);
+        return internal_e_next_h - internal_e_next_l;
+      });
+}
+
+// Time of n_rep full (adaptively subcycled) RKStepper integrations over dt for all
+// (rho, internal_e) pairs. Also returns the mean number of subcycles per cooling cell.
+template <typename RKStepper>
+Real TimeSubcycling(const CoolingTableObj &cooling_table_obj,
+                    const ParArray2D<Real> &d_rho, const ParArray2D<Real> &d_internal_e,
+                    const Real dt, const Real d_e_tol, const Real internal_e_floor,
+                    const Real epsilon, const unsigned int max_iter, const int n_rep,
+                    Real &mean_subcycles) {
+  const int n_rho = d_rho.extent_int(0);
+  const int n_e = d_rho.extent_int(1);
+  const Real min_sub_dt = dt / max_iter;
+  // Same setup as in SubcyclingFixedIntSrcTerm (without a work queue)
+  auto subcycle = KOKKOS_LAMBDA(const int j, const int i, Real &internal_e) {
+    const Real rho = d_rho(j, i);
+    internal_e = d_internal_e(j, i);
+    if (cooling_table_obj.DeDt(internal_e, rho) == 0.0 ||
+        internal_e <= internal_e_floor) {
+      return -1;
+    }
+    Real sub_t = 0;
+    Real sub_dt = (d_e_tol == 0) ? min_sub_dt : dt;
+    unsigned int sub_iter = 0;
+    SubcycleCell<RKStepper>(cooling_table_obj, rho, dt, min_sub_dt, d_e_tol,
+                            internal_e_floor, epsilon, max_iter, max_iter + 2,
+                            utils::FailureCounter(), sub_t, sub_dt, internal_e, sub_iter);
+    return static_cast<int>(sub_iter);
+  };
+
+  const Real seconds =
+      TimeCells(n_rho, n_e, n_rep, KOKKOS_LAMBDA(const int j, const int i) {
+        Real internal_e;
+        subcycle(j, i, internal_e);
+        return internal_e;
+      });
+
+  Real num_subcycles, num_cooling;
+  Kokkos::parallel_reduce(
+      "SrcTerms::TabularCooling::BenchmarkSubcycles",
+      Kokkos::MDRangePolicy<Kokkos::Rank<2>>(DevExecSpace(), {0, 0}, {n_rho, n_e}),
+      KOKKOS_LAMBDA(const int j, const int i, Real &lsubcycles, Real &lcooling) {
+        Real internal_e;
+        const int sub_iter = subcycle(j, i, internal_e);
+        if (sub_iter >= 0) {
+          lsubcycles += sub_iter;
+          lcooling += 1.0;
+        }
+      },
+      num_subcycles, num_cooling);
+  mean_subcycles = num_cooling > 0.0 ? num_subcycles / num_cooling : 0.0;
+  return seconds;
+}
+
+// Piecewise power law fits (per density row of two-dimensional tables) for the Townsend
+// (2009) exact integration scheme, see TabularCooling::ReadTable for the layout of the
+// coefficients. Both the temperature bin and the bin of the inverse of the temporal
+// evolution function are found in O(1) (through the table spacing or the index maps) and
+// all coefficients of a bin are contiguous in memory.
+struct TownsendTable {
+  ParArray1D<Real> coeffs, rows;
+  ParArray1D<int> y_map;
+  CoolingTableObj cooling_table_obj;
+  int nbins, n_y_map;
+  unsigned int n_dens;
+  Real temp_cool_floor, mbar_gm1_over_kb;
+
+  // Bin of the inverse of Y, i.e., the last bin k <= k_start with Y_k >= y (or 0)
+  KOKKOS_INLINE_FUNCTION int InverseBin(const unsigned int row, const Real y,
+                                        const int k_start) const {
+    // All Y_k >= 0 (and Y may be negative in the last bin or above the table)
+    if (!(y > 0.0)) {
+      return k_start;
+    }
+    const auto *r = &rows(townsend_row_stride * row);
+    if (y > r[1]) {
+      return 0;
+    }
+    // Lower bound from the index map (and bin 0 above the map, i.e., for y > Y_1)
+    const Real x = (log(y) - log(r[1] - y) - r[2]) * r[3];
+    int k = x < n_y_map ? y_map(row * n_y_map + static_cast<int>(std::max<Real>(x, 0.0)))
+                        : 0;
+    k = std::min(k, k_start);
+    const auto co = townsend_stride * row * nbins;
+    while (k < k_start && coeffs(co + townsend_stride * (k + 1) + 1) >= y) {
+      k++;
+    }
+    return k;
+  }
+
+  // Temperature after cooling for dt of a cell with temperature temp (above the lower
+  // end of the cooling table) and n_h2_by_rho = rho * X_H^2 / m_h^2.
+  // The result may be below the lower end of the cooling table.
+  KOKKOS_INLINE_FUNCTION Real NewTemperature(const Real temp, const Real rho,
+                                             const Real n_h2_by_rho,
+                                             const Real dt) const {
+    const Real ln_temp = log(temp);
+    // Bin of the temperature (the last bin above the table)
+    const int idx_temp = cooling_table_obj.TempBin(ln_temp);
+    const Real dy = dt * mbar_gm1_over_kb * n_h2_by_rho;
+
+    // New temperature using the piecewise power law fit of density row `row`
+    auto townsend_temp = [&](const unsigned int row) {
+      // Compute the Temporal Evolution Function Y(T) (Eq. A5)
+      const auto *c = &coeffs(townsend_stride * (row * nbins + idx_temp));
+      const Real tef = c[1] + c[2] * expm1(c[4] * (c[0] - ln_temp));
+
+      // Compute the adjusted TEF for new timestep (Eqn. 26) (term in brackets)
+      const Real tef_adj = tef + rows(townsend_row_stride * row) * dy;
+
+      // TEF is a strictly decreasing function and new_tef > tef, i.e., the new
+      // temperature is in the same or a lower bin
+      const auto idx = InverseBin(row, tef_adj, idx_temp);
+
+      // Compute the Inverse Temporal Evolution Function Y^{-1}(Y) (Eq. A7)
+      const auto *ci = &coeffs(townsend_stride * (row * nbins + idx));
+      return exp(ci[0] - log1p((tef_adj - ci[1]) * ci[3]) * ci[5]);
+    };
+
+    if (n_dens == 1) {
+      return townsend_temp(0);
+    }
+    // Interpolate (in log space) between the new temperatures of the density rows
+    unsigned int row;
+    Real w;
+    cooling_table_obj.DensityRow(rho, row, w);
+    const Real temp_new_row = std::max<Real>(townsend_temp(row), temp_cool_floor);
+    const Real temp_new_rowp1 = std::max<Real>(townsend_temp(row + 1), temp_cool_floor);
+    return exp((1.0 - w) * log(temp_new_row) + w * log(temp_new_rowp1));
+  }
+};
+} // namespace
+
 template <typename RKStepper>
 void TabularCooling::SubcyclingFixedIntSrcTerm(MeshData<Real> *md, const Real dt_,
                                                const RKStepper rk_stepper) const {
@@ -306,6 +1037,16 @@ void TabularCooling::SubcyclingFixedIntSrcTerm(MeshData<Real> *md, const Real dt
 
   const Real d_e_tol = d_e_tol_;
 
+  const Real epsilon = KEpsilon_;
+
+  const auto failures = failures_;
+
+  // Subcycles of the first pass over all cells. Without a work queue, all cells are
+  // fully integrated in the first pass.
+  const bool use_work_queue = work_queue_subcycles_ > 0;
+  const unsigned int first_pass_iter =
+      use_work_queue ? work_queue_subcycles_ : max_iter + 2;
+
   // Determine the cooling floor, whichever is higher of the cooling table floor
   // or fluid solver floor
   const auto temp_cool_floor = std::pow(10.0, log_temp_start_); // low end of cool table
@@ -322,168 +1063,185 @@ void TabularCooling::SubcyclingFixedIntSrcTerm(MeshData<Real> *md, const Real dt
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
 
+  // Number of subcycles per block used as cost for load balancing (if enabled)
+  const bool count_substeps = hydro_pkg->Param<Real>("lb_cooling_cost_weight") > 0.0;
+  ParArray1D<Real> substeps("SrcTerms::TabularCooling::substeps",
+                            count_substeps ? cons_pack.GetDim(5) : 0);
+
+  // Minimum cooling time per block after the update (if used for the timestep)
+  const bool record_cooling_time = dt_from_srcterm_;
+  const auto min_cooling_time = MinCoolingTimes(md);
+  const auto interior = InteriorBounds(md);
+
+  // Update of the energy once the subcycling of a cell is done
+  auto finalize_cell = KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                                     const Real internal_e_initial, Real internal_e,
+                                     const unsigned int sub_iter) {
+    auto &cons = cons_pack(b);
+    auto &prim = prim_pack(b);
+    const Real rho = cons(IDN, k, j, i);
+    // If cooled below floor, reset to floor value.
+    // This could happen if the floor value is larger than the lower end of the
+    // cooling table or if they are close and the last subcycle in the cooling above
+    // the lower end pushed the temperature below the lower end (and the floor).
+    internal_e = (internal_e > internal_e_floor) ? internal_e : internal_e_floor;
+
+    // Remove the cooling from the total energy density
+    cons(IEN, k, j, i) += rho * (internal_e - internal_e_initial);
+    // Latter technically not required if no other tasks follows before
+    // ConservedToPrim conversion, but keeping it for now (better safe than sorry).
+    prim(IPR, k, j, i) = rho * internal_e * gm1;
+
+    if (count_substeps) {
+      Kokkos::atomic_add(&substeps(b), static_cast<Real>(sub_iter));
+    }
+    if (record_cooling_time && interior.Contains(k, j, i)) {
+      const Real cooling_time =
+          CoolingTime(cooling_table_obj, rho, internal_e, internal_e_floor);
+      Kokkos::atomic_min(&min_cooling_time(b), cooling_time);
+    }
+  };
+
+  // Cells that are not done after the first pass are stored (with their subcycling
+  // state) by their flattened (b, k, j, i) index in the pack in a work queue.
+  const std::int64_t nx1 = cons_pack.GetDim(1);
+  const std::int64_t nx2 = cons_pack.GetDim(2);
+  const std::int64_t nx3 = cons_pack.GetDim(3);
+  // The queues are only reallocated if they are too small, e.g., after the pack size
+  // changed (or after remeshing, when the driver drops them).
+  std::array<CoolingWorkQueue, 2> *queues = nullptr;
+  if (use_work_queue) {
+    utils::shared_params::WithMutableParam<CoolingWorkQueues>(
+        hydro_pkg.get(), "cooling_work_queues",
+        [&](auto *work_queues) { queues = &(*work_queues)[md]; });
+    (*queues)[0].Reserve(cons_pack.GetDim(5) * nx3 * nx2 * nx1);
+  }
+  CoolingWorkQueue queue = use_work_queue ? (*queues)[0] : CoolingWorkQueue();
+  Kokkos::View<std::int64_t, parthenon::DevMemSpace> num_entries(
+      "SrcTerms::TabularCooling::num_entries");
+
   par_for(
-      DEFAULT_LOOP_PATTERN, "TabularCooling::SubcyclingSplitSrcTerm", DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      DEFAULT_LOOP_PATTERN, "SrcTerms::TabularCooling::SubcyclingSrcTerm", DevExecSpace(),
+      0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
         auto &cons = cons_pack(b);
-        auto &prim = prim_pack(b);
         // Need to use `cons` here as prim may still contain state at t_0;
         const Real rho = cons(IDN, k, j, i);
-        // TODO(pgrete) with potentially more EOS, a separate get_pressure (or similar)
-        // function could be useful.
-        Real internal_e =
-            cons(IEN, k, j, i) - 0.5 *
-                                     (SQR(cons(IM1, k, j, i)) + SQR(cons(IM2, k, j, i)) +
-                                      SQR(cons(IM3, k, j, i))) /
-                                     rho;
-        if (mhd_enabled) {
-          internal_e -= 0.5 * (SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) +
-                               SQR(cons(IB3, k, j, i)));
+        const Real internal_e_initial =
+            SpecificInternalEnergy(cons, k, j, i, mhd_enabled);
+        Real internal_e = internal_e_initial;
+
+        // States of cells that already failed during the step (see hydro/step_retry)
+        // cannot be evaluated in the cooling table
+        if (!(rho > 0.0 && std::isfinite(internal_e)) && failures.Count()) {
+          return;
         }
-        internal_e /= rho;
-        const Real internal_e_initial = internal_e;
 
         bool dedt_valid = true;
-
-        // Wrap DeDt into a functor for the RKStepper
-        auto DeDt_wrapper = [&](const Real t, const Real e, bool &valid) {
-          return cooling_table_obj.DeDt(e, rho, valid);
-        };
-
-        Real sub_t = 0; // current subcycle time
-        // Try full dt. If error is too large adaptive timestepping will reduce sub_dt
-        Real sub_dt = dt;
-
         // Check if cooling is actually happening, e.g., when T below T_cool_min or if
         // temperature is already below floor.
-        const Real dedt_initial = DeDt_wrapper(0.0, internal_e_initial, dedt_valid);
+        const Real dedt_initial =
+            cooling_table_obj.DeDt(internal_e_initial, rho, dedt_valid);
         if (dedt_initial == 0.0 || internal_e_initial <= internal_e_floor) {
           return;
         }
 
+        Real sub_t = 0; // current subcycle time
+        // Try full dt. If error is too large adaptive timestepping will reduce sub_dt
+        Real sub_dt = dt;
+
         // Use minumum subcycle timestep when d_e_tol == 0
         if (d_e_tol == 0) {
           sub_dt = min_sub_dt;
         }
 
         unsigned int sub_iter = 0;
-        // check for dedt != 0.0 required in case cooling floor it hit during subcycling
-        while ((sub_t * (1 + KEpsilon_) < dt) &&
-               (DeDt_wrapper(sub_t, internal_e, dedt_valid) != 0.0)) {
-
-          if (sub_iter > max_iter) {
-            // Due to sub_dt >= min_dt, this error should never happen
-            PARTHENON_FAIL(
-                "FATAL ERROR in [TabularCooling::SubcyclingFixedIntSrcTerm]: Sub "
-                "cycles exceed max_iter (This should be impossible)");
-          }
-
-          // Next higher order estimate
-          Real internal_e_next_h;
-          // Error in estimate of higher order
-          Real d_e_err;
-          // Number of attempts on this subcycle
-          unsigned int sub_attempt = 0;
-          // Whether to reattempt this subcycle
-          bool reattempt_sub = true;
-          do {
-            // Next lower order estimate
-            Real internal_e_next_l;
-            // Do one dual order RK step
-            dedt_valid = true;
-            RKStepper::Step(sub_t, sub_dt, internal_e, DeDt_wrapper, internal_e_next_h,
-                            internal_e_next_l, dedt_valid);
-
-            sub_attempt++;
-
-            if (!dedt_valid) {
-              if (sub_dt == min_sub_dt) {
-                // Cooling is so fast that even the minimum subcycle dt would lead to
-                // negative internal energy -- so just cool to the floor of the cooling
-                // table
-                sub_dt = (dt - sub_t);
-                internal_e_next_h = internal_e_floor;
-                reattempt_sub = false;
-              } else {
-                reattempt_sub = true;
-                sub_dt = min_sub_dt;
-              }
-            } else {
-
-              // Compute error
-              d_e_err = fabs((internal_e_next_h - internal_e_next_l) / internal_e_next_h);
-
-              reattempt_sub = false;
-              // Accepting or reattempting the subcycle:
-              //
-              // -If the error is small, accept the subcycle
-              //
-              // -If the error on the subcycle is too high, compute a new time
-              // step to reattempt the subcycle
-              //   -But if the new time step is smaller than the minimum subcycle
-              //   time step (total step duration/ max iterations), just use the
-              //   minimum subcycle time step instead
-
-              if (std::isnan(d_e_err)) {
-                reattempt_sub = true;
-                sub_dt = min_sub_dt;
-              } else if (d_e_err >= d_e_tol && sub_dt > min_sub_dt) {
-                // Reattempt this subcycle
-                reattempt_sub = true;
-                // Error was too high, shrink the timestep
-                if (d_e_tol == 0) {
-                  sub_dt = min_sub_dt;
-                } else {
-                  sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
-                }
-                // Don't drop timestep under maximum iteration count
-                if (sub_dt < min_sub_dt || sub_attempt >= max_iter) {
-                  sub_dt = min_sub_dt;
-                }
-              }
-            }
-
-          } while (reattempt_sub);
-          // Accept this subcycle
-          sub_t += sub_dt;
-
-          internal_e = internal_e_next_h;
+        const bool done = SubcycleCell<RKStepper>(
+            cooling_table_obj, rho, dt, min_sub_dt, d_e_tol, internal_e_floor, epsilon,
+            max_iter, first_pass_iter, failures, sub_t, sub_dt, internal_e, sub_iter);
+        if (!done) {
+          const auto n = Kokkos::atomic_fetch_add(&num_entries(), 1);
+          queue.idx(n) = ((b * nx3 + k) * nx2 + j) * nx1 + i;
+          queue.sub_t(n) = sub_t;
+          queue.sub_dt(n) = sub_dt;
+          queue.internal_e(n) = internal_e;
+          queue.sub_iter(n) = sub_iter;
+          return;
+        }
+        finalize_cell(b, k, j, i, internal_e_initial, internal_e, sub_iter);
+      });
 
-          // skip to the end of subcycling if error is 0 (very unlikely)
-          if (d_e_err == 0) {
-            sub_dt = dt - sub_t;
-          } else {
-            // Grow the timestep
-            // (or shrink in case d_e_err >= d_e_tol and sub_dt is already at min_sub_dt)
-            sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
+  std::int64_t num_work = 0;
+  if (use_work_queue) {
+    num_work =
+        Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), num_entries)();
+  }
+  // Following passes only go over the (compacted) stiff cells so that the work is
+  // balanced across threads. The number of subcycles per pass is doubled with every pass
+  // to limit the number of passes (and host synchronizations).
+  unsigned int pass_iter = first_pass_iter;
+  int next = 1;
+  while (num_work > 0) {
+    pass_iter = std::min(2 * pass_iter, max_iter + 2);
+    const unsigned int max_pass_iter = pass_iter;
+    (*queues)[next].Reserve(num_work);
+    const auto next_queue = (*queues)[next];
+    const auto prev_queue = queue;
+    Kokkos::deep_copy(num_entries, 0);
+    Kokkos::parallel_for(
+        "SrcTerms::TabularCooling::SubcyclingSrcTerm::WorkQueue",
+        Kokkos::RangePolicy<>(DevExecSpace(), 0, num_work),
+        KOKKOS_LAMBDA(const std::int64_t n) {
+          auto idx = prev_queue.idx(n);
+          const int i = idx % nx1;
+          idx /= nx1;
+          const int j = idx % nx2;
+          idx /= nx2;
+          const int k = idx % nx3;
+          const int b = idx / nx3;
+          auto &cons = cons_pack(b);
+          const Real rho = cons(IDN, k, j, i);
+          // Conserved variables are only updated once a cell is done
+          const Real internal_e_initial =
+              SpecificInternalEnergy(cons, k, j, i, mhd_enabled);
+
+          Real sub_t = prev_queue.sub_t(n);
+          Real sub_dt = prev_queue.sub_dt(n);
+          Real internal_e = prev_queue.internal_e(n);
+          unsigned int sub_iter = prev_queue.sub_iter(n);
+          const bool done = SubcycleCell<RKStepper>(
+              cooling_table_obj, rho, dt, min_sub_dt, d_e_tol, internal_e_floor, epsilon,
+              max_iter, max_pass_iter, failures, sub_t, sub_dt, internal_e, sub_iter);
+          if (!done) {
+            const auto m = Kokkos::atomic_fetch_add(&num_entries(), 1);
+            next_queue.idx(m) = prev_queue.idx(n);
+            next_queue.sub_t(m) = sub_t;
+            next_queue.sub_dt(m) = sub_dt;
+            next_queue.internal_e(m) = internal_e;
+            next_queue.sub_iter(m) = sub_iter;
+            return;
           }
+          finalize_cell(b, k, j, i, internal_e_initial, internal_e, sub_iter);
+        });
+    num_work =
+        Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), num_entries)();
+    queue = next_queue;
+    next = 1 - next;
+  }
 
-          if (d_e_tol == 0) {
-            sub_dt = min_sub_dt;
+  if (record_cooling_time) {
+    StoreMinCoolingTimes(md, min_cooling_time);
+  }
+  if (count_substeps) {
+    auto substeps_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), substeps);
+    utils::shared_params::WithMutableParam<std::map<int, Real>>(
+        hydro_pkg.get(), "lb_cooling_substeps", [&](auto *lb_cooling_substeps) {
+          for (int b = 0; b < md->NumBlocks(); b++) {
+            (*lb_cooling_substeps)[md->GetBlockData(b)->GetBlockPointer()->gid] +=
+                substeps_h(b);
           }
-
-          // Don't drop timestep under the minimum step size
-          sub_dt = std::max(sub_dt, min_sub_dt);
-
-          // Limit by end time
-          sub_dt = std::min(sub_dt, dt - sub_t);
-
-          sub_iter++;
-        }
-
-        // If cooled below floor, reset to floor value.
-        // This could happen if the floor value is larger than the lower end of the
-        // cooling table or if they are close and the last subcycle in the cooling above
-        // the lower end pushed the temperature below the lower end (and the floor).
-        internal_e = (internal_e > internal_e_floor) ? internal_e : internal_e_floor;
-
-        // Remove the cooling from the total energy density
-        cons(IEN, k, j, i) += rho * (internal_e - internal_e_initial);
-        // Latter technically not required if no other tasks follows before
-        // ConservedToPrim conversion, but keeping it for now (better safe than sorry).
-        prim(IPR, k, j, i) = rho * internal_e * gm1;
-      });
+        });
+  }
 }
 
 void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
@@ -500,11 +1258,6 @@ void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
   const Real X_by_mh2 =
       std::pow((1 - hydro_pkg->Param<Real>("He_mass_fraction")) / units.mh(), 2);
 
-  const auto lambdas = lambdas_;
-  const auto temps = temps_;
-  const auto alpha_k = townsend_alpha_k_;
-  const auto Y_k = townsend_Y_k_;
-
   const auto internal_e_floor = T_floor_ / mbar_gm1_over_kb;
   const auto temp_cool_floor = std::pow(10.0, log_temp_start_); // low end of cool table
 
@@ -517,15 +1270,28 @@ void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
 
-  const auto nbins = alpha_k.extent_int(0);
-
-  // Get reference values
-  const auto temp_final = std::pow(10.0, log_temp_final_);
-  const auto lambda_final = lambda_final_;
+  const CoolingTableObj cooling_table_obj = cooling_table_obj_;
+  const TownsendTable townsend{townsend_coeffs_,
+                               townsend_rows_,
+                               townsend_y_map_,
+                               cooling_table_obj,
+                               static_cast<int>(n_temp_) - 1,
+                               townsend_y_map_.extent_int(0) / static_cast<int>(n_dens_),
+                               n_dens_,
+                               temp_cool_floor,
+                               mbar_gm1_over_kb};
+
+  // Minimum cooling time per block after the update (if used for the timestep) using the
+  // same floor as in EstimateTimeStep
+  const bool record_cooling_time = dt_from_srcterm_;
+  const auto min_cooling_time = MinCoolingTimes(md);
+  const auto interior = InteriorBounds(md);
+  const Real dt_internal_e_floor =
+      std::max<Real>(T_floor_, temp_cool_floor) / mbar_gm1_over_kb;
 
   par_for(
-      DEFAULT_LOOP_PATTERN, "TabularCooling::TownsendSrcTerm", DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      DEFAULT_LOOP_PATTERN, "SrcTerms::TabularCooling::TownsendSrcTerm", DevExecSpace(),
+      0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
@@ -562,36 +1328,8 @@ void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
         }
         const Real n_h2_by_rho = rho * X_by_mh2;
 
-        // Get the index of the right temperature bin
-        // TODO(?) this could be optimized for using a binary search
-        auto idx = 0;
-        while ((idx < nbins - 1) && (temps(idx + 1) < temp)) {
-          idx += 1;
-        }
-
-        // Compute the Temporal Evolution Function Y(T) (Eq. A5)
-        const auto alpha_k_m1 = alpha_k(idx) - 1.0;
-        const auto tef =
-            Y_k(idx) + (lambda_final / lambdas(idx)) * (temps(idx) / temp_final) *
-                           (std::pow(temps(idx) / temp, alpha_k_m1) - 1.0) / alpha_k_m1;
-
-        // Compute the adjusted TEF for new timestep (Eqn. 26) (term in brackets)
-        const auto tef_adj =
-            tef + lambda_final * dt / temp_final * mbar_gm1_over_kb * n_h2_by_rho;
-
-        // TEF is a strictly decreasing function and new_tef > tef
-        // Check if the new TEF falls into a lower bin, i.e., find the right bin for A7
-        // If so, update slopes and coefficients
-        while ((idx > 0) && (tef_adj > Y_k(idx))) {
-          idx -= 1;
-        }
+        const Real temp_new = townsend.NewTemperature(temp, rho, n_h2_by_rho, dt);
 
-        // Compute the Inverse Temporal Evolution Function Y^{-1}(Y) (Eq. A7)
-        const auto temp_new =
-            temps(idx) *
-            std::pow(1 - (1.0 - alpha_k(idx)) * (lambdas(idx) / lambda_final) *
-                             (temp_final / temps(idx)) * (tef_adj - Y_k(idx)),
-                     1.0 / (1.0 - alpha_k(idx)));
         // Set new temp (at the lowest to the lower end of the cooling table)
         const auto internal_e_new = temp_new > temp_cool_floor
                                         ? temp_new / mbar_gm1_over_kb
@@ -600,10 +1338,49 @@ void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
         // Latter technically not required if no other tasks follows before
         // ConservedToPrim conversion, but keeping it for now (better safe than sorry).
         prim(IPR, k, j, i) = rho * internal_e_new * gm1;
+
+        if (record_cooling_time && interior.Contains(k, j, i)) {
+          const Real cooling_time =
+              CoolingTime(cooling_table_obj, rho, internal_e_new, dt_internal_e_floor);
+          Kokkos::atomic_min(&min_cooling_time(b), cooling_time);
+        }
+      });
+
+  if (record_cooling_time) {
+    StoreMinCoolingTimes(md, min_cooling_time);
+  }
+}
+
+CoolingBounds TabularCooling::InteriorBounds(MeshData<Real> *md) const {
+  const auto &rc = md->GetBlockData(0);
+  return CoolingBounds{rc->GetBoundsI(IndexDomain::interior),
+                       rc->GetBoundsJ(IndexDomain::interior),
+                       rc->GetBoundsK(IndexDomain::interior)};
+}
+
+ParArray1D<Real> TabularCooling::MinCoolingTimes(MeshData<Real> *md) const {
+  ParArray1D<Real> min_cooling_time("SrcTerms::TabularCooling::min_cooling_time",
+                                    dt_from_srcterm_ ? md->NumBlocks() : 0);
+  Kokkos::deep_copy(min_cooling_time, std::numeric_limits<Real>::infinity());
+  return min_cooling_time;
+}
+
+void TabularCooling::StoreMinCoolingTimes(
+    MeshData<Real> *md, const ParArray1D<Real> &min_cooling_time) const {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  auto min_cooling_time_h =
+      Kokkos::create_mirror_view_and_copy(HostMemSpace(), min_cooling_time);
+  utils::shared_params::WithMutableParam<std::map<int, Real>>(
+      hydro_pkg.get(), "cooling_min_time", [&](auto *cooling_min_time) {
+        for (int b = 0; b < md->NumBlocks(); b++) {
+          (*cooling_min_time)[md->GetBlockData(b)->GetBlockPointer()->gid] =
+              min_cooling_time_h(b);
+        }
       });
 }
 
 Real TabularCooling::EstimateTimeStep(MeshData<Real> *md) const {
+  utils::profiling::ScopedRegion region("SrcTerms::TabularCooling::EstimateTimeStep");
   if (cooling_time_cfl_ <= 0.0) {
     return std::numeric_limits<Real>::max();
   }
@@ -614,6 +1391,31 @@ Real TabularCooling::EstimateTimeStep(MeshData<Real> *md) const {
 
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
+  // Use the minimum cooling times recorded during the last cooling update of all blocks
+  // (if available). Otherwise, e.g., in the first cycle or for new blocks after a
+  // refinement, the cooling times are computed below.
+  if (dt_from_srcterm_) {
+    Real min_cooling_time = std::numeric_limits<Real>::infinity();
+    bool recorded = true;
+    utils::shared_params::WithMutableParam<std::map<int, Real>>(
+        hydro_pkg.get(), "cooling_min_time", [&](auto *cooling_min_time) {
+          for (int b = 0; b < md->NumBlocks(); b++) {
+            auto it =
+                cooling_min_time->find(md->GetBlockData(b)->GetBlockPointer()->gid);
+            if (it == cooling_min_time->end()) {
+              recorded = false;
+              continue;
+            }
+            min_cooling_time = std::min(min_cooling_time, it->second);
+            // recorded times are only valid for a single cycle
+            cooling_min_time->erase(it);
+          }
+        });
+    if (recorded) {
+      return cooling_time_cfl_ * min_cooling_time;
+    }
+  }
+
   const CoolingTableObj cooling_table_obj = cooling_table_obj_;
   const auto gm1 = (hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0);
   const auto mbar_gm1_over_kb = hydro_pkg->Param<Real>("mbar_over_kb") * gm1;
@@ -635,7 +1437,7 @@ Real TabularCooling::EstimateTimeStep(MeshData<Real> *md) const {
   Kokkos::Min<Real> reducer_min(min_cooling_time);
 
   Kokkos::parallel_reduce(
-      "TabularCooling::TimeStep",
+      "SrcTerms::TabularCooling::EstimateTimeStep",
       Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
           {0, kb.s, jb.s, ib.s}, {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
           {1, 1, 1, ib.e + 1 - ib.s}),
@@ -648,14 +1450,11 @@ Real TabularCooling::EstimateTimeStep(MeshData<Real> *md) const {
 
         const Real internal_e = pres / (rho * gm1);
 
-        const Real de_dt = cooling_table_obj.DeDt(internal_e, rho);
-
         // Compute cooling time
         // If de_dt is zero (temperature is smaller than lower end of cooling table) or
         // current temp is below floor, use infinite cooling time
-        const Real cooling_time = ((de_dt == 0) || (internal_e < internal_e_floor))
-                                      ? std::numeric_limits<Real>::infinity()
-                                      : fabs(internal_e / de_dt);
+        const Real cooling_time =
+            CoolingTime(cooling_table_obj, rho, internal_e, internal_e_floor);
 
         thread_min_cooling_time = std::min(cooling_time, thread_min_cooling_time);
       },
@@ -687,8 +1486,9 @@ void TabularCooling::TestCoolingTable(ParameterInput *pin) const {
       d_internal_e("d_internal_e", n_rho, n_pres), d_de_dt("d_de_dt", n_rho, n_pres);
 
   par_for(
-      loop_pattern_mdrange_tag, "TabularCooling::TestCoolingTable", DevExecSpace(), 0,
-      n_rho - 1, 0, n_pres - 1, KOKKOS_LAMBDA(const int &j, const int &i) {
+      loop_pattern_mdrange_tag, "SrcTerms::TabularCooling::TestCoolingTable",
+      DevExecSpace(), 0, n_rho - 1, 0, n_pres - 1,
+      KOKKOS_LAMBDA(const int &j, const int &i) {
         const Real rho = rho0 * pow(rho1 / rho0, static_cast<Real>(j) / (n_rho - 1));
         const Real pres = pres0 * pow(pres1 / pres0, static_cast<Real>(i) / (n_pres - 1));
 
@@ -721,4 +1521,132 @@ void TabularCooling::TestCoolingTable(ParameterInput *pin) const {
   }
 }
 
+void TabularCooling::Benchmark(ParameterInput *pin,
+                               const StateDescriptor *hydro_pkg) const {
+  const auto n_rho = pin->GetOrAddInteger("cooling", "benchmark_n_rho", 256);
+  const auto n_temp = pin->GetOrAddInteger("cooling", "benchmark_n_temp", 256);
+  const auto n_rep = pin->GetOrAddInteger("cooling", "benchmark_n_rep", 10);
+  // Densities (in code units), step size of the single RK steps, and timestep of the
+  // full integrations relative to the cooling time
+  const auto rho0 = pin->GetOrAddReal("cooling", "benchmark_rho0", 1e-2);
+  const auto rho1 = pin->GetOrAddReal("cooling", "benchmark_rho1", 1e2);
+  const auto cfl = pin->GetOrAddReal("cooling", "benchmark_cfl", 0.1);
+  const auto dt_ratio = pin->GetOrAddReal("cooling", "benchmark_dt_ratio", 1.0);
+  PARTHENON_REQUIRE_THROWS(n_rho > 1 && n_temp > 1 && n_rep > 0,
+                           "cooling/benchmark_n_rho and benchmark_n_temp need to be > 1 "
+                           "and benchmark_n_rep > 0.");
+  PARTHENON_REQUIRE_THROWS(cfl > 0.0 && dt_ratio > 0.0,
+                           "cooling/benchmark_cfl and benchmark_dt_ratio need to be "
+                           "positive.");
+
+  const auto units = hydro_pkg->Param<Units>("units");
+  const auto gm1 = hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0;
+  const auto mbar_gm1_over_kb = hydro_pkg->Param<Real>("mbar_over_kb") * gm1;
+  const Real X_by_mh2 =
+      std::pow((1 - hydro_pkg->Param<Real>("He_mass_fraction")) / units.mh(), 2);
+
+  // Temperatures covering the full table as well as a decade below and above
+  const Real log_temp0 = log_temp_start_ - 1.0;
+  const Real log_temp1 = log_temp_final_ + 1.0;
+
+  ParArray2D<Real> d_rho("d_rho", n_rho, n_temp),
+      d_internal_e("d_internal_e", n_rho, n_temp);
+  par_for(
+      loop_pattern_mdrange_tag, "SrcTerms::TabularCooling::BenchmarkSetup",
+      DevExecSpace(), 0, n_rho - 1, 0, n_temp - 1,
+      KOKKOS_LAMBDA(const int &j, const int &i) {
+        d_rho(j, i) = rho0 * pow(rho1 / rho0, static_cast<Real>(j) / (n_rho - 1));
+        const Real log_temp =
+            log_temp0 + (log_temp1 - log_temp0) * static_cast<Real>(i) / (n_temp - 1);
+        d_internal_e(j, i) = pow(10.0, log_temp) / mbar_gm1_over_kb;
+      });
+
+  // Steps relative to the cooling time at the peak of the cooling curve
+  auto host_log_lambdas =
+      Kokkos::create_mirror_view_and_copy(HostMemSpace(), log_lambdas_);
+  auto host_log_temps = Kokkos::create_mirror_view_and_copy(HostMemSpace(), log_temps_);
+  Real log_lambda_max = host_log_lambdas(0);
+  Real log_temp_max = log_temp_start_;
+  for (unsigned int i = 1; i < n_temp_; i++) {
+    if (host_log_lambdas(i) > log_lambda_max) {
+      log_lambda_max = host_log_lambdas(i);
+      log_temp_max = host_log_temps(i);
+    }
+  }
+  const Real e_max = std::pow(10.0, log_temp_max) / mbar_gm1_over_kb;
+  const Real t_cool = e_max / std::abs(cooling_table_obj_.DeDt(e_max, rho1));
+  const Real h = cfl * t_cool;
+  const Real dt = dt_ratio * t_cool;
+
+  const auto temp_cool_floor = std::pow(10.0, log_temp_start_);
+  const Real internal_e_floor =
+      std::max<Real>(T_floor_, temp_cool_floor) / mbar_gm1_over_kb;
+
+  // Throughput (in cells/s) of all benchmarks in the order of names
+  std::vector<std::string> names;
+  std::vector<Real> throughputs;
+  const Real n_cells = static_cast<Real>(n_rho) * n_temp * n_rep;
+  auto add = [&](const std::string &name, const Real seconds) {
+    names.push_back(name);
+    throughputs.push_back(n_cells / seconds);
+  };
+
+  for (const bool fast : {false, true}) {
+    const auto obj = cooling_table_obj_.WithFastTable(fast);
+    const std::string table = fast ? " fast table" : " default table";
+    auto dedt = KOKKOS_LAMBDA(const int j, const int i) {
+      return obj.DeDt(d_internal_e(j, i), d_rho(j, i));
+    };
+    add("dedt" + table, TimeCells(n_rho, n_temp, n_rep, dedt));
+    add("rk12 step" + table,
+        TimeRKSteps<RK12Stepper>(obj, d_rho, d_internal_e, h, n_rep));
+    add("rk45 step" + table,
+        TimeRKSteps<RK45Stepper>(obj, d_rho, d_internal_e, h, n_rep));
+    Real mean_subcycles;
+    add("rk12 subcycling" + table,
+        TimeSubcycling<RK12Stepper>(obj, d_rho, d_internal_e, dt, d_e_tol_,
+                                    internal_e_floor, KEpsilon_, max_iter_, n_rep,
+                                    mean_subcycles));
+    names.back() += " (" + std::to_string(mean_subcycles) + " subcycles)";
+    add("rk45 subcycling" + table,
+        TimeSubcycling<RK45Stepper>(obj, d_rho, d_internal_e, dt, d_e_tol_,
+                                    internal_e_floor, KEpsilon_, max_iter_, n_rep,
+                                    mean_subcycles));
+    names.back() += " (" + std::to_string(mean_subcycles) + " subcycles)";
+  }
+
+  // The piecewise power law fits are only set up for the Townsend integrator
+  if (integrator_ == CoolIntegrator::townsend) {
+    const TownsendTable townsend{
+        townsend_coeffs_,
+        townsend_rows_,
+        townsend_y_map_,
+        cooling_table_obj_,
+        static_cast<int>(n_temp_) - 1,
+        townsend_y_map_.extent_int(0) / static_cast<int>(n_dens_),
+        n_dens_,
+        temp_cool_floor,
+        mbar_gm1_over_kb};
+    auto townsend_cell = KOKKOS_LAMBDA(const int j, const int i) {
+      const Real rho = d_rho(j, i);
+      const Real temp = mbar_gm1_over_kb * d_internal_e(j, i);
+      if (temp < temp_cool_floor) {
+        return temp;
+      }
+      return townsend.NewTemperature(temp, rho, rho * X_by_mh2, dt);
+    };
+    add("townsend", TimeCells(n_rho, n_temp, n_rep, townsend_cell));
+  }
+
+  if (parthenon::Globals::my_rank == 0) {
+    std::cout << "Cooling table benchmark on " << DevExecSpace::name() << " ("
+              << n_rho * n_temp << " cells, " << n_temp_ << " table temperatures, "
+              << n_rep << " repetitions, dt = " << dt_ratio << " t_cool):\n";
+    for (size_t n = 0; n < names.size(); n++) {
+      std::cout << "  " << names[n] << ": " << throughputs[n] << " cells/s\n";
+    }
+    std::cout << std::flush;
+  }
+}
+
 } // namespace cooling
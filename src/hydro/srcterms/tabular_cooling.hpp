@@ -9,8 +9,12 @@
 #define HYDRO_SRCTERMS_TABULAR_COOLING_HPP_
 
 // C++ headers
+#include <algorithm> // min, max
+#include <array>     // array
+#include <cstdint>   // int64_t
 #include <fstream>   // stringstream
 #include <iterator>  // istream_iterator
+#include <map>       // map
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // string
@@ -26,6 +30,7 @@
 // AthenaPK headers
 #include "../../main.hpp"
 #include "../../units.hpp"
+#include "../../utils/failure_counter.hpp"
 
 #ifdef MPI_PARALLEL
 #include <mpi.h>
@@ -87,42 +92,144 @@ struct RK45Stepper {
 
 enum class CoolIntegrator { undefined, rk12, rk45, townsend };
 
+// Index ranges of the interior of the blocks (to be captured in kernels)
+struct CoolingBounds {
+  parthenon::IndexRange ib, jb, kb;
+  KOKKOS_INLINE_FUNCTION bool Contains(const int k, const int j, const int i) const {
+    return (k >= kb.s && k <= kb.e && j >= jb.s && j <= jb.e && i >= ib.s && i <= ib.e);
+  }
+};
+
 class CoolingTableObj {
   /************************************************************
    *  Cooling Table Object, for interpolating a cooling rate out of a cooling
-   *  table. Currently assumes evenly space log_temperatures in cooling table
+   *  table. Log temperatures of the table are either evenly spaced (direct indexing)
+   *  or non-uniformly spaced, in which case the bin is found through an auxiliary index
+   *  map on a uniform grid in log temperature.
+   *  Two-dimensional tables additionally depend on the (equally spaced) log hydrogen
+   *  number density and are bilinearly interpolated in log space.
    *
    *  Lightweight object intended for inlined computation within kernels
    ************************************************************/
  private:
-  // Log cooling rate/ne^3
+  // Log cooling rate/ne^3 (of row j = density index at j * n_temp_ of 2D tables)
   parthenon::ParArray1D<parthenon::Real> log_lambdas_;
 
-  // Spacing of cooling table
-  // TODO: assumes evenly spaced cooling table
+  // Range of the cooling table and spacing of the uniform grid in log temperature, i.e.,
+  // the spacing of the table (if uniform) or of the index map (if non-uniform)
   parthenon::Real log_temp_start_, log_temp_final_, d_log_temp_;
   unsigned int n_temp_;
 
+  // Non-uniform tables: log temperatures of the table and index map storing the bin
+  // containing the lower edge of each of the n_map_ cells of the uniform grid
+  bool uniform_;
+  parthenon::ParArray1D<parthenon::Real> log_temps_;
+  parthenon::ParArray1D<int> bin_map_;
+  unsigned int n_map_;
+
+  // Density axis of two-dimensional tables (n_dens_ = 1 for one-dimensional tables)
+  unsigned int n_dens_;
+  parthenon::Real log_dens_start_, inv_d_log_dens_, log_nH_over_rho_;
+
   // Mean molecular mass * ( adiabatic_index -1) / boltzmann_constant
   parthenon::Real mbar_gm1_over_k_B_;
 
   // (Hydrogen mass fraction / hydrogen atomic mass)^2
   parthenon::Real x_H_over_m_h2_;
 
+  // Fast path (cooling/fast_table): Per bin power law lambda = exp(c_k + alpha_k ln(T))
+  // stored as interleaved (c_k, alpha_k) together with the table bounds in linear (and
+  // natural log) temperature and the reciprocal spacing so that only a single log and a
+  // single exp are evaluated within the table (and a sqrt above the table).
+  bool fast_table_;
+  parthenon::ParArray1D<parthenon::Real> power_law_coeffs_;
+  parthenon::Real temp_start_, temp_final_, ln_temp_start_, inv_d_ln_temp_,
+      lambda_final_;
+
  public:
   CoolingTableObj()
       : log_lambdas_(), log_temp_start_(NAN), log_temp_final_(NAN), d_log_temp_(NAN),
-        n_temp_(0), mbar_gm1_over_k_B_(NAN), x_H_over_m_h2_(NAN) {}
+        n_temp_(0), uniform_(true), log_temps_(), bin_map_(), n_map_(0), n_dens_(1),
+        log_dens_start_(NAN), inv_d_log_dens_(NAN), log_nH_over_rho_(NAN),
+        mbar_gm1_over_k_B_(NAN), x_H_over_m_h2_(NAN), fast_table_(false),
+        power_law_coeffs_(), temp_start_(NAN), temp_final_(NAN), ln_temp_start_(NAN),
+        inv_d_ln_temp_(NAN), lambda_final_(NAN) {}
   CoolingTableObj(const parthenon::ParArray1D<parthenon::Real> log_lambdas,
                   const parthenon::Real log_temp_start,
                   const parthenon::Real log_temp_final, const parthenon::Real d_log_temp,
-                  const unsigned int n_temp, const parthenon::Real mbar_over_kb,
+                  const unsigned int n_temp, const bool uniform,
+                  const parthenon::ParArray1D<parthenon::Real> log_temps,
+                  const parthenon::ParArray1D<int> bin_map, const unsigned int n_dens,
+                  const parthenon::Real log_dens_start, const parthenon::Real d_log_dens,
+                  const parthenon::Real log_nH_over_rho,
+                  const parthenon::Real mbar_over_kb,
                   const parthenon::Real adiabatic_index, const parthenon::Real x_H,
-                  const Units units)
+                  const Units units, const bool fast_table,
+                  const parthenon::ParArray1D<parthenon::Real> power_law_coeffs,
+                  const parthenon::Real lambda_final)
       : log_lambdas_(log_lambdas), log_temp_start_(log_temp_start),
         log_temp_final_(log_temp_final), d_log_temp_(d_log_temp), n_temp_(n_temp),
+        uniform_(uniform), log_temps_(log_temps), bin_map_(bin_map),
+        n_map_(bin_map.extent(0)), n_dens_(n_dens), log_dens_start_(log_dens_start),
+        inv_d_log_dens_(1.0 / d_log_dens), log_nH_over_rho_(log_nH_over_rho),
         mbar_gm1_over_k_B_(mbar_over_kb * (adiabatic_index - 1)),
-        x_H_over_m_h2_(SQR(x_H / units.mh())) {}
+        x_H_over_m_h2_(SQR(x_H / units.mh())), fast_table_(fast_table),
+        power_law_coeffs_(power_law_coeffs), temp_start_(std::pow(10.0, log_temp_start)),
+        temp_final_(std::pow(10.0, log_temp_final)),
+        ln_temp_start_(log_temp_start * std::log(10.0)),
+        inv_d_ln_temp_(1.0 / (d_log_temp * std::log(10.0))), lambda_final_(lambda_final) {
+  }
+
+  // Bin of a non-uniform table containing log_temp (within the table) given the position
+  // x = (log_temp - log_temp_start_) / d_log_temp_ on the uniform grid of the index map.
+  // Bins are at least as wide as the cells of the map (unless the map size was capped)
+  // so that the loop typically takes at most a single iteration.
+  KOKKOS_INLINE_FUNCTION unsigned int NonUniformBin(const parthenon::Real log_temp,
+                                                    const parthenon::Real x) const {
+    const unsigned int m = std::min(static_cast<unsigned int>(x), n_map_ - 1);
+    unsigned int k = bin_map_(m);
+    while (k < n_temp_ - 2 && log_temp >= log_temps_(k + 1)) {
+      k++;
+    }
+    return k;
+  }
+
+  // Temperature bin k, i.e., log_temps[k] <= log10(T) < log_temps[k + 1], of a
+  // temperature (at or above the lower end of the table) given by its natural log.
+  // Temperatures above the table (and round-off at the upper end) belong to the last bin.
+  KOKKOS_INLINE_FUNCTION unsigned int TempBin(const parthenon::Real ln_temp) const {
+    const parthenon::Real x = (ln_temp - ln_temp_start_) * inv_d_ln_temp_;
+    if (uniform_) {
+      return std::min(static_cast<unsigned int>(x), n_temp_ - 2);
+    }
+    constexpr parthenon::Real inv_ln10 = 0.43429448190325182765;
+    return NonUniformBin(inv_ln10 * ln_temp, x);
+  }
+
+  unsigned int NumDensities() const { return n_dens_; }
+
+  // Lower density row j (and weight w of row j + 1) of two-dimensional tables containing
+  // rho. Densities outside of the table are clamped to the table.
+  KOKKOS_INLINE_FUNCTION void DensityRow(const parthenon::Real rho, unsigned int &j,
+                                         parthenon::Real &w) const {
+    using parthenon::Real;
+    const Real log_dens = log10(rho) + log_nH_over_rho_;
+    const Real x_raw = (log_dens - log_dens_start_) * inv_d_log_dens_;
+    const Real x = std::min<Real>(std::max<Real>(x_raw, 0.0), n_dens_ - 1.0);
+    j = std::min(static_cast<unsigned int>(x), n_dens_ - 2);
+    w = x - j;
+  }
+
+  // Log cooling rate at temperature index i (interpolated between the density rows)
+  KOKKOS_INLINE_FUNCTION parthenon::Real LogLambda(const unsigned int j,
+                                                   const parthenon::Real w,
+                                                   const unsigned int i) const {
+    if (n_dens_ == 1) {
+      return log_lambdas_(i);
+    }
+    return (1.0 - w) * log_lambdas_(j * n_temp_ + i) +
+           w * log_lambdas_((j + 1) * n_temp_ + i);
+  }
 
   // Interpolate a cooling rate from the table
   // from internal energy density and density
@@ -136,18 +243,27 @@ class CoolingTableObj {
     }
 
     const Real temp = mbar_gm1_over_k_B_ * e;
+    if (fast_table_) {
+      return -FastLambda(temp, rho) * x_H_over_m_h2_ * rho;
+    }
     const Real log_temp = log10(temp);
-    Real log_lambda;
     if (log_temp < log_temp_start_) {
       return 0;
-    } else if (log_temp > log_temp_final_) {
+    }
+    unsigned int j = 0;
+    Real w = 0.0;
+    if (n_dens_ > 1) {
+      DensityRow(rho, j, w);
+    }
+    Real log_lambda;
+    if (log_temp > log_temp_final_) {
       // Above table
       // Return de/dt
       // TODO(forrestglines):Currently free-free cooling is used for
       // temperatures above the table. This behavior could be generalized via
       // templates
-      log_lambda = 0.5 * log_temp - 0.5 * log_temp_final_ + log_lambdas_(n_temp_ - 1);
-    } else {
+      log_lambda = 0.5 * log_temp - 0.5 * log_temp_final_ + LogLambda(j, w, n_temp_ - 1);
+    } else if (uniform_) {
       // Inside table, interpolate assuming log spaced temperatures
 
       // Determine where temp is in the table
@@ -159,12 +275,29 @@ class CoolingTableObj {
       PARTHENON_REQUIRE(log_temp >= log_temp_i && log_temp <= log_temp_i + d_log_temp_,
                         "FATAL ERROR in [CoolingTable::DeDt]: Failed to find log_temp");
 
-      const Real log_lambda_i = log_lambdas_(i_temp);
-      const Real log_lambda_ip1 = log_lambdas_(i_temp + 1);
+      const Real log_lambda_i = LogLambda(j, w, i_temp);
+      const Real log_lambda_ip1 = LogLambda(j, w, i_temp + 1);
 
       // Linearly interpolate lambda at log_temp
       log_lambda = log_lambda_i + (log_temp - log_temp_i) *
                                       (log_lambda_ip1 - log_lambda_i) / d_log_temp_;
+    } else {
+      // Inside non-uniform table
+      const unsigned int i_temp =
+          NonUniformBin(log_temp, (log_temp - log_temp_start_) / d_log_temp_);
+      const Real log_temp_i = log_temps_(i_temp);
+      const Real log_temp_ip1 = log_temps_(i_temp + 1);
+
+      PARTHENON_REQUIRE(log_temp >= log_temp_i && log_temp <= log_temp_ip1,
+                        "FATAL ERROR in [CoolingTable::DeDt]: Failed to find log_temp");
+
+      const Real log_lambda_i = LogLambda(j, w, i_temp);
+      const Real log_lambda_ip1 = LogLambda(j, w, i_temp + 1);
+
+      // Linearly interpolate lambda at log_temp
+      log_lambda = log_lambda_i + (log_temp - log_temp_i) *
+                                      (log_lambda_ip1 - log_lambda_i) /
+                                      (log_temp_ip1 - log_temp_i);
     }
     // Return de/dt
     const Real lambda = pow(10., log_lambda);
@@ -172,6 +305,56 @@ class CoolingTableObj {
     return de_dt;
   }
 
+  // Cooling rate lambda(T) of the fast path (identical to the log linear interpolation
+  // of the table up to round-off)
+  KOKKOS_INLINE_FUNCTION parthenon::Real FastLambda(const parthenon::Real temp,
+                                                    const parthenon::Real rho) const {
+    using namespace parthenon;
+    if (temp < temp_start_) {
+      return 0;
+    }
+    unsigned int j = 0;
+    Real w = 0.0;
+    if (n_dens_ > 1) {
+      DensityRow(rho, j, w);
+    }
+    if (temp > temp_final_) {
+      // Above table free-free cooling, see above
+      const Real lambda_final =
+          n_dens_ == 1 ? lambda_final_ : pow(10.0, LogLambda(j, w, n_temp_ - 1));
+      return lambda_final * std::sqrt(temp / temp_final_);
+    }
+    const Real ln_temp = log(temp);
+    const Real x = (ln_temp - ln_temp_start_) * inv_d_ln_temp_;
+    unsigned int k;
+    if (uniform_) {
+      PARTHENON_DEBUG_REQUIRE(x > -1e-8 && x < n_temp_ - 1 + 1e-8,
+                              "FATAL ERROR in [CoolingTable::DeDt]: Failed to find temp");
+      // Upper end of the table (and round-off) belongs to the last bin
+      k = std::min(static_cast<unsigned int>(x), n_temp_ - 2);
+    } else {
+      constexpr Real inv_ln10 = 0.43429448190325182765;
+      k = NonUniformBin(inv_ln10 * ln_temp, x);
+    }
+    const unsigned int idx = 2 * (j * (n_temp_ - 1) + k);
+    if (n_dens_ == 1) {
+      return exp(power_law_coeffs_(idx) + power_law_coeffs_(idx + 1) * ln_temp);
+    }
+    const unsigned int idx_p1 = idx + 2 * (n_temp_ - 1);
+    const Real ln_lambda_j =
+        power_law_coeffs_(idx) + power_law_coeffs_(idx + 1) * ln_temp;
+    const Real ln_lambda_jp1 =
+        power_law_coeffs_(idx_p1) + power_law_coeffs_(idx_p1 + 1) * ln_temp;
+    return exp((1.0 - w) * ln_lambda_j + w * ln_lambda_jp1);
+  }
+
+  // Copy of the object using the fast (or default) table lookup
+  CoolingTableObj WithFastTable(const bool fast_table) const {
+    CoolingTableObj obj = *this;
+    obj.fast_table_ = fast_table;
+    return obj;
+  }
+
   KOKKOS_INLINE_FUNCTION parthenon::Real DeDt(const parthenon::Real &e,
                                               const parthenon::Real &rho) const {
     bool is_valid = true;
@@ -179,9 +362,36 @@ class CoolingTableObj {
   }
 };
 
+// Stiff cells (by their flattened index in the pack) and their subcycling state
+struct CoolingWorkQueue {
+  parthenon::ParArray1D<std::int64_t> idx;
+  parthenon::ParArray1D<parthenon::Real> sub_t, sub_dt, internal_e;
+  parthenon::ParArray1D<unsigned int> sub_iter;
+
+  // Reallocates the (uninitialized) arrays if they hold fewer than n entries
+  void Reserve(const std::int64_t n) {
+    if (static_cast<std::int64_t>(idx.extent(0)) >= n) {
+      return;
+    }
+    const auto alloc = [](const std::string &label) {
+      return Kokkos::view_alloc(Kokkos::WithoutInitializing, label);
+    };
+    idx = parthenon::ParArray1D<std::int64_t>(alloc("cooling queue idx"), n);
+    sub_t = parthenon::ParArray1D<parthenon::Real>(alloc("cooling queue t"), n);
+    sub_dt = parthenon::ParArray1D<parthenon::Real>(alloc("cooling queue dt"), n);
+    internal_e = parthenon::ParArray1D<parthenon::Real>(alloc("cooling queue e"), n);
+    sub_iter = parthenon::ParArray1D<unsigned int>(alloc("cooling queue iter"), n);
+  }
+};
+
+// Work queues of each MeshData kept between the calls of the subcycling (in the Hydro
+// param "cooling_work_queues"). The two queues alternate between the passes.
+using CoolingWorkQueues =
+    std::map<parthenon::MeshData<parthenon::Real> *, std::array<CoolingWorkQueue, 2>>;
+
 class TabularCooling {
  private:
-  // Defines uniformly spaced log temperature range of the table
+  // Defines the log temperature range of the table (and the spacing of uniform tables)
   unsigned int n_temp_;
   parthenon::Real log_temp_start_, log_temp_final_, d_log_temp_, lambda_final_;
 
@@ -189,14 +399,22 @@ class TabularCooling {
   // TODO(forrestglines): Make log_lambdas_ explicitly a texture cache array, use CUDA to
   // interpolate directly
   // Log versions are used in subcyling cooling where cooling rates are interpolated
-  // Non-log versions are used for Townsend cooling
   parthenon::ParArray1D<parthenon::Real> log_lambdas_;
-  parthenon::ParArray1D<parthenon::Real> lambdas_;
-  parthenon::ParArray1D<parthenon::Real> temps_;
-  // Townsend cooling temporal evolution function
-  parthenon::ParArray1D<parthenon::Real> townsend_Y_k_;
-  // Townsend cooling power law indices
-  parthenon::ParArray1D<parthenon::Real> townsend_alpha_k_;
+  // Townsend cooling per bin coefficients of the piecewise power law fits and temporal
+  // evolution function, per density row coefficients, and index maps for the inverse
+  parthenon::ParArray1D<parthenon::Real> townsend_coeffs_;
+  parthenon::ParArray1D<parthenon::Real> townsend_rows_;
+  parthenon::ParArray1D<int> townsend_y_map_;
+  // Density rows of two-dimensional tables (n_dens_ = 1 for one-dimensional tables)
+  unsigned int n_dens_;
+  parthenon::Real log_dens_start_, d_log_dens_;
+
+  // Log temperatures and index map for non-uniformly spaced tables (see CoolingTableObj)
+  bool uniform_;
+  parthenon::ParArray1D<parthenon::Real> log_temps_;
+  parthenon::ParArray1D<int> bin_map_;
+  // Per bin power law coefficients (interleaved c_k, alpha_k) for the fast table lookup
+  parthenon::ParArray1D<parthenon::Real> power_law_coeffs_;
 
   CoolIntegrator integrator_;
 
@@ -209,6 +427,10 @@ class TabularCooling {
   // Maximum number of iterations/subcycles
   unsigned int max_iter_;
 
+  // Number of subcycles in the first pass over all cells before the remaining (stiff)
+  // cells are processed in a compacted work queue. Zero disables the work queue.
+  unsigned int work_queue_subcycles_;
+
   // Cooling CFL
   parthenon::Real cooling_time_cfl_;
 
@@ -219,11 +441,35 @@ class TabularCooling {
   // Tolerances
   parthenon::Real d_log_temp_tol_, d_e_tol_;
 
+  // Whether the cooling timestep uses the minimum cooling time recorded during the
+  // (last) cooling update rather than a separate pass over all cells
+  bool dt_from_srcterm_;
+
+  // Counter of cells whose subcycling failed (if enabled, see hydro/step_retry)
+  utils::FailureCounter failures_;
+
   // Used for roundoff as subcycle approaches end of timestep
   static constexpr parthenon::Real KEpsilon_ = 1e-12;
 
   CoolingTableObj cooling_table_obj_;
 
+  // Recording of the minimum cooling time per block (see cooling/dt_from_srcterm)
+  CoolingBounds InteriorBounds(parthenon::MeshData<parthenon::Real> *md) const;
+  parthenon::ParArray1D<parthenon::Real>
+  MinCoolingTimes(parthenon::MeshData<parthenon::Real> *md) const;
+  void StoreMinCoolingTimes(
+      parthenon::MeshData<parthenon::Real> *md,
+      const parthenon::ParArray1D<parthenon::Real> &min_cooling_time) const;
+
+  // Reads the cooling table and sets up all derived arrays
+  void ReadTable(parthenon::ParameterInput *pin, const Units &units);
+
+  // Binary cache of the derived arrays (see cooling/table_cache)
+  std::string TableCacheKey(parthenon::ParameterInput *pin, const Units &units) const;
+  void WriteTableCache(const std::string &filename, const std::string &key) const;
+  // Returns false if the cache does not exist or does not match the key
+  bool ReadTableCache(const std::string &filename, const std::string &key);
+
  public:
   TabularCooling(parthenon::ParameterInput *pin,
                  std::shared_ptr<parthenon::StateDescriptor> hydro_pkg);
@@ -245,7 +491,21 @@ class TabularCooling {
   // Get a lightweight object for computing cooling rate from the cooling table
   const CoolingTableObj GetCoolingTableObj() const { return cooling_table_obj_; }
 
+  // Memory of the table and all derived arrays in bytes
+  std::size_t TableBytes() const {
+    return (log_lambdas_.size() + townsend_coeffs_.size() + townsend_rows_.size() +
+            log_temps_.size() + power_law_coeffs_.size()) *
+               sizeof(parthenon::Real) +
+           (townsend_y_map_.size() + bin_map_.size()) * sizeof(int);
+  }
+
   void TestCoolingTable(parthenon::ParameterInput *pin) const;
+
+  // Measures the throughput of DeDt, single RK steps, full subcycled integrations, and
+  // (if used) the Townsend integration on a grid of densities and temperatures with the
+  // default and the fast table lookup (see cooling/benchmark)
+  void Benchmark(parthenon::ParameterInput *pin,
+                 const parthenon::StateDescriptor *hydro_pkg) const;
 };
 
 } // namespace cooling
@@ -0,0 +1,158 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file stage_graphs.cpp
+//! \brief Optional recording and replay of the flux kernels as CUDA/HIP graphs
+
+// C++ headers
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <parthenon/package.hpp>
+#include <utils/error_checking.hpp>
+
+// AthenaPK headers
+#include "stage_graphs.hpp"
+
+#if defined(KOKKOS_ENABLE_CUDA)
+#include <cuda_runtime.h>
+#define APK_GRAPHS_AVAILABLE
+#define APK_GPU(name) cuda##name
+using GpuStream_t = cudaStream_t;
+using GpuGraph_t = cudaGraph_t;
+using GpuGraphExec_t = cudaGraphExec_t;
+#elif defined(KOKKOS_ENABLE_HIP)
+#include <hip/hip_runtime.h>
+#define APK_GRAPHS_AVAILABLE
+#define APK_GPU(name) hip##name
+using GpuStream_t = hipStream_t;
+using GpuGraph_t = hipGraph_t;
+using GpuGraphExec_t = hipGraphExec_t;
+#endif
+
+namespace Hydro {
+
+#ifdef APK_GRAPHS_AVAILABLE
+namespace {
+GpuStream_t DevStream() {
+#if defined(KOKKOS_ENABLE_CUDA)
+  return parthenon::DevExecSpace().cuda_stream();
+#else
+  return parthenon::DevExecSpace().hip_stream();
+#endif
+}
+
+void Check(const APK_GPU(Error_t) err, const std::string &what) {
+  if (err != APK_GPU(Success)) {
+    PARTHENON_FAIL("StageGraphs: " + what + " failed with " +
+                   std::string(APK_GPU(GetErrorString)(err)));
+  }
+}
+} // namespace
+#endif
+
+struct StageGraphs::Entry {
+  // Blocks of the MeshData the graph was recorded for (see pack_cache.cpp)
+  std::vector<std::weak_ptr<MeshBlockData<Real>>> block_data;
+  bool warm = false;
+  TaskStatus status = TaskStatus::complete;
+#ifdef APK_GRAPHS_AVAILABLE
+  GpuGraph_t graph = nullptr;
+  GpuGraphExec_t graph_exec = nullptr;
+
+  ~Entry() {
+    if (graph_exec != nullptr) {
+      APK_GPU(GraphExecDestroy)(graph_exec);
+    }
+    if (graph != nullptr) {
+      APK_GPU(GraphDestroy)(graph);
+    }
+  }
+  bool IsRecorded() const { return graph_exec != nullptr; }
+#else
+  bool IsRecorded() const { return false; }
+#endif
+
+  bool SameBlocks(MeshData<Real> *md) const {
+    if (static_cast<int>(block_data.size()) != md->NumBlocks()) {
+      return false;
+    }
+    for (int b = 0; b < md->NumBlocks(); b++) {
+      const auto &rc = md->GetBlockData(b);
+      if (block_data[b].owner_before(rc) || rc.owner_before(block_data[b])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+StageGraphs::StageGraphs(StateDescriptor *hydro_pkg)
+    : enabled_(hydro_pkg->Param<bool>("graph_capture")) {
+#ifndef APK_GRAPHS_AVAILABLE
+  if (enabled_ && parthenon::Globals::my_rank == 0) {
+    std::cout << "### WARNING hydro/graph_capture has no effect as AthenaPK was not "
+                 "built with CUDA or HIP."
+              << std::endl;
+  }
+  enabled_ = false;
+#endif
+}
+
+StageGraphs::~StageGraphs() = default;
+
+void StageGraphs::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
+
+TaskStatus StageGraphs::Run(FluxFun_t *func, std::shared_ptr<MeshData<Real>> &md,
+                            MeshData<Real> *u1_data, const Real gam0, const Real gam1,
+                            const Real beta_dt, const BlockRegion region) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &entry = entries_[Key(func, md.get(), u1_data, region)];
+  if (entry == nullptr || !entry->SameBlocks(md.get())) {
+    entry = std::make_unique<Entry>();
+    for (int b = 0; b < md->NumBlocks(); b++) {
+      entry->block_data.emplace_back(md->GetBlockData(b));
+    }
+  }
+  // Regular first call, which builds the packs (whose setup synchronizes with the host
+  // and, thus, cannot be recorded) and allocates the scratch space
+  if (!entry->warm) {
+    entry->warm = true;
+    return func(md, u1_data, gam0, gam1, beta_dt, region);
+  }
+#ifdef APK_GRAPHS_AVAILABLE
+  const auto stream = DevStream();
+  if (!entry->IsRecorded()) {
+    const auto err =
+        APK_GPU(StreamBeginCapture)(stream, APK_GPU(StreamCaptureModeThreadLocal));
+    if (err != APK_GPU(Success)) {
+      // e.g., if the default execution space uses the legacy default stream
+      if (parthenon::Globals::my_rank == 0) {
+        std::cout << "### WARNING hydro/graph_capture disabled as the stream of the "
+                     "default execution space cannot be captured: "
+                  << APK_GPU(GetErrorString)(err) << std::endl;
+      }
+      enabled_ = false;
+      return func(md, u1_data, gam0, gam1, beta_dt, region);
+    }
+    entry->status = func(md, u1_data, gam0, gam1, beta_dt, region);
+    Check(APK_GPU(StreamEndCapture)(stream, &entry->graph), "ending the capture");
+    Check(APK_GPU(GraphInstantiateWithFlags)(&entry->graph_exec, entry->graph, 0),
+          "instantiating the graph");
+  }
+  Check(APK_GPU(GraphLaunch)(entry->graph_exec, stream), "launching the graph");
+  return entry->status;
+#else
+  return func(md, u1_data, gam0, gam1, beta_dt, region);
+#endif
+}
+
+} // namespace Hydro
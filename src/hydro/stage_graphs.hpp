@@ -0,0 +1,82 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file stage_graphs.hpp
+//! \brief Optional recording and replay of the flux kernels as CUDA/HIP graphs
+
+#ifndef HYDRO_STAGE_GRAPHS_HPP_
+#define HYDRO_STAGE_GRAPHS_HPP_
+
+// C++ headers
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../main.hpp"
+#include "hydro.hpp"
+
+using namespace parthenon::package::prelude;
+
+namespace Hydro {
+
+// Records the kernels launched by a flux calculation task (for a MeshData, register, and
+// BlockRegion) into a graph (via stream capture) and replays the graph in following
+// calls, which replaces the launches of the individual kernels by a single one.
+// Graphs are recorded at the second call (so that packs and scratch space are set up by
+// the first) and recorded again after the blocks of a MeshData changed.
+// Only the flux calculation is recorded as it is the only task consisting of multiple
+// kernels whose arguments do not change between cycles, whereas the other tasks involve
+// communication, host logic, or the timestep.
+// Enabled by <hydro/graph_capture> for CUDA and HIP builds (no-op otherwise).
+class StageGraphs {
+ public:
+  explicit StageGraphs(StateDescriptor *hydro_pkg);
+  ~StageGraphs();
+
+  bool IsEnabled() const { return enabled_; }
+
+  // Returns a callable (to be passed to TaskList::AddTask) that calls func or replays
+  // its recorded kernels.
+  auto Wrap(FluxFun_t *func) {
+    return [this, func](std::shared_ptr<MeshData<Real>> &md, MeshData<Real> *u1_data,
+                        const Real gam0, const Real gam1, const Real beta_dt,
+                        const BlockRegion region) {
+      if (!enabled_) {
+        return func(md, u1_data, gam0, gam1, beta_dt, region);
+      }
+      return Run(func, md, u1_data, gam0, gam1, beta_dt, region);
+    };
+  }
+
+  // Drops all graphs (e.g., after remeshing so that graphs of MeshData that are no
+  // longer used are freed)
+  void Clear();
+
+ private:
+  struct Entry;
+  // flux function, MeshData (of the register), register of the fused update, region
+  using Key = std::tuple<FluxFun_t *, const MeshData<Real> *, const MeshData<Real> *,
+                         BlockRegion>;
+
+  TaskStatus Run(FluxFun_t *func, std::shared_ptr<MeshData<Real>> &md,
+                 MeshData<Real> *u1_data, const Real gam0, const Real gam1,
+                 const Real beta_dt, const BlockRegion region);
+
+  bool enabled_;
+  std::map<Key, std::unique_ptr<Entry>> entries_;
+  // Kernels launched by other threads would be recorded, too. Thus, recording and
+  // replaying are serialized (task lists are still required to be executed by a
+  // single thread, see docs/input.md).
+  std::mutex mutex_;
+};
+
+} // namespace Hydro
+
+#endif // HYDRO_STAGE_GRAPHS_HPP_
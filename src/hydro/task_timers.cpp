@@ -0,0 +1,316 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file task_timers.cpp
+//! \brief Optional timing of the tasks of the HydroDriver
+
+// C++ headers
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Parthenon headers
+#include "bvals/boundary_conditions.hpp"
+#include "bvals/comms/bvals_in_one.hpp"
+#include <parthenon/driver.hpp>
+#include <parthenon/package.hpp>
+
+#include "globals.hpp"
+
+// AthenaPK headers
+#include "../bvals/boundary_conditions_apk.hpp"
+#include "task_timers.hpp"
+
+namespace Hydro {
+
+namespace {
+const char *task_names[] = {"agn_triggering",
+                            "magnetic_tower",
+                            "split_sources_strang",
+                            "calc_fluxes",
+                            "first_order_flux_correct",
+                            "flux_correction",
+                            "update",
+                            "unsplit_sources",
+                            "split_sources_first_order",
+                            "boundary_exchange",
+                            "fill_derived",
+                            "sts_diff_fluxes",
+                            "sts_step",
+                            "sts_boundary_exchange",
+                            "implicit_conduction",
+                            "estimate_timestep",
+                            "tracers",
+                            "refinement_tag",
+                            "prolongation"};
+static_assert(sizeof(task_names) / sizeof(task_names[0]) ==
+                  static_cast<size_t>(TimedTask::num_tasks),
+              "Names of timed tasks do not match TimedTask.");
+} // namespace
+
+TaskTimers::TaskTimers(StateDescriptor *hydro_pkg)
+    : enabled_(hydro_pkg->Param<bool>("task_timers") ||
+               hydro_pkg->Param<bool>("roofline")),
+      csv_(hydro_pkg->Param<bool>("task_timers")),
+      roofline_(hydro_pkg->Param<bool>("roofline")),
+      ncycles_(hydro_pkg->Param<int>("task_timers_ncycles")),
+      filename_(hydro_pkg->Param<std::string>("task_timers_file")) {
+  if (!roofline_) {
+    return;
+  }
+  // Rough estimates per (interior) cell and call. Each cell is assumed to be read and
+  // written once per kernel (and direction for directionally split kernels), i.e.,
+  // neighboring cells required by stencils are cached. FLOPs count additions,
+  // multiplications, divisions, and square roots as one operation each.
+  const auto fluid = hydro_pkg->Param<Fluid>("fluid");
+  const bool mhd = fluid == Fluid::glmmhd;
+  const Real nv = hydro_pkg->Param<int>("nhydro") + hydro_pkg->Param<int>("nscalars");
+  const Real nd = hydro_pkg->Param<int>("ndim");
+  const Real real = sizeof(Real);
+
+  // Reconstruction of a single variable at both faces of a cell
+  Real recon_flops = 0.0;
+  switch (hydro_pkg->Param<Reconstruction>("reconstruction")) {
+  case Reconstruction::plm:
+    recon_flops = 12.0;
+    break;
+  case Reconstruction::ppm:
+    recon_flops = 60.0;
+    break;
+  case Reconstruction::wenoz:
+    recon_flops = 80.0;
+    break;
+  case Reconstruction::weno3:
+    recon_flops = 35.0;
+    break;
+  case Reconstruction::limo3:
+    recon_flops = 30.0;
+    break;
+  default:
+    break;
+  }
+  // Riemann solver at a single face
+  Real riemann_flops = 0.0;
+  switch (hydro_pkg->Param<RiemannSolver>("riemann")) {
+  case RiemannSolver::llf:
+    riemann_flops = mhd ? 75.0 : 45.0;
+    break;
+  case RiemannSolver::hlle:
+    riemann_flops = mhd ? 120.0 : 70.0;
+    break;
+  case RiemannSolver::hllc:
+    riemann_flops = 110.0;
+    break;
+  case RiemannSolver::hlld:
+    riemann_flops = 300.0;
+    break;
+  default:
+    break;
+  }
+
+  // Read u0, u1, and the fluxes (of the lower faces) and write u0
+  const RooflineModel update{(3.0 + nd) * nv * real, nv * (2.0 * nd + 4.0)};
+  auto &models = models_;
+  auto set = [&models](const TimedTask task, const RooflineModel model) {
+    models[static_cast<int>(task)] = model;
+  };
+  // Read prim and write the fluxes in each direction
+  RooflineModel calc_fluxes{2.0 * nd * nv * real,
+                            nd * (nv * recon_flops + riemann_flops)};
+  if (hydro_pkg->Param<bool>("fused_update")) {
+    // fluxes are not written but only used for the update
+    calc_fluxes.bytes += update.bytes - 2.0 * nd * nv * real;
+    calc_fluxes.flops += update.flops;
+  }
+  set(TimedTask::calc_fluxes, calc_fluxes);
+  set(TimedTask::update, update);
+  // Read u0, u1, and the fluxes for the first order update check and write the
+  // corrected fluxes (in the worst case)
+  set(TimedTask::first_order_flux_correct,
+      {(2.0 + 2.0 * nd) * nv * real, nd * riemann_flops + nv * (2.0 * nd + 4.0)});
+  // Conversion from conserved to primitive variables (and derived fields)
+  set(TimedTask::fill_derived, {2.0 * nv * real, (mhd ? 35.0 : 20.0) + nv});
+  if (hydro_pkg->Param<Cooling>("enable_cooling") == Cooling::tabular) {
+    // Read density, momentum, energy (and magnetic field) and write energy for a
+    // single subcycle of the cooling integration (including the table lookups)
+    set(TimedTask::unsplit_sources, {(mhd ? 10.0 : 7.0) * real, 150.0});
+  }
+
+  // Diffusive fluxes of energy (and momentum or magnetic field) in each direction
+  RooflineModel diff_fluxes{0.0, 0.0};
+  const auto conduction = hydro_pkg->Param<Conduction>("conduction");
+  if (conduction != Conduction::none) {
+    const bool aniso = conduction == Conduction::anisotropic;
+    diff_fluxes.bytes += ((aniso ? 5.0 : 2.0) + nd) * real;
+    diff_fluxes.flops += nd * (aniso ? 90.0 : 25.0);
+  }
+  if (hydro_pkg->Param<Viscosity>("viscosity") != Viscosity::none) {
+    diff_fluxes.bytes += (4.0 + 4.0 * nd) * real;
+    diff_fluxes.flops += nd * 60.0;
+  }
+  if (hydro_pkg->Param<Resistivity>("resistivity") != Resistivity::none) {
+    diff_fluxes.bytes += (3.0 + 4.0 * nd) * real;
+    diff_fluxes.flops += nd * 50.0;
+  }
+  if (diff_fluxes.bytes > 0.0) {
+    set(TimedTask::sts_diff_fluxes, diff_fluxes);
+    // RKL2 stage: read Y_j-1, Y_j-2, Y0, MY0, and the fluxes and write Y_j and Y_j-2
+    set(TimedTask::sts_step, {(6.0 + nd) * nv * real, nv * (2.0 * nd + 8.0)});
+  }
+}
+
+void TaskTimers::Add(const TimedTask task, const Real seconds,
+                     const std::int64_t cells) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  seconds_[static_cast<int>(task)] += seconds;
+  calls_[static_cast<int>(task)] += 1;
+  total_seconds_[static_cast<int>(task)] += seconds;
+  total_cells_[static_cast<int>(task)] += cells;
+}
+
+TaskID TaskTimers::AddBoundaryExchangeTasks(const TimedTask task, TaskID dependency,
+                                            TaskList &tl,
+                                            std::shared_ptr<MeshData<Real>> &md,
+                                            const bool multilevel) {
+  if (!enabled_) {
+    return AddExchangeTasks(dependency, tl, md, multilevel);
+  }
+  const auto key = std::make_pair(static_cast<int>(task), md.get());
+  auto start = tl.AddTask(dependency, [this, key]() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    spans_[key].reset();
+    return TaskStatus::complete;
+  });
+  auto exchange = AddExchangeTasks(start, tl, md, multilevel);
+  // Not returned as dependency so that following tasks are not delayed.
+  tl.AddTask(exchange, [this, task, key]() {
+    Real seconds;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      seconds = spans_[key].seconds();
+    }
+    Add(task, seconds);
+    return TaskStatus::complete;
+  });
+  return exchange;
+}
+
+TaskID TaskTimers::AddExchangeTasks(TaskID dependency, TaskList &tl,
+                                    std::shared_ptr<MeshData<Real>> &md,
+                                    const bool multilevel) {
+  using BoundaryFunction::ApplyBoundaryConditionsOnCoarseOrFineMD;
+  const auto any = parthenon::BoundaryType::any;
+  auto send = tl.AddTask(dependency, parthenon::SendBoundBufs<any>, md);
+  auto recv = tl.AddTask(dependency, parthenon::ReceiveBoundBufs<any>, md);
+  auto set = tl.AddTask(recv, parthenon::SetBounds<any>, md);
+  auto pro = set;
+  if (multilevel) {
+    auto cbound = tl.AddTask(set, ApplyBoundaryConditionsOnCoarseOrFineMD, md, true);
+    pro = tl.AddTask(cbound,
+                     Wrap(TimedTask::prolongation, parthenon::ProlongateBounds<any>), md);
+  }
+  return tl.AddTask(send | pro, ApplyBoundaryConditionsOnCoarseOrFineMD, md, false);
+}
+
+void TaskTimers::NewCycle(const int ncycle) {
+  if (!csv_) {
+    return;
+  }
+  if (last_output_cycle_ < 0) {
+    last_output_cycle_ = ncycle;
+    return;
+  }
+  const int window = ncycle - last_output_cycle_;
+  if (window < ncycles_) {
+    return;
+  }
+
+  std::array<Real, num_tasks_> min_seconds = seconds_;
+  std::array<Real, num_tasks_> max_seconds = seconds_;
+  std::array<Real, num_tasks_> sum_seconds = seconds_;
+  std::array<int, num_tasks_> max_calls = calls_;
+  int nranks = 1;
+#ifdef MPI_PARALLEL
+  nranks = parthenon::Globals::nranks;
+  const bool root = parthenon::Globals::my_rank == 0;
+  PARTHENON_MPI_CHECK(MPI_Reduce(root ? MPI_IN_PLACE : min_seconds.data(),
+                                 min_seconds.data(), num_tasks_, MPI_PARTHENON_REAL,
+                                 MPI_MIN, 0, MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Reduce(root ? MPI_IN_PLACE : max_seconds.data(),
+                                 max_seconds.data(), num_tasks_, MPI_PARTHENON_REAL,
+                                 MPI_MAX, 0, MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Reduce(root ? MPI_IN_PLACE : sum_seconds.data(),
+                                 sum_seconds.data(), num_tasks_, MPI_PARTHENON_REAL,
+                                 MPI_SUM, 0, MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Reduce(root ? MPI_IN_PLACE : max_calls.data(), max_calls.data(),
+                                 num_tasks_, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD));
+#endif
+
+  if (parthenon::Globals::my_rank == 0) {
+    std::ofstream outfile;
+    if (!file_initialized_) {
+      outfile.open(filename_, std::ios::trunc);
+      outfile << "cycle,ncycles,task,calls,min,mean,max" << std::endl;
+      file_initialized_ = true;
+    } else {
+      outfile.open(filename_, std::ios::app);
+    }
+    outfile << std::scientific << std::setprecision(6);
+    for (int n = 0; n < num_tasks_; n++) {
+      if (max_calls[n] == 0) {
+        continue;
+      }
+      outfile << ncycle << "," << window << "," << task_names[n] << "," << max_calls[n]
+              << "," << min_seconds[n] / window << ","
+              << sum_seconds[n] / (nranks * window) << "," << max_seconds[n] / window
+              << std::endl;
+    }
+  }
+
+  seconds_.fill(0.0);
+  calls_.fill(0);
+  last_output_cycle_ = ncycle;
+}
+
+void TaskTimers::ReportRoofline() {
+  if (!roofline_) {
+    return;
+  }
+  // Summed over ranks
+  std::array<Real, num_tasks_> seconds = total_seconds_;
+  std::array<Real, num_tasks_> bytes{};
+  std::array<Real, num_tasks_> flops{};
+  for (int n = 0; n < num_tasks_; n++) {
+    bytes[n] = models_[n].bytes * static_cast<Real>(total_cells_[n]);
+    flops[n] = models_[n].flops * static_cast<Real>(total_cells_[n]);
+  }
+#ifdef MPI_PARALLEL
+  const bool root = parthenon::Globals::my_rank == 0;
+  for (auto *vals : {&seconds, &bytes, &flops}) {
+    PARTHENON_MPI_CHECK(MPI_Reduce(root ? MPI_IN_PLACE : vals->data(), vals->data(),
+                                   num_tasks_, MPI_PARTHENON_REAL, MPI_SUM, 0,
+                                   MPI_COMM_WORLD));
+  }
+#endif
+
+  if (parthenon::Globals::my_rank == 0) {
+    std::cout << "Roofline estimates (achieved rates per rank) of the tasks:"
+              << std::endl;
+    for (int n = 0; n < num_tasks_; n++) {
+      if (models_[n].bytes == 0.0 || seconds[n] == 0.0 || bytes[n] == 0.0) {
+        continue;
+      }
+      std::cout << "  " << task_names[n] << ": " << std::scientific
+                << std::setprecision(3) << seconds[n] / parthenon::Globals::nranks
+                << " s, " << bytes[n] / seconds[n] / 1e9 << " GB/s, "
+                << flops[n] / seconds[n] / 1e9 << " GFLOP/s, "
+                << flops[n] / bytes[n] << " FLOP/byte" << std::defaultfloat
+                << std::endl;
+    }
+  }
+}
+
+} // namespace Hydro
@@ -0,0 +1,177 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file task_timers.hpp
+//! \brief Optional timing of the tasks of the HydroDriver
+
+#ifndef HYDRO_TASK_TIMERS_HPP_
+#define HYDRO_TASK_TIMERS_HPP_
+
+// C++ headers
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+// Parthenon headers
+#include <parthenon/driver.hpp>
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../main.hpp"
+
+using namespace parthenon::driver::prelude;
+
+namespace Hydro {
+
+// Tasks (or groups of tasks) of the HydroDriver that can be timed.
+// Order and names (see task_timers.cpp) must match.
+enum class TimedTask {
+  agn_triggering,
+  magnetic_tower,
+  split_sources_strang,
+  calc_fluxes,
+  first_order_flux_correct,
+  flux_correction,
+  update,
+  unsplit_sources, // includes cooling
+  split_sources_first_order,
+  boundary_exchange,
+  fill_derived,
+  sts_diff_fluxes,
+  sts_step,
+  sts_boundary_exchange,
+  implicit_conduction, // complete solve incl. ghost exchanges and reductions
+  estimate_timestep,
+  tracers,
+  refinement_tag,
+  prolongation, // of ghost cells at fine-coarse boundaries (part of boundary exchanges)
+  num_tasks
+};
+
+// Static per cell model of the data moved from/to memory (assuming perfect caching of
+// neighboring cells) and of the floating point operations of a task called for a
+// MeshData, see TaskTimers::TaskTimers for the estimates.
+struct RooflineModel {
+  Real bytes = 0.0;
+  Real flops = 0.0;
+};
+
+// Number of interior cells processed by a task called with args, i.e., those of the
+// first MeshData argument. Calls for the rim of blocks count as zero cells as the
+// cells are already counted by the call for the interior, see BlockRegion.
+inline void CountCells(MeshData<Real> *md, std::int64_t &cells, bool &) {
+  if (cells < 0 && md != nullptr) {
+    const auto &rc = md->GetBlockData(0);
+    const auto ib = rc->GetBoundsI(parthenon::IndexDomain::interior);
+    const auto jb = rc->GetBoundsJ(parthenon::IndexDomain::interior);
+    const auto kb = rc->GetBoundsK(parthenon::IndexDomain::interior);
+    cells = static_cast<std::int64_t>(md->NumBlocks()) * (ib.e - ib.s + 1) *
+            (jb.e - jb.s + 1) * (kb.e - kb.s + 1);
+  }
+}
+inline void CountCells(const std::shared_ptr<MeshData<Real>> &md, std::int64_t &cells,
+                       bool &rim) {
+  CountCells(md.get(), cells, rim);
+}
+inline void CountCells(const BlockRegion region, std::int64_t &, bool &rim) {
+  rim = rim || region == BlockRegion::rim;
+}
+template <typename T>
+void CountCells(const T &, std::int64_t &, bool &) {}
+
+template <typename... Args>
+std::int64_t NumCells(const Args &...args) {
+  std::int64_t cells = -1;
+  bool rim = false;
+  (CountCells(args, cells, rim), ...);
+  return (cells < 0 || rim) ? 0 : cells;
+}
+
+// Accumulates the time spent in wrapped tasks (summed over all task lists and calls on a
+// rank) and periodically writes the min/mean/max across ranks (per cycle averaged over
+// hydro/task_timers_ncycles cycles) to the hydro/task_timers_file CSV file.
+// With hydro/roofline, the number of cells processed by the tasks is counted in addition
+// and the achieved bandwidth and FLOP rate of the tasks with a RooflineModel are
+// reported at the end of the simulation.
+// Kernels are fenced after each timed task so that the time can be attributed to the
+// task, which perturbs asynchronous execution. Thus, timers are disabled by default.
+class TaskTimers {
+ public:
+  explicit TaskTimers(StateDescriptor *hydro_pkg);
+
+  bool IsEnabled() const { return enabled_; }
+
+  // Returns a callable (to be passed to TaskList::AddTask) that forwards all arguments to
+  // func and adds the time spent in it to task.
+  template <typename F>
+  auto Wrap(const TimedTask task, F func) {
+    return [this, task, func](auto &&...args) {
+      if (!enabled_) {
+        return func(std::forward<decltype(args)>(args)...);
+      }
+      const auto cells = roofline_ ? NumCells(args...) : 0;
+      Kokkos::Timer timer;
+      auto status = func(std::forward<decltype(args)>(args)...);
+      Kokkos::fence();
+      Add(task, timer.seconds(), cells);
+      return status;
+    };
+  }
+
+  // Same as parthenon::AddBoundaryExchangeTasks (but applying the packed boundary
+  // conditions, see bvals/boundary_conditions_apk.hpp) and (if enabled) times the wall
+  // time from the start of the exchange until its completion. Note that this includes
+  // the time of other tasks of the same task list being executed while the exchange is
+  // pending.
+  // With multilevel meshes, the prolongation of the ghost cells is additionally timed
+  // separately (TimedTask::prolongation).
+  TaskID AddBoundaryExchangeTasks(const TimedTask task, TaskID dependency, TaskList &tl,
+                                  std::shared_ptr<MeshData<Real>> &md,
+                                  const bool multilevel);
+
+  // To be called (collectively on all ranks) once at the beginning of each cycle.
+  // Writes the timings if hydro/task_timers_ncycles cycles passed since the last output.
+  void NewCycle(const int ncycle);
+
+  // To be called (collectively on all ranks) at the end of the simulation.
+  // Prints the achieved bandwidth and FLOP rate (averaged over ranks) of all tasks with
+  // a RooflineModel if hydro/roofline is enabled.
+  void ReportRoofline();
+
+ private:
+  void Add(const TimedTask task, const Real seconds, const std::int64_t cells = 0);
+  // Tasks of parthenon::AddBoundaryExchangeTasks with a timed prolongation and the
+  // packed boundary conditions
+  TaskID AddExchangeTasks(TaskID dependency, TaskList &tl,
+                          std::shared_ptr<MeshData<Real>> &md, const bool multilevel);
+
+  bool enabled_;
+  bool csv_;
+  bool roofline_;
+  int ncycles_;
+  std::string filename_;
+  int last_output_cycle_ = -1;
+  bool file_initialized_ = false;
+
+  static constexpr int num_tasks_ = static_cast<int>(TimedTask::num_tasks);
+  std::array<Real, num_tasks_> seconds_{};
+  std::array<int, num_tasks_> calls_{};
+  // accumulated over the whole simulation for the roofline report
+  std::array<RooflineModel, num_tasks_> models_{};
+  std::array<Real, num_tasks_> total_seconds_{};
+  std::array<std::int64_t, num_tasks_> total_cells_{};
+  // start of boundary exchanges in flight, see AddBoundaryExchangeTasks
+  std::map<std::pair<int, const MeshData<Real> *>, Kokkos::Timer> spans_;
+  // task lists may be executed by multiple threads
+  std::mutex mutex_;
+};
+
+} // namespace Hydro
+
+#endif // HYDRO_TASK_TIMERS_HPP_
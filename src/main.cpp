@@ -4,6 +4,8 @@
 
 #include <sstream>
 
+#include <sys/resource.h>
+
 // Parthenon headers
 #include "bvals/boundary_conditions_generic.hpp"
 #include "defs.hpp"
@@ -16,8 +18,10 @@
 #include "hydro/hydro_driver.hpp"
 #include "main.hpp"
 
+#include "pgen/cloud_frame.hpp"
 #include "pgen/pgen.hpp"
 #include "tracers/tracers.hpp"
+#include "utils/ensemble.hpp"
 // Initialize defaults for package specific callback functions
 namespace Hydro {
 InitPackageDataFun_t ProblemInitPackageData = nullptr;
@@ -25,7 +29,12 @@ SourceFun_t ProblemSourceFirstOrder = nullptr;
 SourceFun_t ProblemSourceStrangSplit = nullptr;
 SourceFun_t ProblemSourceUnsplit = nullptr;
 EstimateTimestepFun_t ProblemEstimateTimestep = nullptr;
+ConsToPrimFun_t ProblemConsToPrim = nullptr;
+MeshUserWorkFun_t ProblemUserMeshWorkBeforeOutput = nullptr;
+MeshUserWorkFun_t ProblemPreStepMeshUserWork = nullptr;
 std::function<AmrTag(MeshBlockData<Real> *mbd)> ProblemCheckRefinementBlock = nullptr;
+std::function<void(MeshData<Real> *md, parthenon::ParArray1D<AmrTag> &amr_tags)>
+    ProblemCheckRefinementMesh = nullptr;
 } // namespace Hydro
 
 namespace Tracers {
@@ -55,6 +64,7 @@ int main(int argc, char *argv[]) {
   // Redefine defaults
   pman.app_input->ProcessPackages = Hydro::ProcessPackages;
   pman.app_input->PreStepMeshUserWorkInLoop = Hydro::PreStepMeshUserWorkInLoop;
+  pman.app_input->UserMeshWorkBeforeOutput = Hydro::UserMeshWorkBeforeOutput;
   const auto problem = pman.pinput->GetOrAddString("job", "problem_id", "unset");
 
   if (problem == "linear_wave") {
@@ -73,12 +83,21 @@ int main(int argc, char *argv[]) {
   } else if (problem == "cloud") {
     pman.app_input->InitUserMeshData = cloud::InitUserMeshData;
     pman.app_input->ProblemGenerator = cloud::ProblemGenerator;
-    pman.app_input->RegisterBoundaryCondition(parthenon::BoundaryFace::inner_x2,
-                                              "cloud_inflow_x2", cloud::InflowWindX2);
-    Hydro::ProblemCheckRefinementBlock = cloud::ProblemCheckRefinementBlock;
+    Hydro::ProblemInitPackageData = cloud::ProblemInitPackageData;
+    Hydro::ProblemPreStepMeshUserWork = cloud_frame::Track;
+    Hydro::BoundaryFunction::RegisterBoundaryCondition(
+        pman.pinput.get(), pman.app_input.get(), parthenon::BoundaryFace::inner_x2,
+        "cloud_inflow_x2", cloud::InflowWindX2, cloud::InflowWindX2Packed);
+    Hydro::ProblemCheckRefinementMesh = cloud::ProblemCheckRefinementMesh;
   } else if (problem == "moving_cloud") {
     pman.app_input->InitUserMeshData = moving_cloud::InitUserMeshData;
     pman.app_input->ProblemGenerator = moving_cloud::ProblemGenerator;
+    Hydro::ProblemInitPackageData = moving_cloud::ProblemInitPackageData;
+    Hydro::ProblemPreStepMeshUserWork = cloud_frame::Track;
+    Hydro::BoundaryFunction::RegisterBoundaryCondition(
+        pman.pinput.get(), pman.app_input.get(), parthenon::BoundaryFace::outer_x1,
+        "moving_cloud_inflow_ox1", moving_cloud::InflowAmbientOX1,
+        moving_cloud::InflowAmbientOX1Packed);
   } else if (problem == "blast") {
     pman.app_input->InitUserMeshData = blast::InitUserMeshData;
     pman.app_input->ProblemGenerator = blast::ProblemGenerator;
@@ -103,11 +122,14 @@ int main(int argc, char *argv[]) {
     Hydro::ProblemSourceFirstOrder = rand_blast::RandomBlasts;
   } else if (problem == "cluster") {
     pman.app_input->MeshProblemGenerator = cluster::ProblemGenerator;
-    pman.app_input->MeshBlockUserWorkBeforeOutput = cluster::UserWorkBeforeOutput;
+    pman.app_input->InitMeshBlockUserData = cluster::InitMeshBlockUserData;
+    Hydro::ProblemUserMeshWorkBeforeOutput = cluster::UserMeshWorkBeforeOutput;
+    Hydro::ProblemPreStepMeshUserWork = cluster::OutputRadialProfiles;
     Hydro::ProblemInitPackageData = cluster::ProblemInitPackageData;
     Hydro::ProblemSourceUnsplit = cluster::ClusterUnsplitSrcTerm;
     Hydro::ProblemSourceFirstOrder = cluster::ClusterSplitSrcTerm;
     Hydro::ProblemEstimateTimestep = cluster::ClusterEstimateTimestep;
+    Hydro::ProblemConsToPrim = cluster::ClusterConsToPrim;
   } else if (problem == "sod") {
     pman.app_input->ProblemGenerator = sod::ProblemGenerator;
   } else if (problem == "turbulence") {
@@ -125,22 +147,35 @@ int main(int argc, char *argv[]) {
     PARTHENON_THROW(msg);
   }
 
+  // Batch independent realizations of the problem along an additional mesh direction
+  utils::ensemble::Setup(pman.pinput.get(), pman.app_input.get());
+
   const std::string REFLECTING = "reflecting";
   using BF = parthenon::BoundaryFace;
   using Hydro::BoundaryFunction::ReflectBC;
+  using Hydro::BoundaryFunction::ReflectBCPacked;
+  using Hydro::BoundaryFunction::RegisterBoundaryCondition;
   using parthenon::BoundaryFunction::BCSide;
-  pman.app_input->RegisterBoundaryCondition(BF::inner_x1, REFLECTING,
-                                            ReflectBC<X1DIR, BCSide::Inner>);
-  pman.app_input->RegisterBoundaryCondition(BF::outer_x1, REFLECTING,
-                                            ReflectBC<X1DIR, BCSide::Outer>);
-  pman.app_input->RegisterBoundaryCondition(BF::inner_x2, REFLECTING,
-                                            ReflectBC<X2DIR, BCSide::Inner>);
-  pman.app_input->RegisterBoundaryCondition(BF::outer_x2, REFLECTING,
-                                            ReflectBC<X2DIR, BCSide::Outer>);
-  pman.app_input->RegisterBoundaryCondition(BF::inner_x3, REFLECTING,
-                                            ReflectBC<X3DIR, BCSide::Inner>);
-  pman.app_input->RegisterBoundaryCondition(BF::outer_x3, REFLECTING,
-                                            ReflectBC<X3DIR, BCSide::Outer>);
+  auto pin = pman.pinput.get();
+  auto app_input = pman.app_input.get();
+  RegisterBoundaryCondition(pin, app_input, BF::inner_x1, REFLECTING,
+                            ReflectBC<X1DIR, BCSide::Inner>,
+                            ReflectBCPacked<X1DIR, BCSide::Inner>);
+  RegisterBoundaryCondition(pin, app_input, BF::outer_x1, REFLECTING,
+                            ReflectBC<X1DIR, BCSide::Outer>,
+                            ReflectBCPacked<X1DIR, BCSide::Outer>);
+  RegisterBoundaryCondition(pin, app_input, BF::inner_x2, REFLECTING,
+                            ReflectBC<X2DIR, BCSide::Inner>,
+                            ReflectBCPacked<X2DIR, BCSide::Inner>);
+  RegisterBoundaryCondition(pin, app_input, BF::outer_x2, REFLECTING,
+                            ReflectBC<X2DIR, BCSide::Outer>,
+                            ReflectBCPacked<X2DIR, BCSide::Outer>);
+  RegisterBoundaryCondition(pin, app_input, BF::inner_x3, REFLECTING,
+                            ReflectBC<X3DIR, BCSide::Inner>,
+                            ReflectBCPacked<X3DIR, BCSide::Inner>);
+  RegisterBoundaryCondition(pin, app_input, BF::outer_x3, REFLECTING,
+                            ReflectBC<X3DIR, BCSide::Outer>,
+                            ReflectBCPacked<X3DIR, BCSide::Outer>);
 
   pman.ParthenonInitPackagesAndMesh();
 
@@ -157,6 +192,24 @@ int main(int argc, char *argv[]) {
     driver.Execute();
   }
 
+  // Host memory high-water mark (maximum across ranks), e.g., for performance tests
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  long max_rss_kb = usage.ru_maxrss / 1024; // in bytes on macOS
+#else
+  long max_rss_kb = usage.ru_maxrss;
+#endif
+#ifdef MPI_PARALLEL
+  const bool root = parthenon::Globals::my_rank == 0;
+  PARTHENON_MPI_CHECK(MPI_Reduce(root ? MPI_IN_PLACE : &max_rss_kb, &max_rss_kb, 1,
+                                 MPI_LONG, MPI_MAX, 0, MPI_COMM_WORLD));
+#endif
+  if (parthenon::Globals::my_rank == 0) {
+    std::cout << "memory high-water mark (max across ranks) = " << max_rss_kb / 1024.0
+              << " MiB" << std::endl;
+  }
+
   // call MPI_Finalize and Kokkos::finalize if necessary
   pman.ParthenonFinalize();
 
@@ -34,8 +34,9 @@ enum { IV1 = 1, IV2 = 2, IV3 = 3, IPR = 4 };
 
 enum class RiemannSolver { undefined, none, hlle, llf, hllc, hlld };
 enum class Reconstruction { undefined, dc, plm, ppm, wenoz, weno3, limo3 };
-enum class Integrator { undefined, rk1, rk2, vl2, rk3 };
+enum class Integrator { undefined, rk1, rk2, vl2, rk3, ssprk43, ssprk104 };
 enum class Fluid { undefined, euler, glmmhd };
+enum class EosType { adiabatic, tabulated };
 enum class Cooling { none, tabular };
 enum class Conduction { none, isotropic, anisotropic };
 enum class ConductionCoeff { none, fixed, spitzer };
@@ -43,7 +44,9 @@ enum class Viscosity { none, isotropic };
 enum class ViscosityCoeff { none, fixed };
 enum class Resistivity { none, ohmic };
 enum class ResistivityCoeff { none, fixed, spitzer };
-enum class DiffInt { none, unsplit, rkl2 };
+enum class DiffInt { none, unsplit, rkl2, rkl1, implicit };
+// Subsets of a block used to overlap the ghost cell exchange with computation
+enum class BlockRegion { all, rim, interior };
 
 enum class Hst { idx, ekin, emag, divb };
 
@@ -51,6 +54,18 @@ enum class CartesianDir { x, y, z };
 
 constexpr parthenon::Real float_min{std::numeric_limits<float>::min()};
 
+// Maximum number of pencils in the transverse direction processed by a single team in the
+// x2 and x3 flux kernels, see hydro/flux_tile_transverse
+constexpr int max_flux_tile_transverse{4};
+
+// Storage type of the reconstructed left/right states in the flux kernels' scratch pads.
+// All arithmetic (reconstruction, Riemann solvers) is still done in Real.
+#ifdef ATHENAPK_MIXED_PRECISION
+using ScratchReal = float;
+#else
+using ScratchReal = parthenon::Real;
+#endif
+
 using InitPackageDataFun_t =
     std::function<void(parthenon::ParameterInput *pin, parthenon::StateDescriptor *pkg)>;
 
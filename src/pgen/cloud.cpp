@@ -23,8 +23,11 @@
 #include <sstream>
 
 // AthenaPK headers
+#include "../bvals/boundary_conditions_apk.hpp"
 #include "../main.hpp"
+#include "../refinement/refinement.hpp"
 #include "../units.hpp"
+#include "cloud_frame.hpp"
 
 namespace cloud {
 using namespace parthenon::driver::prelude;
@@ -143,6 +146,14 @@ void InitUserMeshData(Mesh *mesh, ParameterInput *pin) {
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void ProblemInitPackageData(ParameterInput *pin, StateDescriptor *pkg)
+//  \brief Optionally follows the cloud (moving along x2) in a Galilean frame
+
+void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg) {
+  cloud_frame::Initialize(pin, pkg, "problem/cloud", X2DIR);
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void MeshBlock::ProblemGenerator(ParameterInput *pin)
 //  \brief Problem Generator for the cloud in wind setup
@@ -155,6 +166,7 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
 
   const auto nhydro = hydro_pkg->Param<int>("nhydro");
   const auto nscalars = hydro_pkg->Param<int>("nscalars");
+  const auto sparse_scalars = hydro_pkg->Param<bool>("sparse_scalars");
 
   const bool mhd_enabled = hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd;
   if (((Bx != 0.0) || (By != 0.0) || (Bz != 0.0)) && !mhd_enabled) {
@@ -205,7 +217,7 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
         }
 
         // Init passive scalars
-        for (auto n = nhydro; n < nhydro + nscalars; n++) {
+        for (auto n = nhydro; n < nhydro + (sparse_scalars ? 0 : nscalars); n++) {
           if (rad <= r_cloud) {
             u(n, k, j, i) = 1.0 * rho;
           }
@@ -216,6 +228,35 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
 
   // copy initialized vars to device
   u_dev.DeepCopy(u);
+
+  // Sparse scalars are only allocated (and set) on blocks overlapping the cloud
+  if (sparse_scalars) {
+    const auto &bs = pmb->block_size;
+    Real dist2 = 0.0;
+    for (const auto dir : {X1DIR, X2DIR, X3DIR}) {
+      dist2 += SQR(std::max({bs.xmin(dir), -bs.xmax(dir), Real(0.0)}));
+    }
+    if (dist2 > SQR(r_cloud)) {
+      return;
+    }
+    for (auto n = 0; n < nscalars; n++) {
+      pmb->AllocSparseID("scalar_density", n);
+      auto &s_dev = mbd->Get("scalar_density_" + std::to_string(n)).data;
+      auto s = s_dev.GetHostMirrorAndCopy();
+      for (int k = kb.s; k <= kb.e; k++) {
+        for (int j = jb.s; j <= jb.e; j++) {
+          for (int i = ib.s; i <= ib.e; i++) {
+            const Real rad = std::sqrt(SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j)) +
+                                       SQR(coords.Xc<3>(k)));
+            if (rad <= r_cloud) {
+              s(k, j, i) = 1.0 * u(IDN, k, j, i);
+            }
+          }
+        }
+      }
+      s_dev.DeepCopy(s);
+    }
+  }
 }
 
 void InflowWindX2(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse) {
@@ -224,7 +265,9 @@ void InflowWindX2(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse) {
   // TODO(pgrete) Add par_for_bndry to Parthenon without requiring nb
   const auto nb = IndexRange{0, 0};
   const auto rho_wind_ = rho_wind;
-  const auto mom_wind_ = mom_wind;
+  // Wind velocity in the frame following the cloud (if any)
+  const auto mom_wind_ =
+      mom_wind - rho_wind * cloud_frame::Velocity(pmb->packages.Get("Hydro").get());
   const auto rhoe_wind_ = rhoe_wind;
   const auto Bx_ = Bx;
   const auto By_ = By;
@@ -251,29 +294,58 @@ void InflowWindX2(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse) {
       });
 }
 
-parthenon::AmrTag ProblemCheckRefinementBlock(MeshBlockData<Real> *mbd) {
-  auto pmb = mbd->GetBlockPointer();
-  auto w = mbd->Get("prim").data;
+// Same as InflowWindX2 for all blocks of md at once
+void InflowWindX2Packed(MeshData<Real> *md, bool coarse) {
+  auto cons = md->PackVariables(std::vector<std::string>{"cons"}, coarse);
+  const auto rho_wind_ = rho_wind;
+  const auto mom_wind_ =
+      mom_wind - rho_wind * cloud_frame::Velocity(
+                                md->GetParentPointer()->packages.Get("Hydro").get());
+  const auto rhoe_wind_ = rhoe_wind;
+  const auto Bx_ = Bx;
+  const auto By_ = By;
+  const auto Bz_ = Bz;
+  using parthenon::BoundaryFunction::BCSide;
+  Hydro::BoundaryFunction::ParForPackedBndry<X2DIR, BCSide::Inner>(
+      "InflowWindX2Packed", md, cons, coarse,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        cons(b, IDN, k, j, i) = rho_wind_;
+        cons(b, IM2, k, j, i) = mom_wind_;
+        cons(b, IEN, k, j, i) = rhoe_wind_ + 0.5 * mom_wind_ * mom_wind_ / rho_wind_;
+        if (Bx_ != 0.0) {
+          cons(b, IB1, k, j, i) = Bx_;
+          cons(b, IEN, k, j, i) += 0.5 * Bx_ * Bx_;
+        }
+        if (By_ != 0.0) {
+          cons(b, IB2, k, j, i) = By_;
+          cons(b, IEN, k, j, i) += 0.5 * By_ * By_;
+        }
+        if (Bz_ != 0.0) {
+          cons(b, IB3, k, j, i) = Bz_;
+          cons(b, IEN, k, j, i) += 0.5 * Bz_ * Bz_;
+        }
+      });
+}
+
+void ProblemCheckRefinementMesh(MeshData<Real> *md,
+                                parthenon::ParArray1D<parthenon::AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const auto w =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("prim_names"));
 
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
 
-  auto hydro_pkg = pmb->packages.Get("Hydro");
   const auto nhydro = hydro_pkg->Param<int>("nhydro");
 
-  Real maxscalar = 0.0;
-  pmb->par_reduce(
-      "cloud refinement", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e + 1,
-      KOKKOS_LAMBDA(const int k, const int j, const int i, Real &lmaxscalar) {
-        // scalar is first variable after hydro vars
-        lmaxscalar = std::max(lmaxscalar, w(nhydro, k, j, i));
-      },
-      Kokkos::Max<Real>(maxscalar));
-
-  if (maxscalar > 0.01) return parthenon::AmrTag::refine;
-  if (maxscalar < 0.001) return parthenon::AmrTag::derefine;
-  return parthenon::AmrTag::same;
-};
+  refinement::TagBlocks(
+      "cloud refinement", md, amr_tags, kb, jb, {ib.s, ib.e + 1}, 0.01, 0.001,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        // scalar is first variable after hydro vars (and zero if not allocated)
+        return w.IsAllocated(b, nhydro) ? w(b, nhydro, k, j, i) : 0.0;
+      });
+}
 
 } // namespace cloud
@@ -0,0 +1,150 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file cloud_frame.cpp
+//  \brief Galilean frame following the cloud of the cloud and moving_cloud problems
+
+// C++ headers
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <kokkos_abstraction.hpp>
+#include <mesh/domain.hpp>
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <parthenon/package.hpp>
+#include <utils/error_checking.hpp>
+
+// AthenaPK headers
+#include "../main.hpp"
+#include "../utils/profiling.hpp"
+#include "cloud_frame.hpp"
+
+namespace cloud_frame {
+using namespace parthenon::package::prelude;
+
+void Initialize(ParameterInput *pin, StateDescriptor *hydro_pkg, const std::string &block,
+                const parthenon::CoordinateDirection dir, const Real velocity0) {
+  const auto enabled = pin->GetOrAddBoolean(block, "frame_tracking", false);
+  hydro_pkg->AddParam<>("cloud_frame/enabled", enabled);
+  if (!enabled) {
+    return;
+  }
+  PARTHENON_REQUIRE_THROWS(hydro_pkg->Param<int>("nscalars") >= 1,
+                           block + "/frame_tracking requires hydro/nscalars >= 1 (the "
+                                   "first passive scalar traces the cloud).");
+  hydro_pkg->AddParam<>("cloud_frame/dir", static_cast<int>(dir));
+  // Velocity and displacement (at the end of the current cycle) of the frame relative to
+  // the initial frame
+  hydro_pkg->AddParam<>("cloud_frame/velocity", velocity0, Params::Mutability::Restart);
+  hydro_pkg->AddParam<>("cloud_frame/offset", Real(0.0), Params::Mutability::Restart);
+
+  auto hst_vars = hydro_pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
+  // The same on all partitions and ranks
+  for (const std::string &name : {"velocity", "offset"}) {
+    hst_vars.emplace_back(parthenon::HistoryOutputVar(
+        parthenon::UserHistoryOperation::max,
+        [name](MeshData<Real> *md) {
+          auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+          return hydro_pkg->Param<Real>("cloud_frame/" + name);
+        },
+        "cloud_frame_" + name));
+  }
+  hydro_pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
+}
+
+bool IsEnabled(StateDescriptor *hydro_pkg) {
+  return hydro_pkg->Param<bool>("cloud_frame/enabled");
+}
+
+Real Velocity(StateDescriptor *hydro_pkg) {
+  return IsEnabled(hydro_pkg) ? hydro_pkg->Param<Real>("cloud_frame/velocity") : 0.0;
+}
+
+void Track(Mesh *pmesh, ParameterInput * /*pin*/, const SimTime &tm) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  if (!IsEnabled(hydro_pkg.get())) {
+    return;
+  }
+  utils::profiling::ScopedRegion region("cloud_frame::Track");
+  const auto nhydro = hydro_pkg->Param<int>("nhydro");
+  const auto &cons_names = hydro_pkg->Param<std::vector<std::string>>("cons_names");
+  const int dir = hydro_pkg->Param<int>("cloud_frame/dir");
+  const int im = IM1 + dir - 1;
+  const int iv = IV1 + dir - 1;
+
+  // Cloud mass and momentum along dir (the scalar is the cloud density) of all
+  // partitions, which are then summed over all ranks in a single reduction
+  Real sums[2] = {0.0, 0.0};
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    const auto cons = md->PackVariables(cons_names);
+    const auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+    const auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+    const auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+    Real mass = 0.0, mom = 0.0;
+    Kokkos::parallel_reduce(
+        "cloud_frame: cloud momentum",
+        Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+            {0, kb.s, jb.s, ib.s}, {cons.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+            {1, 1, 1, ib.e + 1 - ib.s}),
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lmass,
+                      Real &lmom) {
+          // Sparse scalars are only allocated on blocks (possibly) containing the cloud
+          if (!cons.IsAllocated(b, nhydro)) {
+            return;
+          }
+          const auto &coords = cons.GetCoords(b);
+          const Real cloud_mass = cons(b, nhydro, k, j, i) * coords.CellVolume(k, j, i);
+          lmass += cloud_mass;
+          lmom += cloud_mass * cons(b, im, k, j, i) / cons(b, IDN, k, j, i);
+        },
+        mass, mom);
+    sums[0] += mass;
+    sums[1] += mom;
+  }
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPI_PARTHENON_REAL, MPI_SUM,
+                                    MPI_COMM_WORLD));
+#endif // MPI_PARALLEL
+
+  // No cloud (material) left to follow
+  if (sums[0] <= 0.0) {
+    return;
+  }
+  const Real dv = sums[1] / sums[0];
+
+  // Galilean boost of all cells (incl. ghost zones so that they stay consistent with the
+  // interior and inflow boundaries) in the conserved and the primitive variables (which
+  // are used by the first stage)
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    const auto cons = md->PackVariables(std::vector<std::string>{"cons"});
+    const auto prim = md->PackVariables(std::vector<std::string>{"prim"});
+    const auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+    const auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+    const auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "cloud_frame: boost", parthenon::DevExecSpace(), 0,
+        cons.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          const Real rho = cons(b, IDN, k, j, i);
+          const Real mom = cons(b, im, k, j, i);
+          cons(b, IEN, k, j, i) += -dv * mom + 0.5 * rho * SQR(dv);
+          cons(b, im, k, j, i) = mom - rho * dv;
+          prim(b, iv, k, j, i) -= dv;
+        });
+  }
+
+  const auto velocity = hydro_pkg->Param<Real>("cloud_frame/velocity") + dv;
+  hydro_pkg->UpdateParam("cloud_frame/velocity", velocity);
+  hydro_pkg->UpdateParam("cloud_frame/offset",
+                         hydro_pkg->Param<Real>("cloud_frame/offset") + velocity * tm.dt);
+}
+
+} // namespace cloud_frame
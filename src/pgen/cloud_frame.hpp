@@ -0,0 +1,49 @@
+#ifndef PGEN_CLOUD_FRAME_HPP_
+#define PGEN_CLOUD_FRAME_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file cloud_frame.hpp
+//  \brief Galilean frame following the cloud of the cloud and moving_cloud problems
+//
+// At the beginning of every cycle, the bulk velocity of the cloud along the direction of
+// motion is measured (weighted by the cloud mass, i.e., the first passive scalar) and all
+// cells are boosted by this velocity so that the cloud stays at rest in the simulation
+// frame. The (accumulated) velocity and displacement of the frame relative to the
+// initial frame are stored in Params (and restart files) so that inflow boundaries can
+// be set in the frame and positions can be converted back to the initial frame.
+
+// C++ headers
+#include <string>
+
+// Parthenon headers
+#include <basic_types.hpp>
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <parthenon/package.hpp>
+
+namespace cloud_frame {
+using parthenon::Real;
+
+// Reads <block>/frame_tracking and adds the Params of the frame moving along dir with
+// initial velocity velocity0 (relative to the initial frame). To be called from the
+// ProblemInitPackageData of the problem generator.
+void Initialize(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg,
+                const std::string &block, const parthenon::CoordinateDirection dir,
+                const Real velocity0 = 0.0);
+
+bool IsEnabled(parthenon::StateDescriptor *hydro_pkg);
+
+// Velocity of the frame relative to the initial frame (zero without frame tracking)
+Real Velocity(parthenon::StateDescriptor *hydro_pkg);
+
+// Measures the cloud velocity and boosts all cells into the rest frame of the cloud
+// (used as Hydro::ProblemPreStepMeshUserWork)
+void Track(parthenon::Mesh *pmesh, parthenon::ParameterInput *pin,
+           const parthenon::SimTime &tm);
+
+} // namespace cloud_frame
+
+#endif // PGEN_CLOUD_FRAME_HPP_
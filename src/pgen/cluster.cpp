@@ -20,9 +20,11 @@
 #include <cstdio>    // fopen(), fprintf(), freopen()
 #include <iostream>  // endl
 #include <limits>
+#include <set>
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // c_str()
+#include <vector>
 
 // Parthenon headers
 #include "Kokkos_MathematicalFunctions.hpp"
@@ -42,6 +44,9 @@
 #include "../hydro/srcterms/tabular_cooling.hpp"
 #include "../main.hpp"
 #include "../utils/few_modes_ft.hpp"
+#include "../utils/global_reductions.hpp"
+#include "../utils/history.hpp"
+#include "../utils/profiling.hpp"
 
 // Cluster headers
 #include "cluster/agn_feedback.hpp"
@@ -52,6 +57,7 @@
 #include "cluster/entropy_profiles.hpp"
 #include "cluster/hydrostatic_equilibrium_sphere.hpp"
 #include "cluster/magnetic_tower.hpp"
+#include "cluster/radial_profiles.hpp"
 #include "cluster/snia_feedback.hpp"
 #include "cluster/stellar_feedback.hpp"
 
@@ -62,6 +68,7 @@ using utils::few_modes_ft::FewModesFT;
 
 void ClusterUnsplitSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
                            const Real beta_dt) {
+  utils::profiling::ScopedRegion region("Cluster::UnsplitSrcTerm");
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
   const bool &gravity_srcterm = hydro_pkg->Param<bool>("gravity_srcterm");
@@ -84,6 +91,7 @@ void ClusterUnsplitSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
 };
 void ClusterSplitSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
                          const Real dt) {
+  utils::profiling::ScopedRegion region("Cluster::SplitSrcTerm");
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
   const auto &stellar_feedback = hydro_pkg->Param<StellarFeedback>("stellar_feedback");
@@ -93,6 +101,7 @@ void ClusterSplitSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
 }
 
 Real ClusterEstimateTimestep(MeshData<Real> *md) {
+  utils::profiling::ScopedRegion region("Cluster::EstimateTimestep");
   Real min_dt = std::numeric_limits<Real>::max();
 
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
@@ -106,6 +115,33 @@ Real ClusterEstimateTimestep(MeshData<Real> *md) {
   return min_dt;
 }
 
+namespace {
+// Names of all variables written by any output (<parthenon/output*>/variables) or the
+// asynchronous snapshots (<snapshot>/variables)
+std::set<std::string> GetOutputVariables(ParameterInput *pin) {
+  std::set<std::string> variables;
+  for (auto *pib = pin->pfirst_block; pib != nullptr; pib = pib->pnext) {
+    if (pib->block_name.compare(0, 16, "parthenon/output") != 0 &&
+        pib->block_name != "snapshot") {
+      continue;
+    }
+    for (const std::string key : {"variables", "variable"}) {
+      if (!pin->DoesParameterExist(pib->block_name, key)) {
+        continue;
+      }
+      std::stringstream ss(pin->GetString(pib->block_name, key));
+      std::string var;
+      while (std::getline(ss, var, ',')) {
+        var.erase(0, var.find_first_not_of(" \t"));
+        var.erase(var.find_last_not_of(" \t") + 1);
+        variables.insert(var);
+      }
+    }
+  }
+  return variables;
+}
+} // namespace
+
 //========================================================================================
 //! \fn void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor
 //! *hydro_pkg) \brief Init package data from parameter input
@@ -113,6 +149,14 @@ Real ClusterEstimateTimestep(MeshData<Real> *md) {
 
 void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg) {
 
+  // The running totals in Params (e.g., stellar mass, clipped mass and energy, feedback),
+  // the AGN triggering state and its output are advanced in each step and not restored
+  // when a step is retried.
+  PARTHENON_REQUIRE_THROWS(!pin->GetOrAddBoolean("hydro", "step_retry", false),
+                           "hydro/step_retry is incompatible with the cluster problem "
+                           "generator as its accumulated quantities are not restored "
+                           "when retrying a step.");
+
   /************************************************************
    * Read Uniform Gas
    ************************************************************/
@@ -229,6 +273,14 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
        (agn_feedback.fixed_power_ != 0 ||
         agn_triggering.triggering_mode_ != AGNTriggeringMode::NONE));
   hydro_pkg->AddParam("magnetic_tower_power_scaling", magnetic_tower_power_scaling);
+  if (magnetic_tower_power_scaling) {
+    auto *reductions =
+        hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+    reductions->Register("cluster", "magnetic_tower_linear_contrib",
+                         utils::ReductionOp::sum);
+    reductions->Register("cluster", "magnetic_tower_quadratic_contrib",
+                         utils::ReductionOp::sum);
+  }
 
   /************************************************************
    * Read SNIA Feedback
@@ -242,6 +294,12 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
 
   StellarFeedback stellar_feedback(pin, hydro_pkg);
 
+  /************************************************************
+   * Read Radial Profiles
+   ************************************************************/
+
+  RadialProfiles radial_profiles(pin, hydro_pkg);
+
   /************************************************************
    * Read Clips  (ceilings and floors)
    ************************************************************/
@@ -276,6 +334,14 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
   hydro_pkg->AddParam("cluster_vAceil", vAceil);
   hydro_pkg->AddParam("cluster_clip_r", clip_r);
 
+  // Optionally apply the clips as part of the following conversion to primitive
+  // variables (i.e., over all cells including ghosts) instead of in a separate kernel
+  const bool fused_clips = pin->GetOrAddBoolean("problem/cluster/clips", "fused", false);
+  hydro_pkg->AddParam("cluster_fused_clips", fused_clips);
+  // MeshData whose clips are pending for the next conversion to primitive variables
+  hydro_pkg->AddParam("cluster_clips_pending", std::set<MeshData<Real> *>(),
+                      Params::Mutability::Mutable);
+
   /************************************************************
    * Start running reductions into history outputs for clips, stellar mass, cold
    * gas, and AGN extent
@@ -315,10 +381,18 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
   // Add history reduction for total cold gas using stellar mass threshold
   const Real cold_thresh =
       pin->GetOrAddReal("problem/cluster/reductions", "cold_temp_thresh", 0.0);
+  const bool fused_hst = hydro_pkg->Param<bool>("fused_hst");
+  std::vector<std::string> fused_hst_names;
+  std::vector<parthenon::UserHistoryOperation> fused_hst_ops;
   if (cold_thresh > 0) {
     hydro_pkg->AddParam("reduction_cold_threshold", cold_thresh);
-    hst_vars.emplace_back(parthenon::HistoryOutputVar(
-        parthenon::UserHistoryOperation::sum, LocalReduceColdGas, "cold_mass"));
+    if (fused_hst) {
+      fused_hst_names.emplace_back("cold_mass");
+      fused_hst_ops.emplace_back(parthenon::UserHistoryOperation::sum);
+    } else {
+      hst_vars.emplace_back(parthenon::HistoryOutputVar(
+          parthenon::UserHistoryOperation::sum, LocalReduceColdGas, "cold_mass"));
+    }
   }
   const Real agn_tracer_thresh =
       pin->GetOrAddReal("problem/cluster/reductions", "agn_tracer_thresh", -1.0);
@@ -327,48 +401,55 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
         pin->GetOrAddBoolean("problem/cluster/agn_feedback", "enable_tracer", false),
         "AGN Tracer must be enabled to reduce AGN tracer extent");
     hydro_pkg->AddParam("reduction_agn_tracer_threshold", agn_tracer_thresh);
-    hst_vars.emplace_back(parthenon::HistoryOutputVar(
-        parthenon::UserHistoryOperation::max, LocalReduceAGNExtent, "agn_extent"));
+    if (fused_hst) {
+      fused_hst_names.emplace_back("agn_extent");
+      fused_hst_ops.emplace_back(parthenon::UserHistoryOperation::max);
+    } else {
+      hst_vars.emplace_back(parthenon::HistoryOutputVar(
+          parthenon::UserHistoryOperation::max, LocalReduceAGNExtent, "agn_extent"));
+    }
+  }
+  // Cold gas and AGN extent in a single pass over the data, see cluster_reductions.hpp
+  if (!fused_hst_names.empty()) {
+    utils::history::FusedSums::AddHistoryVars(hst_vars, fused_hst_names, fused_hst_ops,
+                                              LocalReduceClusterHst);
   }
 
   hydro_pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
 
   /************************************************************
    * Add derived fields
-   * NOTE: these must be filled in UserWorkBeforeOutput
+   * NOTE: these are only added if requested by any output and filled in
+   * UserMeshWorkBeforeOutput
    ************************************************************/
 
-  auto m = Metadata({Metadata::Cell, Metadata::OneCopy}, std::vector<int>({1}));
-
-  // log10 of cell-centered radius
-  hydro_pkg->AddField("log10_cell_radius", m);
-  // entropy
-  hydro_pkg->AddField("entropy", m);
-  // sonic Mach number v/c_s
-  hydro_pkg->AddField("mach_sonic", m);
-  // temperature
-  hydro_pkg->AddField("temperature", m);
-  // radial velocity
-  hydro_pkg->AddField("v_r", m);
-
-  // spherical theta
-  hydro_pkg->AddField("theta_sph", m);
-
+  std::vector<std::string> derived_fields = {
+      "log10_cell_radius", // log10 of cell-centered radius
+      "entropy",           // entropy
+      "mach_sonic",        // sonic Mach number v/c_s
+      "temperature",       // temperature
+      "v_r",               // radial velocity
+      "theta_sph",         // spherical theta
+  };
   if (hydro_pkg->Param<Cooling>("enable_cooling") == Cooling::tabular) {
-    // cooling time
-    hydro_pkg->AddField("cooling_time", m);
+    derived_fields.emplace_back("cooling_time");
   }
-
   if (hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd) {
-    // alfven Mach number v_A/c_s
-    hydro_pkg->AddField("mach_alfven", m);
-
-    // plasma beta
-    hydro_pkg->AddField("plasma_beta", m);
+    derived_fields.emplace_back("mach_alfven"); // alfven Mach number v_A/c_s
+    derived_fields.emplace_back("plasma_beta");
+    derived_fields.emplace_back("B_mag"); // magnetic field strength
+  }
 
-    // plasma beta
-    hydro_pkg->AddField("B_mag", m);
+  const auto output_variables = GetOutputVariables(pin);
+  std::vector<std::string> requested_derived_fields;
+  auto m = Metadata({Metadata::Cell, Metadata::OneCopy}, std::vector<int>({1}));
+  for (const auto &field : derived_fields) {
+    if (output_variables.count(field) > 0) {
+      hydro_pkg->AddField(field, m);
+      requested_derived_fields.push_back(field);
+    }
   }
+  hydro_pkg->AddParam("cluster_derived_fields", requested_derived_fields);
 
   /************************************************************
    * Add infrastructure for initial pertubations
@@ -470,6 +551,16 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
   // This could be more optimized, but require a refactor of init routines being called.
   // However, given that it's just called during initial setup, this should not be a
   // performance concern.
+  {
+    auto hydro_pkg = pmesh->packages.Get("Hydro");
+    if (!hydro_pkg->Param<bool>("init_uniform_gas")) {
+      // Integrate the (optionally) shared hydrostatic profiles once (collectively)
+      hydro_pkg
+          ->Param<HydrostaticEquilibriumSphere<ClusterGravity, ACCEPTEntropyProfile>>(
+              "hydrostatic_equilibirum_sphere")
+          .prepare_shared_profiles(md);
+    }
+  }
   for (int b = 0; b < md->NumBlocks(); b++) {
     auto pmb = md->GetBlockData(b)->GetBlockPointer();
     auto hydro_pkg = pmb->packages.Get("Hydro");
@@ -528,7 +619,7 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
 
       // initialize conserved variables
       parthenon::par_for(
-          DEFAULT_LOOP_PATTERN, "cluster::ProblemGenerator::UniformGas",
+          DEFAULT_LOOP_PATTERN, "Cluster::ProblemGenerator::HydrostaticEquilibriumSphere",
           parthenon::DevExecSpace(), kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
           KOKKOS_LAMBDA(const int &k, const int &j, const int &i) {
             // Calculate radius
@@ -583,7 +674,7 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
         const Real my = hydro_pkg->Param<Real>("dipole_b_field_my");
         const Real mz = hydro_pkg->Param<Real>("dipole_b_field_mz");
         parthenon::par_for(
-            DEFAULT_LOOP_PATTERN, "MagneticTower::AddInitialFieldToPotential",
+            DEFAULT_LOOP_PATTERN, "Cluster::MagneticTower::AddInitialFieldToPotential",
             parthenon::DevExecSpace(), a_kb.s, a_kb.e, a_jb.s, a_jb.e, a_ib.s, a_ib.e,
             KOKKOS_LAMBDA(const int &k, const int &j, const int &i) {
               // Compute and apply potential
@@ -607,7 +698,7 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
        * Apply the potential to the conserved variables
        ************************************************************/
       parthenon::par_for(
-          DEFAULT_LOOP_PATTERN, "cluster::ProblemGenerator::ApplyMagneticPotential",
+          DEFAULT_LOOP_PATTERN, "Cluster::ProblemGenerator::ApplyMagneticPotential",
           parthenon::DevExecSpace(), kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
           KOKKOS_LAMBDA(const int &k, const int &j, const int &i) {
             u(IB1, k, j, i) =
@@ -633,7 +724,7 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
         const Real by = hydro_pkg->Param<Real>("uniform_b_field_by");
         const Real bz = hydro_pkg->Param<Real>("uniform_b_field_bz");
         parthenon::par_for(
-            DEFAULT_LOOP_PATTERN, "cluster::ProblemGenerator::ApplyUniformBField",
+            DEFAULT_LOOP_PATTERN, "Cluster::ProblemGenerator::ApplyUniformBField",
             parthenon::DevExecSpace(), kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
             KOKKOS_LAMBDA(const int &k, const int &j, const int &i) {
               const Real bx_i = u(IB1, k, j, i);
@@ -688,7 +779,8 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
     auto perturb_pack = md->PackVariables(std::vector<std::string>{"tmp_perturb"});
 
     pmb->par_reduce(
-        "Init sigma_v", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        "Cluster::ProblemGenerator::InitSigmaV", 0, num_blocks - 1, kb.s, kb.e, jb.s,
+        jb.e, ib.s, ib.e,
         KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
           const auto &coords = cons.GetCoords(b);
           const auto &u = cons(b);
@@ -720,7 +812,8 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
     auto v_norm = std::sqrt(v2_sum / (Lx * Ly * Lz) / (SQR(sigma_v)));
 
     pmb->par_for(
-        "Norm sigma_v", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        "Cluster::ProblemGenerator::NormSigmaV", 0, num_blocks - 1, kb.s, kb.e, jb.s,
+        jb.e, ib.s, ib.e,
         KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
           const auto &u = cons(b);
 
@@ -756,7 +849,8 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
     auto perturb_pack = md->PackVariables(std::vector<std::string>{"tmp_perturb"});
 
     pmb->par_reduce(
-        "Init sigma_b", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        "Cluster::ProblemGenerator::InitSigmaB", 0, num_blocks - 1, kb.s, kb.e, jb.s,
+        jb.e, ib.s, ib.e,
         KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
           const auto &coords = cons.GetCoords(b);
           const auto &u = cons(b);
@@ -798,7 +892,8 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
     auto b_norm = std::sqrt(b2_sum / (Lx * Ly * Lz) / (SQR(sigma_b)));
 
     pmb->par_for(
-        "Norm sigma_b", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        "Cluster::ProblemGenerator::NormSigmaB", 0, num_blocks - 1, kb.s, kb.e, jb.s,
+        jb.e, ib.s, ib.e,
         KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
           const auto &u = cons(b);
 
@@ -812,116 +907,138 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
   }
 }
 
-void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin,
-                          const parthenon::SimTime & /*tm*/) {
-  // get hydro
-  auto pkg = pmb->packages.Get("Hydro");
+// Used as InitMeshBlockUserData so that the static injection weights are (re)computed
+// whenever blocks are created (incl. remeshing and restarts)
+void InitMeshBlockUserData(MeshBlock *pmb, ParameterInput * /*pin*/) {
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  hydro_pkg->Param<SNIAFeedback>("snia_feedback").InitBCGDensity(pmb);
+}
+
+// Fills the derived output fields that are requested by any output (see
+// ProblemInitPackageData) in a single kernel per partition (*including ghost cells*)
+void UserMeshWorkBeforeOutput(Mesh *pmesh, ParameterInput *pin,
+                              const parthenon::SimTime & /*tm*/) {
+  utils::profiling::ScopedRegion region("Cluster::UserMeshWorkBeforeOutput");
+  auto pkg = pmesh->packages.Get("Hydro");
+  const auto &derived_fields =
+      pkg->Param<std::vector<std::string>>("cluster_derived_fields");
+  if (derived_fields.empty()) {
+    return;
+  }
   const Real gam = pin->GetReal("hydro", "gamma");
   const Real gm1 = (gam - 1.0);
 
-  // get prim vars
-  auto &data = pmb->meshblock_data.Get();
-  auto const &prim = data->Get("prim").data;
-
-  // get derived fields
-  auto &log10_radius = data->Get("log10_cell_radius").data;
-  auto &entropy = data->Get("entropy").data;
-  auto &mach_sonic = data->Get("mach_sonic").data;
-  auto &temperature = data->Get("temperature").data;
-  auto &v_r = data->Get("v_r").data;
-  auto &theta_sph = data->Get("theta_sph").data;
-
   // for computing temperature from primitives
   auto units = pkg->Param<Units>("units");
   auto mbar_over_kb = pkg->Param<Real>("mbar_over_kb");
   auto mbar = mbar_over_kb * units.k_boltzmann();
 
-  // fill derived vars (*including ghost cells*)
-  auto &coords = pmb->coords;
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::entire);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::entire);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::entire);
-
-  pmb->par_for(
-      "Cluster::UserWorkBeforeOutput", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int k, const int j, const int i) {
-        // get gas properties
-        const Real rho = prim(IDN, k, j, i);
-        const Real v1 = prim(IV1, k, j, i);
-        const Real v2 = prim(IV2, k, j, i);
-        const Real v3 = prim(IV3, k, j, i);
-        const Real P = prim(IPR, k, j, i);
-
-        // compute radius
-        const Real x = coords.Xc<1>(i);
-        const Real y = coords.Xc<2>(j);
-        const Real z = coords.Xc<3>(k);
-        const Real r = std::sqrt(SQR(x) + SQR(y) + SQR(z));
-        log10_radius(k, j, i) = std::log10(r);
-
-        v_r(k, j, i) = ((v1 * x) + (v2 * y) + (v3 * z)) / r;
-
-        theta_sph(k, j, i) = std::acos(z / r);
-
-        // compute entropy
-        const Real K = P / std::pow(rho / mbar, gam);
-        entropy(k, j, i) = K;
-
-        const Real v_mag = std::sqrt(SQR(v1) + SQR(v2) + SQR(v3));
-        const Real c_s = std::sqrt(gam * P / rho); // ideal gas EOS
-        const Real M_s = v_mag / c_s;
-        mach_sonic(k, j, i) = M_s;
-
-        // compute temperature
-        temperature(k, j, i) = mbar_over_kb * P / rho;
-      });
-  if (pkg->Param<Cooling>("enable_cooling") == Cooling::tabular) {
-    auto &cooling_time = data->Get("cooling_time").data;
-
-    // get cooling function
-    const cooling::TabularCooling &tabular_cooling =
-        pkg->Param<cooling::TabularCooling>("tabular_cooling");
-    const auto cooling_table_obj = tabular_cooling.GetCoolingTableObj();
-
-    pmb->par_for(
-        "Cluster::UserWorkBeforeOutput::CoolingTime", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA(const int k, const int j, const int i) {
-          // get gas properties
-          const Real rho = prim(IDN, k, j, i);
-          const Real P = prim(IPR, k, j, i);
-
-          // compute cooling time
-          const Real eint = P / (rho * gm1);
-          const Real edot = cooling_table_obj.DeDt(eint, rho);
-          cooling_time(k, j, i) = (edot != 0) ? -eint / edot : NAN;
-        });
+  const bool cooling_time_requested =
+      std::find(derived_fields.begin(), derived_fields.end(), "cooling_time") !=
+      derived_fields.end();
+  // Only the table of the tabular cooling is captured (the param does not exist
+  // otherwise)
+  cooling::CoolingTableObj cooling_table_obj;
+  if (cooling_time_requested) {
+    cooling_table_obj =
+        pkg->Param<cooling::TabularCooling>("tabular_cooling").GetCoolingTableObj();
   }
 
-  if (pkg->Param<Fluid>("fluid") == Fluid::glmmhd) {
-    auto &plasma_beta = data->Get("plasma_beta").data;
-    auto &mach_alfven = data->Get("mach_alfven").data;
-    auto &b_mag = data->Get("B_mag").data;
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int n = 0; n < num_partitions; n++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", n);
+    const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+    parthenon::PackIndexMap imap;
+    const auto &derived_pack = md->PackVariables(derived_fields, imap);
+    // Index of each derived field in the pack (or -1 if not requested)
+    const auto index = [&imap](const std::string &name) { return imap[name].first; };
+    const int ilog10_radius = index("log10_cell_radius");
+    const int ientropy = index("entropy");
+    const int imach_sonic = index("mach_sonic");
+    const int itemperature = index("temperature");
+    const int iv_r = index("v_r");
+    const int itheta_sph = index("theta_sph");
+    const int icooling_time = index("cooling_time");
+    const int imach_alfven = index("mach_alfven");
+    const int iplasma_beta = index("plasma_beta");
+    const int ib_mag = index("B_mag");
+
+    IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+    IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+    IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "Cluster::UserMeshWorkBeforeOutput", DevExecSpace(), 0,
+        prim_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          const auto &prim = prim_pack(b);
+          auto &derived = derived_pack(b);
+          const auto &coords = prim_pack.GetCoords(b);
 
-    pmb->par_for(
-        "Cluster::UserWorkBeforeOutput::MHD", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA(const int k, const int j, const int i) {
           // get gas properties
           const Real rho = prim(IDN, k, j, i);
+          const Real v1 = prim(IV1, k, j, i);
+          const Real v2 = prim(IV2, k, j, i);
+          const Real v3 = prim(IV3, k, j, i);
           const Real P = prim(IPR, k, j, i);
-          const Real Bx = prim(IB1, k, j, i);
-          const Real By = prim(IB2, k, j, i);
-          const Real Bz = prim(IB3, k, j, i);
-          const Real B2 = (SQR(Bx) + SQR(By) + SQR(Bz));
 
-          b_mag(k, j, i) = Kokkos::sqrt(B2);
-
-          // compute Alfven mach number
-          const Real v_A = std::sqrt(B2 / rho);
+          // compute radius
+          const Real x = coords.Xc<1>(i);
+          const Real y = coords.Xc<2>(j);
+          const Real z = coords.Xc<3>(k);
+          const Real r = std::sqrt(SQR(x) + SQR(y) + SQR(z));
+          if (ilog10_radius >= 0) {
+            derived(ilog10_radius, k, j, i) = std::log10(r);
+          }
+          if (iv_r >= 0) {
+            derived(iv_r, k, j, i) = ((v1 * x) + (v2 * y) + (v3 * z)) / r;
+          }
+          if (itheta_sph >= 0) {
+            derived(itheta_sph, k, j, i) = std::acos(z / r);
+          }
+
+          // compute entropy
+          if (ientropy >= 0) {
+            derived(ientropy, k, j, i) = P / std::pow(rho / mbar, gam);
+          }
+
+          const Real v_mag = std::sqrt(SQR(v1) + SQR(v2) + SQR(v3));
           const Real c_s = std::sqrt(gam * P / rho); // ideal gas EOS
-          mach_alfven(k, j, i) = mach_sonic(k, j, i) * c_s / v_A;
+          if (imach_sonic >= 0) {
+            derived(imach_sonic, k, j, i) = v_mag / c_s;
+          }
+
+          // compute temperature
+          if (itemperature >= 0) {
+            derived(itemperature, k, j, i) = mbar_over_kb * P / rho;
+          }
 
-          // compute plasma beta
-          plasma_beta(k, j, i) = (B2 != 0) ? P / (0.5 * B2) : NAN;
+          // compute cooling time
+          if (icooling_time >= 0) {
+            const Real eint = P / (rho * gm1);
+            const Real edot = cooling_table_obj.DeDt(eint, rho);
+            derived(icooling_time, k, j, i) = (edot != 0) ? -eint / edot : NAN;
+          }
+
+          if (imach_alfven >= 0 || iplasma_beta >= 0 || ib_mag >= 0) {
+            const Real Bx = prim(IB1, k, j, i);
+            const Real By = prim(IB2, k, j, i);
+            const Real Bz = prim(IB3, k, j, i);
+            const Real B2 = (SQR(Bx) + SQR(By) + SQR(Bz));
+
+            if (ib_mag >= 0) {
+              derived(ib_mag, k, j, i) = Kokkos::sqrt(B2);
+            }
+            // compute Alfven mach number
+            if (imach_alfven >= 0) {
+              const Real v_A = std::sqrt(B2 / rho);
+              derived(imach_alfven, k, j, i) = v_mag / v_A;
+            }
+            // compute plasma beta
+            if (iplasma_beta >= 0) {
+              derived(iplasma_beta, k, j, i) = (B2 != 0) ? P / (0.5 * B2) : NAN;
+            }
+          }
         });
   }
 }
@@ -55,7 +55,9 @@ AGNFeedback::AGNFeedback(parthenon::ParameterInput *pin,
           pin->GetOrAddBoolean("problem/cluster/agn_feedback", "enable_tracer", false)),
       disabled_(pin->GetOrAddBoolean("problem/cluster/agn_feedback", "disabled", false)),
       enable_magnetic_tower_mass_injection_(pin->GetOrAddBoolean(
-          "problem/cluster/agn_feedback", "enable_magnetic_tower_mass_injection", true)) {
+          "problem/cluster/agn_feedback", "enable_magnetic_tower_mass_injection", true)),
+      cull_blocks_(
+          pin->GetOrAddBoolean("problem/cluster/agn_feedback", "cull_blocks", false)) {
 
   // Normalize the thermal, kinetic, and magnetic fractions to sum to 1.0
   const Real total_frac = thermal_fraction_ + kinetic_fraction_ + magnetic_fraction_;
@@ -248,9 +250,31 @@ void AGNFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
                     "AGNFeedback::FeedbackSrcTerm Magnetic, Thermal, and Kinetic "
                     "fractions are all zero");
 
+  const auto &jet_coords_factory =
+      hydro_pkg->Param<JetCoordsFactory>("jet_coords_factory");
+  const JetCoords jet_coords = jet_coords_factory.CreateJetCoords(tm.time);
+
+  // A sparse tracer has to be allocated on all blocks covering the jet launching region
+  // (before packing) as it is only allocated automatically next to blocks where it is
+  // above the threshold.
+  if (enable_tracer_ && kinetic_mass_fraction_ > 0 &&
+      hydro_pkg->Param<bool>("sparse_scalars")) {
+    for (int b = 0; b < md->NumBlocks(); b++) {
+      auto *pmb = md->GetBlockData(b)->GetBlockPointer();
+      if (!md->GetBlockData(b)->IsAllocated("scalar_density_0") &&
+          InjectionBlocks::BoundingSphere(pmb, jet_coords)
+              .IntersectsJet(kinetic_jet_radius_, kinetic_jet_offset_,
+                             kinetic_jet_thickness_)) {
+        pmb->AllocSparseID("scalar_density", 0);
+      }
+    }
+  }
+
   // Grab some necessary variables
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  const auto &prim_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("prim_names"));
+  const auto &cons_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("cons_names"));
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
@@ -304,17 +328,28 @@ void AGNFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
   const auto enable_tracer = enable_tracer_;
   ////////////////////////////////////////////////////////////////////////////////
 
-  const parthenon::Real time = tm.time;
-
-  const auto &jet_coords_factory =
-      hydro_pkg->Param<JetCoordsFactory>("jet_coords_factory");
-  const JetCoords jet_coords = jet_coords_factory.CreateJetCoords(time);
+  // The velocity and temperature ceilings apply to all cells (so the kernel is only
+  // restricted to the blocks intersecting the injection regions without ceilings). The
+  // regions only depend on the (fixed) fractions so that the cached blocks stay valid.
+  const bool thermal = thermal_fraction_ > 0 || thermal_mass_fraction_ > 0;
+  const bool kinetic = kinetic_fraction_ > 0 || kinetic_mass_fraction_ > 0;
+  const bool ceilings = kinetic && (std::isfinite(vceil) || std::isfinite(eceil));
+  const auto blocks = injection_blocks_.Get(
+      md, "agn_feedback", jet_coords, cull_blocks_ && !ceilings,
+      [&](const BlockBoundingSphere &sphere) {
+        return (thermal && sphere.IntersectsSphere(thermal_radius_)) ||
+               (kinetic && sphere.IntersectsJet(kinetic_jet_radius, kinetic_jet_offset,
+                                                kinetic_jet_thickness));
+      });
+  const auto block_idx = blocks.first;
+  const int nblocks = blocks.second;
 
   // Appy kinietic jet and thermal feedback
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "HydroAGNFeedback::FeedbackSrcTerm",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+      DEFAULT_LOOP_PATTERN, "Cluster::AGNFeedback::FeedbackSrcTerm",
+      parthenon::DevExecSpace(), 0, nblocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i) {
+        const int b = block_idx(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -371,7 +406,7 @@ void AGNFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
             // we cannot distinguish between original material in a cell and new jet
             // material in the evolution of the jet. Eventually, we're just interested in
             // stuff that came from here.
-            if (enable_tracer) {
+            if (enable_tracer && cons.IsAllocated(nhydro)) {
               cons(nhydro, k, j, i) = 1.0 * cons(IDN, k, j, i);
             }
 
@@ -16,6 +16,7 @@
 #include <parameter_input.hpp>
 #include <parthenon/package.hpp>
 
+#include "injection_blocks.hpp"
 #include "jet_coords.hpp"
 
 namespace cluster {
@@ -49,6 +50,10 @@ class AGNFeedback {
 
   const bool enable_magnetic_tower_mass_injection_;
 
+  // Only launch the kernels over blocks intersecting the injection regions
+  const bool cull_blocks_;
+  InjectionBlocks injection_blocks_;
+
   AGNFeedback(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg);
 
   parthenon::Real GetFeedbackPower(parthenon::StateDescriptor *hydro_pkg) const;
@@ -9,6 +9,8 @@
 #include <cmath>
 #include <fstream> // for ofstream
 #include <limits>
+#include <string>
+#include <vector>
 
 // Parthenon headers
 #include <coordinates/uniform_cartesian.hpp>
@@ -24,6 +26,9 @@
 #include "../../eos/adiabatic_hydro.hpp"
 #include "../../main.hpp"
 #include "../../units.hpp"
+#include "../../utils/global_reductions.hpp"
+#include "../../utils/profiling.hpp"
+#include "../../utils/shared_params.hpp"
 #include "agn_feedback.hpp"
 #include "agn_triggering.hpp"
 #include "cluster_utils.hpp"
@@ -50,6 +55,26 @@ AGNTriggeringMode ParseAGNTriggeringMode(const std::string &mode_str) {
   return AGNTriggeringMode::NONE;
 }
 
+namespace {
+// Quantities that are globally reduced for the given triggering mode
+std::vector<std::string> GetReducedQuantities(const AGNTriggeringMode mode) {
+  switch (mode) {
+  case AGNTriggeringMode::COLD_GAS: {
+    return {"agn_triggering_cold_mass"};
+  }
+  case AGNTriggeringMode::BOOSTED_BONDI:
+  case AGNTriggeringMode::BOOTH_SCHAYE: {
+    return {"agn_triggering_total_mass", "agn_triggering_mass_weighted_density",
+            "agn_triggering_mass_weighted_velocity", "agn_triggering_mass_weighted_cs"};
+  }
+  case AGNTriggeringMode::NONE: {
+    break;
+  }
+  }
+  return {};
+}
+} // namespace
+
 AGNTriggering::AGNTriggering(parthenon::ParameterInput *pin,
                              parthenon::StateDescriptor *hydro_pkg,
                              const std::string &block)
@@ -76,6 +101,7 @@ AGNTriggering::AGNTriggering(parthenon::ParameterInput *pin,
       1 / (He_mass_fraction * 3. / 4. + (1 - He_mass_fraction) * 2);
 
   mean_molecular_mass_ = mu * units.atomic_mass_unit();
+  mean_molecular_mass_by_kb_ = mean_molecular_mass_ / units.k_boltzmann();
 
   if (triggering_mode_ == AGNTriggeringMode::NONE) {
     hydro_pkg->AddParam<bool>("agn_triggering_reduce_accretion_rate", false);
@@ -104,6 +130,14 @@ AGNTriggering::AGNTriggering(parthenon::ParameterInput *pin,
   }
   }
 
+  // Triggering quantities are reduced together with other modules (e.g., the magnetic
+  // tower power scaling) at the beginning of each cycle.
+  auto *reductions =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+  for (const auto &name : GetReducedQuantities(triggering_mode_)) {
+    reductions->Register("cluster", name, utils::ReductionOp::sum);
+  }
+
   // Set up writing the triggering to file, used for debugging and regression
   // testing. Note that this is written every timestep, which is more
   // frequently than history outputs. It is also not reduced across ranks and
@@ -118,149 +152,36 @@ AGNTriggering::AGNTriggering(parthenon::ParameterInput *pin,
   hydro_pkg->AddParam<AGNTriggering>("agn_triggering", *this);
 }
 
-// Compute Cold gas accretion rate within the accretion radius for cold gas triggering
-// and simultaneously remove cold gas (updating conserveds and primitives)
-template <typename EOS>
-void AGNTriggering::ReduceColdMass(parthenon::Real &cold_mass,
-                                   parthenon::MeshData<parthenon::Real> *md,
-                                   const parthenon::Real dt, const EOS eos) const {
-  using parthenon::IndexDomain;
-  using parthenon::IndexRange;
-  using parthenon::Real;
-
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-
-  // Grab some necessary variables
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
-  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
-  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
-  IndexRange int_ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-  IndexRange int_jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-  IndexRange int_kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
-  const auto nhydro = hydro_pkg->Param<int>("nhydro");
-  const auto nscalars = hydro_pkg->Param<int>("nscalars");
-
-  const Real accretion_radius2 = pow(accretion_radius_, 2);
-
-  // Reduce just the cold gas
-  const auto units = hydro_pkg->Param<Units>("units");
-  const Real mean_molecular_mass_by_kb = mean_molecular_mass_ / units.k_boltzmann();
-
-  const Real cold_temp_thresh = cold_temp_thresh_;
-  const Real cold_t_acc = cold_t_acc_;
-
-  const bool remove_accreted_mass = remove_accreted_mass_;
-
-  Real md_cold_mass = 0;
-
-  parthenon::par_reduce(
-      parthenon::loop_pattern_mdrange_tag, "AGNTriggering::ReduceColdGas",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e,
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
-                    Real &team_cold_mass) {
-        auto &cons = cons_pack(b);
-        auto &prim = prim_pack(b);
-        const auto &coords = cons_pack.GetCoords(b);
-
-        const parthenon::Real r2 =
-            pow(coords.Xc<1>(i), 2) + pow(coords.Xc<2>(j), 2) + pow(coords.Xc<3>(k), 2);
-        if (r2 < accretion_radius2) {
-
-          const Real temp =
-              mean_molecular_mass_by_kb * prim(IPR, k, j, i) / prim(IDN, k, j, i);
-
-          if (temp <= cold_temp_thresh) {
-
-            const Real cell_cold_mass = prim(IDN, k, j, i) * coords.CellVolume(k, j, i);
-
-            if (k >= int_kb.s && k <= int_kb.e && j >= int_jb.s && j <= int_jb.e &&
-                i >= int_ib.s && i <= int_ib.e) {
-              // Only reduce the cold gas that exists on the interior grid
-              team_cold_mass += cell_cold_mass;
-            }
-
-            const Real cell_delta_rho = -prim(IDN, k, j, i) / cold_t_acc * dt;
-
-            if (remove_accreted_mass) {
-              AddDensityToConsAtFixedVelTemp(cell_delta_rho, cons, prim, eos.GetGamma(),
-                                             k, j, i);
-              // Update the Primitives
-              eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
-            }
-          }
-        }
-      },
-      Kokkos::Sum<Real>(md_cold_mass));
-  cold_mass += md_cold_mass;
-}
-
-// Compute Mass-weighted total density, velocity, and sound speed and total mass
-// for Bondi accretion
-void AGNTriggering::ReduceBondiTriggeringQuantities(
-    parthenon::Real &total_mass, parthenon::Real &mass_weighted_density,
-    parthenon::Real &mass_weighted_velocity, parthenon::Real &mass_weighted_cs,
-    parthenon::MeshData<parthenon::Real> *md) const {
-  using parthenon::IndexDomain;
-  using parthenon::IndexRange;
-  using parthenon::Real;
-
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-
-  // Grab some necessary variables
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
-
-  const Real accretion_radius2 = pow(accretion_radius_, 2);
-
-  // Reduce Mass-weighted total density, velocity, and sound speed and total
-  // mass (in that order). Will need to divide the three latter quantities by
-  // total mass in order to get their mass-weighted averaged values
-  Real total_mass_red, mass_weighted_density_red, mass_weighted_velocity_red,
-      mass_weighted_cs_red;
-
-  const parthenon::Real gamma = gamma_;
-
-  Kokkos::parallel_reduce(
-      "AGNTriggering::ReduceBondi",
-      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-          DevExecSpace(), {0, kb.s, jb.s, ib.s},
-          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-          {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
-                    Real &ltotal_mass_red, Real &lmass_weighted_density_red,
-                    Real &lmass_weighted_velocity_red, Real &lmass_weighted_cs_red) {
-        auto &prim = prim_pack(b);
-        const auto &coords = prim_pack.GetCoords(b);
-        const parthenon::Real r2 =
-            pow(coords.Xc<1>(i), 2) + pow(coords.Xc<2>(j), 2) + pow(coords.Xc<3>(k), 2);
-        if (r2 < accretion_radius2) {
-          const Real cell_mass = prim(IDN, k, j, i) * coords.CellVolume(k, j, i);
-
-          const Real cell_mass_weighted_density = cell_mass * prim(IDN, k, j, i);
-          const Real cell_mass_weighted_velocity =
-              cell_mass * sqrt(pow(prim(IV1, k, j, i), 2) + pow(prim(IV2, k, j, i), 2) +
-                               pow(prim(IV3, k, j, i), 2));
-          const Real cell_mass_weighted_cs =
-              cell_mass * sqrt(gamma * prim(IPR, k, j, i) / prim(IDN, k, j, i));
-
-          ltotal_mass_red += cell_mass;
-          lmass_weighted_density_red += cell_mass_weighted_density;
-          lmass_weighted_velocity_red += cell_mass_weighted_velocity;
-          lmass_weighted_cs_red += cell_mass_weighted_cs;
-        }
-      },
-      total_mass_red, mass_weighted_density_red, mass_weighted_velocity_red,
-      mass_weighted_cs_red);
-  // Save the reduction results to triggering_quantities
-  total_mass += total_mass_red;
-  mass_weighted_density += mass_weighted_density_red;
-  mass_weighted_velocity += mass_weighted_velocity_red;
-  mass_weighted_cs += mass_weighted_cs_red;
+ClusterReductionRequest
+AGNTriggering::GetReductionRequest(const parthenon::Real dt) const {
+  ClusterReductionRequest request;
+  request.accretion_radius = accretion_radius_;
+  switch (triggering_mode_) {
+  case AGNTriggeringMode::COLD_GAS: {
+    request.Request(ClusterSum::accretion_cold_mass);
+    request.cold_temp_thresh = cold_temp_thresh_;
+    request.mean_molecular_mass_by_kb = mean_molecular_mass_by_kb_;
+    request.remove_accreted_cold_gas = remove_accreted_mass_;
+    request.cold_t_acc = cold_t_acc_;
+    request.dt = dt;
+    break;
+  }
+  case AGNTriggeringMode::BOOSTED_BONDI:
+  case AGNTriggeringMode::BOOTH_SCHAYE: {
+    // Will need to divide the three latter quantities by total mass in order to get
+    // their mass-weighted averaged values
+    request.Request(ClusterSum::accretion_mass);
+    request.Request(ClusterSum::accretion_mass_weighted_density);
+    request.Request(ClusterSum::accretion_mass_weighted_velocity);
+    request.Request(ClusterSum::accretion_mass_weighted_cs);
+    request.gamma = gamma_;
+    break;
+  }
+  case AGNTriggeringMode::NONE: {
+    break;
+  }
+  }
+  return request;
 }
 
 // Remove gas consistent with Bondi accretion
@@ -277,8 +198,10 @@ void AGNTriggering::RemoveBondiAccretedGas(parthenon::MeshData<parthenon::Real>
 
   // Grab some necessary variables
   // FIXME(forrestglines) When reductions are called, is `prim` up to date?
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  const auto &prim_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("prim_names"));
+  const auto &cons_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("cons_names"));
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
@@ -291,9 +214,10 @@ void AGNTriggering::RemoveBondiAccretedGas(parthenon::MeshData<parthenon::Real>
   const Real total_mass = hydro_pkg->Param<Real>("agn_triggering_total_mass");
 
   parthenon::par_for(
-      parthenon::loop_pattern_mdrange_tag, "AGNTriggering::RemoveBondiAccretedGas",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+      parthenon::loop_pattern_mdrange_tag,
+      "Cluster::AGNTriggering::RemoveBondiAccretedGas", parthenon::DevExecSpace(), 0,
+      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -391,46 +315,36 @@ AGNTriggeringResetTriggering(parthenon::StateDescriptor *hydro_pkg) {
 parthenon::TaskStatus
 AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
                               const parthenon::Real dt) {
+  utils::profiling::ScopedRegion region("Cluster::AGNTriggering::ReduceTriggering");
 
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   const auto &agn_triggering = hydro_pkg->Param<AGNTriggering>("agn_triggering");
 
+  if (agn_triggering.triggering_mode_ == AGNTriggeringMode::NONE) {
+    return TaskStatus::complete;
+  }
+
+  // Contributions of this partition (all quantities in a single pass), accumulated below
+  // as partitions may be reduced concurrently
+  const auto sums = ReduceCluster(md, agn_triggering.GetReductionRequest(dt));
+
+  using utils::shared_params::UpdateSum;
   switch (agn_triggering.triggering_mode_) {
   case AGNTriggeringMode::COLD_GAS: {
-    Real cold_mass = hydro_pkg->Param<parthenon::Real>("agn_triggering_cold_mass");
-
-    auto fluid = hydro_pkg->Param<Fluid>("fluid");
-    if (fluid == Fluid::euler) {
-      agn_triggering.ReduceColdMass(cold_mass, md, dt,
-                                    hydro_pkg->Param<AdiabaticHydroEOS>("eos"));
-    } else if (fluid == Fluid::glmmhd) {
-      agn_triggering.ReduceColdMass(cold_mass, md, dt,
-                                    hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos"));
-    } else {
-      PARTHENON_FAIL("AGNTriggeringReduceTriggeringQuantities: Unknown EOS");
-    }
-
-    hydro_pkg->UpdateParam("agn_triggering_cold_mass", cold_mass);
+    UpdateSum(hydro_pkg.get(), "agn_triggering_cold_mass",
+              sums.Get(ClusterSum::accretion_cold_mass));
     break;
   }
   case AGNTriggeringMode::BOOSTED_BONDI:
   case AGNTriggeringMode::BOOTH_SCHAYE: {
-    Real total_mass = hydro_pkg->Param<parthenon::Real>("agn_triggering_total_mass");
-    Real mass_weighted_density =
-        hydro_pkg->Param<parthenon::Real>("agn_triggering_mass_weighted_density");
-    Real mass_weighted_velocity =
-        hydro_pkg->Param<parthenon::Real>("agn_triggering_mass_weighted_velocity");
-    Real mass_weighted_cs =
-        hydro_pkg->Param<parthenon::Real>("agn_triggering_mass_weighted_cs");
-
-    agn_triggering.ReduceBondiTriggeringQuantities(
-        total_mass, mass_weighted_density, mass_weighted_velocity, mass_weighted_cs, md);
-
-    hydro_pkg->UpdateParam("agn_triggering_total_mass", total_mass);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_density", mass_weighted_density);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_velocity",
-                           mass_weighted_velocity);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_cs", mass_weighted_cs);
+    UpdateSum(hydro_pkg.get(), "agn_triggering_total_mass",
+              sums.Get(ClusterSum::accretion_mass));
+    UpdateSum(hydro_pkg.get(), "agn_triggering_mass_weighted_density",
+              sums.Get(ClusterSum::accretion_mass_weighted_density));
+    UpdateSum(hydro_pkg.get(), "agn_triggering_mass_weighted_velocity",
+              sums.Get(ClusterSum::accretion_mass_weighted_velocity));
+    UpdateSum(hydro_pkg.get(), "agn_triggering_mass_weighted_cs",
+              sums.Get(ClusterSum::accretion_mass_weighted_cs));
     break;
   }
   case AGNTriggeringMode::NONE: {
@@ -441,49 +355,31 @@ AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
 }
 
 parthenon::TaskStatus
-AGNTriggeringMPIReduceTriggering(parthenon::StateDescriptor *hydro_pkg) {
-#ifdef MPI_PARALLEL
+AGNTriggeringSetLocalReductions(parthenon::StateDescriptor *hydro_pkg) {
   const auto &agn_triggering = hydro_pkg->Param<AGNTriggering>("agn_triggering");
-  switch (agn_triggering.triggering_mode_) {
-  case AGNTriggeringMode::COLD_GAS: {
-
-    Real accretion_rate = hydro_pkg->Param<Real>("agn_triggering_cold_mass");
-    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &accretion_rate, 1,
-                                      MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
-    hydro_pkg->UpdateParam("agn_triggering_cold_mass", accretion_rate);
-    break;
-  }
-  case AGNTriggeringMode::BOOSTED_BONDI:
-  case AGNTriggeringMode::BOOTH_SCHAYE: {
-    Real triggering_quantities[] = {
-        hydro_pkg->Param<Real>("agn_triggering_total_mass"),
-        hydro_pkg->Param<Real>("agn_triggering_mass_weighted_density"),
-        hydro_pkg->Param<Real>("agn_triggering_mass_weighted_velocity"),
-        hydro_pkg->Param<Real>("agn_triggering_mass_weighted_cs"),
-    };
-
-    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &triggering_quantities, 4,
-                                      MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
-
-    hydro_pkg->UpdateParam("agn_triggering_total_mass", triggering_quantities[0]);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_density",
-                           triggering_quantities[1]);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_velocity",
-                           triggering_quantities[2]);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_cs", triggering_quantities[3]);
-    break;
-  }
-  case AGNTriggeringMode::NONE: {
-    break;
+  auto *reductions =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+  for (const auto &name : GetReducedQuantities(agn_triggering.triggering_mode_)) {
+    reductions->SetLocal(name, hydro_pkg->Param<Real>(name));
   }
+  return TaskStatus::complete;
+}
+
+parthenon::TaskStatus
+AGNTriggeringGetGlobalReductions(parthenon::StateDescriptor *hydro_pkg) {
+  const auto &agn_triggering = hydro_pkg->Param<AGNTriggering>("agn_triggering");
+  const auto &reductions =
+      hydro_pkg->Param<utils::GlobalReductions>("global_reductions");
+  for (const auto &name : GetReducedQuantities(agn_triggering.triggering_mode_)) {
+    hydro_pkg->UpdateParam(name, reductions.Get(name));
   }
-#endif
   return TaskStatus::complete;
 }
 
 parthenon::TaskStatus
 AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
                                 const parthenon::SimTime &tm) {
+  utils::profiling::ScopedRegion region("Cluster::AGNTriggering::FinalizeTriggering");
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   const auto &agn_triggering = hydro_pkg->Param<AGNTriggering>("agn_triggering");
 
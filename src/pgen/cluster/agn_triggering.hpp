@@ -18,6 +18,7 @@
 
 // AthenaPK headers
 #include "../../units.hpp"
+#include "cluster_reductions.hpp"
 #include "jet_coords.hpp"
 #include "utils/error_checking.hpp"
 
@@ -34,6 +35,7 @@ class AGNTriggering {
  private:
   const parthenon::Real gamma_;
   parthenon::Real mean_molecular_mass_;
+  parthenon::Real mean_molecular_mass_by_kb_;
 
  public:
   const AGNTriggeringMode triggering_mode_;
@@ -68,20 +70,11 @@ class AGNTriggering {
   AGNTriggering(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg,
                 const std::string &block = "problem/cluster/agn_triggering");
 
-  // Compute Cold gas accretion rate within the accretion radius for cold gas triggering
-  // and simultaneously remove cold gas (updating conserveds and primitives)
-  template <typename EOS>
-  void ReduceColdMass(parthenon::Real &cold_mass,
-                      parthenon::MeshData<parthenon::Real> *md, const parthenon::Real dt,
-                      const EOS eos) const;
-
-  // Compute Mass-weighted total density, velocity, and sound speed and total mass
-  // for Bondi accretion
-  void ReduceBondiTriggeringQuantities(parthenon::Real &total_mass,
-                                       parthenon::Real &mass_weighted_density,
-                                       parthenon::Real &mass_weighted_velocity,
-                                       parthenon::Real &mass_weighted_cs,
-                                       parthenon::MeshData<parthenon::Real> *md) const;
+  // Request of the triggering quantities within the accretion radius from the fused
+  // cluster reduction: the cold gas mass for cold gas triggering (simultaneously removing
+  // the cold gas, updating conserveds and primitives) or the total mass and mass-weighted
+  // density, velocity, and sound speed for Bondi accretion
+  ClusterReductionRequest GetReductionRequest(const parthenon::Real dt) const;
 
   // Remove gas consistent with Bondi accretion
   /// i.e. proportional to the accretion rate, weighted by the local gas mass
@@ -101,7 +94,10 @@ class AGNTriggering {
                                 const parthenon::Real dt);
 
   friend parthenon::TaskStatus
-  AGNTriggeringMPIReduceTriggering(parthenon::StateDescriptor *hydro_pkg);
+  AGNTriggeringSetLocalReductions(parthenon::StateDescriptor *hydro_pkg);
+
+  friend parthenon::TaskStatus
+  AGNTriggeringGetGlobalReductions(parthenon::StateDescriptor *hydro_pkg);
 
   friend parthenon::TaskStatus
   AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
@@ -119,8 +115,13 @@ parthenon::TaskStatus
 AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
                               const parthenon::Real dt);
 
+// Sets the local triggering quantities in/gets the global ones from the "cluster" phase
+// of the global reductions
+parthenon::TaskStatus
+AGNTriggeringSetLocalReductions(parthenon::StateDescriptor *hydro_pkg);
+
 parthenon::TaskStatus
-AGNTriggeringMPIReduceTriggering(parthenon::StateDescriptor *hydro_pkg);
+AGNTriggeringGetGlobalReductions(parthenon::StateDescriptor *hydro_pkg);
 
 parthenon::TaskStatus
 AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
@@ -4,8 +4,12 @@
 // Copyright (c) 2021-2023, Athena-Parthenon Collaboration. All rights reserved.
 // Licensed under the 3-clause BSD License, see LICENSE file for details
 //========================================================================================
-//! \file agn_triggering.cpp
-//  \brief  Class for computing AGN triggering from Bondi-like and cold gas accretion
+//! \file cluster_clips.cpp
+//  \brief  Applying floors and ceils and reducing removed/added mass/energy
+
+// C++ headers
+#include <limits>
+#include <set>
 
 // Parthenon headers
 #include "kokkos_abstraction.hpp"
@@ -18,6 +22,9 @@
 // AthenaPK headers
 #include "../../eos/adiabatic_glmmhd.hpp"
 #include "../../eos/adiabatic_hydro.hpp"
+#include "../../eos/clips.hpp"
+#include "../../utils/shared_params.hpp"
+#include "cluster_clips.hpp"
 
 namespace cluster {
 using namespace parthenon;
@@ -39,6 +46,52 @@ void ApplyClusterClips(MeshData<Real> *md, const parthenon::SimTime &tm,
   }
 }
 
+namespace {
+// Clips of the current cluster parameters (or a negative clip radius if all are disabled)
+RadialClip MakeClip(MeshData<Real> *md) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  RadialClip clip;
+  clip.dfloor = hydro_pkg->Param<Real>("cluster_dfloor");
+  clip.eceil = hydro_pkg->Param<Real>("cluster_eceil");
+  clip.vceil = hydro_pkg->Param<Real>("cluster_vceil");
+  clip.vAceil = hydro_pkg->Param<Real>("cluster_vAceil");
+  const auto clip_r = hydro_pkg->Param<Real>("cluster_clip_r");
+  constexpr Real inf = std::numeric_limits<Real>::infinity();
+  const bool active = clip_r > 0 && (clip.dfloor > 0 || clip.eceil < inf ||
+                                     clip.vceil < inf || clip.vAceil < inf);
+  clip.clip_r2 = active ? SQR(clip_r) : -1.0;
+  clip.gm1 = hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0;
+  clip.magnetic_fields = hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd;
+  clip.ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  clip.jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  clip.kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  if (active) {
+    clip.sums = ParArray1D<Real>("Cluster::ClipSums", 4);
+  }
+  return clip;
+}
+
+// Add the freshly added mass/removed energy to running totals
+void AddClipSums(StateDescriptor *hydro_pkg, const RadialClip &clip) {
+  auto sums = Kokkos::create_mirror_view_and_copy(HostMemSpace(), clip.sums);
+  using utils::shared_params::UpdateSum;
+  UpdateSum(hydro_pkg, "added_dfloor_mass", sums(0));
+  UpdateSum(hydro_pkg, "removed_vceil_energy", sums(1));
+  UpdateSum(hydro_pkg, "added_vAceil_mass", sums(2));
+  UpdateSum(hydro_pkg, "removed_eceil_energy", sums(3));
+}
+
+template <class EOS>
+Real ConsToPrimWithClip(MeshData<Real> *md, const EOS &eos, const RadialClip &clip,
+                        const bool with_dt_hyp) {
+  if (with_dt_hyp) {
+    return eos.ConservedToPrimitiveAndTimestep(md, clip);
+  }
+  eos.ConservedToPrimitive(md, clip);
+  return std::numeric_limits<Real>::max();
+}
+} // namespace
+
 template <class EOS>
 void ApplyClusterClips(MeshData<Real> *md, const parthenon::SimTime &tm,
                        const Real beta_dt, const EOS eos) {
@@ -47,129 +100,65 @@ void ApplyClusterClips(MeshData<Real> *md, const parthenon::SimTime &tm,
 
   // Apply clips -- ceilings on temperature, velocity, alfven velocity, and
   // density floor -- within a radius of the AGN
-  const auto &dfloor = hydro_pkg->Param<Real>("cluster_dfloor");
-  const auto &eceil = hydro_pkg->Param<Real>("cluster_eceil");
-  const auto &vceil = hydro_pkg->Param<Real>("cluster_vceil");
-  const auto &vAceil = hydro_pkg->Param<Real>("cluster_vAceil");
-  const auto &clip_r = hydro_pkg->Param<Real>("cluster_clip_r");
-
-  if (clip_r > 0 && (dfloor > 0 || eceil < std::numeric_limits<Real>::infinity() ||
-                     vceil < std::numeric_limits<Real>::infinity() ||
-                     vAceil < std::numeric_limits<Real>::infinity())) {
-    // Grab some necessary variables
-    const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-    const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-    IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-    IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-    IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
-    const auto nhydro = hydro_pkg->Param<int>("nhydro");
-    const auto nscalars = hydro_pkg->Param<int>("nscalars");
-
-    const Real clip_r2 = SQR(clip_r);
-    const Real vceil2 = SQR(vceil);
-    const Real vAceil2 = SQR(vAceil);
-    const Real gm1 = (hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0);
-
-    const bool magnetic_fields = (hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd);
-    Real added_dfloor_mass = 0.0, removed_vceil_energy = 0.0, added_vAceil_mass = 0.0,
-         removed_eceil_energy = 0.0;
-
-    Kokkos::parallel_reduce(
-        "Cluster::ApplyClusterClips",
-        Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-            DevExecSpace(), {0, kb.s, jb.s, ib.s},
-            {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-            {1, 1, 1, ib.e + 1 - ib.s}),
-        KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
-                      Real &added_dfloor_mass_team, Real &removed_vceil_energy_team,
-                      Real &added_vAceil_mass_team, Real &removed_eceil_energy_team) {
-          auto &cons = cons_pack(b);
-          auto &prim = prim_pack(b);
-          const auto &coords = cons_pack.GetCoords(b);
-
-          const Real r2 =
-              SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j)) + SQR(coords.Xc<3>(k));
-
-          if (r2 < clip_r2) {
-            // Cell falls within clipping radius
-            eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
-
-            if (dfloor > 0) {
-              const Real rho = prim(IDN, k, j, i);
-              if (rho < dfloor) {
-                added_dfloor_mass_team += (dfloor - rho) * coords.CellVolume(k, j, i);
-                cons(IDN, k, j, i) = dfloor;
-                prim(IDN, k, j, i) = dfloor;
-              }
-            }
-
-            if (vceil < std::numeric_limits<Real>::infinity()) {
-              // Apply velocity ceiling
-              const Real v2 = SQR(prim(IV1, k, j, i)) + SQR(prim(IV2, k, j, i)) +
-                              SQR(prim(IV3, k, j, i));
-              if (v2 > vceil2) {
-                // Fix the velocity to the velocity ceiling
-                const Real v = sqrt(v2);
-                cons(IM1, k, j, i) *= vceil / v;
-                cons(IM2, k, j, i) *= vceil / v;
-                cons(IM3, k, j, i) *= vceil / v;
-                prim(IV1, k, j, i) *= vceil / v;
-                prim(IV2, k, j, i) *= vceil / v;
-                prim(IV3, k, j, i) *= vceil / v;
-
-                // Remove kinetic energy
-                const Real removed_energy = 0.5 * prim(IDN, k, j, i) * (v2 - vceil2);
-                removed_vceil_energy_team += removed_energy * coords.CellVolume(k, j, i);
-                cons(IEN, k, j, i) -= removed_energy;
-              }
-            }
-
-            if (magnetic_fields && vAceil2 < std::numeric_limits<Real>::infinity()) {
-              // Apply Alfven velocity ceiling by raising density
-              const Real rho = prim(IDN, k, j, i);
-              const Real B2 = (SQR(prim(IB1, k, j, i)) + SQR(prim(IB2, k, j, i)) +
-                               SQR(prim(IB3, k, j, i)));
-
-              // compute Alfven mach number
-              const Real va2 = (B2 / rho);
-
-              if (va2 > vAceil2) {
-                // Increase the density to match the alfven velocity ceiling
-                const Real rho_new = std::sqrt(B2 / vAceil2);
-                added_vAceil_mass_team += (rho_new - rho) * coords.CellVolume(k, j, i);
-                cons(IDN, k, j, i) = rho_new;
-                prim(IDN, k, j, i) = rho_new;
-              }
-            }
-
-            if (eceil < std::numeric_limits<Real>::infinity()) {
-              // Apply  internal energy ceiling as a pressure ceiling
-              const Real internal_e = prim(IPR, k, j, i) / (gm1 * prim(IDN, k, j, i));
-              if (internal_e > eceil) {
-                const Real removed_energy = prim(IDN, k, j, i) * (internal_e - eceil);
-                removed_eceil_energy_team += removed_energy * coords.CellVolume(k, j, i);
-                cons(IEN, k, j, i) -= removed_energy;
-                prim(IPR, k, j, i) = gm1 * prim(IDN, k, j, i) * eceil;
-              }
-            }
-          }
-        },
-        added_dfloor_mass, removed_vceil_energy, added_vAceil_mass, removed_eceil_energy);
-
-    // Add the freshly added mass/removed energy to running totals
-    hydro_pkg->UpdateParam("added_dfloor_mass",
-                           added_dfloor_mass +
-                               hydro_pkg->Param<parthenon::Real>("added_dfloor_mass"));
-    hydro_pkg->UpdateParam("removed_vceil_energy",
-                           removed_vceil_energy +
-                               hydro_pkg->Param<parthenon::Real>("removed_vceil_energy"));
-    hydro_pkg->UpdateParam("added_vAceil_mass",
-                           added_vAceil_mass +
-                               hydro_pkg->Param<parthenon::Real>("added_vAceil_mass"));
-    hydro_pkg->UpdateParam("removed_eceil_energy",
-                           removed_eceil_energy +
-                               hydro_pkg->Param<parthenon::Real>("removed_eceil_energy"));
+  const auto clip = MakeClip(md);
+  if (clip.clip_r2 <= 0) {
+    return;
+  }
+
+  if (hydro_pkg->Param<bool>("cluster_fused_clips")) {
+    // Applied as part of the following conversion to primitive variables
+    utils::shared_params::WithMutableParam<std::set<MeshData<Real> *>>(
+        hydro_pkg.get(), "cluster_clips_pending",
+        [&](auto *pending) { pending->insert(md); });
+    return;
+  }
+
+  // Grab some necessary variables
+  const auto &prim_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("prim_names"));
+  const auto &cons_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("cons_names"));
+  const auto nhydro = hydro_pkg->Param<int>("nhydro");
+  const auto nscalars = hydro_pkg->Param<int>("nscalars");
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Cluster::ApplyClusterClips", DevExecSpace(), 0,
+      cons_pack.GetDim(5) - 1, clip.kb.s, clip.kb.e, clip.jb.s, clip.jb.e, clip.ib.s,
+      clip.ib.e, KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+        auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+        const auto &coords = cons_pack.GetCoords(b);
+        if (clip.Contains(coords, k, j, i)) {
+          // Cell falls within clipping radius
+          eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+          clip(cons, prim, coords, k, j, i);
+        }
+      });
+  AddClipSums(hydro_pkg.get(), clip);
+}
+
+bool ClusterConsToPrim(MeshData<Real> *md, const bool with_dt_hyp, Real &dt_hyp) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  if (!hydro_pkg->Param<bool>("cluster_fused_clips")) {
+    return false;
+  }
+  const bool pending = utils::shared_params::WithMutableParam<std::set<MeshData<Real> *>>(
+      hydro_pkg.get(), "cluster_clips_pending",
+      [&](auto *pending) { return pending->erase(md) > 0; });
+  if (!pending) {
+    return false;
+  }
+
+  const auto clip = MakeClip(md);
+  if (hydro_pkg->Param<Fluid>("fluid") == Fluid::euler) {
+    dt_hyp = ConsToPrimWithClip(md, hydro_pkg->Param<AdiabaticHydroEOS>("eos"), clip,
+                                with_dt_hyp);
+  } else {
+    dt_hyp = ConsToPrimWithClip(md, hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos"), clip,
+                                with_dt_hyp);
   }
+  AddClipSums(hydro_pkg.get(), clip);
+  return true;
 }
 
 } // namespace cluster
\ No newline at end of file
@@ -22,6 +22,11 @@ namespace cluster {
 void ApplyClusterClips(MeshData<Real> *md, const parthenon::SimTime &tm,
                        const Real beta_dt);
 
+// With <problem/cluster/clips> fused, the clips are only marked as pending by
+// ApplyClusterClips and applied as part of the following conversion to primitive
+// variables of md (see Hydro::ProblemConsToPrim).
+bool ClusterConsToPrim(MeshData<Real> *md, const bool with_dt_hyp, Real &dt_hyp);
+
 }
 
 #endif // CLUSTER_AGN_TRIGGERING_HPP_
\ No newline at end of file
@@ -8,7 +8,12 @@
 //! \file cluster_gravity.hpp
 //  \brief Class for defining gravitational acceleration for a cluster+bcg+smbh
 
+// C++ headers
+#include <algorithm>
+#include <cmath>
+
 // Parthenon headers
+#include <kokkos_abstraction.hpp>
 #include <parameter_input.hpp>
 
 // AthenaPK headers
@@ -52,6 +57,18 @@ class ClusterGravity {
   // Radius underwhich to truncate
   parthenon::Real smoothing_r_;
 
+  // Optional table of g(r) with table_bins_ bins per octave in r (i.e., approximately
+  // log-spaced bins that are uniform in r within each octave) from 2^(table_e_min_ - 1)
+  // to 2^(table_e_min_ - 1 + table_octaves_). The position in the table follows from the
+  // binary exponent and mantissa of r so that no log is required for the lookup.
+  bool tabulated_ = false;
+  int table_bins_ = 0;
+  int table_e_min_ = 0;
+  int table_octaves_ = 0;
+  using Table_t = Kokkos::View<parthenon::Real *, parthenon::DevMemSpace>;
+  Table_t g_table_;
+  typename Table_t::host_mirror_type g_table_h_;
+
   // Static Helper functions to calculate constants to minimize in-kernel work
   static parthenon::Real calc_R_nfw_s(const parthenon::Real rho_crit,
                                       const parthenon::Real m_nfw_200,
@@ -162,6 +179,46 @@ class ClusterGravity {
 
     smoothing_r_ =
         pin->GetOrAddReal("problem/cluster/gravity", "g_smoothing_radius", 0.0);
+
+    // Optionally tabulate g(r) (as it is static and purely radial)
+    table_bins_ =
+        pin->GetOrAddInteger("problem/cluster/gravity", "table_bins_per_octave", 0);
+    PARTHENON_REQUIRE_THROWS(
+        table_bins_ >= 0, "problem/cluster/gravity/table_bins_per_octave must be >= 0");
+    if (table_bins_ > 0) {
+      // By default, cover the full domain (from the origin at the cluster center)
+      parthenon::Real r_max_domain2 = 0.0;
+      for (const auto dir : {"1", "2", "3"}) {
+        const auto xmin = pin->GetReal("parthenon/mesh", std::string("x") + dir + "min");
+        const auto xmax = pin->GetReal("parthenon/mesh", std::string("x") + dir + "max");
+        const auto x = std::max(std::abs(xmin), std::abs(xmax));
+        r_max_domain2 += x * x;
+      }
+      const auto r_max = pin->GetOrAddReal("problem/cluster/gravity", "table_r_max",
+                                           std::sqrt(r_max_domain2));
+      const auto r_min = pin->GetOrAddReal("problem/cluster/gravity", "table_r_min",
+                                           std::ldexp(r_max, -20));
+      PARTHENON_REQUIRE_THROWS(r_min > 0.0 && r_max > r_min,
+                               "Gravity table requires 0 < table_r_min < table_r_max");
+      int e_max;
+      std::frexp(r_min, &table_e_min_);
+      std::frexp(r_max, &e_max);
+      table_octaves_ = e_max - table_e_min_ + 1;
+      const int table_size = table_octaves_ * table_bins_ + 1;
+
+      g_table_ = Table_t("ClusterGravity::g_table", table_size);
+      g_table_h_ = Kokkos::create_mirror_view(g_table_);
+      for (int n = 0; n < table_size; n++) {
+        const int octave = n / table_bins_;
+        const int bin = n % table_bins_;
+        const parthenon::Real r =
+            std::ldexp(1.0 + static_cast<parthenon::Real>(bin) / table_bins_,
+                       table_e_min_ + octave - 1);
+        g_table_h_(n) = g_from_r_analytic(r);
+      }
+      Kokkos::deep_copy(g_table_, g_table_h_);
+      tabulated_ = true;
+    }
   }
 
   ClusterGravity(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg)
@@ -172,6 +229,36 @@ class ClusterGravity {
   // Inline functions to compute gravitational acceleration
   KOKKOS_INLINE_FUNCTION parthenon::Real g_from_r(const parthenon::Real r_in) const
       __attribute__((always_inline)) {
+    if (tabulated_) {
+      parthenon::Real g_r;
+      KOKKOS_IF_ON_DEVICE((if (g_from_table(g_table_, r_in, g_r)) { return g_r; }))
+      KOKKOS_IF_ON_HOST((if (g_from_table(g_table_h_, r_in, g_r)) { return g_r; }))
+    }
+    return g_from_r_analytic(r_in);
+  }
+
+  // Linear interpolation of g within the table. Returns false outside of the table.
+  template <typename View_t>
+  KOKKOS_INLINE_FUNCTION bool g_from_table(const View_t &table, const parthenon::Real r,
+                                           parthenon::Real &g_r) const
+      __attribute__((always_inline)) {
+    int e;
+    // r = mant * 2^e with mant in [0.5, 1)
+    const parthenon::Real mant = frexp(r, &e);
+    const int octave = e - table_e_min_;
+    if (!(r > 0) || octave < 0 || octave >= table_octaves_) {
+      return false;
+    }
+    const parthenon::Real pos = (2 * mant - 1) * table_bins_;
+    const int bin = static_cast<int>(pos);
+    const parthenon::Real w = pos - bin;
+    const int n = octave * table_bins_ + bin;
+    g_r = (1 - w) * table(n) + w * table(n + 1);
+    return true;
+  }
+
+  KOKKOS_INLINE_FUNCTION parthenon::Real
+  g_from_r_analytic(const parthenon::Real r_in) const __attribute__((always_inline)) {
 
     const parthenon::Real r = std::max(r_in, smoothing_r_);
     const parthenon::Real r2 = r * r;
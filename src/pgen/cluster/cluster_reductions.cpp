@@ -1,4 +1,3 @@
-
 //========================================================================================
 // AthenaPK - a performance portable block structured AMR astrophysical MHD code.
 // Copyright (c) 2021-2023, Athena-Parthenon Collaboration. All rights reserved.
@@ -8,6 +7,10 @@
 //  \brief  Cluster-specific reductions to compute the total cold gas and maximum radius
 //  of AGN feedback
 
+// C++ headers
+#include <cmath>
+#include <vector>
+
 // Parthenon headers
 #include "kokkos_abstraction.hpp"
 #include "mesh/domain.hpp"
@@ -19,83 +22,180 @@
 // AthenaPK headers
 #include "../../eos/adiabatic_glmmhd.hpp"
 #include "../../eos/adiabatic_hydro.hpp"
+#include "cluster_reductions.hpp"
+#include "cluster_utils.hpp"
 
 namespace cluster {
 using namespace parthenon;
 
-parthenon::Real LocalReduceColdGas(parthenon::MeshData<parthenon::Real> *md) {
+namespace {
+template <typename EOS>
+ClusterSums ReduceCluster(MeshData<Real> *md, const ClusterReductionRequest &request,
+                          const EOS eos) {
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
-  const auto &cold_thresh = hydro_pkg->Param<Real>("reduction_cold_threshold");
-  auto mbar_over_kb = hydro_pkg->Param<Real>("mbar_over_kb");
-  const auto e_thresh =
-      cold_thresh / mbar_over_kb / (hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0);
-
-  // Grab some necessary variables
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
-  const auto nhydro = hydro_pkg->Param<int>("nhydro");
+  const bool cold_gas = request.IsRequested(ClusterSum::cold_gas);
+  const bool agn_extent = request.agn_extent;
+  const bool accretion_cold_mass = request.IsRequested(ClusterSum::accretion_cold_mass);
+  const bool bondi = request.IsRequested(ClusterSum::accretion_mass) ||
+                     request.IsRequested(ClusterSum::accretion_mass_weighted_density) ||
+                     request.IsRequested(ClusterSum::accretion_mass_weighted_velocity) ||
+                     request.IsRequested(ClusterSum::accretion_mass_weighted_cs);
+  const bool remove_cold_gas = accretion_cold_mass && request.remove_accreted_cold_gas;
 
   const Real gm1 = (hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0);
+  const Real e_thresh =
+      cold_gas ? hydro_pkg->Param<Real>("reduction_cold_threshold") /
+                     hydro_pkg->Param<Real>("mbar_over_kb") / gm1
+               : 0.0;
+  const Real tracer_thresh =
+      agn_extent ? hydro_pkg->Param<Real>("reduction_agn_tracer_threshold") : 0.0;
+
+  const Real accretion_radius2 = SQR(request.accretion_radius);
+  const Real cold_temp_thresh = request.cold_temp_thresh;
+  const Real mean_molecular_mass_by_kb = request.mean_molecular_mass_by_kb;
+  const Real gamma = request.gamma;
+  const Real cold_t_acc = request.cold_t_acc;
+  const Real dt = request.dt;
 
-  Real cold_gas = 0.0;
-
+  // Grab some necessary variables
+  const auto &prim_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("prim_names"));
+  const auto &cons_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("cons_names"));
+  const auto nhydro = hydro_pkg->Param<int>("nhydro");
+  const auto nscalars = hydro_pkg->Param<int>("nscalars");
+
+  // Removing the accreted cold gas also covers the ghost cells, but only interior cells
+  // contribute to the reductions
+  const auto domain = remove_cold_gas ? IndexDomain::entire : IndexDomain::interior;
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(domain);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(domain);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(domain);
+  IndexRange int_ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange int_jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange int_kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  constexpr int iCG = static_cast<int>(ClusterSum::cold_gas);
+  constexpr int iACM = static_cast<int>(ClusterSum::accretion_cold_mass);
+  constexpr int iAM = static_cast<int>(ClusterSum::accretion_mass);
+  constexpr int iAD = static_cast<int>(ClusterSum::accretion_mass_weighted_density);
+  constexpr int iAV = static_cast<int>(ClusterSum::accretion_mass_weighted_velocity);
+  constexpr int iACS = static_cast<int>(ClusterSum::accretion_mass_weighted_cs);
+
+  ClusterSums sums;
   Kokkos::parallel_reduce(
-      "LocalReduceColdGas",
+      "Cluster::ReduceCluster",
       Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
           DevExecSpace(), {0, kb.s, jb.s, ib.s},
-          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
           {1, 1, 1, ib.e + 1 - ib.s}),
       KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
-                    Real &cold_gas_team) {
+                    ClusterSums &lsums) {
+        auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
-        const auto &coords = prim_pack.GetCoords(b);
+        const auto &coords = cons_pack.GetCoords(b);
 
-        const Real internal_e = prim(IPR, k, j, i) / (gm1 * prim(IDN, k, j, i));
-        if (internal_e < e_thresh) {
-          cold_gas_team += prim(IDN, k, j, i) * coords.CellVolume(k, j, i);
+        const bool interior = k >= int_kb.s && k <= int_kb.e && j >= int_jb.s &&
+                              j <= int_jb.e && i >= int_ib.s && i <= int_ib.e;
+        const Real r2 =
+            SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j)) + SQR(coords.Xc<3>(k));
+        const Real vol = coords.CellVolume(k, j, i);
+
+        if (interior && cold_gas) {
+          const Real internal_e = prim(IPR, k, j, i) / (gm1 * prim(IDN, k, j, i));
+          if (internal_e < e_thresh) {
+            lsums.sum[iCG] += prim(IDN, k, j, i) * vol;
+          }
         }
-      },
-      cold_gas);
-  return cold_gas;
-}
-
-parthenon::Real LocalReduceAGNExtent(parthenon::MeshData<parthenon::Real> *md) {
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-
-  const auto &tracer_thresh = hydro_pkg->Param<Real>("reduction_agn_tracer_threshold");
 
-  // Grab some necessary variables
-  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
-  const auto nhydro = hydro_pkg->Param<int>("nhydro");
+        if (interior && agn_extent &&
+            cons(nhydro, k, j, i) / cons(IDN, k, j, i) > tracer_thresh &&
+            r2 > lsums.max_agn_r2) {
+          lsums.max_agn_r2 = r2;
+        }
 
-  Real max_r2 = 0.0;
+        if (r2 >= accretion_radius2) {
+          return;
+        }
 
-  Kokkos::parallel_reduce(
-      "LocalReduceAGNExtent",
-      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-          DevExecSpace(), {0, kb.s, jb.s, ib.s},
-          {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-          {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
-                    Real &max_r2_team) {
-        auto &cons = cons_pack(b);
-        const auto &coords = cons_pack.GetCoords(b);
+        if (interior && bondi) {
+          const Real cell_mass = prim(IDN, k, j, i) * vol;
+          lsums.sum[iAM] += cell_mass;
+          lsums.sum[iAD] += cell_mass * prim(IDN, k, j, i);
+          lsums.sum[iAV] += cell_mass * sqrt(SQR(prim(IV1, k, j, i)) +
+                                             SQR(prim(IV2, k, j, i)) +
+                                             SQR(prim(IV3, k, j, i)));
+          lsums.sum[iACS] +=
+              cell_mass * sqrt(gamma * prim(IPR, k, j, i) / prim(IDN, k, j, i));
+        }
 
-        const auto r2 = SQR(coords.Xc<1>(k, j, i)) + SQR(coords.Xc<2>(k, j, i)) +
-                        SQR(coords.Xc<3>(k, j, i));
-        if (cons(nhydro, k, j, i) / cons(IDN, k, j, i) > tracer_thresh && r2 > max_r2) {
-          max_r2_team = r2;
+        if (accretion_cold_mass) {
+          const Real temp =
+              mean_molecular_mass_by_kb * prim(IPR, k, j, i) / prim(IDN, k, j, i);
+          if (temp <= cold_temp_thresh) {
+            if (interior) {
+              // Only reduce the cold gas that exists on the interior grid
+              lsums.sum[iACM] += prim(IDN, k, j, i) * vol;
+            }
+            if (remove_cold_gas) {
+              const Real cell_delta_rho = -prim(IDN, k, j, i) / cold_t_acc * dt;
+              AddDensityToConsAtFixedVelTemp(cell_delta_rho, cons, prim, eos.GetGamma(),
+                                             k, j, i);
+              // Update the Primitives
+              eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+            }
+          }
         }
       },
-      Kokkos::Max<Real>(max_r2));
+      Kokkos::Sum<ClusterSums>(sums));
+  return sums;
+}
+} // namespace
 
-  return std::sqrt(max_r2);
+ClusterSums ReduceCluster(MeshData<Real> *md, const ClusterReductionRequest &request) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  auto fluid = hydro_pkg->Param<Fluid>("fluid");
+  if (fluid == Fluid::euler) {
+    return ReduceCluster(md, request, hydro_pkg->Param<AdiabaticHydroEOS>("eos"));
+  } else if (fluid == Fluid::glmmhd) {
+    return ReduceCluster(md, request, hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos"));
+  }
+  PARTHENON_FAIL("Cluster::ReduceCluster: Unknown EOS");
+  return ClusterSums();
+}
+
+parthenon::Real LocalReduceColdGas(parthenon::MeshData<parthenon::Real> *md) {
+  ClusterReductionRequest request;
+  request.Request(ClusterSum::cold_gas);
+  return ReduceCluster(md, request).Get(ClusterSum::cold_gas);
+}
+
+parthenon::Real LocalReduceAGNExtent(parthenon::MeshData<parthenon::Real> *md) {
+  ClusterReductionRequest request;
+  request.agn_extent = true;
+  return std::sqrt(ReduceCluster(md, request).max_agn_r2);
+}
+
+std::vector<parthenon::Real>
+LocalReduceClusterHst(parthenon::MeshData<parthenon::Real> *md) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const bool cold_gas = hydro_pkg->AllParams().hasKey("reduction_cold_threshold");
+  ClusterReductionRequest request;
+  if (cold_gas) {
+    request.Request(ClusterSum::cold_gas);
+  }
+  request.agn_extent = hydro_pkg->AllParams().hasKey("reduction_agn_tracer_threshold");
+
+  const auto sums = ReduceCluster(md, request);
+  std::vector<Real> values;
+  if (cold_gas) {
+    values.push_back(sums.Get(ClusterSum::cold_gas));
+  }
+  if (request.agn_extent) {
+    values.push_back(std::sqrt(sums.max_agn_r2));
+  }
+  return values;
 }
 
-} // namespace cluster
\ No newline at end of file
+} // namespace cluster
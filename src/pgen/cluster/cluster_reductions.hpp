@@ -8,6 +8,14 @@
 //! \file cluster_reductions.hpp
 //  \brief  Cluster-specific reductions to compute the total cold gas and maximum radius
 //  of AGN feedback
+//
+// All cluster reductions (history outputs of the cold gas and AGN extent, and the
+// quantities within the accretion radius used by the AGN triggering) are calculated by
+// ReduceCluster in a single pass over the data with an array-valued reducer. Callers
+// request the quantities they need through a ClusterReductionRequest.
+
+// C++ headers
+#include <vector>
 
 // parthenon headers
 #include <basic_types.hpp>
@@ -15,10 +23,89 @@
 
 namespace cluster {
 
+// Sums of the fused cluster reduction
+enum class ClusterSum : int {
+  // Mass of gas below the reduction_cold_threshold temperature (history output)
+  cold_gas,
+  // Mass of gas below the cold_temp_thresh within the accretion radius (cold gas
+  // triggering)
+  accretion_cold_mass,
+  // Mass and mass weighted density, velocity, and sound speed within the accretion
+  // radius (Bondi-like triggering)
+  accretion_mass,
+  accretion_mass_weighted_density,
+  accretion_mass_weighted_velocity,
+  accretion_mass_weighted_cs,
+  num
+};
+constexpr int kNumClusterSums = static_cast<int>(ClusterSum::num);
+
+// Value of the fused cluster reduction (to be reduced with Kokkos::Sum)
+struct ClusterSums {
+  parthenon::Real sum[kNumClusterSums];
+  // Maximum squared radius of cells with an AGN tracer above the threshold
+  parthenon::Real max_agn_r2;
+
+  KOKKOS_INLINE_FUNCTION ClusterSums() : max_agn_r2(0.0) {
+    for (int n = 0; n < kNumClusterSums; n++) {
+      sum[n] = 0.0;
+    }
+  }
+
+  // Joins partial results, i.e., sums the sums and takes the maximum of the maxima
+  KOKKOS_INLINE_FUNCTION ClusterSums &operator+=(const ClusterSums &other) {
+    for (int n = 0; n < kNumClusterSums; n++) {
+      sum[n] += other.sum[n];
+    }
+    max_agn_r2 = other.max_agn_r2 > max_agn_r2 ? other.max_agn_r2 : max_agn_r2;
+    return *this;
+  }
+
+  parthenon::Real Get(const ClusterSum q) const { return sum[static_cast<int>(q)]; }
+};
+
+struct ClusterReductionRequest {
+  bool sums[kNumClusterSums] = {};
+  bool agn_extent = false;
+
+  // Parameters of the accretion region (only used if accretion quantities are requested)
+  parthenon::Real accretion_radius = 0.0;
+  parthenon::Real cold_temp_thresh = 0.0;
+  parthenon::Real mean_molecular_mass_by_kb = 0.0;
+  parthenon::Real gamma = 0.0;
+  // Remove the cold gas within the accretion radius over the accretion time cold_t_acc
+  // (updating conserveds and primitives, including ghost cells) in the same pass
+  bool remove_accreted_cold_gas = false;
+  parthenon::Real cold_t_acc = 0.0;
+  parthenon::Real dt = 0.0;
+
+  void Request(const ClusterSum q) { sums[static_cast<int>(q)] = true; }
+  bool IsRequested(const ClusterSum q) const { return sums[static_cast<int>(q)]; }
+};
+
+// Local (rank and partition) values of the requested quantities (unrequested quantities
+// are zero)
+ClusterSums ReduceCluster(parthenon::MeshData<parthenon::Real> *md,
+                          const ClusterReductionRequest &request);
+
 parthenon::Real LocalReduceColdGas(parthenon::MeshData<parthenon::Real> *md);
 
 parthenon::Real LocalReduceAGNExtent(parthenon::MeshData<parthenon::Real> *md);
 
+// History outputs "cold_mass" and/or "agn_extent" from a single ReduceCluster
+std::vector<parthenon::Real>
+LocalReduceClusterHst(parthenon::MeshData<parthenon::Real> *md);
+
 } // namespace cluster
 
+namespace Kokkos {
+// Required to use Kokkos::Sum with cluster::ClusterSums
+template <>
+struct reduction_identity<cluster::ClusterSums> {
+  KOKKOS_FORCEINLINE_FUNCTION static cluster::ClusterSums sum() {
+    return cluster::ClusterSums();
+  }
+};
+} // namespace Kokkos
+
 #endif // CLUSTER_CLUSTER_REDUCTIONS_HPP_
@@ -11,17 +11,28 @@
 //========================================================================================
 
 // C++ headers
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
 
 // Parthenon headers
 #include <coordinates/uniform_cartesian.hpp>
 #include <globals.hpp>
 #include <mesh/domain.hpp>
+#include <mesh/mesh.hpp>
 #include <parameter_input.hpp>
+#include <parthenon/package.hpp>
 
 // AthenaPK headers
 #include "../../units.hpp"
+#include "../../utils/random.hpp"
 
 // Cluster headers
 #include "cluster_gravity.hpp"
@@ -31,6 +42,18 @@
 namespace cluster {
 using namespace parthenon;
 
+namespace {
+ParArray1D<Real> ToDevice(const std::string &label, const std::vector<Real> &values) {
+  ParArray1D<Real> device_values(label, values.size());
+  auto host_values = Kokkos::create_mirror_view(device_values);
+  for (int i = 0; i < values.size(); i++) {
+    host_values(i) = values[i];
+  }
+  Kokkos::deep_copy(device_values, host_values);
+  return device_values;
+}
+} // namespace
+
 /************************************************************
  * HydrostaticEquilibriumSphere constructor
  ************************************************************/
@@ -59,6 +82,23 @@ HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::
   r_sampling_ =
       pin->GetOrAddReal("problem/cluster/hydrostatic_equilibrium", "r_sampling", 4.0);
 
+  shared_profiles_ = pin->GetOrAddBoolean("problem/cluster/hydrostatic_equilibrium",
+                                          "shared_profiles", false);
+  cache_basename_ =
+      pin->GetOrAddString("problem/cluster/hydrostatic_equilibrium", "profile_cache", "");
+  PARTHENON_REQUIRE_THROWS(cache_basename_.empty() || shared_profiles_,
+                           "problem/cluster/hydrostatic_equilibrium/profile_cache "
+                           "requires shared_profiles = true");
+  // Largest distance of any point of the domain from the cluster center (at the origin)
+  Real r_max2 = 0.0;
+  for (const auto dir : {"1", "2", "3"}) {
+    const auto xmin = pin->GetReal("parthenon/mesh", std::string("x") + dir + "min");
+    const auto xmax = pin->GetReal("parthenon/mesh", std::string("x") + dir + "max");
+    r_max2 += std::pow(std::max(std::abs(xmin), std::abs(xmax)), 2);
+  }
+  r_max_ = std::sqrt(r_max2);
+  shared_profiles_data_ = std::make_shared<std::map<Real, Profile_t>>();
+
   // Test out the HSE sphere if requested
   const bool test_he_sphere = pin->GetOrAddBoolean(
       "problem/cluster/hydrostatic_equilibrium", "test_he_sphere", false);
@@ -145,10 +185,15 @@ HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::generate_P_rho
                     "No equidistant grid in x3dir");
   // Resolution of profile on this meshbock -- use 1/r_sampling_ of resolution
   // or 1/r_sampling_ of r_k, whichever is smaller
-  const Real dr =
-      std::min(std::min(coords.Dxc<1>(0), std::min(coords.Dxc<2>(0), coords.Dxc<3>(0))) /
-                   r_sampling_,
-               entropy_profile_.r_k_ / r_sampling_);
+  const Real dr = profile_dr(
+      std::min(coords.Dxc<1>(0), std::min(coords.Dxc<2>(0), coords.Dxc<3>(0))));
+
+  if (shared_profiles_) {
+    const auto &profile = shared_profile(dr);
+    const auto n_r = profile.first.extent(0);
+    return PRhoProfile<GravitationalField, EntropyProfile>(
+        profile.first, profile.second, 0.0, (n_r - 1) * dr, *this);
+  }
 
   // Loop through mesh for minimum and maximum radius
   // Make sure to include R_fix_
@@ -187,22 +232,36 @@ PRhoProfile<GravitationalField, EntropyProfile>
 HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::generate_P_rho_profile(
     const Real r_start, const Real r_end, const unsigned int n_r) const {
 
+  std::vector<Real> r, p;
+  integrate_P(r_start, r_end, n_r, r, p);
+
+  return PRhoProfile<GravitationalField, EntropyProfile>(
+      ToDevice("PRhoProfile r", r), ToDevice("PRhoProfile p", p), r[0], r[n_r - 1],
+      *this);
+}
+
+/************************************************************
+ * HydrostaticEquilibriumSphere::integrate_P
+ ************************************************************/
+template <typename GravitationalField, typename EntropyProfile>
+void HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::integrate_P(
+    const Real r_start, const Real r_end, const unsigned int n_r, std::vector<Real> &r,
+    std::vector<Real> &p) const {
+
   // Array of radii along which to compute the profile
-  ParArray1D<parthenon::Real> device_r("PRhoProfile r", n_r);
-  auto r = Kokkos::create_mirror_view(device_r);
+  r.resize(n_r);
   const Real dr = (r_end - r_start) / (n_r - 1.0);
 
   // Use a linear R - possibly adapt if using a mesh with logrithmic r
   for (int i = 0; i < n_r; i++) {
-    r(i) = r_start + i * dr;
+    r[i] = r_start + i * dr;
   }
 
   /************************************************************
    * Integrate Pressure inward and outward from virial radius
    ************************************************************/
   // Create array for pressure
-  ParArray1D<parthenon::Real> device_p("PRhoProfile p", n_r);
-  auto p = Kokkos::create_mirror_view(device_p);
+  p.resize(n_r);
 
   const Real k_fix = entropy_profile_.K_from_r(r_fix_);
   const Real p_fix = P_from_rho_K(rho_fix_, k_fix);
@@ -213,14 +272,14 @@ HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::generate_P_rho
 
   // Find the index in R right before R_fix_
   int i_fix = static_cast<int>(floor((n_r - 1) / (r_end - r_start) * (r_fix_ - r_start)));
-  if (r_fix_ < r(i_fix) - kRTol || r_fix_ > r(i_fix + 1) + kRTol) {
+  if (r_fix_ < r[i_fix] - kRTol || r_fix_ > r[i_fix + 1] + kRTol) {
     std::stringstream msg;
     msg << "### FATAL ERROR in function "
            "[HydrostaticEquilibriumSphere::generate_P_rho_profile]"
         << std::endl
         << "r(i_fix) to r_(i_fix+1) does not contain r_fix_" << std::endl
-        << "r(i_fix) r_fix_ r(i_fix+1):" << r(i_fix) << " " << r_fix_ << " "
-        << r(i_fix + 1) << std::endl;
+        << "r(i_fix) r_fix_ r(i_fix+1):" << r[i_fix] << " " << r_fix_ << " "
+        << r[i_fix + 1] << std::endl;
     PARTHENON_FAIL(msg);
   }
 
@@ -228,9 +287,9 @@ HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::generate_P_rho
 
   // Make is the i right before R_fix_
   for (int i = i_fix + 1; i > 0; i--) { // Move is up one, to account for initial R_fix_
-    p(i - 1) = step_rk4(r_i, r(i - 1), p_i, dP_dr_from_r_P);
-    r_i = r(i - 1);
-    p_i = p(i - 1);
+    p[i - 1] = step_rk4(r_i, r[i - 1], p_i, dP_dr_from_r_P);
+    r_i = r[i - 1];
+    p_i = p[i - 1];
   }
 
   // Integrate P outward from R_fix_
@@ -240,16 +299,157 @@ HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::generate_P_rho
   // Make is the i right after R_fix_
   for (int i = i_fix; i < n_r - 1;
        i++) { // Move is back one, to account for initial R_fix_
-    p(i + 1) = step_rk4(r_i, r(i + 1), p_i, dP_dr_from_r_P);
-    r_i = r(i + 1);
-    p_i = p(i + 1);
+    p[i + 1] = step_rk4(r_i, r[i + 1], p_i, dP_dr_from_r_P);
+    r_i = r[i + 1];
+    p_i = p[i + 1];
+  }
+}
+
+/************************************************************
+ * HydrostaticEquilibriumSphere::profile_dr
+ ************************************************************/
+template <typename GravitationalField, typename EntropyProfile>
+Real HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::profile_dr(
+    const Real dx) const {
+  return std::min(dx / r_sampling_, entropy_profile_.r_k_ / r_sampling_);
+}
+
+/************************************************************
+ * HydrostaticEquilibriumSphere::shared_n_r
+ ************************************************************/
+template <typename GravitationalField, typename EntropyProfile>
+unsigned int HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::shared_n_r(
+    const Real dr) const {
+  // Same room beyond the domain (and r_fix_) as for profiles per block
+  const Real r_end = std::max(r_max_, r_fix_) + r_sampling_ * dr;
+  return static_cast<unsigned int>(ceil(r_end / dr)) + 1;
+}
+
+/************************************************************
+ * HydrostaticEquilibriumSphere::shared_profile
+ ************************************************************/
+template <typename GravitationalField, typename EntropyProfile>
+const typename HydrostaticEquilibriumSphere<GravitationalField,
+                                            EntropyProfile>::Profile_t &
+HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::shared_profile(
+    const Real dr) const {
+  // Spacings of identical levels may differ by round-off
+  for (const auto &[dr_shared, profile] : *shared_profiles_data_) {
+    if (std::abs(dr_shared - dr) <= 1e-10 * dr) {
+      return profile;
+    }
   }
+  // Not prepared (e.g., on a refinement level not present during preparation)
+  const auto n_r = shared_n_r(dr);
+  std::vector<Real> r, p;
+  integrate_P(0.0, (n_r - 1) * dr, n_r, r, p);
+  return (*shared_profiles_data_)[dr] =
+             Profile_t(ToDevice("PRhoProfile r", r), ToDevice("PRhoProfile p", p));
+}
 
-  Kokkos::deep_copy(device_r, r);
-  Kokkos::deep_copy(device_p, p);
+/************************************************************
+ * HydrostaticEquilibriumSphere::cache_key
+ ************************************************************/
+template <typename GravitationalField, typename EntropyProfile>
+std::uint64_t HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::cache_key(
+    const Real dr) const {
+  std::uint64_t key = sizeof(Real);
+  auto add = [&key](const Real value) {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(Real));
+    key = utils::random::Hash(key, bits);
+  };
+  for (const auto value :
+       {mh_, k_boltzmann_, r_fix_, rho_fix_, mu_, mu_e_, r_sampling_, r_max_, dr}) {
+    add(value);
+  }
+  // The gravitational field and entropy profile are (only) identified by samples
+  for (int n = 0; n < 64; n++) {
+    const Real r = r_max_ * std::pow(2.0, -0.5 * n);
+    add(gravitational_field_.g_from_r(r));
+    add(entropy_profile_.K_from_r(r));
+  }
+  return key;
+}
+
+/************************************************************
+ * HydrostaticEquilibriumSphere::prepare_shared_profiles
+ ************************************************************/
+template <typename GravitationalField, typename EntropyProfile>
+void HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::
+    prepare_shared_profiles(MeshData<Real> *md) const {
+  if (!shared_profiles_) {
+    return;
+  }
+  auto pm = md->GetParentPointer();
+  const int root_level = pm->GetRootLevel();
+  int max_level = root_level;
+  for (int b = 0; b < md->NumBlocks(); b++) {
+    max_level = std::max(max_level, md->GetBlockData(b)->GetBlockPointer()->loc.level());
+  }
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(
+      MPI_Allreduce(MPI_IN_PLACE, &max_level, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD));
+#endif // MPI_PARALLEL
+
+  Real dx_root = std::numeric_limits<Real>::max();
+  for (const auto dir : {X1DIR, X2DIR, X3DIR}) {
+    dx_root = std::min(dx_root, (pm->mesh_size.xmax(dir) - pm->mesh_size.xmin(dir)) /
+                                    pm->mesh_size.nx(dir));
+  }
 
-  return PRhoProfile<GravitationalField, EntropyProfile>(device_r, device_p, r(0),
-                                                         r(n_r - 1), *this);
+  for (int level = root_level; level <= max_level; level++) {
+    const Real dr = profile_dr(std::ldexp(dx_root, root_level - level));
+    bool prepared = false;
+    for (const auto &entry : *shared_profiles_data_) {
+      prepared = prepared || std::abs(entry.first - dr) <= 1e-10 * dr;
+    }
+    if (prepared) {
+      continue;
+    }
+    const auto n_r = shared_n_r(dr);
+    std::vector<Real> r(n_r), p(n_r);
+    for (int i = 0; i < n_r; i++) {
+      r[i] = i * dr;
+    }
+    if (Globals::my_rank == 0) {
+      const auto key = cache_key(dr);
+      std::stringstream filename;
+      filename << cache_basename_ << "." << std::hex << std::setw(16) << std::setfill('0')
+               << key << ".bin";
+      bool cached = false;
+      if (!cache_basename_.empty()) {
+        std::ifstream infile(filename.str(), std::ios::binary);
+        std::uint64_t file_key = 0, file_n_r = 0;
+        infile.read(reinterpret_cast<char *>(&file_key), sizeof(file_key));
+        infile.read(reinterpret_cast<char *>(&file_n_r), sizeof(file_n_r));
+        if (infile.good() && file_key == key && file_n_r == n_r) {
+          infile.read(reinterpret_cast<char *>(p.data()), n_r * sizeof(Real));
+          cached = infile.good();
+        }
+      }
+      if (!cached) {
+        integrate_P(0.0, (n_r - 1) * dr, n_r, r, p);
+        if (!cache_basename_.empty()) {
+          std::ofstream outfile(filename.str(), std::ios::binary | std::ios::trunc);
+          const std::uint64_t file_n_r = n_r;
+          outfile.write(reinterpret_cast<const char *>(&key), sizeof(key));
+          outfile.write(reinterpret_cast<const char *>(&file_n_r), sizeof(file_n_r));
+          outfile.write(reinterpret_cast<const char *>(p.data()), n_r * sizeof(Real));
+          if (!outfile.good()) {
+            PARTHENON_WARN("Could not write hydrostatic profile cache " +
+                           filename.str());
+          }
+        }
+      }
+    }
+#ifdef MPI_PARALLEL
+    PARTHENON_MPI_CHECK(
+        MPI_Bcast(p.data(), n_r, MPI_PARTHENON_REAL, 0, MPI_COMM_WORLD));
+#endif // MPI_PARALLEL
+    (*shared_profiles_data_)[dr] =
+        Profile_t(ToDevice("PRhoProfile r", r), ToDevice("PRhoProfile p", p));
+  }
 }
 
 // Instantiate HydrostaticEquilibriumSphere
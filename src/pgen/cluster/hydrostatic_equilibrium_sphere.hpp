@@ -8,9 +8,18 @@
 //! \file hydrostatic_equilbirum_sphere
 //  \brief Class for initializing a sphere in hydrostatic equiblibrium
 
+// C++ headers
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 // Parthenon headers
 #include <mesh/domain.hpp>
 #include <parameter_input.hpp>
+#include <parthenon/package.hpp>
 
 // AthenaPK headers
 #include "../../units.hpp"
@@ -49,6 +58,23 @@ class HydrostaticEquilibriumSphere {
   // R mesh sampling parameter
   parthenon::Real r_sampling_;
 
+  // With shared profiles, a single profile from r = 0 to r_max_ (covering the entire
+  // domain) is integrated per radial spacing (i.e., refinement level) and shared by all
+  // blocks (and copies of this object) instead of integrating a profile per block.
+  // Profiles are keyed by their radial spacing.
+  bool shared_profiles_;
+  parthenon::Real r_max_;
+  // Shared profiles are optionally read from/written to <cache_basename_>.<key>.bin
+  std::string cache_basename_;
+  using Profile_t = std::pair<parthenon::ParArray1D<parthenon::Real>,
+                              parthenon::ParArray1D<parthenon::Real>>; // r and P
+  std::shared_ptr<std::map<parthenon::Real, Profile_t>> shared_profiles_data_;
+
+  // Shared profile with spacing dr (integrated locally if not prepared)
+  const Profile_t &shared_profile(const parthenon::Real dr) const;
+  // Number of radii of a shared profile with spacing dr
+  unsigned int shared_n_r(const parthenon::Real dr) const;
+
   /************************************************************
    * Functions to build the cluster model
    *
@@ -130,6 +156,18 @@ class HydrostaticEquilibriumSphere {
 
   static constexpr parthenon::Real kRTol = 1e-15;
 
+  // Radial spacing of the profile for a mesh with cell size dx
+  parthenon::Real profile_dr(const parthenon::Real dx) const;
+
+  // Integrates the pressure on the host at the n_r radii r_start + i * dr
+  void integrate_P(const parthenon::Real r_start, const parthenon::Real r_end,
+                   const unsigned int n_r, std::vector<parthenon::Real> &r,
+                   std::vector<parthenon::Real> &p) const;
+
+  // Identifies a shared profile with spacing dr (from all parameters of the profile and
+  // samples of the gravitational field and entropy profile)
+  std::uint64_t cache_key(const parthenon::Real dr) const;
+
  public:
   HydrostaticEquilibriumSphere(parthenon::ParameterInput *pin,
                                parthenon::StateDescriptor *hydro_pkg,
@@ -145,6 +183,10 @@ class HydrostaticEquilibriumSphere {
   generate_P_rho_profile(const parthenon::Real r_start, const parthenon::Real r_end,
                          const unsigned int n_R) const;
 
+  // Integrates (or reads from the cache) the shared profiles for all refinement levels
+  // in use on rank 0 and broadcasts them. Must be called by all ranks.
+  void prepare_shared_profiles(parthenon::MeshData<parthenon::Real> *md) const;
+
   template <typename GF, typename EP>
   friend class PRhoProfile;
 };
@@ -158,6 +200,8 @@ class PRhoProfile {
 
   const int n_r_;
   const parthenon::Real r_start_, r_end_;
+  // Inverse spacing of the (equidistant) radii for the direct lookup of the bin of r
+  const parthenon::Real inv_dr_;
 
  public:
   PRhoProfile(
@@ -166,12 +210,11 @@ class PRhoProfile {
       const parthenon::Real r_end,
       const HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile> &sphere)
       : r_(r), p_(p), sphere_(sphere), n_r_(r_.extent(0)), r_start_(r_start),
-        r_end_(r_end) {}
+        r_end_(r_end), inv_dr_((n_r_ - 1) / (r_end - r_start)) {}
 
   KOKKOS_INLINE_FUNCTION parthenon::Real P_from_r(const parthenon::Real r) const {
     // Determine indices in R bounding r
-    const int i_r =
-        static_cast<int>(floor((n_r_ - 1) / (r_end_ - r_start_) * (r - r_start_)));
+    const int i_r = static_cast<int>(floor(inv_dr_ * (r - r_start_)));
 
     if (r < r_(i_r) - sphere_.kRTol || r > r_(i_r + 1) + sphere_.kRTol) {
       Kokkos::abort("PRhoProfile::P_from_r R(i_r) to R_(i_r+1) does not contain r");
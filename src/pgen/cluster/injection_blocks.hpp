@@ -0,0 +1,165 @@
+#ifndef CLUSTER_INJECTION_BLOCKS_HPP_
+#define CLUSTER_INJECTION_BLOCKS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file injection_blocks.hpp
+//  \brief Cache of the blocks intersecting the AGN feedback injection regions
+//
+// The AGN feedback (thermal sphere and kinetic jet) and the magnetic tower only modify a
+// small region around the cluster center. With problem/cluster/agn_feedback/cull_blocks
+// their kernels are only launched over the blocks whose bounding boxes intersect that
+// region. The list of blocks of a MeshData is only recomputed after the blocks of the
+// MeshData changed (i.e., after a remesh) or the jet axis moved.
+
+// C++ headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parthenon headers
+#include <basic_types.hpp>
+#include <mesh/mesh.hpp>
+#include <parthenon/package.hpp>
+
+#include "jet_coords.hpp"
+
+namespace cluster {
+
+// Conservative bounding sphere of a block (incl. one layer of ghost cells) with its
+// center given in jet cylindrical coordinates
+struct BlockBoundingSphere {
+  // Distance of the center to the origin and radius of the sphere
+  parthenon::Real d, radius;
+  // Position of the center in jet cylindrical coordinates
+  parthenon::Real r_jet, h_jet;
+
+  // Whether the sphere intersects the sphere of the given radius around the origin
+  bool IntersectsSphere(const parthenon::Real r_sphere) const {
+    return d - radius <= r_sphere;
+  }
+  // Whether the sphere intersects the (two sided) jet cylinder of the given radius
+  // between offset and offset + thickness above and below the jet disk
+  bool IntersectsJet(const parthenon::Real r_cyl, const parthenon::Real offset,
+                     const parthenon::Real thickness) const {
+    return r_jet - radius <= r_cyl && std::abs(h_jet) + radius >= offset &&
+           std::abs(h_jet) - radius <= offset + thickness;
+  }
+};
+
+class InjectionBlocks {
+ public:
+  InjectionBlocks() : cache_(std::make_shared<Cache>()) {}
+
+  // Bounding sphere of the given block for the jet coordinates
+  static BlockBoundingSphere BoundingSphere(const parthenon::MeshBlock *pmb,
+                                            const JetCoords &jet_coords) {
+    using parthenon::Real;
+    const auto &bs = pmb->block_size;
+    Real center[3], radius2 = 0.0, d2 = 0.0;
+    for (int d = 0; d < 3; d++) {
+      const auto dir = static_cast<parthenon::CoordinateDirection>(d + 1);
+      const Real width = bs.xmax(dir) - bs.xmin(dir);
+      center[d] = 0.5 * (bs.xmin(dir) + bs.xmax(dir));
+      const Real half_width = 0.5 * width + width / bs.nx(dir);
+      radius2 += half_width * half_width;
+      d2 += center[d] * center[d];
+    }
+    BlockBoundingSphere sphere;
+    sphere.d = std::sqrt(d2);
+    sphere.radius = std::sqrt(radius2);
+    Real cos_theta, sin_theta;
+    jet_coords.SimCartToJetCylCoords(center[0], center[1], center[2], sphere.r_jet,
+                                     cos_theta, sin_theta, sphere.h_jet);
+    return sphere;
+  }
+
+  // Returns the indices (within md) of the blocks of md for which
+  // intersects(BlockBoundingSphere) is true (or of all blocks if cull is false) and
+  // their number. Different regions in the same MeshData are distinguished by name.
+  template <typename Intersects>
+  std::pair<parthenon::ParArray1D<int>, int>
+  Get(parthenon::MeshData<parthenon::Real> *md, const std::string &region,
+      const JetCoords &jet_coords, const bool cull, const Intersects &intersects) const {
+    using parthenon::Real;
+    const int nblocks = md->NumBlocks();
+    const int ncycle = md->GetParentPointer()->ncycle;
+    std::vector<Location_t> locs(nblocks);
+    for (int b = 0; b < nblocks; b++) {
+      const auto &loc = md->GetBlockData(b)->GetBlockPointer()->loc;
+      locs[b] = {loc.level(), loc.lx1(), loc.lx2(), loc.lx3()};
+    }
+
+    // Partitions may be processed concurrently
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    const Key_t key(region, md);
+    auto it = cache_->entries.find(key);
+    if (it != cache_->entries.end() && it->second.locs == locs &&
+        it->second.cull == cull && (!cull || it->second.jet_coords == jet_coords)) {
+      it->second.last_used = ncycle;
+      return {it->second.blocks, it->second.nblocks};
+    }
+
+    std::vector<int> blocks;
+    for (int b = 0; b < nblocks; b++) {
+      const auto *pmb = md->GetBlockData(b)->GetBlockPointer();
+      if (cull && !intersects(BoundingSphere(pmb, jet_coords))) {
+        continue;
+      }
+      blocks.push_back(b);
+    }
+
+    parthenon::ParArray1D<int> blocks_d("Cluster::InjectionBlocks::blocks",
+                                        std::max<int>(blocks.size(), 1));
+    auto blocks_h = Kokkos::create_mirror_view(blocks_d);
+    for (std::size_t n = 0; n < blocks.size(); n++) {
+      blocks_h(n) = blocks[n];
+    }
+    Kokkos::deep_copy(blocks_d, blocks_h);
+
+    // Entries of MeshData that have not been used in the previous cycle no longer exist
+    for (auto jt = cache_->entries.begin(); jt != cache_->entries.end();) {
+      if (jt->second.last_used < ncycle - 1) {
+        jt = cache_->entries.erase(jt);
+      } else {
+        ++jt;
+      }
+    }
+    cache_->entries.erase(key);
+    cache_->entries.emplace(key, Entry{locs, cull, jet_coords, blocks_d,
+                                       static_cast<int>(blocks.size()), ncycle});
+    return {blocks_d, static_cast<int>(blocks.size())};
+  }
+
+ private:
+  // Logical location (level, lx1, lx2, lx3) of a block
+  using Location_t = std::array<std::int64_t, 4>;
+  struct Entry {
+    std::vector<Location_t> locs;
+    bool cull;
+    JetCoords jet_coords;
+    parthenon::ParArray1D<int> blocks;
+    int nblocks;
+    int last_used;
+  };
+  using Key_t = std::pair<std::string, const parthenon::MeshData<parthenon::Real> *>;
+  struct Cache {
+    std::mutex mutex;
+    std::map<Key_t, Entry> entries;
+  };
+  // Shared by all copies (e.g., the one stored in the Params)
+  std::shared_ptr<Cache> cache_;
+};
+
+} // namespace cluster
+
+#endif // CLUSTER_INJECTION_BLOCKS_HPP_
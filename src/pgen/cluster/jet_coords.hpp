@@ -36,6 +36,14 @@ class JetCoords {
         sin_theta_jet_axis_(sin(theta_jet_axis)), cos_phi_jet_axis_(cos(phi_jet_axis)),
         sin_phi_jet_axis_(sin(phi_jet_axis)) {}
 
+  // Whether both objects describe the same jet axis
+  bool operator==(const JetCoords &other) const {
+    return cos_theta_jet_axis_ == other.cos_theta_jet_axis_ &&
+           sin_theta_jet_axis_ == other.sin_theta_jet_axis_ &&
+           cos_phi_jet_axis_ == other.cos_phi_jet_axis_ &&
+           sin_phi_jet_axis_ == other.sin_phi_jet_axis_;
+  }
+
   // Convert simulation cartesian coordinates to jet cylindrical coordinates
   KOKKOS_INLINE_FUNCTION void
   SimCartToJetCylCoords(const parthenon::Real x_sim, const parthenon::Real y_sim,
@@ -19,6 +19,8 @@
 #include "../../eos/adiabatic_glmmhd.hpp"
 #include "../../main.hpp"
 #include "../../units.hpp"
+#include "../../utils/global_reductions.hpp"
+#include "../../utils/shared_params.hpp"
 #include "cluster_utils.hpp"
 #include "magnetic_tower.hpp"
 #include "utils/error_checking.hpp"
@@ -79,12 +81,16 @@ void MagneticTower::AddSrcTerm(parthenon::Real field_to_add, parthenon::Real mas
   a_kb.s -= 1;
   a_kb.e += 1;
 
+  const auto tower_blocks = GetTowerBlocks(md, jet_coords);
+  const auto block_idx = tower_blocks.first;
+  const int nblocks = tower_blocks.second;
+
   // Construct the magnetic tower potential
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "MagneticTower::AddFieldSrcTerm::ConstructPotential",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, a_kb.s, a_kb.e, a_jb.s,
-      a_jb.e, a_ib.s, a_ib.e,
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+      DEFAULT_LOOP_PATTERN, "Cluster::MagneticTower::AddSrcTerm::ConstructPotential",
+      parthenon::DevExecSpace(), 0, nblocks - 1, a_kb.s, a_kb.e, a_jb.s, a_jb.e, a_ib.s,
+      a_ib.e, KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i) {
+        const int b = block_idx(n);
         // Compute and apply potential
         auto &A = A_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -100,9 +106,10 @@ void MagneticTower::AddSrcTerm(parthenon::Real field_to_add, parthenon::Real mas
 
   // Take the curl of the potential and apply the new magnetic field
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "MagneticTower::MagneticFieldSrcTerm::ApplyPotential",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+      DEFAULT_LOOP_PATTERN, "Cluster::MagneticTower::AddSrcTerm::ApplyPotential",
+      parthenon::DevExecSpace(), 0, nblocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i) {
+        const int b = block_idx(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         auto &A = A_pack(b);
@@ -167,17 +174,24 @@ void MagneticTower::ReducePowerContribs(parthenon::Real &linear_contrib,
   const MagneticTowerObj mt = MagneticTowerObj(1, alpha_, l_scale_, offset_, thickness_,
                                                0, l_mass_scale_, jet_coords, potential_);
 
+  const auto tower_blocks = GetTowerBlocks(md, jet_coords);
+  const auto block_idx = tower_blocks.first;
+  const int nblocks = tower_blocks.second;
+  if (nblocks == 0) {
+    return; // No contributions
+  }
+
   // Get the reduction of the linear and quadratic contributions ready
   Real linear_contrib_red, quadratic_contrib_red;
 
   Kokkos::parallel_reduce(
-      "MagneticTowerScaleFactor",
-      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-          DevExecSpace(), {0, kb.s, jb.s, ib.s},
-          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-          {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
+      "Cluster::MagneticTower::ReducePowerContribs",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(DevExecSpace(), {0, kb.s, jb.s, ib.s},
+                                             {nblocks, kb.e + 1, jb.e + 1, ib.e + 1},
+                                             {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i,
                     Real &llinear_contrib_red, Real &lquadratic_contrib_red) {
+        const int b = block_idx(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -201,6 +215,23 @@ void MagneticTower::ReducePowerContribs(parthenon::Real &linear_contrib,
   quadratic_contrib += quadratic_contrib_red;
 }
 
+std::pair<parthenon::ParArray1D<int>, int>
+MagneticTower::GetTowerBlocks(parthenon::MeshData<parthenon::Real> *md,
+                              const JetCoords &jet_coords) const {
+  // The profiles are Gaussians so that the region is cut at cull_extent_ scale lengths
+  const bool cull = cull_blocks_ && potential_ != MagneticTowerPotential::undefined;
+  const Real field_extent = cull_extent_ * l_scale_;
+  const Real mass_extent = cull_extent_ * l_mass_scale_;
+  return injection_blocks_.Get(
+      md, "magnetic_tower", jet_coords, cull, [&](const BlockBoundingSphere &sphere) {
+        const bool field =
+            potential_ == MagneticTowerPotential::li
+                ? sphere.IntersectsSphere(field_extent)
+                : sphere.IntersectsJet(field_extent, offset_, thickness_);
+        return field || (l_mass_scale_ > 0 && sphere.IntersectsSphere(mass_extent));
+      });
+}
+
 // Add magnetic potential to provided potential
 template <typename View4D>
 void MagneticTower::AddInitialFieldToPotential(parthenon::MeshBlock *pmb,
@@ -221,7 +252,7 @@ void MagneticTower::AddInitialFieldToPotential(parthenon::MeshBlock *pmb,
                             l_mass_scale_, jet_coords, potential_);
 
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "MagneticTower::AddInitialFieldToPotential",
+      DEFAULT_LOOP_PATTERN, "Cluster::MagneticTower::AddInitialFieldToPotential",
       parthenon::DevExecSpace(), kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int &k, const int &j, const int &i) {
         // Compute and apply potential
@@ -305,14 +336,37 @@ MagneticTowerReducePowerContribs(parthenon::MeshData<parthenon::Real> *md,
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   const auto &magnetic_tower = hydro_pkg->Param<MagneticTower>("magnetic_tower");
 
-  parthenon::Real linear_contrib =
-      hydro_pkg->Param<parthenon::Real>("magnetic_tower_linear_contrib");
-  parthenon::Real quadratic_contrib =
-      hydro_pkg->Param<parthenon::Real>("magnetic_tower_quadratic_contrib");
+  // Contributions of this partition (partitions may be reduced concurrently)
+  parthenon::Real linear_contrib = 0.0;
+  parthenon::Real quadratic_contrib = 0.0;
   magnetic_tower.ReducePowerContribs(linear_contrib, quadratic_contrib, md, tm);
 
-  hydro_pkg->UpdateParam("magnetic_tower_linear_contrib", linear_contrib);
-  hydro_pkg->UpdateParam("magnetic_tower_quadratic_contrib", quadratic_contrib);
+  utils::shared_params::UpdateSum(hydro_pkg.get(), "magnetic_tower_linear_contrib",
+                                  linear_contrib);
+  utils::shared_params::UpdateSum(hydro_pkg.get(), "magnetic_tower_quadratic_contrib",
+                                  quadratic_contrib);
+  return TaskStatus::complete;
+}
+
+parthenon::TaskStatus
+MagneticTowerSetLocalReductions(parthenon::StateDescriptor *hydro_pkg) {
+  auto *reductions =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+  for (const auto &name :
+       {"magnetic_tower_linear_contrib", "magnetic_tower_quadratic_contrib"}) {
+    reductions->SetLocal(name, hydro_pkg->Param<parthenon::Real>(name));
+  }
+  return TaskStatus::complete;
+}
+
+parthenon::TaskStatus
+MagneticTowerGetGlobalReductions(parthenon::StateDescriptor *hydro_pkg) {
+  const auto &reductions =
+      hydro_pkg->Param<utils::GlobalReductions>("global_reductions");
+  for (const auto &name :
+       {"magnetic_tower_linear_contrib", "magnetic_tower_quadratic_contrib"}) {
+    hydro_pkg->UpdateParam(name, reductions.Get(name));
+  }
   return TaskStatus::complete;
 }
 
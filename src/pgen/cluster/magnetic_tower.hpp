@@ -16,6 +16,7 @@
 #include <parameter_input.hpp>
 #include <parthenon/package.hpp>
 
+#include "injection_blocks.hpp"
 #include "jet_coords.hpp"
 #include "utils/error_checking.hpp"
 
@@ -175,6 +176,12 @@ class MagneticTower {
 
   MagneticTowerPotential potential_;
 
+  // Only launch the kernels over blocks within cull_extent_ times l_scale_ (and
+  // l_mass_scale_) of the tower
+  const bool cull_blocks_;
+  const parthenon::Real cull_extent_;
+  InjectionBlocks injection_blocks_;
+
   MagneticTower(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg,
                 const std::string &block = "problem/cluster/magnetic_tower")
       : alpha_(pin->GetOrAddReal(block, "li_alpha", 0)),
@@ -185,7 +192,10 @@ class MagneticTower {
         fixed_field_rate_(pin->GetOrAddReal(block, "fixed_field_rate", 0)),
         fixed_mass_rate_(pin->GetOrAddReal(block, "fixed_mass_rate", 0)),
         l_mass_scale_(pin->GetOrAddReal(block, "l_mass_scale", 0)),
-        potential_(MagneticTowerPotential::undefined) {
+        potential_(MagneticTowerPotential::undefined),
+        cull_blocks_(
+            pin->GetOrAddBoolean("problem/cluster/agn_feedback", "cull_blocks", false)),
+        cull_extent_(pin->GetOrAddReal(block, "cull_extent", 6.0)) {
     hydro_pkg->AddParam<parthenon::Real>("magnetic_tower_linear_contrib", 0.0, true);
     hydro_pkg->AddParam<parthenon::Real>("magnetic_tower_quadratic_contrib", 0.0, true);
 
@@ -205,6 +215,8 @@ class MagneticTower {
                                "Please disable (set to zero) tower offset and thickness "
                                "for the Li tower model");
     }
+    PARTHENON_REQUIRE_THROWS(!cull_blocks_ || cull_extent_ > 0.0,
+                             "Magnetic tower cull_extent must be positive");
 
     // Vector potential is only locally used, so no need to
     // communicate/restrict/prolongate/fluxes/etc
@@ -251,6 +263,12 @@ class MagneticTower {
                            parthenon::MeshData<parthenon::Real> *md,
                            const parthenon::SimTime &tm) const;
 
+  // Returns the indices (within md) of the blocks intersecting the tower (or of all
+  // blocks if culling is disabled) and their number
+  std::pair<parthenon::ParArray1D<int>, int>
+  GetTowerBlocks(parthenon::MeshData<parthenon::Real> *md,
+                 const JetCoords &jet_coords) const;
+
   friend parthenon::TaskStatus
   MagneticTowerResetPowerContribs(parthenon::StateDescriptor *hydro_pkg);
 
@@ -264,6 +282,12 @@ MagneticTowerResetPowerContribs(parthenon::StateDescriptor *hydro_pkg);
 parthenon::TaskStatus
 MagneticTowerReducePowerContribs(parthenon::MeshData<parthenon::Real> *md,
                                  const parthenon::SimTime &tm);
+// Sets the local power contributions in/gets the global ones from the "cluster" phase
+// of the global reductions
+parthenon::TaskStatus
+MagneticTowerSetLocalReductions(parthenon::StateDescriptor *hydro_pkg);
+parthenon::TaskStatus
+MagneticTowerGetGlobalReductions(parthenon::StateDescriptor *hydro_pkg);
 
 } // namespace cluster
 
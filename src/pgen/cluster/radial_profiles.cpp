@@ -0,0 +1,235 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file radial_profiles.cpp
+//  \brief In-situ spherically averaged profiles around the cluster center
+
+// C++ headers
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <kokkos_abstraction.hpp>
+#include <mesh/domain.hpp>
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <parthenon/package.hpp>
+#include <utils/error_checking.hpp>
+
+// AthenaPK headers
+#include "../../hydro/srcterms/tabular_cooling.hpp"
+#include "../../main.hpp"
+#include "../../units.hpp"
+#include "../../utils/profiling.hpp"
+#include "radial_profiles.hpp"
+
+namespace cluster {
+using namespace parthenon;
+
+RadialProfiles::RadialProfiles(parthenon::ParameterInput *pin,
+                               parthenon::StateDescriptor *hydro_pkg)
+    : dt_(pin->GetOrAddReal("problem/cluster/profiles", "dt", -1.0)),
+      nbins_(pin->GetOrAddInteger("problem/cluster/profiles", "nbins", 64)),
+      r_min_(0.0), r_max_(0.0),
+      filename_(pin->GetOrAddString("problem/cluster/profiles", "file",
+                                    "cluster.profiles")) {
+  if (IsEnabled()) {
+    r_min_ = pin->GetReal("problem/cluster/profiles", "r_min");
+    r_max_ = pin->GetReal("problem/cluster/profiles", "r_max");
+    PARTHENON_REQUIRE_THROWS(nbins_ > 0, "problem/cluster/profiles/nbins must be > 0");
+    PARTHENON_REQUIRE_THROWS(r_min_ > 0.0 && r_max_ > r_min_,
+                             "problem/cluster/profiles requires 0 < r_min < r_max");
+  }
+  hydro_pkg->AddParam<RadialProfiles>("radial_profiles", *this);
+  hydro_pkg->AddParam<>("radial_profiles_next_time", std::numeric_limits<Real>::lowest(),
+                        Params::Mutability::Mutable);
+}
+
+bool RadialProfiles::IsDue(const Real time, StateDescriptor *hydro_pkg) const {
+  return IsEnabled() && time >= hydro_pkg->Param<Real>("radial_profiles_next_time");
+}
+
+void RadialProfiles::Output(Mesh *pmesh, const SimTime &tm) const {
+  utils::profiling::ScopedRegion region("Cluster::RadialProfiles::Output");
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  const Real gam = hydro_pkg->Param<Real>("AdiabaticIndex");
+  const Real gm1 = gam - 1.0;
+  const auto units = hydro_pkg->Param<Units>("units");
+  const auto mbar_over_kb = hydro_pkg->Param<Real>("mbar_over_kb");
+  const auto mbar = mbar_over_kb * units.k_boltzmann();
+
+  // Only the table of the tabular cooling is captured (the param does not exist
+  // otherwise)
+  const bool with_cooling =
+      hydro_pkg->Param<Cooling>("enable_cooling") == Cooling::tabular;
+  cooling::CoolingTableObj cooling_table_obj;
+  if (with_cooling) {
+    cooling_table_obj =
+        hydro_pkg->Param<cooling::TabularCooling>("tabular_cooling").GetCoolingTableObj();
+  }
+
+  const int nbins = nbins_;
+  const Real log10_r_min = std::log10(r_min_);
+  const Real dlog10_r = (std::log10(r_max_) - log10_r_min) / nbins;
+  constexpr int nq = num_quantities;
+  const int nsums = nq * nbins;
+
+  // Sums of all blocks of the rank, bin major
+  ParArray1D<Real> sums("RadialProfiles::sums", nsums);
+
+  // Each team first accumulates the profiles of its block in scratch memory so that
+  // atomics to global memory are only required once per bin and block
+  const size_t scratch_size_in_bytes = ScratchPad1D<Real>::shmem_size(nsums);
+  const int scratch_level =
+      static_cast<int>(scratch_size_in_bytes) <=
+              Kokkos::TeamPolicy<DevExecSpace>::scratch_size_max(0)
+          ? 0
+          : 1;
+
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+    const auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+    const auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+    const auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+    const int ni = ib.e - ib.s + 1;
+    const int nj = jb.e - jb.s + 1;
+    const int ncells = (kb.e - kb.s + 1) * nj * ni;
+
+    par_for_outer(
+        DEFAULT_OUTER_LOOP_PATTERN, "Cluster::RadialProfiles", DevExecSpace(),
+        scratch_size_in_bytes, scratch_level, 0, prim_pack.GetDim(5) - 1,
+        KOKKOS_LAMBDA(team_mbr_t member, const int b) {
+          ScratchPad1D<Real> block_sums(member.team_scratch(scratch_level), nsums);
+          Kokkos::parallel_for(Kokkos::TeamThreadRange(member, nsums),
+                               [&](const int n) { block_sums(n) = 0.0; });
+          member.team_barrier();
+
+          const auto &prim = prim_pack(b);
+          const auto &coords = prim_pack.GetCoords(b);
+          Kokkos::parallel_for(Kokkos::TeamThreadRange(member, ncells), [&](const int n) {
+            const int k = kb.s + n / (nj * ni);
+            const int j = jb.s + (n / ni) % nj;
+            const int i = ib.s + n % ni;
+
+            const Real x = coords.Xc<1>(i);
+            const Real y = coords.Xc<2>(j);
+            const Real z = coords.Xc<3>(k);
+            const Real r = std::sqrt(SQR(x) + SQR(y) + SQR(z));
+            const int bin =
+                r > 0.0 ? static_cast<int>(std::floor((std::log10(r) - log10_r_min) /
+                                                      dlog10_r))
+                        : -1;
+            if (bin < 0 || bin >= nbins) {
+              return;
+            }
+
+            const Real rho = prim(IDN, k, j, i);
+            const Real P = prim(IPR, k, j, i);
+            const Real cell_volume = coords.CellVolume(k, j, i);
+            const Real cell_mass = rho * cell_volume;
+            const Real v_r = (prim(IV1, k, j, i) * x + prim(IV2, k, j, i) * y +
+                              prim(IV3, k, j, i) * z) /
+                             r;
+            const auto add = [&](const int q, const Real value) {
+              Kokkos::atomic_add(&block_sums(bin * nq + q), value);
+            };
+            add(volume, cell_volume);
+            add(mass, cell_mass);
+            add(mass_temperature, cell_mass * mbar_over_kb * P / rho);
+            add(mass_entropy, cell_mass * P / std::pow(rho / mbar, gam));
+            add(mass_v_r, cell_mass * v_r);
+            if (with_cooling) {
+              const Real eint = P / (rho * gm1);
+              const Real edot = cooling_table_obj.DeDt(eint, rho);
+              if (edot != 0.0) {
+                add(cooling_mass, cell_mass);
+                add(mass_cooling_time, -cell_mass * eint / edot);
+              }
+            }
+          });
+          member.team_barrier();
+
+          Kokkos::parallel_for(Kokkos::TeamThreadRange(member, nsums), [&](const int n) {
+            if (block_sums(n) != 0.0) {
+              Kokkos::atomic_add(&sums(n), block_sums(n));
+            }
+          });
+        });
+  }
+
+  auto sums_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), sums);
+#ifdef MPI_PARALLEL
+  // Single reduction of all bins of all quantities
+  PARTHENON_MPI_CHECK(MPI_Reduce(Globals::my_rank == 0 ? MPI_IN_PLACE : sums_h.data(),
+                                 sums_h.data(), nsums, MPI_PARTHENON_REAL, MPI_SUM, 0,
+                                 MPI_COMM_WORLD));
+#endif
+  if (Globals::my_rank != 0) {
+    return;
+  }
+
+  std::ifstream existing(filename_);
+  const bool write_header = (!pmesh->is_restart && tm.ncycle == 0) || !existing.good();
+  existing.close();
+  std::ofstream outfile(filename_, write_header ? std::ios::trunc : std::ios::app);
+  PARTHENON_REQUIRE_THROWS(outfile.good(), "Cannot open profiles file " + filename_);
+  outfile << std::scientific
+          << std::setprecision(std::numeric_limits<Real>::max_digits10);
+  if (write_header) {
+    outfile << "# cycle time quantity values in the " << nbins
+            << " bins of log10(r) with the edges of the \"r_edges\" line" << std::endl;
+    outfile << "# r_edges";
+    for (int n = 0; n <= nbins; n++) {
+      outfile << " " << std::pow(10.0, log10_r_min + n * dlog10_r);
+    }
+    outfile << std::endl;
+  }
+
+  // Volume, mass, and density of a bin, and mass weighted means of the other quantities
+  // (NaN for empty bins)
+  const auto write = [&](const std::string &name, const int q, const int weight) {
+    outfile << tm.ncycle << " " << tm.time << " " << name;
+    for (int n = 0; n < nbins; n++) {
+      const Real value = sums_h(n * nq + q);
+      if (weight < 0) {
+        outfile << " " << value;
+      } else {
+        const Real w = sums_h(n * nq + weight);
+        outfile << " " << (w > 0.0 ? value / w : std::numeric_limits<Real>::quiet_NaN());
+      }
+    }
+    outfile << std::endl;
+  };
+  write("volume", volume, -1);
+  write("mass", mass, -1);
+  write("density", mass, volume);
+  write("temperature", mass_temperature, mass);
+  write("entropy", mass_entropy, mass);
+  write("v_r", mass_v_r, mass);
+  if (with_cooling) {
+    write("cooling_time", mass_cooling_time, cooling_mass);
+  }
+}
+
+void OutputRadialProfiles(Mesh *pmesh, ParameterInput * /*pin*/, const SimTime &tm) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  const auto &profiles = hydro_pkg->Param<RadialProfiles>("radial_profiles");
+  if (!profiles.IsDue(tm.time, hydro_pkg.get())) {
+    return;
+  }
+  profiles.Output(pmesh, tm);
+  const auto dt = profiles.GetDt();
+  hydro_pkg->UpdateParam("radial_profiles_next_time",
+                         (std::floor(tm.time / dt) + 1.0) * dt);
+}
+
+} // namespace cluster
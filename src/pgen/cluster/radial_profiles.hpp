@@ -0,0 +1,64 @@
+#ifndef CLUSTER_RADIAL_PROFILES_HPP_
+#define CLUSTER_RADIAL_PROFILES_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file radial_profiles.hpp
+//  \brief In-situ spherically averaged profiles around the cluster center
+//
+// Every problem/cluster/profiles/dt, the volume, mass, and mass weighted temperature,
+// entropy, radial velocity, and (with tabular cooling) cooling time are binned in log
+// radius on device (per block in team scratch memory), summed over all ranks in a single
+// MPI reduction, and appended to a text file by rank 0.
+
+// C++ headers
+#include <string>
+
+// parthenon headers
+#include <basic_types.hpp>
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <parthenon/package.hpp>
+
+namespace cluster {
+
+class RadialProfiles {
+ public:
+  // Binned quantities (sums over the cells in a bin)
+  enum Quantity : int {
+    volume,
+    mass,
+    mass_temperature,
+    mass_entropy,
+    mass_v_r,
+    // Only cells with non-vanishing cooling contribute to the cooling time
+    cooling_mass,
+    mass_cooling_time,
+    num_quantities
+  };
+
+  RadialProfiles(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg);
+
+  bool IsEnabled() const { return dt_ > 0.0; }
+  parthenon::Real GetDt() const { return dt_; }
+  bool IsDue(const parthenon::Real time, parthenon::StateDescriptor *hydro_pkg) const;
+
+  // Reduces the profiles over all blocks (and ranks) and appends them to the file
+  void Output(parthenon::Mesh *pmesh, const parthenon::SimTime &tm) const;
+
+ private:
+  parthenon::Real dt_;
+  int nbins_;
+  parthenon::Real r_min_, r_max_;
+  std::string filename_;
+};
+
+// Writes the profiles if due (used as Hydro::ProblemPreStepMeshUserWork)
+void OutputRadialProfiles(parthenon::Mesh *pmesh, parthenon::ParameterInput *pin,
+                          const parthenon::SimTime &tm);
+
+} // namespace cluster
+
+#endif // CLUSTER_RADIAL_PROFILES_HPP_
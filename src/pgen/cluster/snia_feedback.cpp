@@ -41,12 +41,44 @@ SNIAFeedback::SNIAFeedback(parthenon::ParameterInput *pin,
   // Turn off the NFW and SMBH to get just the BCG gravity
   bcg_gravity_.include_nfw_g_ = false;
   bcg_gravity_.include_smbh_g_ = false;
+  // The table (if any) contains the full gravity (and only the density is used here)
+  bcg_gravity_.tabulated_ = false;
 
   PARTHENON_REQUIRE(disabled_ || bcg_gravity_.which_bcg_g_ != BCG::NONE,
                     "BCG must be defined for SNIA Feedback to be enabled");
+
+  if (IsActive()) {
+    // The BCG density is static and only (re)computed when blocks are created (see
+    // InitBCGDensity) so that it does not need to be communicated/prolongated/restricted
+    parthenon::Metadata m({parthenon::Metadata::Cell, parthenon::Metadata::Derived,
+                           parthenon::Metadata::OneCopy});
+    hydro_pkg->AddField("snia_bcg_density", m);
+  }
   hydro_pkg->AddParam<SNIAFeedback>("snia_feedback", *this);
 }
 
+void SNIAFeedback::InitBCGDensity(parthenon::MeshBlock *pmb) const {
+  if (!IsActive()) {
+    return;
+  }
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  auto &bcg_density = pmb->meshblock_data.Get()->Get("snia_bcg_density").data;
+  const auto &coords = pmb->coords;
+  const ClusterGravity bcg_gravity = bcg_gravity_;
+
+  pmb->par_for(
+      "Cluster::SNIAFeedback::InitBCGDensity", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &k, const int &j, const int &i) {
+        const Real x = coords.Xc<1>(i);
+        const Real y = coords.Xc<2>(j);
+        const Real z = coords.Xc<3>(k);
+        const Real r = sqrt(x * x + y * y + z * z);
+        bcg_density(k, j, i) = bcg_gravity.rho_from_r(r);
+      });
+}
+
 void SNIAFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
                                    const parthenon::Real beta_dt,
                                    const parthenon::SimTime &tm) const {
@@ -70,14 +102,18 @@ void SNIAFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
 
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
-  if ((power_per_bcg_mass_ == 0 && mass_rate_per_bcg_mass_ == 0) || disabled_) {
+  if (!IsActive()) {
     // No AGN feedback, return
     return;
   }
 
   // Grab some necessary variables
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  const auto &prim_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("prim_names"));
+  const auto &cons_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("cons_names"));
+  const auto &bcg_density_pack =
+      md->PackVariables(std::vector<std::string>{"snia_bcg_density"});
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
@@ -87,26 +123,18 @@ void SNIAFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
   const Real energy_per_bcg_mass = power_per_bcg_mass_ * beta_dt;
   const Real mass_per_bcg_mass = mass_rate_per_bcg_mass_ * beta_dt;
 
-  const ClusterGravity bcg_gravity = bcg_gravity_;
-
   ////////////////////////////////////////////////////////////////////////////////
 
   // Constant volumetric heating
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "SNIAFeedback::FeedbackSrcTerm", parthenon::DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      DEFAULT_LOOP_PATTERN, "Cluster::SNIAFeedback::FeedbackSrcTerm",
+      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e,
       KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
-        const auto &coords = cons_pack.GetCoords(b);
-
-        const Real x = coords.Xc<1>(i);
-        const Real y = coords.Xc<2>(j);
-        const Real z = coords.Xc<3>(k);
-
-        const Real r = sqrt(x * x + y * y + z * z);
 
-        const Real bcg_density = bcg_gravity.rho_from_r(r);
+        const Real bcg_density = bcg_density_pack(b, 0, k, j, i);
 
         const Real snia_energy_density = energy_per_bcg_mass * bcg_density;
         const Real snia_mass_density = mass_per_bcg_mass * bcg_density;
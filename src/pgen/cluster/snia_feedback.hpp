@@ -35,6 +35,13 @@ class SNIAFeedback {
 
   SNIAFeedback(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg);
 
+  bool IsActive() const {
+    return !disabled_ && (power_per_bcg_mass_ != 0 || mass_rate_per_bcg_mass_ != 0);
+  }
+
+  // Fill the (static) BCG density used as injection weight in the cells of a new block
+  void InitBCGDensity(parthenon::MeshBlock *pmb) const;
+
   void FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
                        const parthenon::Real beta_dt, const parthenon::SimTime &tm) const;
 
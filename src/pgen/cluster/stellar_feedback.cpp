@@ -21,6 +21,7 @@
 #include "../../eos/adiabatic_hydro.hpp"
 #include "../../main.hpp"
 #include "../../units.hpp"
+#include "../../utils/shared_params.hpp"
 #include "cluster_gravity.hpp"
 #include "cluster_utils.hpp"
 #include "stellar_feedback.hpp"
@@ -94,8 +95,10 @@ void StellarFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
   }
 
   // Grab some necessary variables
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  const auto &prim_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("prim_names"));
+  const auto &cons_pack =
+      md->PackVariables(hydro_pkg->Param<std::vector<std::string>>("cons_names"));
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
@@ -121,7 +124,7 @@ void StellarFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
 
   // Constant volumetric heating, reduce mass removed
   Kokkos::parallel_reduce(
-      "StellarFeedback::FeedbackSrcTerm",
+      "Cluster::StellarFeedback::FeedbackSrcTerm",
       Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
           DevExecSpace(), {0, kb.s, jb.s, ib.s},
           {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
@@ -169,8 +172,7 @@ void StellarFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
         eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
       },
       stellar_mass);
-  hydro_pkg->UpdateParam(
-      "stellar_mass", stellar_mass + hydro_pkg->Param<parthenon::Real>("stellar_mass"));
+  utils::shared_params::UpdateSum(hydro_pkg.get(), "stellar_mass", stellar_mass);
 }
 
 } // namespace cluster
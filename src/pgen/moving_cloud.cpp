@@ -20,8 +20,10 @@
 // #include <sstream>
 
 // AthenaPK headers
+#include "../bvals/boundary_conditions_apk.hpp"
 #include "../main.hpp" // Use of IDN indices and more
 #include "../units.hpp"
+#include "cloud_frame.hpp"
 
 namespace moving_cloud {
 // Easier access to classes like 'Mesh', 'ParameterInput' etc.
@@ -116,6 +118,23 @@ void InitUserMeshData(Mesh *mesh, ParameterInput *pin) {
   }
 };
 
+//----------------------------------------------------------------------------------------
+//! \fn void ProblemInitPackageData(ParameterInput *pin, StateDescriptor *pkg)
+//  \brief Optionally follows the cloud (moving along x1) in a Galilean frame, which
+//  initially moves with the cloud velocity
+
+void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg) {
+  const auto units = pkg->Param<Units>("units");
+  const Real velocity_cloud =
+      pin->GetReal("problem/moving_cloud", "velocity_cloud_km_s") * units.km_s();
+  cloud_frame::Initialize(pin, pkg, "problem/moving_cloud", X1DIR, velocity_cloud);
+  if (cloud_frame::IsEnabled(pkg)) {
+    PARTHENON_REQUIRE_THROWS(!pkg->Param<bool>("sparse_scalars"),
+                             "problem/moving_cloud/frame_tracking does not support "
+                             "hydro/sparse_scalars.");
+  }
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void MeshBlock::ProblemGenerator(ParameterInput *pin)
 //  \brief Problem Generator for the cloud in wind setup
@@ -136,6 +155,11 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
   const Real cloud_radius_factor =
       hydro_pkg->Param<Real>("moving_cloud/cloud_radius_factor");
   const Real steepness = hydro_pkg->Param<Real>("moving_cloud/cloud_steepness");
+  // With frame tracking, the setup starts in the rest frame of the cloud
+  const Real velocity_frame = cloud_frame::Velocity(hydro_pkg.get());
+  const auto nhydro = hydro_pkg->Param<int>("nhydro");
+  const auto nscalars = hydro_pkg->Param<int>("nscalars");
+  const auto sparse_scalars = hydro_pkg->Param<bool>("sparse_scalars");
 
   // initialize conserved variables
   auto &mbd = pmb->meshblock_data.Get();
@@ -161,7 +185,8 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
 
         // Same as above, but ambient = 0
         Real velocity =
-            0.5 * (velocity_cloud) * (1.0 - std::tanh(steepness * (rad_cl - 1.0)));
+            0.5 * (velocity_cloud) * (1.0 - std::tanh(steepness * (rad_cl - 1.0))) -
+            velocity_frame;
 
         // Real velocity;
         // Factor 1.3 as used in Grønnow, Tepper-García, & Bland-Hawthorn 2018,
@@ -184,7 +209,11 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
                 (2.0 * u(IDN, k, j, i));
 
         // TODO: if MHD is used, initialize the field here...
-        // TODO: if passive scalars are used, initialize here
+
+        // Passive scalars trace the cloud material
+        for (auto n = nhydro; n < nhydro + (sparse_scalars ? 0 : nscalars); n++) {
+          u(n, k, j, i) = rad_cl <= 1.0 ? rho : 0.0;
+        }
       }
     }
   }
@@ -193,4 +222,49 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
   u_dev.DeepCopy(u);
 };
 
+// Ambient medium (at rest in the initial frame) entering at the outer x1 boundary in the
+// frame following the cloud
+void InflowAmbientOX1(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse) {
+  auto pmb = mbd->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  auto cons = mbd->PackVariables(std::vector<std::string>{"cons"}, coarse);
+  const auto nb = IndexRange{0, 0};
+  const Real rho = hydro_pkg->Param<Real>("moving_cloud/rho_ambient");
+  const Real mom = -rho * cloud_frame::Velocity(hydro_pkg.get());
+  const Real en = hydro_pkg->Param<Real>("moving_cloud/pressure") /
+                      (hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0) +
+                  0.5 * mom * mom / rho;
+  const bool fine = false;
+  pmb->par_for_bndry(
+      "InflowAmbientOX1", nb, IndexDomain::outer_x1, parthenon::TopologicalElement::CC,
+      coarse, fine, KOKKOS_LAMBDA(const int &, const int &k, const int &j, const int &i) {
+        cons(IDN, k, j, i) = rho;
+        cons(IM1, k, j, i) = mom;
+        cons(IM2, k, j, i) = 0.0;
+        cons(IM3, k, j, i) = 0.0;
+        cons(IEN, k, j, i) = en;
+      });
+}
+
+// Same as InflowAmbientOX1 for all blocks of md at once
+void InflowAmbientOX1Packed(MeshData<Real> *md, bool coarse) {
+  auto hydro_pkg = md->GetParentPointer()->packages.Get("Hydro");
+  auto cons = md->PackVariables(std::vector<std::string>{"cons"}, coarse);
+  const Real rho = hydro_pkg->Param<Real>("moving_cloud/rho_ambient");
+  const Real mom = -rho * cloud_frame::Velocity(hydro_pkg.get());
+  const Real en = hydro_pkg->Param<Real>("moving_cloud/pressure") /
+                      (hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0) +
+                  0.5 * mom * mom / rho;
+  using parthenon::BoundaryFunction::BCSide;
+  Hydro::BoundaryFunction::ParForPackedBndry<X1DIR, BCSide::Outer>(
+      "InflowAmbientOX1Packed", md, cons, coarse,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        cons(b, IDN, k, j, i) = rho;
+        cons(b, IM1, k, j, i) = mom;
+        cons(b, IM2, k, j, i) = 0.0;
+        cons(b, IM3, k, j, i) = 0.0;
+        cons(b, IEN, k, j, i) = en;
+      });
+}
+
 } // namespace moving_cloud
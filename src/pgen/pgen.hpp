@@ -41,16 +41,22 @@ namespace cloud {
 using namespace parthenon::driver::prelude;
 
 void InitUserMeshData(Mesh *mesh, ParameterInput *pin);
+void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg);
 void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
 void InflowWindX2(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse);
-parthenon::AmrTag ProblemCheckRefinementBlock(MeshBlockData<Real> *mbd);
+void InflowWindX2Packed(MeshData<Real> *md, bool coarse);
+void ProblemCheckRefinementMesh(MeshData<Real> *md,
+                                parthenon::ParArray1D<parthenon::AmrTag> &amr_tags);
 } // namespace cloud
 
 namespace moving_cloud {
 using namespace parthenon::driver::prelude;
 
 void InitUserMeshData(Mesh *mesh, ParameterInput *pin);
+void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg);
 void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void InflowAmbientOX1(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse);
+void InflowAmbientOX1Packed(MeshData<Real> *md, bool coarse);
 } // namespace moving_cloud
 
 namespace blast {
@@ -114,13 +120,16 @@ using namespace parthenon::driver::prelude;
 void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg);
 void InitUserMeshData(ParameterInput *pin);
 void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
-void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin,
-                          const parthenon::SimTime &tm);
+void InitMeshBlockUserData(MeshBlock *pmb, ParameterInput *pin);
+void UserMeshWorkBeforeOutput(Mesh *pmesh, ParameterInput *pin,
+                              const parthenon::SimTime &tm);
 void ClusterUnsplitSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
                            const Real beta_dt);
 void ClusterSplitSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
                          const Real beta_dt);
 parthenon::Real ClusterEstimateTimestep(MeshData<Real> *md);
+bool ClusterConsToPrim(MeshData<Real> *md, const bool with_dt_hyp, Real &dt_hyp);
+void OutputRadialProfiles(Mesh *pmesh, ParameterInput *pin, const parthenon::SimTime &tm);
 } // namespace cluster
 
 namespace sod {
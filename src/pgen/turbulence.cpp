@@ -19,28 +19,40 @@
 #include "mesh/mesh.hpp"
 #include <iomanip>
 #include <ios>
+#include <limits>
 #include <parthenon/driver.hpp>
 #include <parthenon/package.hpp>
 #include <random>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 // AthenaPK headers
 #include "../main.hpp"
 #include "../tracers/tracers.hpp"
 #include "../units.hpp"
 #include "../utils/few_modes_ft.hpp"
+#include "../utils/history.hpp"
+#include "../utils/profiling.hpp"
 #include "utils/error_checking.hpp"
 
 namespace turbulence {
 using namespace parthenon::package::prelude;
 using parthenon::DevMemSpace;
+using parthenon::ParArray1D;
 using parthenon::ParArray2D;
 using utils::few_modes_ft::Complex;
 using utils::few_modes_ft::FewModesFT;
 
-// TODO(?) until we are able to process multiple variables in a single hst function call
-// we'll use this enum to identify the various vars.
+// Number of lookback times stored for the tracers (in powers of 2,
+// i.e., 12 allows to go from 0, 2^0 = 1, 2^1 = 2, 2^2 = 4, ..., 2^10 = 1024 cycles).
+// Could even be made an input parameter if required/desired (though it should probably
+// not be changeable for restarts) but is used to size the correlation reduction.
+constexpr int tracer_n_lookback = 12;
+
+// Used to identify the various vars unless all are calculated in a single reduction
+// (with hydro/fused_hst = true), see FusedTurbulenceHst below.
 enum class HstQuan { Ms, Ma, pb };
 
 // Compute the local sum of either the sonic Mach number,
@@ -100,14 +112,76 @@ Real TurbulenceHst(MeshData<Real> *md) {
   return sum;
 }
 
+// Compute the local sums of the sonic Mach number and (for glmmhd) the alfvenic Mach
+// number and plasma beta in a single pass, see utils/history.hpp.
+template <Fluid fluid>
+std::vector<Real> FusedTurbulenceHst(MeshData<Real> *md) {
+  constexpr int nhst = fluid == Fluid::glmmhd ? 3 : 1;
+  using Sums_t = utils::history::Sums<nhst>;
+
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const auto gamma = hydro_pkg->Param<Real>("AdiabaticIndex");
+
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  Sums_t sums;
+
+  pmb->par_reduce(
+      "hst_turbulence_fused", 0, prim_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Sums_t &lsums) {
+        const auto &prim = prim_pack(b);
+        const auto &coords = prim_pack.GetCoords(b);
+
+        const auto vel2 = (prim(IV1, k, j, i) * prim(IV1, k, j, i) +
+                           prim(IV2, k, j, i) * prim(IV2, k, j, i) +
+                           prim(IV3, k, j, i) * prim(IV3, k, j, i));
+
+        const auto c_s =
+            std::sqrt(gamma * prim(IPR, k, j, i) / prim(IDN, k, j, i)); // speed of sound
+
+        lsums.v[0] += std::sqrt(vel2) / c_s * coords.CellVolume(k, j, i);
+
+        if constexpr (fluid == Fluid::glmmhd) {
+          const auto e_kin = 0.5 * prim(IDN, k, j, i) * vel2;
+          const auto B2 = (prim(IB1, k, j, i) * prim(IB1, k, j, i) +
+                           prim(IB2, k, j, i) * prim(IB2, k, j, i) +
+                           prim(IB3, k, j, i) * prim(IB3, k, j, i));
+
+          const auto e_mag = 0.5 * B2;
+
+          lsums.v[1] += std::sqrt(e_kin / e_mag) * coords.CellVolume(k, j, i);
+          lsums.v[2] += prim(IPR, k, j, i) / e_mag * coords.CellVolume(k, j, i);
+        }
+      },
+      Kokkos::Sum<Sums_t>(sums));
+
+  return sums.ToVector();
+}
+
 void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg) {
   // Step 1. Enlist history output information
   auto hst_vars = pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
   const auto fluid = pkg->Param<Fluid>("fluid");
 
-  hst_vars.emplace_back(parthenon::HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                                    TurbulenceHst<HstQuan::Ms>, "Ms"));
-  if (fluid == Fluid::glmmhd) {
+  if (pkg->Param<bool>("fused_hst")) {
+    if (fluid == Fluid::glmmhd) {
+      utils::history::FusedSums::AddHistoryVars(hst_vars, {"Ms", "Ma", "plasma_beta"},
+                                                FusedTurbulenceHst<Fluid::glmmhd>);
+    } else {
+      utils::history::FusedSums::AddHistoryVars(hst_vars, {"Ms"},
+                                                FusedTurbulenceHst<Fluid::euler>);
+    }
+  } else {
+    hst_vars.emplace_back(parthenon::HistoryOutputVar(
+        parthenon::UserHistoryOperation::sum, TurbulenceHst<HstQuan::Ms>, "Ms"));
+  }
+  if (fluid == Fluid::glmmhd && !pkg->Param<bool>("fused_hst")) {
     hst_vars.emplace_back(parthenon::HistoryOutputVar(
         parthenon::UserHistoryOperation::sum, TurbulenceHst<HstQuan::Ma>, "Ma"));
     hst_vars.emplace_back(parthenon::HistoryOutputVar(
@@ -115,6 +189,14 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg
   }
   pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
 
+  // The state of the driving (the modes and random number generator of the OU process
+  // and the update interval Params) is advanced in each step and not restored when a
+  // step is retried.
+  PARTHENON_REQUIRE_THROWS(!pin->GetOrAddBoolean("hydro", "step_retry", false),
+                           "hydro/step_retry is incompatible with turbulence driving "
+                           "as the state of the driving is not restored when retrying "
+                           "a step.");
+
   // Step 2. Add appropriate fields required by this pgen
   // Using OneCopy here to save memory. We typically don't need to update/evolve the
   // acceleration field for various stages in a cycle as the "model" error of the
@@ -125,8 +207,35 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg
              std::vector<int>({3}));
   pkg->AddField("acc", m);
 
-  auto num_modes =
-      pin->GetInteger("problem/turbulence", "num_modes"); // number of wavemodes
+  // Optionally, the forcing field is only updated every update_interval_cycles cycles or
+  // every update_interval_tcorr * corr_time and interpolated in time in between.
+  const auto update_cycles =
+      pin->GetOrAddInteger("problem/turbulence", "update_interval_cycles", 1);
+  const auto update_tcorr =
+      pin->GetOrAddReal("problem/turbulence", "update_interval_tcorr", 0.0);
+  PARTHENON_REQUIRE_THROWS(update_cycles >= 1,
+                           "problem/turbulence/update_interval_cycles must be >= 1.");
+  PARTHENON_REQUIRE_THROWS(update_tcorr >= 0.0 &&
+                               (update_cycles == 1 || update_tcorr == 0.0),
+                           "Only one of problem/turbulence/update_interval_cycles and "
+                           "update_interval_tcorr can be set.");
+  pkg->AddParam<>("turbulence/update_interval_cycles", update_cycles);
+  pkg->AddParam<>("turbulence/update_interval_tcorr", update_tcorr);
+  const bool interpolate = update_cycles > 1 || update_tcorr > 0.0;
+  pkg->AddParam<>("turbulence/interpolate", interpolate);
+  if (interpolate) {
+    // Fields at the beginning and end of the current update interval
+    Metadata m_interp({Metadata::Cell, Metadata::Derived, Metadata::OneCopy,
+                       Metadata::Restart},
+                      std::vector<int>({3}));
+    pkg->AddField("acc_prev", m_interp);
+    pkg->AddField("acc_next", m_interp);
+    // Cycle and time of the last update (no update yet for negative cycles) and length
+    // of the current update interval
+    pkg->AddParam<>("turbulence/update_cycle", -1, Params::Mutability::Restart);
+    pkg->AddParam<>("turbulence/update_time", Real(0.0), Params::Mutability::Restart);
+    pkg->AddParam<>("turbulence/update_dt", Real(0.0), Params::Mutability::Restart);
+  }
 
   uint32_t rseed =
       pin->GetOrAddInteger("problem/turbulence", "rseed", -1); // seed for random number.
@@ -147,22 +256,105 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg
   Real sol_weight = pin->GetReal("problem/turbulence", "sol_weight"); // solenoidal weight
   pkg->AddParam<>("turbulence/sol_weight", sol_weight);
 
-  // list of wavenumber vectors
-  auto k_vec = ParArray2D<Real>("k_vec", 3, num_modes);
-  auto k_vec_host = Kokkos::create_mirror_view(k_vec);
-  for (int j = 0; j < 3; j++) {
-    for (int i = 1; i <= num_modes; i++) {
-      k_vec_host(j, i - 1) =
-          pin->GetInteger("modes", "k_" + std::to_string(i) + "_" + std::to_string(j));
+  // Wave vectors of the driven modes, either listed in <modes> or all (integer) wave
+  // vectors with non-vanishing power of the forcing spectrum, i.e., |k| < sqrt(2) kpeak
+  const auto modes = pin->GetOrAddString("problem/turbulence", "modes", "list");
+  PARTHENON_REQUIRE_THROWS(modes == "list" || modes == "all",
+                           "Unknown problem/turbulence/modes '" + modes +
+                               "'. Use 'list' or 'all'.");
+  ParArray2D<Real> k_vec;
+  int num_modes;
+  if (modes == "list") {
+    num_modes = pin->GetInteger("problem/turbulence", "num_modes"); // number of wavemodes
+    k_vec = ParArray2D<Real>("k_vec", 3, num_modes);
+    auto k_vec_host = Kokkos::create_mirror_view(k_vec);
+    for (int j = 0; j < 3; j++) {
+      for (int i = 1; i <= num_modes; i++) {
+        k_vec_host(j, i - 1) =
+            pin->GetInteger("modes", "k_" + std::to_string(i) + "_" + std::to_string(j));
+      }
     }
+    Kokkos::deep_copy(k_vec, k_vec_host);
+  } else {
+    PARTHENON_REQUIRE_THROWS(k_peak > 0.0,
+                             "problem/turbulence/modes=all requires kpeak > 0.");
+    k_vec = utils::few_modes_ft::MakeAllModes(std::sqrt(2.0) * k_peak);
+    num_modes = k_vec.extent_int(1);
   }
-  Kokkos::deep_copy(k_vec, k_vec_host);
 
+  // The explicit transform sums over all modes for every cell, whereas the separable
+  // transform sums over the components of the wave vectors one direction at a time,
+  // whose cost is independent of the number of modes, see docs/turbulence.md.
+  const auto transform =
+      pin->GetOrAddString("problem/turbulence", "transform", "explicit");
+  PARTHENON_REQUIRE_THROWS(transform == "explicit" || transform == "separable",
+                           "Unknown problem/turbulence/transform '" + transform +
+                               "'. Use 'explicit' or 'separable'.");
+
+  // Optionally, the driving is restricted to the box driving_xmin <= x < driving_xmax
+  // (of the cell centers). The acceleration field is then only computed for the blocks
+  // intersecting the box and normalized over the volume of the box.
+  const auto driving_region =
+      pin->GetOrAddBoolean("problem/turbulence", "driving_region", false);
+  pkg->AddParam<>("turbulence/driving_region", driving_region);
+  if (driving_region) {
+    std::vector<Real> mesh_xmin, mesh_xmax;
+    for (const auto &dir : {"1", "2", "3"}) {
+      mesh_xmin.push_back(pin->GetReal("parthenon/mesh", std::string("x") + dir + "min"));
+      mesh_xmax.push_back(pin->GetReal("parthenon/mesh", std::string("x") + dir + "max"));
+    }
+    const auto xmin =
+        pin->GetOrAddVector<Real>("problem/turbulence", "driving_xmin", mesh_xmin);
+    const auto xmax =
+        pin->GetOrAddVector<Real>("problem/turbulence", "driving_xmax", mesh_xmax);
+    PARTHENON_REQUIRE_THROWS(xmin.size() == 3 && xmax.size() == 3,
+                             "problem/turbulence/driving_xmin and driving_xmax should "
+                             "have three components.");
+    Kokkos::Array<Real, 3> region_xmin, region_xmax;
+    for (int d = 0; d < 3; d++) {
+      PARTHENON_REQUIRE_THROWS(xmin[d] < xmax[d] && xmin[d] < mesh_xmax[d] &&
+                                   xmax[d] > mesh_xmin[d],
+                               "The driving region (problem/turbulence/driving_xmin and "
+                               "driving_xmax) must be non-empty and within the mesh.");
+      region_xmin[d] = xmin[d];
+      region_xmax[d] = xmax[d];
+    }
+    pkg->AddParam<>("turbulence/driving_xmin", region_xmin);
+    pkg->AddParam<>("turbulence/driving_xmax", region_xmax);
+  }
+
+  const auto rng = pin->GetOrAddString("problem/turbulence", "rng", "mt19937");
+  PARTHENON_REQUIRE_THROWS(rng == "mt19937" || rng == "counter_based",
+                           "Unknown problem/turbulence/rng '" + rng +
+                               "'. Use 'mt19937' or 'counter_based'.");
+  const bool fill_ghosts = false;
   auto few_modes_ft = FewModesFT(pin, pkg, "turbulence", num_modes, k_vec, k_peak,
-                                 sol_weight, t_corr, rseed);
+                                 sol_weight, t_corr, rseed, fill_ghosts,
+                                 rng == "counter_based", transform == "separable");
   // object must be mutable to update the internal state of the RNG
   pkg->AddParam<>("turbulence/few_modes_ft", few_modes_ft, true);
 
+  // In-situ power spectra (of the modes up to spectra_kmax) every spectra_dt
+  const auto spectra_dt = pin->GetOrAddReal("problem/turbulence", "spectra_dt", -1.0);
+  pkg->AddParam<>("turbulence/spectra_dt", spectra_dt);
+  if (spectra_dt > 0.0) {
+    const auto spectra_kmax =
+        pin->GetOrAddInteger("problem/turbulence", "spectra_kmax", 3);
+    PARTHENON_REQUIRE_THROWS(spectra_kmax >= 1,
+                             "problem/turbulence/spectra_kmax must be >= 1.");
+    pkg->AddParam<>("turbulence/spectra_kmax", spectra_kmax);
+    const auto k_vec_spectra = utils::few_modes_ft::MakeShellModes(spectra_kmax);
+    // Only the phases are used so the parameters of the OU process are irrelevant
+    auto spectra_ft = FewModesFT(pin, pkg, "turbulence_spectra", k_vec_spectra.extent(1),
+                                 k_vec_spectra, 1.0, -1.0, 1.0, 0);
+    pkg->AddParam<>("turbulence/spectra_ft", spectra_ft);
+    pkg->AddParam<>(
+        "turbulence/spectra_file",
+        pin->GetOrAddString("problem/turbulence", "spectra_file", "turbulence.spectra"));
+    pkg->AddParam<>("turbulence/spectra_next_time", std::numeric_limits<Real>::lowest(),
+                    Params::Mutability::Mutable);
+  }
+
   // Check if this is is a restart and restore previous state
   if (pin->DoesParameterExist("problem/turbulence", "accel_hat_0_0_r")) {
     // Need to extract mutable object from Params here as the original few_modes_ft above
@@ -185,24 +377,26 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg
     Kokkos::deep_copy(accel_hat, accel_hat_host);
 
     // Restore state of random number gen
-    {
-      std::istringstream iss(pin->GetString("problem/turbulence", "state_rng"));
-      pfew_modes_ft->RestoreRNG(iss);
-    }
-    // Restore state of dist
-    {
-      std::istringstream iss(pin->GetString("problem/turbulence", "state_dist"));
-      pfew_modes_ft->RestoreDist(iss);
+    if (pfew_modes_ft->IsCounterBasedRNG()) {
+      pfew_modes_ft->RestoreRNGCounter(
+          pin->GetInteger("problem/turbulence", "rng_counter"));
+    } else {
+      {
+        std::istringstream iss(pin->GetString("problem/turbulence", "state_rng"));
+        pfew_modes_ft->RestoreRNG(iss);
+      }
+      // Restore state of dist
+      {
+        std::istringstream iss(pin->GetString("problem/turbulence", "state_dist"));
+        pfew_modes_ft->RestoreDist(iss);
+      }
     }
   }
 }
 
 void ProblemInitTracerData(ParameterInput * /*pin*/,
                            parthenon::StateDescriptor *tracer_pkg) {
-  // Number of lookback times to be stored (in powers of 2,
-  // i.e., 12 allows to go from 0, 2^0 = 1, 2^1 = 2, 2^2 = 4, ..., 2^10 = 1024 cycles)
-  const int n_lookback = 12; // could even be made an input parameter if required/desired
-                             // (though it should probably not be changeable for restarts)
+  const int n_lookback = tracer_n_lookback;
   tracer_pkg->AddParam("turbulence/n_lookback", n_lookback);
 
   const auto swarm_name = tracer_pkg->Param<std::string>("swarm_name");
@@ -222,6 +416,10 @@ void SetPhases(MeshBlock *pmb, ParameterInput *pin) {
   auto hydro_pkg = pmb->packages.Get("Hydro");
   auto few_modes_ft = hydro_pkg->Param<FewModesFT>("turbulence/few_modes_ft");
   few_modes_ft.SetPhases(pmb, pin);
+  if (hydro_pkg->Param<Real>("turbulence/spectra_dt") > 0.0) {
+    auto spectra_ft = hydro_pkg->Param<FewModesFT>("turbulence/spectra_ft");
+    spectra_ft.SetPhases(pmb, pin);
+  }
 }
 
 //========================================================================================
@@ -366,23 +564,127 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
       });
 }
 
+// Blocks of a MeshData (and box) of the driving region, see GetDrivenBlocks below
+struct DrivenBlocks {
+  bool enabled = false;         // if the driving is restricted to the region
+  ParArray1D<int> ids;          // indices of the blocks intersecting the region
+  ParArray1D<int> undriven_ids; // indices of all other blocks
+  Kokkos::Array<Real, 3> xmin, xmax;
+
+  // Number of blocks to loop over and index (within the MeshData) of block bi of the loop
+  int NumBlocks(MeshData<Real> *md) const {
+    return enabled ? ids.extent_int(0) : md->NumBlocks();
+  }
+  KOKKOS_INLINE_FUNCTION int Block(const int bi) const { return enabled ? ids(bi) : bi; }
+  KOKKOS_INLINE_FUNCTION bool Contains(const parthenon::Coordinates_t &coords,
+                                       const int k, const int j, const int i) const {
+    if (!enabled) {
+      return true;
+    }
+    const Real x[3] = {coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k)};
+    bool contains = true;
+    for (int d = 0; d < 3; d++) {
+      contains = contains && x[d] >= xmin[d] && x[d] < xmax[d];
+    }
+    return contains;
+  }
+};
+
+//----------------------------------------------------------------------------------------
+//! \fn DrivenBlocks GetDrivenBlocks(MeshData<Real> *md)
+//  \brief Blocks of md intersecting the driving region (with turbulence/driving_region)
+//
+// The acceleration fields are only computed (and applied) for these blocks. The children
+// of blocks not intersecting the (fixed) region do not intersect it either, but the
+// children of a parent intersecting it may not. Their acceleration is prolongated from
+// the parent, so it is explicitly zeroed for all other blocks (see ZeroUndriven).
+
+DrivenBlocks GetDrivenBlocks(MeshData<Real> *md) {
+  auto hydro_pkg = md->GetParentPointer()->packages.Get("Hydro");
+  DrivenBlocks driven;
+  driven.enabled = hydro_pkg->Param<bool>("turbulence/driving_region");
+  if (!driven.enabled) {
+    return driven;
+  }
+  driven.xmin = hydro_pkg->Param<Kokkos::Array<Real, 3>>("turbulence/driving_xmin");
+  driven.xmax = hydro_pkg->Param<Kokkos::Array<Real, 3>>("turbulence/driving_xmax");
+
+  std::vector<int> ids, undriven_ids;
+  for (int b = 0; b < md->NumBlocks(); b++) {
+    auto pmb = md->GetBlockData(b)->GetBlockPointer();
+    const auto &coords = pmb->coords;
+    const IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+    const IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+    const IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+    const Real block_xmin[3] = {coords.Xf<1>(ib.s), coords.Xf<2>(jb.s),
+                                coords.Xf<3>(kb.s)};
+    const Real block_xmax[3] = {coords.Xf<1>(ib.e + 1), coords.Xf<2>(jb.e + 1),
+                                coords.Xf<3>(kb.e + 1)};
+    bool intersects = true;
+    for (int d = 0; d < 3; d++) {
+      intersects = intersects && block_xmin[d] < driven.xmax[d] &&
+                   block_xmax[d] > driven.xmin[d];
+    }
+    (intersects ? ids : undriven_ids).push_back(b);
+  }
+  const auto to_device = [](const std::string &label, const std::vector<int> &v) {
+    ParArray1D<int> arr(label, v.size());
+    auto arr_host = Kokkos::create_mirror_view(arr);
+    for (int n = 0; n < static_cast<int>(v.size()); n++) {
+      arr_host(n) = v[n];
+    }
+    Kokkos::deep_copy(arr, arr_host);
+    return arr;
+  };
+  driven.ids = to_device("turbulence driven blocks", ids);
+  driven.undriven_ids = to_device("turbulence undriven blocks", undriven_ids);
+  return driven;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ZeroUndriven(MeshData<Real> *md, const DrivenBlocks &driven)
+//  \brief Zeros the acceleration of the blocks not intersecting the driving region
+
+void ZeroUndriven(MeshData<Real> *md, const DrivenBlocks &driven) {
+  const int num_blocks = driven.enabled ? driven.undriven_ids.extent_int(0) : 0;
+  if (num_blocks == 0) {
+    return;
+  }
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  auto acc_pack = md->PackVariables(std::vector<std::string>{"acc"});
+  const auto &undriven_ids = driven.undriven_ids;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "forcing: zero undriven", parthenon::DevExecSpace(), 0,
+      num_blocks - 1, 0, 2, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int bi, const int n, const int k, const int j, const int i) {
+        acc_pack(undriven_ids(bi), n, k, j, i) = 0.0;
+      });
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Generate()
-//  \brief Generate velocity pertubation.
+//  \brief Generate velocity pertubation (in field var_name).
 
-void Generate(MeshData<Real> *md, Real dt) {
+void Generate(MeshData<Real> *md, Real dt, const std::string &var_name,
+              const DrivenBlocks &driven) {
   auto pmb = md->GetBlockData(0)->GetBlockPointer();
   auto hydro_pkg = pmb->packages.Get("Hydro");
   // Must be mutable so the internal RNG state is updated
   auto *few_modes_ft = hydro_pkg->MutableParam<FewModesFT>("turbulence/few_modes_ft");
-  few_modes_ft->Generate(md, dt, "acc");
+  few_modes_ft->Generate(md, dt, var_name, driven.enabled ? &driven.ids : nullptr);
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn void Perturb(Real dt)
-//  \brief Add velocity perturbation to the hydro variables
-
-void Perturb(MeshData<Real> *md, const Real dt) {
+//! \fn void Normalization(MeshData<Real> *md, const std::string &var_name,
+//                          const DrivenBlocks &driven)
+//  \brief Mean (mass weighted) acceleration and normalization factor of var_name (within
+//  the driving region)
+
+std::pair<Kokkos::Array<Real, 3>, Real> Normalization(MeshData<Real> *md,
+                                                      const std::string &var_name,
+                                                      const DrivenBlocks &driven) {
   auto pmb = md->GetBlockData(0)->GetBlockPointer();
   auto hydro_pkg = pmb->packages.Get("Hydro");
 
@@ -391,45 +693,55 @@ void Perturb(MeshData<Real> *md, const Real dt) {
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
   auto cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-  auto acc_pack = md->PackVariables(std::vector<std::string>{"acc"});
-
-  Kokkos::Array<Real, 4> sums{{0.0, 0.0, 0.0, 0.0}};
-  Kokkos::parallel_reduce(
-      "forcing: calc mean momenum",
-      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-          {0, kb.s, jb.s, ib.s}, {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-          {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lmass_sum,
-                    Real &lim1_sum, Real &lim2_sum, Real &lim3_sum) {
-        const auto &coords = cons_pack.GetCoords(b);
-        auto den = cons_pack(b, IDN, k, j, i);
-        lmass_sum += den * coords.CellVolume(k, j, i);
-        lim1_sum += den * acc_pack(b, 0, k, j, i) * coords.CellVolume(k, j, i);
-        lim2_sum += den * acc_pack(b, 1, k, j, i) * coords.CellVolume(k, j, i);
-        lim3_sum += den * acc_pack(b, 2, k, j, i) * coords.CellVolume(k, j, i);
-      },
-      sums[0], sums[1], sums[2], sums[3]);
-
-#ifdef MPI_PARALLEL
-  // Sum the perturbations over all processors
-  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums.data(), 4, MPI_PARTHENON_REAL,
-                                    MPI_SUM, MPI_COMM_WORLD));
-#endif // MPI_PARALLEL
-
-  pmb->par_reduce(
-      "forcing: remove mean momentum and calc norm", 0, acc_pack.GetDim(5) - 1, 0, 2,
-      kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int b, const int n, const int k, const int j, const int i,
-                    Real &lampl_sum) {
-        const auto &coords = acc_pack.GetCoords(b);
-        acc_pack(b, n, k, j, i) -= sums[n + 1] / sums[0];
-        lampl_sum += SQR(acc_pack(b, n, k, j, i)) * coords.CellVolume(k, j, i);
-      },
-      sums[0]);
+  auto acc_pack = md->PackVariables(std::vector<std::string>{var_name});
+
+  // Mass, mass weighted mean acceleration, and volume weighted (first and second)
+  // moments of the acceleration (as well as the volume of the driving region) are all
+  // reduced at once so that only a single global reduction is required. The norm of the
+  // acceleration after removing the mean momentum m_n follows from
+  // sum_V (a_n - m_n)^2 = sum_V a_n^2 - 2 m_n sum_V a_n + m_n^2 V.
+  Kokkos::Array<Real, 11> sums{
+      {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}};
+  const int num_blocks = driven.NumBlocks(md);
+  if (num_blocks > 0) {
+    Kokkos::parallel_reduce(
+        "forcing: calc mean momenum and moments",
+        Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+            {0, kb.s, jb.s, ib.s}, {num_blocks, kb.e + 1, jb.e + 1, ib.e + 1},
+            {1, 1, 1, ib.e + 1 - ib.s}),
+        KOKKOS_LAMBDA(const int bi, const int k, const int j, const int i,
+                      Real &lmass_sum, Real &lim1_sum, Real &lim2_sum, Real &lim3_sum,
+                      Real &la1_sum, Real &la2_sum, Real &la3_sum, Real &la1sq_sum,
+                      Real &la2sq_sum, Real &la3sq_sum, Real &lvol_sum) {
+          const int b = driven.Block(bi);
+          const auto &coords = cons_pack.GetCoords(b);
+          if (!driven.Contains(coords, k, j, i)) {
+            return;
+          }
+          const auto vol = coords.CellVolume(k, j, i);
+          const auto den = cons_pack(b, IDN, k, j, i);
+          const auto a1 = acc_pack(b, 0, k, j, i);
+          const auto a2 = acc_pack(b, 1, k, j, i);
+          const auto a3 = acc_pack(b, 2, k, j, i);
+          lmass_sum += den * vol;
+          lim1_sum += den * a1 * vol;
+          lim2_sum += den * a2 * vol;
+          lim3_sum += den * a3 * vol;
+          la1_sum += a1 * vol;
+          la2_sum += a2 * vol;
+          la3_sum += a3 * vol;
+          la1sq_sum += SQR(a1) * vol;
+          la2sq_sum += SQR(a2) * vol;
+          la3sq_sum += SQR(a3) * vol;
+          lvol_sum += vol;
+        },
+        sums[0], sums[1], sums[2], sums[3], sums[4], sums[5], sums[6], sums[7], sums[8],
+        sums[9], sums[10]);
+  }
 
 #ifdef MPI_PARALLEL
   // Sum the perturbations over all processors
-  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums.data(), 1, MPI_PARTHENON_REAL,
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums.data(), 11, MPI_PARTHENON_REAL,
                                     MPI_SUM, MPI_COMM_WORLD));
 #endif // MPI_PARALLEL
 
@@ -440,11 +752,40 @@ void Perturb(MeshData<Real> *md, const Real dt) {
   const auto Lz =
       pmb->pmy_mesh->mesh_size.xmax(X3DIR) - pmb->pmy_mesh->mesh_size.xmin(X3DIR);
   const auto accel_rms = hydro_pkg->Param<Real>("turbulence/accel_rms");
-  auto norm = accel_rms / std::sqrt(sums[0] / (Lx * Ly * Lz));
+  const auto vol = driven.enabled ? sums[10] : Lx * Ly * Lz;
+  PARTHENON_REQUIRE(vol > 0.0, "No cell center within the turbulence driving region.");
+  Kokkos::Array<Real, 3> mean_acc;
+  Real ampl_sum = 0.0;
+  for (int n = 0; n < 3; n++) {
+    mean_acc[n] = sums[n + 1] / sums[0];
+    ampl_sum += sums[n + 7] - 2.0 * mean_acc[n] * sums[n + 4] + SQR(mean_acc[n]) * vol;
+  }
+  return {mean_acc, accel_rms / std::sqrt(ampl_sum / vol)};
+}
 
+//----------------------------------------------------------------------------------------
+//! \fn void Perturb(Real dt)
+//  \brief Add velocity perturbation to the hydro variables (within the driving region)
+
+void Perturb(MeshData<Real> *md, const Real dt, const Kokkos::Array<Real, 3> &mean_acc,
+             const Real norm, const DrivenBlocks &driven) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  auto cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  auto acc_pack = md->PackVariables(std::vector<std::string>{"acc"});
+
+  const int num_blocks = driven.NumBlocks(md);
+  if (num_blocks == 0) {
+    return;
+  }
   pmb->par_for(
-      "apply momemtum perturb", 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+      "apply momemtum perturb", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int bi, const int k, const int j, const int i) {
+        const int b = driven.Block(bi);
         auto &cons = cons_pack(b);
         auto &acc = acc_pack(b);
 
@@ -452,10 +793,18 @@ void Perturb(MeshData<Real> *md, const Real dt) {
         auto &acc_1 = acc(1, k, j, i);
         auto &acc_2 = acc(2, k, j, i);
 
-        // normalizing accel field here so that the actual values are used in the output
-        acc_0 *= norm;
-        acc_1 *= norm;
-        acc_2 *= norm;
+        if (!driven.Contains(cons_pack.GetCoords(b), k, j, i)) {
+          acc_0 = 0.0;
+          acc_1 = 0.0;
+          acc_2 = 0.0;
+          return;
+        }
+
+        // removing the mean momentum and normalizing accel field here so that the actual
+        // values are used in the output
+        acc_0 = (acc_0 - mean_acc[0]) * norm;
+        acc_1 = (acc_1 - mean_acc[1]) * norm;
+        acc_2 = (acc_2 - mean_acc[2]) * norm;
 
         Real qa = dt * cons(IDN, k, j, i);
         cons(IEN, k, j, i) +=
@@ -469,16 +818,194 @@ void Perturb(MeshData<Real> *md, const Real dt) {
       });
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void GenerateNormalized(MeshData<Real> *md, Real dt, const std::string &var_name)
+//  \brief Generate the perturbation in var_name and remove the mean momentum as well as
+//  normalize it (given the current density).
+
+void GenerateNormalized(MeshData<Real> *md, Real dt, const std::string &var_name,
+                        const DrivenBlocks &driven) {
+  Generate(md, dt, var_name, driven);
+  const auto normalization = Normalization(md, var_name, driven);
+  const auto mean_acc = normalization.first;
+  const auto norm = normalization.second;
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  auto pack = md->PackVariables(std::vector<std::string>{var_name});
+  const int num_blocks = driven.NumBlocks(md);
+  if (num_blocks == 0) {
+    return;
+  }
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "forcing: normalize update", parthenon::DevExecSpace(), 0,
+      num_blocks - 1, 0, 2, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int bi, const int n, const int k, const int j, const int i) {
+        const int b = driven.Block(bi);
+        pack(b, n, k, j, i) = driven.Contains(pack.GetCoords(b), k, j, i)
+                                  ? (pack(b, n, k, j, i) - mean_acc[n]) * norm
+                                  : 0.0;
+      });
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void OutputSpectra(MeshData<Real> *md, const parthenon::SimTime &tm)
+//  \brief Appends the shell-binned power spectra of density, velocity, and magnetic field
+//  (if any) to the spectra file.
+//
+// The power in shell n (with n - 1/2 <= |k| < n + 1/2) is sum |f_hat(k)|^2 over all wave
+// vectors (including -k) in the shell so that the sum over all shells is the variance
+// of f (for k_max large enough). Note, the last shell only contains |k| <= spectra_kmax.
+
+void OutputSpectra(MeshData<Real> *md, const parthenon::SimTime &tm) {
+  utils::profiling::ScopedRegion region("turbulence::OutputSpectra");
+  auto pm = md->GetParentPointer();
+  auto hydro_pkg = pm->packages.Get("Hydro");
+  const auto &spectra_ft = hydro_pkg->Param<FewModesFT>("turbulence/spectra_ft");
+  const auto kmax = hydro_pkg->Param<int>("turbulence/spectra_kmax");
+  const bool mhd = hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd;
+
+  std::vector<std::string> names = {"density", "velocity"};
+  std::vector<std::vector<int>> quantities = {{IDN}, {IV1, IV2, IV3}};
+  if (mhd) {
+    names.emplace_back("magnetic");
+    quantities.push_back({IB1, IB2, IB3});
+  }
+  std::vector<int> components;
+  for (const auto &q : quantities) {
+    components.insert(components.end(), q.begin(), q.end());
+  }
+  const auto f_hat = spectra_ft.Project(md, "prim", components);
+  if (parthenon::Globals::my_rank != 0) {
+    return;
+  }
+
+  const auto num_modes = spectra_ft.GetNumModes();
+  auto k_vec = spectra_ft.GetKVec().GetHostMirrorAndCopy();
+  std::vector<int> shell(num_modes);
+  for (int m = 0; m < num_modes; m++) {
+    shell[m] = static_cast<int>(std::lround(
+        std::sqrt(SQR(k_vec(0, m)) + SQR(k_vec(1, m)) + SQR(k_vec(2, m)))));
+  }
+
+  const auto &filename = hydro_pkg->Param<std::string>("turbulence/spectra_file");
+  std::ifstream existing(filename);
+  const bool write_header = (!pm->is_restart && tm.ncycle == 0) || !existing.good();
+  existing.close();
+  std::ofstream outfile(filename, write_header ? std::ios::trunc : std::ios::app);
+  PARTHENON_REQUIRE_THROWS(outfile.good(), "Cannot open spectra file " + filename);
+  if (write_header) {
+    outfile << "# cycle time quantity P(k=1) ... P(k=" << kmax << ")" << std::endl;
+  }
+  outfile << std::scientific
+          << std::setprecision(std::numeric_limits<Real>::max_digits10);
+  int c = 0;
+  for (int q = 0; q < static_cast<int>(names.size()); q++) {
+    std::vector<Real> power(kmax + 1, 0.0);
+    for (int n = 0; n < static_cast<int>(quantities[q].size()); n++, c++) {
+      for (int m = 0; m < num_modes; m++) {
+        if (shell[m] <= kmax) {
+          // Factor 2 accounts for the modes -k (not contained in the half space)
+          const auto &f = f_hat[c * num_modes + m];
+          power[shell[m]] += 2.0 * (SQR(f.real()) + SQR(f.imag()));
+        }
+      }
+    }
+    outfile << tm.ncycle << " " << tm.time << " " << names[q];
+    for (int k = 1; k <= kmax; k++) {
+      outfile << " " << power[k];
+    }
+    outfile << std::endl;
+  }
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void FewModesTurbulenceDriver::Driving(void)
 //  \brief Generate and Perturb the velocity field
 
 void Driving(MeshData<Real> *md, const parthenon::SimTime &tm, const Real dt) {
-  // evolve forcing
-  Generate(md, dt);
+  auto hydro_pkg = md->GetParentPointer()->packages.Get("Hydro");
+  // Spectra of the state at the beginning of the cycle
+  const auto spectra_dt = hydro_pkg->Param<Real>("turbulence/spectra_dt");
+  if (spectra_dt > 0.0 &&
+      tm.time >= hydro_pkg->Param<Real>("turbulence/spectra_next_time")) {
+    OutputSpectra(md, tm);
+    hydro_pkg->UpdateParam("turbulence/spectra_next_time",
+                           (std::floor(tm.time / spectra_dt) + 1.0) * spectra_dt);
+  }
+
+  const auto driven = GetDrivenBlocks(md);
+  ZeroUndriven(md, driven);
+  if (!hydro_pkg->Param<bool>("turbulence/interpolate")) {
+    // evolve forcing
+    Generate(md, dt, "acc", driven);
+
+    // actually drive turbulence
+    const auto [mean_acc, norm] = Normalization(md, "acc", driven);
+    Perturb(md, dt, mean_acc, norm, driven);
+    return;
+  }
+
+  // Reduced cadence: the forcing field is only generated (and normalized) at the end of
+  // the current update interval and linearly interpolated in time in between.
+  const auto update_cycles = hydro_pkg->Param<int>("turbulence/update_interval_cycles");
+  const auto update_cycle = hydro_pkg->Param<int>("turbulence/update_cycle");
+  const auto update_time = hydro_pkg->Param<Real>("turbulence/update_time");
+  const auto update_dt = hydro_pkg->Param<Real>("turbulence/update_dt");
+  const bool by_cycle = update_cycles > 1;
+  const bool update = update_cycle < 0 ||
+                      (by_cycle ? tm.ncycle - update_cycle >= update_cycles
+                                : tm.time >= update_time + update_dt);
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  auto acc_pack = md->PackVariables(std::vector<std::string>{"acc"});
+  auto prev_pack = md->PackVariables(std::vector<std::string>{"acc_prev"});
+  auto next_pack = md->PackVariables(std::vector<std::string>{"acc_next"});
+
+  if (update) {
+    const Real dt_update =
+        by_cycle ? update_cycles * dt
+                 : hydro_pkg->Param<Real>("turbulence/update_interval_tcorr") *
+                       hydro_pkg->Param<Real>("turbulence/t_corr");
+    if (update_cycle < 0) {
+      // first update (without any previous field)
+      GenerateNormalized(md, dt, "acc_prev", driven);
+    } else {
+      parthenon::par_for(
+          DEFAULT_LOOP_PATTERN, "forcing: shift update", parthenon::DevExecSpace(), 0,
+          driven.NumBlocks(md) - 1, 0, 2, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+          KOKKOS_LAMBDA(const int bi, const int n, const int k, const int j,
+                        const int i) {
+            const int b = driven.Block(bi);
+            prev_pack(b, n, k, j, i) = next_pack(b, n, k, j, i);
+          });
+    }
+    GenerateNormalized(md, dt_update, "acc_next", driven);
+    hydro_pkg->UpdateParam("turbulence/update_cycle", static_cast<int>(tm.ncycle));
+    hydro_pkg->UpdateParam("turbulence/update_time", tm.time);
+    hydro_pkg->UpdateParam("turbulence/update_dt", dt_update);
+  }
+
+  // Weight of the field at the end of the interval
+  const auto last_cycle = hydro_pkg->Param<int>("turbulence/update_cycle");
+  const auto last_time = hydro_pkg->Param<Real>("turbulence/update_time");
+  const auto last_dt = hydro_pkg->Param<Real>("turbulence/update_dt");
+  const Real w = by_cycle ? static_cast<Real>(tm.ncycle - last_cycle) / update_cycles
+                          : std::min<Real>(1.0, (tm.time - last_time) / last_dt);
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "forcing: interpolate", parthenon::DevExecSpace(), 0,
+      driven.NumBlocks(md) - 1, 0, 2, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int bi, const int n, const int k, const int j, const int i) {
+        const int b = driven.Block(bi);
+        acc_pack(b, n, k, j, i) =
+            (1.0 - w) * prev_pack(b, n, k, j, i) + w * next_pack(b, n, k, j, i);
+      });
 
-  // actually drive turbulence
-  Perturb(md, dt);
+  // actually drive turbulence (the interpolated field is already normalized)
+  Perturb(md, dt, Kokkos::Array<Real, 3>{{0.0, 0.0, 0.0}}, 1.0, driven);
 }
 
 void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin,
@@ -503,6 +1030,11 @@ void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin,
     }
   }
   // store state of random number gen
+  if (few_modes_ft.IsCounterBasedRNG()) {
+    pin->SetInteger("problem/turbulence", "rng_counter",
+                    static_cast<int>(few_modes_ft.GetRNGCounter()));
+    return;
+  }
   auto state_rng = few_modes_ft.GetRNGState();
   pin->SetString("problem/turbulence", "state_rng", state_rng);
   // store state of distribution
@@ -515,7 +1047,7 @@ TaskStatus ProblemFillTracers(MeshData<Real> *md, const parthenon::SimTime &tm,
   const auto current_cycle = tm.ncycle;
 
   auto tracers_pkg = md->GetParentPointer()->packages.Get("tracers");
-  const auto n_lookback = tracers_pkg->Param<int>("turbulence/n_lookback");
+  constexpr int n_lookback = tracer_n_lookback;
   // Params (which is storing t_lookback) is shared across all blocks so we update it
   // outside the block loop. Note, that this is a standard vector, so it cannot be used
   // in the kernel (but also don't need to be used as can directly update it)
@@ -533,12 +1065,12 @@ TaskStatus ProblemFillTracers(MeshData<Real> *md, const parthenon::SimTime &tm,
   // Write data back to Params dict
   tracers_pkg->UpdateParam("turbulence/t_lookback", t_lookback);
 
-  // TODO(pgrete) Benchmark atomic and potentially update to proper reduction instead of
-  // atomics.
-  //  Used for the parallel reduction. Could be reused but this way it's initalized to
-  //  0.
-  // n_lookback + 1 as it also carries <s> and <sdot>
-  parthenon::ParArray2D<Real> corr("tracer correlations", 2, n_lookback + 1);
+  // The (mean) correlations are calculated by an array-valued reduction per block (with
+  // per-thread and team-level partial sums) rather than with atomics on the few global
+  // entries. Entry n_lookback of each row carries <s> and <sdot>, respectively.
+  constexpr int ncorr = n_lookback + 1;
+  using Corr_t = utils::history::Sums<2 * ncorr>;
+  Corr_t corr;
   int64_t num_particles_total = 0;
 
   for (int b = 0; b < md->NumBlocks(); b++) {
@@ -556,8 +1088,11 @@ TaskStatus ProblemFillTracers(MeshData<Real> *md, const parthenon::SimTime &tm,
 
     // update loop.
     const int max_active_index = swarm->GetMaxActiveIndex();
-    pmb->par_for(
-        "Turbulence::Fill Tracers", 0, max_active_index, KOKKOS_LAMBDA(const int n) {
+    Corr_t corr_block;
+    Kokkos::parallel_reduce(
+        "Turbulence::Fill Tracers",
+        Kokkos::RangePolicy<>(parthenon::DevExecSpace(), 0, max_active_index + 1),
+        KOKKOS_LAMBDA(const int n, Corr_t &lcorr) {
           if (swarm_d.IsActive(n)) {
             auto dncycle = static_cast<int>(Kokkos::pow(2, n_lookback - 2));
             auto s_idx = n_lookback - 1;
@@ -575,27 +1110,30 @@ TaskStatus ProblemFillTracers(MeshData<Real> *md, const parthenon::SimTime &tm,
             // Now that all s and sdot entries are updated, we calculate the (mean)
             // correlations
             for (s_idx = 0; s_idx < n_lookback; s_idx++) {
-              Kokkos::atomic_add(&corr(0, s_idx), s(0, n) * s(s_idx, n));
-              Kokkos::atomic_add(&corr(1, s_idx), sdot(0, n) * sdot(s_idx, n));
+              lcorr.v[s_idx] += s(0, n) * s(s_idx, n);
+              lcorr.v[ncorr + s_idx] += sdot(0, n) * sdot(s_idx, n);
             }
-            Kokkos::atomic_add(&corr(0, n_lookback), s(0, n));
-            Kokkos::atomic_add(&corr(1, n_lookback), sdot(0, n));
+            lcorr.v[n_lookback] += s(0, n);
+            lcorr.v[ncorr + n_lookback] += sdot(0, n);
           }
-        });
+        },
+        Kokkos::Sum<Corr_t>(corr_block));
+    corr += corr_block;
     num_particles_total += swarm->GetNumActive();
   } // loop over all blocks on this rank (this MeshData container)
 
-  // Results still live in device memory. Copy to host for global reduction and output.
-  auto corr_h = Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), corr);
+  const auto corr_h = [&corr](const int j, const int i) -> Real & {
+    return corr.v[j * ncorr + i];
+  };
 #ifdef MPI_PARALLEL
   if (parthenon::Globals::my_rank == 0) {
-    PARTHENON_MPI_CHECK(MPI_Reduce(MPI_IN_PLACE, corr_h.data(), corr_h.GetSize(),
-                                   MPI_PARTHENON_REAL, MPI_SUM, 0, MPI_COMM_WORLD));
+    PARTHENON_MPI_CHECK(MPI_Reduce(MPI_IN_PLACE, corr.v, 2 * ncorr, MPI_PARTHENON_REAL,
+                                   MPI_SUM, 0, MPI_COMM_WORLD));
     PARTHENON_MPI_CHECK(MPI_Reduce(MPI_IN_PLACE, &num_particles_total, 1, MPI_INT64_T,
                                    MPI_SUM, 0, MPI_COMM_WORLD));
   } else {
-    PARTHENON_MPI_CHECK(MPI_Reduce(corr_h.data(), corr_h.data(), corr_h.GetSize(),
-                                   MPI_PARTHENON_REAL, MPI_SUM, 0, MPI_COMM_WORLD));
+    PARTHENON_MPI_CHECK(MPI_Reduce(corr.v, corr.v, 2 * ncorr, MPI_PARTHENON_REAL,
+                                   MPI_SUM, 0, MPI_COMM_WORLD));
     PARTHENON_MPI_CHECK(MPI_Reduce(&num_particles_total, &num_particles_total, 1,
                                    MPI_INT64_T, MPI_SUM, 0, MPI_COMM_WORLD));
   }
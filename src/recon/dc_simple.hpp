@@ -22,13 +22,14 @@ using parthenon::ScratchPad2D;
 //  have been cached for the appropriate k, j (and plus 1) values. Thus, in x1dir ql needs
 //  to be offset by i+1 but for the other direction the offset has been set outside in the
 //  cached stencil.
+//  Only the variables [nl, nu] of q are reconstructed.
 template <Reconstruction recon, int XNDIR>
 KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::dc, void>::type
 Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<Real> &ql,
-            ScratchPad2D<Real> &qr) {
-  const auto nvar = q.GetDim(4);
-  for (auto n = 0; n < nvar; ++n) {
+            const int iu, const parthenon::VariablePack<Real> &q,
+            ScratchPad2D<ScratchReal> &ql, ScratchPad2D<ScratchReal> &qr, const int nl,
+            const int nu) {
+  for (auto n = nl; n <= nu; ++n) {
     parthenon::par_for_inner(member, il, iu, [&](const int i) {
       if constexpr (XNDIR == parthenon::X1DIR) {
         // ql is ql_ip1 and qr is qr_i
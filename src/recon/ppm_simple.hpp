@@ -28,6 +28,8 @@
 
 #include <parthenon/parthenon.hpp>
 
+#include "../utils/simd.hpp"
+
 using parthenon::ScratchPad2D;
 
 //----------------------------------------------------------------------------------------
@@ -35,9 +37,10 @@ using parthenon::ScratchPad2D;
 //  \brief Reconstructs parabolic slope in cell i to compute ql(i+1) and qr(i). Works for
 //  reconstruction in any dimension by passing in the appropriate q_im2,...,q _ip2.
 
+template <typename T>
 KOKKOS_INLINE_FUNCTION
 void PPM(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_ip1,
-         const Real &q_ip2, Real &ql_ip1, Real &qr_i) {
+         const Real &q_ip2, T &ql_ip1, T &qr_i) {
 
   // CS08 constant used in second derivative limiter, >1 , independent of h
   const Real C2 = 1.25;
@@ -105,8 +108,8 @@ void PPM(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_ip
 
   //--- Step 3. ------------------------------------------------------------------------
   // Compute cell-centered difference stencils (MC section 2.4.1)
-  const Real dqf_minus = q_i - qr_i; // (CS eq 25) = -dQ^- in Mignone's notation
-  const Real dqf_plus = ql_ip1 - q_i;
+  const Real dqf_minus = q_i - dph; // (CS eq 25) = -dQ^- in Mignone's notation
+  const Real dqf_plus = dph_ip1 - q_i;
 
   //--- Step 4. ------------------------------------------------------------------------
   // For uniform Cartesian-like coordinate: apply CS limiters to parabolic interpolant
@@ -161,6 +164,118 @@ void PPM(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_ip
   }
 }
 
+#ifdef ATHENAPK_HOST_SIMD
+//----------------------------------------------------------------------------------------
+//! \fn PPM()
+//  \brief SIMD version of the PPM reconstruction above (see utils/simd.hpp). The
+//  branches of the limiters are replaced by selects so that the results are identical.
+KOKKOS_INLINE_FUNCTION
+void PPM(const utils::simd::Vec &q_im2, const utils::simd::Vec &q_im1,
+         const utils::simd::Vec &q_i, const utils::simd::Vec &q_ip1,
+         const utils::simd::Vec &q_ip2, utils::simd::Vec &ql_ip1,
+         utils::simd::Vec &qr_i) {
+  using utils::simd::Abs, utils::simd::Max, utils::simd::Min, utils::simd::Select,
+      utils::simd::Sign, utils::simd::Vec;
+  using Mask = utils::simd::Mask;
+
+  const Real C2 = 1.25;
+  //--- Step 1. --------------------------------------------------------------------------
+  Vec qa = (q_i - q_im1);
+  Vec qb = (q_ip1 - q_i);
+  const Vec dd_im1 = 0.5 * qa + 0.5 * (q_im1 - q_im2);
+  const Vec dd = 0.5 * qb + 0.5 * qa;
+  const Vec dd_ip1 = 0.5 * (q_ip2 - q_ip1) + 0.5 * qb;
+
+  Vec dph = 0.5 * (q_im1 + q_i) + (dd_im1 - dd) / 6.0;
+  Vec dph_ip1 = 0.5 * (q_i + q_ip1) + (dd - dd_ip1) / 6.0;
+
+  //--- Step 2a. -----------------------------------------------------------------------
+  const Vec d2qc_im1 = q_im2 + q_i - 2.0 * q_im1;
+  const Vec d2qc = q_im1 + q_ip1 - 2.0 * q_i;
+  const Vec d2qc_ip1 = q_i + q_ip2 - 2.0 * q_ip1;
+
+  // i-1/2
+  Vec qa_tmp = dph - q_im1;
+  Vec qb_tmp = q_i - dph;
+  qa = 3.0 * (q_im1 + q_i - 2.0 * dph);
+  qb = d2qc_im1;
+  Vec qc = d2qc;
+  Vec qd = Select(Sign(qa) == Sign(qb) && Sign(qa) == Sign(qc),
+                  Sign(qa) * Min(C2 * Abs(qb), Min(C2 * Abs(qc), Abs(qa))), Vec(0.0));
+  const Vec dph_tmp = 0.5 * (q_im1 + q_i) - qd / 6.0;
+  dph = Select(qa_tmp * qb_tmp < Vec(0.0), dph_tmp, dph);
+
+  // i+1/2
+  qa_tmp = dph_ip1 - q_i;
+  qb_tmp = q_ip1 - dph_ip1;
+  qa = 3.0 * (q_i + q_ip1 - 2.0 * dph_ip1);
+  qb = d2qc;
+  qc = d2qc_ip1;
+  qd = Select(Sign(qa) == Sign(qb) && Sign(qa) == Sign(qc),
+              Sign(qa) * Min(C2 * Abs(qb), Min(C2 * Abs(qc), Abs(qa))), Vec(0.0));
+  const Vec dphip1_tmp = 0.5 * (q_i + q_ip1) - qd / 6.0;
+  dph_ip1 = Select(qa_tmp * qb_tmp < Vec(0.0), dphip1_tmp, dph_ip1);
+
+  const Vec d2qf = 6.0 * (dph + dph_ip1 - 2.0 * q_i);
+
+  qr_i = dph;
+  ql_ip1 = dph_ip1;
+
+  //--- Step 3. ------------------------------------------------------------------------
+  const Vec dqf_minus = q_i - dph;
+  const Vec dqf_plus = dph_ip1 - q_i;
+
+  //--- Step 4. ------------------------------------------------------------------------
+  qa_tmp = dqf_minus * dqf_plus;
+  qb_tmp = (q_ip1 - q_i) * (q_i - q_im1);
+
+  qa = d2qc_im1;
+  qb = d2qc;
+  qc = d2qc_ip1;
+  qd = d2qf;
+  const Vec qe = Select(Sign(qa) == Sign(qb) && Sign(qa) == Sign(qc) &&
+                            Sign(qa) == Sign(qd),
+                        Sign(qd) * Min(Min(C2 * Abs(qa), C2 * Abs(qb)),
+                                       Min(C2 * Abs(qc), Abs(qd))),
+                        Vec(0.0));
+
+  qa = Max(Abs(q_im1), Abs(q_im2));
+  qb = Max(Max(Abs(q_i), Abs(q_ip1)), Abs(q_ip2));
+
+  const Vec rho = Select(Abs(qd) > (1.0e-12) * Max(qa, qb), qe / qd, Vec(0.0));
+
+  const Vec tmp_m = q_i - rho * dqf_minus;
+  const Vec tmp_p = q_i + rho * dqf_plus;
+  const Vec tmp2_m = q_i - 2.0 * dqf_plus;
+  const Vec tmp2_p = q_i + 2.0 * dqf_minus;
+
+  const Mask extrema = qa_tmp <= Vec(0.0) || qb_tmp <= Vec(0.0);
+  const Mask smooth = extrema && rho <= Vec(1.0 - (1.0e-12));
+  qr_i = Select(smooth, tmp_m, qr_i);
+  ql_ip1 = Select(smooth, tmp_p, ql_ip1);
+  qr_i = Select(!extrema && Abs(dqf_minus) >= 2.0 * Abs(dqf_plus), tmp2_m, qr_i);
+  ql_ip1 = Select(!extrema && Abs(dqf_plus) >= 2.0 * Abs(dqf_minus), tmp2_p, ql_ip1);
+}
+#endif // ATHENAPK_HOST_SIMD
+
+//----------------------------------------------------------------------------------------
+//! \fn LinearPPM()
+//  \brief Unlimited PPM, i.e., the fourth order interface values of step 1 of PPM() (CW
+//  eq 1.6) without any limiter. Only used in smooth regions with hybrid reconstruction.
+template <typename T>
+KOKKOS_INLINE_FUNCTION void LinearPPM(const Real &q_im2, const Real &q_im1,
+                                      const Real &q_i, const Real &q_ip1,
+                                      const Real &q_ip2, T &ql_ip1, T &qr_i) {
+  const Real qa = (q_i - q_im1);
+  const Real qb = (q_ip1 - q_i);
+  const Real dd_im1 = 0.5 * qa + 0.5 * (q_im1 - q_im2);
+  const Real dd = 0.5 * qb + 0.5 * qa;
+  const Real dd_ip1 = 0.5 * (q_ip2 - q_ip1) + 0.5 * qb;
+
+  qr_i = 0.5 * (q_im1 + q_i) + (dd_im1 - dd) / 6.0;
+  ql_ip1 = 0.5 * (q_i + q_ip1) + (dd - dd_ip1) / 6.0;
+}
+
 //! \fn Reconstruct<Reconstruction::ppm, int DIR>()
 //  \brief Wrapper function for PPM reconstruction
 //  In X1DIR call over [is-1,ie+1] to get BOTH L/R states over [is,ie]
@@ -170,14 +285,21 @@ void PPM(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_ip
 //  have been cached for the appropriate k, j (and plus 1) values. Thus, in x1dir ql needs
 //  to be offset by i+1 but for the other direction the offset has been set outside in the
 //  cached stencil.
+//  Only the variables [nl, nu] of q are reconstructed.
 template <Reconstruction recon, int XNDIR>
 KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::ppm, void>::type
 Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<Real> &ql,
-            ScratchPad2D<Real> &qr) {
-  const auto nvar = q.GetDim(4);
-  for (auto n = 0; n < nvar; ++n) {
-    parthenon::par_for_inner(member, il, iu, [&](const int i) {
+            const int iu, const parthenon::VariablePack<Real> &q,
+            ScratchPad2D<ScratchReal> &ql, ScratchPad2D<ScratchReal> &qr, const int nl,
+            const int nu) {
+  int is = il;
+#ifdef ATHENAPK_HOST_SIMD
+  // Full SIMD-width chunks, the remainder is handled by the scalar loop below
+  is = utils::simd::ReconstructChunks<XNDIR>(member, k, j, il, iu, q, ql, qr, nl, nu,
+                                             [](auto &&...args) { PPM(args...); });
+#endif
+  for (auto n = nl; n <= nu; ++n) {
+    parthenon::par_for_inner(member, is, iu, [&](const int i) {
       if constexpr (XNDIR == parthenon::X1DIR) {
         // ql is ql_ip1 and qr is qr_i
         PPM(q(n, k, j, i - 2), q(n, k, j, i - 1), q(n, k, j, i), q(n, k, j, i + 1),
@@ -197,4 +319,34 @@ Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const
   }
 }
 
+//! \fn ReconstructLinear<Reconstruction::ppm, int DIR>()
+//  \brief Wrapper function for LinearPPM reconstruction with the same stencil, range,
+//  and storage layout as Reconstruct<Reconstruction::ppm, int DIR>() above.
+template <Reconstruction recon, int XNDIR>
+KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::ppm, void>::type
+ReconstructLinear(parthenon::team_mbr_t const &member, const int k, const int j,
+                  const int il, const int iu, const parthenon::VariablePack<Real> &q,
+                  ScratchPad2D<ScratchReal> &ql, ScratchPad2D<ScratchReal> &qr,
+                  const int nl, const int nu) {
+  for (auto n = nl; n <= nu; ++n) {
+    parthenon::par_for_inner(member, il, iu, [&](const int i) {
+      if constexpr (XNDIR == parthenon::X1DIR) {
+        // ql is ql_ip1 and qr is qr_i
+        LinearPPM(q(n, k, j, i - 2), q(n, k, j, i - 1), q(n, k, j, i), q(n, k, j, i + 1),
+                  q(n, k, j, i + 2), ql(n, i + 1), qr(n, i));
+      } else if constexpr (XNDIR == parthenon::X2DIR) {
+        // ql is ql_jp1 and qr is qr_j
+        LinearPPM(q(n, k, j - 2, i), q(n, k, j - 1, i), q(n, k, j, i), q(n, k, j + 1, i),
+                  q(n, k, j + 2, i), ql(n, i), qr(n, i));
+      } else if constexpr (XNDIR == parthenon::X3DIR) {
+        // ql is ql_kp1 and qr is qr_k
+        LinearPPM(q(n, k - 2, j, i), q(n, k - 1, j, i), q(n, k, j, i), q(n, k + 1, j, i),
+                  q(n, k + 2, j, i), ql(n, i), qr(n, i));
+      } else {
+        PARTHENON_FAIL("Unknow direction for LinearPPM reconstruction.")
+      }
+    });
+  }
+}
+
 #endif // RECONSTRUCT_PPM_SIMPLE_HPP_
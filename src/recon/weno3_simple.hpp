@@ -22,9 +22,10 @@ using parthenon::ScratchPad2D;
 //  \brief Reconstructs linear slope in cell i to compute ql(i+1) and qr(i). Works for
 //  reconstruction in any dimension by passing in the appropriate q_im1, q_i, and q_ip1.
 
+template <typename T>
 KOKKOS_INLINE_FUNCTION
-void WENO3(const Real &q_im1, const Real &q_i, const Real &q_ip1, Real &ql_ip1,
-           Real &qr_i, const Real &dx2) {
+void WENO3(const Real &q_im1, const Real &q_i, const Real &q_ip1, T &ql_ip1, T &qr_i,
+           const Real &dx2) {
 
   Real beta[2]; // (20) in YC09
   beta[0] = SQR(q_ip1 - q_i);
@@ -71,13 +72,14 @@ void WENO3(const Real &q_im1, const Real &q_i, const Real &q_ip1, Real &ql_ip1,
 //  have been cached for the appropriate k, j (and plus 1) values. Thus, in x1dir ql needs
 //  to be offset by i+1 but for the other direction the offset has been set outside in the
 //  cached stencil.
+//  Only the variables [nl, nu] of q are reconstructed.
 template <Reconstruction recon, int XNDIR>
 KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::weno3, void>::type
 Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<Real> &ql,
-            ScratchPad2D<Real> &qr) {
-  const auto nvar = q.GetDim(4);
-  for (auto n = 0; n < nvar; ++n) {
+            const int iu, const parthenon::VariablePack<Real> &q,
+            ScratchPad2D<ScratchReal> &ql, ScratchPad2D<ScratchReal> &qr, const int nl,
+            const int nu) {
+  for (auto n = nl; n <= nu; ++n) {
     parthenon::par_for_inner(member, il, iu, [&](const int i) {
       auto dx2 = q.GetCoords().Dxc<XNDIR>(k, j, i);
       dx2 = dx2 * dx2;
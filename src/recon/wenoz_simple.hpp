@@ -17,6 +17,8 @@
 
 #include <parthenon/parthenon.hpp>
 
+#include "../utils/simd.hpp"
+
 using parthenon::ScratchPad2D;
 
 //----------------------------------------------------------------------------------------
@@ -24,9 +26,10 @@ using parthenon::ScratchPad2D;
 //  \brief Reconstructs 5th-order polynomial in cell i to compute ql(i+1) and qr(i).
 //  Works for any dimension by passing in the appropriate q_im2,...,q _ip2.
 
+template <typename T>
 KOKKOS_INLINE_FUNCTION
 void WENOZ(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_ip1,
-           const Real &q_ip2, Real &ql_ip1, Real &qr_i) {
+           const Real &q_ip2, T &ql_ip1, T &qr_i) {
   // Smooth WENO weights: Note that these are from Del Zanna et al. 2007 (A.18)
   const Real beta_coeff[2]{13. / 12., 0.25};
 
@@ -80,6 +83,75 @@ void WENOZ(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_
   qr_i = (f[0] * alpha[0] + f[1] * alpha[1] + f[2] * alpha[2]) / alpha_sum;
 }
 
+#ifdef ATHENAPK_HOST_SIMD
+//----------------------------------------------------------------------------------------
+//! \fn WENOZ()
+//  \brief SIMD version of the WENOZ reconstruction above (see utils/simd.hpp)
+KOKKOS_INLINE_FUNCTION
+void WENOZ(const utils::simd::Vec &q_im2, const utils::simd::Vec &q_im1,
+           const utils::simd::Vec &q_i, const utils::simd::Vec &q_ip1,
+           const utils::simd::Vec &q_ip2, utils::simd::Vec &ql_ip1,
+           utils::simd::Vec &qr_i) {
+  using utils::simd::Vec;
+  const Real beta_coeff[2]{13. / 12., 0.25};
+
+  Vec beta[3];
+  beta[0] = beta_coeff[0] * SQR(q_im2 + q_i - 2.0 * q_im1) +
+            beta_coeff[1] * SQR(q_im2 + 3.0 * q_i - 4.0 * q_im1);
+
+  beta[1] =
+      beta_coeff[0] * SQR(q_im1 + q_ip1 - 2.0 * q_i) + beta_coeff[1] * SQR(q_im1 - q_ip1);
+
+  beta[2] = beta_coeff[0] * SQR(q_ip2 + q_i - 2.0 * q_ip1) +
+            beta_coeff[1] * SQR(q_ip2 + 3.0 * q_i - 4.0 * q_ip1);
+
+  const Real epsL = 1.0e-42;
+
+  const Vec tau_5 = utils::simd::Abs(beta[0] - beta[2]);
+
+  Vec indicator[3];
+  indicator[0] = tau_5 / (beta[0] + epsL);
+  indicator[1] = tau_5 / (beta[1] + epsL);
+  indicator[2] = tau_5 / (beta[2] + epsL);
+
+  Vec f[3];
+  f[0] = (2.0 * q_im2 - 7.0 * q_im1 + 11.0 * q_i);
+  f[1] = (-1.0 * q_im1 + 5.0 * q_i + 2.0 * q_ip1);
+  f[2] = (2.0 * q_i + 5.0 * q_ip1 - q_ip2);
+
+  Vec alpha[3];
+  alpha[0] = 0.1 * (1.0 + SQR(indicator[0]));
+  alpha[1] = 0.6 * (1.0 + SQR(indicator[1]));
+  alpha[2] = 0.3 * (1.0 + SQR(indicator[2]));
+  Vec alpha_sum = 6.0 * (alpha[0] + alpha[1] + alpha[2]);
+
+  ql_ip1 = (f[0] * alpha[0] + f[1] * alpha[1] + f[2] * alpha[2]) / alpha_sum;
+
+  f[0] = (2.0 * q_ip2 - 7.0 * q_ip1 + 11.0 * q_i);
+  f[1] = (-1.0 * q_ip1 + 5.0 * q_i + 2.0 * q_im1);
+  f[2] = (2.0 * q_i + 5.0 * q_im1 - q_im2);
+
+  alpha[0] = 0.1 * (1.0 + SQR(indicator[2]));
+  alpha[1] = 0.6 * (1.0 + SQR(indicator[1]));
+  alpha[2] = 0.3 * (1.0 + SQR(indicator[0]));
+  alpha_sum = 6.0 * (alpha[0] + alpha[1] + alpha[2]);
+
+  qr_i = (f[0] * alpha[0] + f[1] * alpha[1] + f[2] * alpha[2]) / alpha_sum;
+}
+#endif // ATHENAPK_HOST_SIMD
+
+//----------------------------------------------------------------------------------------
+//! \fn LinearWENOZ()
+//  \brief WENOZ() with the ideal (linear) weights, i.e., the upwind-biased fifth order
+//  interface values. Only used in smooth regions with hybrid reconstruction.
+template <typename T>
+KOKKOS_INLINE_FUNCTION void LinearWENOZ(const Real &q_im2, const Real &q_im1,
+                                        const Real &q_i, const Real &q_ip1,
+                                        const Real &q_ip2, T &ql_ip1, T &qr_i) {
+  ql_ip1 = (2.0 * q_im2 - 13.0 * q_im1 + 47.0 * q_i + 27.0 * q_ip1 - 3.0 * q_ip2) / 60.0;
+  qr_i = (2.0 * q_ip2 - 13.0 * q_ip1 + 47.0 * q_i + 27.0 * q_im1 - 3.0 * q_im2) / 60.0;
+}
+
 //! \fn Reconstruct<Reconstruction::wenoz, int DIR>()
 //  \brief Wrapper function for WENOZ reconstruction
 //  In X1DIR call over [is-1,ie+1] to get BOTH L/R states over [is,ie]
@@ -89,14 +161,21 @@ void WENOZ(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_
 //  have been cached for the appropriate k, j (and plus 1) values. Thus, in x1dir ql needs
 //  to be offset by i+1 but for the other direction the offset has been set outside in the
 //  cached stencil.
+//  Only the variables [nl, nu] of q are reconstructed.
 template <Reconstruction recon, int XNDIR>
 KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::wenoz, void>::type
 Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<Real> &ql,
-            ScratchPad2D<Real> &qr) {
-  const auto nvar = q.GetDim(4);
-  for (auto n = 0; n < nvar; ++n) {
-    parthenon::par_for_inner(member, il, iu, [&](const int i) {
+            const int iu, const parthenon::VariablePack<Real> &q,
+            ScratchPad2D<ScratchReal> &ql, ScratchPad2D<ScratchReal> &qr, const int nl,
+            const int nu) {
+  int is = il;
+#ifdef ATHENAPK_HOST_SIMD
+  // Full SIMD-width chunks, the remainder is handled by the scalar loop below
+  is = utils::simd::ReconstructChunks<XNDIR>(member, k, j, il, iu, q, ql, qr, nl, nu,
+                                             [](auto &&...args) { WENOZ(args...); });
+#endif
+  for (auto n = nl; n <= nu; ++n) {
+    parthenon::par_for_inner(member, is, iu, [&](const int i) {
       if constexpr (XNDIR == parthenon::X1DIR) {
         // ql is ql_ip1 and qr is qr_i
         WENOZ(q(n, k, j, i - 2), q(n, k, j, i - 1), q(n, k, j, i), q(n, k, j, i + 1),
@@ -116,4 +195,34 @@ Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const
   }
 }
 
+//! \fn ReconstructLinear<Reconstruction::wenoz, int DIR>()
+//  \brief Wrapper function for LinearWENOZ reconstruction with the same stencil, range,
+//  and storage layout as Reconstruct<Reconstruction::wenoz, int DIR>() above.
+template <Reconstruction recon, int XNDIR>
+KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::wenoz, void>::type
+ReconstructLinear(parthenon::team_mbr_t const &member, const int k, const int j,
+                  const int il, const int iu, const parthenon::VariablePack<Real> &q,
+                  ScratchPad2D<ScratchReal> &ql, ScratchPad2D<ScratchReal> &qr,
+                  const int nl, const int nu) {
+  for (auto n = nl; n <= nu; ++n) {
+    parthenon::par_for_inner(member, il, iu, [&](const int i) {
+      if constexpr (XNDIR == parthenon::X1DIR) {
+        // ql is ql_ip1 and qr is qr_i
+        LinearWENOZ(q(n, k, j, i - 2), q(n, k, j, i - 1), q(n, k, j, i),
+                    q(n, k, j, i + 1), q(n, k, j, i + 2), ql(n, i + 1), qr(n, i));
+      } else if constexpr (XNDIR == parthenon::X2DIR) {
+        // ql is ql_jp1 and qr is qr_j
+        LinearWENOZ(q(n, k, j - 2, i), q(n, k, j - 1, i), q(n, k, j, i),
+                    q(n, k, j + 1, i), q(n, k, j + 2, i), ql(n, i), qr(n, i));
+      } else if constexpr (XNDIR == parthenon::X3DIR) {
+        // ql is ql_kp1 and qr is qr_k
+        LinearWENOZ(q(n, k - 2, j, i), q(n, k - 1, j, i), q(n, k, j, i),
+                    q(n, k + 1, j, i), q(n, k + 2, j, i), ql(n, i), qr(n, i));
+      } else {
+        PARTHENON_FAIL("Unknow direction for LinearWENOZ reconstruction.")
+      }
+    });
+  }
+}
+
 #endif // RECONSTRUCT_WENOZ_SIMPLE_HPP_
@@ -0,0 +1,205 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file combined.cpp
+//  \brief Evaluation of multiple refinement criteria in a single pass
+
+// C++ headers
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+// AthenaPK headers
+#include "../main.hpp"
+#include "criteria.hpp"
+#include "refinement.hpp"
+
+namespace refinement {
+
+using parthenon::IndexDomain;
+
+namespace {
+enum Criterion { pressure_gradient, xyvelocity_gradient, density_2nd_deriv, maxdensity };
+constexpr int ncriteria = 4;
+
+// Tagging thresholds and cell range (as used by the individual criterion)
+struct CriterionConfig {
+  bool active = false;
+  Real refine_above = std::numeric_limits<Real>::max();
+  Real deref_below = std::numeric_limits<Real>::lowest();
+  // An empty range results in AmrTag::same (e.g., for unsupported dimensions)
+  int ks = 0, ke = -1, js = 0, je = -1, is = 0, ie = -1;
+
+  KOKKOS_INLINE_FUNCTION bool Contains(const int k, const int j, const int i) const {
+    return k >= ks && k <= ke && j >= js && j <= je && i >= is && i <= ie;
+  }
+};
+
+struct BlockMaxima {
+  Real v[ncriteria];
+};
+
+// Reducer for the element-wise maxima of BlockMaxima
+struct MaxOfEach {
+  using reducer = MaxOfEach;
+  using value_type = BlockMaxima;
+  using result_view_type =
+      Kokkos::View<value_type, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>;
+
+  KOKKOS_INLINE_FUNCTION explicit MaxOfEach(value_type &value) : value_(&value) {}
+
+  KOKKOS_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const {
+    for (int c = 0; c < ncriteria; c++) {
+      dest.v[c] = src.v[c] > dest.v[c] ? src.v[c] : dest.v[c];
+    }
+  }
+  KOKKOS_INLINE_FUNCTION void init(value_type &val) const {
+    for (int c = 0; c < ncriteria; c++) {
+      val.v[c] = Kokkos::reduction_identity<Real>::max();
+    }
+  }
+  KOKKOS_INLINE_FUNCTION value_type &reference() const { return *value_; }
+  KOKKOS_INLINE_FUNCTION result_view_type view() const {
+    return result_view_type(value_);
+  }
+  KOKKOS_INLINE_FUNCTION bool references_scalar() const { return true; }
+
+ private:
+  value_type *value_;
+};
+} // namespace
+
+void Combined(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const auto &combined = hydro_pkg->Param<CombinedCriteria>("refinement/combined");
+  const auto w = md->PackVariables(std::vector<std::string>{"prim"});
+  const int ndim = pmb->pmy_mesh->ndim;
+
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+
+  CriterionConfig cfg[ncriteria];
+  if (combined.pressure_gradient) {
+    auto &c = cfg[pressure_gradient];
+    c.active = true;
+    if (ndim >= 2) {
+      const auto thr = hydro_pkg->Param<Real>("refinement/threshold_pressure_gradient");
+      c.refine_above = thr;
+      c.deref_below =
+          hydro_pkg->Param<Real>("refinement/derefine_threshold_pressure_gradient");
+      c.ks = ndim == 3 ? kb.s - 1 : kb.s;
+      c.ke = ndim == 3 ? kb.e + 1 : kb.s;
+      c.js = jb.s - 1, c.je = jb.e + 1, c.is = ib.s - 1, c.ie = ib.e + 1;
+    }
+  }
+  if (combined.xyvelocity_gradient) {
+    auto &c = cfg[xyvelocity_gradient];
+    const auto thr = hydro_pkg->Param<Real>("refinement/threshold_xyvelocity_gradient");
+    c.active = true;
+    c.refine_above = thr;
+    c.deref_below =
+        hydro_pkg->Param<Real>("refinement/derefine_threshold_xyvelocity_gradient");
+    c.ks = kb.s, c.ke = kb.e, c.js = jb.s - 1, c.je = jb.e + 1;
+    c.is = ib.s - 1, c.ie = ib.e + 1;
+  }
+  Real epsilon = 0.0;
+  if (combined.density_2nd_deriv_err_norm) {
+    auto &c = cfg[density_2nd_deriv];
+    c.active = true;
+    if (ndim == 3) {
+      c.refine_above = hydro_pkg->Param<Real>("refinement/threshold_density_2nd_deriv");
+      c.deref_below =
+          hydro_pkg->Param<Real>("refinement/derefine_threshold_density_2nd_deriv");
+      epsilon = hydro_pkg->Param<Real>("refinement/epsilon_density_2nd_deriv");
+      c.ks = kb.s - 1, c.ke = kb.e + 1, c.js = jb.s - 1, c.je = jb.e + 1;
+      c.is = ib.s - 1, c.ie = ib.e + 1;
+    }
+  }
+  if (combined.maxdensity) {
+    auto &c = cfg[maxdensity];
+    c.active = true;
+    c.refine_above = hydro_pkg->Param<Real>("refinement/maxdensity_refine_above");
+    c.deref_below = hydro_pkg->Param<Real>("refinement/maxdensity_deref_below");
+    c.ks = kb.s, c.ke = kb.e, c.js = jb.s, c.je = jb.e, c.is = ib.s, c.ie = ib.e + 1;
+  }
+
+  // Union of the cell ranges of all criteria
+  int ks = kb.s, ke = kb.e, js = jb.s, je = jb.e, is = ib.s, ie = ib.e;
+  for (const auto &c : cfg) {
+    if (c.active && c.ke >= c.ks) {
+      ks = std::min(ks, c.ks), ke = std::max(ke, c.ke);
+      js = std::min(js, c.js), je = std::max(je, c.je);
+      is = std::min(is, c.is), ie = std::max(ie, c.ie);
+    }
+  }
+  const int nj = je - js + 1;
+  const int ni = ie - is + 1;
+  const int ncells = (ke - ks + 1) * nj * ni;
+  const bool combine_min = combined.combine_min;
+
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, "check refine: combined", parthenon::DevExecSpace(), 0,
+      0, 0, md->NumBlocks() - 1,
+      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b) {
+        const auto &wb = w(b);
+        BlockMaxima maxima;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(member, ncells),
+            [&](const int n, BlockMaxima &lmaxima) {
+              const int k = ks + n / (nj * ni);
+              const int j = js + (n / ni) % nj;
+              const int i = is + n % ni;
+              Real value[ncriteria];
+              for (int c = 0; c < ncriteria; c++) {
+                value[c] = Kokkos::reduction_identity<Real>::max();
+              }
+              if (cfg[pressure_gradient].active &&
+                  cfg[pressure_gradient].Contains(k, j, i)) {
+                value[pressure_gradient] =
+                    criteria::PressureGradient(wb, ndim == 3, k, j, i);
+              }
+              if (cfg[xyvelocity_gradient].active &&
+                  cfg[xyvelocity_gradient].Contains(k, j, i)) {
+                value[xyvelocity_gradient] = criteria::VelocityGradient(wb, k, j, i);
+              }
+              if (cfg[density_2nd_deriv].active &&
+                  cfg[density_2nd_deriv].Contains(k, j, i)) {
+                value[density_2nd_deriv] =
+                    criteria::Density2ndDerivErrorNorm(wb, epsilon, k, j, i);
+              }
+              if (cfg[maxdensity].active && cfg[maxdensity].Contains(k, j, i)) {
+                value[maxdensity] = criteria::Density(wb, k, j, i);
+              }
+              for (int c = 0; c < ncriteria; c++) {
+                lmaxima.v[c] = value[c] > lmaxima.v[c] ? value[c] : lmaxima.v[c];
+              }
+            },
+            MaxOfEach(maxima));
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          int tag = static_cast<int>(combine_min ? AmrTag::refine : AmrTag::derefine);
+          for (int c = 0; c < ncriteria; c++) {
+            if (!cfg[c].active) {
+              continue;
+            }
+            auto tag_c = AmrTag::same;
+            if (maxima.v[c] > cfg[c].refine_above) {
+              tag_c = AmrTag::refine;
+            } else if (maxima.v[c] < cfg[c].deref_below) {
+              tag_c = AmrTag::derefine;
+            }
+            tag = combine_min ? std::min(tag, static_cast<int>(tag_c))
+                              : std::max(tag, static_cast<int>(tag_c));
+          }
+          if (tag > static_cast<int>(amr_tags(b))) {
+            amr_tags(b) = static_cast<AmrTag>(tag);
+          }
+        });
+      });
+}
+
+} // namespace refinement
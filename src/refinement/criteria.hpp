@@ -0,0 +1,94 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file criteria.hpp
+//  \brief Cell values of the refinement criteria
+//
+// Shared by the individual criteria and the combined (single pass) evaluation.
+// w are the primitive variables of a single block.
+#ifndef REFINEMENT_CRITERIA_HPP_
+#define REFINEMENT_CRITERIA_HPP_
+
+// C++ headers
+#include <cmath>
+
+// Parthenon headers
+#include <parthenon/parthenon.hpp>
+
+// AthenaPK headers
+#include "../main.hpp"
+
+namespace refinement {
+namespace criteria {
+
+using parthenon::Real;
+
+// Relative pressure gradient (3D or 2D)
+template <typename TPrim>
+KOKKOS_INLINE_FUNCTION Real PressureGradient(const TPrim &w, const bool three_d,
+                                             const int k, const int j, const int i) {
+  if (three_d) {
+    return std::sqrt(SQR(0.5 * (w(IPR, k, j, i + 1) - w(IPR, k, j, i - 1))) +
+                     SQR(0.5 * (w(IPR, k, j + 1, i) - w(IPR, k, j - 1, i))) +
+                     SQR(0.5 * (w(IPR, k + 1, j, i) - w(IPR, k - 1, j, i)))) /
+           w(IPR, k, j, i);
+  }
+  return std::sqrt(SQR(0.5 * (w(IPR, k, j, i + 1) - w(IPR, k, j, i - 1))) +
+                   SQR(0.5 * (w(IPR, k, j + 1, i) - w(IPR, k, j - 1, i)))) /
+         w(IPR, k, j, i);
+}
+
+// 2D (xy) velocity gradient
+template <typename TPrim>
+KOKKOS_INLINE_FUNCTION Real VelocityGradient(const TPrim &w, const int k, const int j,
+                                             const int i) {
+  Real vgy = std::abs(w(IV2, k, j, i + 1) - w(IV2, k, j, i - 1)) * 0.5;
+  Real vgx = std::abs(w(IV1, k, j + 1, i) - w(IV1, k, j - 1, i)) * 0.5;
+  return std::sqrt(vgx * vgx + vgy * vgy);
+}
+
+// Second derivative error norm of the density (3D, based on Lohner 1987 and Mignone et
+// al 2012)
+template <typename TPrim>
+KOKKOS_INLINE_FUNCTION Real Density2ndDerivErrorNorm(const TPrim &w, const Real epsilon,
+                                                     const int k, const int j,
+                                                     const int i) {
+  // Squared second order derivatives in each dimension
+  Real numerator =
+      SQR((w(IDN, k, j, i + 1) + w(IDN, k, j, i - 1) - 2 * w(IDN, k, j, i))) +
+      SQR((w(IDN, k, j + 1, i) + w(IDN, k, j - 1, i) - 2 * w(IDN, k, j, i))) +
+      SQR((w(IDN, k + 1, j, i) + w(IDN, k - 1, j, i) - 2 * w(IDN, k, j, i)));
+
+  Real denominator = SQR(std::abs(w(IDN, k, j, i + 1) - w(IDN, k, j, i)) +
+                         std::abs(w(IDN, k, j, i) - w(IDN, k, j, i - 1)) +
+                         epsilon * (std::abs(w(IDN, k, j, i + 1)) +
+                                    std::abs(w(IDN, k, j, i)) * 2.0 +
+                                    std::abs(w(IDN, k, j, i - 1))));
+  denominator += SQR(std::abs(w(IDN, k, j + 1, i) - w(IDN, k, j, i)) +
+                     std::abs(w(IDN, k, j, i) - w(IDN, k, j - 1, i)) +
+                     epsilon * (std::abs(w(IDN, k, j + 1, i)) +
+                                std::abs(w(IDN, k, j, i)) * 2.0 +
+                                std::abs(w(IDN, k, j - 1, i))));
+
+  denominator += SQR(std::abs(w(IDN, k + 1, j, i) - w(IDN, k, j, i)) +
+                     std::abs(w(IDN, k, j, i) - w(IDN, k - 1, j, i)) +
+                     epsilon * (std::abs(w(IDN, k + 1, j, i)) +
+                                std::abs(w(IDN, k, j, i)) * 2.0 +
+                                std::abs(w(IDN, k - 1, j, i))));
+
+  return std::sqrt(numerator / denominator);
+}
+
+// Density (for the maximum density criterion)
+template <typename TPrim>
+KOKKOS_INLINE_FUNCTION Real Density(const TPrim &w, const int k, const int j,
+                                    const int i) {
+  return w(IDN, k, j, i);
+}
+
+} // namespace criteria
+} // namespace refinement
+
+#endif // REFINEMENT_CRITERIA_HPP_
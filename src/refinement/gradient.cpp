@@ -6,8 +6,11 @@
 
 // AthenaPK headers
 #include "../main.hpp"
+#include "criteria.hpp"
 #include "refinement.hpp"
 #include <cmath>
+#include <string>
+#include <vector>
 
 namespace refinement {
 namespace gradient {
@@ -15,87 +18,78 @@ namespace gradient {
 using parthenon::IndexDomain;
 using parthenon::IndexRange;
 
+// Blocks that are not tagged by a criterion (e.g., in 1D) keep their level
+void TagSame(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags) {
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "check refine: same", parthenon::DevExecSpace(), 0,
+      md->NumBlocks() - 1, KOKKOS_LAMBDA(const int b) {
+        if (static_cast<int>(amr_tags(b)) < static_cast<int>(AmrTag::same)) {
+          amr_tags(b) = AmrTag::same;
+        }
+      });
+}
+
 // refinement condition: check the maximum pressure gradient
-AmrTag PressureGradient(MeshBlockData<Real> *rc) {
-  auto pmb = rc->GetBlockPointer();
-  auto w = rc->Get("prim").data;
+void PressureGradient(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  const auto w = md->PackVariables(std::vector<std::string>{"prim"});
 
-  const auto threshold =
-      pmb->packages.Get("Hydro")->Param<Real>("refinement/threshold_pressure_gradient");
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const auto threshold = hydro_pkg->Param<Real>("refinement/threshold_pressure_gradient");
+  const auto deref_threshold =
+      hydro_pkg->Param<Real>("refinement/derefine_threshold_pressure_gradient");
 
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
 
-  Real maxeps = 0.0;
   if (pmb->pmy_mesh->ndim == 3) {
-
-    pmb->par_reduce(
-        "check refine: pressure gradient", kb.s - 1, kb.e + 1, jb.s - 1, jb.e + 1,
-        ib.s - 1, ib.e + 1,
-        KOKKOS_LAMBDA(const int k, const int j, const int i, Real &lmaxeps) {
-          Real eps = std::sqrt(SQR(0.5 * (w(IPR, k, j, i + 1) - w(IPR, k, j, i - 1))) +
-                               SQR(0.5 * (w(IPR, k, j + 1, i) - w(IPR, k, j - 1, i))) +
-                               SQR(0.5 * (w(IPR, k + 1, j, i) - w(IPR, k - 1, j, i)))) /
-                     w(IPR, k, j, i);
-          lmaxeps = std::max(lmaxeps, eps);
-        },
-        Kokkos::Max<Real>(maxeps));
+    TagBlocks(
+        "check refine: pressure gradient", md, amr_tags, {kb.s - 1, kb.e + 1},
+        {jb.s - 1, jb.e + 1}, {ib.s - 1, ib.e + 1}, threshold, deref_threshold,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          return criteria::PressureGradient(w(b), true, k, j, i);
+        });
   } else if (pmb->pmy_mesh->ndim == 2) {
-    int k = kb.s;
-    pmb->par_reduce(
-        "check refine: pressure gradient", jb.s - 1, jb.e + 1, ib.s - 1, ib.e + 1,
-        KOKKOS_LAMBDA(const int j, const int i, Real &lmaxeps) {
-          Real eps = std::sqrt(SQR(0.5 * (w(IPR, k, j, i + 1) - w(IPR, k, j, i - 1))) +
-                               SQR(0.5 * (w(IPR, k, j + 1, i) - w(IPR, k, j - 1, i)))) /
-                     w(IPR, k, j, i);
-          lmaxeps = std::max(lmaxeps, eps);
-        },
-        Kokkos::Max<Real>(maxeps));
+    TagBlocks(
+        "check refine: pressure gradient", md, amr_tags, {kb.s, kb.s},
+        {jb.s - 1, jb.e + 1}, {ib.s - 1, ib.e + 1}, threshold, deref_threshold,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          return criteria::PressureGradient(w(b), false, k, j, i);
+        });
   } else {
-    return AmrTag::same;
+    TagSame(md, amr_tags);
   }
-
-  if (maxeps > threshold) return AmrTag::refine;
-  if (maxeps < 0.25 * threshold) return AmrTag::derefine;
-  return AmrTag::same;
 }
 
 // refinement condition: check the maximum 2D velocity gradient
-AmrTag VelocityGradient(MeshBlockData<Real> *rc) {
-  auto pmb = rc->GetBlockPointer();
-  auto w = rc->Get("prim").data;
+void VelocityGradient(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  const auto w = md->PackVariables(std::vector<std::string>{"prim"});
 
+  auto hydro_pkg = pmb->packages.Get("Hydro");
   const auto threshold =
-      pmb->packages.Get("Hydro")->Param<Real>("refinement/threshold_xyvelocity_gradient");
+      hydro_pkg->Param<Real>("refinement/threshold_xyvelocity_gradient");
+  const auto deref_threshold =
+      hydro_pkg->Param<Real>("refinement/derefine_threshold_xyvelocity_gradient");
 
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
 
-  Real vgmax = 0.0;
-
-  pmb->par_reduce(
-      "check refine: velocity gradient", kb.s, kb.e, jb.s - 1, jb.e + 1, ib.s - 1,
-      ib.e + 1,
-      KOKKOS_LAMBDA(const int k, const int j, const int i, Real &lvgmax) {
-        Real vgy = std::abs(w(IV2, k, j, i + 1) - w(IV2, k, j, i - 1)) * 0.5;
-        Real vgx = std::abs(w(IV1, k, j + 1, i) - w(IV1, k, j - 1, i)) * 0.5;
-        Real vg = std::sqrt(vgx * vgx + vgy * vgy);
-        if (vg > lvgmax) lvgmax = vg;
-      },
-      Kokkos::Max<Real>(vgmax));
-
-  if (vgmax > threshold) return AmrTag::refine;
-  if (vgmax < 0.5 * threshold) return AmrTag::derefine;
-  return AmrTag::same;
+  TagBlocks(
+      "check refine: velocity gradient", md, amr_tags, kb, {jb.s - 1, jb.e + 1},
+      {ib.s - 1, ib.e + 1}, threshold, deref_threshold,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        return criteria::VelocityGradient(w(b), k, j, i);
+      });
 }
 
 // refinement condition: check the maximum value of the second derivative error norm
 // of the density (based on Lohner 1987 and Mignone et al 2012)
-AmrTag Density2ndDerivErrorNorm(MeshBlockData<Real> *rc) {
-  auto pmb = rc->GetBlockPointer();
-  auto w = rc->Get("prim").data;
+void Density2ndDerivErrorNorm(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  const auto w = md->PackVariables(std::vector<std::string>{"prim"});
 
   // Extract parameters for the refinement
   const Real threshold =
@@ -109,48 +103,17 @@ AmrTag Density2ndDerivErrorNorm(MeshBlockData<Real> *rc) {
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
 
-  Real max_norm_error = 0.0;
   if (pmb->pmy_mesh->ndim == 3) {
-
-    pmb->par_reduce(
-        "check refine: density 2nd derivative error norm", kb.s - 1, kb.e + 1, jb.s - 1,
-        jb.e + 1, ib.s - 1, ib.e + 1,
-        KOKKOS_LAMBDA(const int k, const int j, const int i, Real &lmax_norm_error) {
-          // Squared second order derivatives in each dimension
-          Real numerator =
-              SQR((w(IDN, k, j, i + 1) + w(IDN, k, j, i - 1) - 2 * w(IDN, k, j, i))) +
-              SQR((w(IDN, k, j + 1, i) + w(IDN, k, j - 1, i) - 2 * w(IDN, k, j, i))) +
-              SQR((w(IDN, k + 1, j, i) + w(IDN, k - 1, j, i) - 2 * w(IDN, k, j, i)));
-
-          Real denominator = SQR(std::abs(w(IDN, k, j, i + 1) - w(IDN, k, j, i)) +
-                                 std::abs(w(IDN, k, j, i) - w(IDN, k, j, i - 1)) +
-                                 epsilon * (std::abs(w(IDN, k, j, i + 1)) +
-                                            std::abs(w(IDN, k, j, i)) * 2.0 +
-                                            std::abs(w(IDN, k, j, i - 1))));
-          denominator += SQR(std::abs(w(IDN, k, j + 1, i) - w(IDN, k, j, i)) +
-                             std::abs(w(IDN, k, j, i) - w(IDN, k, j - 1, i)) +
-                             epsilon * (std::abs(w(IDN, k, j + 1, i)) +
-                                        std::abs(w(IDN, k, j, i)) * 2.0 +
-                                        std::abs(w(IDN, k, j - 1, i))));
-
-          denominator += SQR(std::abs(w(IDN, k + 1, j, i) - w(IDN, k, j, i)) +
-                             std::abs(w(IDN, k, j, i) - w(IDN, k - 1, j, i)) +
-                             epsilon * (std::abs(w(IDN, k + 1, j, i)) +
-                                        std::abs(w(IDN, k, j, i)) * 2.0 +
-                                        std::abs(w(IDN, k - 1, j, i))));
-
-          Real snd_deriv_norm_error = std::sqrt(numerator / denominator);
-
-          lmax_norm_error = std::max(lmax_norm_error, snd_deriv_norm_error);
-        },
-        Kokkos::Max<Real>(max_norm_error));
+    TagBlocks(
+        "check refine: density 2nd derivative error norm", md, amr_tags,
+        {kb.s - 1, kb.e + 1}, {jb.s - 1, jb.e + 1}, {ib.s - 1, ib.e + 1}, threshold,
+        deref_threshold,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          return criteria::Density2ndDerivErrorNorm(w(b), epsilon, k, j, i);
+        });
   } else {
-    return AmrTag::same;
+    TagSame(md, amr_tags);
   }
-
-  if (max_norm_error > threshold) return AmrTag::refine;
-  if (max_norm_error < deref_threshold) return AmrTag::derefine;
-  return AmrTag::same;
 }
 
 } // namespace gradient
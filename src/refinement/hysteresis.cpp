@@ -0,0 +1,67 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file hysteresis.cpp
+//  \brief Suppression of the derefinement of recently created blocks
+
+// C++ headers
+#include <string>
+
+// AthenaPK headers
+#include "../main.hpp"
+#include "../utils/shared_params.hpp"
+#include "refinement.hpp"
+
+namespace refinement {
+
+void EnforceMinDerefineAge(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const auto min_age = hydro_pkg->Param<int>("refinement/min_derefine_age");
+  const int ncycle = pmb->pmy_mesh->ncycle;
+
+  // Blocks younger than min_derefine_age cycles must not be derefined
+  ParArray1D<bool> young("young", md->NumBlocks());
+  auto young_h = Kokkos::create_mirror_view(young);
+  utils::shared_params::WithMutableParam<BlockAges>(
+      hydro_pkg.get(), "refinement/block_ages", [&](BlockAges *ages) {
+        // Start of a new check (for all partitions). Blocks that have not been seen in
+        // the previous check no longer exist (on this rank).
+        if (ncycle != ages->current_check) {
+          ages->previous_check = ages->current_check;
+          ages->current_check = ncycle;
+          for (auto it = ages->blocks.begin(); it != ages->blocks.end();) {
+            if (it->second.last_seen < ages->previous_check) {
+              it = ages->blocks.erase(it);
+            } else {
+              ++it;
+            }
+          }
+        }
+        for (int b = 0; b < md->NumBlocks(); b++) {
+          const auto &loc = md->GetBlockData(b)->GetBlockPointer()->loc;
+          const BlockAges::Key key = {loc.level(), loc.lx1(), loc.lx2(), loc.lx3()};
+          auto it = ages->blocks.find(key);
+          if (it == ages->blocks.end()) {
+            // Blocks of the initial mesh are considered old
+            const int created = ages->previous_check < 0 ? ncycle - min_age : ncycle;
+            it = ages->blocks.emplace(key, BlockAges::Entry{created, ncycle}).first;
+          }
+          it->second.last_seen = ncycle;
+          young_h(b) = ncycle - it->second.created < min_age;
+        }
+      });
+  Kokkos::deep_copy(young, young_h);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "check refine: min derefine age", parthenon::DevExecSpace(),
+      0, md->NumBlocks() - 1, KOKKOS_LAMBDA(const int b) {
+        if (young(b) && amr_tags(b) == AmrTag::derefine) {
+          amr_tags(b) = AmrTag::same;
+        }
+      });
+}
+
+} // namespace refinement
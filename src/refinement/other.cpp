@@ -6,8 +6,13 @@
 
 // AthenaPK headers
 #include "../main.hpp"
+#include "criteria.hpp"
 #include "refinement.hpp"
 
+// C++ headers
+#include <string>
+#include <vector>
+
 namespace refinement {
 namespace other {
 
@@ -15,9 +20,9 @@ using parthenon::IndexDomain;
 using parthenon::IndexRange;
 
 // refinement condition: check max density
-parthenon::AmrTag MaxDensity(MeshBlockData<Real> *rc) {
-  auto pmb = rc->GetBlockPointer();
-  auto w = rc->Get("prim").data;
+void MaxDensity(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  const auto w = md->PackVariables(std::vector<std::string>{"prim"});
   const auto deref_below =
       pmb->packages.Get("Hydro")->Param<Real>("refinement/maxdensity_deref_below");
   const auto refine_above =
@@ -27,17 +32,11 @@ parthenon::AmrTag MaxDensity(MeshBlockData<Real> *rc) {
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
 
-  Real maxrho = 0.0;
-  pmb->par_reduce(
-      "overdens check refinement", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e + 1,
-      KOKKOS_LAMBDA(const int k, const int j, const int i, Real &lmaxrho) {
-        lmaxrho = std::max(lmaxrho, w(IDN, k, j, i));
-      },
-      Kokkos::Max<Real>(maxrho));
-
-  if (maxrho > refine_above) return parthenon::AmrTag::refine;
-  if (maxrho < deref_below) return parthenon::AmrTag::derefine;
-  return parthenon::AmrTag::same;
+  TagBlocks(
+      "overdens check refinement", md, amr_tags, kb, jb, {ib.s, ib.e + 1}, refine_above,
+      deref_below, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        return criteria::Density(w(b), k, j, i);
+      });
 }
 
 } // namespace other
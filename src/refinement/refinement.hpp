@@ -5,23 +5,108 @@
 #ifndef REFINEMENT_HPP_
 #define REFINEMENT_HPP_
 
+// C++ headers
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <tuple>
+
 // Parthenon headers
 #include <parthenon/parthenon.hpp>
 
 namespace refinement {
 
 using parthenon::AmrTag;
+using parthenon::IndexRange;
 using parthenon::MeshBlockData;
+using parthenon::MeshData;
+using parthenon::ParArray1D;
 using parthenon::Real;
 
+// Refinement criteria are evaluated for all blocks of a MeshData in a single kernel and
+// set the tag of block b in amr_tags (unless a larger tag has already been set).
+using CheckRefinementMeshFun_t =
+    std::function<void(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags)>;
+
+// One team per block reduces the maximum of cell_value(b, k, j, i) over [kb, jb, ib].
+// Blocks are tagged for refinement if the maximum is > refine_above and for
+// derefinement if it is < deref_below.
+template <typename F>
+void TagBlocks(const std::string &label, MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags,
+               const IndexRange &kb, const IndexRange &jb, const IndexRange &ib,
+               const Real refine_above, const Real deref_below, const F &cell_value) {
+  const int nj = jb.e - jb.s + 1;
+  const int ni = ib.e - ib.s + 1;
+  const int ncells = (kb.e - kb.s + 1) * nj * ni;
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, label, parthenon::DevExecSpace(), 0, 0, 0,
+      md->NumBlocks() - 1, KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b) {
+        Real max_value = 0.0;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(member, ncells),
+            [&](const int n, Real &lmax_value) {
+              const int k = kb.s + n / (nj * ni);
+              const int j = jb.s + (n / ni) % nj;
+              const int i = ib.s + n % ni;
+              lmax_value = std::max(lmax_value, cell_value(b, k, j, i));
+            },
+            Kokkos::Max<Real>(max_value));
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          auto tag = AmrTag::same;
+          if (max_value > refine_above) {
+            tag = AmrTag::refine;
+          } else if (max_value < deref_below) {
+            tag = AmrTag::derefine;
+          }
+          if (static_cast<int>(tag) > static_cast<int>(amr_tags(b))) {
+            amr_tags(b) = tag;
+          }
+        });
+      });
+}
+
+// Set of built-in criteria evaluated together in a single pass over the data, see
+// Combined()
+struct CombinedCriteria {
+  bool pressure_gradient = false;
+  bool xyvelocity_gradient = false;
+  bool density_2nd_deriv_err_norm = false;
+  bool maxdensity = false;
+  // Tags of the individual criteria are combined with min (a block is only refined if
+  // all criteria request refinement and derefined if any criterion allows it) instead of
+  // max (refined if any criterion requests it and only derefined if all allow it).
+  bool combine_min = false;
+};
+
+// The same as applying the enabled individual criteria but reading the data only once
+void Combined(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags);
+
+// Creation cycle of the blocks (on this rank) identified by their logical location
+struct BlockAges {
+  using Key = std::tuple<int, std::int64_t, std::int64_t, std::int64_t>;
+  struct Entry {
+    int created;
+    int last_seen;
+  };
+  std::map<Key, Entry> blocks;
+  int previous_check = -1;
+  int current_check = -1;
+};
+
+// Prevents the derefinement of blocks that were created less than
+// refinement/min_derefine_age cycles ago. Applied after the refinement criteria.
+// Blocks moved to this rank by the load balancing are considered as new.
+void EnforceMinDerefineAge(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags);
+
 namespace gradient {
-AmrTag PressureGradient(MeshBlockData<Real> *rc);
-AmrTag VelocityGradient(MeshBlockData<Real> *rc);
-AmrTag Density2ndDerivErrorNorm(MeshBlockData<Real> *rc);
+void PressureGradient(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags);
+void VelocityGradient(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags);
+void Density2ndDerivErrorNorm(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags);
 } // namespace gradient
 namespace other {
-parthenon::AmrTag MaxDensity(MeshBlockData<Real> *rc);
-}
+void MaxDensity(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags);
+} // namespace other
 
 } // namespace refinement
 
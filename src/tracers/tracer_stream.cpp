@@ -0,0 +1,169 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file tracer_stream.cpp
+//  \brief Streaming output of tracer values (independent of the Parthenon outputs)
+
+// C++ headers
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parthenon headers
+#include "kokkos_abstraction.hpp"
+#include "mesh/mesh.hpp"
+#include "utils/error_checking.hpp"
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../utils/profiling.hpp"
+#include "tracer_stream.hpp"
+#include "tracers.hpp"
+
+namespace Tracers {
+
+namespace {
+template <typename T>
+void Append(std::vector<char> *buffer, const T *data, const std::size_t count) {
+  const auto offset = buffer->size();
+  buffer->resize(offset + count * sizeof(T));
+  std::memcpy(buffer->data() + offset, data, count * sizeof(T));
+}
+} // namespace
+
+TracerStream::TracerStream(const std::string &filename, const Real dt,
+                           const std::vector<std::string> &variables)
+    : filename_(filename), dt_(dt), variables_(variables),
+      next_time_(std::numeric_limits<Real>::lowest()) {}
+
+TracerStream::~TracerStream() { Wait(); }
+
+void TracerStream::Wait() {
+  if (pending_.valid()) {
+    pending_.get();
+  }
+}
+
+void TracerStream::Write(MeshData<Real> *md, const int ncycle, const Real time) {
+  if (time < next_time_) {
+    return;
+  }
+  utils::profiling::ScopedRegion region("Tracers::TracerStream::Write");
+  next_time_ = (std::floor(time / dt_) + 1.0) * dt_;
+
+  // Compact the selected values of the active tracers of all blocks on device and copy
+  // them to the host
+  const int nvars = variables_.size();
+  std::vector<std::int64_t> ids;
+  std::vector<std::vector<Real>> values(nvars);
+  for (int b = 0; b < md->NumBlocks(); b++) {
+    auto *pmb = md->GetBlockData(b)->GetBlockPointer();
+    auto &swarm = pmb->meshblock_data.Get()->GetSwarmData()->Get("tracers");
+    const int nslots = swarm->GetMaxActiveIndex() + 1;
+    if (nslots <= 0) {
+      continue;
+    }
+    auto swarm_d = swarm->GetDeviceContext();
+
+    parthenon::ParArray1D<int> index("Tracers::TracerStream::index", nslots);
+    int nactive = 0;
+    Kokkos::parallel_scan(
+        "Tracers::TracerStream::Compact",
+        Kokkos::RangePolicy<>(parthenon::DevExecSpace(), 0, nslots),
+        KOKKOS_LAMBDA(const int n, int &offset, const bool final) {
+          if (swarm_d.IsActive(n)) {
+            if (final) {
+              index(offset) = n;
+            }
+            offset += 1;
+          }
+        },
+        nactive);
+    if (nactive == 0) {
+      continue;
+    }
+
+    auto &id = swarm->Get<int>("id").Get();
+    parthenon::ParArray1D<int> id_buf("Tracers::TracerStream::id", nactive);
+    parthenon::ParArray2D<Real> buf("Tracers::TracerStream::values", nvars, nactive);
+    pmb->par_for(
+        "Tracers::TracerStream::Gather id", 0, nactive - 1,
+        KOKKOS_LAMBDA(const int m) { id_buf(m) = id(index(m)); });
+    for (int v = 0; v < nvars; v++) {
+      auto &var = swarm->Get<Real>(variables_[v]).Get();
+      pmb->par_for(
+          "Tracers::TracerStream::Gather values", 0, nactive - 1,
+          KOKKOS_LAMBDA(const int m) { buf(v, m) = var(index(m)); });
+    }
+    auto id_h = Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), id_buf);
+    auto buf_h = Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), buf);
+    for (int m = 0; m < nactive; m++) {
+      ids.push_back(id_h(m));
+    }
+    for (int v = 0; v < nvars; v++) {
+      for (int m = 0; m < nactive; m++) {
+        values[v].push_back(buf_h(v, m));
+      }
+    }
+  }
+
+  // The staging buffer is only reused once the previous write finished
+  Wait();
+  staging_.clear();
+  const bool truncate = !header_written_ && !md->GetParentPointer()->is_restart;
+  if (!header_written_) {
+    // Only write the header to new files (restarts append to the existing file)
+    std::ifstream existing(filename_, std::ios::binary | std::ios::ate);
+    if (truncate || !existing.good() || existing.tellg() <= 0) {
+      const char magic[16] = {'A', 'T', 'H', 'E', 'N', 'A', 'P', 'K',
+                              '_', 'T', 'R', 'A', 'C', 'E', 'R', 'S'};
+      const std::int32_t version = 1;
+      const std::int32_t real_size = sizeof(Real);
+      const std::int32_t num_vars = nvars;
+      Append(&staging_, magic, 16);
+      Append(&staging_, &version, 1);
+      Append(&staging_, &real_size, 1);
+      Append(&staging_, &num_vars, 1);
+      for (const auto &var : variables_) {
+        const std::int32_t len = var.size();
+        Append(&staging_, &len, 1);
+        Append(&staging_, var.data(), var.size());
+      }
+    }
+    header_written_ = true;
+  }
+  const std::int64_t cycle = ncycle;
+  const double record_time = time;
+  const std::int64_t num_tracers = ids.size();
+  Append(&staging_, &cycle, 1);
+  Append(&staging_, &record_time, 1);
+  Append(&staging_, &num_tracers, 1);
+  Append(&staging_, ids.data(), ids.size());
+  for (const auto &vals : values) {
+    Append(&staging_, vals.data(), vals.size());
+  }
+
+  pending_ = std::async(std::launch::async, [this, truncate]() {
+    std::ofstream outfile(filename_, std::ios::binary |
+                                         (truncate ? std::ios::trunc : std::ios::app));
+    PARTHENON_REQUIRE_THROWS(outfile.good(), "Cannot open tracer stream " + filename_);
+    outfile.write(staging_.data(), staging_.size());
+  });
+}
+
+TaskStatus StreamTracers(MeshData<Real> *md, parthenon::SimTime &tm) {
+  auto tracers_pkg = md->GetParentPointer()->packages.Get("tracers");
+  auto stream = tracers_pkg->Param<std::shared_ptr<TracerStream>>("stream");
+  stream->Write(md, tm.ncycle, tm.time);
+  return TaskStatus::complete;
+}
+
+} // namespace Tracers
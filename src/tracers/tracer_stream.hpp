@@ -0,0 +1,58 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file tracer_stream.hpp
+//  \brief Streaming output of tracer values (independent of the Parthenon outputs)
+//
+// Every tracers/stream_dt, the selected values of all tracers of a rank are appended to
+// a per-rank binary file. The data is copied into a host-side staging buffer and
+// written by a separate thread so that the time loop only waits for the previous write
+// (if it is still in progress) at the next output.
+#ifndef TRACERS_TRACER_STREAM_HPP_
+#define TRACERS_TRACER_STREAM_HPP_
+
+// C++ headers
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+namespace Tracers {
+
+using parthenon::MeshData;
+using parthenon::Real;
+
+class TracerStream {
+ public:
+  TracerStream(const std::string &filename, const Real dt,
+               const std::vector<std::string> &variables);
+  ~TracerStream();
+  TracerStream(const TracerStream &) = delete;
+  TracerStream &operator=(const TracerStream &) = delete;
+
+  // Copies the data of all tracers of md to the staging buffer and starts writing it if
+  // time reached the next output time.
+  void Write(MeshData<Real> *md, const int ncycle, const Real time);
+
+ private:
+  // Waits for the write currently in progress (if any)
+  void Wait();
+
+  std::string filename_;
+  Real dt_;
+  std::vector<std::string> variables_;
+  Real next_time_;
+  bool header_written_ = false;
+  // Encoded record (and file header) handed to the writer thread
+  std::vector<char> staging_;
+  std::future<void> pending_;
+};
+
+} // namespace Tracers
+
+#endif // TRACERS_TRACER_STREAM_HPP_
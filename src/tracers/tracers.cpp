@@ -19,14 +19,25 @@
 // publicly, and to permit others to do so.
 //========================================================================================
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include <Kokkos_Sort.hpp>
+
 // Parthenon headers
 #include "basic_types.hpp"
+#include "globals.hpp"
 #include "interface/metadata.hpp"
+#include "interface/swarm_pack.hpp"
 #include "kokkos_abstraction.hpp"
 #include "parthenon_array_generic.hpp"
 #include "utils/error_checking.hpp"
@@ -34,11 +45,173 @@
 
 // AthenaPK headers
 #include "../main.hpp"
+#include "../utils/profiling.hpp"
+#include "../utils/random.hpp"
+#include "../utils/shared_params.hpp"
+#include "tracer_stream.hpp"
 #include "tracers.hpp"
 
 namespace Tracers {
 using namespace parthenon::package::prelude;
 namespace LCInterp = parthenon::interpolation::cent::linear;
+using parthenon::ParArray1D;
+
+namespace {
+// Indices of the tracer variables in the swarm packs, see TracerPackDescriptor
+enum TracerVar { tx, ty, tz, tvel_x, tvel_y, tvel_z, trho, tpressure, tB_x, tB_y, tB_z };
+
+// Pack of all tracer variables over all blocks of a MeshData
+const parthenon::SwarmPackDescriptor<Real> &TracerPackDescriptor(const bool mhd) {
+  static const auto desc = [mhd]() {
+    std::vector<std::string> vars = {
+        swarm_position::x::name(), swarm_position::y::name(), swarm_position::z::name(),
+        "vel_x", "vel_y", "vel_z", "rho", "pressure"};
+    if (mhd) {
+      vars.insert(vars.end(), {"B_x", "B_y", "B_z"});
+    }
+    return parthenon::MakeSwarmPackDescriptor<Real>("tracers", vars);
+  }();
+  return desc;
+}
+
+// Order in which the tracer slots of block gid are processed (empty if not sorted yet),
+// see SortTracers
+ParArray1D<int> SortOrder(StateDescriptor *tracers_pkg, const int gid) {
+  if (tracers_pkg->Param<int>("sort_interval") <= 0) {
+    return ParArray1D<int>();
+  }
+  return utils::shared_params::WithMutableParam<std::map<int, ParArray1D<int>>>(
+      tracers_pkg, "sort_order", [&](auto *sort_order) {
+        auto it = sort_order->find(gid);
+        return it != sort_order->end() ? it->second : ParArray1D<int>();
+      });
+}
+
+using utils::random::Hash;
+using utils::random::Uniform;
+
+// Seeds the tracers of each cell (identified by its global index on its level) from a
+// counter-based random number generator so that exactly the tracers belonging to a block
+// are created (without any redistribution) independent of the mesh decomposition.
+// Globally unique ids follow from a prefix sum of the number of tracers per block.
+void SeedCounterBased(Mesh *pmesh, ParameterInput *pin) {
+  const auto num_tracers_per_cell =
+      pin->GetOrAddReal("tracers", "initial_num_tracers_per_cell", 0.0);
+  PARTHENON_REQUIRE_THROWS(num_tracers_per_cell > 0.0,
+                           "You should seed at least some tracers.");
+  const std::uint64_t rng_seed =
+      Hash(pin->GetOrAddInteger("tracers", "initial_rng_seed", 0));
+  // Each cell gets nfull tracers and one more with probability frac
+  const int nfull = static_cast<int>(num_tracers_per_cell);
+  const Real frac = num_tracers_per_cell - nfull;
+
+  const auto num_blocks = pmesh->block_list.size();
+  std::vector<ParArray1D<int>> cell_offsets(num_blocks);
+  std::vector<std::int64_t> block_offsets(num_blocks + 1, 0);
+  for (std::size_t nb = 0; nb < num_blocks; nb++) {
+    auto &pmb = pmesh->block_list[nb];
+    IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+    IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+    IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+    const int ni = ib.e - ib.s + 1;
+    const int nj = jb.e - jb.s + 1;
+    const int ncells = (kb.e - kb.s + 1) * nj * ni;
+    const std::int64_t level = pmb->loc.level();
+    const std::int64_t gis = pmb->loc.lx1() * ni;
+    const std::int64_t gjs = pmb->loc.lx2() * nj;
+    const std::int64_t gks = pmb->loc.lx3() * (kb.e - kb.s + 1);
+
+    // Offset of the first tracer of each cell within the block
+    cell_offsets[nb] = ParArray1D<int>("Tracers::SeedCounterBased::offsets", ncells);
+    auto offsets = cell_offsets[nb];
+    int num_block = 0;
+    Kokkos::parallel_scan(
+        "Tracers::SeedCounterBased::Count",
+        Kokkos::RangePolicy<>(parthenon::DevExecSpace(), 0, ncells),
+        KOKKOS_LAMBDA(const int c, int &offset, const bool final) {
+          const std::uint64_t cell =
+              Hash(Hash(Hash(level, gks + c / (nj * ni)), gjs + (c / ni) % nj),
+                   gis + c % ni);
+          if (final) {
+            offsets(c) = offset;
+          }
+          offset += nfull + (Uniform(Hash(rng_seed, cell)) < frac ? 1 : 0);
+        },
+        num_block);
+    block_offsets[nb + 1] = block_offsets[nb] + num_block;
+  }
+
+  // Blocks on a rank are contiguous in gid so that the global offset of the rank follows
+  // from an exclusive scan over the ranks
+  std::int64_t rank_offset = 0;
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Exscan(&block_offsets[num_blocks], &rank_offset, 1,
+                                 MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD));
+  if (parthenon::Globals::my_rank == 0) {
+    rank_offset = 0;
+  }
+#endif
+  PARTHENON_REQUIRE_THROWS(rank_offset + block_offsets[num_blocks] <=
+                               std::numeric_limits<int>::max(),
+                           "Number of tracers exceeds the range of the tracer ids.");
+
+  for (std::size_t nb = 0; nb < num_blocks; nb++) {
+    auto &pmb = pmesh->block_list[nb];
+    const int num_block = block_offsets[nb + 1] - block_offsets[nb];
+    if (num_block == 0) {
+      continue;
+    }
+    auto &swarm = pmb->meshblock_data.Get()->GetSwarmData()->Get("tracers");
+    IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+    IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+    IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+    const int ni = ib.e - ib.s + 1;
+    const int nj = jb.e - jb.s + 1;
+    const int ncells = (kb.e - kb.s + 1) * nj * ni;
+    const std::int64_t level = pmb->loc.level();
+    const std::int64_t gis = pmb->loc.lx1() * ni;
+    const std::int64_t gjs = pmb->loc.lx2() * nj;
+    const std::int64_t gks = pmb->loc.lx3() * (kb.e - kb.s + 1);
+    const int id_offset = rank_offset + block_offsets[nb];
+
+    auto new_particles_context = swarm->AddEmptyParticles(num_block);
+
+    auto &x = swarm->Get<Real>(swarm_position::x::name()).Get();
+    auto &y = swarm->Get<Real>(swarm_position::y::name()).Get();
+    auto &z = swarm->Get<Real>(swarm_position::z::name()).Get();
+    auto &id = swarm->Get<int>("id").Get();
+    auto swarm_d = swarm->GetDeviceContext();
+    const auto coords = pmb->coords;
+    auto offsets = cell_offsets[nb];
+
+    pmb->par_for(
+        "Tracers::SeedCounterBased::Seed", 0, ncells - 1, KOKKOS_LAMBDA(const int c) {
+          const int k = kb.s + c / (nj * ni);
+          const int j = jb.s + (c / ni) % nj;
+          const int i = ib.s + c % ni;
+          const std::uint64_t cell = Hash(
+              Hash(Hash(level, gks + k - kb.s), gjs + j - jb.s), gis + i - ib.s);
+          const int num_cell = (c + 1 < ncells ? offsets(c + 1) : num_block) - offsets(c);
+          for (int p = 0; p < num_cell; p++) {
+            const int new_n = offsets(c) + p;
+            const int n = new_particles_context.GetNewParticleIndex(new_n);
+            const std::uint64_t key = Hash(rng_seed, Hash(cell, p));
+            x(n) = coords.Xf<1>(i) +
+                   Uniform(Hash(key, 1)) * (coords.Xf<1>(i + 1) - coords.Xf<1>(i));
+            y(n) = coords.Xf<2>(j) +
+                   Uniform(Hash(key, 2)) * (coords.Xf<2>(j + 1) - coords.Xf<2>(j));
+            z(n) = coords.Xf<3>(k) +
+                   Uniform(Hash(key, 3)) * (coords.Xf<3>(k + 1) - coords.Xf<3>(k));
+            id(n) = id_offset + new_n;
+
+            // Only sets the (current) block index as all tracers are within the block
+            bool on_current_mesh_block = true;
+            swarm_d.GetNeighborBlockIndex(n, x(n), y(n), z(n), on_current_mesh_block);
+          }
+        });
+  }
+}
+} // namespace
 
 std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   auto tracer_pkg = std::make_shared<StateDescriptor>("tracers");
@@ -48,6 +221,23 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
 
   Params &params = tracer_pkg->AllParams();
 
+  // Interpolate to and advect the tracers of all blocks of a MeshData in a single kernel
+  // (using swarm packs) rather than launching one kernel per block
+  tracer_pkg->AddParam<>("swarm_packs",
+                         pin->GetOrAddBoolean("tracers", "swarm_packs", false));
+
+  // Process the tracers of a block in the order of the cells they are in (updated every
+  // sort_interval cycles) so that nearby tracers read nearby cells
+  const auto sort_interval = pin->GetOrAddInteger("tracers", "sort_interval", 0);
+  PARTHENON_REQUIRE_THROWS(sort_interval >= 0, "tracers/sort_interval must be >= 0.");
+  PARTHENON_REQUIRE_THROWS(sort_interval == 0 || !tracer_pkg->Param<bool>("swarm_packs"),
+                           "tracers/sort_interval is not supported with swarm_packs.");
+  tracer_pkg->AddParam<>("sort_interval", sort_interval);
+  if (sort_interval > 0) {
+    tracer_pkg->AddParam<>("sort_order", std::map<int, ParArray1D<int>>(),
+                           Params::Mutability::Mutable);
+  }
+
   // Add swarm of tracers
   std::string swarm_name = "tracers";
   tracer_pkg->AddParam<>("swarm_name", swarm_name);
@@ -74,9 +264,22 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   // one, but we should check if there's direct way to access Params of other packages.
   const bool mhd = pin->GetString("hydro", "fluid") == "glmmhd";
 
+  // On adaptive meshes, the tracers of a refined (derefined) block are moved to its
+  // children (parent) by Parthenon during remeshing and are sent along with their block
+  // during load balancing. Interpolation at fine-coarse boundaries uses the prolongated
+  // (restricted) ghost cells.
+
+  // Cost of a tracer relative to the cost of the hydro update of a cell used for the
+  // load balancing, see Hydro::SetLoadBalancingCosts
+  const auto lb_cost_weight = pin->GetOrAddReal("tracers", "lb_cost_weight", 0.0);
+  PARTHENON_REQUIRE_THROWS(lb_cost_weight >= 0.0,
+                           "tracers/lb_cost_weight must be non-negative.");
   PARTHENON_REQUIRE_THROWS(
-      pin->GetString("parthenon/mesh", "refinement") != "adaptive",
-      "Tracers/swarms currently only supported on non-adaptive meshes.");
+      lb_cost_weight == 0.0 ||
+          pin->GetOrAddString("parthenon/loadbalancing", "balancer", "default") ==
+              "manual",
+      "tracers/lb_cost_weight requires parthenon/loadbalancing/balancer=manual.");
+  tracer_pkg->AddParam<>("lb_cost_weight", lb_cost_weight);
 
   if (mhd) {
     tracer_pkg->AddSwarmValue("B_x", swarm_name, real_swarmvalue_metadata);
@@ -84,6 +287,35 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
     tracer_pkg->AddSwarmValue("B_z", swarm_name, real_swarmvalue_metadata);
   }
 
+  // Streaming output of selected tracer values (per rank and independent of the
+  // Parthenon outputs)
+  const auto stream_dt = pin->GetOrAddReal("tracers", "stream_dt", -1.0);
+  tracer_pkg->AddParam<>("stream_enabled", stream_dt > 0.0);
+  if (stream_dt > 0.0) {
+    const std::string default_vars = mhd ? "x, y, z, rho, pressure, vel_x, vel_y, vel_z, "
+                                           "B_x, B_y, B_z"
+                                         : "x, y, z, rho, pressure, vel_x, vel_y, vel_z";
+    std::stringstream vars_ss(
+        pin->GetOrAddString("tracers", "stream_variables", default_vars));
+    std::vector<std::string> stream_vars;
+    std::string var;
+    while (std::getline(vars_ss, var, ',')) {
+      var.erase(0, var.find_first_not_of(' '));
+      var.erase(var.find_last_not_of(' ') + 1);
+      const bool known = var == "x" || var == "y" || var == "z" || var == "rho" ||
+                         var == "pressure" || var == "vel_x" || var == "vel_y" ||
+                         var == "vel_z" ||
+                         (mhd && (var == "B_x" || var == "B_y" || var == "B_z"));
+      PARTHENON_REQUIRE_THROWS(known, "Unknown tracers/stream_variables entry: " + var);
+      stream_vars.push_back(var);
+    }
+    std::stringstream fname;
+    fname << pin->GetOrAddString("tracers", "stream_basename", "tracers") << "."
+          << std::setw(5) << std::setfill('0') << parthenon::Globals::my_rank << ".bin";
+    tracer_pkg->AddParam<>(
+        "stream", std::make_shared<TracerStream>(fname.str(), stream_dt, stream_vars));
+  }
+
   tracer_pkg->UserWorkBeforeLoopMesh = SeedInitialTracers;
 
   if (ProblemInitTracerData != nullptr) {
@@ -145,7 +377,7 @@ void SeedInitialTracers(Mesh *pmesh, ParameterInput *pin, parthenon::SimTime &tm
 
       const auto gid = pmb->gid;
       pmb->par_for(
-          "SeedInitialTracers::random_per_block", 0,
+          "Tracers::SeedInitialTracers::RandomPerBlock", 0,
           new_particles_context.GetNewParticlesMaxIndex(),
           KOKKOS_LAMBDA(const int new_n) {
             auto rng_gen = rng_pool.get_state();
@@ -166,6 +398,8 @@ void SeedInitialTracers(Mesh *pmesh, ParameterInput *pin, parthenon::SimTime &tm
             swarm_d.GetNeighborBlockIndex(n, x(n), y(n), z(n), on_current_mesh_block);
           });
     }
+  } else if (seed_method == "counter_based") {
+    SeedCounterBased(pmesh, pin);
   } else {
     PARTHENON_THROW("Unknown tracer initial_seed_method");
   }
@@ -180,13 +414,18 @@ void SeedInitialTracers(Mesh *pmesh, ParameterInput *pin, parthenon::SimTime &tm
   PARTHENON_REQUIRE_THROWS(num_partitions == 1,
                            "Only pack_size=-1 currently supported for tracers.")
   auto &mu0 = pmesh->mesh_data.GetOrAdd("base", 0);
-  FillTracers(mu0.get(), tm);
+  if (tracers_pkg->Param<bool>("swarm_packs")) {
+    FillTracersMD(mu0.get(), tm);
+  } else {
+    FillTracers(mu0.get(), tm);
+  }
   if (ProblemFillTracers != nullptr) {
     ProblemFillTracers(mu0.get(), tm, tm.dt);
   }
 }
 
 TaskStatus AdvectTracers(MeshBlockData<Real> *mbd, const Real dt) {
+  utils::profiling::ScopedRegion region("Tracers::AdvectTracers");
   auto *pmb = mbd->GetParentPointer();
   auto &sd = pmb->meshblock_data.Get()->GetSwarmData();
   auto &swarm = sd->Get("tracers");
@@ -204,9 +443,13 @@ TaskStatus AdvectTracers(MeshBlockData<Real> *mbd, const Real dt) {
 
   // update loop. RK2
   const int max_active_index = swarm->GetMaxActiveIndex();
+  const auto order = SortOrder(pmb->packages.Get("tracers").get(), pmb->gid);
+  const int norder = order.extent_int(0);
   pmb->par_for(
-      "Advect Tracers", 0, max_active_index, KOKKOS_LAMBDA(const int n) {
-        if (swarm_d.IsActive(n)) {
+      "Tracers::AdvectTracers", 0, std::max(norder - 1, max_active_index),
+      KOKKOS_LAMBDA(const int m) {
+        const int n = m < norder ? order(m) : m;
+        if (n <= max_active_index && swarm_d.IsActive(n)) {
           int k, j, i;
           swarm_d.Xtoijk(x(n), y(n), z(n), i, j, k);
 
@@ -241,12 +484,109 @@ TaskStatus AdvectTracers(MeshBlockData<Real> *mbd, const Real dt) {
   return TaskStatus::complete;
 } // AdvectTracers
 
+TaskStatus SortTracers(MeshBlock *pmb, const int ncycle) {
+  auto tracers_pkg = pmb->packages.Get("tracers");
+  const auto sort_interval = tracers_pkg->Param<int>("sort_interval");
+  if (ncycle % sort_interval != 0) {
+    return TaskStatus::complete;
+  }
+  utils::profiling::ScopedRegion region("Tracers::SortTracers");
+  auto &swarm = pmb->meshblock_data.Get()->GetSwarmData()->Get("tracers");
+  const int nslots = swarm->GetMaxActiveIndex() + 1;
+  if (nslots <= 0) {
+    return TaskStatus::complete;
+  }
+
+  auto &x = swarm->Get<Real>(swarm_position::x::name()).Get();
+  auto &y = swarm->Get<Real>(swarm_position::y::name()).Get();
+  auto &z = swarm->Get<Real>(swarm_position::z::name()).Get();
+  auto swarm_d = swarm->GetDeviceContext();
+
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::entire);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::entire);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::entire);
+  const int ni = ib.e - ib.s + 1;
+  const int nj = jb.e - jb.s + 1;
+  const int ncells = (kb.e - kb.s + 1) * nj * ni;
+
+  // Cell index of each slot (inactive slots last)
+  ParArray1D<int> keys("Tracers::SortTracers::keys", nslots);
+  pmb->par_for(
+      "Tracers::SortTracers::keys", 0, nslots - 1, KOKKOS_LAMBDA(const int n) {
+        if (swarm_d.IsActive(n)) {
+          int k, j, i;
+          swarm_d.Xtoijk(x(n), y(n), z(n), i, j, k);
+          keys(n) = ((k - kb.s) * nj + (j - jb.s)) * ni + (i - ib.s);
+        } else {
+          keys(n) = ncells;
+        }
+      });
+  using BinOp_t = Kokkos::BinOp1D<ParArray1D<int>>;
+  Kokkos::BinSort<ParArray1D<int>, BinOp_t> bin_sort(
+      keys, BinOp_t(ncells + 1, 0, ncells + 1), false);
+  bin_sort.create_permute_vector();
+  const auto permute = bin_sort.get_permute_vector();
+
+  ParArray1D<int> order("Tracers::SortTracers::order", nslots);
+  pmb->par_for(
+      "Tracers::SortTracers::order", 0, nslots - 1,
+      KOKKOS_LAMBDA(const int n) { order(n) = permute(n); });
+  utils::shared_params::WithMutableParam<std::map<int, ParArray1D<int>>>(
+      tracers_pkg.get(), "sort_order",
+      [&](auto *sort_order) { (*sort_order)[pmb->gid] = order; });
+
+  return TaskStatus::complete;
+} // SortTracers
+
+TaskStatus AdvectTracersMD(MeshData<Real> *md, const Real dt) {
+  utils::profiling::ScopedRegion region("Tracers::AdvectTracersMD");
+  auto hydro_pkg = md->GetParentPointer()->packages.Get("Hydro");
+  const auto mhd = hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd;
+
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  auto pack = TracerPackDescriptor(mhd).GetPack(md);
+
+  // Same update as in AdvectTracers for all tracers of all blocks
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Tracers::AdvectTracersMD", parthenon::DevExecSpace(), 0,
+      pack.GetMaxFlatIndex(), KOKKOS_LAMBDA(const int idx) {
+        auto [b, n] = pack.GetBlockParticleIndices(idx);
+        auto swarm_d = pack.GetContext(b);
+        if (swarm_d.IsActive(n)) {
+          auto &x = pack(b, tx, n);
+          auto &y = pack(b, ty, n);
+          auto &z = pack(b, tz, n);
+          const auto vel_x = pack(b, tvel_x, n);
+          const auto vel_y = pack(b, tvel_y, n);
+          const auto vel_z = pack(b, tvel_z, n);
+
+          const auto x_star = x + dt * vel_x;
+          const auto y_star = y + dt * vel_y;
+          const auto z_star = z + dt * vel_z;
+
+          const auto vel_x_star = LCInterp::Do(b, x_star, y_star, z_star, prim_pack, IV1);
+          const auto vel_y_star = LCInterp::Do(b, x_star, y_star, z_star, prim_pack, IV2);
+          const auto vel_z_star = LCInterp::Do(b, x_star, y_star, z_star, prim_pack, IV3);
+
+          x += dt * 0.5 * (vel_x + vel_x_star);
+          y += dt * 0.5 * (vel_y + vel_y_star);
+          z += dt * 0.5 * (vel_z + vel_z_star);
+
+          bool unused_temp = true;
+          swarm_d.GetNeighborBlockIndex(n, x, y, z, unused_temp);
+        }
+      });
+
+  return TaskStatus::complete;
+} // AdvectTracersMD
+
 /**
  * FillDerived function for tracers.
  * Registered Quantities (in addition to t, x, y, z):
  * rho, vel, B
  **/
 TaskStatus FillTracers(MeshData<Real> *md, parthenon::SimTime &tm) {
+  utils::profiling::ScopedRegion region("Tracers::FillTracers");
   auto hydro_pkg = md->GetParentPointer()->packages.Get("Hydro");
   const auto mhd = hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd;
 
@@ -283,9 +623,13 @@ TaskStatus FillTracers(MeshData<Real> *md, parthenon::SimTime &tm) {
 
     // update loop.
     const int max_active_index = swarm->GetMaxActiveIndex();
+    const auto order = SortOrder(tracers_pkg.get(), pmb->gid);
+    const int norder = order.extent_int(0);
     pmb->par_for(
-        "Fill Tracers", 0, max_active_index, KOKKOS_LAMBDA(const int n) {
-          if (swarm_d.IsActive(n)) {
+        "Tracers::FillTracers", 0, std::max(norder - 1, max_active_index),
+        KOKKOS_LAMBDA(const int m) {
+          const int n = m < norder ? order(m) : m;
+          if (n <= max_active_index && swarm_d.IsActive(n)) {
             int k, j, i;
             swarm_d.Xtoijk(x(n), y(n), z(n), i, j, k);
 
@@ -306,4 +650,38 @@ TaskStatus FillTracers(MeshData<Real> *md, parthenon::SimTime &tm) {
 
   return TaskStatus::complete;
 } // FillTracers
+
+// Same as FillTracers but a single kernel for all tracers of all blocks
+TaskStatus FillTracersMD(MeshData<Real> *md, parthenon::SimTime &tm) {
+  utils::profiling::ScopedRegion region("Tracers::FillTracersMD");
+  auto hydro_pkg = md->GetParentPointer()->packages.Get("Hydro");
+  const auto mhd = hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd;
+
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  auto pack = TracerPackDescriptor(mhd).GetPack(md);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Tracers::FillTracersMD", parthenon::DevExecSpace(), 0,
+      pack.GetMaxFlatIndex(), KOKKOS_LAMBDA(const int idx) {
+        auto [b, n] = pack.GetBlockParticleIndices(idx);
+        const auto swarm_d = pack.GetContext(b);
+        if (swarm_d.IsActive(n)) {
+          const auto x = pack(b, tx, n);
+          const auto y = pack(b, ty, n);
+          const auto z = pack(b, tz, n);
+          pack(b, trho, n) = LCInterp::Do(b, x, y, z, prim_pack, IDN);
+          pack(b, tvel_x, n) = LCInterp::Do(b, x, y, z, prim_pack, IV1);
+          pack(b, tvel_y, n) = LCInterp::Do(b, x, y, z, prim_pack, IV2);
+          pack(b, tvel_z, n) = LCInterp::Do(b, x, y, z, prim_pack, IV3);
+          pack(b, tpressure, n) = LCInterp::Do(b, x, y, z, prim_pack, IPR);
+          if (mhd) {
+            pack(b, tB_x, n) = LCInterp::Do(b, x, y, z, prim_pack, IB1);
+            pack(b, tB_y, n) = LCInterp::Do(b, x, y, z, prim_pack, IB2);
+            pack(b, tB_z, n) = LCInterp::Do(b, x, y, z, prim_pack, IB3);
+          }
+        }
+      });
+
+  return TaskStatus::complete;
+} // FillTracersMD
 } // namespace Tracers
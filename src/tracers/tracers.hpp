@@ -44,8 +44,19 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin);
 extern InitPackageDataFun_t ProblemInitTracerData;
 
 TaskStatus AdvectTracers(MeshBlockData<Real> *mbd, const Real dt);
+// Same as AdvectTracers and FillTracers using swarm packs, see tracers/swarm_packs
+TaskStatus AdvectTracersMD(MeshData<Real> *md, const Real dt);
+TaskStatus FillTracersMD(MeshData<Real> *md, parthenon::SimTime &tm);
 
 TaskStatus FillTracers(MeshData<Real> *md, parthenon::SimTime &tm);
+
+// Appends the tracer values to the tracer stream every tracers/stream_dt, see
+// TracerStream
+TaskStatus StreamTracers(MeshData<Real> *md, parthenon::SimTime &tm);
+
+// Calculates the order (by cell) in which the tracers of the block are processed every
+// tracers/sort_interval cycles
+TaskStatus SortTracers(MeshBlock *pmb, const int ncycle);
 using FillTracersFun_t = std::function<TaskStatus(
     MeshData<Real> *md, const parthenon::SimTime &tm, const Real dt)>;
 extern FillTracersFun_t ProblemFillTracers;
@@ -0,0 +1,238 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file ensemble.cpp
+//  \brief Ensemble mode: many small independent simulations batched in one mesh
+
+// C++ headers
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include "kokkos_abstraction.hpp"
+#include "mesh/mesh.hpp"
+#include "utils/error_checking.hpp"
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "ensemble.hpp"
+
+namespace utils::ensemble {
+
+using parthenon::ApplicationInput;
+using parthenon::IndexDomain;
+using parthenon::Mesh;
+using parthenon::MeshBlock;
+using parthenon::MeshData;
+using parthenon::Metadata;
+using parthenon::MetadataFlag;
+using parthenon::ParameterInput;
+using parthenon::Real;
+
+namespace {
+// Original problem generator and the input parameters of all members
+std::function<void(Mesh *, ParameterInput *)> init_user_mesh_data = nullptr;
+std::function<void(MeshBlock *, ParameterInput *)> problem_generator = nullptr;
+std::function<void(Mesh *, ParameterInput *, MeshData<Real> *)>
+    mesh_problem_generator = nullptr;
+std::vector<std::unique_ptr<ParameterInput>> member_pins;
+int ensemble_dir = 0;
+
+// Copy of the input parameters with the ensemble direction removed and the overrides
+// of member m applied
+std::unique_ptr<ParameterInput> MakeMemberInput(ParameterInput *pin, const int dir,
+                                                const int m) {
+  std::stringstream dump;
+  pin->ParameterDump(dump);
+  auto pin_m = std::make_unique<ParameterInput>();
+  pin_m->LoadFromStream(dump);
+
+  const auto xdir = "x" + std::to_string(dir);
+  pin_m->SetInteger("parthenon/mesh", "n" + xdir, 1);
+  pin_m->SetInteger("parthenon/meshblock", "n" + xdir, 1);
+  pin_m->SetReal("parthenon/mesh", xdir + "min", pin->GetReal("ensemble", xdir + "min"));
+  pin_m->SetReal("parthenon/mesh", xdir + "max", pin->GetReal("ensemble", xdir + "max"));
+
+  std::stringstream overrides(
+      pin->GetOrAddString("ensemble", "member_" + std::to_string(m), ""));
+  std::string entry;
+  while (overrides >> entry) {
+    const auto eq = entry.find('=');
+    const auto slash = entry.rfind('/', eq);
+    PARTHENON_REQUIRE_THROWS(eq != std::string::npos && slash != std::string::npos &&
+                                 slash > 0 && slash + 1 < eq,
+                             "Ensemble member overrides must be of the form "
+                             "block/name=value but got '" +
+                                 entry + "'");
+    const auto block = entry.substr(0, slash);
+    PARTHENON_REQUIRE_THROWS(block.rfind("problem", 0) == 0,
+                             "Only problem/* parameters can differ between ensemble "
+                             "members but got '" +
+                                 entry + "'");
+    pin_m->SetString(block, entry.substr(slash + 1, eq - slash - 1),
+                     entry.substr(eq + 1));
+  }
+  return pin_m;
+}
+
+// Copies the cells of members m_begin <= m < m_end of the independent variables into
+// buffer (or back from buffer if to_buffer is false)
+void CopyMembers(MeshData<Real> *md, parthenon::ParArray5D<Real> buffer,
+                 const int m_begin, const int m_end, const bool to_buffer) {
+  auto pack =
+      md->PackVariables(std::vector<MetadataFlag>{Metadata::Independent, Metadata::Cell});
+  const auto ib = md->GetBoundsI(IndexDomain::entire);
+  const auto jb = md->GetBoundsJ(IndexDomain::entire);
+  const auto kb = md->GetBoundsK(IndexDomain::entire);
+  const int dir = ensemble_dir;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "ensemble::CopyMembers", parthenon::DevExecSpace(), 0,
+      pack.GetDim(5) - 1, 0, pack.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
+        const auto &coords = pack.GetCoords(b);
+        const Real x = dir == 2 ? coords.Xc<2>(j) : coords.Xc<3>(k);
+        if (x < m_begin || x >= m_end) return;
+        if (to_buffer) {
+          buffer(b, v, k, j, i) = pack(b, v, k, j, i);
+        } else {
+          pack(b, v, k, j, i) = buffer(b, v, k, j, i);
+        }
+      });
+}
+
+void CopyMembers(MeshBlock *pmb, parthenon::ParArray5D<Real> buffer, const int m_begin,
+                 const int m_end, const bool to_buffer) {
+  auto pack = pmb->meshblock_data.Get()->PackVariables(
+      std::vector<MetadataFlag>{Metadata::Independent, Metadata::Cell});
+  const auto ib = pmb->cellbounds.GetBoundsI(IndexDomain::entire);
+  const auto jb = pmb->cellbounds.GetBoundsJ(IndexDomain::entire);
+  const auto kb = pmb->cellbounds.GetBoundsK(IndexDomain::entire);
+  const auto &coords = pmb->coords;
+  const int dir = ensemble_dir;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "ensemble::CopyMembers", parthenon::DevExecSpace(), 0,
+      pack.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int v, const int k, const int j, const int i) {
+        const Real x = dir == 2 ? coords.Xc<2>(j) : coords.Xc<3>(k);
+        if (x < m_begin || x >= m_end) return;
+        if (to_buffer) {
+          buffer(0, v, k, j, i) = pack(v, k, j, i);
+        } else {
+          pack(v, k, j, i) = buffer(0, v, k, j, i);
+        }
+      });
+}
+
+// Initializes all members of data (a MeshBlock or MeshData), one after the other, with
+// the original problem generator (that is unaware of the ensemble and initializes all
+// cells) and only keeps the cells of the current member
+template <typename Data>
+void InitializeMembers(Mesh *pmesh, Data *data, MeshBlock *pmb, const int nblocks,
+                       const std::function<void(ParameterInput *)> &pgen) {
+  const int nvar = pmb->meshblock_data.Get()
+                       ->PackVariables(std::vector<MetadataFlag>{Metadata::Independent,
+                                                                 Metadata::Cell})
+                       .GetDim(4);
+  const auto &cb = pmb->cellbounds;
+  parthenon::ParArray5D<Real> buffer("ensemble buffer", nblocks, nvar,
+                                     cb.ncellsk(IndexDomain::entire),
+                                     cb.ncellsj(IndexDomain::entire),
+                                     cb.ncellsi(IndexDomain::entire));
+
+  const int size = static_cast<int>(member_pins.size());
+  for (int m = 0; m < size; m++) {
+    if (init_user_mesh_data != nullptr) {
+      init_user_mesh_data(pmesh, member_pins[m].get());
+    }
+    pgen(member_pins[m].get());
+    CopyMembers(data, buffer, m, m + 1, true);
+  }
+  CopyMembers(data, buffer, 0, size, false);
+}
+} // namespace
+
+int GetDir(ParameterInput *pin) {
+  return pin->DoesParameterExist("ensemble", "dir") ? pin->GetInteger("ensemble", "dir")
+                                                    : 0;
+}
+
+int GetNumDims(ParameterInput *pin) {
+  const int ndim = pin->GetOrAddInteger("parthenon/mesh", "nx3", 1) > 1   ? 3
+                   : pin->GetOrAddInteger("parthenon/mesh", "nx2", 1) > 1 ? 2
+                                                                          : 1;
+  return GetDir(pin) > 0 ? ndim - 1 : ndim;
+}
+
+void Setup(ParameterInput *pin, ApplicationInput *app_input) {
+  const int size = pin->GetOrAddInteger("ensemble", "size", 1);
+  PARTHENON_REQUIRE_THROWS(size > 0, "ensemble/size must be > 0");
+  if (size == 1) {
+    return;
+  }
+  PARTHENON_REQUIRE_THROWS(
+      pin->GetOrAddString("parthenon/mesh", "refinement", "none") == "none",
+      "Ensemble mode does not support mesh refinement");
+
+  // On restarts the mesh already contains the ensemble direction
+  if (!pin->DoesParameterExist("ensemble", "dir")) {
+    const int dir = GetNumDims(pin) + 1;
+    PARTHENON_REQUIRE_THROWS(dir <= 3,
+                             "Ensemble mode requires a one or two dimensional problem");
+    pin->SetInteger("ensemble", "dir", dir);
+
+    const auto xdir = "x" + std::to_string(dir);
+    pin->SetReal("ensemble", xdir + "min",
+                 pin->GetOrAddReal("parthenon/mesh", xdir + "min", -0.5));
+    pin->SetReal("ensemble", xdir + "max",
+                 pin->GetOrAddReal("parthenon/mesh", xdir + "max", 0.5));
+    const int members_per_block = pin->GetOrAddInteger("ensemble", "members_per_block",
+                                                       size);
+    PARTHENON_REQUIRE_THROWS(members_per_block > 0 && size % members_per_block == 0,
+                             "ensemble/members_per_block must divide ensemble/size");
+
+    // Member m occupies m <= x < m + 1 along the ensemble direction
+    pin->SetInteger("parthenon/mesh", "n" + xdir, size);
+    pin->SetReal("parthenon/mesh", xdir + "min", 0.0);
+    pin->SetReal("parthenon/mesh", xdir + "max", size);
+    pin->SetInteger("parthenon/meshblock", "n" + xdir, members_per_block);
+    pin->SetString("parthenon/mesh", "i" + xdir + "_bc", "periodic");
+    pin->SetString("parthenon/mesh", "o" + xdir + "_bc", "periodic");
+  }
+
+  ensemble_dir = GetDir(pin);
+  member_pins.clear();
+  for (int m = 0; m < size; m++) {
+    member_pins.emplace_back(MakeMemberInput(pin, ensemble_dir, m));
+  }
+
+  // The mesh data initialization is (also) called for each member right before the
+  // member is initialized so that the problem generator sees the member's state
+  init_user_mesh_data = app_input->InitUserMeshData;
+
+  if (app_input->ProblemGenerator != nullptr) {
+    problem_generator = app_input->ProblemGenerator;
+    app_input->ProblemGenerator = [](MeshBlock *pmb, ParameterInput *) {
+      InitializeMembers(pmb->pmy_mesh, pmb, pmb, 1, [pmb](ParameterInput *pin_m) {
+        problem_generator(pmb, pin_m);
+      });
+    };
+  }
+  if (app_input->MeshProblemGenerator != nullptr) {
+    mesh_problem_generator = app_input->MeshProblemGenerator;
+    app_input->MeshProblemGenerator = [](Mesh *pmesh, ParameterInput *,
+                                         MeshData<Real> *md) {
+      auto pmb = md->GetBlockData(0)->GetBlockPointer();
+      InitializeMembers(pmesh, md, pmb, md->NumBlocks(),
+                        [pmesh, md](ParameterInput *pin_m) {
+                          mesh_problem_generator(pmesh, pin_m, md);
+                        });
+    };
+  }
+}
+
+} // namespace utils::ensemble
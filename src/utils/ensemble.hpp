@@ -0,0 +1,39 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file ensemble.hpp
+//  \brief Ensemble mode: many small independent simulations batched in one mesh
+//
+// With ensemble/size = N > 1, a one (two) dimensional problem is run as N independent
+// members stacked along the otherwise unused x2 (x3) mesh direction, i.e., member m
+// occupies the cells with m <= x2 (x3) < m + 1 and a block holds
+// ensemble/members_per_block members. The hydro package neither calculates fluxes nor
+// timestep constraints along this direction, so that members only share the (global)
+// timestep, the kernel launches, and the MeshData packs. Each member is initialized by
+// the problem generator with its own copy of the input parameters, modified by the
+// overrides in ensemble/member_<m> (whitespace separated block/name=value entries).
+#ifndef UTILS_ENSEMBLE_HPP_
+#define UTILS_ENSEMBLE_HPP_
+
+// Parthenon headers
+#include <application_input.hpp>
+#include <parameter_input.hpp>
+
+namespace utils::ensemble {
+
+// Adds the ensemble direction to the mesh (if enabled and not restarting) and wraps the
+// problem generator of app_input. Must be called after the problem generator has been
+// set and before the mesh is constructed.
+void Setup(parthenon::ParameterInput *pin, parthenon::ApplicationInput *app_input);
+
+// Mesh direction indexing the members (0 if ensemble mode is disabled)
+int GetDir(parthenon::ParameterInput *pin);
+
+// Number of dimensions of the members, i.e., of the mesh without the ensemble direction
+int GetNumDims(parthenon::ParameterInput *pin);
+
+} // namespace utils::ensemble
+
+#endif // UTILS_ENSEMBLE_HPP_
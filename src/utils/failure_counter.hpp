@@ -0,0 +1,52 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file failure_counter.hpp
+//  \brief Device counter of failed cells for retrying steps, see <hydro/step_retry>
+#ifndef UTILS_FAILURE_COUNTER_HPP_
+#define UTILS_FAILURE_COUNTER_HPP_
+
+// C++ headers
+#include <string>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+namespace utils {
+
+// Counts cells in which a kernel failed (e.g., a negative pressure in the conversion to
+// primitive variables) so that the step can be retried instead of aborting.
+// Default constructed counters are disabled, i.e., Count() returns false and the kernels
+// keep aborting. Copies (e.g., captured in kernels) share the count.
+class FailureCounter {
+ public:
+  FailureCounter() = default;
+  explicit FailureCounter(const std::string &label) : count_(label) {}
+
+  // Returns whether the failure was counted (and the kernel may continue)
+  KOKKOS_INLINE_FUNCTION
+  bool Count() const {
+    if (count_.data() == nullptr) {
+      return false;
+    }
+    Kokkos::atomic_add(&count_(), 1);
+    return true;
+  }
+
+  bool Enabled() const { return count_.data() != nullptr; }
+
+  // Number of failures (of this rank) since the last reset
+  int Get() const {
+    return Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), count_)();
+  }
+  void Reset() const { Kokkos::deep_copy(count_, 0); }
+
+ private:
+  Kokkos::View<int, parthenon::DevMemSpace> count_;
+};
+
+} // namespace utils
+
+#endif // UTILS_FAILURE_COUNTER_HPP_
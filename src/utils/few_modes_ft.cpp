@@ -8,7 +8,13 @@
 //  \brief Helper functions for an inverse (explicit complex to real) FT
 
 // C++ headers
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <random>
+#include <set>
+#include <string>
+#include <vector>
 
 // Parthenon headers
 #include "basic_types.hpp"
@@ -19,6 +25,9 @@
 
 // AthenaPK headers
 #include "few_modes_ft.hpp"
+#include "history.hpp"
+#include "profiling.hpp"
+#include "random.hpp"
 #include "utils/error_checking.hpp"
 
 namespace utils::few_modes_ft {
@@ -29,15 +38,16 @@ using parthenon::Metadata;
 FewModesFT::FewModesFT(parthenon::ParameterInput *pin, parthenon::StateDescriptor *pkg,
                        std::string prefix, int num_modes, ParArray2D<Real> k_vec,
                        Real k_peak, Real sol_weight, Real t_corr, uint32_t rseed,
-                       bool fill_ghosts)
+                       bool fill_ghosts, bool counter_based_rng, bool separable)
     : prefix_(prefix), num_modes_(num_modes), k_vec_(k_vec), k_peak_(k_peak),
-      t_corr_(t_corr), fill_ghosts_(fill_ghosts) {
+      t_corr_(t_corr), fill_ghosts_(fill_ghosts), counter_based_rng_(counter_based_rng),
+      rseed_(rseed), separable_(separable) {
 
-  if ((num_modes > 100) && (parthenon::Globals::my_rank == 0)) {
+  if ((num_modes > 100) && !separable && (parthenon::Globals::my_rank == 0)) {
     std::cout << "### WARNING using more than 100 explicit modes will significantly "
               << "increase the runtime." << std::endl
               << "If many modes are required in the transform field consider using "
-              << "the driving mechanism based on full FFTs." << std::endl;
+              << "the separable transform." << std::endl;
   }
   // Ensure that all all wavevectors can be represented on the root grid
   const auto gnx1 = pin->GetInteger("parthenon/mesh", "nx1");
@@ -56,15 +66,40 @@ FewModesFT::FewModesFT(parthenon::ParameterInput *pin, parthenon::StateDescripto
   const auto nx2 = pin->GetInteger("parthenon/meshblock", "nx2");
   const auto nx3 = pin->GetInteger("parthenon/meshblock", "nx3");
   const auto ng_tot = fill_ghosts_ ? 2 * parthenon::Globals::nghost : 0;
+  // The separable transform only requires the phases of the (distinct) components of the
+  // wave vectors
+  std::array<int, 3> num_phases = {num_modes, num_modes, num_modes};
+  if (separable_) {
+    std::array<int, 3> kmax;
+    std::set<std::array<int, 3>> modes;
+    for (int m = 0; m < num_modes; m++) {
+      std::array<int, 3> k;
+      for (int d = 0; d < 3; d++) {
+        k[d] = static_cast<int>(k_vec_host(d, m));
+        kmin_[d] = m == 0 ? k[d] : std::min(kmin_[d], k[d]);
+        kmax[d] = m == 0 ? k[d] : std::max(kmax[d], k[d]);
+      }
+      // Modes are assigned (rather than accumulated) to the grid
+      PARTHENON_REQUIRE_THROWS(modes.insert(k).second,
+                               "Separable transform requires unique wave vectors.");
+    }
+    for (int d = 0; d < 3; d++) {
+      nk_[d] = num_modes > 0 ? kmax[d] - kmin_[d] + 1 : 0;
+    }
+    var_hat_grid_ =
+        ParArray4D<Complex>(prefix + "_var_hat_grid", 3, nk_[2], nk_[1], nk_[0]);
+    num_phases = nk_;
+  }
+  const auto phases = prefix + (separable_ ? "_grid_phases_" : "_phases_");
   auto m = Metadata({Metadata::None, Metadata::Derived, Metadata::OneCopy},
-                    std::vector<int>({2, num_modes, nx1 + ng_tot}), prefix + "_phases_i");
-  pkg->AddField(prefix + "_phases_i", m);
+                    std::vector<int>({2, num_phases[0], nx1 + ng_tot}), phases + "i");
+  pkg->AddField(phases + "i", m);
   m = Metadata({Metadata::None, Metadata::Derived, Metadata::OneCopy},
-               std::vector<int>({2, num_modes, nx2 + ng_tot}), prefix + "_phases_j");
-  pkg->AddField(prefix + "_phases_j", m);
+               std::vector<int>({2, num_phases[1], nx2 + ng_tot}), phases + "j");
+  pkg->AddField(phases + "j", m);
   m = Metadata({Metadata::None, Metadata::Derived, Metadata::OneCopy},
-               std::vector<int>({2, num_modes, nx3 + ng_tot}), prefix + "_phases_k");
-  pkg->AddField(prefix + "_phases_k", m);
+               std::vector<int>({2, num_phases[2], nx3 + ng_tot}), phases + "k");
+  pkg->AddField(phases + "k", m);
 
   // Variable (e.g., acceleration field for turbulence driver) in Fourier space using
   // complex to real transform.
@@ -141,13 +176,58 @@ void FewModesFT::SetPhases(MeshBlock *pmb, ParameterInput *pin) {
   Complex I(0.0, 1.0);
 
   auto &base = pmb->meshblock_data.Get();
+  const auto ng = fill_ghosts_ ? parthenon::Globals::nghost : 0;
+
+  if (separable_) {
+    // Phases of all (integer) components between kmin and kmin + nk - 1
+    auto &grid_phases_i = base->Get(prefix_ + "_grid_phases_i").data;
+    auto &grid_phases_j = base->Get(prefix_ + "_grid_phases_j").data;
+    auto &grid_phases_k = base->Get(prefix_ + "_grid_phases_k").data;
+    const int kmin1 = kmin_[0], kmin2 = kmin_[1], kmin3 = kmin_[2];
+    const int nk1 = nk_[0], nk2 = nk_[1], nk3 = nk_[2];
+
+    pmb->par_for(
+        "FewModesFT::SetPhases::GridPhasesI", 0, nx1 - 1 + 2 * ng, KOKKOS_LAMBDA(int i) {
+          Real gi = static_cast<Real>((i + gis - ng) % static_cast<int>(gnx1));
+          for (int a = 0; a < nk1; a++) {
+            const int kx = kmin1 + a;
+            const Real w_kx = kx * 2. * M_PI / static_cast<Real>(gnx1);
+            // same adjustment for the Complex->Real IFT as below
+            const Complex phase = (kx == 0 ? 0.5 : 1.0) * Kokkos::exp(I * w_kx * gi);
+            grid_phases_i(i, a, 0) = phase.real();
+            grid_phases_i(i, a, 1) = phase.imag();
+          }
+        });
+
+    pmb->par_for(
+        "FewModesFT::SetPhases::GridPhasesJ", 0, nx2 - 1 + 2 * ng, KOKKOS_LAMBDA(int j) {
+          Real gj = static_cast<Real>((j + gjs - ng) % static_cast<int>(gnx2));
+          for (int a = 0; a < nk2; a++) {
+            const Real w_ky = (kmin2 + a) * 2. * M_PI / static_cast<Real>(gnx2);
+            const Complex phase = Kokkos::exp(I * w_ky * gj);
+            grid_phases_j(j, a, 0) = phase.real();
+            grid_phases_j(j, a, 1) = phase.imag();
+          }
+        });
+
+    pmb->par_for(
+        "FewModesFT::SetPhases::GridPhasesK", 0, nx3 - 1 + 2 * ng, KOKKOS_LAMBDA(int k) {
+          Real gk = static_cast<Real>((k + gks - ng) % static_cast<int>(gnx3));
+          for (int a = 0; a < nk3; a++) {
+            const Real w_kz = (kmin3 + a) * 2. * M_PI / static_cast<Real>(gnx3);
+            const Complex phase = Kokkos::exp(I * w_kz * gk);
+            grid_phases_k(k, a, 0) = phase.real();
+            grid_phases_k(k, a, 1) = phase.imag();
+          }
+        });
+    return;
+  }
+
   auto &phases_i = base->Get(prefix_ + "_phases_i").data;
   auto &phases_j = base->Get(prefix_ + "_phases_j").data;
   auto &phases_k = base->Get(prefix_ + "_phases_k").data;
-
-  const auto ng = fill_ghosts_ ? parthenon::Globals::nghost : 0;
   pmb->par_for(
-      "FMFT: calc phases_i", 0, nx1 - 1 + 2 * ng, KOKKOS_LAMBDA(int i) {
+      "FewModesFT::SetPhases::PhasesI", 0, nx1 - 1 + 2 * ng, KOKKOS_LAMBDA(int i) {
         Real gi = static_cast<Real>((i + gis - ng) % static_cast<int>(gnx1));
         Real w_kx;
         Complex phase;
@@ -166,7 +246,7 @@ void FewModesFT::SetPhases(MeshBlock *pmb, ParameterInput *pin) {
       });
 
   pmb->par_for(
-      "FMFT: calc phases_j", 0, nx2 - 1 + 2 * ng, KOKKOS_LAMBDA(int j) {
+      "FewModesFT::SetPhases::PhasesJ", 0, nx2 - 1 + 2 * ng, KOKKOS_LAMBDA(int j) {
         Real gj = static_cast<Real>((j + gjs - ng) % static_cast<int>(gnx2));
         Real w_ky;
         Complex phase;
@@ -180,7 +260,7 @@ void FewModesFT::SetPhases(MeshBlock *pmb, ParameterInput *pin) {
       });
 
   pmb->par_for(
-      "FMFT: calc phases_k", 0, nx3 - 1 + 2 * ng, KOKKOS_LAMBDA(int k) {
+      "FewModesFT::SetPhases::PhasesK", 0, nx3 - 1 + 2 * ng, KOKKOS_LAMBDA(int k) {
         Real gk = static_cast<Real>((k + gks - ng) % static_cast<int>(gnx3));
         Real w_kz;
         Complex phase;
@@ -195,7 +275,8 @@ void FewModesFT::SetPhases(MeshBlock *pmb, ParameterInput *pin) {
 }
 
 void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
-                          const std::string &var_name) {
+                          const std::string &var_name, const ParArray1D<int> *blocks) {
+  utils::profiling::ScopedRegion region("FewModesFT::Generate");
   auto pmb = md->GetBlockData(0)->GetBlockPointer();
 
   const auto num_modes = num_modes_;
@@ -203,21 +284,27 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
   Complex I(0.0, 1.0);
   auto &random_num = random_num_;
 
-  // get a set of random numbers from the CPU so that they are deterministic
-  // when run on GPUs
-  Real v1, v2, v_sqr;
-  for (int n = 0; n < 3; n++)
-    for (int m = 0; m < num_modes; m++) {
-      do {
-        v1 = dist_(rng_);
-        v2 = dist_(rng_);
-        v_sqr = v1 * v1 + v2 * v2;
-      } while (v_sqr >= 1.0 || v_sqr == 0.0);
-
-      random_num_host_(n, m, 0) = v1;
-      random_num_host_(n, m, 1) = v2;
-    }
-  Kokkos::deep_copy(random_num, random_num_host_);
+  const bool counter_based_rng = counter_based_rng_;
+  // Key of all random numbers of this call (combined with the mode and component)
+  const uint64_t rng_key = utils::random::Hash(rseed_, rng_counter_);
+  rng_counter_ += 1;
+  if (!counter_based_rng) {
+    // get a set of random numbers from the CPU so that they are deterministic
+    // when run on GPUs
+    Real v1, v2, v_sqr;
+    for (int n = 0; n < 3; n++)
+      for (int m = 0; m < num_modes; m++) {
+        do {
+          v1 = dist_(rng_);
+          v2 = dist_(rng_);
+          v_sqr = v1 * v1 + v2 * v2;
+        } while (v_sqr >= 1.0 || v_sqr == 0.0);
+
+        random_num_host_(n, m, 0) = v1;
+        random_num_host_(n, m, 1) = v2;
+      }
+    Kokkos::deep_copy(random_num, random_num_host_);
+  }
 
   // make local ref to capure in lambda
   auto &k_vec = k_vec_;
@@ -228,7 +315,7 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
 
   // generate new power spectrum (injection)
   pmb->par_for(
-      "FMFT: new power spec", 0, 2, 0, num_modes - 1,
+      "FewModesFT::Generate::NewPowerSpec", 0, 2, 0, num_modes - 1,
       KOKKOS_LAMBDA(const int n, const int m) {
         Real kmag, tmp, norm, v_sqr;
 
@@ -242,16 +329,31 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
 
         tmp = std::pow(kmag / kpeak, 2.) * (2. - std::pow(kmag / kpeak, 2.));
         if (tmp < 0.) tmp = 0.;
-        v_sqr = SQR(random_num(n, m, 0)) + SQR(random_num(n, m, 1));
+        Real v1, v2;
+        if (counter_based_rng) {
+          // Same rejection sampling (for the polar method) as on the host
+          const uint64_t key = utils::random::Hash(rng_key, 3 * m + n);
+          uint64_t attempt = 0;
+          do {
+            const uint64_t key_attempt = utils::random::Hash(key, attempt);
+            v1 = 2.0 * utils::random::Uniform(utils::random::Hash(key_attempt, 0)) - 1.0;
+            v2 = 2.0 * utils::random::Uniform(utils::random::Hash(key_attempt, 1)) - 1.0;
+            v_sqr = v1 * v1 + v2 * v2;
+            attempt++;
+          } while (v_sqr >= 1.0 || v_sqr == 0.0);
+        } else {
+          v1 = random_num(n, m, 0);
+          v2 = random_num(n, m, 1);
+          v_sqr = SQR(v1) + SQR(v2);
+        }
         norm = std::sqrt(-2.0 * std::log(v_sqr) / v_sqr);
 
-        var_hat_new(n, m) =
-            Complex(tmp * norm * random_num(n, m, 0), tmp * norm * random_num(n, m, 1));
+        var_hat_new(n, m) = Complex(tmp * norm * v1, tmp * norm * v2);
       });
 
   // enforce symmetry of complex to real transform
   pmb->par_for(
-      "forcing: enforce symmetry", 0, 2, 0, num_modes - 1,
+      "FewModesFT::Generate::EnforceSymmetry", 0, 2, 0, num_modes - 1,
       KOKKOS_LAMBDA(const int n, const int m) {
         if (k_vec(0, m) == 0.) {
           for (int m2 = 0; m2 < m; m2++) {
@@ -266,7 +368,7 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
   if (sol_weight_ >= 0.0) {
     // project
     pmb->par_for(
-        "forcing: projection", 0, num_modes - 1, KOKKOS_LAMBDA(const int m) {
+        "FewModesFT::Generate::Projection", 0, num_modes - 1, KOKKOS_LAMBDA(const int m) {
           Real kmag;
 
           Real kx = k_vec(0, m);
@@ -310,7 +412,7 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
   const auto c_diff = std::sqrt(1.0 - c_drift * c_drift);
 
   pmb->par_for(
-      "FMFT: evolve spec", 0, 2, 0, num_modes - 1,
+      "FewModesFT::Generate::EvolveSpec", 0, 2, 0, num_modes - 1,
       KOKKOS_LAMBDA(const int n, const int m) {
         var_hat(n, m) =
             Complex(var_hat(n, m).real() * c_drift + var_hat_new(n, m).real() * c_diff,
@@ -322,32 +424,246 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(domain);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(domain);
   auto var_pack = md->PackVariables(std::vector<std::string>{var_name});
+
+  // The modes are still evolved above (and for all ranks) without any block
+  const bool use_block_ids = blocks != nullptr;
+  const auto block_ids = use_block_ids ? *blocks : ParArray1D<int>();
+  const int num_blocks = use_block_ids ? block_ids.extent_int(0) : md->NumBlocks();
+  if (num_blocks == 0) {
+    return;
+  }
+
+  if (separable_) {
+    // With the modes on a dense grid (zero for wave vectors that are not driven), the
+    // inverse transform factorizes into 1D transforms, i.e.,
+    // var(n, k) = sum_kz phase_k(kz, k) var_hat(n, kz, ky, kx) (for all kx, ky),
+    // var(n, k, j) = sum_ky phase_j(ky, j) var(n, k) (for all kx), and finally
+    // var(n, k, j, i) = 2 Re(sum_kx phase_i(kx, i) var(n, k, j)) per cell. The cost thus
+    // only depends on the extent of the grid (nk) rather than on the number of modes.
+    const int nk1 = nk_[0], nk2 = nk_[1], nk3 = nk_[2];
+    const int kmin1 = kmin_[0], kmin2 = kmin_[1], kmin3 = kmin_[2];
+    const int nk = kb.e - kb.s + 1;
+    const int nj = jb.e - jb.s + 1;
+    if (partial_k_.extent_int(0) < num_blocks || partial_k_.extent_int(2) != nk ||
+        partial_jk_.extent_int(3) != nj) {
+      partial_k_ =
+          ParArray5D<Complex>(prefix_ + "_partial_k", num_blocks, 3, nk, nk2, nk1);
+      partial_jk_ =
+          ParArray5D<Complex>(prefix_ + "_partial_jk", num_blocks, 3, nk, nj, nk1);
+    }
+    auto &var_hat_grid = var_hat_grid_;
+    auto &partial_k = partial_k_;
+    auto &partial_jk = partial_jk_;
+    auto grid_phases_i =
+        md->PackVariables(std::vector<std::string>{prefix_ + "_grid_phases_i"});
+    auto grid_phases_j =
+        md->PackVariables(std::vector<std::string>{prefix_ + "_grid_phases_j"});
+    auto grid_phases_k =
+        md->PackVariables(std::vector<std::string>{prefix_ + "_grid_phases_k"});
+
+    Kokkos::deep_copy(var_hat_grid, Complex(0.0, 0.0));
+    pmb->par_for(
+        "FewModesFT::Generate::ScatterGrid", 0, 2, 0, num_modes - 1,
+        KOKKOS_LAMBDA(const int n, const int m) {
+          const int a1 = static_cast<int>(k_vec(0, m)) - kmin1;
+          const int a2 = static_cast<int>(k_vec(1, m)) - kmin2;
+          const int a3 = static_cast<int>(k_vec(2, m)) - kmin3;
+          var_hat_grid(n, a3, a2, a1) = var_hat(n, m);
+        });
+
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "FewModesFT::Generate::InverseFTk",
+        parthenon::DevExecSpace(), 0, num_blocks - 1, kb.s, kb.e, 0, nk2 - 1, 0, nk1 - 1,
+        KOKKOS_LAMBDA(const int bi, const int k, const int a2, const int a1) {
+          const int b = use_block_ids ? block_ids(bi) : bi;
+          for (int n = 0; n < 3; n++) {
+            Complex sum(0.0, 0.0);
+            for (int a3 = 0; a3 < nk3; a3++) {
+              sum += var_hat_grid(n, a3, a2, a1) *
+                     Complex(grid_phases_k(b, 0, k - kb.s, a3, 0),
+                             grid_phases_k(b, 0, k - kb.s, a3, 1));
+            }
+            partial_k(bi, n, k - kb.s, a2, a1) = sum;
+          }
+        });
+
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "FewModesFT::Generate::InverseFTj",
+        parthenon::DevExecSpace(), 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e, 0, nk1 - 1,
+        KOKKOS_LAMBDA(const int bi, const int k, const int j, const int a1) {
+          const int b = use_block_ids ? block_ids(bi) : bi;
+          for (int n = 0; n < 3; n++) {
+            Complex sum(0.0, 0.0);
+            for (int a2 = 0; a2 < nk2; a2++) {
+              sum += partial_k(bi, n, k - kb.s, a2, a1) *
+                     Complex(grid_phases_j(b, 0, j - jb.s, a2, 0),
+                             grid_phases_j(b, 0, j - jb.s, a2, 1));
+            }
+            partial_jk(bi, n, k - kb.s, j - jb.s, a1) = sum;
+          }
+        });
+
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "FewModesFT::Generate::InverseFTi",
+        parthenon::DevExecSpace(), 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int bi, const int k, const int j, const int i) {
+          const int b = use_block_ids ? block_ids(bi) : bi;
+          Real var[3] = {0.0, 0.0, 0.0};
+          for (int a1 = 0; a1 < nk1; a1++) {
+            const Real phase_re = grid_phases_i(b, 0, i - ib.s, a1, 0);
+            const Real phase_im = grid_phases_i(b, 0, i - ib.s, a1, 1);
+            for (int n = 0; n < 3; n++) {
+              const auto &c = partial_jk(bi, n, k - kb.s, j - jb.s, a1);
+              var[n] += c.real() * phase_re - c.imag() * phase_im;
+            }
+          }
+          for (int n = 0; n < 3; n++) {
+            var_pack(b, n, k, j, i) = 2. * var[n];
+          }
+        });
+    return;
+  }
+
   auto phases_i = md->PackVariables(std::vector<std::string>{prefix_ + "_phases_i"});
   auto phases_j = md->PackVariables(std::vector<std::string>{prefix_ + "_phases_j"});
   auto phases_k = md->PackVariables(std::vector<std::string>{prefix_ + "_phases_k"});
 
-  // implictly assuming cubic box of size L=1
-  parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "FMFT: Inverse FT", parthenon::DevExecSpace(), 0,
-      md->NumBlocks() - 1, 0, 2, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int b, const int n, const int k, const int j, const int i) {
-        Complex phase, phase_i, phase_j, phase_k;
-        var_pack(b, n, k, j, i) = 0.0;
-
-        for (int m = 0; m < num_modes; m++) {
-          phase_i =
-              Complex(phases_i(b, 0, i - ib.s, m, 0), phases_i(b, 0, i - ib.s, m, 1));
-          phase_j =
-              Complex(phases_j(b, 0, j - jb.s, m, 0), phases_j(b, 0, j - jb.s, m, 1));
-          phase_k =
-              Complex(phases_k(b, 0, k - kb.s, m, 0), phases_k(b, 0, k - kb.s, m, 1));
-          phase = phase_i * phase_j * phase_k;
-          var_pack(b, n, k, j, i) += 2. * (var_hat(n, m).real() * phase.real() -
-                                           var_hat(n, m).imag() * phase.imag());
-        }
+  // The inverse transform of pencil (b, k, j) is the (3 x num_modes) x (num_modes x nx1)
+  // matrix product of the modes with the x1 phases after folding the x2 and x3 phases
+  // into the modes, i.e., var(n, i) = 2 Re(sum_m coeff(n, m) phase_i(m, i)) with
+  // coeff(n, m) = var_hat(n, m) phase_j(m) phase_k(m). A team computes coeff once per
+  // pencil (in scratch) and then the product for all cells of the pencil, which avoids
+  // recomputing the product of the phases for every cell and component.
+  // The wave vectors are arbitrary (and not a tensor product of 1D modes) so the x2 and
+  // x3 phases cannot be separated any further.
+  // Note, implictly assuming cubic box of size L=1
+  const size_t scratch_size_in_bytes =
+      parthenon::ScratchPad2D<Real>::shmem_size(6, num_modes);
+  const int scratch_level = 0;
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, "FewModesFT::Generate::InverseFT",
+      parthenon::DevExecSpace(), scratch_size_in_bytes, scratch_level, 0,
+      num_blocks - 1, kb.s, kb.e, jb.s, jb.e,
+      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int bi, const int k,
+                    const int j) {
+        const int b = use_block_ids ? block_ids(bi) : bi;
+        // real and imaginary part of the coefficient of component n in rows 2n and 2n+1
+        parthenon::ScratchPad2D<Real> coeff(member.team_scratch(scratch_level), 6,
+                                            num_modes);
+        parthenon::par_for_inner(member, 0, num_modes - 1, [&](const int m) {
+          const Complex phase_j(phases_j(b, 0, j - jb.s, m, 0),
+                                phases_j(b, 0, j - jb.s, m, 1));
+          const Complex phase_k(phases_k(b, 0, k - kb.s, m, 0),
+                                phases_k(b, 0, k - kb.s, m, 1));
+          const Complex phase_jk = phase_j * phase_k;
+          for (int n = 0; n < 3; n++) {
+            const Complex c = var_hat(n, m) * phase_jk;
+            coeff(2 * n, m) = c.real();
+            coeff(2 * n + 1, m) = c.imag();
+          }
+        });
+        member.team_barrier();
+
+        parthenon::par_for_inner(member, ib.s, ib.e, [&](const int i) {
+          Real var[3] = {0.0, 0.0, 0.0};
+          for (int m = 0; m < num_modes; m++) {
+            const Real phase_re = phases_i(b, 0, i - ib.s, m, 0);
+            const Real phase_im = phases_i(b, 0, i - ib.s, m, 1);
+            for (int n = 0; n < 3; n++) {
+              var[n] += coeff(2 * n, m) * phase_re - coeff(2 * n + 1, m) * phase_im;
+            }
+          }
+          for (int n = 0; n < 3; n++) {
+            var_pack(b, n, k, j, i) = 2. * var[n];
+          }
+        });
       });
 }
 
+std::vector<Complex> FewModesFT::Project(MeshData<Real> *md, const std::string &var_name,
+                                         const std::vector<int> &components) const {
+  utils::profiling::ScopedRegion region("FewModesFT::Project");
+  PARTHENON_REQUIRE_THROWS(!fill_ghosts_, "Projection requires interior phases only.");
+  PARTHENON_REQUIRE_THROWS(!separable_, "Projection requires the explicit transform.");
+  auto pm = md->GetParentPointer();
+  const auto num_modes = num_modes_;
+  const int ncomp = components.size();
+  const auto vol = (pm->mesh_size.xmax(X1DIR) - pm->mesh_size.xmin(X1DIR)) *
+                   (pm->mesh_size.xmax(X2DIR) - pm->mesh_size.xmin(X2DIR)) *
+                   (pm->mesh_size.xmax(X3DIR) - pm->mesh_size.xmin(X3DIR));
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  auto var_pack = md->PackVariables(std::vector<std::string>{var_name});
+  auto phases_i = md->PackVariables(std::vector<std::string>{prefix_ + "_phases_i"});
+  auto phases_j = md->PackVariables(std::vector<std::string>{prefix_ + "_phases_j"});
+  auto phases_k = md->PackVariables(std::vector<std::string>{prefix_ + "_phases_k"});
+  auto &k_vec = k_vec_;
+
+  const int nb = md->NumBlocks();
+  const int nk = kb.e - kb.s + 1;
+  const int nj = jb.e - jb.s + 1;
+  const int ni = ib.e - ib.s + 1;
+  const int ncells = nb * nk * nj * ni;
+
+  using Sums_t = utils::history::Sums<2>;
+  ParArray2D<Complex> var_hat_proj("FewModesFT::Project::var_hat", ncomp, num_modes);
+  for (int c = 0; c < ncomp; c++) {
+    const int v = components[c];
+    // One team per mode reduces over all cells of all blocks
+    parthenon::par_for_outer(
+        DEFAULT_OUTER_LOOP_PATTERN, "FewModesFT::Project", parthenon::DevExecSpace(), 0,
+        0, 0, num_modes - 1, KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int m) {
+          Sums_t sums;
+          Kokkos::parallel_reduce(
+              Kokkos::TeamThreadRange(member, ncells),
+              [&](const int idx, Sums_t &lsums) {
+                const int b = idx / (nk * nj * ni);
+                const int k = kb.s + (idx / (nj * ni)) % nk;
+                const int j = jb.s + (idx / ni) % nj;
+                const int i = ib.s + idx % ni;
+                const Complex phase_i(phases_i(b, 0, i - ib.s, m, 0),
+                                      phases_i(b, 0, i - ib.s, m, 1));
+                const Complex phase_j(phases_j(b, 0, j - jb.s, m, 0),
+                                      phases_j(b, 0, j - jb.s, m, 1));
+                const Complex phase_k(phases_k(b, 0, k - kb.s, m, 0),
+                                      phases_k(b, 0, k - kb.s, m, 1));
+                const Complex phase = phase_i * phase_j * phase_k;
+                const auto f = var_pack(b, v, k, j, i) *
+                               var_pack.GetCoords(b).CellVolume(k, j, i);
+                // multiplication with the complex conjugate of the phase
+                lsums.v[0] += f * phase.real();
+                lsums.v[1] -= f * phase.imag();
+              },
+              Kokkos::Sum<Sums_t>(sums));
+          Kokkos::single(Kokkos::PerTeam(member), [&]() {
+            // undo the factor 1/2 of the k_x = 0 phases (only used for the inverse FT)
+            const Real fac = k_vec(0, m) == 0.0 ? 2.0 / vol : 1.0 / vol;
+            var_hat_proj(c, m) = Complex(fac * sums.v[0], fac * sums.v[1]);
+          });
+        });
+  }
+  auto var_hat_proj_h =
+      Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), var_hat_proj);
+  std::vector<Real> buf(2 * ncomp * num_modes);
+  for (int c = 0; c < ncomp; c++) {
+    for (int m = 0; m < num_modes; m++) {
+      buf[2 * (c * num_modes + m)] = var_hat_proj_h(c, m).real();
+      buf[2 * (c * num_modes + m) + 1] = var_hat_proj_h(c, m).imag();
+    }
+  }
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, buf.data(), buf.size(),
+                                    MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
+#endif // MPI_PARALLEL
+  std::vector<Complex> result(ncomp * num_modes);
+  for (int n = 0; n < ncomp * num_modes; n++) {
+    result[n] = Complex(buf[2 * n], buf[2 * n + 1]);
+  }
+  return result;
+}
+
 // Creates a random set of wave vectors with k_mag within k_peak/2 and 2*k_peak
 ParArray2D<Real> MakeRandomModes(const int num_modes, const Real k_peak,
                                  uint32_t rseed = 31224) {
@@ -403,4 +719,56 @@ ParArray2D<Real> MakeRandomModes(const int num_modes, const Real k_peak,
 
   return k_vec;
 }
-} // namespace utils::few_modes_ft
\ No newline at end of file
+
+// Creates all (integer) wave vectors with 0 < k_mag <= k_max and k_x >= 0
+ParArray2D<Real> MakeAllModes(const Real k_max) {
+  std::vector<std::array<int, 3>> modes;
+  const int k_int = static_cast<int>(std::floor(k_max));
+  for (int kx = 0; kx <= k_int; kx++) {
+    for (int ky = -k_int; ky <= k_int; ky++) {
+      for (int kz = -k_int; kz <= k_int; kz++) {
+        const int k_sqr = SQR(kx) + SQR(ky) + SQR(kz);
+        if (k_sqr > 0 && k_sqr <= SQR(k_max)) {
+          modes.push_back({kx, ky, kz});
+        }
+      }
+    }
+  }
+  const int num_modes = modes.size();
+  auto k_vec = parthenon::ParArray2D<Real>("k_vec", 3, num_modes);
+  auto k_vec_h = Kokkos::create_mirror_view(k_vec);
+  for (int m = 0; m < num_modes; m++) {
+    for (int d = 0; d < 3; d++) {
+      k_vec_h(d, m) = modes[m][d];
+    }
+  }
+  Kokkos::deep_copy(k_vec, k_vec_h);
+  return k_vec;
+}
+
+// Creates all (integer) wave vectors with 0 < k_mag <= k_max in the half space
+ParArray2D<Real> MakeShellModes(const int k_max) {
+  std::vector<std::array<int, 3>> modes;
+  for (int kx = 0; kx <= k_max; kx++) {
+    for (int ky = -k_max; ky <= k_max; ky++) {
+      for (int kz = -k_max; kz <= k_max; kz++) {
+        const bool half_space = kx > 0 || (kx == 0 && ky > 0) ||
+                                (kx == 0 && ky == 0 && kz > 0);
+        if (half_space && SQR(kx) + SQR(ky) + SQR(kz) <= SQR(k_max)) {
+          modes.push_back({kx, ky, kz});
+        }
+      }
+    }
+  }
+  const int num_modes = modes.size();
+  auto k_vec = parthenon::ParArray2D<Real>("k_vec", 3, num_modes);
+  auto k_vec_h = Kokkos::create_mirror_view(k_vec);
+  for (int m = 0; m < num_modes; m++) {
+    for (int d = 0; d < 3; d++) {
+      k_vec_h(d, m) = modes[m][d];
+    }
+  }
+  Kokkos::deep_copy(k_vec, k_vec_h);
+  return k_vec;
+}
+} // namespace utils::few_modes_ft
@@ -11,9 +11,13 @@
 // Parthenon headers
 #include "basic_types.hpp"
 #include "config.hpp"
+#include <array>
+#include <cstdint>
 #include <parthenon/package.hpp>
 #include <random>
 #include <sstream>
+#include <string>
+#include <vector>
 
 // AthenaPK headers
 #include "../main.hpp"
@@ -24,7 +28,10 @@ using namespace parthenon::package::prelude;
 using parthenon::Real;
 using Complex = Kokkos::complex<Real>;
 using parthenon::IndexRange;
+using parthenon::ParArray1D;
 using parthenon::ParArray2D;
+using parthenon::ParArray4D;
+using parthenon::ParArray5D;
 
 class FewModesFT {
  private:
@@ -42,16 +49,45 @@ class FewModesFT {
                      // disable projection
   Real t_corr_;      // correlation time for evolution of Ornstein-Uhlenbeck process
   bool fill_ghosts_; // if the inverse transform should also fill ghost zones
+  // Draw the random numbers on device from a counter-based RNG keyed by (seed, number
+  // of previous calls to Generate, mode) instead of from rng_ on the host
+  bool counter_based_rng_;
+  uint32_t rseed_;
+  uint64_t rng_counter_ = 0; // number of previous calls to Generate
+  // Separable inverse transform (see few_modes_ft.cpp). The modes are scattered to the
+  // dense grid of all wave vectors between kmin_ and kmin_ + nk_ - 1 (in each direction).
+  bool separable_;
+  std::array<int, 3> kmin_, nk_;
+  ParArray4D<Complex> var_hat_grid_;
+  // Partial sums over k_z and over (k_y, k_z) of all blocks (of the last call)
+  ParArray5D<Complex> partial_k_, partial_jk_;
 
  public:
   FewModesFT(parthenon::ParameterInput *pin, parthenon::StateDescriptor *pkg,
              std::string prefix, int num_modes, ParArray2D<Real> k_vec, Real k_peak,
-             Real sol_weight, Real t_corr, uint32_t rseed, bool fill_ghosts = false);
+             Real sol_weight, Real t_corr, uint32_t rseed, bool fill_ghosts = false,
+             bool counter_based_rng = false, bool separable = false);
 
   ParArray2D<Complex> GetVarHat() { return var_hat_; }
-  int GetNumModes() { return num_modes_; }
+  ParArray2D<Real> GetKVec() const { return k_vec_; }
+  int GetNumModes() const { return num_modes_; }
   void SetPhases(MeshBlock *pmb, ParameterInput *pin);
-  void Generate(MeshData<Real> *md, const Real dt, const std::string &var_name);
+  // Evolves the modes and computes the inverse transform in var_name. If blocks is given,
+  // the inverse transform is only computed for the blocks of md with the (possibly no)
+  // indices in blocks and var_name is left unchanged for all other blocks.
+  void Generate(MeshData<Real> *md, const Real dt, const std::string &var_name,
+                const ParArray1D<int> *blocks = nullptr);
+  bool IsSeparable() const { return separable_; }
+  // Forward (volume weighted) projection of the given components of var_name on all
+  // modes, i.e., f_hat(k) = 1/V sum_cells f exp(-i k.x) dV. Returns the global (i.e.,
+  // reduced over all ranks) coefficient of component c and mode m at index
+  // c * num_modes + m. Not supported for the separable transform.
+  std::vector<Complex> Project(MeshData<Real> *md, const std::string &var_name,
+                               const std::vector<int> &components) const;
+  bool IsCounterBasedRNG() const { return counter_based_rng_; }
+  // The counter is all that is required to restore the state of the counter-based RNG
+  uint64_t GetRNGCounter() const { return rng_counter_; }
+  void RestoreRNGCounter(const uint64_t counter) { rng_counter_ = counter; }
   void RestoreRNG(std::istringstream &iss) { iss >> rng_; }
   void RestoreDist(std::istringstream &iss) { iss >> dist_; }
   std::string GetRNGState() {
@@ -69,4 +105,13 @@ class FewModesFT {
 // Creates a random set of wave vectors with k_mag within k_peak/2 and 2*k_peak
 ParArray2D<Real> MakeRandomModes(const int num_modes, const Real k_peak, uint32_t rseed);
 
+// Creates all (integer) wave vectors with 0 < k_mag <= k_max and k_x >= 0 (i.e.,
+// including both k and -k for k_x = 0 as expected by the phases of the transform)
+ParArray2D<Real> MakeAllModes(const Real k_max);
+
+// Creates all (integer) wave vectors with 0 < k_mag <= k_max in the half space that is
+// sufficient for an explicit complex to real transform (k_x > 0 or k_x = 0 and k_y > 0 or
+// k_x = k_y = 0 and k_z > 0)
+ParArray2D<Real> MakeShellModes(const int k_max);
+
 } // namespace utils::few_modes_ft
\ No newline at end of file
@@ -0,0 +1,107 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file global_reductions.cpp
+//  \brief Batched, non-blocking global reductions of scalars from different modules
+
+// C++ headers
+#include <mutex>
+#include <string>
+
+// Parthenon headers
+#include "globals.hpp"
+#include "utils/error_checking.hpp"
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "global_reductions.hpp"
+
+namespace utils {
+
+void GlobalReductions::Register(const std::string &phase, const std::string &name,
+                                const ReductionOp op) {
+  PARTHENON_REQUIRE_THROWS(!IsRegistered(name),
+                           "Global reduction " + name + " is already registered.");
+  auto &buffer = phases_[phase].buffers[static_cast<int>(op)];
+  slots_[name] = Slot{phase, static_cast<int>(op), static_cast<int>(buffer.size())};
+  buffer.push_back(0.0);
+}
+
+void GlobalReductions::SetLocal(const std::string &name, const Real value) {
+  const auto &slot = slots_.at(name);
+  auto &phase = phases_.at(slot.phase);
+  PARTHENON_REQUIRE(!phase.in_flight, "Cannot set " + name + " during its reduction.");
+  phase.buffers[slot.op][slot.idx] = value;
+}
+
+Real GlobalReductions::Get(const std::string &name) const {
+  const auto &slot = slots_.at(name);
+  return phases_.at(slot.phase).buffers[slot.op][slot.idx];
+}
+
+TaskStatus GlobalReductions::StartReduce(const std::string &phase_name) {
+  std::lock_guard<std::mutex> lock(*mutex_);
+  auto &phase = phases_.at(phase_name);
+  PARTHENON_REQUIRE(!phase.in_flight,
+                    "Reduction of phase " + phase_name + " is already in flight.");
+  phase.started = true;
+#ifdef MPI_PARALLEL
+  const MPI_Op mpi_ops[num_ops_] = {MPI_SUM, MPI_MIN, MPI_MAX};
+  for (int op = 0; op < num_ops_; op++) {
+    auto &buffer = phase.buffers[op];
+    if (buffer.empty()) {
+      phase.requests[op] = MPI_REQUEST_NULL;
+      continue;
+    }
+    PARTHENON_MPI_CHECK(MPI_Iallreduce(MPI_IN_PLACE, buffer.data(), buffer.size(),
+                                       MPI_PARTHENON_REAL, mpi_ops[op], MPI_COMM_WORLD,
+                                       &phase.requests[op]));
+  }
+  phase.in_flight = true;
+#endif
+  return TaskStatus::complete;
+}
+
+TaskStatus GlobalReductions::CheckReduce(const std::string &phase_name) {
+  std::lock_guard<std::mutex> lock(*mutex_);
+  auto &phase = phases_.at(phase_name);
+  PARTHENON_REQUIRE(phase.started,
+                    "Reduction of phase " + phase_name + " has not been started.");
+#ifdef MPI_PARALLEL
+  if (!phase.in_flight) {
+    return TaskStatus::complete;
+  }
+  int done;
+  PARTHENON_MPI_CHECK(
+      MPI_Testall(num_ops_, phase.requests.data(), &done, MPI_STATUSES_IGNORE));
+  if (!done) {
+    return TaskStatus::incomplete;
+  }
+  phase.in_flight = false;
+#endif
+  return TaskStatus::complete;
+}
+
+void GlobalReductions::WaitReduce(const std::string &phase_name) {
+  std::lock_guard<std::mutex> lock(*mutex_);
+  auto &phase = phases_.at(phase_name);
+  PARTHENON_REQUIRE(phase.started,
+                    "Reduction of phase " + phase_name + " has not been started.");
+#ifdef MPI_PARALLEL
+  if (phase.in_flight) {
+    PARTHENON_MPI_CHECK(
+        MPI_Waitall(num_ops_, phase.requests.data(), MPI_STATUSES_IGNORE));
+    phase.in_flight = false;
+  }
+#endif
+}
+
+bool GlobalReductions::IsInFlight(const std::string &phase_name) const {
+  std::lock_guard<std::mutex> lock(*mutex_);
+  const auto it = phases_.find(phase_name);
+  return it != phases_.end() && it->second.in_flight;
+}
+
+} // namespace utils
@@ -0,0 +1,79 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file global_reductions.hpp
+//  \brief Batched, non-blocking global reductions of scalars from different modules
+#ifndef UTILS_GLOBAL_REDUCTIONS_HPP_
+#define UTILS_GLOBAL_REDUCTIONS_HPP_
+
+// C++ headers
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+namespace utils {
+using parthenon::Real;
+using parthenon::TaskStatus;
+
+enum class ReductionOp { sum, min, max };
+
+// Scalars are registered (at initialization on all ranks in the same order) for a
+// "phase", i.e., a group of scalars that are available at the same point in the task
+// list.
+// All scalars of a phase are reduced in a single MPI_Iallreduce per reduction op.
+// Usage (within a single task list):
+//   - SetLocal() the contribution of this rank in a task,
+//   - StartReduce(phase) and CheckReduce(phase) tasks depending on those, and
+//   - Get() the global value in tasks depending on CheckReduce.
+// CheckReduce may also be called from multiple task lists of a later region (to overlap
+// the reduction with other work), in which case all calls return TaskStatus::complete
+// once the reduction is done.
+// The object is stored as mutable "global_reductions" param in the Hydro package.
+class GlobalReductions {
+ public:
+  void Register(const std::string &phase, const std::string &name, const ReductionOp op);
+  bool IsRegistered(const std::string &name) const { return slots_.count(name) > 0; }
+
+  void SetLocal(const std::string &name, const Real value);
+  Real Get(const std::string &name) const;
+
+  TaskStatus StartReduce(const std::string &phase);
+  // Returns TaskStatus::incomplete until the reductions of the phase (started last) are
+  // done.
+  TaskStatus CheckReduce(const std::string &phase);
+  // Blocks until the reductions of the phase are done (outside of task lists).
+  void WaitReduce(const std::string &phase);
+  bool IsInFlight(const std::string &phase) const;
+
+ private:
+  static constexpr int num_ops_ = 3;
+  struct Slot {
+    std::string phase;
+    int op;
+    int idx; // within the buffer of the phase for the op
+  };
+  struct Phase {
+    std::array<std::vector<Real>, num_ops_> buffers;
+#ifdef MPI_PARALLEL
+    std::array<MPI_Request, num_ops_> requests;
+#endif
+    bool started = false;
+    bool in_flight = false;
+  };
+  std::map<std::string, Slot> slots_;
+  std::map<std::string, Phase> phases_;
+  // shared so that the object can be stored in (and copied to) the Params
+  std::shared_ptr<std::mutex> mutex_ = std::make_shared<std::mutex>();
+};
+
+} // namespace utils
+
+#endif // UTILS_GLOBAL_REDUCTIONS_HPP_
@@ -0,0 +1,138 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file history.hpp
+//  \brief History outputs of multiple quantities calculated in a single reduction
+//
+// Parthenon calls the function of each history output variable separately for every
+// MeshData (partition). With FusedSums, all quantities of a group are calculated by a
+// single (array-valued) reduction per MeshData, i.e., a single pass over the data.
+// The values are cached on the first request of any quantity of the group and taken
+// from the cache for the remaining quantities of the same MeshData. The global (MPI)
+// reduction of all sum quantities is still done by Parthenon in one go.
+#ifndef UTILS_HISTORY_HPP_
+#define UTILS_HISTORY_HPP_
+
+// C++ headers
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parthenon headers
+#include <outputs/outputs.hpp>
+#include <parthenon/package.hpp>
+
+namespace utils::history {
+
+using parthenon::MeshData;
+using parthenon::Real;
+
+// N sums to be reduced together in a Kokkos::parallel_reduce (with Kokkos::Sum)
+template <int N>
+struct Sums {
+  Real v[N];
+
+  KOKKOS_INLINE_FUNCTION Sums() {
+    for (int n = 0; n < N; n++) {
+      v[n] = 0.0;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION Sums &operator+=(const Sums &other) {
+    for (int n = 0; n < N; n++) {
+      v[n] += other.v[n];
+    }
+    return *this;
+  }
+
+  std::vector<Real> ToVector() const { return std::vector<Real>(v, v + N); }
+};
+
+class FusedSums {
+ public:
+  // Returns the (local) sums of all quantities of md in the order of the names
+  using ReduceFun_t = std::function<std::vector<Real>(MeshData<Real> *md)>;
+
+  // Appends one history output variable (with sum reduction) per name to hst_vars
+  static void AddHistoryVars(parthenon::HstVar_list &hst_vars,
+                             const std::vector<std::string> &names,
+                             ReduceFun_t reduce_all) {
+    AddHistoryVars(
+        hst_vars, names,
+        std::vector<parthenon::UserHistoryOperation>(
+            names.size(), parthenon::UserHistoryOperation::sum),
+        std::move(reduce_all));
+  }
+
+  // Same as above but with the given (global) reduction operation per name, e.g., for
+  // maxima that are reduced together with sums in a single pass.
+  static void AddHistoryVars(parthenon::HstVar_list &hst_vars,
+                             const std::vector<std::string> &names,
+                             const std::vector<parthenon::UserHistoryOperation> &ops,
+                             ReduceFun_t reduce_all) {
+    PARTHENON_REQUIRE(ops.size() == names.size(),
+                      "Need one reduction operation per history output.");
+    auto group = std::make_shared<FusedSums>(names.size(), std::move(reduce_all));
+    for (std::size_t n = 0; n < names.size(); n++) {
+      hst_vars.emplace_back(parthenon::HistoryOutputVar(
+          ops[n], [group, n](MeshData<Real> *md) { return group->Get(md, n); },
+          names[n]));
+    }
+  }
+
+  FusedSums(const std::size_t num, ReduceFun_t reduce_all)
+      : num_(num), reduce_all_(std::move(reduce_all)) {}
+
+  // A new reduction is done if quantity n was already requested for md since the last
+  // reduction (e.g., in the next history output).
+  Real Get(MeshData<Real> *md, const std::size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(md);
+    if (it == cache_.end() || it->second.used[n]) {
+      auto values = reduce_all_(md);
+      PARTHENON_REQUIRE(values.size() == num_, "Unexpected number of fused sums.");
+      it = cache_.insert_or_assign(md, Entry{std::move(values), std::vector<bool>(num_)})
+               .first;
+    }
+    auto &entry = it->second;
+    const auto value = entry.values[n];
+    entry.used[n] = true;
+    // Remove the entry once all quantities have been requested
+    if (std::all_of(entry.used.begin(), entry.used.end(), [](bool u) { return u; })) {
+      cache_.erase(it);
+    }
+    return value;
+  }
+
+ private:
+  struct Entry {
+    std::vector<Real> values;
+    std::vector<bool> used;
+  };
+
+  std::size_t num_;
+  ReduceFun_t reduce_all_;
+  std::map<MeshData<Real> *, Entry> cache_;
+  std::mutex mutex_;
+};
+
+} // namespace utils::history
+
+namespace Kokkos {
+// Required to use Kokkos::Sum with utils::history::Sums
+template <int N>
+struct reduction_identity<utils::history::Sums<N>> {
+  KOKKOS_FORCEINLINE_FUNCTION static utils::history::Sums<N> sum() {
+    return utils::history::Sums<N>();
+  }
+};
+} // namespace Kokkos
+
+#endif // UTILS_HISTORY_HPP_
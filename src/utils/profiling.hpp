@@ -0,0 +1,48 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file profiling.hpp
+//  \brief Kokkos Tools profiling regions around logical phases of AthenaPK
+//
+// Kernel labels and regions follow a hierarchical "Module::Function[::Detail]" scheme
+// with the modules Hydro, EOS, SrcTerms, Diffusion, Tracers, Cluster, and FewModesFT so
+// that timelines/profiles can be attributed to the physics modules.
+#ifndef UTILS_PROFILING_HPP_
+#define UTILS_PROFILING_HPP_
+
+// Kokkos headers
+#include <Kokkos_Core.hpp>
+
+namespace utils::profiling {
+
+// Runtime switch for all regions (set from <hydro/profiling_regions>)
+inline bool &RegionsEnabled() {
+  static bool enabled = false;
+  return enabled;
+}
+
+// Pushes a Kokkos Tools profiling region for the lifetime of the object (if enabled).
+class ScopedRegion {
+ public:
+  explicit ScopedRegion(const char *name) : active_(RegionsEnabled()) {
+    if (active_) {
+      Kokkos::Profiling::pushRegion(name);
+    }
+  }
+  ~ScopedRegion() {
+    if (active_) {
+      Kokkos::Profiling::popRegion();
+    }
+  }
+  ScopedRegion(const ScopedRegion &) = delete;
+  ScopedRegion &operator=(const ScopedRegion &) = delete;
+
+ private:
+  const bool active_;
+};
+
+} // namespace utils::profiling
+
+#endif // UTILS_PROFILING_HPP_
@@ -0,0 +1,44 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file random.hpp
+//  \brief Counter-based random numbers that can be evaluated on device
+//
+// The random number only depends on its key (e.g., derived from a seed, a cycle, and a
+// cell or mode index) and not on the order or place (block, rank, thread) of its
+// generation. Thus, no generator state needs to be stored, communicated, or restored.
+#ifndef UTILS_RANDOM_HPP_
+#define UTILS_RANDOM_HPP_
+
+// C++ headers
+#include <cstdint>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+namespace utils::random {
+using parthenon::Real;
+
+// SplitMix64 finalizer
+KOKKOS_INLINE_FUNCTION std::uint64_t Hash(std::uint64_t key) {
+  key += 0x9e3779b97f4a7c15ULL;
+  key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+  return key ^ (key >> 31);
+}
+
+KOKKOS_INLINE_FUNCTION std::uint64_t Hash(const std::uint64_t seed,
+                                          const std::uint64_t a) {
+  return Hash(seed ^ Hash(a));
+}
+
+// Uniform random number in [0, 1) for the given key
+KOKKOS_INLINE_FUNCTION Real Uniform(const std::uint64_t key) {
+  return static_cast<Real>((key >> 11) * 0x1.0p-53);
+}
+
+} // namespace utils::random
+
+#endif // UTILS_RANDOM_HPP_
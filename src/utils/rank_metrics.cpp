@@ -0,0 +1,46 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file rank_metrics.cpp
+//  \brief Per rank step times and throughput between history outputs
+
+// Parthenon headers
+#include "globals.hpp"
+#include "utils/error_checking.hpp"
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "rank_metrics.hpp"
+
+namespace utils {
+
+const RankMetrics::Interval &RankMetrics::Get() {
+  if (cycles_ == last_cycles_) {
+    return interval_;
+  }
+  const auto ncycles = last_cycles_ < 0 ? cycles_ : cycles_ - last_cycles_;
+  const auto seconds = seconds_ - last_seconds_;
+  const auto zone_cycles = zone_cycles_ - last_zone_cycles_;
+  interval_.step_time = ncycles > 0 ? seconds / ncycles : 0.0;
+  interval_.zcs = seconds > 0.0 ? zone_cycles / seconds : 0.0;
+
+  interval_.slowest_rank = parthenon::Globals::my_rank;
+#ifdef MPI_PARALLEL
+  struct {
+    double seconds;
+    int rank;
+  } slowest{seconds, parthenon::Globals::my_rank};
+  PARTHENON_MPI_CHECK(
+      MPI_Allreduce(MPI_IN_PLACE, &slowest, 1, MPI_DOUBLE_INT, MPI_MAXLOC, MPI_COMM_WORLD));
+  interval_.slowest_rank = slowest.rank;
+#endif
+
+  last_seconds_ = seconds_;
+  last_zone_cycles_ = zone_cycles_;
+  last_cycles_ = cycles_;
+  return interval_;
+}
+
+} // namespace utils
@@ -0,0 +1,52 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file rank_metrics.hpp
+//  \brief Per rank step times and throughput between history outputs
+#ifndef UTILS_RANK_METRICS_HPP_
+#define UTILS_RANK_METRICS_HPP_
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+namespace utils {
+using parthenon::Real;
+
+// Accumulates the (fenced) wall time of the driver steps and the zone-cycles of this
+// rank to monitor the load imbalance between ranks, see <hydro/hst_rank_metrics>.
+// The step time includes the time waiting for ghost cells of neighboring ranks but not
+// the time waiting in the global timestep reduction (after the step).
+// The object is stored as mutable "rank_metrics" param in the Hydro package.
+class RankMetrics {
+ public:
+  struct Interval {
+    Real step_time = 0.0; // mean wall time per step
+    Real zcs = 0.0;       // zone-cycles per second (of the steps)
+    int slowest_rank = 0; // rank with the largest accumulated step time
+  };
+
+  void AddStep(const Real seconds, const Real zones) {
+    seconds_ += seconds;
+    zone_cycles_ += zones;
+    cycles_ += 1;
+  }
+
+  // Metrics of this rank for the steps since the previous output.
+  // The first call after new steps starts a new interval and is collective (as the
+  // first history output function is called on all ranks).
+  const Interval &Get();
+
+ private:
+  Real seconds_ = 0.0, zone_cycles_ = 0.0;
+  int cycles_ = 0;
+  // Accumulated values at the start of the current interval
+  Real last_seconds_ = 0.0, last_zone_cycles_ = 0.0;
+  int last_cycles_ = -1;
+  Interval interval_;
+};
+
+} // namespace utils
+
+#endif // UTILS_RANK_METRICS_HPP_
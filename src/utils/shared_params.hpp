@@ -0,0 +1,61 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file shared_params.hpp
+//  \brief Thread-safe updates of mutable params shared between task lists
+//
+// Tasks of different task lists (i.e., of different partitions of the mesh) within a
+// region may be executed concurrently by multiple host threads. Params that are
+// accumulated over all partitions (e.g., the timesteps dt_hyp and dt_diff, AGN triggering
+// quantities, or the magnetic tower power contributions) as well as maps in Params that
+// are modified by such tasks must only be accessed through the functions below.
+// Note that the order in which contributions of different partitions are accumulated
+// (and, thus, the roundoff of sums) then depends on the execution order.
+#ifndef UTILS_SHARED_PARAMS_HPP_
+#define UTILS_SHARED_PARAMS_HPP_
+
+// C++ headers
+#include <mutex>
+#include <string>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+namespace utils::shared_params {
+
+// Guards all read-modify-write accesses of shared params (of all packages)
+inline std::mutex &Mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Param key = min(Param key, value)
+template <typename T>
+void UpdateMin(parthenon::StateDescriptor *pkg, const std::string &key, const T value) {
+  std::lock_guard<std::mutex> lock(Mutex());
+  if (value < pkg->Param<T>(key)) {
+    pkg->UpdateParam(key, value);
+  }
+}
+
+// Param key = Param key + value
+template <typename T>
+void UpdateSum(parthenon::StateDescriptor *pkg, const std::string &key, const T value) {
+  std::lock_guard<std::mutex> lock(Mutex());
+  pkg->UpdateParam(key, pkg->Param<T>(key) + value);
+}
+
+// Calls f(param) with a pointer to the mutable param key while holding the lock, e.g.,
+// to insert entries into (or remove them from) a std::map.
+template <typename T, typename F>
+auto WithMutableParam(parthenon::StateDescriptor *pkg, const std::string &key,
+                      const F &f) {
+  std::lock_guard<std::mutex> lock(Mutex());
+  return f(pkg->MutableParam<T>(key));
+}
+
+} // namespace utils::shared_params
+
+#endif // UTILS_SHARED_PARAMS_HPP_
@@ -0,0 +1,121 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file simd.hpp
+//  \brief Explicit SIMD helpers for the pencil kernels (reconstruction, Riemann solvers)
+//
+// Only used with -DAthenaPK_ENABLE_HOST_SIMD=ON (which defines ATHENAPK_HOST_SIMD) for
+// host-only builds. The kernels then process full SIMD-width chunks of a pencil with
+// Kokkos SIMD types and the remaining cells with the (unchanged) scalar code.
+// All branches of the scalar code are replaced by selects that evaluate both sides, and
+// Min/Max/Sign follow the exact semantics of std::min/std::max/SIGN (incl. the sign of
+// zero) so that the results are identical to the scalar path.
+#ifndef UTILS_SIMD_HPP_
+#define UTILS_SIMD_HPP_
+
+#ifdef ATHENAPK_HOST_SIMD
+
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL)
+#error "ATHENAPK_HOST_SIMD is only supported for host execution spaces."
+#endif
+
+// Kokkos headers
+#include <Kokkos_Core.hpp>
+#include <Kokkos_SIMD.hpp>
+
+// Parthenon headers
+#include <parthenon/parthenon.hpp>
+
+// AthenaPK headers
+#include "../main.hpp"
+
+namespace utils::simd {
+
+using parthenon::Real;
+using Vec = Kokkos::Experimental::native_simd<Real>;
+using Mask = typename Vec::mask_type;
+
+// Number of cells processed together
+constexpr int width = Vec::size();
+
+static_assert(std::is_same_v<ScratchReal, Real>,
+              "The SIMD path requires the Riemann states to be stored in Real.");
+
+// Loads/stores width contiguous values (no alignment requirements)
+KOKKOS_FORCEINLINE_FUNCTION Vec Load(const Real *ptr) {
+  Vec v;
+  v.copy_from(ptr, Kokkos::Experimental::simd_flag_default);
+  return v;
+}
+
+KOKKOS_FORCEINLINE_FUNCTION void Store(const Vec &v, Real *ptr) {
+  v.copy_to(ptr, Kokkos::Experimental::simd_flag_default);
+}
+
+// Lane-wise `mask ? a : b`
+KOKKOS_FORCEINLINE_FUNCTION Vec Select(const Mask &mask, const Vec &a, const Vec &b) {
+  return Kokkos::Experimental::condition(mask, a, b);
+}
+
+// Same as std::min(a, b) and std::max(a, b), i.e., a is returned if the values compare
+// equal (which differs from, e.g., the x86 min/max instructions for +-0)
+KOKKOS_FORCEINLINE_FUNCTION Vec Min(const Vec &a, const Vec &b) {
+  return Select(b < a, b, a);
+}
+
+KOKKOS_FORCEINLINE_FUNCTION Vec Max(const Vec &a, const Vec &b) {
+  return Select(a < b, b, a);
+}
+
+KOKKOS_FORCEINLINE_FUNCTION Vec Abs(const Vec &a) { return Kokkos::abs(a); }
+
+KOKKOS_FORCEINLINE_FUNCTION Vec Sqrt(const Vec &a) { return Kokkos::sqrt(a); }
+
+// Same as SIGN, i.e., 1 for +-0
+KOKKOS_FORCEINLINE_FUNCTION Vec Sign(const Vec &a) {
+  return Select(a < Vec(0.0), Vec(-1.0), Vec(1.0));
+}
+
+// Number of full SIMD-width chunks in [il, iu]
+KOKKOS_FORCEINLINE_FUNCTION int NumChunks(const int il, const int iu) {
+  return iu >= il ? (iu - il + 1) / width : 0;
+}
+
+// Calls the (SIMD) reconstruction recon(q_im2, q_im1, q_i, q_ip1, q_ip2, ql_ip1, qr_i)
+// for all full chunks of [il, iu] (and variables [nl, nu]) with the same stencil and
+// storage layout as the scalar Reconstruct<recon, XNDIR> functions, i.e., ql is shifted
+// by one cell in X1DIR.
+// Returns the first index that still needs to be reconstructed by the scalar code.
+template <int XNDIR, typename F>
+KOKKOS_INLINE_FUNCTION int
+ReconstructChunks(parthenon::team_mbr_t const &member, const int k, const int j,
+                  const int il, const int iu, const parthenon::VariablePack<Real> &q,
+                  parthenon::ScratchPad2D<ScratchReal> &ql,
+                  parthenon::ScratchPad2D<ScratchReal> &qr, const int nl, const int nu,
+                  const F &recon) {
+  const int nchunks = NumChunks(il, iu);
+  const int dk = XNDIR == parthenon::X3DIR;
+  const int dj = XNDIR == parthenon::X2DIR;
+  const int di = XNDIR == parthenon::X1DIR;
+  for (auto n = nl; n <= nu; ++n) {
+    parthenon::par_for_inner(member, 0, nchunks - 1, [&](const int c) {
+      const int i = il + c * width;
+      Vec ql_ip1, qr_i;
+      recon(Load(&q(n, k - 2 * dk, j - 2 * dj, i - 2 * di)),
+            Load(&q(n, k - dk, j - dj, i - di)), Load(&q(n, k, j, i)),
+            Load(&q(n, k + dk, j + dj, i + di)),
+            Load(&q(n, k + 2 * dk, j + 2 * dj, i + 2 * di)), ql_ip1, qr_i);
+      Store(ql_ip1, &ql(n, i + di));
+      Store(qr_i, &qr(n, i));
+    });
+  }
+  return il + nchunks * width;
+}
+
+} // namespace utils::simd
+
+#endif // ATHENAPK_HOST_SIMD
+
+#endif // UTILS_SIMD_HPP_
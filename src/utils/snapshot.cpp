@@ -0,0 +1,168 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file snapshot.cpp
+//  \brief Asynchronous snapshots of cell variables (independent of the Parthenon outputs)
+
+// C++ headers
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parthenon headers
+#include "globals.hpp"
+#include "kokkos_abstraction.hpp"
+#include "mesh/mesh.hpp"
+#include "utils/error_checking.hpp"
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "profiling.hpp"
+#include "snapshot.hpp"
+
+namespace utils {
+
+namespace {
+template <typename T>
+void Append(std::vector<char> *buffer, const T *data, const std::size_t count) {
+  const auto offset = buffer->size();
+  buffer->resize(offset + count * sizeof(T));
+  std::memcpy(buffer->data() + offset, data, count * sizeof(T));
+}
+} // namespace
+
+AsyncSnapshot::AsyncSnapshot(const std::string &basename, const Real dt,
+                             const std::vector<std::string> &variables,
+                             const int max_in_flight)
+    : basename_(basename), dt_(dt), variables_(variables),
+      max_in_flight_(max_in_flight), next_time_(std::numeric_limits<Real>::lowest()) {
+  PARTHENON_REQUIRE_THROWS(max_in_flight_ > 0, "snapshot/max_in_flight must be > 0");
+}
+
+AsyncSnapshot::~AsyncSnapshot() { WaitAll(); }
+
+void AsyncSnapshot::WaitAll() {
+  while (!in_flight_.empty()) {
+    in_flight_.front().get();
+    in_flight_.pop_front();
+  }
+}
+
+void AsyncSnapshot::Write(Mesh *pmesh, const int ncycle, const Real time) {
+  if (!IsDue(time)) {
+    return;
+  }
+  utils::profiling::ScopedRegion region("AsyncSnapshot::Write");
+  // Dumps are numbered by their time interval so that numbers are unique across
+  // restarts
+  const std::int64_t num = std::floor(time / dt_);
+  next_time_ = (num + 1.0) * dt_;
+
+  // Bound the number of dumps in flight (and thus the host memory of the staging
+  // buffers)
+  while (static_cast<int>(in_flight_.size()) >= max_in_flight_) {
+    in_flight_.front().get();
+    in_flight_.pop_front();
+  }
+
+  auto staging = std::make_shared<std::vector<char>>();
+  bool header_written = false;
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    parthenon::PackIndexMap imap;
+    const auto &pack = md->PackVariables(variables_, imap);
+
+    if (!header_written) {
+      const char magic[16] = {'A', 'T', 'H', 'E', 'N', 'A', 'P', 'K',
+                              '_', 'S', 'N', 'A', 'P', 'S', 'H', 'T'};
+      const std::int32_t version = 1;
+      const std::int32_t real_size = sizeof(Real);
+      const std::int64_t cycle = ncycle;
+      const double snapshot_time = time;
+      const std::int32_t num_vars = variables_.size();
+      const std::int32_t num_blocks = pmesh->block_list.size();
+      Append(staging.get(), magic, 16);
+      Append(staging.get(), &version, 1);
+      Append(staging.get(), &real_size, 1);
+      Append(staging.get(), &cycle, 1);
+      Append(staging.get(), &snapshot_time, 1);
+      Append(staging.get(), &num_vars, 1);
+      for (const auto &var : variables_) {
+        const auto idx = imap[var];
+        PARTHENON_REQUIRE_THROWS(idx.first >= 0, "Unknown snapshot/variables entry: " +
+                                                     var);
+        const std::int32_t len = var.size();
+        const std::int32_t ncomp = idx.second - idx.first + 1;
+        Append(staging.get(), &len, 1);
+        Append(staging.get(), var.data(), var.size());
+        Append(staging.get(), &ncomp, 1);
+      }
+      Append(staging.get(), &num_blocks, 1);
+      header_written = true;
+    }
+
+    const auto ib = md->GetBlockData(0)->GetBoundsI(parthenon::IndexDomain::interior);
+    const auto jb = md->GetBlockData(0)->GetBoundsJ(parthenon::IndexDomain::interior);
+    const auto kb = md->GetBlockData(0)->GetBoundsK(parthenon::IndexDomain::interior);
+    const int ni = ib.e - ib.s + 1;
+    const int nj = jb.e - jb.s + 1;
+    const int nk = kb.e - kb.s + 1;
+    const int ncomp = pack.GetDim(4);
+    const std::size_t ncells = static_cast<std::size_t>(ni) * nj * nk;
+
+    // Gather the interior cells of all blocks (component major) on device so that a
+    // single transfer to the host is required
+    parthenon::ParArray1D<Real> buf("AsyncSnapshot::buf",
+                                    pack.GetDim(5) * ncomp * ncells);
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "AsyncSnapshot::Gather", parthenon::DevExecSpace(), 0,
+        pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          const std::size_t cell = ((k - kb.s) * nj + (j - jb.s)) * ni + (i - ib.s);
+          for (int n = 0; n < ncomp; n++) {
+            buf((b * ncomp + n) * ncells + cell) = pack(b, n, k, j, i);
+          }
+        });
+    auto buf_h = Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), buf);
+
+    for (int b = 0; b < md->NumBlocks(); b++) {
+      auto *pmb = md->GetBlockData(b)->GetBlockPointer();
+      const auto &bs = pmb->block_size;
+      const std::int64_t gid = pmb->gid;
+      const std::int64_t loc[4] = {pmb->loc.level(), pmb->loc.lx1(), pmb->loc.lx2(),
+                                   pmb->loc.lx3()};
+      const double bounds[6] = {bs.xmin(parthenon::X1DIR), bs.xmin(parthenon::X2DIR),
+                                bs.xmin(parthenon::X3DIR), bs.xmax(parthenon::X1DIR),
+                                bs.xmax(parthenon::X2DIR), bs.xmax(parthenon::X3DIR)};
+      const std::int32_t nx[3] = {ni, nj, nk};
+      Append(staging.get(), &gid, 1);
+      Append(staging.get(), loc, 4);
+      Append(staging.get(), bounds, 6);
+      Append(staging.get(), nx, 3);
+      Append(staging.get(), buf_h.data() + b * ncomp * ncells, ncomp * ncells);
+    }
+  }
+
+  std::stringstream fname;
+  fname << basename_ << "." << std::setw(5) << std::setfill('0') << num << "."
+        << std::setw(5) << std::setfill('0') << parthenon::Globals::my_rank << ".bin";
+  in_flight_.emplace_back(
+      std::async(std::launch::async, [filename = fname.str(), staging]() {
+        std::ofstream outfile(filename, std::ios::binary | std::ios::trunc);
+        PARTHENON_REQUIRE_THROWS(outfile.good(), "Cannot open snapshot " + filename);
+        outfile.write(staging->data(), staging->size());
+      }));
+}
+
+} // namespace utils
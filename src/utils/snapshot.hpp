@@ -0,0 +1,60 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2025, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file snapshot.hpp
+//  \brief Asynchronous snapshots of cell variables (independent of the Parthenon outputs)
+//
+// Every snapshot/dt, the interior cells of the selected variables of all blocks of a rank
+// are gathered on device into a contiguous buffer, copied to the host in a single
+// transfer, and written to a per-rank binary file by a separate thread while the
+// simulation advances. At most snapshot/max_in_flight dumps are written concurrently
+// (further dumps first wait for the oldest one). All dumps are completed before any
+// Parthenon output (in particular restart dumps) is written.
+#ifndef UTILS_SNAPSHOT_HPP_
+#define UTILS_SNAPSHOT_HPP_
+
+// C++ headers
+#include <deque>
+#include <future>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+namespace utils {
+
+using parthenon::Mesh;
+using parthenon::Real;
+
+class AsyncSnapshot {
+ public:
+  AsyncSnapshot(const std::string &basename, const Real dt,
+                const std::vector<std::string> &variables, const int max_in_flight);
+  ~AsyncSnapshot();
+  AsyncSnapshot(const AsyncSnapshot &) = delete;
+  AsyncSnapshot &operator=(const AsyncSnapshot &) = delete;
+
+  bool IsDue(const Real time) const { return time >= next_time_; }
+
+  // Copies the selected variables of all blocks of the rank to a host staging buffer
+  // and starts writing it (if time reached the next snapshot time).
+  void Write(Mesh *pmesh, const int ncycle, const Real time);
+
+  // Waits for all dumps that are currently being written
+  void WaitAll();
+
+ private:
+  std::string basename_;
+  Real dt_;
+  std::vector<std::string> variables_;
+  int max_in_flight_;
+  Real next_time_;
+  std::deque<std::future<void>> in_flight_;
+};
+
+} // namespace utils
+
+#endif // UTILS_SNAPSHOT_HPP_
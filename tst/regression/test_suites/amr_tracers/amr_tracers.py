@@ -0,0 +1,114 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Tracers in a uniform diagonal flow that advects a density blob through a periodic box
+# with adaptive mesh refinement (refining ahead of and derefining behind the blob).
+# The number and ids of the tracers have to be conserved across all (de)refinements and
+# all tracers have to be displaced uniformly by the flow velocity so that they are back
+# at their initial positions after one crossing time.
+vel = 1.0
+tlim = 1.0
+dump_dt = 0.25
+# same tolerance as in the particle_advection test (on a uniform mesh)
+pos_tol = 0.003
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        parameters.driver_cmd_line_args = [
+            "parthenon/mesh/numlevel=3",
+            f"parthenon/time/tlim={tlim}",
+            f"problem/advection/vx={vel}",
+            f"problem/advection/vy={vel}",
+            f"problem/advection/vz={vel}",
+            "problem/advection/rho_radius=0.125",
+            "parthenon/output0/file_type=rst",
+            f"parthenon/output0/dt={dump_dt}",
+            "parthenon/output0/id=amr",
+            "tracers/enabled=true",
+            "tracers/initial_seed_method=random_per_block",
+            "tracers/initial_num_tracers_per_cell=0.125",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        success = True
+
+        num_dumps = int(round(tlim / dump_dt))
+        dumps = [f"{n:05d}" for n in range(num_dumps)] + ["final"]
+        data_sorted = {}
+        levels = {}
+        for dump in dumps:
+            data = phdf.phdf(f"{parameters.output_path}/parthenon.amr.{dump}.rhdf")
+            tracers = data.GetSwarm("tracers")
+            ids = tracers.Get("id")
+            idx_ids_sorted = np.argsort(ids)
+            data_sorted[dump] = {
+                "time": data.Time,
+                "ids": ids[idx_ids_sorted],
+                "xs": tracers.x[idx_ids_sorted],
+                "ys": tracers.y[idx_ids_sorted],
+                "zs": tracers.z[idx_ids_sorted],
+            }
+            levels[dump] = np.sort(data.Levels)
+
+        # The mesh has to be refined and has to change between the dumps (i.e., blocks
+        # were refined and derefined while the blob moved).
+        if max(np.max(lvl) for lvl in levels.values()) == 0:
+            print("ERROR: mesh was never refined.")
+            success = False
+        for prev_dump, dump in zip(dumps[:-1], dumps[1:]):
+            if np.array_equal(levels[prev_dump], levels[dump]):
+                print(f"WARNING: same refinement levels in dumps {prev_dump} and {dump}.")
+        if len(set(len(lvl) for lvl in levels.values())) == 1:
+            print("ERROR: number of blocks did not change during the simulation.")
+            success = False
+
+        init = data_sorted[dumps[0]]
+        for dump in dumps[1:]:
+            cur = data_sorted[dump]
+            if not np.array_equal(init["ids"], cur["ids"]):
+                print(
+                    f"ERROR: tracers not conserved in dump {dump}: {len(cur['ids'])} "
+                    f"instead of {len(init['ids'])} tracers (or different ids)."
+                )
+                success = False
+                continue
+
+            shift = vel * (cur["time"] - init["time"])
+            for pos in ["xs", "ys", "zs"]:
+                # distance (in the periodic unit box) to the advected initial position
+                dist = np.abs((cur[pos] - init[pos] - shift + 0.5) % 1.0 - 0.5)
+                if dist.max() > pos_tol:
+                    print(
+                        f"ERROR: {pos} in dump {dump} differs by up to {dist.max()} "
+                        "from the advected initial positions."
+                    )
+                    success = False
+
+        return success
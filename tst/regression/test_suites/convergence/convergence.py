@@ -42,6 +42,8 @@ method_cfgs = [
     {"integrator": "rk3", "recon": "weno3"},
     {"integrator": "rk3", "recon": "limo3"},
     {"integrator": "rk3", "recon": "wenoz"},
+    {"integrator": "rk3", "recon": "ppm", "ssp_integrator": "ssprk43"},
+    {"integrator": "rk3", "recon": "ppm", "ssp_integrator": "ssprk104"},
 ]
 
 
@@ -104,6 +106,7 @@ class TestCase(utils.test_case.TestCaseAbs):
             "parthenon/mesh/nghost=%d"
             % (3 if (recon == "ppm" or recon == "wenoz") else 2),
             "parthenon/time/integrator=%s" % integrator,
+            "hydro/ssp_integrator=%s" % method_cfg.get("ssp_integrator", "none"),
             "hydro/reconstruction=%s" % recon,
             "hydro/riemann=%s" % riemann,
         ]
@@ -163,15 +166,24 @@ class TestCase(utils.test_case.TestCaseAbs):
         if data[10, 4] > 1.547584e-08:
             analyze_status = False
 
-        markers = "ov^<>sp*hXD"
+        # The many-stage SSP integrators (at the larger timesteps from their SSP
+        # coefficients) should be about as accurate as SSPRK(3,3) with the same
+        # reconstruction
+        for row in [43, 47]:
+            if data[row, 4] > 1.1 * data[27, 4]:
+                print("Many-stage SSP integrator less accurate than SSPRK(3,3)")
+                analyze_status = False
+
+        markers = "ov^<>sp*hXDd"
         for i, cfg in enumerate(method_cfgs):
+            integrator = cfg.get("ssp_integrator", cfg["integrator"]).upper()
             plt.plot(
                 data[i * n_res : (i + 1) * n_res, 0],
                 data[i * n_res : (i + 1) * n_res, 4],
                 marker=markers[i],
                 label=(
                     (
-                        f'{cfg["integrator"].upper()} {cfg["recon"].upper()} '
+                        f'{integrator} {cfg["recon"].upper()} '
                         f'{"hlle" if "riemann" not in cfg.keys() else cfg["riemann"]}'
                     )
                 ),
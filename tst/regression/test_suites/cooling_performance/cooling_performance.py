@@ -0,0 +1,112 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import matplotlib
+
+matplotlib.use("agg")
+import matplotlib.pylab as plt
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Grid size (n_rho = n_temp), number of temperatures of the cooling table, and timestep of
+# the full integrations relative to the cooling time at the peak of the cooling curve
+perf_cfgs = [
+    {"n_grid": 256, "n_table": 200, "dt_ratio": 1.0},
+    {"n_grid": 64, "n_table": 200, "dt_ratio": 1.0},
+    {"n_grid": 1024, "n_table": 200, "dt_ratio": 1.0},
+    {"n_grid": 256, "n_table": 50, "dt_ratio": 1.0},
+    {"n_grid": 256, "n_table": 1000, "dt_ratio": 1.0},
+    {"n_grid": 256, "n_table": 200, "dt_ratio": 0.1},
+    {"n_grid": 256, "n_table": 200, "dt_ratio": 10.0},
+]
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        cfg = perf_cfgs[step - 1]
+
+        # Synthetic cooling curve with a peak at 2e5 K and bremsstrahlung at high T
+        table_filename = f"benchmark_{cfg['n_table']}.cooling"
+        log_temps = np.linspace(4.0, 9.0, cfg["n_table"])
+        lambdas = 10 ** (-21.3) * np.exp(-((log_temps - 5.3) ** 2) / 0.5) + 10 ** (
+            -27.0
+        ) * np.sqrt(10**log_temps)
+        np.savetxt(
+            table_filename, np.stack((log_temps, np.log10(lambdas)), axis=1), delimiter=" "
+        )
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/time/nlim=0",
+            f"cooling/table_filename={table_filename}",
+            "cooling/lambda_units_cgs=1",
+            "cooling/integrator=townsend",
+            "cooling/benchmark=true",
+            f"cooling/benchmark_n_rho={cfg['n_grid']}",
+            f"cooling/benchmark_n_temp={cfg['n_grid']}",
+            f"cooling/benchmark_dt_ratio={cfg['dt_ratio']}",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+
+        # Throughput (in cells/s) of each benchmark for each configuration
+        perfs = []
+        names = None
+        for output in parameters.stdouts:
+            cfg_names = []
+            cfg_perfs = []
+            for line in output.decode("utf-8").split("\n"):
+                print(line)
+                if line.startswith("  ") and line.endswith(" cells/s"):
+                    name, perf = line.strip().rsplit(": ", 1)
+                    # Remove the number of subcycles
+                    cfg_names.append(name.split(" (")[0])
+                    cfg_perfs.append(float(perf.split(" ")[0]))
+            if names is None:
+                names = cfg_names
+            elif names != cfg_names:
+                print("Benchmarks differ between configurations.")
+                return False
+            perfs.append(cfg_perfs)
+
+        if names is None or len(names) == 0 or len(perfs) != len(perf_cfgs):
+            print("Benchmark output is missing.")
+            return False
+
+        perfs = np.array(perfs)
+
+        # Plot results
+        fig, p = plt.subplots(
+            1, len(names), figsize=(3 * len(names), 8.0 / 10 * len(perf_cfgs)), sharey=True
+        )
+        labels = [
+            f'${cfg["n_grid"]}^2$ cells, {cfg["n_table"]} temps, '
+            f'dt = {cfg["dt_ratio"]} $t_\\mathrm{{cool}}$'
+            for cfg in perf_cfgs
+        ]
+
+        for n, name in enumerate(names):
+            p[n].plot(perfs[:, n] / 1e6, np.arange(len(perf_cfgs)), "o")
+            p[n].set_title(name, fontsize="small")
+            p[n].set_xlabel("Mcells/s")
+            p[n].set_xscale("log")
+            p[n].grid()
+            p[n].set_yticks(np.arange(len(perf_cfgs)))
+        p[0].set_yticklabels(labels)
+
+        fig.savefig(
+            os.path.join(parameters.output_path, "cooling_performance.png"),
+            bbox_inches="tight",
+        )
+
+        return True
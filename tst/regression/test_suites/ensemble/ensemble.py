@@ -0,0 +1,110 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Shock tubes with different left pressures batched in one ensemble run (ensemble/size)
+# compared to the individual runs of all members.
+# Ensemble members share the global timestep so that the timestep is fixed (by
+# hydro/max_dt, below the hyperbolic constraint of all members) to make the individual
+# runs comparable. The members then have to agree with the individual runs to roundoff.
+pres_l_cfgs = [1.0, 0.4, 2.0, 0.1]
+size = len(pres_l_cfgs)
+nx1 = 256
+max_dt = 2e-4
+tlim = 0.2
+err_tol = 1e-12
+
+
+def get_outname(step):
+    return "ensemble" if step == 1 else f"member{step - 2}"
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        assert parameters.num_ranks <= 2, "Use <= 2 ranks for ensemble test."
+
+        parameters.driver_cmd_line_args = [
+            f"parthenon/mesh/nx1={nx1}",
+            f"parthenon/meshblock/nx1={nx1 // parameters.num_ranks}",
+            "parthenon/time/integrator=vl2",
+            "hydro/reconstruction=plm",
+            "hydro/riemann=hllc",
+            f"hydro/max_dt={max_dt}",
+            f"parthenon/time/tlim={tlim}",
+            f"parthenon/output0/dt={tlim}",
+            f"parthenon/output0/id={get_outname(step)}",
+        ]
+        # first the ensemble and then all members individually
+        if step == 1:
+            parameters.driver_cmd_line_args.append(f"ensemble/size={size}")
+            for m, pres_l in enumerate(pres_l_cfgs):
+                parameters.driver_cmd_line_args.append(
+                    f"ensemble/member_{m}=problem/sod/pres_l={pres_l}"
+                )
+        else:
+            parameters.driver_cmd_line_args.append(
+                f"problem/sod/pres_l={pres_l_cfgs[step - 2]}"
+            )
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        def load(step):
+            data_file = phdf.phdf(
+                f"{parameters.output_path}/parthenon.{get_outname(step)}.final.phdf"
+            )
+            zz, yy, xx = data_file.GetVolumeLocations()
+            components = data_file.GetComponents(
+                data_file.Info["ComponentNames"], flatten=False
+            )
+            return (
+                xx.ravel(),
+                yy.ravel(),
+                {name: comp.ravel() for name, comp in components.items()},
+            )
+
+        test_success = True
+        x_ens, y_ens, comps_ens = load(1)
+        for m in range(size):
+            x, _, comps = load(m + 2)
+            idx = np.argsort(x)
+            # member m occupies m <= x2 < m + 1
+            mask = (y_ens >= m) & (y_ens < m + 1)
+            idx_ens = np.argsort(x_ens[mask])
+            if not np.array_equal(x[idx], x_ens[mask][idx_ens]):
+                print(f"Cells of ensemble member {m} do not match the individual run.")
+                test_success = False
+                continue
+            for name, ref in comps.items():
+                val = comps_ens[name][mask][idx_ens]
+                err = np.max(np.abs(val - ref[idx])) / np.max(np.abs(ref))
+                if not err <= err_tol:
+                    print(
+                        f"{name} of ensemble member {m} differs by {err} (relative to "
+                        "the maximum) from the individual run."
+                    )
+                    test_success = False
+
+        return test_success
@@ -0,0 +1,87 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# 3D linear wave with the x2 and x3 flux kernels processing tiles of different
+# shapes, i.e., (hydro/flux_tile_sweep, hydro/flux_tile_transverse), including tiles
+# that do not divide the number of faces (or pencils) of a block.
+# The fluxes of each face are calculated in the same way, i.e., the results have to be
+# identical to the default of one team per plane of pencils.
+tile_cfgs = [(-1, 1), (4, 1), (-1, 2), (4, 4), (3, 3)]
+
+
+def get_outname(cfg):
+    tile_s, tile_t = cfg
+    return f"tile_{tile_s}_{tile_t}"
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        assert parameters.num_ranks <= 4, "Use <= 4 ranks for flux_tiles test."
+
+        tile_s, tile_t = tile_cfgs[step - 1]
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/mesh/nx1=32",
+            "parthenon/meshblock/nx1=16",
+            "parthenon/mesh/nx2=16",
+            "parthenon/meshblock/nx2=8",
+            "parthenon/mesh/nx3=16",
+            "parthenon/meshblock/nx3=8",
+            "parthenon/time/integrator=vl2",
+            "parthenon/time/tlim=0.2",
+            "hydro/reconstruction=plm",
+            "hydro/riemann=hllc",
+            "problem/linear_wave/amp=1e-2",
+            "problem/linear_wave/vflow=0.3",
+            f"hydro/flux_tile_sweep={tile_s}",
+            f"hydro/flux_tile_transverse={tile_t}",
+            "parthenon/output0/dt=0.2",
+            "parthenon/output0/variables=prim",
+            f"parthenon/output0/id={get_outname(tile_cfgs[step - 1])}",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        components = {}
+        for cfg in tile_cfgs:
+            data_file = phdf.phdf(
+                f"{parameters.output_path}/parthenon.{get_outname(cfg)}.final.phdf"
+            )
+            components[cfg] = data_file.GetComponents(
+                data_file.Info["ComponentNames"], flatten=False
+            )
+
+        test_success = True
+        ref_cfg = tile_cfgs[0]
+        for cfg in tile_cfgs[1:]:
+            for name, ref in components[ref_cfg].items():
+                if not np.array_equal(ref, components[cfg][name]):
+                    max_diff = np.max(np.abs(ref - components[cfg][name]))
+                    print(f"{name} differs (by up to {max_diff}) for tile {cfg}.")
+                    test_success = False
+
+        return test_success
@@ -0,0 +1,124 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import itertools
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Riemann problems with explicit SIMD types in the reconstruction and Riemann solvers
+# (AthenaPK_ENABLE_HOST_SIMD=ON).
+# The initial conditions cover shocks and rarefactions moving in both directions (incl.
+# a sonic point and a strong shock) so that all branches of the limiters (min/max and
+# sign selects) and of the wave speed selection are taken.
+# The number of cells (plus one face) of each pencil is not a multiple of the SIMD width
+# so that the scalar remainder is used as well.
+# All runs are repeated with the scalar athenaPK_reference executable (built alongside
+# athenaPK) and the results of both runs have to be bitwise identical.
+method_cfgs = [
+    {"recon": "ppm", "riemann": "hllc"},
+    {"recon": "wenoz", "riemann": "hllc"},
+    {"recon": "ppm", "riemann": "hlle"},
+    {"recon": "plm", "riemann": "hllc"},
+]
+
+# Following Toro Sec. 10.8 these are rho_l, u_l, p_l, rho_r, u_r, p_r, and t_end
+# Tests 1 (and its mirror image), 2, and 3 from Table 10.1
+init_cond_cfgs = [
+    [1.0, 0.75, 1.0, 0.125, 0.0, 0.1, 0.2],
+    [0.125, 0.0, 0.1, 1.0, -0.75, 1.0, 0.2],
+    [1.0, -2.0, 0.4, 1.0, 2.0, 0.4, 0.15],
+    [1.0, 0.0, 1000.0, 1.0, 0.0, 0.01, 0.012],
+]
+
+all_cfgs = list(itertools.product(method_cfgs, init_cond_cfgs))
+n_runs = len(all_cfgs)
+
+
+def get_outname(step):
+    # steps [1, n_runs] use the SIMD and the following ones the scalar executable
+    return f"{'simd' if step <= n_runs else 'ref'}_{(step - 1) % n_runs}"
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        if not hasattr(self, "driver_path"):
+            self.driver_path = parameters.driver_path
+        if step <= n_runs:
+            parameters.driver_path = self.driver_path
+        else:
+            parameters.driver_path = os.path.join(
+                os.path.dirname(self.driver_path), "athenaPK_reference"
+            )
+        assert parameters.num_ranks <= 2, "Use <= 2 ranks for host_simd test."
+
+        method, init_cond = all_cfgs[(step - 1) % n_runs]
+        rho_l, u_l, p_l, rho_r, u_r, p_r, tlim = init_cond
+        recon = method["recon"]
+
+        nx1 = 102
+        parameters.driver_cmd_line_args = [
+            f"parthenon/mesh/nx1={nx1}",
+            f"parthenon/meshblock/nx1={nx1 // parameters.num_ranks}",
+            "parthenon/time/integrator=rk3",
+            f"hydro/reconstruction={recon}",
+            "parthenon/mesh/nghost=%d" % (2 if recon == "plm" else 3),
+            f"hydro/riemann={method['riemann']}",
+            f"parthenon/output0/id={get_outname(step)}",
+            f"problem/sod/rho_l={rho_l}",
+            f"problem/sod/pres_l={p_l}",
+            f"problem/sod/u_l={u_l}",
+            f"problem/sod/rho_r={rho_r}",
+            f"problem/sod/u_r={u_r}",
+            f"problem/sod/pres_r={p_r}",
+            "problem/sod/x_discont=0.5",
+            f"parthenon/time/tlim={tlim}",
+            f"parthenon/output0/dt={tlim}",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+        for step in range(1, n_runs + 1):
+            components = []
+            for outname in [get_outname(step), get_outname(step + n_runs)]:
+                data_file = phdf.phdf(
+                    f"{parameters.output_path}/parthenon.{outname}.final.phdf"
+                )
+                components.append(
+                    data_file.GetComponents(
+                        data_file.Info["ComponentNames"], flatten=False
+                    )
+                )
+
+            method, init_cond = all_cfgs[step - 1]
+            for name, ref in components[1].items():
+                if not np.array_equal(ref, components[0][name]):
+                    max_diff = np.max(np.abs(ref - components[0][name]))
+                    print(
+                        f"{name} differs (by up to {max_diff}) between the SIMD and "
+                        f"scalar path for {method} and initial conditions {init_cond}."
+                    )
+                    test_success = False
+
+        return test_success
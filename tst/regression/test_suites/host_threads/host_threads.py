@@ -0,0 +1,110 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import itertools
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# 3D linear wave on 32 blocks split into 8 partitions (parthenon/mesh/pack_size) whose
+# task lists are either executed by a single host thread or concurrently by multiple
+# threads (parthenon/execution/nthreads).
+# The second configuration adds isotropic conduction with the RKL2 integrator so that
+# both the hyperbolic and the diffusive timestep are reduced over concurrently executed
+# partitions.
+# Timesteps are minima and all other updates are local to the blocks, i.e., the results
+# have to be identical.
+method_cfgs = [
+    {"integrator": "vl2", "recon": "plm", "riemann": "hlle", "nghost": 2},
+    {"integrator": "vl2", "recon": "plm", "riemann": "hllc", "nghost": 2, "rkl2": True},
+]
+thread_cfgs = [1, 4]
+all_cfgs = list(itertools.product(range(len(method_cfgs)), thread_cfgs))
+
+
+def get_outname(cfg):
+    method, nthreads = cfg
+    return f"method{method}_nthreads_{nthreads}"
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        assert parameters.num_ranks <= 4, "Use <= 4 ranks for host_threads test."
+
+        method, nthreads = all_cfgs[step - 1]
+        method_cfg = method_cfgs[method]
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/mesh/nx1=32",
+            "parthenon/meshblock/nx1=8",
+            "parthenon/mesh/nx2=16",
+            "parthenon/meshblock/nx2=8",
+            "parthenon/mesh/nx3=16",
+            "parthenon/meshblock/nx3=8",
+            "parthenon/mesh/pack_size=4",
+            f"parthenon/execution/nthreads={nthreads}",
+            f"parthenon/mesh/nghost={method_cfg['nghost']}",
+            f"parthenon/time/integrator={method_cfg['integrator']}",
+            "parthenon/time/tlim=0.2",
+            f"hydro/reconstruction={method_cfg['recon']}",
+            f"hydro/riemann={method_cfg['riemann']}",
+            "problem/linear_wave/amp=1e-2",
+            "problem/linear_wave/vflow=0.3",
+            "parthenon/output0/dt=0.2",
+            "parthenon/output0/variables=prim",
+            f"parthenon/output0/id={get_outname(all_cfgs[step - 1])}",
+        ]
+        if method_cfg.get("rkl2", False):
+            parameters.driver_cmd_line_args += [
+                "diffusion/integrator=rkl2",
+                "diffusion/conduction=isotropic",
+                "diffusion/conduction_coeff=fixed",
+                "diffusion/thermal_diff_coeff_code=0.01",
+            ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+        for method in range(len(method_cfgs)):
+            components = {}
+            for nthreads in thread_cfgs:
+                outname = get_outname((method, nthreads))
+                data_file = phdf.phdf(
+                    f"{parameters.output_path}/parthenon.{outname}.final.phdf"
+                )
+                components[nthreads] = data_file.GetComponents(
+                    data_file.Info["ComponentNames"], flatten=False
+                )
+
+            ref_threads = thread_cfgs[0]
+            for nthreads in thread_cfgs[1:]:
+                for name, ref in components[ref_threads].items():
+                    if not np.array_equal(ref, components[nthreads][name]):
+                        max_diff = np.max(np.abs(ref - components[nthreads][name]))
+                        print(
+                            f"{name} differs (by up to {max_diff}) with {nthreads} "
+                            f"threads for {method_cfgs[method]}."
+                        )
+                        test_success = False
+
+        return test_success
@@ -0,0 +1,111 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import utils.test_case
+from scipy.optimize import curve_fit
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Isotropic thermal conduction of a Gaussian profile in x1 with the implicit (backward
+# Euler) integrator compared to the analytic solution.
+# The timestep is set by the hyperbolic constraint, i.e., it scales with the cell size
+# so that the first-order accuracy in time dominates the error.
+res_cfgs = [128, 256, 512]
+diff_coeff = 0.25
+tlim = 2.0
+
+
+def get_outname(res):
+    return f"implicit_{res}"
+
+
+def get_ref(x):
+    return 1.0 + 1e-6 / (
+        np.sqrt(4 * np.pi * diff_coeff * (0.5 + tlim))
+        / np.exp(-(x**2) / (4.0 * diff_coeff * (0.5 + tlim)))
+    )
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        assert parameters.num_ranks <= 4, "Use <= 4 ranks for implicit conduction test."
+
+        res = res_cfgs[step - 1]
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/mesh/nx1=%d" % res,
+            "parthenon/meshblock/nx1=64",
+            "parthenon/mesh/x1min=-6.0",
+            "parthenon/mesh/x1max=6.0",
+            "parthenon/mesh/nx2=32",
+            "parthenon/meshblock/nx2=32",
+            "parthenon/mesh/x2min=-1.0",
+            "parthenon/mesh/x2max=1.0",
+            "parthenon/mesh/nx3=1",
+            "parthenon/meshblock/nx3=1",
+            "parthenon/time/integrator=rk1",
+            "problem/diffusion/Bx=0.0",
+            "problem/diffusion/By=0.0",
+            "problem/diffusion/iprob=10",
+            "parthenon/output0/id=%s" % get_outname(res),
+            "hydro/gamma=2.0",
+            "parthenon/time/tlim=%f" % tlim,
+            "parthenon/time/dt_ceil=%f" % tlim,
+            "diffusion/conduction=isotropic",
+            "diffusion/thermal_diff_coeff_code=%f" % diff_coeff,
+            "diffusion/integrator=implicit",
+            "diffusion/implicit_tol=1e-10",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        tests_passed = True
+
+        l1_err = np.zeros(len(res_cfgs))
+        for i, res in enumerate(res_cfgs):
+            data_filename = (
+                f"{parameters.output_path}/parthenon.{get_outname(res)}.final.phdf"
+            )
+            data_file = phdf.phdf(data_filename)
+            zz, yy, xx = data_file.GetVolumeLocations()
+            mask = yy == yy[0]
+            components = data_file.GetComponents(
+                data_file.Info["ComponentNames"], flatten=False
+            )
+            # because of gamma = 2.0 and rho = 1 -> p = e = T
+            temp = components["prim_pressure"].ravel()[mask]
+            l1_err[i] = np.average(np.abs(temp - get_ref(xx[mask])))
+            print(f"N={res}: L1 error {l1_err[i]:.3e}")
+
+        conv_model = lambda log_n, log_a, conv_rate: conv_rate * log_n + log_a
+        popt, pconv = curve_fit(conv_model, np.log(res_cfgs), np.log(l1_err))
+        conv_a, conv_measured = popt
+        if conv_measured > -0.95:
+            print(
+                f"!!!\nConvergence of the implicit conduction test is worse "
+                f"({conv_measured}) than expected (-0.95).\n!!!"
+            )
+            tests_passed = False
+
+        return tests_passed
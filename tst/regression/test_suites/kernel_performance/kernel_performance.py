@@ -0,0 +1,110 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import matplotlib
+
+matplotlib.use("agg")
+import matplotlib.pylab as plt
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Mesh and block size (in cells per direction) and fluid of the (three dimensional)
+# kernel benchmarks
+perf_cfgs = [
+    {"mx": 128, "mb": 128, "fluid": "euler"},
+    {"mx": 128, "mb": 64, "fluid": "euler"},
+    {"mx": 128, "mb": 32, "fluid": "euler"},
+    {"mx": 128, "mb": 16, "fluid": "euler"},
+    {"mx": 128, "mb": 128, "fluid": "glmmhd"},
+    {"mx": 128, "mb": 64, "fluid": "glmmhd"},
+    {"mx": 128, "mb": 32, "fluid": "glmmhd"},
+    {"mx": 128, "mb": 16, "fluid": "glmmhd"},
+]
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        cfg = perf_cfgs[step - 1]
+
+        parameters.driver_cmd_line_args = [
+            "problem/linear_wave/compute_error=false",
+            "parthenon/mesh/x1max=1.5",
+            f"parthenon/mesh/nx1={cfg['mx']}",
+            f"parthenon/meshblock/nx1={cfg['mb']}",
+            f"parthenon/mesh/nx2={cfg['mx']}",
+            f"parthenon/meshblock/nx2={cfg['mb']}",
+            f"parthenon/mesh/nx3={cfg['mx']}",
+            f"parthenon/meshblock/nx3={cfg['mb']}",
+            # ghost zones for all reconstruction methods
+            "parthenon/mesh/nghost=3",
+            "parthenon/mesh/refinement=none",
+            "parthenon/time/nlim=0",
+            f"hydro/fluid={cfg['fluid']}",
+            "hydro/kernel_benchmark=true",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+
+        # Throughput (in cells/s) and bandwidth (in GB/s) of each kernel for each
+        # configuration (names depend on the fluid)
+        results = []
+        for output in parameters.stdouts:
+            cfg_results = {}
+            for line in output.decode("utf-8").split("\n"):
+                print(line)
+                if line.startswith("  ") and line.endswith(" GB/s"):
+                    name, perf = line.strip().rsplit(": ", 1)
+                    cells, bandwidth = perf.split(", ")
+                    cfg_results[name] = (
+                        float(cells.split(" ")[0]),
+                        float(bandwidth.split(" ")[0]),
+                    )
+            results.append(cfg_results)
+
+        if len(results) != len(perf_cfgs) or any(len(r) == 0 for r in results):
+            print("Benchmark output is missing.")
+            return False
+
+        # Plot results (one panel per fluid with all kernels over block sizes)
+        fluids = sorted(set(cfg["fluid"] for cfg in perf_cfgs))
+        fig, p = plt.subplots(
+            1, len(fluids), figsize=(6 * len(fluids), 6), squeeze=False
+        )
+        for n, fluid in enumerate(fluids):
+            idx = [i for i, cfg in enumerate(perf_cfgs) if cfg["fluid"] == fluid]
+            block_sizes = [perf_cfgs[i]["mb"] for i in idx]
+            for name in results[idx[0]].keys():
+                if any(name not in results[i] for i in idx):
+                    print(f"Kernel {name} is missing for some configurations.")
+                    return False
+                p[0, n].plot(
+                    block_sizes,
+                    [results[i][name][0] / 1e6 for i in idx],
+                    "o-",
+                    label=name,
+                )
+            p[0, n].set_title(fluid)
+            p[0, n].set_xlabel("block size (cells per direction)")
+            p[0, n].set_ylabel("Mcells/s")
+            p[0, n].set_xscale("log", base=2)
+            p[0, n].set_yscale("log")
+            p[0, n].grid()
+            p[0, n].legend(fontsize="x-small", ncol=2)
+
+        fig.savefig(
+            os.path.join(parameters.output_path, "kernel_performance.png"),
+            bbox_inches="tight",
+        )
+
+        return True
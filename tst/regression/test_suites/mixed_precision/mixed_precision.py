@@ -0,0 +1,129 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import math
+import numpy as np
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Linear wave convergence with reconstruction states stored in single precision
+# (AthenaPK_ENABLE_MIXED_PRECISION=ON).
+# The amplitude is increased compared to the default convergence test (1e-6) so that
+# the truncation error dominates the single precision roundoff of the Riemann states
+# over the resolutions tested while nonlinear effects are still negligible.
+# All runs are repeated with the double precision athenaPK_reference executable (built
+# alongside athenaPK) and the errors of both runs have to agree within err_rtol.
+lin_res = [16, 32, 64]
+amp = 1e-3
+err_rtol = 0.05
+method_cfgs = [
+    {"integrator": "vl2", "recon": "plm", "min_order": 1.8},
+    {"integrator": "rk3", "recon": "ppm", "min_order": 1.8},
+]
+n_runs = len(lin_res) * len(method_cfgs)
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        # steps [1, n_runs] use the mixed precision and the following ones the double
+        # precision executable
+        if not hasattr(self, "driver_path"):
+            self.driver_path = parameters.driver_path
+        if step <= n_runs:
+            parameters.driver_path = self.driver_path
+        else:
+            parameters.driver_path = os.path.join(
+                os.path.dirname(self.driver_path), "athenaPK_reference"
+            )
+        step = (step - 1) % n_runs + 1
+
+        n_res = len(lin_res)
+        # make sure we can evenly distribute the MeshBlock sizes
+        err_msg = "Num ranks must be multiples of 2 for mixed precision test."
+        assert parameters.num_ranks == 1 or parameters.num_ranks % 2 == 0, err_msg
+        # ensure a minimum block size of 4
+        assert (
+            lin_res[0] / parameters.num_ranks >= 4
+        ), "Use <= 4 ranks for mixed precision test."
+
+        res = lin_res[(step - 1) % n_res]
+        method_cfg = method_cfgs[(step - 1) // n_res]
+        integrator = method_cfg["integrator"]
+        recon = method_cfg["recon"]
+        mb_nx1 = (2 * res) // parameters.num_ranks
+        # ensure that nx1 is <= 128 when using scratch (V100 limit on test system)
+        while mb_nx1 > 128:
+            mb_nx1 //= 2
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/mesh/nx1=%d" % (2 * res),
+            "parthenon/meshblock/nx1=%d" % mb_nx1,
+            "parthenon/mesh/nx2=%d" % res,
+            "parthenon/meshblock/nx2=%d" % res,
+            "parthenon/mesh/nx3=%d" % res,
+            "parthenon/meshblock/nx3=%d" % res,
+            "parthenon/mesh/nghost=%d" % (3 if recon == "ppm" else 2),
+            "parthenon/time/integrator=%s" % integrator,
+            "hydro/reconstruction=%s" % recon,
+            "problem/linear_wave/amp=%e" % amp,
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        try:
+            data = np.genfromtxt(
+                os.path.join(parameters.output_path, "linearwave-errors.dat")
+            )
+        except IOError:
+            print("linearwave-errors.dat file not accessible")
+            return False
+
+        n_res = len(lin_res)
+        if data.shape[0] != 2 * n_runs:
+            print(
+                "Missing lines in output file. Expected ",
+                2 * n_runs,
+                ", but got ",
+                data.shape[0],
+            )
+            return False
+
+        analyze_status = True
+        for i, cfg in enumerate(method_cfgs):
+            # L1 error normalized by the wave amplitude
+            errs = data[i * n_res : (i + 1) * n_res, 4] / amp
+            errs_ref = data[n_runs + i * n_res : n_runs + (i + 1) * n_res, 4] / amp
+            rel_diff = np.abs(errs - errs_ref) / errs_ref
+            print(
+                f'{cfg["integrator"].upper()} {cfg["recon"].upper()}: '
+                f"relative difference {rel_diff} to the double precision errors "
+                f"{errs_ref}"
+            )
+            if np.any(rel_diff > err_rtol):
+                print(
+                    f"Errors differ by more than {err_rtol} from the double precision "
+                    f'run for {cfg["integrator"]} {cfg["recon"]}.'
+                )
+                analyze_status = False
+            orders = np.log2(errs[:-1] / errs[1:])
+            print(
+                f'{cfg["integrator"].upper()} {cfg["recon"].upper()}: '
+                f"relative L1 errors {errs} with convergence orders {orders}"
+            )
+            if np.any(orders < cfg["min_order"]):
+                print(
+                    f'Convergence order below {cfg["min_order"]} for '
+                    f'{cfg["integrator"]} {cfg["recon"]}.'
+                )
+                analyze_status = False
+
+        return analyze_status
@@ -0,0 +1,98 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import itertools
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# 3D linear wave (large amplitude with background flow so that all components and
+# directions are non-trivial) on many small blocks with the intermediate stage ghost cell
+# exchange either at the end of the stage or overlapped with the interior fluxes of the
+# following stage (hydro/overlap_ghost_exchange), which has to give identical results.
+method_cfgs = [
+    {"integrator": "vl2", "recon": "plm", "riemann": "hlle", "nghost": 2},
+    {"integrator": "rk3", "recon": "ppm", "riemann": "hllc", "nghost": 3},
+]
+overlap_cfgs = ["false", "true"]
+all_cfgs = list(itertools.product(range(len(method_cfgs)), overlap_cfgs))
+
+
+def get_outname(cfg):
+    method, overlap = cfg
+    return f"method{method}_overlap_{overlap}"
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        assert (
+            parameters.num_ranks <= 4
+        ), "Use <= 4 ranks for overlap_ghost_exchange test."
+
+        method, overlap = all_cfgs[step - 1]
+        method_cfg = method_cfgs[method]
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/mesh/nx1=32",
+            "parthenon/meshblock/nx1=8",
+            "parthenon/mesh/nx2=16",
+            "parthenon/meshblock/nx2=8",
+            "parthenon/mesh/nx3=16",
+            "parthenon/meshblock/nx3=8",
+            f"parthenon/mesh/nghost={method_cfg['nghost']}",
+            f"parthenon/time/integrator={method_cfg['integrator']}",
+            "parthenon/time/tlim=0.2",
+            f"hydro/reconstruction={method_cfg['recon']}",
+            f"hydro/riemann={method_cfg['riemann']}",
+            f"hydro/overlap_ghost_exchange={overlap}",
+            "problem/linear_wave/amp=1e-2",
+            "problem/linear_wave/vflow=0.3",
+            "parthenon/output0/dt=0.2",
+            "parthenon/output0/variables=prim",
+            f"parthenon/output0/id={get_outname(all_cfgs[step - 1])}",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+        for method, method_cfg in enumerate(method_cfgs):
+            components = {}
+            for overlap in overlap_cfgs:
+                outname = get_outname((method, overlap))
+                data_file = phdf.phdf(
+                    f"{parameters.output_path}/parthenon.{outname}.final.phdf"
+                )
+                components[overlap] = data_file.GetComponents(
+                    data_file.Info["ComponentNames"], flatten=False
+                )
+
+            for name, ref in components["false"].items():
+                if not np.array_equal(ref, components["true"][name]):
+                    max_diff = np.max(np.abs(ref - components["true"][name]))
+                    print(
+                        f"{name} differs (by up to {max_diff}) with "
+                        f"overlap_ghost_exchange for {method_cfg}."
+                    )
+                    test_success = False
+
+        return test_success
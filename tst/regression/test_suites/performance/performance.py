@@ -16,12 +16,15 @@
 # ========================================================================================
 
 # Modules
+import glob
+import json
 import math
 import numpy as np
 import matplotlib
 
 matplotlib.use("agg")
 import matplotlib.pylab as plt
+import shutil
 import sys
 import os
 import utils.test_case
@@ -29,6 +32,8 @@ import utils.test_case
 """ To prevent littering up imported folders with .pyc files or __pycache_ folder"""
 sys.dont_write_bytecode = True
 
+# Single node configurations. With multiple ranks, these are weakly scaled, i.e., the
+# mesh is extended in the x1 direction by the number of ranks.
 perf_cfgs = [
     {"mx": 256, "mb": 256, "integrator": "vl2", "recon": "plm"},
     {"mx": 256, "mb": 128, "integrator": "vl2", "recon": "plm"},
@@ -51,25 +56,157 @@ perf_cfgs = [
     {"mx": 256, "mb": 128, "integrator": "rk2", "recon": "limo3", "fluid": "glmmhd"},
     {"mx": 256, "mb": 128, "integrator": "rk3", "recon": "weno3", "fluid": "glmmhd"},
     {"mx": 256, "mb": 128, "integrator": "rk3", "recon": "wenoz", "fluid": "glmmhd"},
+    # many-stage SSP integrators (with correspondingly larger timesteps)
+    {"mx": 256, "mb": 128, "integrator": "rk3", "recon": "ppm", "ssp": "ssprk43"},
+    {"mx": 256, "mb": 128, "integrator": "rk3", "recon": "ppm", "ssp": "ssprk104"},
+    {
+        "mx": 256,
+        "mb": 128,
+        "integrator": "rk3",
+        "recon": "wenoz",
+        "fluid": "glmmhd",
+        "ssp": "ssprk43",
+    },
 ]
 
+# Configurations of production runs (with most physics modules enabled) for weak and
+# strong scaling sweeps, i.e., for runs of this test with different numbers of ranks.
+# Strong scaling configurations keep the mesh fixed and need at least as many blocks as
+# ranks.
+scaling_physics = [[], ["cooling"], ["conduction"], ["amr"], ["tracers"]]
+scaling_physics.append(["cooling", "conduction", "amr", "tracers"])
+scaling_cfgs = []
+for scaling, mb in [("weak", 64), ("strong", 32)]:
+    for physics in scaling_physics:
+        scaling_cfgs.append(
+            {
+                "mx": 128,
+                "mb": 32 if "amr" in physics else mb,
+                "integrator": "vl2",
+                "recon": "plm",
+                "physics": physics,
+                "scaling": scaling,
+            }
+        )
+# Per task timings (that require fencing and, thus, perturb the overall performance) of
+# the production configuration
+scaling_cfgs.append(dict(scaling_cfgs[-1], task_timers=True))
+
+# SSP coefficients, i.e., the factor the timestep is larger than for the same cfl with
+# the other integrators
+ssp_coeffs = {"none": 1.0, "ssprk43": 2.0, "ssprk104": 6.0}
+
 for cfg in perf_cfgs:
+    cfg["scaling"] = "weak"
+all_cfgs = perf_cfgs + scaling_cfgs
+for cfg in all_cfgs:
     if "fluid" not in cfg.keys():
         cfg["fluid"] = "euler"
+    if "ssp" not in cfg.keys():
+        cfg["ssp"] = "none"
+    if "physics" not in cfg.keys():
+        cfg["physics"] = []
+    if "task_timers" not in cfg.keys():
+        cfg["task_timers"] = False
+    # Unique name used to match results between runs and with the baseline
+    cfg["name"] = (
+        f'{cfg["scaling"]} {cfg["integrator"]} {cfg["recon"]} {cfg["fluid"]} '
+        f'mx{cfg["mx"]} mb{cfg["mb"]}'
+        f'{" " + cfg["ssp"] if cfg["ssp"] != "none" else ""}'
+        f'{" " + "+".join(cfg["physics"]) if len(cfg["physics"]) > 0 else ""}'
+        f'{" task_timers" if cfg["task_timers"] else ""}'
+    )
+
+# Relative tolerance of the zone-cycles/s (and memory high-water mark) compared to
+# the baseline
+default_tolerance = 0.1
+
+
+def physics_args(physics):
+    """Input parameters enabling the given physics modules"""
+    args = []
+    if "cooling" in physics:
+        # Cluster like units so that the gas (p/rho = 1/gamma) has T ~ 4e7 K
+        args += [
+            "units/code_length_cgs=3.085677580962325e+24",
+            "units/code_mass_cgs=1.98841586e+47",
+            "units/code_time_cgs=3.15576e+16",
+            "hydro/He_mass_fraction=0.25",
+            "cooling/enable_cooling=tabular",
+            "cooling/table_filename=performance.cooling",
+            "cooling/lambda_units_cgs=1",
+        ]
+    if "conduction" in physics:
+        # About 6 RKL2 stages per hyperbolic timestep
+        args += [
+            "diffusion/integrator=rkl2",
+            "diffusion/conduction=isotropic",
+            "diffusion/conduction_coeff=fixed",
+            "diffusion/thermal_diff_coeff_code=0.1",
+            "diffusion/rkl2_max_dt_ratio=100.0",
+        ]
+    if "amr" in physics:
+        # Refines a fraction of the domain around the largest pressure gradients
+        args += [
+            "parthenon/mesh/refinement=adaptive",
+            "parthenon/mesh/numlevel=2",
+            "problem/linear_wave/amp=1.0e-3",
+            "refinement/type=pressure_gradient",
+            "refinement/threshold_pressure_gradient=1.0e-4",
+        ]
+    else:
+        args += ["parthenon/mesh/refinement=none"]
+    if "tracers" in physics:
+        args += [
+            "tracers/enabled=true",
+            "tracers/initial_seed_method=random_per_block",
+            "tracers/initial_num_tracers_per_cell=0.125",
+        ]
+    return args
+
+
+def read_task_timers(filename):
+    """Mean and maximum (across ranks) time per cycle of each task in the last output"""
+    phases = {}
+    if not os.path.isfile(filename):
+        return phases
+    with open(filename) as f:
+        rows = [line.strip().split(",") for line in f.readlines()[1:]]
+    if len(rows) == 0:
+        return phases
+    last_cycle = max(int(row[0]) for row in rows)
+    for row in rows:
+        if int(row[0]) == last_cycle:
+            phases[row[2]] = {"mean": float(row[5]), "max": float(row[6])}
+    return phases
 
 
 class TestCase(utils.test_case.TestCaseAbs):
     def Prepare(self, parameters, step):
-        mx = perf_cfgs[step - 1]["mx"]
-        mb = perf_cfgs[step - 1]["mb"]
-        integrator = perf_cfgs[step - 1]["integrator"]
-        recon = perf_cfgs[step - 1]["recon"]
-        fluid = perf_cfgs[step - 1]["fluid"]
+        cfg = all_cfgs[step - 1]
+        mx = cfg["mx"]
+        mb = cfg["mb"]
+        recon = cfg["recon"]
+        # Weak scaling extends the mesh (at fixed resolution) with the number of ranks
+        nx1 = mx * parameters.num_ranks if cfg["scaling"] == "weak" else mx
+        x1max = 1.5 * nx1 / mx
+
+        if "cooling" in cfg["physics"]:
+            # Synthetic cooling curve with a peak at 2e5 K and bremsstrahlung at high T
+            log_temps = np.linspace(4.0, 9.0, 200)
+            lambdas = 10 ** (-21.3) * np.exp(-((log_temps - 5.3) ** 2) / 0.5) + 10 ** (
+                -27.0
+            ) * np.sqrt(10**log_temps)
+            np.savetxt(
+                "performance.cooling",
+                np.stack((log_temps, np.log10(lambdas)), axis=1),
+                delimiter=" ",
+            )
 
         parameters.driver_cmd_line_args = [
             "problem/linear_wave/compute_error=false",
-            "parthenon/mesh/x1max=1.5",
-            "parthenon/mesh/nx1=%d" % mx,
+            "parthenon/mesh/x1max=%g" % x1max,
+            "parthenon/mesh/nx1=%d" % nx1,
             "parthenon/meshblock/nx1=%d" % mb,
             "parthenon/mesh/nx2=%d" % mx,
             "parthenon/meshblock/nx2=%d" % mb,
@@ -77,31 +214,94 @@ class TestCase(utils.test_case.TestCaseAbs):
             "parthenon/meshblock/nx3=%d" % mb,
             "parthenon/mesh/nghost=%d"
             % (3 if (recon == "ppm" or recon == "wenoz") else 2),
-            "parthenon/mesh/refinement=none",
-            "parthenon/time/integrator=%s" % integrator,
+            "parthenon/time/integrator=%s" % cfg["integrator"],
             "parthenon/time/nlim=10",
+            "hydro/ssp_integrator=%s" % cfg["ssp"],
             "hydro/reconstruction=%s" % recon,
-            "hydro/fluid=%s" % fluid,
-        ]
+            "hydro/fluid=%s" % cfg["fluid"],
+        ] + physics_args(cfg["physics"])
+
+        if cfg["task_timers"]:
+            # Only the last 5 cycles are used (to exclude the startup)
+            parameters.driver_cmd_line_args += [
+                "hydro/task_timers=true",
+                "hydro/task_timers_ncycles=5",
+                "hydro/task_timers_file=%s"
+                % os.path.join(parameters.output_path, f"task_timers_{step}.csv"),
+            ]
 
         return parameters
 
     def Analyse(self, parameters):
 
         perfs = []
+        mems = []
         for output in parameters.stdouts:
+            mem = float("nan")
             for line in output.decode("utf-8").split("\n"):
                 print(line)
                 if "zone-cycles/wallsecond" in line:
                     perfs.append(float(line.split(" ")[2]))
+                if line.startswith("memory high-water mark"):
+                    mem = float(line.split(" = ")[1].split(" ")[0])
+            mems.append(mem)
+
+        if len(perfs) != len(all_cfgs):
+            print("Performance output is missing.")
+            return False
 
         perfs = np.array(perfs)
 
+        # Throughput per simulated time comparable between integrators (i.e., the
+        # zone-cycles/wallsecond required with SSP coefficient 1 for the same progress)
+        for i, cfg in enumerate(all_cfgs):
+            if cfg["ssp"] != "none":
+                print(
+                    f"cfg {i}: {perfs[i] * ssp_coeffs[cfg['ssp']]:.3e} "
+                    f"zone-cycles/wallsecond equivalent with SSP coefficient 1"
+                )
+
+        # Machine-readable results
+        results = {"num_ranks": parameters.num_ranks, "results": []}
+        for i, cfg in enumerate(all_cfgs):
+            phases = {}
+            if cfg["task_timers"]:
+                phases = read_task_timers(
+                    os.path.join(parameters.output_path, f"task_timers_{i + 1}.csv")
+                )
+            results["results"].append(
+                {
+                    "name": cfg["name"],
+                    "cfg": cfg,
+                    "zone_cycles_per_second": perfs[i],
+                    "memory_high_water_mark_mib": mems[i],
+                    "phases": phases,
+                }
+            )
+        results_filename = os.path.join(parameters.output_path, "performance.json")
+        with open(results_filename, "w") as f:
+            json.dump(results, f, indent=2)
+
+        # Optionally collect the results of runs with different numbers of ranks in one
+        # directory for the scaling analysis (and as future baselines)
+        results_dir = os.environ.get("ATHENAPK_PERF_RESULTS")
+        if results_dir is not None:
+            os.makedirs(results_dir, exist_ok=True)
+            shutil.copy(
+                results_filename,
+                os.path.join(
+                    results_dir, f"performance_{parameters.num_ranks}ranks.json"
+                ),
+            )
+            self.AnalyseScaling(results_dir)
+
+        analyze_status = self.CompareToBaseline(results)
+
         # Plot results
-        fig, p = plt.subplots(2, 1, figsize=(4, 8.0 / 10 * len(perf_cfgs)), sharey=True)
+        fig, p = plt.subplots(2, 1, figsize=(4, 8.0 / 10 * len(all_cfgs)), sharey=True)
         labels = []
 
-        for i, cfg in enumerate(perf_cfgs):
+        for i, cfg in enumerate(all_cfgs):
             p[0].plot(perfs[i] / 1e6, i, "o")
             p[1].plot(perfs[i] / perfs[0], i, "o")
             labels.append(
@@ -109,6 +309,9 @@ class TestCase(utils.test_case.TestCaseAbs):
                     f'{cfg["integrator"].upper()} {cfg["recon"].upper()} '
                     f'Mesh ${cfg["mx"]}^3$ MB ${cfg["mb"]}^3$'
                     f'{" MHD" if cfg["fluid"] == "glmmhd" else ""}'
+                    f'{" " + cfg["ssp"].upper() if cfg["ssp"] != "none" else ""}'
+                    f'{" " + "+".join(cfg["physics"]) if cfg["physics"] else ""}'
+                    f'{" (timers)" if cfg["task_timers"] else ""}'
                 )
             )
 
@@ -117,11 +320,77 @@ class TestCase(utils.test_case.TestCaseAbs):
 
         for i in range(2):
             p[i].grid()
-            p[i].set_yticks(np.arange(len(perf_cfgs)))
+            p[i].set_yticks(np.arange(len(all_cfgs)))
             p[i].set_yticklabels(labels)
 
         fig.savefig(
             os.path.join(parameters.output_path, "performance.png"), bbox_inches="tight"
         )
 
-        return True
+        return analyze_status
+
+    def CompareToBaseline(self, results):
+        """Compares the results to the ones (with the same number of ranks) stored in
+        the file given by ATHENAPK_PERF_BASELINE"""
+        baseline_filename = os.environ.get("ATHENAPK_PERF_BASELINE")
+        if baseline_filename is None:
+            return True
+        tolerance = float(os.environ.get("ATHENAPK_PERF_TOLERANCE", default_tolerance))
+
+        with open(baseline_filename) as f:
+            baseline = json.load(f)
+        if baseline["num_ranks"] != results["num_ranks"]:
+            print(
+                f"Baseline was obtained with {baseline['num_ranks']} ranks but this "
+                f"test ran with {results['num_ranks']} ranks."
+            )
+            return False
+        baseline = {r["name"]: r for r in baseline["results"]}
+
+        status = True
+        for result in results["results"]:
+            if result["name"] not in baseline.keys():
+                print(f"No baseline for {result['name']}")
+                continue
+            ref = baseline[result["name"]]
+            perf = result["zone_cycles_per_second"]
+            ref_perf = ref["zone_cycles_per_second"]
+            if perf < (1.0 - tolerance) * ref_perf:
+                print(
+                    f"Performance regression of {result['name']}: {perf:.3e} "
+                    f"zone-cycles/s compared to {ref_perf:.3e} in the baseline."
+                )
+                status = False
+            mem = result["memory_high_water_mark_mib"]
+            ref_mem = ref["memory_high_water_mark_mib"]
+            if mem > (1.0 + tolerance) * ref_mem:
+                print(
+                    f"Memory regression of {result['name']}: {mem:.1f} MiB compared "
+                    f"to {ref_mem:.1f} MiB in the baseline."
+                )
+                status = False
+        return status
+
+    def AnalyseScaling(self, results_dir):
+        """Prints the parallel efficiency of the runs collected in results_dir relative
+        to the single rank run"""
+        runs = {}
+        for filename in glob.glob(os.path.join(results_dir, "performance_*ranks.json")):
+            with open(filename) as f:
+                results = json.load(f)
+            runs[results["num_ranks"]] = {r["name"]: r for r in results["results"]}
+        if 1 not in runs.keys() or len(runs) < 2:
+            return
+
+        for num_ranks in sorted(runs.keys()):
+            if num_ranks == 1:
+                continue
+            print(f"Parallel efficiency with {num_ranks} ranks:")
+            for name, result in runs[num_ranks].items():
+                if name not in runs[1].keys():
+                    continue
+                # Same for weak (zones scale with ranks) and strong scaling
+                efficiency = result["zone_cycles_per_second"] / (
+                    num_ranks * runs[1][name]["zone_cycles_per_second"]
+                )
+                print(f"  {name}: {efficiency:.3f}")
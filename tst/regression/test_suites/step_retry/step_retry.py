@@ -0,0 +1,99 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Strong shock tube (Toro test 3) with hydro/step_retry and a cfl number far beyond the
+# stability limit so that steps fail (negative pressures) and are retried with a reduced
+# timestep (every other cycle, as the timestep grows again afterwards).
+# The run has to complete with retries and agree within err_rtol with a run at a stable
+# cfl number (without retries).
+cfl_cfgs = {"retry": 2.0, "ref": 0.4}
+err_rtol = 0.05
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        name = list(cfl_cfgs.keys())[step - 1]
+
+        nx1 = 256
+        parameters.driver_cmd_line_args = [
+            f"parthenon/mesh/nx1={nx1}",
+            f"parthenon/meshblock/nx1={nx1 // parameters.num_ranks}",
+            f"parthenon/job/problem_id={name}",
+            f"parthenon/time/cfl={cfl_cfgs[name]}",
+            "parthenon/time/integrator=vl2",
+            "hydro/reconstruction=plm",
+            "hydro/riemann=hllc",
+            "hydro/step_retry=true",
+            "hydro/step_retry_max_attempts=4",
+            "problem/sod/rho_l=1.0",
+            "problem/sod/pres_l=1000.0",
+            "problem/sod/u_l=0.0",
+            "problem/sod/rho_r=1.0",
+            "problem/sod/pres_r=0.01",
+            "problem/sod/u_r=0.0",
+            "problem/sod/x_discont=0.5",
+            "parthenon/time/tlim=0.012",
+            "parthenon/output0/dt=0.012",
+            "parthenon/output1/file_type=hst",
+            "parthenon/output1/dt=0.001",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+        rho = {}
+        for name in cfl_cfgs.keys():
+            hst = np.genfromtxt(
+                os.path.join(parameters.output_path, f"{name}.out1.hst"),
+                names=True,
+                skip_header=1,
+            )
+            col = [n for n in hst.dtype.names if n.endswith("step_retries")][0]
+            retries = int(hst[col][-1])
+            print(f"{retries} step retries with cfl = {cfl_cfgs[name]}")
+            if (name == "retry") != (retries > 0):
+                print(f"!!!\nUnexpected number of step retries for the {name} run.\n!!!")
+                test_success = False
+
+            data_file = phdf.phdf(
+                os.path.join(parameters.output_path, f"{name}.prim.final.phdf")
+            )
+            components = data_file.GetComponents(
+                data_file.Info["ComponentNames"], flatten=False
+            )
+            rho[name] = components["prim_density"].ravel()
+
+        err = np.sum(np.abs(rho["retry"] - rho["ref"])) / np.sum(np.abs(rho["ref"]))
+        print(f"Relative L1 difference of the density: {err}")
+        if not err <= err_rtol:
+            print(
+                f"!!!\nDensity with step retries differs by more than {err_rtol} from "
+                "the stable run.\n!!!"
+            )
+            test_success = False
+
+        return test_success
@@ -0,0 +1,111 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import itertools
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Anisotropic thermal conduction of the ring problem on 16 blocks with the number of RKL
+# stages either set globally or per block (diffusion/sts_local_stages).
+# Only the blocks containing (parts of) the ring have a temperature gradient, i.e., all
+# other blocks use the minimum number of stages.
+# As blocks with different numbers of stages integrate different stability polynomials,
+# the results are not identical but have to agree within a tolerance.
+# The fluxes through faces between blocks with different numbers of stages are corrected
+# so that the total energy (with a fixed velocity and magnetic field as there are no
+# hyperbolic fluxes, i.e., the sum of the pressure) is conserved to roundoff.
+int_cfgs = ["rkl1", "rkl2"]
+local_cfgs = ["false", "true"]
+all_cfgs = list(itertools.product(int_cfgs, local_cfgs))
+# relative L1 difference of the temperature perturbation
+err_rtol = 5e-2
+# change of the total pressure relative to the L1 norm of the perturbation
+cons_rtol = 1e-10
+
+
+def get_outname(cfg):
+    integrator, local = cfg
+    return f"{integrator}_local_{local}"
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        assert parameters.num_ranks <= 4, "Use <= 4 ranks for sts_local_stages test."
+
+        integrator, local = all_cfgs[step - 1]
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/mesh/nx1=128",
+            "parthenon/meshblock/nx1=32",
+            "parthenon/mesh/nx2=128",
+            "parthenon/meshblock/nx2=32",
+            "parthenon/mesh/nx3=1",
+            "parthenon/meshblock/nx3=1",
+            "problem/diffusion/iprob=20",
+            "parthenon/time/tlim=20.0",
+            # several super timesteps (see aniso_therm_cond_ring_conv test)
+            "parthenon/time/dt_ceil=5.0",
+            "parthenon/output0/dt=20.0",
+            f"parthenon/output0/id={get_outname(all_cfgs[step - 1])}",
+            f"diffusion/integrator={integrator}",
+            f"diffusion/sts_local_stages={local}",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+        for integrator in int_cfgs:
+            temp = {}
+            for local in local_cfgs:
+                outname = get_outname((integrator, local))
+                data_file = phdf.phdf(
+                    f"{parameters.output_path}/parthenon.{outname}.final.phdf"
+                )
+                components = data_file.GetComponents(
+                    data_file.Info["ComponentNames"], flatten=False
+                )
+                # gamma and rho are uniform, i.e., the pressure is a proxy for T
+                temp[local] = components["prim_pressure"].ravel()
+            # perturbation with respect to the background (eint = 10)
+            ref = temp["false"] - np.min(temp["false"])
+            err = np.sum(np.abs(temp["true"] - temp["false"])) / np.sum(np.abs(ref))
+            print(f"Relative L1 difference with sts_local_stages ({integrator}): {err}")
+            if not np.isfinite(err) or err > err_rtol:
+                print(
+                    f"!!!\nsts_local_stages differs by more than {err_rtol} for the "
+                    f"{integrator} integrator.\n!!!"
+                )
+                test_success = False
+            cons_err = np.abs(np.sum(temp["true"]) - np.sum(temp["false"])) / np.sum(
+                np.abs(ref)
+            )
+            print(f"Relative change of the total pressure ({integrator}): {cons_err}")
+            if not np.isfinite(cons_err) or cons_err > cons_rtol:
+                print(
+                    f"!!!\nsts_local_stages does not conserve the energy for the "
+                    f"{integrator} integrator.\n!!!"
+                )
+                test_success = False
+
+        return test_success
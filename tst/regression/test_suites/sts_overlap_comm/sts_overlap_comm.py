@@ -0,0 +1,88 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import itertools
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Anisotropic thermal conduction of the ring problem (on multiple blocks) with the RKL
+# stages either calculated at once or split into rim and interior with the ghost cell
+# exchange in between (diffusion/sts_overlap_comm), which has to give identical results.
+int_cfgs = ["rkl1", "rkl2"]
+overlap_cfgs = ["false", "true"]
+all_cfgs = list(itertools.product(int_cfgs, overlap_cfgs))
+
+
+def get_outname(cfg):
+    integrator, overlap = cfg
+    return f"{integrator}_overlap_{overlap}"
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        assert parameters.num_ranks <= 4, "Use <= 4 ranks for sts_overlap_comm test."
+
+        integrator, overlap = all_cfgs[step - 1]
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/mesh/nx1=64",
+            "parthenon/meshblock/nx1=32",
+            "parthenon/mesh/nx2=64",
+            "parthenon/meshblock/nx2=32",
+            "parthenon/mesh/nx3=1",
+            "parthenon/meshblock/nx3=1",
+            "problem/diffusion/iprob=20",
+            "parthenon/time/tlim=20.0",
+            # several super timesteps (see aniso_therm_cond_ring_conv test)
+            "parthenon/time/dt_ceil=5.0",
+            "parthenon/output0/dt=20.0",
+            f"parthenon/output0/id={get_outname(all_cfgs[step - 1])}",
+            f"diffusion/integrator={integrator}",
+            f"diffusion/sts_overlap_comm={overlap}",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+        for integrator in int_cfgs:
+            components = {}
+            for overlap in overlap_cfgs:
+                outname = get_outname((integrator, overlap))
+                data_file = phdf.phdf(
+                    f"{parameters.output_path}/parthenon.{outname}.final.phdf"
+                )
+                components[overlap] = data_file.GetComponents(
+                    data_file.Info["ComponentNames"], flatten=False
+                )
+
+            for name, ref in components["false"].items():
+                if not np.array_equal(ref, components["true"][name]):
+                    max_diff = np.max(np.abs(ref - components["true"][name]))
+                    print(
+                        f"{name} differs (by up to {max_diff}) with sts_overlap_comm "
+                        f"for the {integrator} integrator."
+                    )
+                    test_success = False
+
+        return test_success
@@ -0,0 +1,136 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import itertools
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Riemann problems with the tabulated equation of state (hydro/eos=tabulated) of an ideal
+# gas (generated here) compared to the same runs with hydro/eos=adiabatic.
+# The tables are stored in single precision so that the results agree to a relative
+# (L1) difference of err_rtol and not to roundoff.
+gamma = 1.4
+err_rtol = 1e-5
+# density and specific internal energy grid of the table (covering all states)
+table_n_rho = 17
+table_log_rho = (-3.0, 1.0)
+table_n_e = 33
+table_log_e = (-3.0, 3.0)
+
+# Following Toro Sec. 10.8 these are rho_l, u_l, p_l, rho_r, u_r, p_r, and t_end
+# Tests 1 and 2 from Table 10.1
+init_cond_cfgs = [
+    [1.0, 0.75, 1.0, 0.125, 0.0, 0.1, 0.2],
+    [1.0, -2.0, 0.4, 1.0, 2.0, 0.4, 0.15],
+]
+eos_cfgs = ["adiabatic", "tabulated"]
+all_cfgs = list(itertools.product(range(len(init_cond_cfgs)), eos_cfgs))
+
+
+def get_outname(cfg):
+    init_cond, eos = cfg
+    return f"ic{init_cond}_{eos}"
+
+
+def write_table(filename):
+    with open(filename, "w") as f:
+        f.write("# ideal gas with gamma = %.16e\n" % gamma)
+        f.write(
+            f"{table_n_rho} {table_n_e} {table_log_rho[0]} {table_log_rho[1]} "
+            f"{table_log_e[0]} {table_log_e[1]}\n"
+        )
+        for rho in np.logspace(*table_log_rho, table_n_rho):
+            for e in np.logspace(*table_log_e, table_n_e):
+                f.write("%.16e %.16e\n" % ((gamma - 1.0) * rho * e, gamma))
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        init_cond, eos = all_cfgs[step - 1]
+        rho_l, u_l, p_l, rho_r, u_r, p_r, tlim = init_cond_cfgs[init_cond]
+
+        # make sure we can evenly distribute the MeshBlock sizes
+        nx1 = 256
+        mb_nx1 = nx1 // parameters.num_ranks
+        while mb_nx1 > 128:
+            mb_nx1 //= 2
+
+        parameters.driver_cmd_line_args = [
+            f"parthenon/mesh/nx1={nx1}",
+            f"parthenon/meshblock/nx1={mb_nx1}",
+            "parthenon/time/integrator=vl2",
+            "hydro/reconstruction=plm",
+            "hydro/riemann=hlle",
+            f"hydro/gamma={gamma}",
+            f"hydro/eos={eos}",
+            f"parthenon/output0/id={get_outname(all_cfgs[step - 1])}",
+            f"problem/sod/rho_l={rho_l}",
+            f"problem/sod/pres_l={p_l}",
+            f"problem/sod/u_l={u_l}",
+            f"problem/sod/rho_r={rho_r}",
+            f"problem/sod/u_r={u_r}",
+            f"problem/sod/pres_r={p_r}",
+            "problem/sod/x_discont=0.5",
+            f"parthenon/time/tlim={tlim}",
+            f"parthenon/output0/dt={tlim}",
+        ]
+        if eos == "tabulated":
+            os.makedirs(parameters.output_path, exist_ok=True)
+            table_filename = os.path.join(parameters.output_path, "ideal_gas.eos")
+            write_table(table_filename)
+            parameters.driver_cmd_line_args.append(
+                f"hydro/eos_table_filename={table_filename}"
+            )
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+        for init_cond in range(len(init_cond_cfgs)):
+            components = {}
+            for eos in eos_cfgs:
+                outname = get_outname((init_cond, eos))
+                data_file = phdf.phdf(
+                    f"{parameters.output_path}/parthenon.{outname}.final.phdf"
+                )
+                components[eos] = data_file.GetComponents(
+                    data_file.Info["ComponentNames"], flatten=False
+                )
+
+            for name, ref in components["adiabatic"].items():
+                # normalized by the maximum as the velocities may vanish
+                err = np.average(np.abs(components["tabulated"][name] - ref)) / np.max(
+                    np.abs(ref)
+                )
+                print(
+                    f"{name}: relative L1 difference {err} for "
+                    f"{init_cond_cfgs[init_cond]}"
+                )
+                if not err <= err_rtol:
+                    print(
+                        f"!!!\n{name} of the tabulated EOS differs by more than "
+                        f"{err_rtol} from the ideal gas.\n!!!"
+                    )
+                    test_success = False
+
+        return test_success
@@ -0,0 +1,91 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Counter-based tracer seeding (tracers/initial_seed_method=counter_based) for different
+# meshblock sizes of the same mesh, which has to result in the same set of tracers.
+# Ids depend on the meshblock size so the tracers are compared by position (sorted).
+# The positions may only differ by the roundoff of the face coordinates of the blocks.
+mb_cfgs = [(32, 32, 16), (32, 16, 8), (8, 8, 8)]
+pos_tol = 1e-12
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        mb_nx1, mb_nx2, mb_nx3 = mb_cfgs[step - 1]
+        parameters.driver_cmd_line_args = [
+            "parthenon/output1/dt=-1",
+            "parthenon/output2/dt=-1",
+            "parthenon/output3/dt=1.0",
+            f"parthenon/output3/id=mb{step - 1}",
+            "parthenon/time/tlim=0.01",
+            "parthenon/mesh/refinement=none",
+            "parthenon/mesh/nx1=32",
+            "parthenon/mesh/nx2=32",
+            "parthenon/mesh/nx3=32",
+            f"parthenon/meshblock/nx1={mb_nx1}",
+            f"parthenon/meshblock/nx2={mb_nx2}",
+            f"parthenon/meshblock/nx3={mb_nx3}",
+            "tracers/enabled=true",
+            "tracers/initial_seed_method=counter_based",
+            "tracers/initial_num_tracers_per_cell=0.3",
+            # disable driving
+            "problem/turbulence/accel_rms=0.0",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        success = True
+
+        positions = []
+        for n in range(len(mb_cfgs)):
+            data = phdf.phdf(f"{parameters.output_path}/parthenon.mb{n}.00000.rhdf")
+            tracers = data.GetSwarm("tracers")
+            pos = np.stack([tracers.x, tracers.y, tracers.z])
+            positions.append(pos[:, np.argsort(pos[0])])
+            ids = np.sort(tracers.Get("id"))
+            if not np.array_equal(ids, np.arange(len(ids))):
+                print(f"ERROR: tracer ids for meshblock {mb_cfgs[n]} are not 0..n-1.")
+                success = False
+
+        for n in range(1, len(mb_cfgs)):
+            if positions[n].shape != positions[0].shape:
+                print(
+                    f"ERROR: {positions[n].shape[1]} tracers for meshblock {mb_cfgs[n]} "
+                    f"instead of {positions[0].shape[1]} for {mb_cfgs[0]}."
+                )
+                success = False
+                continue
+            max_diff = np.max(np.abs(positions[n] - positions[0]))
+            if max_diff > pos_tol:
+                print(
+                    f"ERROR: tracer positions for meshblock {mb_cfgs[n]} differ by up to "
+                    f"{max_diff} from those for {mb_cfgs[0]}."
+                )
+                success = False
+
+        return success
@@ -0,0 +1,94 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2025, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import os
+import itertools
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Driven turbulence (for a few cycles) with the acceleration field calculated by the
+# explicit (default) or separable inverse transform (problem/turbulence/transform), for
+# both the modes listed in the input file and all modes (problem/turbulence/modes=all).
+# The Ornstein-Uhlenbeck evolution of the modes is shared so that the acceleration field
+# and the resulting primitive variables have to agree to roundoff.
+modes_cfgs = ["list", "all"]
+transform_cfgs = ["explicit", "separable"]
+all_cfgs = list(itertools.product(modes_cfgs, transform_cfgs))
+tlim = 0.1
+err_tol = 1e-10
+
+
+def get_outname(cfg):
+    modes, transform = cfg
+    return f"modes_{modes}_{transform}"
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        assert parameters.num_ranks <= 4, "Use <= 4 ranks for turbulence_transform test."
+
+        modes, transform = all_cfgs[step - 1]
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/output1/dt=-1",
+            "parthenon/output3/dt=-1",
+            f"parthenon/output2/dt={tlim}",
+            f"parthenon/output2/id={get_outname(all_cfgs[step - 1])}",
+            f"parthenon/time/tlim={tlim}",
+            "parthenon/mesh/nx1=32",
+            "parthenon/mesh/nx2=32",
+            "parthenon/mesh/nx3=32",
+            "parthenon/meshblock/nx1=16",
+            "parthenon/meshblock/nx2=16",
+            "parthenon/meshblock/nx3=16",
+            f"problem/turbulence/modes={modes}",
+            f"problem/turbulence/transform={transform}",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+        for modes in modes_cfgs:
+            components = {}
+            for transform in transform_cfgs:
+                outname = get_outname((modes, transform))
+                data_file = phdf.phdf(
+                    f"{parameters.output_path}/parthenon.{outname}.final.phdf"
+                )
+                components[transform] = data_file.GetComponents(
+                    data_file.Info["ComponentNames"], flatten=False
+                )
+
+            for name, ref in components["explicit"].items():
+                # normalized by the maximum as the velocities and accelerations may vanish
+                err = np.max(np.abs(components["separable"][name] - ref)) / np.max(
+                    np.abs(ref)
+                )
+                if not err <= err_tol:
+                    print(
+                        f"{name} differs by {err} (relative to the maximum) between the "
+                        f"explicit and separable transform for modes = {modes}."
+                    )
+                    test_success = False
+
+        return test_success